@@ -0,0 +1,237 @@
+/**
+ * @file ai.h
+ *
+ * @brief Declarations of the computer player (alpha-beta search).
+ *
+ * The search is an iterative deepening PVS (principal variation search) over `generateMoves()`,
+ * played with `makeMove()`/`unmakeMove()` on the real game (no board copy).
+ * Positions are stored in a fixed-size transposition table indexed by `Board::itsHash`,
+ * and moves are ordered with the table move, two killer moves per ply and a history table.
+ * With several threads the search is a lazy SMP: helper threads search copies of the game
+ * (`GameSnapshot`) at shifted depths and only communicate through the shared lock-free table.
+ * Before searching, the position is looked up in the opening book and in the endgame tables
+ * when the caller attached them (`itsBook`, `itsEndgames`, see book.h), then in the persistent
+ * analysis cache (`itsAnalysis`, see analysis.h), which also receives the result of the search.
+ * With an evaluator attached (`attachEvaluator()`), the children of the nodes one ply from the
+ * horizon are evaluated together, in one batch, instead of one by one (see batcheval.h).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef AI_H
+#define AI_H
+
+#include <atomic>
+#include <chrono>
+#include "typeDef.h"
+#include "boardpool.h"
+
+struct OpeningBook;
+struct EndgameTables;
+struct AnalysisCache;
+struct EvalBackend;
+struct EvalBatch;
+
+/**
+ * @brief Maximum depth of the search (in plies).
+ */
+const int AI_MAX_PLY = 64;
+
+/**
+ * @brief Score of a won position (a win found at ply p is scored `AI_WIN_SCORE - p`).
+ */
+const int AI_WIN_SCORE = 30000;
+
+/**
+ * @brief Default time budget of a move (in milliseconds).
+ */
+const int AI_TIME_BUDGET_MS = 90;
+
+/**
+ * @brief Default number of entries of the transposition table (as a power of 2).
+ */
+const int AI_TABLE_BITS = 20;
+
+/**
+ * @brief Thread count meaning "one thread per core" (see `createAi()`).
+ */
+const int AI_ALL_CORES = 0;
+
+/**
+ * @brief Maximum number of search threads.
+ */
+const int AI_MAX_THREADS = 64;
+
+/**
+ * @brief Weights of the evaluation (from the point of view of ATTACK, see `evaluatePosition()`).
+ */
+const int AI_SWORD_VALUE = 100;
+const int AI_SHIELD_VALUE = 160;
+const int AI_KING_CORNER_DISTANCE = 12;
+const int AI_KING_OPEN_LINE = 300;
+const int AI_KING_HOSTILE_SIDE = 35;
+
+/**
+ * @enum BoundType
+ * @brief Meaning of a score stored in the transposition table.
+ */
+enum BoundType : unsigned char
+{
+    BOUND_NONE,  /**< Empty entry. */
+    BOUND_EXACT, /**< The score is exact. */
+    BOUND_LOWER, /**< The real score is at least the stored one (beta cutoff). */
+    BOUND_UPPER  /**< The real score is at most the stored one (no move raised alpha). */
+};
+
+/**
+ * @struct TableEntry
+ * @brief One entry of the transposition table (16 bytes), shared by all the search threads.
+ *
+ * `itsData` packs the score (bits 0-15), the depth (16-23), the bound (24-31), the start cell (32-39)
+ * and the end cell (40-47) of the best move. `itsCheck` is the key XOR `itsData`: an entry
+ * written by two threads at the same time doesn't match any key, so no lock is needed.
+ */
+struct TableEntry
+{
+    std::atomic<uint64_t> itsCheck{0}; /**< Zobrist key of the position XOR `itsData`. */
+    std::atomic<uint64_t> itsData{0};  /**< Packed score, depth, bound and best move. */
+};
+
+/**
+ * @struct PlyMoves
+ * @brief Moves of one ply of the search and their ordering scores.
+ */
+struct PlyMoves
+{
+    MoveList itsList;           /**< Legal moves of the position. */
+    int itsScores[MAX_MOVES];   /**< Ordering score of each move (higher is searched first). */
+};
+
+/**
+ * @struct AiSearch
+ * @brief State of the search kept from one move to the next (tables, killers, history).
+ *
+ * Created by `createAi()` and released by `deleteAi()`. The main state owns the table
+ * and one helper state per extra thread; helpers share the table and the stop signal.
+ */
+struct AiSearch
+{
+    TableEntry* itsTable = nullptr;      /**< The transposition table (`itsTableMask + 1` entries). */
+    bool itsOwnsTable = false;           /**< true for the main state, false for the helpers. */
+    AiSearch* itsHelpers = nullptr;      /**< States of the helper threads (`itsHelperCount` entries). */
+    int itsHelperCount = 0;              /**< Number of helper threads (thread count - 1). */
+    std::atomic<bool> itsStopSignal{false}; /**< Set by the main thread to stop the helpers. */
+    const std::atomic<bool>* itsSharedStop = nullptr; /**< Stop signal of the main state (helpers only). */
+    BoardPool itsBoards;                 /**< The boards of the helpers (main state only). */
+    Game itsGame;                        /**< Copy of the searched game (helpers only, its board is from the pool of the main state). */
+    uint64_t itsTableMask = 0;           /**< Mask applied to a key to get its slot. */
+    int* itsHistory = nullptr;           /**< History scores, indexed by role, start cell and end cell. */
+    PlyMoves* itsPlies = nullptr;        /**< Move lists of each ply (`AI_MAX_PLY` entries, kept off the stack). */
+    Move itsKillers[AI_MAX_PLY][2];      /**< Two quiet moves that caused a cutoff, per ply. */
+    uint64_t itsPathKeys[AI_MAX_PLY + 1]; /**< Keys of the positions of the current line (repetitions). */
+    long long itsNodes = 0;              /**< Number of positions visited by this thread. */
+    std::chrono::steady_clock::time_point itsDeadline; /**< Time when the search must stop. */
+    bool itsStopped = false;             /**< true when the time budget is exhausted. */
+    const OpeningBook* itsBook = nullptr; /**< Opening book looked up before searching (not owned, nullptr for none). */
+    const EndgameTables* itsEndgames = nullptr; /**< Endgame tables looked up before searching (not owned, nullptr for none). */
+    AnalysisCache* itsAnalysis = nullptr; /**< Analysis cache looked up before searching and storing the results (not owned, nullptr for none). */
+    const EvalBackend* itsEvaluator = nullptr; /**< Backend scoring the horizon in batches (not owned, nullptr for `evaluatePosition()`). */
+    EvalBatch* itsBatch = nullptr;        /**< The children being evaluated (allocated by `attachEvaluator()`). */
+};
+
+/**
+ * @struct AiResult
+ * @brief Result of `searchBestMove()`.
+ */
+struct AiResult
+{
+    Move itsBestMove = {{-1,-1},{-1,-1}}; /**< The chosen move (-1 if the player has no legal move). */
+    int itsScore = 0;                     /**< Score of the move for the player to move. */
+    int itsDepth = 0;                     /**< Depth of the last completed iteration. */
+    long long itsNodes = 0;               /**< Number of positions visited (all threads). */
+    long long itsElapsedMs = 0;           /**< Time spent (in milliseconds). */
+};
+
+/**
+ * @brief Allocates the tables of the search.
+ *
+ * @param aSearch The search state to initialize (must not be already created).
+ * @param aTableBits The transposition table holds 2^aTableBits entries (1-28).
+ * @param aThreadCount Number of search threads (1-`AI_MAX_THREADS`, `AI_ALL_CORES` for one per core).
+ * @return `true` if the allocation succeeded, `false` otherwise.
+ */
+bool createAi(AiSearch& aSearch, int aTableBits = AI_TABLE_BITS, int aThreadCount = 1);
+
+/**
+ * @brief Releases the tables of the search.
+ *
+ * @param aSearch The search state to release (pointers are set to nullptr).
+ */
+void deleteAi(AiSearch& aSearch);
+
+/**
+ * @brief Clears the transposition table, the killers and the history (new game).
+ *
+ * @param aSearch The search state to clear (must be created, helpers are cleared too).
+ */
+void clearAi(AiSearch& aSearch);
+
+/**
+ * @brief Makes the search evaluate its horizon in batches with a backend.
+ *
+ * Allocates one batch per search thread; the backend is called by all the threads.
+ *
+ * @param aSearch The search state (must be created).
+ * @param aBackend The backend (must outlive its use), nullptr to go back to `evaluatePosition()`.
+ * @return `false` (and the search keeps `evaluatePosition()`) if the batches can't be allocated.
+ */
+bool attachEvaluator(AiSearch& aSearch, const EvalBackend* aBackend);
+
+/**
+ * @brief Evaluates a position without searching.
+ *
+ * Combines the features of `computeEvalFeatures()` (without the mobility): material,
+ * the distance of the king to the corners, its open lines to a FORTRESS and the number
+ * of hostile cells around it.
+ *
+ * @param aGame The game to evaluate (`itsHasBitboards` must be true).
+ * @return The score from the point of view of the player to move (positive is good for that player).
+ */
+int evaluatePosition(const Game& aGame);
+
+/**
+ * @brief Searches the best move of the current player.
+ *
+ * Iterative deepening until `aMaxDepth` or until the time budget is exhausted.
+ * The game is modified during the search and restored before returning.
+ * The helper threads search their own copy of the game and are joined before returning.
+ * A position found in the opening book or won/lost in the endgame tables is answered
+ * without searching (depth 0, no node).
+ * A position found in the analysis cache is answered with its stored result (the depth
+ * and the node count of the search that stored it), a searched position is stored in it.
+ *
+ * @param aGame The game to search (the board must have its bitboards).
+ * @param aSearch The search state (must be created).
+ * @param aTimeBudgetMs Maximum time of the search (in milliseconds).
+ * @param aMaxDepth Maximum depth of the search (1 to `AI_MAX_PLY - 1`).
+ * @return The best move found and the search statistics.
+ */
+AiResult searchBestMove(Game& aGame, AiSearch& aSearch, int aTimeBudgetMs = AI_TIME_BUDGET_MS, int aMaxDepth = AI_MAX_PLY - 1);
+
+/**
+ * @brief Stores the result of a position in the transposition table, as an exact score.
+ *
+ * Used to fill the table before searching (see `preloadAnalysisCache()`), a slot holding
+ * the same position searched deeper is kept.
+ *
+ * @param aSearch The search state (must be created).
+ * @param aKey The Zobrist key of the position.
+ * @param aDepth The depth of the result.
+ * @param aScore The score of the best move for the player to move.
+ * @param aMove The best move.
+ * @param aSize The size of the board.
+ */
+void storeSearchResult(AiSearch& aSearch, uint64_t aKey, int aDepth, int aScore, const Move& aMove, int aSize);
+
+#endif // AI_H
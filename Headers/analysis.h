@@ -0,0 +1,168 @@
+/**
+ * @file analysis.h
+ *
+ * @brief Declarations of the persistent analysis cache.
+ *
+ * The cache keeps the result of the searches (best move, score, depth and node count) in a
+ * file mapped in memory, so a position already analyzed in a previous run is answered without
+ * searching (see `AiSearch::itsAnalysis`), and its results can be loaded in the transposition
+ * table before the first search (`preloadAnalysisCache()`).
+ *
+ * File: an `AnalysisHeader`, then 2^`itsSlotBits` `AnalysisSlot`. The file never grows: the
+ * slots are grouped in buckets of `ANALYSIS_WAYS` indexed by the Zobrist key, and a new position
+ * takes the empty slot of its bucket or the least recently used one (each slot keeps the tick of
+ * the shared clock of its last use).
+ *
+ * The slots are read and written lock-free like the transposition table: `itsCheck` is the key
+ * XOR the other words, so a slot torn by two writers (threads or processes mapping the same
+ * file) is seen as empty. Any number of readers can use the file while it is written.
+ *
+ * Fields are stored in the byte order of the machine (little-endian on the supported targets).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include <atomic>
+#include "typeDef.h"
+#include "ai.h"
+#include "book.h"
+
+/**
+ * @brief Magic bytes at the start of an analysis cache.
+ */
+const char ANALYSIS_MAGIC[4] = {'H', 'N', 'A', 'C'};
+
+/**
+ * @brief Version of the analysis cache format.
+ */
+const uint32_t ANALYSIS_VERSION = 1;
+
+/**
+ * @brief Default number of slots of a new cache (as a power of 2, 8 MiB).
+ */
+const int ANALYSIS_SLOT_BITS = 18;
+
+/**
+ * @brief Number of slots of a bucket (a position can only be stored in the slots of its bucket).
+ */
+const int ANALYSIS_WAYS = 4;
+
+/**
+ * @brief Path of the analysis cache used by the game (in `BOOK_DIRECTORY`, see book.h).
+ */
+const string ANALYSIS_CACHE_PATH = BOOK_DIRECTORY + "/analysis.cache";
+
+/**
+ * @struct AnalysisHeader
+ * @brief First bytes of an analysis cache.
+ */
+struct AnalysisHeader
+{
+    char itsMagic[4] = {ANALYSIS_MAGIC[0], ANALYSIS_MAGIC[1], ANALYSIS_MAGIC[2], ANALYSIS_MAGIC[3]}; /**< `ANALYSIS_MAGIC`. */
+    uint32_t itsVersion = ANALYSIS_VERSION; /**< `ANALYSIS_VERSION`. */
+    uint32_t itsSlotBits = 0;               /**< The file holds 2^itsSlotBits slots. */
+    uint32_t itsPadding = 0;                /**< Unused, always 0. */
+    std::atomic<uint64_t> itsClock{0};      /**< Ticks of the uses of the slots (shared by all the users). */
+    unsigned char itsReserved[40] = {};     /**< Unused, always 0 (the slots start on a cache line). */
+};
+
+static_assert(sizeof(AnalysisHeader) == 64, "The analysis header must take 64 bytes");
+
+/**
+ * @struct AnalysisSlot
+ * @brief One position of an analysis cache.
+ *
+ * `itsData` packs the score (bits 0-15), the depth (16-23), the board size (24-31), the start cell
+ * (32-39) and the end cell (40-47) of the best move, and bit 48 is set in a used slot.
+ */
+struct AnalysisSlot
+{
+    std::atomic<uint64_t> itsCheck{0};    /**< Zobrist key of the position XOR `itsData` XOR `itsNodes`. */
+    std::atomic<uint64_t> itsData{0};     /**< Packed score, depth, size and best move (0 for an empty slot). */
+    std::atomic<uint64_t> itsNodes{0};    /**< Positions visited by the search. */
+    std::atomic<uint64_t> itsLastUse{0};  /**< Tick of `AnalysisHeader::itsClock` of the last store or probe. */
+};
+
+static_assert(sizeof(AnalysisSlot) == 32, "An analysis slot must take 32 bytes");
+
+/**
+ * @struct AnalysisCache
+ * @brief An analysis cache mapped from a file.
+ */
+struct AnalysisCache
+{
+    unsigned char* itsData = nullptr;   /**< The mapped file (nullptr when closed). */
+    uint64_t itsLength = 0;             /**< Size of the mapped file. */
+    void* itsMapping = nullptr;         /**< Handle of the mapping (Windows only). */
+    AnalysisHeader* itsHeader = nullptr; /**< The header of the file. */
+    AnalysisSlot* itsSlots = nullptr;   /**< The slots of the file. */
+    uint64_t itsBucketMask = 0;         /**< Number of buckets minus 1. */
+};
+
+/**
+ * @struct AnalysisEntry
+ * @brief Unpacked content of an `AnalysisSlot`.
+ */
+struct AnalysisEntry
+{
+    Move itsMove = {{-1,-1},{-1,-1}}; /**< The best move. */
+    int itsScore = 0;                 /**< Score of the move for the player to move. */
+    int itsDepth = 0;                 /**< Depth of the search. */
+    long long itsNodes = 0;           /**< Positions visited by the search. */
+};
+
+/**
+ * @brief Maps an analysis cache in memory, read-write, creating the file if it doesn't exist.
+ *
+ * @param aCache The cache to open (must be closed).
+ * @param aPath The path of the file.
+ * @param aSlotBits A new file holds 2^aSlotBits slots (4-28, an existing file keeps its size).
+ * @return `true` if the cache is mapped, `false` if the file can't be created or is not a valid cache.
+ */
+bool openAnalysisCache(AnalysisCache& aCache, const string& aPath, int aSlotBits = ANALYSIS_SLOT_BITS);
+
+/**
+ * @brief Unmaps an analysis cache (the results are kept in the file). Safe to call on a closed cache.
+ *
+ * @param aCache The cache to close.
+ */
+void closeAnalysisCache(AnalysisCache& aCache);
+
+/**
+ * @brief Looks the position of a game up in an analysis cache.
+ *
+ * @param aCache The cache (must be open).
+ * @param aGame The game (the board must have its bitboards and its key).
+ * @param anEntry Set to the result of the position.
+ * @return `true` if the position is in the cache and its move is legal.
+ */
+bool probeAnalysisCache(AnalysisCache& aCache, const Game& aGame, AnalysisEntry& anEntry);
+
+/**
+ * @brief Stores the result of a search in an analysis cache.
+ *
+ * A result of the same position searched deeper is kept. A new position takes an empty slot of
+ * its bucket, or the least recently used one.
+ *
+ * @param aCache The cache (must be open).
+ * @param aGame The searched game (the board must have its key).
+ * @param anEntry The result of the search.
+ */
+void storeAnalysisCache(AnalysisCache& aCache, const Game& aGame, const AnalysisEntry& anEntry);
+
+/**
+ * @brief Copies the results of an analysis cache to a transposition table.
+ *
+ * Each result is stored as an exact score at its depth (see `storeSearchResult()`).
+ *
+ * @param aCache The cache (must be open).
+ * @param aSearch The search state (must be created).
+ * @return The number of results copied.
+ */
+long long preloadAnalysisCache(const AnalysisCache& aCache, AiSearch& aSearch);
+
+#endif // ANALYSIS_H
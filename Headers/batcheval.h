@@ -0,0 +1,185 @@
+/**
+ * @file batcheval.h
+ *
+ * @brief Declarations of the batched evaluation of positions (for external evaluators).
+ *
+ * A batch encodes its positions in one contiguous tensor of floats, position after position,
+ * with `EVAL_PLANE_COUNT` planes of `size * size` cells each (plane cell `row * size + col`):
+ * one plane per piece type (SHIELD, SWORD, KING), one per special cell (FORTRESS, CASTLE)
+ * and one plane set to 1 when ATTACK is to move. The planes are filled from the masks of the
+ * board (its bitboards, or a SIMD scan of the cells, see evalfeatures.h).
+ *
+ * The whole batch is scored by one call to a backend (`EvalBackend`), for instance a neural
+ * network on an accelerator. The search uses it on the positions one ply from its horizon:
+ * all the children of such a node are encoded and evaluated together (see `attachEvaluator()`).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef BATCHEVAL_H
+#define BATCHEVAL_H
+
+#include "typeDef.h"
+
+/**
+ * @enum EvalPlane
+ * @brief The planes of an encoded position, in tensor order.
+ */
+enum EvalPlane
+{
+    PLANE_SHIELD,   /**< 1 on the SHIELD pieces. */
+    PLANE_SWORD,    /**< 1 on the SWORD pieces. */
+    PLANE_KING,     /**< 1 on the KING. */
+    PLANE_FORTRESS, /**< 1 on the FORTRESS cells. */
+    PLANE_CASTLE,   /**< 1 on the CASTLE cell. */
+    PLANE_TO_MOVE,  /**< 1 everywhere if ATTACK is to move, 0 if DEFENSE is to move. */
+    EVAL_PLANE_COUNT /**< Number of planes of a position. */
+};
+
+/**
+ * @brief Number of floats of one encoded position.
+ *
+ * @param aSize The size of the board.
+ * @return `EVAL_PLANE_COUNT * aSize * aSize`.
+ */
+inline int getEvalPositionFloats(BoardSize aSize)
+{
+    return EVAL_PLANE_COUNT * aSize * aSize;
+}
+
+/**
+ * @brief Function of a backend: scores `aCount` encoded positions.
+ *
+ * The scores are from the point of view of ATTACK (positive is good for ATTACK), in the units
+ * of `evaluatePosition()` (a SWORD is worth about 100). The function can be called by several
+ * search threads at the same time, each with its own tensor.
+ *
+ * @param aContext The context of the backend (`EvalBackend::itsContext`).
+ * @param aTensor The encoded positions (`aCount * getEvalPositionFloats(aSize)` floats).
+ * @param aCount The number of positions (at least 1).
+ * @param aSize The size of the boards of the batch.
+ * @param aScores Receives one score per position.
+ * @return `false` if the backend can't evaluate the batch.
+ */
+typedef bool (*EvalBackendFunction)(void* aContext, const float* aTensor, int aCount, BoardSize aSize, int* aScores);
+
+/**
+ * @struct EvalBackend
+ * @brief An evaluator of batches (a function and its context, both owned by the caller).
+ */
+struct EvalBackend
+{
+    EvalBackendFunction itsEvaluate = nullptr; /**< The function scoring a batch. */
+    void* itsContext = nullptr;                /**< Given back to `itsEvaluate` (model, device, ...). */
+};
+
+/**
+ * @struct EvalBatch
+ * @brief Positions waiting to be evaluated together, and their scores.
+ *
+ * Created by `createEvalBatch()` and released by `deleteEvalBatch()`; adding a position never allocates.
+ * All the positions of a batch have the board size of its first position.
+ */
+struct EvalBatch
+{
+    float* itsTensor = nullptr;         /**< The encoded positions (`itsCapacity` positions of a BIG board). */
+    int* itsScores = nullptr;           /**< Score of each position for its player to move (after `evaluateEvalBatch()`). */
+    PlayerRole* itsRoles = nullptr;     /**< Role to move of each position. */
+    int itsCapacity = 0;                /**< Maximum number of positions. */
+    int itsCount = 0;                   /**< Number of positions in the batch. */
+    BoardSize itsSize = LITTLE;         /**< The size of the boards of the batch. */
+};
+
+/**
+ * @struct LinearEvalModel
+ * @brief Reference backend: one weight per plane and per cell, plus a bias.
+ *
+ * The score of a position is the sum of the weights of its cells set to 1, plus the bias
+ * (from the point of view of ATTACK). It shows the expected layout and is thread-safe.
+ */
+struct LinearEvalModel
+{
+    BoardSize itsSize = LITTLE;                  /**< The board size the weights are made for. */
+    float itsWeights[EVAL_PLANE_COUNT][BIG * BIG] = {}; /**< Weight of each plane cell (only `itsSize * itsSize` are used). */
+    float itsBias = 0.0f;                        /**< Added to every score. */
+};
+
+/**
+ * @brief Allocates a batch.
+ *
+ * @param aBatch The batch to initialize (must not be already created).
+ * @param aCapacity Maximum number of positions (1 to `MAX_MOVES`).
+ * @return `true` if the allocation succeeded.
+ */
+bool createEvalBatch(EvalBatch& aBatch, int aCapacity);
+
+/**
+ * @brief Releases a batch.
+ *
+ * @param aBatch The batch to release (pointers are set to nullptr).
+ */
+void deleteEvalBatch(EvalBatch& aBatch);
+
+/**
+ * @brief Empties a batch (the memory is kept).
+ *
+ * @param aBatch The batch.
+ */
+void clearEvalBatch(EvalBatch& aBatch);
+
+/**
+ * @brief Encodes a position in `getEvalPositionFloats()` floats.
+ *
+ * @param aGame The game (LITTLE or BIG board; its bitboards are used when synchronized).
+ * @param aPlanes Receives the planes of the position.
+ * @return `false` (and nothing is written) if the board can't be encoded.
+ */
+bool encodeEvalPosition(const Game& aGame, float* aPlanes);
+
+/**
+ * @brief Adds a position at the end of a batch.
+ *
+ * @param aBatch The batch (must be created).
+ * @param aGame The game to encode.
+ * @return The index of the position in the batch, or -1 if the batch is full, the board size
+ * differs from the one of the batch, or the board can't be encoded.
+ */
+int addEvalPosition(EvalBatch& aBatch, const Game& aGame);
+
+/**
+ * @brief Scores all the positions of a batch with one call to the backend.
+ *
+ * The scores of the backend are turned to the point of view of the player to move of each
+ * position and kept below the win scores of the search.
+ *
+ * @param aBatch The batch (`itsScores` receives the scores).
+ * @param aBackend The backend.
+ * @return `false` if the batch is empty, the backend has no function or it failed.
+ */
+bool evaluateEvalBatch(EvalBatch& aBatch, const EvalBackend& aBackend);
+
+/**
+ * @brief Sets the weights of a linear model to the material and king distance terms of `evaluatePosition()`.
+ *
+ * @param aModel The model.
+ * @param aSize The size of the boards it evaluates.
+ */
+void initializeLinearModel(LinearEvalModel& aModel, BoardSize aSize);
+
+/**
+ * @brief Backend function of a `LinearEvalModel` (the context).
+ *
+ * @return `false` if the size of the batch is not the size of the model.
+ */
+bool evaluateLinearModel(void* aContext, const float* aTensor, int aCount, BoardSize aSize, int* aScores);
+
+/**
+ * @brief Makes a backend evaluating with a linear model.
+ *
+ * @param aModel The model (must outlive the backend).
+ * @return The backend.
+ */
+EvalBackend makeLinearBackend(LinearEvalModel& aModel);
+
+#endif // BATCHEVAL_H
@@ -0,0 +1,172 @@
+/**
+ * @file bench.h
+ *
+ * @brief Declarations of the microbenchmarks of the functions.h API.
+ *
+ * Each benchmark runs one function in a loop on a fixture: a position of a LITTLE or BIG
+ * board, either the starting position or a mid-game position (24 plies of a depth 2 game
+ * of the AI against itself, so every run measures the same position). The loop is run with
+ * 1, 10, 100... iterations until it lasts at least the minimum time, like Google Benchmark.
+ *
+ * The results are written as a table or as Google Benchmark JSON (`benchmarks` array with
+ * `name`, `iterations`, `real_time`, `cpu_time` in nanoseconds and `items_per_second`),
+ * which can be compared with a baseline file of the same format (see `compareBenchmarks()`).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <string>
+#include "typeDef.h"
+#include "saveindex.h"
+
+/**
+ * @enum BenchPhase
+ * @brief The position of a fixture.
+ */
+enum BenchPhase
+{
+    BENCH_OPENING, /**< The position of `initializeBoard()`. */
+    BENCH_MIDGAME, /**< 24 plies of a depth 2 self-play game from the starting position. */
+    BENCH_PHASE_COUNT
+};
+
+/**
+ * @brief Number of captures of the capture fixtures (0 to `BENCH_MAX_CAPTURES`).
+ */
+const int BENCH_MAX_CAPTURES = 4;
+
+/**
+ * @brief Default minimum time of a measure (in seconds).
+ */
+const double BENCH_MIN_TIME = 0.2;
+
+/**
+ * @struct BenchFixture
+ * @brief Everything the benchmarks of one board size and one phase work on.
+ *
+ * Created by `createBenchFixture()` and released by `deleteBenchFixture()`; the loops never allocate
+ * (except `createBoard()`/`deleteBoard()`, which is what they measure).
+ */
+struct BenchFixture
+{
+    BoardSize itsSize = LITTLE;      /**< The size of the board. */
+    BenchPhase itsPhase = BENCH_OPENING; /**< The position of `itsGame`. */
+    Game itsGame;                    /**< The position. */
+    MoveList itsLegalMoves;          /**< The legal moves of the position. */
+    MoveList itsIllegalMoves;        /**< Straight moves of the pieces of the player that are not legal, and diagonals. */
+    Game itsCaptures[BENCH_MAX_CAPTURES + 1]; /**< A SWORD just arrived next to 0 to 4 SHIELD pieces to capture. */
+    Move itsCaptureMove;             /**< The move of the SWORD of the capture fixtures. */
+    Game itsScratch;                 /**< Board overwritten by the benchmarks (a copy of a fixture, a loaded save). */
+    Game itsEncircled;               /**< A KING and its SHIELD pieces enclosed by swords. */
+    SaveIndex itsSaves;              /**< Index of the temporary save directory. */
+    string itsSaveName;              /**< The save written and read by the round trip. */
+};
+
+/**
+ * @brief Function of a benchmark: runs `anIterations` times the measured call.
+ *
+ * @param aFixture The fixture.
+ * @param anArgument The argument of the benchmark (captures, legal or illegal moves...).
+ * @param anIterations The number of iterations.
+ * @return The number of processed items (for `items_per_second`).
+ */
+typedef long long (*BenchFunction)(BenchFixture& aFixture, int anArgument, long long anIterations);
+
+/**
+ * @struct BenchCase
+ * @brief A benchmark and its argument.
+ */
+struct BenchCase
+{
+    const char* itsName;        /**< The name of the benchmark ("isValidMovement/legal"). */
+    BenchFunction itsFunction;  /**< The measured loop. */
+    int itsArgument;            /**< Given to `itsFunction`. */
+    bool itsUsesPhase;          /**< `false` if the position of the fixture is not used (measured once per size). */
+};
+
+/**
+ * @struct BenchResult
+ * @brief The measure of one benchmark on one fixture.
+ */
+struct BenchResult
+{
+    string itsName;             /**< "<case>/<LITTLE|BIG>[/<opening|midgame>]". */
+    long long itsIterations = 0; /**< Iterations of the measured run. */
+    double itsRealNs = 0;       /**< Wall time per iteration (nanoseconds). */
+    double itsCpuNs = 0;        /**< Processor time per iteration (nanoseconds). */
+    double itsItemsPerSecond = 0; /**< Items processed per second of wall time. */
+};
+
+/**
+ * @brief Gets the list of the benchmarks.
+ *
+ * @param aCount Set to the number of benchmarks.
+ * @return The benchmarks (static array).
+ */
+const BenchCase* getBenchCases(int& aCount);
+
+/**
+ * @brief Builds the fixture of a board size and a phase.
+ *
+ * @param aFixture The fixture to fill (must be empty).
+ * @param aSize The size of the board.
+ * @param aPhase The position.
+ * @param aSaveDirectory The directory of the save round trip (created, emptied by `deleteBenchFixture()`).
+ * @return `false` if a board can't be allocated or the save can't be recorded.
+ */
+bool createBenchFixture(BenchFixture& aFixture, BoardSize aSize, BenchPhase aPhase, const string& aSaveDirectory);
+
+/**
+ * @brief Releases a fixture and removes its save directory.
+ *
+ * @param aFixture The fixture.
+ */
+void deleteBenchFixture(BenchFixture& aFixture);
+
+/**
+ * @brief Gets the name of a benchmark on a fixture.
+ *
+ * @param aCase The benchmark.
+ * @param aFixture The fixture.
+ * @return "<case>/<LITTLE|BIG>" followed by "/opening" or "/midgame" if the case uses the phase.
+ */
+string getBenchName(const BenchCase& aCase, const BenchFixture& aFixture);
+
+/**
+ * @brief Measures a benchmark on a fixture.
+ *
+ * @param aCase The benchmark.
+ * @param aFixture The fixture.
+ * @param aMinSeconds Minimum time of the measured run.
+ * @return The measure.
+ */
+BenchResult runBenchmark(const BenchCase& aCase, BenchFixture& aFixture, double aMinSeconds = BENCH_MIN_TIME);
+
+/**
+ * @brief Formats results as a Google Benchmark JSON document.
+ *
+ * @param aResults The results.
+ * @param aCount The number of results.
+ * @return The JSON document (with its last line end).
+ */
+string formatBenchmarkJson(const BenchResult* aResults, int aCount);
+
+/**
+ * @brief Compares results with the ones of a JSON baseline (written by `formatBenchmarkJson()`).
+ *
+ * Prints one line per benchmark found in both (baseline time, new time, change) to `anOutput`.
+ *
+ * @param aResults The new results.
+ * @param aCount The number of results.
+ * @param aBaseline The content of the baseline file.
+ * @param aTolerance Allowed slowdown (0.1 for 10%).
+ * @param anOutput Receives the comparison.
+ * @return The number of benchmarks slower than the baseline by more than the tolerance.
+ */
+int compareBenchmarks(const BenchResult* aResults, int aCount, const string& aBaseline, double aTolerance, string& anOutput);
+
+#endif // BENCH_H
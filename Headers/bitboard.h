@@ -0,0 +1,206 @@
+/**
+ * @file bitboard.h
+ *
+ * @brief Inline helpers to manipulate the `BitBoard` masks of a `Board`.
+ *
+ * A cell (row, col) of a board of size N is stored at bit `row * N + col`.
+ * All helpers are inline because they are called in the hot functions
+ * (move validation, captures, endgame checks).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "typeDef.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Converts a position into a bit index.
+ *
+ * @param aRow The row of the cell.
+ * @param aCol The column of the cell.
+ * @param aSize The size of the board.
+ * @return The index of the bit representing the cell.
+ */
+constexpr int cellIndex(int aRow, int aCol, int aSize)
+{
+    return aRow * aSize + aCol;
+}
+
+/**
+ * @brief Sets the bit of a cell in a mask.
+ *
+ * @param aMask The mask to modify.
+ * @param anIndex The index of the cell (see `cellIndex()`).
+ */
+inline void setBit(BitBoard& aMask, int anIndex)
+{
+    aMask.itsWords[anIndex >> 6] |= uint64_t(1) << (anIndex & 63);
+}
+
+/**
+ * @brief Clears the bit of a cell in a mask.
+ *
+ * @param aMask The mask to modify.
+ * @param anIndex The index of the cell (see `cellIndex()`).
+ */
+inline void clearBit(BitBoard& aMask, int anIndex)
+{
+    aMask.itsWords[anIndex >> 6] &= ~(uint64_t(1) << (anIndex & 63));
+}
+
+/**
+ * @brief Tests the bit of a cell in a mask.
+ *
+ * @param aMask The mask to read.
+ * @param anIndex The index of the cell (see `cellIndex()`).
+ * @return `true` if the bit is set.
+ */
+inline bool testBit(const BitBoard& aMask, int anIndex)
+{
+    return (aMask.itsWords[anIndex >> 6] >> (anIndex & 63)) & 1;
+}
+
+/**
+ * @brief Checks if a mask contains no cell.
+ *
+ * @param aMask The mask to read.
+ * @return `true` if no bit is set.
+ */
+inline bool isEmptyMask(const BitBoard& aMask)
+{
+    return (aMask.itsWords[0] | aMask.itsWords[1] | aMask.itsWords[2]) == 0;
+}
+
+/**
+ * @brief Computes the union of two masks.
+ *
+ * @param aFirst The first mask.
+ * @param aSecond The second mask.
+ * @return A mask containing the cells of both masks.
+ */
+inline BitBoard maskOr(const BitBoard& aFirst, const BitBoard& aSecond)
+{
+    return {{aFirst.itsWords[0] | aSecond.itsWords[0],
+             aFirst.itsWords[1] | aSecond.itsWords[1],
+             aFirst.itsWords[2] | aSecond.itsWords[2]}};
+}
+
+/**
+ * @brief Computes the intersection of two masks.
+ *
+ * @param aFirst The first mask.
+ * @param aSecond The second mask.
+ * @return A mask containing the cells present in both masks.
+ */
+inline BitBoard maskAnd(const BitBoard& aFirst, const BitBoard& aSecond)
+{
+    return {{aFirst.itsWords[0] & aSecond.itsWords[0],
+             aFirst.itsWords[1] & aSecond.itsWords[1],
+             aFirst.itsWords[2] & aSecond.itsWords[2]}};
+}
+
+/**
+ * @brief Shifts a mask towards the higher indexes (like `<<` on a 192-bit integer).
+ *
+ * @param aMask The mask to shift.
+ * @param aBits The number of bits (1-63).
+ * @return The shifted mask (the bits past index 191 are lost).
+ */
+inline BitBoard shiftMaskLeft(const BitBoard& aMask, int aBits)
+{
+    return {{aMask.itsWords[0] << aBits,
+             (aMask.itsWords[1] << aBits) | (aMask.itsWords[0] >> (64 - aBits)),
+             (aMask.itsWords[2] << aBits) | (aMask.itsWords[1] >> (64 - aBits))}};
+}
+
+/**
+ * @brief Shifts a mask towards the lower indexes (like `>>` on a 192-bit integer).
+ *
+ * @param aMask The mask to shift.
+ * @param aBits The number of bits (1-63).
+ * @return The shifted mask (the bits below index 0 are lost).
+ */
+inline BitBoard shiftMaskRight(const BitBoard& aMask, int aBits)
+{
+    return {{(aMask.itsWords[0] >> aBits) | (aMask.itsWords[1] << (64 - aBits)),
+             (aMask.itsWords[1] >> aBits) | (aMask.itsWords[2] << (64 - aBits)),
+             aMask.itsWords[2] >> aBits}};
+}
+
+/**
+ * @brief Counts the set bits of a 64-bit word.
+ *
+ * @param aWord The word to read.
+ * @return The number of set bits.
+ */
+inline int countWordBits(uint64_t aWord)
+{
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(aWord));
+#else
+    return __builtin_popcountll(aWord);
+#endif
+}
+
+/**
+ * @brief Gets the index of the lowest set bit of a non-null 64-bit word.
+ *
+ * @param aWord The word to read (must not be 0).
+ * @return The index of the lowest set bit (0-63).
+ */
+inline int lowestWordBit(uint64_t aWord)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, aWord);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(aWord);
+#endif
+}
+
+/**
+ * @brief Counts the cells of a mask.
+ *
+ * @param aMask The mask to read.
+ * @return The number of set bits.
+ */
+inline int countBits(const BitBoard& aMask)
+{
+    return countWordBits(aMask.itsWords[0]) + countWordBits(aMask.itsWords[1]) + countWordBits(aMask.itsWords[2]);
+}
+
+/**
+ * @brief Gets the index of the first cell of a mask.
+ *
+ * @param aMask The mask to read.
+ * @return The index of the lowest set bit, or -1 if the mask is empty.
+ */
+inline int firstBit(const BitBoard& aMask)
+{
+    for (int word = 0; word < 3; word++) {
+        if (aMask.itsWords[word] != 0) {
+            return word * 64 + lowestWordBit(aMask.itsWords[word]);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Builds the mask of all the occupied cells (SHIELD, SWORD or KING).
+ *
+ * @param aBoard The board to read (`itsHasBitboards` must be true).
+ * @return The occupancy mask.
+ */
+inline BitBoard occupiedMask(const Board& aBoard)
+{
+    return maskOr(maskOr(aBoard.itsPieceMasks[SHIELD], aBoard.itsPieceMasks[SWORD]), aBoard.itsPieceMasks[KING]);
+}
+
+#endif // BITBOARD_H
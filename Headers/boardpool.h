@@ -0,0 +1,83 @@
+/**
+ * @file boardpool.h
+ *
+ * @brief Declarations of the pool of boards and of the board allocation counter.
+ *
+ * A pool allocates the cells of many boards in one block (`BIG` rows per board). Taking a board
+ * from the pool and giving it back are O(1) and never touch the heap, and a pooled board takes
+ * any size without reallocation (see `resizeBoard()`), so the server and the self-play workers
+ * can run any number of games after their start without allocating.
+ *
+ * Every heap block allocated for cells (`createBoard()` and `createBoardPool()`) is counted by
+ * `getBoardAllocationCount()`, to check that a loop of games allocates nothing.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef BOARDPOOL_H
+#define BOARDPOOL_H
+
+#include "typeDef.h"
+
+/**
+ * @struct BoardPool
+ * @brief Cells of a fixed number of boards and the stack of the free ones.
+ */
+struct BoardPool
+{
+    CellRow* itsCells = nullptr; /**< The cells of all the boards (`BIG` rows per board). */
+    int* itsFree = nullptr;      /**< The free boards (stack of indexes). */
+    int itsFreeCount = 0;        /**< Number of free boards. */
+    int itsCapacity = 0;         /**< Number of boards of the pool. */
+};
+
+/**
+ * @brief Allocates a pool of boards.
+ *
+ * @param aPool The pool to initialize (must not be already created).
+ * @param aCapacity The number of boards.
+ * @return `true` if successful, `false` if the capacity is not positive or an allocation failed.
+ */
+bool createBoardPool(BoardPool& aPool, int aCapacity);
+
+/**
+ * @brief Frees a pool of boards (the boards taken from it must not be used anymore).
+ *
+ * @param aPool The pool to release.
+ */
+void deleteBoardPool(BoardPool& aPool);
+
+/**
+ * @brief Takes a board from a pool, in O(1) and without allocation.
+ *
+ * The cells (padding included) are cleared, the board is not initialized.
+ *
+ * @param aPool The pool.
+ * @param aBoard The board receiving the cells (must not have cells).
+ * @param aSize The size of the board.
+ * @return `true` if successful, `false` if the pool is empty or the board already has cells.
+ */
+bool acquireBoard(BoardPool& aPool, Board& aBoard, BoardSize aSize);
+
+/**
+ * @brief Gives a board back to its pool, in O(1).
+ *
+ * @param aPool The pool the board was taken from.
+ * @param aBoard The board (its cells are set to `nullptr`, nothing happens if it is not from the pool).
+ */
+void releaseBoard(BoardPool& aPool, Board& aBoard);
+
+/**
+ * @brief Counts one heap block allocated for cells (called by `createBoard()` and `createBoardPool()`).
+ */
+void countBoardAllocation();
+
+/**
+ * @brief Gets the number of heap blocks allocated for cells since the start of the program (all threads).
+ *
+ * @return The number of allocations.
+ */
+long long getBoardAllocationCount();
+
+#endif // BOARDPOOL_H
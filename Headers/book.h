@@ -0,0 +1,317 @@
+/**
+ * @file book.h
+ *
+ * @brief Declarations of the opening book and of the endgame tables.
+ *
+ * Both are built offline (`Hnefatafl_book`), written to a file and mapped in memory read-only,
+ * so the AI can look a position up before searching (see `AiSearch::itsBook` and `itsEndgames`).
+ *
+ * Opening book: a `BookHeader` followed by `BookEntry` records sorted by Zobrist key. The book
+ * holds the best move found by a deep search for every position reached in the first plies from
+ * the starting position of `initializeBoard()`. A move found in the book is checked with
+ * `checkMovement()` before it is played, so a key collision can't play an illegal move.
+ *
+ * Endgame tables: a `EndgameHeader`, one `EndgameTableInfo` per table, then the values. A table
+ * holds every position of one board size with the KING, `itsShields` SHIELD pieces and
+ * `itsSwords` SWORD pieces, for both roles to move. It is computed by retrograde iteration:
+ * positions without a legal move are lost (same rule as the search), then the wins in 1, the
+ * losses in 2, ... until no position changes. Each value is the distance to the end of the game
+ * in plies, from the point of view of the player to move (`ENDGAME_LOSS` set for a loss, 0 for
+ * a draw or a cycle).
+ *
+ * Fields are stored in the byte order of the machine (little-endian on the supported targets).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "typeDef.h"
+#include "journal.h"
+
+struct AiSearch;
+
+/**
+ * @brief Directory of the book and table files loaded by the game.
+ */
+const string BOOK_DIRECTORY = "Book";
+
+/**
+ * @brief Magic bytes at the start of an opening book.
+ */
+const char BOOK_MAGIC[4] = {'H', 'N', 'O', 'B'};
+
+/**
+ * @brief Version of the opening book format.
+ */
+const uint32_t BOOK_VERSION = 1;
+
+/**
+ * @brief Magic bytes at the start of an endgame tables file.
+ */
+const char ENDGAME_MAGIC[4] = {'H', 'N', 'E', 'G'};
+
+/**
+ * @brief Version of the endgame tables format.
+ */
+const uint32_t ENDGAME_VERSION = 1;
+
+/**
+ * @brief Maximum number of SHIELD pieces of an endgame table.
+ */
+const int ENDGAME_MAX_SHIELDS = 2;
+
+/**
+ * @brief Maximum number of SWORD pieces of an endgame table.
+ */
+const int ENDGAME_MAX_SWORDS = 3;
+
+/**
+ * @brief Maximum number of tables of an endgame file (one per number of shields and swords).
+ */
+const int ENDGAME_MAX_TABLES = (ENDGAME_MAX_SHIELDS + 1) * ENDGAME_MAX_SWORDS;
+
+/**
+ * @brief Maximum number of positions of an endgame table (bigger tables are not built).
+ */
+const uint64_t ENDGAME_MAX_POSITIONS = uint64_t(1) << 27;
+
+/**
+ * @brief Flag of an endgame value: the player to move loses (the low bits are the distance).
+ */
+const unsigned char ENDGAME_LOSS = 0x80;
+
+/**
+ * @brief Longest distance stored in an endgame table (longer ones are stored as draws).
+ */
+const int ENDGAME_MAX_DISTANCE = 126;
+
+/**
+ * @struct BookHeader
+ * @brief First bytes of an opening book.
+ */
+struct BookHeader
+{
+    char itsMagic[4] = {BOOK_MAGIC[0], BOOK_MAGIC[1], BOOK_MAGIC[2], BOOK_MAGIC[3]}; /**< `BOOK_MAGIC`. */
+    uint32_t itsVersion = BOOK_VERSION; /**< `BOOK_VERSION`. */
+    uint64_t itsEntryCount = 0;         /**< Number of entries. */
+};
+
+static_assert(sizeof(BookHeader) == 16, "The book header must take 16 bytes");
+
+/**
+ * @struct BookEntry
+ * @brief The move of one position of an opening book.
+ */
+struct BookEntry
+{
+    uint64_t itsHash = 0;              /**< Zobrist key of the position (`Board::itsHash`). */
+    MoveRecord itsMove;                /**< The best move found. */
+    int16_t itsScore = 0;              /**< Score of the move for the player to move. */
+    unsigned char itsDepth = 0;        /**< Depth of the search that found the move. */
+    unsigned char itsSize = LITTLE;    /**< The size of the board (11 or 13). */
+};
+
+static_assert(sizeof(BookEntry) == 16, "A book entry must take 16 bytes");
+
+/**
+ * @struct OpeningBook
+ * @brief An opening book, mapped from a file or built in memory.
+ */
+struct OpeningBook
+{
+    const unsigned char* itsData = nullptr; /**< The mapped file (nullptr for a book built in memory). */
+    uint64_t itsLength = 0;                 /**< Size of the mapped file. */
+    void* itsMapping = nullptr;             /**< Handle of the mapping (Windows only). */
+    BookEntry* itsOwnedEntries = nullptr;   /**< The entries of a book built in memory. */
+    const BookEntry* itsEntries = nullptr;  /**< The entries, sorted by key. */
+    uint64_t itsEntryCount = 0;             /**< Number of entries. */
+};
+
+/**
+ * @struct EndgameHeader
+ * @brief First bytes of an endgame tables file.
+ */
+struct EndgameHeader
+{
+    char itsMagic[4] = {ENDGAME_MAGIC[0], ENDGAME_MAGIC[1], ENDGAME_MAGIC[2], ENDGAME_MAGIC[3]}; /**< `ENDGAME_MAGIC`. */
+    uint32_t itsVersion = ENDGAME_VERSION; /**< `ENDGAME_VERSION`. */
+    uint32_t itsTableCount = 0;            /**< Number of tables. */
+    uint32_t itsPadding = 0;               /**< Unused, always 0. */
+};
+
+static_assert(sizeof(EndgameHeader) == 16, "The endgame header must take 16 bytes");
+
+/**
+ * @struct EndgameTableInfo
+ * @brief Description of one endgame table of a file.
+ */
+struct EndgameTableInfo
+{
+    unsigned char itsSize = LITTLE;       /**< The size of the board (11 or 13). */
+    unsigned char itsShields = 0;         /**< Number of SHIELD pieces. */
+    unsigned char itsSwords = 0;          /**< Number of SWORD pieces. */
+    unsigned char itsPadding[5] = {0, 0, 0, 0, 0}; /**< Unused, always 0. */
+    uint64_t itsOffset = 0;               /**< Offset of the values (from the start of the file in a file, from `EndgameTables::itsValues` in memory). */
+    uint64_t itsCount = 0;                /**< Number of values (positions of both roles to move). */
+};
+
+static_assert(sizeof(EndgameTableInfo) == 24, "An endgame table description must take 24 bytes");
+
+/**
+ * @struct EndgameTables
+ * @brief The endgame tables of one board size, mapped from a file or built in memory.
+ */
+struct EndgameTables
+{
+    const unsigned char* itsData = nullptr; /**< The mapped file (nullptr for tables built in memory). */
+    uint64_t itsLength = 0;                 /**< Size of the mapped file. */
+    void* itsMapping = nullptr;             /**< Handle of the mapping (Windows only). */
+    unsigned char* itsOwnedValues = nullptr; /**< The values of tables built in memory (all tables, one block). */
+    EndgameTableInfo itsTables[ENDGAME_MAX_TABLES]; /**< The tables (`itsOffset` is from `itsValues`). */
+    int itsTableCount = 0;                  /**< Number of tables. */
+    const unsigned char* itsValues = nullptr; /**< The values of all the tables. */
+};
+
+// ============================================================================
+// SECTION 1: OPENING BOOK
+// ============================================================================
+
+/**
+ * @brief Gets the path of the opening book of a board size in `BOOK_DIRECTORY`.
+ *
+ * @param aSize The size of the board.
+ * @return "Book/opening-11.book" or "Book/opening-13.book".
+ */
+string getOpeningBookPath(BoardSize aSize);
+
+/**
+ * @brief Builds an opening book by searching every position of the first plies.
+ *
+ * All the moves of both players are followed from the starting position, so the book answers
+ * whichever role the AI plays. Positions reached by several move orders are searched once.
+ *
+ * @param aBook The book receiving the entries (must be empty).
+ * @param aSize The size of the board.
+ * @param aPlies Positions up to `aPlies - 1` moves from the start are searched (1 for the start only).
+ * @param aSearch The search state (created by the caller, its book and tables are not used).
+ * @param aDepth Depth of each search.
+ * @param aTimeBudgetMs Time budget of each search (in milliseconds).
+ * @param aMaxPositions Maximum number of searched positions.
+ * @return `true` if the book is built, `false` on invalid arguments or allocation failure.
+ */
+bool buildOpeningBook(OpeningBook& aBook, BoardSize aSize, int aPlies, AiSearch& aSearch, int aDepth, int aTimeBudgetMs, int aMaxPositions);
+
+/**
+ * @brief Writes an opening book to a file.
+ *
+ * @param aBook The book.
+ * @param aPath The path of the file (replaced).
+ * @return `true` if the whole file was written.
+ */
+bool writeOpeningBook(const OpeningBook& aBook, const string& aPath);
+
+/**
+ * @brief Maps an opening book in memory.
+ *
+ * @param aBook The book to open (must be empty).
+ * @param aPath The path of the file.
+ * @return `true` if the book is mapped and valid (header, length, sorted keys).
+ */
+bool openOpeningBook(OpeningBook& aBook, const string& aPath);
+
+/**
+ * @brief Unmaps or frees an opening book. Safe to call on an empty book.
+ *
+ * @param aBook The book to close.
+ */
+void closeOpeningBook(OpeningBook& aBook);
+
+/**
+ * @brief Looks the position of a game up in an opening book.
+ *
+ * @param aBook The book.
+ * @param aGame The game (the board must have its bitboards and its key).
+ * @param aMove Set to the move of the book.
+ * @param aScore Set to the score of the move.
+ * @return `true` if the position is in the book and its move is legal.
+ */
+bool probeOpeningBook(const OpeningBook& aBook, const Game& aGame, Move& aMove, int& aScore);
+
+// ============================================================================
+// SECTION 2: ENDGAME TABLES
+// ============================================================================
+
+/**
+ * @brief Gets the path of the endgame tables of a board size in `BOOK_DIRECTORY`.
+ *
+ * @param aSize The size of the board.
+ * @return "Book/endgame-11.tables" or "Book/endgame-13.tables".
+ */
+string getEndgameTablesPath(BoardSize aSize);
+
+/**
+ * @brief Computes the endgame tables of a board size, with up to a number of shields and swords.
+ *
+ * The tables are computed from the smallest (the KING against one SWORD) to the biggest,
+ * because a capture leads to a smaller table. Tables with more than `ENDGAME_MAX_POSITIONS`
+ * positions are skipped.
+ *
+ * @param aTables The tables to build (must be empty).
+ * @param aSize The size of the board.
+ * @param aMaxShields Maximum number of SHIELD pieces (0 to `ENDGAME_MAX_SHIELDS`).
+ * @param aMaxSwords Maximum number of SWORD pieces (1 to `ENDGAME_MAX_SWORDS`).
+ * @return `true` if the tables are built, `false` on invalid arguments or allocation failure.
+ */
+bool buildEndgameTables(EndgameTables& aTables, BoardSize aSize, int aMaxShields, int aMaxSwords);
+
+/**
+ * @brief Writes endgame tables to a file.
+ *
+ * @param aTables The tables.
+ * @param aPath The path of the file (replaced).
+ * @return `true` if the whole file was written.
+ */
+bool writeEndgameTables(const EndgameTables& aTables, const string& aPath);
+
+/**
+ * @brief Maps endgame tables in memory.
+ *
+ * @param aTables The tables to open (must be empty).
+ * @param aPath The path of the file.
+ * @return `true` if the tables are mapped and valid (header, sizes and offsets).
+ */
+bool openEndgameTables(EndgameTables& aTables, const string& aPath);
+
+/**
+ * @brief Unmaps or frees endgame tables. Safe to call on empty tables.
+ *
+ * @param aTables The tables to close.
+ */
+void closeEndgameTables(EndgameTables& aTables);
+
+/**
+ * @brief Gets the value of the position of a game in the endgame tables.
+ *
+ * @param aTables The tables.
+ * @param aGame The game (the board must have its bitboards, the game must be in progress).
+ * @return The value (0 for a draw, the distance with `ENDGAME_LOSS` for a loss), or -1 if no table holds the position.
+ */
+int getEndgameValue(const EndgameTables& aTables, const Game& aGame);
+
+/**
+ * @brief Finds the best move of a position of the endgame tables.
+ *
+ * The fastest win, or the longest loss. A drawn position is left to the search.
+ *
+ * @param aTables The tables.
+ * @param aGame The game (modified during the probe and restored).
+ * @param aMove Set to the best move.
+ * @param aScore Set to the score of the move (`AI_WIN_SCORE` minus the distance for a win).
+ * @return `true` if the position is won or lost in the tables.
+ */
+bool probeEndgameTables(const EndgameTables& aTables, Game& aGame, Move& aMove, int& aScore);
+
+#endif // BOOK_H
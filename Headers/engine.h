@@ -0,0 +1,192 @@
+/**
+ * @file engine.h
+ *
+ * @brief Declaration of the rules engine specialized at compile time for each board size.
+ *
+ * `Engine<LITTLE>` and `Engine<BIG>` hold the geometry of a board size as constants
+ * (fortress corners, castle center, starting layout, masks) and the core rules
+ * (move validation, move generation, captures, encirclement of the king) written with
+ * the size as a constant, so the compiler can unroll the loops and replace the divisions.
+ * The public functions of `functions.h` pick the engine of `itsSize` once per call;
+ * `perft()` picks it once for the whole count.
+ *
+ * The members are defined in functions.cpp, which instantiates both engines.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "typeDef.h"
+
+/**
+ * @struct Engine
+ * @brief The rules of the game for boards of size `SIZE` (LITTLE or BIG).
+ *
+ * @tparam SIZE The size of the board.
+ */
+template <int SIZE>
+struct Engine
+{
+    static_assert(SIZE == LITTLE || SIZE == BIG, "An engine only exists for LITTLE and BIG boards");
+
+    /**
+     * @brief Number of cells of the board.
+     */
+    static constexpr int CELLS = SIZE * SIZE;
+
+    /**
+     * @brief Row and column of the castle.
+     */
+    static constexpr int CENTER = SIZE / 2;
+
+    /**
+     * @brief Number of 64-bit words of a `BitBoard` used by the board (2 for LITTLE, 3 for BIG).
+     */
+    static constexpr int WORDS = (CELLS + 63) / 64;
+
+    /**
+     * @brief Checks if a cell is a fortress (one of the 4 corners).
+     *
+     * @param aRow The row of the cell.
+     * @param aCol The column of the cell.
+     * @return `true` for the corners.
+     */
+    static constexpr bool isFortress(int aRow, int aCol) {
+        return (aRow == 0 || aRow == SIZE - 1) && (aCol == 0 || aCol == SIZE - 1);
+    }
+
+    /**
+     * @brief Checks if a cell is the castle (the center).
+     *
+     * @param aRow The row of the cell.
+     * @param aCol The column of the cell.
+     * @return `true` for the center.
+     */
+    static constexpr bool isCastle(int aRow, int aCol) {
+        return aRow == CENTER && aCol == CENTER;
+    }
+
+    /**
+     * @brief Gets the type of a cell (the same for the whole game).
+     *
+     * @param aRow The row of the cell.
+     * @param aCol The column of the cell.
+     * @return FORTRESS, CASTLE or NORMAL.
+     */
+    static constexpr CellType cellType(int aRow, int aCol) {
+        return isFortress(aRow, aCol) ? FORTRESS : isCastle(aRow, aCol) ? CASTLE : NORMAL;
+    }
+
+    /**
+     * @brief Gets the piece of a cell in the starting layout.
+     *
+     * The KING is on the castle, its SHIELD pieces form a cross around it (2 cells wide on LITTLE
+     * with the 4 diagonal cells, 3 cells wide on BIG), and the SWORD pieces form a T on each side:
+     * the 5 middle cells of the border and the cell in front of their center.
+     *
+     * @param aRow The row of the cell.
+     * @param aCol The column of the cell.
+     * @return The piece at the start of a game.
+     */
+    static constexpr PieceType startingPiece(int aRow, int aCol) {
+        const int ARM = (SIZE == LITTLE) ? 2 : 3;
+        const int ROW_GAP = (aRow > CENTER) ? aRow - CENTER : CENTER - aRow;
+        const int COL_GAP = (aCol > CENTER) ? aCol - CENTER : CENTER - aCol;
+        if (ROW_GAP == 0 && COL_GAP == 0) {
+            return KING;
+        }
+        if ((ROW_GAP == 0 && COL_GAP <= ARM) || (COL_GAP == 0 && ROW_GAP <= ARM) || (SIZE == LITTLE && ROW_GAP == 1 && COL_GAP == 1)) {
+            return SHIELD;
+        }
+        const bool IS_BORDER_ROW = aRow == 0 || aRow == SIZE - 1;
+        const bool IS_BORDER_COL = aCol == 0 || aCol == SIZE - 1;
+        if ((IS_BORDER_ROW && COL_GAP <= 2) || (IS_BORDER_COL && ROW_GAP <= 2)
+            || ((aRow == 1 || aRow == SIZE - 2) && COL_GAP == 0) || ((aCol == 1 || aCol == SIZE - 2) && ROW_GAP == 0)) {
+            return SWORD;
+        }
+        return NONE;
+    }
+
+    /**
+     * @brief Builds the mask of the cells of a given type.
+     *
+     * @param aType The cell type.
+     * @return The mask (bit `row * SIZE + col`).
+     */
+    static constexpr BitBoard cellMask(CellType aType) {
+        BitBoard mask;
+        for (int index = 0 ; index < CELLS ; index++) {
+            if (cellType(index / SIZE, index % SIZE) == aType) {
+                mask.itsWords[index >> 6] |= uint64_t(1) << (index & 63);
+            }
+        }
+        return mask;
+    }
+
+    /**
+     * @brief Mask of the fortresses.
+     */
+    static constexpr BitBoard FORTRESS_MASK = cellMask(FORTRESS);
+
+    /**
+     * @brief Mask of the castle.
+     */
+    static constexpr BitBoard CASTLE_MASK = cellMask(CASTLE);
+
+    /**
+     * @brief Puts the board in the starting layout, then builds its bitboards and its key (ATTACK to move).
+     *
+     * @param aBoard The board (`itsCells` allocated, `itsSize` equal to `SIZE`).
+     */
+    static void initialize(Board& aBoard);
+
+    /**
+     * @brief Checks a move for the current player without printing anything (see `checkMovement()`).
+     *
+     * @param aGame Current game state (board of size `SIZE`).
+     * @param aMove The move to validate.
+     * @return `VALID_MOVE` if the move is valid, the reason of the rejection otherwise.
+     */
+    static MoveStatus checkMovement(const Game& aGame, const Move& aMove);
+
+    /**
+     * @brief Generates all the legal moves of the current player (see `generateMoves()`).
+     *
+     * @param aGame Current game state (board of size `SIZE`).
+     * @param aList The list receiving the moves (its previous content is discarded).
+     * @return The number of moves generated.
+     */
+    static int generateMoves(const Game& aGame, MoveList& aList);
+
+    /**
+     * @brief Removes the pieces captured by a move (see `capturePieces()`).
+     *
+     * @param aGame Current game state (board of size `SIZE`).
+     * @param aMove The executed move.
+     * @return The captured neighbors, bit d set for direction d (west, east, north, south).
+     */
+    static int capturePieces(Game& aGame, const Move& aMove);
+
+    /**
+     * @brief Plays a move and records how to undo it (see `makeMove()`).
+     *
+     * @param aGame Current game state (board of size `SIZE`).
+     * @param aMove The move to play (must be valid).
+     * @return The undo record to give to `unmakeMove()`.
+     */
+    static MoveUndo makeMove(Game& aGame, const Move& aMove);
+
+    /**
+     * @brief Checks if the group of KING and SHIELD pieces of a cell is enclosed (see `isKingCapturedRecursive()`).
+     *
+     * @param aBoard The board (size `SIZE`).
+     * @param aStart `cellIndex()` of a KING or SHIELD of the group.
+     * @return `true` if no cell of the group touches an empty NORMAL cell.
+     */
+    static bool isEncircled(const Board& aBoard, int aStart);
+};
+
+#endif // ENGINE_H
@@ -0,0 +1,107 @@
+/**
+ * @file evalfeatures.h
+ *
+ * @brief Declarations of the whole-board scans and of the evaluation features.
+ *
+ * A scan reads the byte-packed cells of a board (one byte per cell, rows of `BIG` cells)
+ * and builds the masks of the pieces and of the special cells with SIMD compares:
+ * SSE2 or AVX2 on x86, NEON on ARM64, and a scalar version everywhere. The best kernel
+ * supported by the CPU is picked at runtime, on first use.
+ *
+ * The features (material, king safety, mobility) are then computed on the masks with
+ * a few shifts and bit counts per direction, for the AI and for the analysis tools.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef EVALFEATURES_H
+#define EVALFEATURES_H
+
+#include "typeDef.h"
+
+/**
+ * @enum FeatureKernel
+ * @brief The implementations of the board scan.
+ */
+enum FeatureKernel
+{
+    KERNEL_SCALAR, /**< Portable loop over the cells. */
+    KERNEL_SSE2,   /**< 16 cells per compare (x86). */
+    KERNEL_AVX2,   /**< 32 cells per compare (x86, checked at runtime). */
+    KERNEL_NEON,   /**< 16 cells per compare (ARM64). */
+    KERNEL_COUNT   /**< Number of kernels. */
+};
+
+/**
+ * @struct EvalFeatures
+ * @brief Features of a position, from the cells point of view (not from the player to move).
+ */
+struct EvalFeatures
+{
+    int itsSwordCount = 0;           /**< Number of SWORD pieces. */
+    int itsShieldCount = 0;          /**< Number of SHIELD pieces. */
+    bool itsHasKing = false;         /**< true if the KING is on the board (the king features are 0 otherwise). */
+    int itsKingFortressDistance = 0; /**< Rows plus columns between the KING and the nearest corner. */
+    int itsKingOpenLines = 0;        /**< Corners the KING can reach through empty cells in one move (0-2). */
+    int itsKingHostileSides = 0;     /**< Sides of the KING that are out of the board, SWORD, CASTLE or FORTRESS (0-4). */
+    int itsSwordsNearKing = 0;       /**< SWORD pieces in the 5x5 square centered on the KING. */
+    int itsAttackMobility = -1;      /**< Number of legal moves of ATTACK (-1 if not computed). */
+    int itsDefenseMobility = -1;     /**< Number of legal moves of DEFENSE (-1 if not computed). */
+};
+
+/**
+ * @brief Checks if a kernel can run on this CPU (and was compiled in).
+ *
+ * @param aKernel The kernel.
+ * @return `true` if `selectFeatureKernel()` can use it.
+ */
+bool isFeatureKernelSupported(FeatureKernel aKernel);
+
+/**
+ * @brief Chooses the kernel used by the scans (the best supported one is used by default).
+ *
+ * @param aKernel The kernel.
+ * @return `false` (and nothing changes) if the kernel is not supported.
+ */
+bool selectFeatureKernel(FeatureKernel aKernel);
+
+/**
+ * @brief Gets the kernel used by the scans.
+ *
+ * @return The selected kernel.
+ */
+FeatureKernel getFeatureKernel();
+
+/**
+ * @brief Gets the name of a kernel.
+ *
+ * @param aKernel The kernel.
+ * @return "scalar", "sse2", "avx2", "neon", or "unknown".
+ */
+const char* getFeatureKernelName(FeatureKernel aKernel);
+
+/**
+ * @brief Builds the masks of the pieces and of the special cells from the cells.
+ *
+ * @param aBoard The board to scan (`itsCells` allocated, size from 1 to `BIG`; its bitboards are not used).
+ * @param aPieceMasks Receives one mask per piece type (the NONE mask is empty).
+ * @param aCellMasks Receives one mask per cell type (the NORMAL mask is empty).
+ * @return `false` (and the masks are not modified) if the board can't be scanned.
+ */
+bool scanBoardMasks(const Board& aBoard, BitBoard aPieceMasks[4], BitBoard aCellMasks[3]);
+
+/**
+ * @brief Computes the features of a position.
+ *
+ * Reads the bitboards of the board when they are synchronized, scans the cells otherwise.
+ * The mobility counts the same moves as `generateMoves()`, without building the list.
+ *
+ * @param aBoard The board (LITTLE or BIG).
+ * @param aFeatures Receives the features.
+ * @param aWithMobility `false` to skip the mobility (the most expensive feature).
+ * @return `false` (and `aFeatures` is reset) if the board is not LITTLE or BIG or has no cells.
+ */
+bool computeEvalFeatures(const Board& aBoard, EvalFeatures& aFeatures, bool aWithMobility = true);
+
+#endif // EVALFEATURES_H
@@ -14,6 +14,7 @@
 #define FUNCTIONS_H
 
 #include "typeDef.h"
+#include "saveindex.h"
 
 // ============================================================================
 // SECTION 1: TERMINAL & DISPLAY FUNCTIONS
@@ -44,8 +45,8 @@ bool clearConsole();
 /**
  * @brief Displays the game logo in ASCII art.
  *
- * Prints the Hnefatafl game logo with stylized text and credit line.
- * Best called after `clearConsole()` for clean display.
+ * Clears the console, then prints the Hnefatafl game logo (`HNEFATAFL_LOGO`) in a single write.
+ * The game screen uses `renderGame()` instead, which doesn't clear the console every turn.
  *
  * @note Uses UTF-8 block characters. Call `enableTerminalFormatting()` first for proper Windows display.
  */
@@ -69,8 +70,8 @@ bool chooseSizeBoard(BoardSize& aBoardSize);
 /**
  * @brief Dynamically creates a game board.
  *
- * Allocates memory for a 2D array of cells. Validates board size and checks for existing allocation.
- * Cleans up memory on failure to avoid leaks.
+ * Allocates the cells in a single contiguous block (`itsSize` rows of `BIG` one-byte cells).
+ * Validates board size (1 to BIG) and checks for existing allocation.
  *
  * @param aBoard Reference to the Board object (`itsSize` must be set).
  * @return `true` if successful, `false` on allocation failure or invalid input.
@@ -80,18 +81,64 @@ bool createBoard(Board& aBoard);
 /**
  * @brief Frees the memory allocated for the game board.
  *
- * Deallocates the 2D array of cells and sets `itsCells` to `nullptr`.
+ * Deallocates the block of cells and sets `itsCells` to `nullptr`.
  * Safe to call multiple times (does nothing if already freed).
+ * A board of a `BoardPool` keeps its cells, they go back with `releaseBoard()`.
  *
  * @param aBoard Reference to the Board object to deallocate.
  */
 void deleteBoard(Board& aBoard);
 
+/**
+ * @brief Gives a board the cells of a size, allocating only if needed.
+ *
+ * A board allocated with another size is reallocated. A board of a `BoardPool` has `BIG` rows,
+ * it takes any size without allocation (its cells are cleared when the size changes).
+ *
+ * @param aBoard The board (allocated or not).
+ * @param aSize The size wanted.
+ * @return `true` if the board has its cells, `false` if the allocation failed.
+ */
+bool resizeBoard(Board& aBoard, BoardSize aSize);
+
+/**
+ * @brief Copies a board (cells, bitboards and key) into another one.
+ *
+ * The destination is allocated (or reallocated if its size differs), then the whole
+ * block of cells is copied with a single `memcpy`.
+ *
+ * @param aSource The board to copy (`itsCells` must be allocated).
+ * @param aDestination The board receiving the copy.
+ * @return `true` if successful, `false` if the source is not allocated or the allocation failed.
+ */
+bool copyBoard(const Board& aSource, Board& aDestination);
+
+/**
+ * @brief Copies the position of a game into a snapshot.
+ *
+ * @param aGame The game to copy (`itsCells` must be allocated).
+ * @return A snapshot holding the cells, the players roles, the player to move and the key.
+ */
+GameSnapshot takeSnapshot(const Game& aGame);
+
+/**
+ * @brief Rebuilds a game from a snapshot.
+ *
+ * The board of `aGame` is (re)allocated if needed, the bitboards are rebuilt and
+ * `itsCurrentPlayer` points to the player of `aGame` stored in the snapshot.
+ *
+ * @param aSnapshot The snapshot to read.
+ * @param aGame The game to overwrite (its player names are kept).
+ * @return `true` if the game was rebuilt, `false` if the snapshot is invalid or the allocation failed.
+ */
+bool restoreSnapshot(const GameSnapshot& aSnapshot, Game& aGame);
+
 /**
  * @brief Displays the game board with piece positions and labels.
  *
  * Shows the board with column numbers (1-N) and row letters (A-N).
  * Displays pieces (shields, swords, king) and special cells (castle, fortresses).
+ * The text is composed in a stack buffer by `writeBoardText()` and written in one call.
  *
  * @param aBoard The game board object to display.
  * @note Handles both LITTLE (11x11) and BIG (13x13) board sizes.
@@ -105,10 +152,36 @@ void displayBoard(const Board& aBoard);
  * shields (12 defenders), and swords (24 attackers) based on board size.
  *
  * @param aBoard The board object to initialize (`itsCells` must be allocated, `itsSize` must be set).
- * @note Adjusts piece positions for LITTLE (11x11) vs BIG (13x13) boards.
+ * @note The layouts of LITTLE (11x11) and BIG (13x13) boards are generated at compile time
+ *       (see `Engine::startingPiece()`), a board of another size is left unchanged.
+ *       Also builds the bitboards and `itsHash` (ATTACK to move).
  */
 void initializeBoard(Board& aBoard);
 
+/**
+ * @brief Rebuilds the bitboards of the board from its cells.
+ *
+ * Fills one mask per piece type (SHIELD, SWORD, KING) and per special cell type (FORTRESS, CASTLE)
+ * with `scanBoardMasks()`, counts the pieces, finds the KING and computes the game status,
+ * then sets `itsHasBitboards` so the hot functions use them instead of scanning `itsCells`.
+ *
+ * @param aBoard The board to update (`itsCells` must be allocated, `itsSize` must be set).
+ * @note Called by `initializeBoard()`. Call it again after editing `itsCells` directly.
+ */
+void updateBitboards(Board& aBoard);
+
+/**
+ * @brief Computes the Zobrist key of a position from scratch.
+ *
+ * XORs one fixed random key per (cell, piece) and a side key when DEFENSE is to move.
+ * Only used to (re)initialize `itsHash`; the other functions update it incrementally.
+ *
+ * @param aBoard The board to read (`itsCells` must be allocated).
+ * @param aRoleToMove The role of the player to move.
+ * @return The 64-bit key of the position.
+ */
+uint64_t computeHash(const Board& aBoard, PlayerRole aRoleToMove);
+
 // ============================================================================
 // SECTION 3: POSITION MANAGEMENT
 // ============================================================================
@@ -152,6 +225,21 @@ bool isEmptyCell(const Board& aBoard, const Position& aPos);
 // SECTION 4: MOVEMENT & ACTIONS
 // ============================================================================
 
+/**
+ * @brief Checks a move for the current player without printing anything.
+ *
+ * Validates, in this order: board bounds, piece ownership (SWORD for ATTACK, SHIELD/KING for DEFENSE),
+ * special cell restrictions (only KING can finish on FORTRESS/CASTLE), horizontal/vertical movement only,
+ * and a free path (no piece or special cell crossed, empty end cell).
+ *
+ * @param aGame Current game state (player, board).
+ * @param aMove The move to validate (start and end positions).
+ * @return `VALID_MOVE` if the move is valid, the reason of the rejection otherwise.
+ * @note The text of the errors is displayed by `playGame()` only.
+ *       Every move is `OUT_OF_BOUNDS` on boards other than LITTLE or BIG.
+ */
+MoveStatus checkMovement(const Game& aGame, const Move& aMove);
+
 /**
  * @brief Checks if a move is valid for the current player.
  *
@@ -162,6 +250,7 @@ bool isEmptyCell(const Board& aBoard, const Position& aPos);
  * @param aGame Current game state (player, board).
  * @param aMove The move to validate (start and end positions).
  * @return `true` if move is valid, `false` otherwise.
+ * @note Prints nothing, use `checkMovement()` to know why a move is rejected.
  */
 bool isValidMovement(const Game& aGame, const Move& aMove);
 
@@ -174,6 +263,7 @@ bool isValidMovement(const Game& aGame, const Move& aMove);
  * @param aGame Current game state.
  * @param aMove The move to execute (start and end positions).
  * @note Assumes move is valid. Use `isValidMovement()` first to validate.
+ *       Keeps the bitboards, the piece counts, the game status and `itsHash` synchronized.
  */
 void movePiece(Game& aGame, const Move& aMove);
 
@@ -183,19 +273,64 @@ void movePiece(Game& aGame, const Move& aMove);
  * Checks all 4 cardinal directions from move end position. Applies capture rules:
  * - ATTACK captures SHIELD when sandwiched between SWORD/FORTRESS/empty CASTLE
  * - DEFENSE captures SWORD when sandwiched between SHIELD/KING/FORTRESS/CASTLE
+ * The border of the board is not hostile: a piece against the border can't be captured from the other side.
+ * Neighbors and anvils come from a table built at compile time for each size; with bitboards, the enemies and
+ * the anvils are masks and each direction is two bit tests.
  *
  * @param aGame Current game state.
  * @param aMove The executed move (uses end position for capture check).
+ * @return The captured neighbors, bit d set for direction d (west, east, north, south, as `MoveUndo`).
  * @note Assumes move already validated and executed. Modifies board to remove captured pieces.
+ *       Keeps the bitboards, the piece counts, the game status and `itsHash` synchronized.
+ *       Nothing is captured on boards other than LITTLE or BIG.
  */
-void capturePieces(Game& aGame, const Move& aMove);
+int capturePieces(Game& aGame, const Move& aMove);
+
+/**
+ * @brief Plays a move and records how to undo it.
+ *
+ * Calls `movePiece()`, `capturePieces()` and `switchCurrentPlayer()`, and records the moved piece,
+ * the captured neighbors and the previous current player. No allocation, no board copy.
+ *
+ * @param aGame Current game state.
+ * @param aMove The move to play (must be valid).
+ * @return The undo record to give to `unmakeMove()`.
+ * @note On boards other than LITTLE or BIG, the piece is moved and the player switched, nothing is captured.
+ */
+MoveUndo makeMove(Game& aGame, const Move& aMove);
+
+/**
+ * @brief Restores the game state as it was before a `makeMove()`.
+ *
+ * Gives the captured pieces back, moves the piece back to its start position
+ * and restores the current player. Bitboards are kept synchronized.
+ *
+ * @param aGame Current game state (must be the state right after the matching `makeMove()`).
+ * @param anUndo The record returned by `makeMove()`.
+ */
+void unmakeMove(Game& aGame, const MoveUndo& anUndo);
+
+/**
+ * @brief Generates all the legal moves of the current player.
+ *
+ * Slides every piece of `itsCurrentPlayer` along rays computed at compile time (one per direction and per cell,
+ * for LITTLE and BIG boards) and applies the same rules as `isValidMovement()`:
+ * pieces stop before any piece or special cell, only the KING can finish on a FORTRESS/CASTLE,
+ * and no piece can cross a FORTRESS/CASTLE.
+ *
+ * @param aGame Current game state (player, board).
+ * @param aList The list receiving the moves (its previous content is discarded).
+ * @return The number of moves generated (also stored in `aList.itsCount`).
+ * @note Prints nothing. Returns 0 for board sizes other than LITTLE or BIG.
+ */
+int generateMoves(const Game& aGame, MoveList& aList);
 
 /**
  * @brief Switches the active player.
  *
  * Toggles between Player1 and Player2 for alternating turns.
  *
- * @param aGame Reference to the Game object (updates `itsCurrentPlayer`).
+ * @param aGame Reference to the Game object (updates `itsCurrentPlayer` and the side key of `itsHash`).
  */
 void switchCurrentPlayer(Game& aGame);
 
@@ -213,6 +348,17 @@ void switchCurrentPlayer(Game& aGame);
  */
 bool isSwordLeft(const Board& aBoard);
 
+/**
+ * @brief Counts the pieces of a given type on the board.
+ *
+ * Reads the cached count when bitboards are available, scans the board otherwise.
+ *
+ * @param aBoard The game board to check.
+ * @param aPiece The piece type to count (SHIELD, SWORD or KING).
+ * @return The number of pieces of this type, 0 for NONE.
+ */
+int countPieces(const Board& aBoard, PieceType aPiece);
+
 /**
  * @brief Gets the king's position on the board.
  *
@@ -246,19 +392,32 @@ bool isKingEscaped(const Board& aBoard);
 bool isKingCapturedSimple(const Board& aBoard);
 
 /**
- * @brief Checks if the king is captured (recursive version with escape detection).
+ * @brief Checks if the king is captured (encirclement of the king and its shields).
  *
- * Advanced version: explores SHIELD chains recursively to find escape routes.
- * King captured only if completely blocked with no path to free cells.
- * Automatically manages memory for visited cell tracking.
+ * Flood-fills the group of KING and SHIELD pieces connected to the king (orthogonally)
+ * with an explicit stack and a `BitBoard` of visited cells: no recursion, no allocation.
+ * King captured only if no cell of the group touches a free cell (empty NORMAL cell);
+ * borders, SWORD pieces, FORTRESS and CASTLE cells are hostile.
+ * This includes the simple capture (`isKingCapturedSimple()`) of a king without shields.
  *
  * @param aBoard The game board to check.
- * @param aKingPos Position to check (default {-1,-1} auto-detects king).
- * @param isCellChecked Internal tracking array (default nullptr, auto-initialized).
- * @return `true` if king completely blocked, `false` if escape route exists.
- * @note Advanced version for bonus points. Call with default params: `isKingCapturedRecursive(board)`.
+ * @param aKingPos Position to start from (default {-1,-1} auto-detects king).
+ * @return `true` if the group is completely enclosed, `false` if a free cell is reachable.
+ * @note Always `false` on boards other than LITTLE or BIG.
+ *       Called after every move by the game status update, so encirclement wins the game for ATTACK.
  */
-bool isKingCapturedRecursive(const Board& aBoard, Position aKingPos = {-1, -1}, bool** isCellChecked = nullptr);
+bool isKingCapturedRecursive(const Board& aBoard, Position aKingPos = {-1, -1});
+
+/**
+ * @brief Gets the state of the game on a board.
+ *
+ * Reads the cached `itsStatus` when the bitboards are synchronized (O(1)),
+ * otherwise uses `isKingCapturedRecursive()`, `isSwordLeft()` and `isKingEscaped()`.
+ *
+ * @param aBoard The game board to check.
+ * @return The status, in the priority order of `whoWon()`.
+ */
+GameStatus getGameStatus(const Board& aBoard);
 
 /**
  * @brief Checks if the game has ended.
@@ -292,64 +451,107 @@ const Player* whoWon(const Game& aGame);
  * @brief create save of game when game is starting.
  *
  * Create a new file of save with selected name
- *  -if name is already used : overwrite suggestion
- *  -if maximum number of save (5) is reached : overwrite suggestion (on selected save)
+ *  -if name is already used (in the save index) : overwrite suggestion
+ *  -if the name can't be used (see `isValidSaveName()`) : return false
  *  -if you choose to not overwrite a save , the game will not be able to save and return false.
+ *  -there is no limit on the number of saves
  *
- *@note all save files will be stocked on the folder /save
+ *@note all save files will be stocked on the folder of the index (/Save), the index is updated
  *
  * @param saveName pointer on the name of the save
+ * @param anIndex the index of the save folder (see `loadSaveIndex()`)
+ * @param aSize the size of the board of the game
  *
  * @return if save is successfully created
  */
-bool createSave (string &saveName);
+bool createSave (string &saveName, SaveIndex& anIndex, int aSize);
 
 /**
  * @brief update the save of the game with the current game state on the save file.
- *  -if file is not found , a new file with the filename is created
+ *  -the game is written in the binary format (see `encodeSave()`), as a journal without moves
+ *  -`playGame()` appends the moves to the journal instead (see `appendJournal()`)
+ *  -if the save is not in the index , a new file with the filename is created
  *
  * @param aGame the current game state.
  * @param saveName the name of the save
+ * @param anIndex the index of the save folder
  */
-void updateSave(const Game& aGame , string& saveName);
+void updateSave(const Game& aGame , string& saveName, SaveIndex& anIndex);
 
 /**
  * @brief delete a selected save.
- *  -if save name does not exist : return false and do nothing
- *  -delete only saves in the folder /Save
- *  -if 2 saves have a same name : select one of them (number between 1 & 5)
+ *  -if save name is not in the index : return false and do nothing
+ *  -delete only saves in the folder of the index (/Save)
+ *  -the save is removed from the index
  *
  * @param saveName Name of the save to delete
+ * @param anIndex the index of the save folder
  *
  * @return  if the deletion was successfully carried out
  */
-bool deleteSave(string& saveName);
+bool deleteSave(string& saveName, SaveIndex& anIndex);
 
 
 /**
  * @brief display a save selection menu
- *  -display 5 line for the 5 saves
- *  -if a save don't exist : display free space
- *  -else display the save name
+ *  -display one line per save of the index (name, board size, moves, last update)
+ *  -if there is no save : display no save
  *  -display the actions possible :
  *      -Load a save 1
  *      -Delete a save 2
- *      -Exit save manager 3
+ *      -Exit save manager 0
  */
-bool saveManager(Game &aGame , string &saveName);
+bool saveManager(Game &aGame , string &saveName, SaveIndex& anIndex);
 
 /**
  * @brief Load a selected save for continue to play it
- *  -if no save in folder /Save display an error message (No save to load) and return false
+ *  -the save is looked up in the index, the file is read in one block, as a binary journal
+ *   (`replayJournal()`) or a legacy text save (`importTextSave()`)
+ *  -if the save is not in the index display an error message (No save to load) and return false
  *  -check if lines contains the goods information (currentPlayer, boardSize , Board )
  *  -if information are incorrect :
  *      -size != 11 or 13
  *      -currentPlayer != itsPlayer1 or itsPlayer2
  *      -if board is missing or invalid (example 2 kings on the board)
  * @param saveName name of the save
+ * @param anIndex the index of the save folder
  *
  * @return if save was successfully loaded
  */
-bool loadSave(Game &aGame, string& saveName);
+bool loadSave(Game &aGame, string& saveName, const SaveIndex& anIndex);
+
+/**
+ * @brief Packs a game into a binary save record.
+ *
+ * @param aGame The game to save (`itsCells` must be allocated).
+ * @return The record (names longer than `SAVE_NAME_LENGTH - 1` characters are cut).
+ */
+SaveRecord encodeSave(const Game& aGame);
+
+/**
+ * @brief Rebuilds a game from a binary save record.
+ *
+ * Checks the magic, the version, the size, the player to move, the roles, the unused bits
+ * and the pieces (at most one KING, only the KING on a FORTRESS or the CASTLE) before
+ * touching the game.
+ *
+ * @param aRecord The record to read.
+ * @param aGame The game to overwrite (board, players, bitboards and key).
+ * @return `true` if the record is valid, `false` otherwise (the game is not modified).
+ */
+bool decodeSave(const SaveRecord& aRecord, Game& aGame);
+
+/**
+ * @brief Reads a save written in the legacy text format.
+ *
+ * Lines: player 1 name, player 2 name, role of the current player (0 or 1), size (11 or 13),
+ * then one line of glyphs per row: `K` (KING), `S` (SWORD), `s` (SHIELD), any other glyph is empty.
+ * A glyph can be a multi-byte UTF-8 character (like `☒`), it counts as one cell.
+ *
+ * @param aText The whole content of the file.
+ * @param aGame The game to overwrite (board, players, bitboards and key).
+ * @return `true` if the text is a valid save, `false` otherwise (the game is not modified).
+ */
+bool importTextSave(const string& aText, Game& aGame);
 
 #endif // FUNCTIONS_H
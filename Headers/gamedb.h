@@ -0,0 +1,235 @@
+/**
+ * @file gamedb.h
+ *
+ * @brief Declarations of the single-file game database.
+ *
+ * A database stores many finished games played from the starting positions of `initializeBoard()`.
+ * Layout of the file:
+ * - a `GameDbHeader` (magic, version, number of games, offset of the index);
+ * - the move streams of all the games, one 4-byte `MoveRecord` per move (same records as the journal);
+ * - the index: one `GameDbEntry` per game (offset of its moves, plies, size, winner).
+ *
+ * The file is written once with `createGameDatabase()` / `addDatabaseGame()` / `closeGameDatabase()`,
+ * then mapped in memory read-only by `openGameDatabase()`: the index and the moves are read in place
+ * (no copy, no parsing) and the mapping can be shared by any number of threads.
+ * Fields are stored in the byte order of the machine (little-endian on the supported targets).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef GAMEDB_H
+#define GAMEDB_H
+
+#include <cstdio>
+#include "typeDef.h"
+#include "journal.h"
+
+/**
+ * @brief Magic bytes at the start of a game database.
+ */
+const char GAMEDB_MAGIC[4] = {'H', 'N', 'D', 'B'};
+
+/**
+ * @brief Version of the database format.
+ */
+const uint32_t GAMEDB_VERSION = 1;
+
+/**
+ * @brief Value of `GameDbEntry::itsWinner` for a game without winner (stopped before the end).
+ */
+const unsigned char GAMEDB_NO_WINNER = 2;
+
+/**
+ * @struct GameDbHeader
+ * @brief First bytes of a game database.
+ */
+struct GameDbHeader
+{
+    char itsMagic[4] = {GAMEDB_MAGIC[0], GAMEDB_MAGIC[1], GAMEDB_MAGIC[2], GAMEDB_MAGIC[3]}; /**< `GAMEDB_MAGIC`. */
+    uint32_t itsVersion = GAMEDB_VERSION; /**< `GAMEDB_VERSION`. */
+    uint64_t itsGameCount = 0;            /**< Number of games (entries of the index). */
+    uint64_t itsIndexOffset = 0;          /**< Offset of the index from the start of the file. */
+};
+
+static_assert(sizeof(GameDbHeader) == 24, "The database header must take 24 bytes");
+
+/**
+ * @struct GameDbEntry
+ * @brief Entry of the index of a game database.
+ */
+struct GameDbEntry
+{
+    uint64_t itsMovesOffset = 0;  /**< Offset of the first `MoveRecord` of the game. */
+    uint32_t itsPlies = 0;        /**< Number of moves of the game. */
+    unsigned char itsSize = LITTLE; /**< The size of the board (11 or 13). */
+    unsigned char itsWinner = GAMEDB_NO_WINNER; /**< Role of the winner (ATTACK, DEFENSE) or `GAMEDB_NO_WINNER`. */
+    unsigned char itsPadding[2] = {0, 0}; /**< Unused, always 0. */
+};
+
+static_assert(sizeof(GameDbEntry) == 16, "A database entry must take 16 bytes");
+
+/**
+ * @struct GameDbWriter
+ * @brief A database being written (the index is kept in memory until `closeGameDatabase()`).
+ */
+struct GameDbWriter
+{
+    FILE* itsFile = nullptr;          /**< The file being written. */
+    GameDbEntry* itsEntries = nullptr; /**< The index of the games already added. */
+    uint64_t itsCount = 0;            /**< Number of games added. */
+    uint64_t itsCapacity = 0;         /**< Size of `itsEntries`. */
+    uint64_t itsOffset = 0;           /**< Offset of the end of the file. */
+    Game itsGame;                     /**< Game used to check the added games. */
+};
+
+/**
+ * @struct GameDatabase
+ * @brief A database mapped in memory (read-only, can be shared between threads).
+ */
+struct GameDatabase
+{
+    const unsigned char* itsData = nullptr; /**< The mapped file. */
+    uint64_t itsLength = 0;                 /**< Size of the mapped file. */
+    const GameDbEntry* itsEntries = nullptr; /**< The index, inside the mapping. */
+    uint64_t itsGameCount = 0;              /**< Number of games. */
+    void* itsMapping = nullptr;             /**< Handle of the mapping (Windows only). */
+};
+
+/**
+ * @struct GameDbStats
+ * @brief Statistics of the games of a database, by board size (index 0 is LITTLE, 1 is BIG).
+ */
+struct GameDbStats
+{
+    long long itsGames[2] = {0, 0};             /**< Number of games. */
+    long long itsPlies[2] = {0, 0};             /**< Total number of moves. */
+    long long itsWins[2][3] = {{0, 0, 0}, {0, 0, 0}}; /**< Games won by ATTACK, DEFENSE and without winner. */
+    long long itsReplayErrors = 0;              /**< Games whose replayed result differs from the index. */
+};
+
+/**
+ * @struct OpeningStats
+ * @brief Results of the games starting with a given move.
+ */
+struct OpeningStats
+{
+    long long itsGames = 0;       /**< Number of games. */
+    long long itsAttackWins = 0;  /**< Games won by ATTACK. */
+    long long itsDefenseWins = 0; /**< Games won by DEFENSE. */
+};
+
+/**
+ * @brief Creates (or overwrites) a game database.
+ *
+ * @param aWriter The writer to open (must be closed).
+ * @param aPath The path of the file.
+ * @return `true` if the file was created.
+ */
+bool createGameDatabase(GameDbWriter& aWriter, const string& aPath);
+
+/**
+ * @brief Adds a game to a database being written.
+ *
+ * The game is replayed from the starting position with `checkMovement()`, so a database
+ * only holds legal games, and the winner of the index is the one of the final position.
+ *
+ * @param aWriter The open writer.
+ * @param aSize The size of the board.
+ * @param aMoves The moves of the game.
+ * @param aPlies The number of moves.
+ * @return `true` if the game was added, `false` if a move is illegal or a write failed.
+ */
+bool addDatabaseGame(GameDbWriter& aWriter, BoardSize aSize, const Move* aMoves, int aPlies);
+
+/**
+ * @brief Writes the index and the header, then closes the file.
+ *
+ * Safe to call on a closed writer.
+ *
+ * @param aWriter The writer to close.
+ * @return `false` if a write failed (the file is not a valid database).
+ */
+bool closeGameDatabase(GameDbWriter& aWriter);
+
+/**
+ * @brief Maps a whole file in memory, read-only.
+ *
+ * @param aPath The path of the file.
+ * @param aData Set to the first byte of the mapping.
+ * @param aLength Set to the size of the file.
+ * @param aMapping Set to the handle of the mapping (Windows only, nullptr elsewhere).
+ * @return `true` if the file is mapped, `false` if it can't be opened or is empty.
+ */
+bool mapReadOnlyFile(const string& aPath, const unsigned char*& aData, uint64_t& aLength, void*& aMapping);
+
+/**
+ * @brief Unmaps a file mapped by `mapReadOnlyFile()`.
+ *
+ * @param aData The first byte of the mapping (nothing is done if nullptr).
+ * @param aLength The size of the mapping.
+ * @param aMapping The handle of the mapping (Windows only).
+ */
+void unmapReadOnlyFile(const unsigned char* aData, uint64_t aLength, void* aMapping);
+
+/**
+ * @brief Maps a game database in memory.
+ *
+ * Checks the header and that the index and every move stream are inside the file,
+ * so the readers don't have to check the offsets again.
+ *
+ * @param aDatabase The database to open (must be closed).
+ * @param aPath The path of the file.
+ * @return `true` if the database is mapped and valid.
+ */
+bool openGameDatabase(GameDatabase& aDatabase, const string& aPath);
+
+/**
+ * @brief Unmaps a game database. Safe to call on a closed database.
+ *
+ * @param aDatabase The database to close.
+ */
+void closeGameDatabase(GameDatabase& aDatabase);
+
+/**
+ * @brief Gets the moves of a game, in place in the mapping.
+ *
+ * @param aDatabase The open database.
+ * @param anIndex The index of the game (less than `itsGameCount`).
+ * @return The first of the `itsPlies` records of the game.
+ */
+const MoveRecord* getDatabaseMoves(const GameDatabase& aDatabase, uint64_t anIndex);
+
+/**
+ * @brief Replays a game of a database with `movePiece()` / `capturePieces()`.
+ *
+ * The moves were checked when the database was written, so they are only checked to be
+ * on the board (no `checkMovement()`), which keeps the replay as fast as possible.
+ *
+ * @param aDatabase The open database.
+ * @param anIndex The index of the game.
+ * @param aGame The game receiving the final position (its board is reused if it has the good size).
+ * @return `false` if the index or a move is out of bounds.
+ */
+bool replayDatabaseGame(const GameDatabase& aDatabase, uint64_t anIndex, Game& aGame);
+
+/**
+ * @brief Replays all the games of a database on a pool of threads and computes their statistics.
+ *
+ * @param aDatabase The open database.
+ * @param aThreadCount Number of threads (`AI_ALL_CORES` (0) for one per core).
+ * @return The statistics.
+ */
+GameDbStats computeDatabaseStats(const GameDatabase& aDatabase, int aThreadCount);
+
+/**
+ * @brief Counts the results of the games starting with a given move (only reads the index and the first moves).
+ *
+ * @param aDatabase The open database.
+ * @param aSize The size of the board of the games to count.
+ * @param anOpening The first move.
+ * @return The results of these games.
+ */
+OpeningStats getOpeningStats(const GameDatabase& aDatabase, BoardSize aSize, const Move& anOpening);
+
+#endif // GAMEDB_H
@@ -0,0 +1,134 @@
+/**
+ * @file journal.h
+ *
+ * @brief Declarations of the append-only move journal used by the save files.
+ *
+ * A save file is a `SaveRecord` (the position when the journal was opened) followed by
+ * one 4-byte `MoveRecord` per played move. A turn only appends a few bytes instead of
+ * rewriting the whole save, and the full history of the game is kept: `replayJournal()`
+ * rebuilds the game by playing the moves again from the header position.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstdio>
+#include "typeDef.h"
+
+/**
+ * @brief Maximum number of moves kept in memory before they are written to the file.
+ */
+const int JOURNAL_BUFFER_MOVES = 64;
+
+/**
+ * @struct MoveRecord
+ * @brief One move of a journal (start row, start column, end row, end column).
+ */
+struct MoveRecord
+{
+    unsigned char itsCoords[4] = {0, 0, 0, 0}; /**< The coordinates of the move. */
+};
+
+static_assert(sizeof(MoveRecord) == 4, "A move record must take 4 bytes");
+
+/**
+ * @struct JournalPolicy
+ * @brief When the moves of a journal are written and synchronized to the disk.
+ */
+struct JournalPolicy
+{
+    int itsFlushInterval = 1;  /**< Moves buffered before a write (1 to `JOURNAL_BUFFER_MOVES`). */
+    bool itsIsSyncing = true;  /**< true to `fsync()` the file after each write (survives a power loss). */
+};
+
+/**
+ * @struct MoveJournal
+ * @brief An open journal file and its buffer of moves not written yet.
+ */
+struct MoveJournal
+{
+    FILE* itsFile = nullptr;                     /**< The file, opened for appending. */
+    MoveRecord itsBuffer[JOURNAL_BUFFER_MOVES];  /**< Moves not written yet. */
+    int itsBuffered = 0;                         /**< Number of moves in `itsBuffer`. */
+    int itsPlies = 0;                            /**< Number of moves of the journal (written or buffered). */
+    JournalPolicy itsPolicy;                     /**< The write and sync policy. */
+};
+
+/**
+ * @brief Forces the written data of a file to the disk.
+ *
+ * @param aFile The file to synchronize (already flushed).
+ * @return `true` if successful.
+ */
+bool syncFile(FILE* aFile);
+
+/**
+ * @brief Creates (or overwrites) a journal starting from the position of a game.
+ *
+ * @param aJournal The journal to open (must be closed).
+ * @param aPath The path of the file.
+ * @param aGame The position written in the header.
+ * @param aPolicy The write and sync policy.
+ * @return `true` if the header was written, `false` otherwise.
+ */
+bool openJournal(MoveJournal& aJournal, const string& aPath, const Game& aGame, const JournalPolicy& aPolicy = JournalPolicy());
+
+/**
+ * @brief Opens an existing journal to append the next moves.
+ *
+ * An incomplete last record (interrupted write) is removed first.
+ *
+ * @param aJournal The journal to open (must be closed).
+ * @param aPath The path of the file (it must start with `SAVE_MAGIC`).
+ * @param aPolicy The write and sync policy.
+ * @return `true` if the journal is open, `false` otherwise.
+ */
+bool resumeJournal(MoveJournal& aJournal, const string& aPath, const JournalPolicy& aPolicy = JournalPolicy());
+
+/**
+ * @brief Adds a move to a journal.
+ *
+ * The move is buffered and the buffer is written when it holds `itsFlushInterval` moves.
+ *
+ * @param aJournal The open journal.
+ * @param aMove The played move.
+ * @return `false` if the journal is closed or a write failed.
+ */
+bool appendJournal(MoveJournal& aJournal, const Move& aMove);
+
+/**
+ * @brief Writes the buffered moves to the file (and syncs it if the policy asks for it).
+ *
+ * @param aJournal The open journal.
+ * @return `false` if the journal is closed or the write failed.
+ */
+bool flushJournal(MoveJournal& aJournal);
+
+/**
+ * @brief Writes the buffered moves, syncs and closes the file.
+ *
+ * Safe to call on a closed journal.
+ *
+ * @param aJournal The journal to close.
+ * @return `false` if the last write failed.
+ */
+bool closeJournal(MoveJournal& aJournal);
+
+/**
+ * @brief Rebuilds a game from the content of a journal file.
+ *
+ * Decodes the header with `decodeSave()` then plays every complete record with `makeMove()`;
+ * an incomplete last record is ignored. Each move is checked with `checkMovement()`.
+ *
+ * @param aContent The whole content of the file.
+ * @param aGame The game to overwrite.
+ * @param aPlies Set to the number of replayed moves (can be `nullptr`).
+ * @return `true` if the header is valid and every move is legal, `false` otherwise
+ *         (after an illegal move, `aGame` holds the position reached before it).
+ */
+bool replayJournal(const string& aContent, Game& aGame, int* aPlies = nullptr);
+
+#endif // JOURNAL_H
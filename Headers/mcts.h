@@ -0,0 +1,150 @@
+/**
+ * @file mcts.h
+ *
+ * @brief Declarations of the Monte Carlo tree search player.
+ *
+ * Each playout walks down the tree with UCT (the child with the best mean result plus an
+ * exploration bonus), expands the leaf reached, plays random moves from it with `generateMoves()`
+ * and `makeMove()` until the end of the game or `MCTS_ROLLOUT_PLIES`, then adds the result to
+ * the nodes of its path. A rollout cut before the end is scored with `evaluatePosition()`.
+ *
+ * The nodes are taken from a pool allocated by `createMcts()`: a search never allocates, and
+ * stops expanding (but keeps playing out) when the pool is full. With several threads, all of
+ * them grow the same tree: a thread going through a node adds a virtual loss to it, so the other
+ * threads explore other branches until its result is added. The counters of the nodes are atomic
+ * and a node is expanded by exactly one thread, so no lock is needed.
+ *
+ * `searchMctsMove()` returns the same `AiResult` as `searchBestMove()` (see player.h to choose
+ * one of them).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <atomic>
+#include "typeDef.h"
+#include "ai.h"
+#include "boardpool.h"
+
+/**
+ * @brief Default number of nodes of the pool (as a power of 2).
+ */
+const int MCTS_NODE_BITS = 20;
+
+/**
+ * @brief Plies after which a rollout is stopped and scored with `evaluatePosition()`.
+ */
+const int MCTS_ROLLOUT_PLIES = 40;
+
+/**
+ * @brief Maximum depth of a path in the tree.
+ */
+const int MCTS_MAX_DEPTH = 256;
+
+/**
+ * @brief Weight of the exploration bonus of UCT.
+ */
+const double MCTS_EXPLORATION = 1.0;
+
+/**
+ * @brief Fixed-point unit of the results (a won playout adds `MCTS_RESULT_UNIT`).
+ */
+const int MCTS_RESULT_UNIT = 1024;
+
+/**
+ * @enum MctsNodeState
+ * @brief Expansion state of a node.
+ */
+enum MctsNodeState : unsigned char
+{
+    MCTS_LEAF,      /**< The children are not created. */
+    MCTS_EXPANDING, /**< A thread is creating the children. */
+    MCTS_EXPANDED,  /**< The children are created (none if the pool was full). */
+    MCTS_TERMINAL   /**< The game is over in this node (`itsWinner` is set). */
+};
+
+/**
+ * @struct MctsNode
+ * @brief A position of the tree and the results of the playouts that went through it.
+ */
+struct MctsNode
+{
+    Move itsMove = {{-1,-1},{-1,-1}};    /**< The move leading to this node. */
+    int itsFirstChild = -1;              /**< Index of the first child (the children are contiguous). */
+    int itsChildCount = 0;               /**< Number of children (set before `MCTS_EXPANDED`). */
+    std::atomic<int> itsVisits{0};       /**< Playouts that went through the node. */
+    std::atomic<int> itsVirtualLoss{0};  /**< Threads currently going through the node. */
+    std::atomic<int64_t> itsResults{0};  /**< Sum of the results for the player of `itsMove` (`MCTS_RESULT_UNIT` per win). */
+    std::atomic<unsigned char> itsState{MCTS_LEAF}; /**< A `MctsNodeState`. */
+    PlayerRole itsMover = ATTACK;        /**< The role of the player of `itsMove`. */
+    PlayerRole itsWinner = ATTACK;       /**< The winner of a terminal node. */
+};
+
+/**
+ * @struct MctsWorker
+ * @brief State of one thread of the search.
+ */
+struct MctsWorker
+{
+    Game itsGame;                 /**< The position of the playout (board from the pool of the search). */
+    MoveList itsMoves;            /**< Moves of the current position of the playout. */
+    uint64_t itsRandom = 0;       /**< State of the random generator of the rollouts. */
+    long long itsPlayouts = 0;    /**< Playouts of the last search. */
+    int itsMaxDepth = 0;          /**< Deepest node reached in the last search. */
+    int itsPath[MCTS_MAX_DEPTH];  /**< The nodes of the current playout. */
+};
+
+/**
+ * @struct MctsSearch
+ * @brief The node pool and the threads of the search, created by `createMcts()`.
+ */
+struct MctsSearch
+{
+    MctsNode* itsNodes = nullptr;       /**< The node pool (the root is node 0). */
+    int itsCapacity = 0;                /**< Number of nodes of the pool. */
+    std::atomic<int> itsNodeCount{0};   /**< Nodes used by the current tree. */
+    MctsWorker* itsWorkers = nullptr;   /**< One state per thread (`itsThreadCount` entries). */
+    int itsThreadCount = 0;             /**< Number of threads. */
+    BoardPool itsBoards;                /**< The boards of the workers. */
+    std::atomic<bool> itsStopSignal{false}; /**< Set when a worker reaches the deadline or the playout limit. */
+    std::atomic<long long> itsPlayouts{0};  /**< Playouts started by all the workers. */
+    uint64_t itsSeed = 1;               /**< Seed of the random generators. */
+};
+
+/**
+ * @brief Allocates the node pool and the threads of the search.
+ *
+ * @param aSearch The search to initialize (must not be already created).
+ * @param aNodeBits The pool holds 2^aNodeBits nodes (4-24).
+ * @param aThreadCount Number of threads (1-`AI_MAX_THREADS`, `AI_ALL_CORES` for one per core).
+ * @param aSeed Seed of the random rollouts.
+ * @return `true` if the allocation succeeded, `false` otherwise.
+ */
+bool createMcts(MctsSearch& aSearch, int aNodeBits = MCTS_NODE_BITS, int aThreadCount = 1, uint64_t aSeed = 1);
+
+/**
+ * @brief Releases the node pool and the threads of the search.
+ *
+ * @param aSearch The search to release (pointers are set to nullptr).
+ */
+void deleteMcts(MctsSearch& aSearch);
+
+/**
+ * @brief Searches the best move of the current player with playouts.
+ *
+ * A new tree is grown from the position at each call. With one thread and a playout limit,
+ * the search only depends on the position and the seed.
+ *
+ * @param aGame The game to search (the board must have its bitboards, it is not modified).
+ * @param aSearch The search (must be created).
+ * @param aTimeBudgetMs Maximum time of the search (in milliseconds).
+ * @param aMaxPlayouts Maximum number of playouts (0 for no limit).
+ * @return The most visited move; `itsScore` is the mean result of the move scaled to ±1000,
+ *         `itsDepth` the deepest node of the tree and `itsNodes` the number of playouts.
+ */
+AiResult searchMctsMove(const Game& aGame, MctsSearch& aSearch, int aTimeBudgetMs = AI_TIME_BUDGET_MS, long long aMaxPlayouts = 0);
+
+#endif // MCTS_H
@@ -0,0 +1,106 @@
+/**
+ * @file notation.h
+ *
+ * @brief Declarations of the one-line text notation of the positions and of the moves.
+ *
+ * A position is written like a FEN of chess: the rows from A to the last one, separated
+ * by `/`, then a space and the role to move (`a` for ATTACK, `d` for DEFENSE).
+ * In a row, `a` is a SWORD, `d` a SHIELD, `k` the KING and a number (1-13) a run of empty cells.
+ * The cell types are not written: they only depend on the size, which is the number of rows.
+ * The 11x11 starting position is `POSITION_START_LITTLE`.
+ *
+ * A move is written with the coordinates of `displayBoard()`: the row letter and the column
+ * number of the start, a `-`, then the end (`F2-F5`). The parsers also accept lowercase
+ * letters and a missing `-`.
+ *
+ * The parsers and formatters work on caller buffers and never allocate (except `parsePosition()`
+ * when the board of the game has to be created or resized), so positions can be streamed
+ * through pipes to batch tools.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include <string_view>
+#include "typeDef.h"
+
+/**
+ * @brief Size of a buffer that can hold any position (13 rows of 13 cells, 12 `/`, the role and a final 0).
+ */
+const int POSITION_TEXT_CAPACITY = BIG * BIG + (BIG - 1) + 2 + 1;
+
+/**
+ * @brief Size of a buffer that can hold any move (`M13-M13` and a final 0).
+ */
+const int MOVE_TEXT_CAPACITY = 8;
+
+/**
+ * @brief The 11x11 starting position.
+ */
+const char POSITION_START_LITTLE[] = "3aaaaa3/5a5/11/a4d4a/a3ddd3a/aa1ddkdd1aa/a3ddd3a/a4d4a/11/5a5/3aaaaa3 a";
+
+/**
+ * @brief The 13x13 starting position.
+ */
+const char POSITION_START_BIG[] = "4aaaaa4/6a6/13/6d6/a5d5a/a5d5a/aa1dddkddd1aa/a5d5a/a5d5a/6d6/13/6a6/4aaaaa4 a";
+
+/**
+ * @brief Writes the position of a game in the text notation.
+ *
+ * @param aGame The game to write (`itsCells` allocated).
+ * @param aBuffer The buffer receiving the text (0 terminated).
+ * @param aCapacity The size of the buffer (`POSITION_TEXT_CAPACITY` is always enough).
+ * @return The length of the text, or -1 if the buffer is too small or the board is not valid.
+ */
+int formatPosition(const Game& aGame, char* aBuffer, int aCapacity);
+
+/**
+ * @brief Reads a position written in the text notation into a game.
+ *
+ * The position is fully checked before the game is modified: every row has the same width,
+ * the size is LITTLE or BIG, there is at most one KING and only the KING is on a special cell.
+ * Trailing spaces and line ends are ignored. Player 1 attacks and player 2 defends
+ * (the names and `itsIsComputer` are kept), the bitboards and the key are rebuilt.
+ *
+ * @param aText The text to read.
+ * @param aGame The game to overwrite (its board is created or resized if needed).
+ * @return `true` if the position was read, `false` if the text is not valid (the game is not modified).
+ */
+bool parsePosition(string_view aText, Game& aGame);
+
+/**
+ * @brief Writes the coordinates of a cell in the text notation (`D4`).
+ *
+ * @param aPos The position (row and column between 0 and 12).
+ * @param aBuffer The buffer receiving the text (0 terminated).
+ * @param aCapacity The size of the buffer (4 bytes are always enough).
+ * @return The length of the text, or -1 if the buffer is too small or the position is out of range.
+ */
+int formatCell(const Position& aPos, char* aBuffer, int aCapacity);
+
+/**
+ * @brief Writes a move in the text notation.
+ *
+ * @param aMove The move to write (rows and columns between 0 and 12).
+ * @param aBuffer The buffer receiving the text (0 terminated).
+ * @param aCapacity The size of the buffer (`MOVE_TEXT_CAPACITY` is always enough).
+ * @return The length of the text, or -1 if the buffer is too small or a position is out of range.
+ */
+int formatMove(const Move& aMove, char* aBuffer, int aCapacity);
+
+/**
+ * @brief Reads a move written in the text notation.
+ *
+ * Only the syntax and the bounds are checked, not the rules (see `checkMovement()`).
+ *
+ * @param aText The text to read (trailing spaces and line ends are ignored).
+ * @param aSize The size of the board.
+ * @param aMove The move receiving the coordinates.
+ * @return `true` if the move was read and both positions are on the board.
+ */
+bool parseMove(string_view aText, BoardSize aSize, Move& aMove);
+
+#endif // NOTATION_H
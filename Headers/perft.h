@@ -0,0 +1,81 @@
+/**
+ * @file perft.h
+ *
+ * @brief Declarations of the perft counter and of the hot path benchmark.
+ *
+ * `perft()` counts the positions reachable in exactly N plies from a position, with
+ * `generateMoves()` and `makeMove()`/`unmakeMove()`. The counts from the starting positions
+ * of `initializeBoard()` are compared with stored reference values, so a change of the
+ * move generation, the captures or the endgame checks is detected immediately.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef PERFT_H
+#define PERFT_H
+
+#include "typeDef.h"
+
+/**
+ * @brief Number of stored reference depths (1 to `PERFT_REFERENCE_DEPTHS`).
+ */
+const int PERFT_REFERENCE_DEPTHS = 5;
+
+/**
+ * @brief Reference perft counts from the starting positions (ATTACK to move), -1 if unknown.
+ *
+ * Row 0 is LITTLE, row 1 is BIG. A finished game (`isGameFinished()`) has no moves.
+ * Depths 1 to 3 were checked against a brute force generator based on `checkMovement()`
+ * (with the captures of `capturePieces()`: the border of the board is never an anvil).
+ */
+const long long PERFT_REFERENCE[2][PERFT_REFERENCE_DEPTHS] = {
+    {116, 6788, 806344, 50456804, 6116568016LL},
+    {156, 20148, 3210320, 421997364, 68644803392LL}
+};
+
+/**
+ * @struct HotPathRates
+ * @brief Speed of the functions called on every node of a search.
+ */
+struct HotPathRates
+{
+    double itsGeneratePerSecond = 0;      /**< Calls of `generateMoves()` per second. */
+    double itsMovesPerSecond = 0;         /**< Moves generated per second. */
+    double itsMakeUnmakePerSecond = 0;    /**< `makeMove()` + `unmakeMove()` pairs per second. */
+    double itsGameFinishedPerSecond = 0;  /**< Calls of `isGameFinished()` per second. */
+    double itsFeaturesPerSecond = 0;      /**< Calls of `computeEvalFeatures()` (with mobility) per second. */
+    double itsScansPerSecond = 0;         /**< Calls of `scanBoardMasks()` per second (selected kernel). */
+};
+
+/**
+ * @brief Counts the positions reachable in exactly `aDepth` plies.
+ *
+ * The last ply is counted with the size of the move list (bulk counting).
+ * The engine of the board size is picked once, the whole count runs in it.
+ *
+ * @param aGame The start position (modified during the count and restored).
+ * @param aDepth The number of plies (0 returns 1).
+ * @return The number of leaf positions (0 for boards other than LITTLE or BIG).
+ */
+long long perft(Game& aGame, int aDepth);
+
+/**
+ * @brief Gets the stored reference count of a starting position.
+ *
+ * @param aSize The size of the board.
+ * @param aDepth The depth.
+ * @return The reference count, or -1 if it is not known.
+ */
+long long perftReference(BoardSize aSize, int aDepth);
+
+/**
+ * @brief Measures the speed of the hot paths on positions of a fixed random game.
+ *
+ * @param aSize The size of the board.
+ * @param aRounds Number of passes over the positions (more rounds give a steadier measure).
+ * @return The measured rates.
+ */
+HotPathRates benchmarkHotPaths(BoardSize aSize, int aRounds);
+
+#endif // PERFT_H
@@ -0,0 +1,87 @@
+/**
+ * @file player.h
+ *
+ * @brief Declarations of the computer player, searching with alpha-beta or with MCTS.
+ *
+ * The interactive game (and any other caller) creates one `ComputerPlayer` with the engine it
+ * wants and asks it for moves, without depending on the engine: both return an `AiResult`.
+ * The opening book and the endgame tables are only used by the alpha-beta engine (`itsSearch`).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include <string_view>
+#include "typeDef.h"
+#include "ai.h"
+#include "mcts.h"
+
+/**
+ * @enum EngineKind
+ * @brief The search used by a computer player.
+ */
+enum EngineKind
+{
+    ENGINE_ALPHA_BETA, /**< `searchBestMove()` (see ai.h). */
+    ENGINE_MCTS        /**< `searchMctsMove()` (see mcts.h). */
+};
+
+/**
+ * @struct ComputerPlayer
+ * @brief A computer player and the state of its engine.
+ */
+struct ComputerPlayer
+{
+    EngineKind itsEngine = ENGINE_ALPHA_BETA; /**< The engine used. */
+    AiSearch itsSearch;                       /**< The state of the alpha-beta engine (only created for it). */
+    MctsSearch itsMcts;                       /**< The state of the MCTS engine (only created for it). */
+};
+
+/**
+ * @brief Gets the name of an engine.
+ *
+ * @param anEngine The engine.
+ * @return "alphabeta" or "mcts".
+ */
+const char* getEngineName(EngineKind anEngine);
+
+/**
+ * @brief Reads the name of an engine.
+ *
+ * @param aText "alphabeta" or "mcts".
+ * @param anEngine Set to the engine if the name is known.
+ * @return `true` if the name is known.
+ */
+bool parseEngineName(std::string_view aText, EngineKind& anEngine);
+
+/**
+ * @brief Creates a computer player with the default sizes of its engine.
+ *
+ * @param aPlayer The player to create (must not be already created).
+ * @param anEngine The engine.
+ * @param aThreadCount Number of search threads (`AI_ALL_CORES` for one per core).
+ * @return `true` if the allocation succeeded, `false` otherwise.
+ */
+bool createComputerPlayer(ComputerPlayer& aPlayer, EngineKind anEngine, int aThreadCount = 1);
+
+/**
+ * @brief Releases a computer player.
+ *
+ * @param aPlayer The player to release.
+ */
+void deleteComputerPlayer(ComputerPlayer& aPlayer);
+
+/**
+ * @brief Chooses the move of the current player.
+ *
+ * @param aGame The game (restored before returning).
+ * @param aPlayer The computer player (must be created).
+ * @param aTimeBudgetMs Maximum time of the search (in milliseconds).
+ * @return The move and the statistics of the search (the best move is -1 if the player has no legal move).
+ */
+AiResult chooseComputerMove(Game& aGame, ComputerPlayer& aPlayer, int aTimeBudgetMs = AI_TIME_BUDGET_MS);
+
+#endif // PLAYER_H
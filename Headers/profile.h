@@ -0,0 +1,202 @@
+/**
+ * @file profile.h
+ *
+ * @brief Declarations of the optional instrumentation of the hot functions.
+ *
+ * When the core is built with `HNEFATAFL_PROFILE` (CMake option of the same name), each
+ * instrumented function counts its calls and the clock ticks spent inside it (the time stamp
+ * counter on x86, nanoseconds elsewhere). Each thread writes its own counters, and the counters
+ * of all the threads are only added together by `collectProfile()`.
+ *
+ * Without `HNEFATAFL_PROFILE`, `PROFILE_SCOPE()` and `PROFILE_COUNT()` expand to nothing: the
+ * instrumented functions are compiled exactly as before, and the reports are empty.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @enum ProfilePoint
+ * @brief The instrumented functions.
+ */
+enum ProfilePoint
+{
+    PROFILE_VALID_MOVEMENT, /**< `isValidMovement()`. */
+    PROFILE_CAPTURE_PIECES, /**< `capturePieces()`. */
+    PROFILE_MOVE_PIECE,     /**< `movePiece()`. */
+    PROFILE_GAME_FINISHED,  /**< `isGameFinished()`. */
+    PROFILE_GENERATE_MOVES, /**< `generateMoves()`. */
+    PROFILE_SEARCH,         /**< `searchBestMove()`. */
+    PROFILE_SEARCH_NODE,    /**< Positions visited by the search (calls only). */
+    PROFILE_SAVE_IO,        /**< Reads and writes of the saves and of the journals. */
+    PROFILE_POINT_COUNT     /**< Number of instrumented functions. */
+};
+
+/**
+ * @struct ProfileCounter
+ * @brief Calls and clock ticks of one function.
+ */
+struct ProfileCounter
+{
+    uint64_t itsCalls = 0;  /**< Number of calls. */
+    uint64_t itsCycles = 0; /**< Clock ticks spent in the calls (callees included). */
+};
+
+/**
+ * @struct ProfileReport
+ * @brief Counters of all the threads, added together.
+ */
+struct ProfileReport
+{
+    bool itsIsEnabled = false;                          /**< true if the build has `HNEFATAFL_PROFILE`. */
+    ProfileCounter itsCounters[PROFILE_POINT_COUNT];    /**< One counter per `ProfilePoint`. */
+};
+
+/**
+ * @brief Checks if the instrumentation is compiled in.
+ *
+ * @return `true` if the core was built with `HNEFATAFL_PROFILE`.
+ */
+bool isProfilingEnabled();
+
+/**
+ * @brief Gets the name of an instrumented function.
+ *
+ * @param aPoint The instrumented function.
+ * @return Its name ("isValidMovement", ...), or "unknown".
+ */
+const char* getProfilePointName(ProfilePoint aPoint);
+
+/**
+ * @brief Gets the name of the clock used for the ticks.
+ *
+ * @return "tsc" (x86 time stamp counter) or "ns" (steady clock).
+ */
+const char* getProfileClockName();
+
+/**
+ * @brief Adds the counters of all the threads (running or finished).
+ *
+ * @return The counters (all 0 without `HNEFATAFL_PROFILE`).
+ */
+ProfileReport collectProfile();
+
+/**
+ * @brief Sets the counters of all the threads to 0.
+ */
+void resetProfile();
+
+/**
+ * @brief Formats a report as a text table (one line per function).
+ *
+ * @param aReport The report.
+ * @return The table, with its line ends.
+ */
+std::string formatProfileText(const ProfileReport& aReport);
+
+/**
+ * @brief Formats a report as one line of JSON (no line end).
+ *
+ * `{"enabled":true,"clock":"tsc","points":{"isValidMovement":{"calls":N,"cycles":N},...}}`
+ *
+ * @param aReport The report.
+ * @return The JSON object.
+ */
+std::string formatProfileJson(const ProfileReport& aReport);
+
+#ifdef HNEFATAFL_PROFILE
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define PROFILE_TSC
+#else
+#include <chrono>
+#endif
+
+/**
+ * @struct ProfileThreadCounters
+ * @brief Counters written by one thread, registered while the thread runs.
+ *
+ * Only the thread writes them (relaxed stores, no lock on the hot path); `collectProfile()`
+ * reads them from another thread. A finished thread adds them to the counters of the
+ * finished threads.
+ */
+struct ProfileThreadCounters
+{
+    std::atomic<uint64_t> itsCalls[PROFILE_POINT_COUNT];  /**< Calls of each function. */
+    std::atomic<uint64_t> itsCycles[PROFILE_POINT_COUNT]; /**< Clock ticks of each function. */
+    ProfileThreadCounters* itsNext = nullptr;             /**< Next registered thread. */
+
+    ProfileThreadCounters();
+    ~ProfileThreadCounters();
+};
+
+/**
+ * @brief Gets the counters of the calling thread (registered on first use).
+ *
+ * @return The counters.
+ */
+ProfileThreadCounters& getThreadProfile();
+
+/**
+ * @brief Reads the clock of the counters.
+ *
+ * @return The current tick.
+ */
+inline uint64_t readProfileClock()
+{
+#ifdef PROFILE_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * @brief Adds a call to the counters of the calling thread.
+ *
+ * @param aPoint The instrumented function.
+ * @param aCycles The clock ticks of the call.
+ */
+inline void addProfileSample(ProfilePoint aPoint, uint64_t aCycles)
+{
+    ProfileThreadCounters& counters = getThreadProfile();
+    counters.itsCalls[aPoint].store(counters.itsCalls[aPoint].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    counters.itsCycles[aPoint].store(counters.itsCycles[aPoint].load(std::memory_order_relaxed) + aCycles, std::memory_order_relaxed);
+}
+
+/**
+ * @struct ProfileScope
+ * @brief Times the rest of the block it is declared in.
+ */
+struct ProfileScope
+{
+    ProfilePoint itsPoint;   /**< The instrumented function. */
+    uint64_t itsStart;       /**< Tick at the start of the block. */
+
+    explicit ProfileScope(ProfilePoint aPoint) : itsPoint(aPoint), itsStart(readProfileClock()) {}
+    ~ProfileScope() { addProfileSample(itsPoint, readProfileClock() - itsStart); }
+};
+
+#define PROFILE_SCOPE(aPoint) ProfileScope profileScope(aPoint)
+#define PROFILE_COUNT(aPoint) addProfileSample(aPoint, 0)
+
+#else
+
+#define PROFILE_SCOPE(aPoint)
+#define PROFILE_COUNT(aPoint)
+
+#endif // HNEFATAFL_PROFILE
+
+#endif // PROFILE_H
@@ -0,0 +1,161 @@
+/**
+ * @file render.h
+ *
+ * @brief Declarations of the buffered terminal renderer of the game screen.
+ *
+ * A frame (the logo, the status line and the board of `displayBoard()`) is composed in one
+ * buffer allocated once, then written with a single system call. The renderer remembers the
+ * cells on the screen: the next frame only moves the cursor to the cells that changed
+ * (the start, the end and the captured cells of a move) and redraws them, rewrites the status
+ * line and erases what was printed below the board (prompts, errors).
+ *
+ * A full frame is drawn when nothing is on the screen yet, when the board size changed, after
+ * `invalidateRenderer()` and when the output is not a terminal or the terminal is too small
+ * to show the whole frame without scrolling (cursor positions would be wrong).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <string_view>
+#include "typeDef.h"
+
+/**
+ * @brief Number of lines of the logo.
+ */
+const int LOGO_LINES = 15;
+
+/**
+ * @brief The lines of the logo (UTF-8, without line ends).
+ */
+extern const char* const HNEFATAFL_LOGO[LOGO_LINES];
+
+/**
+ * @brief Size of a buffer that can hold the text of the logo with its line ends.
+ */
+const int LOGO_TEXT_CAPACITY = 8192;
+
+/**
+ * @brief Size of a buffer that can hold the text of any board (see `writeBoardText()`).
+ */
+const int BOARD_TEXT_CAPACITY = 8192;
+
+/**
+ * @brief Size of the frame buffer of a renderer (the logo, a status line and a BIG board).
+ */
+const int RENDER_BUFFER_BYTES = 16384;
+
+/**
+ * @brief Number of lines kept free below the board for the prompts before a full frame is needed.
+ */
+const int RENDER_PROMPT_LINES = 4;
+
+/**
+ * @struct TextBuffer
+ * @brief Text composed in a fixed-capacity buffer owned by the caller.
+ */
+struct TextBuffer
+{
+    char* itsData = nullptr; /**< The characters (not 0 terminated). */
+    int itsLength = 0;       /**< Number of characters written. */
+    int itsCapacity = 0;     /**< Size of `itsData`. */
+};
+
+/**
+ * @struct BoardRenderer
+ * @brief Frame buffer and copy of the cells shown on the terminal.
+ */
+struct BoardRenderer
+{
+    TextBuffer itsFrame;                 /**< The frame being composed (allocated by `createRenderer()`). */
+    Cell itsShownCells[BIG][BIG] = {};   /**< The cells currently on the screen. */
+    BoardSize itsShownSize = LITTLE;     /**< The size of the board on the screen. */
+    bool itsIsShown = false;             /**< true if the screen holds a frame of this renderer. */
+};
+
+/**
+ * @brief Appends text to a buffer.
+ *
+ * @param aBuffer The buffer.
+ * @param aText The text to append.
+ * @return `true` if it fit, `false` if the buffer is full (nothing is appended).
+ */
+bool appendText(TextBuffer& aBuffer, string_view aText);
+
+/**
+ * @brief Composes the text of a board, exactly as displayed by `displayBoard()`.
+ *
+ * @param aBoard The board to write (`itsSize` at most BIG).
+ * @param aBuffer The buffer receiving the text (`BOARD_TEXT_CAPACITY` bytes are always enough).
+ * @return `true` if the whole board fit in the buffer.
+ */
+bool writeBoardText(const Board& aBoard, TextBuffer& aBuffer);
+
+/**
+ * @brief Allocates the frame buffer of a renderer.
+ *
+ * @param aRenderer The renderer to initialize.
+ * @return `true` if successful, `false` if the allocation failed.
+ */
+bool createRenderer(BoardRenderer& aRenderer);
+
+/**
+ * @brief Frees the frame buffer of a renderer.
+ *
+ * @param aRenderer The renderer to release.
+ */
+void deleteRenderer(BoardRenderer& aRenderer);
+
+/**
+ * @brief Forgets the screen content, so the next render draws a full frame.
+ *
+ * To call when something else changed the screen (console cleared, many lines printed).
+ *
+ * @param aRenderer The renderer.
+ */
+void invalidateRenderer(BoardRenderer& aRenderer);
+
+/**
+ * @brief Composes a full frame: clear screen, logo, status line and board.
+ *
+ * @param aRenderer The renderer (its previous frame is discarded).
+ * @param aBoard The board to draw.
+ * @param aStatus The status line (a single line).
+ * @return `true` if the frame fit in the buffer.
+ */
+bool composeFrame(BoardRenderer& aRenderer, const Board& aBoard, string_view aStatus);
+
+/**
+ * @brief Composes the changes since the last frame: the changed cells, the status line and the erased prompts.
+ *
+ * @param aRenderer The renderer (its previous frame is discarded).
+ * @param aBoard The board to draw (same size as the board on the screen).
+ * @param aStatus The status line (a single line).
+ * @return The number of redrawn cells, or -1 if a full frame is needed (nothing was composed).
+ */
+int composeUpdate(BoardRenderer& aRenderer, const Board& aBoard, string_view aStatus);
+
+/**
+ * @brief Writes the composed frame to the standard output with a single system call.
+ *
+ * `cout` is flushed first so the frame comes after the text already printed.
+ *
+ * @param aRenderer The renderer holding the frame.
+ * @return `true` if the whole frame was written.
+ */
+bool writeRenderer(const BoardRenderer& aRenderer);
+
+/**
+ * @brief Draws the game screen: only the changes when possible, a full frame otherwise.
+ *
+ * @param aRenderer The renderer.
+ * @param aBoard The board to draw.
+ * @param aStatus The status line (a single line).
+ * @return `true` if the frame was written.
+ */
+bool renderGame(BoardRenderer& aRenderer, const Board& aBoard, string_view aStatus);
+
+#endif // RENDER_H
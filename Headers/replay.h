@@ -0,0 +1,116 @@
+/**
+ * @file replay.h
+ *
+ * @brief Declarations of the batch validator of the game records.
+ *
+ * A game record is one line of text: the size of the board, the claimed winner and the moves
+ * in the notation of notation.h, separated by spaces:
+ * `<11|13> <winner A|D|-> <move> <move> ...` (`11 D F2-F5 A4-C4 ...`).
+ * Empty lines and lines starting with `#` are not records.
+ *
+ * Each record is replayed from the starting position of its size with `isValidMovement()`,
+ * `movePiece()` and `capturePieces()`, then the winner of the final position is compared with
+ * the claimed one. The winner follows the rules of the self-play runner: `whoWon()` when the
+ * game is finished, the other player when the player to move has no legal move, none otherwise.
+ *
+ * `runReplay()` streams the records of a file or a pipe by chunks to a pool of workers (each one
+ * replays on its own board) and writes one verdict per record, in the order of the input.
+ * Nothing is read from `cin` or written to the terminal.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <istream>
+#include <ostream>
+#include <string_view>
+#include "typeDef.h"
+
+/**
+ * @brief Number of records given to a worker at once.
+ */
+const int REPLAY_CHUNK_RECORDS = 256;
+
+/**
+ * @enum ReplayStatus
+ * @brief The verdict of a record.
+ */
+enum ReplayStatus
+{
+    REPLAY_VALID,        /**< Every move is legal and the claimed winner is the right one. */
+    REPLAY_WRONG_RESULT, /**< Every move is legal but the claimed winner is not the right one. */
+    REPLAY_ILLEGAL_MOVE, /**< A move is rejected by `isValidMovement()`. */
+    REPLAY_AFTER_END,    /**< A move is played after the end of the game. */
+    REPLAY_SYNTAX_ERROR, /**< The line is not a record (size, winner or move not readable). */
+    REPLAY_STATUS_COUNT  /**< Number of verdicts. */
+};
+
+/**
+ * @struct ReplayVerdict
+ * @brief The verdict of a record and the game replayed up to the first problem.
+ */
+struct ReplayVerdict
+{
+    ReplayStatus itsStatus = REPLAY_SYNTAX_ERROR; /**< The verdict. */
+    int itsPlies = 0;              /**< Moves played (the rejected move is move `itsPlies + 1`). */
+    char itsWinner = '-';          /**< Winner of the position reached (A, D or -). */
+    uint64_t itsFinalHash = 0;     /**< Zobrist key of the position reached. */
+};
+
+/**
+ * @struct ReplaySummary
+ * @brief The number of records of each verdict.
+ */
+struct ReplaySummary
+{
+    long long itsRecords = 0;                          /**< Number of records. */
+    long long itsCounts[REPLAY_STATUS_COUNT] = {0};    /**< Records of each verdict. */
+};
+
+/**
+ * @brief Gets the name of a verdict, as written by `runReplay()`.
+ *
+ * @param aStatus The verdict.
+ * @return "ok", "wrong-result", "illegal", "after-end" or "syntax".
+ */
+const char* getReplayStatusName(ReplayStatus aStatus);
+
+/**
+ * @brief Replays one record and checks its claimed winner.
+ *
+ * @param aRecord The line of the record (without its line end).
+ * @param aGame The game used for the replay (its board is created or resized if needed, then reused).
+ * @return The verdict.
+ */
+ReplayVerdict validateGameRecord(string_view aRecord, Game& aGame);
+
+/**
+ * @brief Writes the line of a verdict: `<index> <verdict> <plies> <winner A|D|-> <final key in hex>`.
+ *
+ * @param anIndex The index of the record (from 0, in the order of the input).
+ * @param aVerdict The verdict.
+ * @param aBuffer The buffer receiving the line (with its line end, 0 terminated).
+ * @param aCapacity The size of the buffer (64 bytes are always enough).
+ * @return The length of the line, or -1 if the buffer is too small.
+ */
+int formatReplayVerdict(long long anIndex, const ReplayVerdict& aVerdict, char* aBuffer, int aCapacity);
+
+/**
+ * @brief Validates all the records of a stream on a pool of threads.
+ *
+ * The calling thread reads the records by chunks of `REPLAY_CHUNK_RECORDS` and writes the
+ * verdicts of the chunks in the order of the input; at most 4 chunks per worker are in memory,
+ * so the input can be of any length.
+ *
+ * @param anInput The records.
+ * @param anOutput Receives one verdict line per record (see `formatReplayVerdict()`).
+ * @param aThreadCount Number of workers (`AI_ALL_CORES` (0) for one per core).
+ * @param aSummary Receives the number of records of each verdict (can be nullptr).
+ * @return `false` if a worker couldn't allocate its board or the output can't be written.
+ */
+bool runReplay(std::istream& anInput, std::ostream& anOutput, int aThreadCount, ReplaySummary* aSummary = nullptr);
+
+#endif // REPLAY_H
@@ -0,0 +1,160 @@
+/**
+ * @file saveindex.h
+ *
+ * @brief Declarations of the index of the save directory.
+ *
+ * The index lists every save of the directory (name, last update, board size, plies and
+ * end of its journal). It is loaded once by `loadSaveIndex()` and kept sorted by name in memory,
+ * so listing, finding and creating saves never scan the directory. Each change is written
+ * to a temporary file which then replaces the index (`rename()`), so a crash leaves either
+ * the old or the new index, never a partial one.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef SAVEINDEX_H
+#define SAVEINDEX_H
+
+#include "typeDef.h"
+
+/**
+ * @brief Directory of the save files.
+ */
+const string SAVE_DIRECTORY = "Save";
+
+/**
+ * @brief Name of the index file in the save directory (it can't be used as a save name).
+ */
+const string SAVE_INDEX_FILE = "saves.index";
+
+/**
+ * @brief Magic bytes at the start of the index file.
+ */
+const char SAVE_INDEX_MAGIC[4] = {'H', 'N', 'S', 'I'};
+
+/**
+ * @brief Version of the index format.
+ */
+const uint32_t SAVE_INDEX_VERSION = 1;
+
+/**
+ * @brief Width of a save name in the index (the last byte is always 0).
+ */
+const int SAVE_INDEX_NAME_LENGTH = 64;
+
+/**
+ * @struct SaveIndexHeader
+ * @brief First bytes of the index file, followed by `itsCount` entries.
+ */
+struct SaveIndexHeader
+{
+    char itsMagic[4] = {SAVE_INDEX_MAGIC[0], SAVE_INDEX_MAGIC[1], SAVE_INDEX_MAGIC[2], SAVE_INDEX_MAGIC[3]}; /**< `SAVE_INDEX_MAGIC`. */
+    uint32_t itsVersion = SAVE_INDEX_VERSION; /**< `SAVE_INDEX_VERSION`. */
+    uint64_t itsCount = 0;                    /**< Number of entries. */
+};
+
+static_assert(sizeof(SaveIndexHeader) == 16, "The index header must take 16 bytes");
+
+/**
+ * @struct SaveIndexEntry
+ * @brief One save of the index.
+ */
+struct SaveIndexEntry
+{
+    char itsName[SAVE_INDEX_NAME_LENGTH] = {}; /**< The name of the save file (0 terminated). */
+    int64_t itsTimestamp = 0;   /**< Time of the last update (seconds since 1970). */
+    uint64_t itsOffset = 0;     /**< Offset of the end of the journal (where the next move is written), 0 for a text save. */
+    uint32_t itsPlies = 0;      /**< Number of moves of the journal. */
+    unsigned char itsSize = 0;  /**< The size of the board (11 or 13), 0 if unknown. */
+    unsigned char itsPadding[3] = {0, 0, 0}; /**< Unused, always 0. */
+};
+
+static_assert(sizeof(SaveIndexEntry) == SAVE_INDEX_NAME_LENGTH + 24, "An index entry must not have padding");
+
+/**
+ * @struct SaveIndex
+ * @brief The index of a save directory, in memory.
+ */
+struct SaveIndex
+{
+    string itsDirectory = SAVE_DIRECTORY;  /**< The save directory. */
+    SaveIndexEntry* itsEntries = nullptr;  /**< The entries, sorted by name. */
+    int itsCount = 0;                      /**< Number of entries. */
+    int itsCapacity = 0;                   /**< Size of `itsEntries`. */
+};
+
+/**
+ * @brief Loads the index of a save directory (creates the directory if needed).
+ *
+ * Without an index file, the directory is scanned once and the index is created from the
+ * save files found (saves written before the index existed).
+ *
+ * @param anIndex The index to fill (its previous entries are freed).
+ * @param aDirectory The save directory.
+ * @return `false` if the index file is invalid or can't be written.
+ */
+bool loadSaveIndex(SaveIndex& anIndex, const string& aDirectory = SAVE_DIRECTORY);
+
+/**
+ * @brief Writes the index to a temporary file, then replaces the index file with it.
+ *
+ * @param anIndex The index to write.
+ * @return `true` if the index file was replaced.
+ */
+bool writeSaveIndex(const SaveIndex& anIndex);
+
+/**
+ * @brief Frees the entries of an index.
+ *
+ * @param anIndex The index to free.
+ */
+void deleteSaveIndex(SaveIndex& anIndex);
+
+/**
+ * @brief Finds a save in the index (binary search).
+ *
+ * @param anIndex The index.
+ * @param aName The name of the save.
+ * @return The position of the entry in `itsEntries`, -1 if the save is not in the index.
+ */
+int findSave(const SaveIndex& anIndex, const string& aName);
+
+/**
+ * @brief Checks if a name can be used for a save (not empty, fits in an entry, no path, not the index).
+ *
+ * @param aName The name to check.
+ * @return `true` if the name is valid.
+ */
+bool isValidSaveName(const string& aName);
+
+/**
+ * @brief Adds or updates a save in the index (timestamp set to now), then writes the index.
+ *
+ * @param anIndex The index.
+ * @param aName The name of the save (see `isValidSaveName()`).
+ * @param aSize The size of the board (0 if unknown).
+ * @param aPlies The number of moves of the journal.
+ * @return `true` if the entry is in the index and the index was written.
+ */
+bool recordSave(SaveIndex& anIndex, const string& aName, int aSize, int aPlies);
+
+/**
+ * @brief Removes a save from the index (the file is not deleted), then writes the index.
+ *
+ * @param anIndex The index.
+ * @param aName The name of the save.
+ * @return `true` if the save was in the index and the index was written.
+ */
+bool removeSave(SaveIndex& anIndex, const string& aName);
+
+/**
+ * @brief Gets the path of a save file.
+ *
+ * @param anIndex The index of the save directory.
+ * @param aName The name of the save.
+ * @return The path of the file in the save directory.
+ */
+string getSavePath(const SaveIndex& anIndex, const string& aName);
+
+#endif // SAVEINDEX_H
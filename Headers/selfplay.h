@@ -0,0 +1,105 @@
+/**
+ * @file selfplay.h
+ *
+ * @brief Declarations of the headless self-play runner.
+ *
+ * Plays AI-vs-AI or random-vs-random games without any terminal output or input
+ * (no `clearConsole()`, no `displayBoard()`, no `cin`, no save file), spread over a pool
+ * of threads, and writes one compact line per game (winner, ply count, final key).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <ostream>
+#include "typeDef.h"
+#include "ai.h"
+#include "boardpool.h"
+#include "mcts.h"
+
+/**
+ * @enum GameEnd
+ * @brief Reason why a self-play game stopped.
+ */
+enum GameEnd
+{
+    END_WIN,      /**< `isGameFinished()` is true, the winner is given by `whoWon()`. */
+    END_NO_MOVE,  /**< The player to move has no legal move (the other player wins). */
+    END_PLY_LIMIT /**< The game reached the maximum number of plies (no winner). */
+};
+
+/**
+ * @enum PlayerKind
+ * @brief How the moves of a side are chosen.
+ */
+enum PlayerKind
+{
+    RANDOM_PLAYER, /**< A random legal move. */
+    AI_PLAYER,     /**< The move of `searchBestMove()`. */
+    MCTS_PLAYER    /**< The move of `searchMctsMove()`. */
+};
+
+/**
+ * @struct SelfPlaySettings
+ * @brief Settings shared by all the games of a run.
+ */
+struct SelfPlaySettings
+{
+    BoardSize itsSize = LITTLE;          /**< Size of the board. */
+    PlayerKind itsAttack = RANDOM_PLAYER; /**< Player of the ATTACK side. */
+    PlayerKind itsDefense = RANDOM_PLAYER; /**< Player of the DEFENSE side. */
+    int itsTimeBudgetMs = 20;            /**< Time budget of an AI move (in milliseconds). */
+    int itsMaxDepth = AI_MAX_PLY - 1;    /**< Maximum depth of an AI move. */
+    int itsTableBits = 16;               /**< Size of the transposition table of each worker. */
+    int itsNodeBits = 16;                /**< Size of the MCTS node pool of each worker. */
+    int itsMaxPlies = 400;               /**< Plies after which a game is stopped. */
+    uint64_t itsSeed = 1;                /**< Seed of the random players (game i uses seed + i). */
+};
+
+/**
+ * @struct SelfPlayResult
+ * @brief Result of one self-play game.
+ */
+struct SelfPlayResult
+{
+    GameEnd itsEnd = END_PLY_LIMIT;  /**< Why the game stopped. */
+    bool itsHasWinner = false;       /**< false for `END_PLY_LIMIT`. */
+    PlayerRole itsWinner = ATTACK;   /**< Role of the winner (if `itsHasWinner`). */
+    int itsPlies = 0;                /**< Number of moves played. */
+    uint64_t itsFinalHash = 0;       /**< Zobrist key of the final position. */
+};
+
+/**
+ * @brief Plays one game without any display or input.
+ *
+ * @param aSettings The settings of the run.
+ * @param aGameIndex Index of the game (the random players use `itsSeed + aGameIndex`).
+ * @param aSearch Search state used by the AI players (created by the caller, can be nullptr
+ *                if no side is an `AI_PLAYER`).
+ * @param aPool Pool giving the board of the game (can be nullptr, the board is then allocated).
+ * @param aMcts Search used by the MCTS players (can be nullptr if no side is a `MCTS_PLAYER`).
+ * @return The result of the game.
+ */
+SelfPlayResult playSelfPlayGame(const SelfPlaySettings& aSettings, int aGameIndex, AiSearch* aSearch, BoardPool* aPool = nullptr,
+                                MctsSearch* aMcts = nullptr);
+
+/**
+ * @brief Plays many games on a pool of threads and writes one line per game.
+ *
+ * Each line is `<index> <winner A|D|-> <end win|stuck|limit> <plies> <final key in hex>`,
+ * in the order of the game indexes whatever the number of threads.
+ *
+ * @param aSettings The settings of the run.
+ * @param aGameCount Number of games to play.
+ * @param aThreadCount Number of worker threads (`AI_ALL_CORES` for one per core).
+ * @param anOutput Stream receiving the lines.
+ * @param aResults Optional array of `aGameCount` results filled by the run (can be nullptr).
+ * @return `true` if all the games were played, `false` if a worker couldn't allocate its tables.
+ */
+bool runSelfPlay(const SelfPlaySettings& aSettings, int aGameCount, int aThreadCount, std::ostream& anOutput,
+                 SelfPlayResult* aResults = nullptr);
+
+#endif // SELFPLAY_H
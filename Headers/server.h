@@ -0,0 +1,203 @@
+/**
+ * @file server.h
+ *
+ * @brief Declarations of the network game server (many games per process).
+ *
+ * The server accepts TCP connections and runs every game of the process in one event loop
+ * (epoll, Linux only). The connections, the games and their boards are taken from pools
+ * allocated by `createServer()`: opening or closing a session never touches the heap.
+ *
+ * Protocol: one ASCII command per line, one or more reply lines (see notation.h for the
+ * positions and the moves).
+ * - `host 11|13`: creates a game and waits for an opponent, this connection attacks → `hosted <id>`;
+ * - `join <id>`: joins a hosted game as defender → `start <id> attack|defense <position>` to both players;
+ * - `new 11|13`: creates a game where this connection plays both roles → `start <id> both <position>`;
+ * - `move F2-F5`: plays a move (checked with `checkMovement()`) → `moved F2-F5 [x D4 ...]` to both players,
+ *   followed by `end <reason> attack|defense` when the game is finished;
+ * - `board` → `position <position>`;
+ * - `leave`: closes the game → `closed` to both players;
+ * - `profile` → `profile <json>`: the counters of the hot functions (see profile.h);
+ * - `quit` → `bye`, then the connection is closed.
+ *
+ * Errors are reported with `error <reason>` and don't close the connection (except a line longer
+ * than `SERVER_LINE_LENGTH` or an output buffer full because the client doesn't read).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <atomic>
+#include <string_view>
+#include "typeDef.h"
+#include "boardpool.h"
+
+/**
+ * @brief Maximum length of a command line (with its line end).
+ */
+const int SERVER_LINE_LENGTH = 128;
+
+/**
+ * @brief Size of the buffer of the replies not sent yet, per connection.
+ */
+const int SERVER_OUTPUT_BYTES = 2048;
+
+/**
+ * @brief Default number of connections of a server.
+ */
+const int SERVER_MAX_CONNECTIONS = 4096;
+
+/**
+ * @brief Default number of games of a server.
+ */
+const int SERVER_MAX_GAMES = 4096;
+
+/**
+ * @struct ServerConnection
+ * @brief A client of the server, with its input and output buffers.
+ */
+struct ServerConnection
+{
+    int itsSocket = -1;                     /**< The socket, -1 for a connection without socket (tests). */
+    bool itsIsOpen = false;                 /**< true if the slot is used. */
+    bool itsIsClosing = false;              /**< true to close the connection once its output is sent. */
+    bool itsIsWaitingOutput = false;        /**< true if the socket is watched for writing (output not fully sent). */
+    bool itsIsPending = false;              /**< true if the connection is in the list of outputs to send. */
+    int itsGame = -1;                       /**< Index of the game of the connection, -1 if none. */
+    int itsNextFree = -1;                   /**< Next free connection (free list). */
+    int itsInputLength = 0;                 /**< Characters of the incomplete line. */
+    int itsOutputLength = 0;                /**< Characters of `itsOutput` not sent yet. */
+    char itsInput[SERVER_LINE_LENGTH];      /**< The incomplete line received. */
+    char itsOutput[SERVER_OUTPUT_BYTES];    /**< The replies not sent yet. */
+};
+
+/**
+ * @struct ServerGame
+ * @brief A game of the server and the connections playing it.
+ */
+struct ServerGame
+{
+    Game itsGame;                   /**< The game (its board is taken from the pool of the server while it is used). */
+    int itsPlayers[2] = {-1, -1};   /**< The connections of ATTACK and DEFENSE (-1 while waiting, the same for both roles in a `new` game). */
+    bool itsIsUsed = false;         /**< true if the slot is used. */
+    int itsNextFree = -1;           /**< Next free game (free list). */
+};
+
+/**
+ * @struct ServerStats
+ * @brief Counters of a server since its creation.
+ */
+struct ServerStats
+{
+    long long itsAccepted = 0;   /**< Connections accepted. */
+    long long itsRefused = 0;    /**< Connections refused (no free connection). */
+    long long itsGames = 0;      /**< Games created. */
+    long long itsMoves = 0;      /**< Moves played. */
+    int itsOpenConnections = 0;  /**< Connections open now. */
+    int itsOpenGames = 0;        /**< Games open now. */
+};
+
+/**
+ * @struct GameServer
+ * @brief The pools of connections and games, and the sockets of the event loop.
+ */
+struct GameServer
+{
+    ServerConnection* itsConnections = nullptr; /**< The pool of connections. */
+    int itsConnectionCapacity = 0;              /**< Size of the pool of connections. */
+    int itsFreeConnection = -1;                 /**< First free connection, -1 if none. */
+    ServerGame* itsGames = nullptr;             /**< The pool of games. */
+    int itsGameCapacity = 0;                    /**< Size of the pool of games. */
+    int itsFreeGame = -1;                       /**< First free game, -1 if none. */
+    BoardPool itsBoards;                        /**< The boards of the games (one per game). */
+    int* itsPending = nullptr;                  /**< Connections with output to send (one entry per connection at most). */
+    int itsPendingCount = 0;                    /**< Number of entries of `itsPending`. */
+    int itsListenSocket = -1;                   /**< The listening socket, -1 if not listening. */
+    int itsPort = 0;                            /**< The port of the listening socket. */
+    int itsEventQueue = -1;                     /**< The epoll instance, -1 if not listening. */
+    atomic<bool> itsIsStopping{false};          /**< Set by `stopServer()` to leave `runServer()`. */
+    ServerStats itsStats;                       /**< The counters. */
+};
+
+/**
+ * @brief Allocates the pools of a server.
+ *
+ * @param aServer The server to initialize.
+ * @param aMaxConnections The number of connections.
+ * @param aMaxGames The number of games.
+ * @return `true` if successful, `false` if a size is not positive or an allocation failed.
+ */
+bool createServer(GameServer& aServer, int aMaxConnections = SERVER_MAX_CONNECTIONS, int aMaxGames = SERVER_MAX_GAMES);
+
+/**
+ * @brief Closes the sockets of a server and frees its pools.
+ *
+ * @param aServer The server to release.
+ */
+void deleteServer(GameServer& aServer);
+
+/**
+ * @brief Takes a connection from the pool.
+ *
+ * @param aServer The server.
+ * @param aSocket The socket of the client (-1 for a connection without socket).
+ * @return The index of the connection, or -1 if the pool is empty.
+ */
+int openConnection(GameServer& aServer, int aSocket);
+
+/**
+ * @brief Closes a connection: its game is closed for the opponent, its socket is closed.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ */
+void closeConnection(GameServer& aServer, int aConnection);
+
+/**
+ * @brief Executes one command line of a connection.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ * @param aLine The command, without its line end.
+ * @return `false` if the connection must be closed (after sending its output).
+ */
+bool handleServerLine(GameServer& aServer, int aConnection, string_view aLine);
+
+/**
+ * @brief Adds received data to the input of a connection and executes its complete lines.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ * @param aData The received bytes.
+ * @param aLength The number of bytes.
+ * @return `false` if the connection must be closed (`quit` or line too long).
+ */
+bool receiveServerData(GameServer& aServer, int aConnection, const char* aData, int aLength);
+
+/**
+ * @brief Opens the listening socket of the server.
+ *
+ * @param aServer The server (created, not listening).
+ * @param aPort The TCP port (0 picks a free port, see `itsPort`).
+ * @return `true` if the server listens, `false` on error or on systems without epoll.
+ */
+bool listenServer(GameServer& aServer, int aPort);
+
+/**
+ * @brief Runs the event loop until `stopServer()` is called.
+ *
+ * @param aServer The listening server.
+ * @return `true` if the loop stopped normally, `false` on error.
+ */
+bool runServer(GameServer& aServer);
+
+/**
+ * @brief Asks the event loop to stop (can be called from another thread or a signal handler).
+ *
+ * @param aServer The server.
+ */
+void stopServer(GameServer& aServer);
+
+#endif // SERVER_H
@@ -69,6 +69,32 @@ void test_createBoard();
  */
 void test_deleteBoard();
 
+/**
+ * @brief Test function for acquireBoard.
+ *
+ * This function tests the pool of boards: boards are taken and given back in O(1) without
+ * allocation, their cells are cleared, and a pooled board changes size without reallocation
+ * (resizeBoard, restoreSnapshot) and is never freed by deleteBoard.
+ */
+void test_acquireBoard();
+
+/**
+ * @brief Test function for the copyBoard function.
+ *
+ * This function tests the copyBoard function by copying initialized boards of both sizes,
+ * checking that the copy is independent from the source, and that a destination of another
+ * size is reallocated.
+ */
+void test_copyBoard();
+
+/**
+ * @brief Test function for takeSnapshot and restoreSnapshot.
+ *
+ * This function tests the snapshot of a game: a restored game has the same cells, key, masks
+ * and player to move, the snapshot doesn't change with the game, and invalid snapshots are rejected.
+ */
+void test_takeSnapshot();
+
 /**
  * @brief Test function for the initializeBoard function.
  *
@@ -76,6 +102,41 @@ void test_deleteBoard();
  */
 void test_initializeBoard();
 
+/**
+ * @brief Test function for the updateBitboards function.
+ *
+ * This function tests the updateBitboards function by checking that every mask matches the cells
+ * after initialization, that movePiece/capturePieces keep the masks synchronized, and that the
+ * mask-based endgame checks give the same answers as the cell scans.
+ */
+void test_updateBitboards();
+
+/**
+ * @brief Test function for the computeHash function.
+ *
+ * This function tests the Zobrist key: starting keys, side to move, incremental updates done by
+ * makeMove/unmakeMove compared with a full recomputation, and two move orders reaching the same position.
+ */
+void test_computeHash();
+
+/**
+ * @brief Test function for the writeBoardText function.
+ *
+ * This function tests the writeBoardText function on the starting positions of both sizes
+ * (lines, pieces and fortresses), checks that displayBoard prints the same text, and that
+ * a small buffer or a board without cells is refused.
+ */
+void test_writeBoardText();
+
+/**
+ * @brief Test function for the composeFrame and composeUpdate functions.
+ *
+ * This function tests that a full frame clears the screen and holds the logo, the status line
+ * and the board, and that an update only redraws the changed cells: none, the start and the end
+ * of a move, or the start, the end and the captured cell. A size change needs a full frame.
+ */
+void test_composeUpdate();
+
 // ─────────────────────────────────────────────────────────────────
 // Position and Cell Validation Tests
 // ─────────────────────────────────────────────────────────────────
@@ -107,6 +168,39 @@ void test_isValidPosition();
  */
 void test_isEmptyCell();
 
+/**
+ * @brief Test function for the formatPosition function.
+ *
+ * This function tests the formatPosition function on the starting positions of both sizes,
+ * with the DEFENSE role to move, and checks that a small buffer or a board without cells is refused.
+ */
+void test_formatPosition();
+
+/**
+ * @brief Test function for the parsePosition function.
+ *
+ * This function tests the parsePosition function on the starting positions, on the positions
+ * of random games (written then read back), and on malformed texts which must leave the game untouched.
+ */
+void test_parsePosition();
+
+/**
+ * @brief Test function for the formatMove function.
+ *
+ * This function tests the formatMove function on moves with one and two digit columns,
+ * and checks that a small buffer or a position out of range is refused.
+ */
+void test_formatMove();
+
+/**
+ * @brief Test function for the parseMove function.
+ *
+ * This function tests the parseMove function with valid moves (uppercase, lowercase, without `-`,
+ * with a line end), with malformed texts and with positions out of the board for both sizes,
+ * and reads back every move generated from the starting positions.
+ */
+void test_parseMove();
+
 // ─────────────────────────────────────────────────────────────────
 // Movement and Action Tests
 // ─────────────────────────────────────────────────────────────────
@@ -121,6 +215,15 @@ void test_isEmptyCell();
  */
 void test_isValidMovement();
 
+/**
+ * @brief Test function for the checkMovement function.
+ *
+ * This function tests the checkMovement function by checking the status returned for each
+ * kind of rejected move, that nothing is printed, and that the moves accepted on the starting
+ * boards are exactly the ones returned by generateMoves.
+ */
+void test_checkMovement();
+
 /**
  * @brief Test the movePiece function with different board sizes and piece types.
  *
@@ -141,6 +244,48 @@ void test_movePiece();
  */
 void test_capturePieces();
 
+/**
+ * @brief Test function for perft.
+ *
+ * This function tests the perft function by comparing the counts of both starting positions
+ * with the reference values up to depth 3, and by checking that the game is restored.
+ */
+void test_perft();
+
+/**
+ * @brief Test function for Engine.
+ *
+ * This function tests the engines of both board sizes by comparing their compile-time masks
+ * with the masks built from the cells, their starting layout with the piece counts,
+ * and their move generation with the public functions; unsupported sizes are rejected.
+ */
+void test_engine();
+
+/**
+ * @brief Test function for makeMove.
+ *
+ * This function tests the makeMove function by checking the undo record (moved piece,
+ * captured mask, previous player) on hand-made capture positions for both roles.
+ */
+void test_makeMove();
+
+/**
+ * @brief Test function for unmakeMove.
+ *
+ * This function tests the unmakeMove function by undoing a capture and sequences of generated
+ * moves, and by comparing the cells, the masks and the current player with the original state.
+ */
+void test_unmakeMove();
+
+/**
+ * @brief Test function for the generateMoves function.
+ *
+ * This function tests the generateMoves function by counting the legal moves of the starting
+ * positions for both roles and sizes, and by checking the special cell rules (KING only on
+ * FORTRESS/CASTLE, no crossing) on hand-made boards, with and without bitboards.
+ */
+void test_generateMoves();
+
 /**
  * @brief Test function for switchCurrentPlayer.
  *
@@ -162,6 +307,14 @@ void test_switchCurrentPlayer();
  */
 void test_isSwordLeft();
 
+/**
+ * @brief Test function for countPieces.
+ *
+ * This function tests the countPieces function on the starting boards (mask path)
+ * and on hand-made boards (scan path) for every piece type.
+ */
+void test_countPieces();
+
 /**
  * @brief Test function for getKingPosition.
  *
@@ -198,6 +351,15 @@ void test_isKingCapturedSimple();
  */
 void test_isKingCapturedRecursive();
 
+/**
+ * @brief Test function for getGameStatus.
+ *
+ * This function tests the getGameStatus function by checking the status cached by makeMove and
+ * unmakeMove in endgame scenarios, and by comparing it with a full scan of the board
+ * along random games on both board sizes.
+ */
+void test_getGameStatus();
+
 /**
  * @brief Test function for isGameFinished.
  *
@@ -216,6 +378,269 @@ void test_isGameFinished();
  */
 void test_whoWon();
 
+// ─────────────────────────────────────────────────────────────────
+// Computer Player Tests
+// ─────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Test function for scanBoardMasks.
+ *
+ * This function tests the scanBoardMasks function with every kernel supported by the CPU
+ * on random cells of several board sizes, against masks built cell by cell.
+ */
+void test_scanBoardMasks();
+
+/**
+ * @brief Test function for computeEvalFeatures.
+ *
+ * This function tests the computeEvalFeatures function on the starting positions, on a hand-made
+ * position around the king, and compares the mobility with generateMoves on random games,
+ * with and without bitboards.
+ */
+void test_computeEvalFeatures();
+
+/**
+ * @brief Test function for evaluatePosition.
+ *
+ * This function tests the evaluatePosition function: the score is symmetric for both roles,
+ * a lost SHIELD is good for ATTACK and an open line from the king to a corner is good for DEFENSE.
+ */
+void test_evaluatePosition();
+
+/**
+ * @brief Test function for searchBestMove.
+ *
+ * This function tests the searchBestMove function: it finds a winning move in one for both roles,
+ * plays a legal move within its time budget on the starting boards, and leaves the game unchanged,
+ * with one and with several threads. It also tests the allocation rules of createAi.
+ */
+void test_searchBestMove();
+
+/**
+ * @brief Test function for buildOpeningBook.
+ *
+ * This function tests the buildOpeningBook function on the first two plies of the LITTLE board:
+ * one entry per position, the limit of positions, the round trip through writeOpeningBook and
+ * openOpeningBook, the lookup of probeOpeningBook, and a searchBestMove answered by the book.
+ */
+void test_buildOpeningBook();
+
+/**
+ * @brief Test function for buildEndgameTables.
+ *
+ * This function tests the buildEndgameTables function on the KING against one and two swords:
+ * the values of an escape in one move for both roles, the move of probeEndgameTables, the
+ * positions without a table, and the round trip through writeEndgameTables and openEndgameTables.
+ */
+void test_buildEndgameTables();
+
+/**
+ * @brief Test function for openAnalysisCache.
+ *
+ * This function tests the creation of a cache file, its reopening with its own size and its
+ * results, and the rejection of invalid sizes and of a file of another format.
+ */
+void test_openAnalysisCache();
+
+/**
+ * @brief Test function for storeAnalysisCache.
+ *
+ * This function tests the results kept for a position (the deepest one), the eviction of the
+ * least recently used position of a full bucket, the keys of another board size, the answer of
+ * searchBestMove from the cache and preloadAnalysisCache.
+ */
+void test_storeAnalysisCache();
+
+/**
+ * @brief Test function for encodeEvalPosition.
+ *
+ * This function tests the encoding of the initial boards of both sizes: the count of each piece
+ * and special cell plane, the KING on the CASTLE, the side-to-move plane, the same planes from
+ * the bitboards and from a scan of the cells, and a board without cells.
+ */
+void test_encodeEvalPosition();
+
+/**
+ * @brief Test function for evaluateEvalBatch.
+ *
+ * This function tests a batch of positions of the LITTLE board: the sizes mixed in a batch,
+ * the scores of the linear model for both players to move, a model of the wrong size,
+ * the scores kept below the win scores, and searchBestMove with a backend attached.
+ */
+void test_evaluateEvalBatch();
+
+/**
+ * @brief Test function for searchMctsMove.
+ *
+ * This function tests the allocation rules of createMcts, the winning moves in one for both roles,
+ * the repeatability of a search with one thread and a playout limit, the playout count with
+ * several threads, and a finished game.
+ */
+void test_searchMctsMove();
+
+/**
+ * @brief Test function for chooseComputerMove.
+ *
+ * This function tests the names of the engines and that a computer player plays a legal move
+ * with both engines, on the same game interface.
+ */
+void test_chooseComputerMove();
+
+// ─────────────────────────────────────────────────────────────────
+// Self-play Tests
+// ─────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Test function for playSelfPlayGame.
+ *
+ * This function tests one headless game: random games are reproducible from their seed,
+ * stop at the ply limit, and AI games end with a winner given by whoWon.
+ */
+void test_playSelfPlayGame();
+
+/**
+ * @brief Test function for runSelfPlay.
+ *
+ * This function tests the thread pool of the self-play runner: one line per game in index order,
+ * and the same output with one or several threads.
+ */
+void test_runSelfPlay();
+
+/**
+ * @brief Test function for validateGameRecord.
+ *
+ * This function tests the verdicts of records without moves, with a bad header, an illegal
+ * move, an unreadable move, a wrong winner and a move after the end, and of complete games.
+ */
+void test_validateGameRecord();
+
+/**
+ * @brief Test function for runReplay.
+ *
+ * This function tests that the verdicts of several chunks of records are written in the order of
+ * the input whatever the number of threads, and that the comments and empty lines are skipped.
+ */
+void test_runReplay();
+
+/**
+ * @brief Test function for getBoardAllocationCount.
+ *
+ * This function tests that the steady state allocates no board: self-play games with a pool,
+ * searches with helper threads and games of the server opened and closed many times.
+ */
+void test_getBoardAllocationCount();
+
+/**
+ * @brief Test function for collectProfile.
+ *
+ * This function tests the names of the instrumented functions, the JSON report, and the calls
+ * counted in two threads: added together with `HNEFATAFL_PROFILE`, all 0 without it.
+ */
+void test_collectProfile();
+
+/**
+ * @brief Test function for runBenchmark.
+ *
+ * This function tests the fixtures of both phases (0 to 4 captures, encircled KING, illegal moves),
+ * one run of every benchmark, and the comparison of the JSON results with a baseline.
+ */
+void test_runBenchmark();
+
+// ─────────────────────────────────────────────────────────────────
+// Save Format and Journal Tests
+// ─────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Test function for encodeSave.
+ *
+ * This function tests the encodeSave function: the header fields, the 2 bits per cell packing,
+ * the size of the record and the truncation of long names.
+ */
+void test_encodeSave();
+
+/**
+ * @brief Test function for decodeSave.
+ *
+ * This function tests the decodeSave function: a game played for a few moves is rebuilt exactly
+ * from its record, and corrupted records are rejected without modifying the game.
+ */
+void test_decodeSave();
+
+/**
+ * @brief Test function for importTextSave.
+ *
+ * This function tests the legacy text import: the multi-byte `☒` glyph counts as one cell,
+ * the special cells are rebuilt on both sizes and truncated or invalid texts are rejected.
+ */
+void test_importTextSave();
+
+/**
+ * @brief Test function for appendJournal.
+ *
+ * This function tests the journal writer: the header is written by openJournal, each move adds
+ * 4 bytes, the buffer is only written every itsFlushInterval moves and closeJournal writes the rest.
+ */
+void test_appendJournal();
+
+/**
+ * @brief Test function for replayJournal.
+ *
+ * This function tests the journal replay: games written move by move (and resumed in the middle)
+ * are rebuilt exactly, an interrupted last record is ignored and illegal moves are rejected.
+ */
+void test_replayJournal();
+
+/**
+ * @brief Test function for addDatabaseGame.
+ *
+ * This function tests the database writer and reader: random games of both sizes are replayed
+ * from the mapping to the same positions, illegal games are refused and corrupted files are rejected.
+ */
+void test_addDatabaseGame();
+
+/**
+ * @brief Test function for computeDatabaseStats.
+ *
+ * This function tests the parallel replay of a database: the statistics are the same with
+ * 1 thread, 4 threads and all the cores, a wrong winner in the index is detected and the
+ * opening statistics count the games starting with a move.
+ */
+void test_computeDatabaseStats();
+
+/**
+ * @brief Test function for recordSave.
+ *
+ * This function tests the save index in memory and on disk: saves are kept sorted and found
+ * without scanning the folder, there is no limit on their number, each change replaces the
+ * index file and invalid names are refused.
+ */
+void test_recordSave();
+
+/**
+ * @brief Test function for loadSaveIndex.
+ *
+ * This function tests the creation of the index of a folder written before the index: the binary
+ * and text saves found are described once (size, plies, offset), other files are ignored.
+ */
+void test_loadSaveIndex();
+
+/**
+ * @brief Test function for handleServerLine.
+ *
+ * This function tests the protocol of the game server on connections without socket: hosting,
+ * joining, the moves checked with checkMovement and sent as diffs (captures included), the end of
+ * a game, the errors, leaving a game, the pools and the lines received in several pieces.
+ */
+void test_handleServerLine();
+
+/**
+ * @brief Test function for runServer.
+ *
+ * This function tests the event loop on loopback sockets: a game between two clients, many
+ * games at the same time, a client refused when the pool is full and the stop of the loop.
+ */
+void test_runServer();
+
 // ========================= HELPER FUNCTIONS =========================
 
 /**
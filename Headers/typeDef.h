@@ -11,6 +11,7 @@
 #define TYPEDEF_H
 
 #include <string>
+#include <cstdint>
 using namespace std;
 
 
@@ -50,7 +51,7 @@ enum PlayerRole
  * - `FORTRESS`: A cell that acts as a fortress.
  * - `CASTLE`: A cell that acts as a castle.
  */
-enum CellType
+enum CellType : unsigned char
 {
     NORMAL,    /**< Represents a normal game board cell. */
     FORTRESS,  /**< Represents a fortress cell. */
@@ -66,7 +67,7 @@ enum CellType
  * - `SWORD`: Represents an attacker (sword) piece.
  * - `KING`: Represents the king piece.
  */
-enum PieceType
+enum PieceType : unsigned char
 {
     NONE,    /**< Represents an empty cell (no piece). */
     SHIELD,  /**< Represents a shield piece. */
@@ -74,17 +75,81 @@ enum PieceType
     KING     /**< Represents the king piece. */
 };
 
+/**
+ * @enum MoveStatus
+ * @brief Represents the result of the validation of a move.
+ *
+ * - `VALID_MOVE`: The move can be played.
+ * - `OUT_OF_BOUNDS`: The start or end position is outside the board.
+ * - `WRONG_PIECE`: The start cell does not hold a piece of the current player.
+ * - `SPECIAL_CELL`: A piece other than the KING tries to finish on a FORTRESS or CASTLE.
+ * - `NO_MOVEMENT`: The start and end positions are the same.
+ * - `NOT_STRAIGHT`: The move is neither horizontal nor vertical.
+ * - `BLOCKED`: A piece or a special cell is on the path, or the end cell is occupied.
+ */
+enum MoveStatus
+{
+    VALID_MOVE,     /**< The move is valid. */
+    OUT_OF_BOUNDS,  /**< A position is out of the board. */
+    WRONG_PIECE,    /**< The moved piece does not belong to the current player. */
+    SPECIAL_CELL,   /**< Only the KING can finish on a FORTRESS or CASTLE. */
+    NO_MOVEMENT,    /**< The piece does not move. */
+    NOT_STRAIGHT,   /**< The move is diagonal. */
+    BLOCKED         /**< The path or the end cell is not free. */
+};
+
+/**
+ * @enum GameStatus
+ * @brief Represents the state of a game, in the order used by `whoWon()`.
+ *
+ * - `IN_PROGRESS`: The game is not finished.
+ * - `KING_CAPTURED`: The KING and its shields are fully surrounded, ATTACK wins.
+ * - `NO_SWORD_LEFT`: All the swords are captured, DEFENSE wins.
+ * - `KING_ESCAPED`: The KING reached a FORTRESS, DEFENSE wins.
+ */
+enum GameStatus : unsigned char
+{
+    IN_PROGRESS,    /**< The game continues. */
+    KING_CAPTURED,  /**< Victory of the attacker (see `isKingCapturedRecursive()`). */
+    NO_SWORD_LEFT,  /**< Victory of the defender (no attacker left). */
+    KING_ESCAPED    /**< Victory of the defender (the king is on a fortress). */
+};
+
 /**
  * @struct Cell
  * @brief Structure to represent the state of a single cell on the board.
  *
  * Each cell has a type (`itsCellType`) and a piece (`itsPieceType`),
  * which can be empty or occupied by a specific piece.
+ * Both are packed in 4 bits so a cell takes a single byte.
  */
 struct Cell
 {
-    CellType itsCellType;   /**< The type of the cell (e.g., NORMAL, FORTRESS, CASTLE). */
-    PieceType itsPieceType; /**< The type of piece occupying the cell (e.g., NONE, SHIELD, SWORD, KING). */
+    CellType itsCellType : 4;   /**< The type of the cell (e.g., NORMAL, FORTRESS, CASTLE). */
+    PieceType itsPieceType : 4; /**< The type of piece occupying the cell (e.g., NONE, SHIELD, SWORD, KING). */
+};
+
+static_assert(sizeof(Cell) == 1, "A cell must be packed in a single byte");
+
+/**
+ * @typedef CellRow
+ * @brief One row of cells, always sized for a BIG board.
+ *
+ * Every board uses the same row stride, so all the cells of a board fit in one
+ * contiguous block while keeping the `itsCells[row][col]` indexing.
+ */
+typedef Cell CellRow[BIG];
+
+/**
+ * @struct BitBoard
+ * @brief Structure representing a set of cells as a packed 192-bit mask.
+ *
+ * Cell (row, col) is stored at bit `row * itsSize + col`, spread over three 64-bit words.
+ * 192 bits are enough for both LITTLE (121 cells) and BIG (169 cells) boards.
+ */
+struct BitBoard
+{
+    uint64_t itsWords[3] = {0, 0, 0}; /**< The 3 words of the mask (bits 0-63, 64-127, 128-191). */
 };
 
 /**
@@ -92,11 +157,24 @@ struct Cell
  * @brief Structure representing the game board as a 2D grid of `Cell` structures.
  *
  * The board contains a set of cells arranged in a grid with a size defined by `itsSize`.
+ * Alongside the cells, the board can hold one bitboard per piece type and per special cell type.
+ * They are only used when `itsHasBitboards` is true (see `updateBitboards()`), like the piece
+ * counts, the king index and the game status, which make the endgame checks O(1).
+ * `itsHash` identifies the position of the game using the board; it is kept up to date by
+ * `movePiece()`, `capturePieces()` and `switchCurrentPlayer()`.
  */
 struct Board
 {
-    Cell** itsCells = nullptr;  /**< 2D array representing the cells on the board. */
+    CellRow* itsCells = nullptr; /**< Contiguous 2D array of cells (`itsSize` rows of `BIG` cells). */
     BoardSize itsSize = LITTLE; /**< The size of the board (LITTLE or BIG). */
+    BitBoard itsPieceMasks[4];  /**< One mask per PieceType (SHIELD, SWORD, KING), the NONE slot is unused. */
+    BitBoard itsCellMasks[3];   /**< One mask per CellType (FORTRESS, CASTLE), the NORMAL slot is unused. */
+    bool itsHasBitboards = false; /**< true if the masks, counts, king index and status are synchronized with `itsCells`. */
+    bool itsIsPooled = false;     /**< true if the cells are a board of a `BoardPool` (`BIG` rows, never freed by `deleteBoard()`). */
+    int itsPieceCounts[4] = {0, 0, 0, 0}; /**< Number of pieces of each PieceType, the NONE slot is unused. */
+    int itsKingIndex = -1;        /**< `cellIndex()` of the KING, -1 if there is no KING. */
+    GameStatus itsStatus = IN_PROGRESS; /**< State of the game on this board (see `getGameStatus()`). */
+    uint64_t itsHash = 0;         /**< Zobrist key of the position (pieces and role to move, see `computeHash()`). */
 };
 
 /**
@@ -124,17 +202,54 @@ struct Move
     Position itsEndPosition;   /**< The ending position of the move. */
 };
 
+/**
+ * @brief Maximum number of legal moves in any position.
+ *
+ * Each empty cell can be reached by at most one piece from each of the 4 directions,
+ * so a BIG board never has more than 4 * 13 * 13 legal moves.
+ */
+const int MAX_MOVES = 4 * BIG * BIG;
+
+/**
+ * @struct MoveList
+ * @brief Fixed-capacity list of moves filled by `generateMoves()`.
+ *
+ * The moves are stored inline so a list can live on the stack without any allocation.
+ */
+struct MoveList
+{
+    Move itsMoves[MAX_MOVES]; /**< The moves of the list (only the first `itsCount` are valid). */
+    int itsCount = 0;         /**< The number of moves in the list. */
+};
+
 /**
  * @struct Player
  * @brief Structure representing a player in the game.
  *
  * Each player has a name (`itsName`) and a role (`itsRole`),
- * which can either be ATTACK or DEFENSE.
+ * which can either be ATTACK or DEFENSE. A player can be played by the computer (`itsIsComputer`).
  */
 struct Player
 {
     string itsName;         /**< The name of the player. */
     PlayerRole itsRole;     /**< The role of the player (ATTACK or DEFENSE). */
+    bool itsIsComputer = false; /**< true if the moves are chosen by the AI (see `searchBestMove()`). */
+};
+
+/**
+ * @struct MoveUndo
+ * @brief Structure recording what `makeMove()` changed, so `unmakeMove()` can restore it.
+ *
+ * The captured neighbors are stored as a 4-bit mask (west, east, north, south of the end position);
+ * they are always pieces of the opponent (SHIELD for an ATTACK move, SWORD for a DEFENSE move).
+ */
+struct MoveUndo
+{
+    Move itsMove;                     /**< The played move. */
+    PieceType itsMovedPiece = NONE;   /**< The piece that moved. */
+    PieceType itsCapturedPiece = NONE; /**< The type of the captured pieces. */
+    unsigned char itsCapturedMask = 0; /**< Bit d set if the neighbor in direction d was captured. */
+    Player* itsPreviousPlayer = nullptr; /**< The current player before the move. */
 };
 
 /**
@@ -152,4 +267,63 @@ struct Game
     Player* itsCurrentPlayer = &itsPlayer1; /**< A pointer to the current player. */
 };
 
+/**
+ * @struct GameSnapshot
+ * @brief Self-contained copy of a game position, safe to copy and to give to another thread.
+ *
+ * Unlike `Game`, it holds no pointer: the cells are stored inline and the current player is
+ * stored as an index (1 or 2). The names of the players are not part of the position.
+ */
+struct GameSnapshot
+{
+    Cell itsCells[BIG][BIG] = {};          /**< The cells (only `itsSize` x `itsSize` are used). */
+    BoardSize itsSize = LITTLE;            /**< The size of the board. */
+    PlayerRole itsPlayerRoles[2] = {ATTACK, DEFENSE}; /**< The roles of player 1 and player 2. */
+    bool itsIsComputer[2] = {false, false}; /**< `itsIsComputer` of player 1 and player 2. */
+    int itsCurrentPlayer = 1;              /**< The player to move (1 or 2). */
+    uint64_t itsHash = 0;                  /**< The Zobrist key of the position. */
+};
+
+/**
+ * @brief Magic bytes at the start of a binary save file.
+ */
+const char SAVE_MAGIC[4] = {'H', 'N', 'F', 'T'};
+
+/**
+ * @brief Version of the binary save format written by `encodeSave()`.
+ */
+const unsigned char SAVE_VERSION = 1;
+
+/**
+ * @brief Width of a player name in a save (longer names are cut, the last byte is always 0).
+ */
+const int SAVE_NAME_LENGTH = 32;
+
+/**
+ * @brief Number of bytes of the packed board of a save (2 bits per cell of a BIG board).
+ */
+const int SAVE_BOARD_BYTES = (BIG * BIG * 2 + 7) / 8;
+
+/**
+ * @struct SaveRecord
+ * @brief Binary save of a game, written and read in one block.
+ *
+ * Every field is made of bytes, so the record has no padding and no byte order issue.
+ * Cell `cellIndex(row, col, size)` is stored on 2 bits (its PieceType) at bit `2 * index`
+ * of `itsCells`. The cell types are not stored: they only depend on the size of the board.
+ */
+struct SaveRecord
+{
+    char itsMagic[4] = {SAVE_MAGIC[0], SAVE_MAGIC[1], SAVE_MAGIC[2], SAVE_MAGIC[3]}; /**< `SAVE_MAGIC`. */
+    unsigned char itsVersion = SAVE_VERSION;  /**< `SAVE_VERSION`. */
+    unsigned char itsSize = LITTLE;           /**< The size of the board (11 or 13). */
+    unsigned char itsCurrentPlayer = 1;       /**< The player to move (1 or 2). */
+    unsigned char itsPlayerRoles[2] = {ATTACK, DEFENSE}; /**< The roles of player 1 and player 2. */
+    unsigned char itsIsComputer[2] = {0, 0};  /**< 1 if the player is played by the computer. */
+    char itsNames[2][SAVE_NAME_LENGTH] = {};  /**< The names of player 1 and player 2 (0 terminated). */
+    unsigned char itsCells[SAVE_BOARD_BYTES] = {}; /**< The pieces, 2 bits per cell. */
+};
+
+static_assert(sizeof(SaveRecord) == 11 + 2 * SAVE_NAME_LENGTH + SAVE_BOARD_BYTES, "A save record must not have padding");
+
 #endif // TYPEDEF_H
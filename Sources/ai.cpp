@@ -0,0 +1,811 @@
+/**
+ * @file ai.cpp
+ *
+ * @brief Implementation of the computer player (alpha-beta search).
+ *
+ * Iterative deepening PVS over `generateMoves()` with `makeMove()`/`unmakeMove()`,
+ * a transposition table keyed by `Board::itsHash`, killer moves and a history table.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/ai.h"
+#include "../Headers/evalfeatures.h"
+#include "../Headers/book.h"
+#include "../Headers/analysis.h"
+#include "../Headers/batcheval.h"
+#include "../Headers/profile.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ============================================================================
+// SECTION 1: SEARCH TABLES
+// ============================================================================
+
+/**
+ * @brief Number of slots of the history table (2 roles x start cell x end cell).
+ */
+static const int HISTORY_SIZE = 2 * BIG * BIG * BIG * BIG;
+
+/**
+ * @brief Allocates the tables owned by each thread (history and move lists).
+ *
+ * @param aSearch The state of one thread.
+ * @return `true` if the allocation succeeded.
+ */
+static bool createThreadTables(AiSearch& aSearch) {
+    aSearch.itsHistory = new (nothrow) int[HISTORY_SIZE];
+    aSearch.itsPlies = new (nothrow) PlyMoves[AI_MAX_PLY];
+    return aSearch.itsHistory != nullptr && aSearch.itsPlies != nullptr;
+}
+
+/**
+ * @brief Allocates the tables of the search.
+ *
+ * @param aSearch The search state to initialize (must not be already created).
+ * @param aTableBits The transposition table holds 2^aTableBits entries (1-28).
+ * @param aThreadCount Number of search threads (1-`AI_MAX_THREADS`, `AI_ALL_CORES` for one per core).
+ * @return `true` if the allocation succeeded, `false` otherwise.
+ */
+bool createAi(AiSearch& aSearch, int aTableBits, int aThreadCount) {
+    //test if already created or invalid size
+    if (aSearch.itsTable != nullptr || aTableBits < 1 || aTableBits > 28 || aThreadCount < 0 || aThreadCount > AI_MAX_THREADS) {
+        return false;
+    }
+    if (aThreadCount == AI_ALL_CORES) {
+        //hardware_concurrency() can return 0 when unknown
+        aThreadCount = clamp(static_cast<int>(thread::hardware_concurrency()), 1, AI_MAX_THREADS);
+    }
+    const uint64_t ENTRIES = uint64_t(1) << aTableBits;
+    aSearch.itsTable = new (nothrow) TableEntry[ENTRIES];
+    aSearch.itsOwnsTable = true;
+    aSearch.itsTableMask = ENTRIES - 1;
+    bool isCreated = aSearch.itsTable != nullptr && createThreadTables(aSearch);
+    if (isCreated && aThreadCount > 1) {
+        aSearch.itsHelpers = new (nothrow) AiSearch[aThreadCount - 1];
+        isCreated = aSearch.itsHelpers != nullptr && createBoardPool(aSearch.itsBoards, aThreadCount - 1);
+        if (isCreated) {
+            aSearch.itsHelperCount = aThreadCount - 1;
+        }
+        //each helper keeps its board, the searches don't allocate
+        for (int helper = 0 ; isCreated && helper < aSearch.itsHelperCount ; helper++) {
+            AiSearch& state = aSearch.itsHelpers[helper];
+            state.itsTable = aSearch.itsTable;
+            state.itsTableMask = aSearch.itsTableMask;
+            state.itsSharedStop = &aSearch.itsStopSignal;
+            isCreated = createThreadTables(state) && acquireBoard(aSearch.itsBoards, state.itsGame.itsBoard, LITTLE);
+        }
+    }
+    if (!isCreated) {
+        deleteAi(aSearch);
+        return false;
+    }
+    clearAi(aSearch);
+    return true;
+}
+
+/**
+ * @brief Releases the batch of one thread and detaches its evaluator.
+ *
+ * @param aSearch The state of one thread.
+ */
+static void releaseBatch(AiSearch& aSearch) {
+    if (aSearch.itsBatch != nullptr) {
+        deleteEvalBatch(*aSearch.itsBatch);
+        delete aSearch.itsBatch;
+    }
+    aSearch.itsBatch = nullptr;
+    aSearch.itsEvaluator = nullptr;
+}
+
+/**
+ * @brief Releases the tables of the search.
+ *
+ * @param aSearch The search state to release (pointers are set to nullptr).
+ */
+void deleteAi(AiSearch& aSearch) {
+    releaseBatch(aSearch);
+    for (int helper = 0 ; helper < aSearch.itsHelperCount ; helper++) {
+        releaseBoard(aSearch.itsBoards, aSearch.itsHelpers[helper].itsGame.itsBoard);
+        deleteAi(aSearch.itsHelpers[helper]);
+    }
+    delete[] aSearch.itsHelpers;
+    deleteBoardPool(aSearch.itsBoards);
+    if (aSearch.itsOwnsTable) {
+        delete[] aSearch.itsTable;
+    }
+    delete[] aSearch.itsHistory;
+    delete[] aSearch.itsPlies;
+    aSearch.itsHelpers = nullptr;
+    aSearch.itsHelperCount = 0;
+    aSearch.itsTable = nullptr;
+    aSearch.itsOwnsTable = false;
+    aSearch.itsHistory = nullptr;
+    aSearch.itsPlies = nullptr;
+    aSearch.itsTableMask = 0;
+}
+
+/**
+ * @brief Clears the killers and the history of one thread.
+ *
+ * @param aSearch The state of one thread.
+ */
+static void clearThreadTables(AiSearch& aSearch) {
+    memset(aSearch.itsHistory, 0, sizeof(int) * HISTORY_SIZE);
+    for (Move* killers : aSearch.itsKillers) {
+        killers[0] = {{-1,-1},{-1,-1}};
+        killers[1] = {{-1,-1},{-1,-1}};
+    }
+}
+
+/**
+ * @brief Clears the transposition table, the killers and the history (new game).
+ *
+ * @param aSearch The search state to clear (must be created, helpers are cleared too).
+ */
+void clearAi(AiSearch& aSearch) {
+    if (aSearch.itsTable == nullptr) {
+        return;
+    }
+    for (uint64_t slot = 0 ; slot <= aSearch.itsTableMask ; slot++) {
+        aSearch.itsTable[slot].itsCheck.store(0, memory_order_relaxed);
+        aSearch.itsTable[slot].itsData.store(0, memory_order_relaxed);
+    }
+    clearThreadTables(aSearch);
+    for (int helper = 0 ; helper < aSearch.itsHelperCount ; helper++) {
+        clearThreadTables(aSearch.itsHelpers[helper]);
+    }
+}
+
+/**
+ * @brief Makes the search evaluate its horizon in batches with a backend.
+ *
+ * Allocates one batch per search thread; the backend is called by all the threads.
+ *
+ * @param aSearch The search state (must be created).
+ * @param aBackend The backend (must outlive its use), nullptr to go back to `evaluatePosition()`.
+ * @return `false` (and the search keeps `evaluatePosition()`) if the batches can't be allocated.
+ */
+bool attachEvaluator(AiSearch& aSearch, const EvalBackend* aBackend) {
+    if (aSearch.itsTable == nullptr) {
+        return false;
+    }
+    //the main state is -1, then the helpers
+    for (int helper = -1 ; helper < aSearch.itsHelperCount ; helper++) {
+        AiSearch& state = (helper == -1) ? aSearch : aSearch.itsHelpers[helper];
+        if (aBackend == nullptr) {
+            releaseBatch(state);
+            continue;
+        }
+        //a batch holds every child of a node
+        if (state.itsBatch == nullptr) {
+            state.itsBatch = new (nothrow) EvalBatch;
+            if (state.itsBatch == nullptr || !createEvalBatch(*state.itsBatch, MAX_MOVES)) {
+                attachEvaluator(aSearch, nullptr);
+                return false;
+            }
+        }
+        state.itsEvaluator = aBackend;
+    }
+    return true;
+}
+
+// ============================================================================
+// SECTION 2: EVALUATION
+// ============================================================================
+
+/**
+ * @brief Evaluates a position without searching.
+ *
+ * Combines the features of `computeEvalFeatures()` (without the mobility): material,
+ * the distance of the king to the corners, its open lines to a FORTRESS and the number
+ * of hostile cells around it.
+ *
+ * @param aGame The game to evaluate (`itsHasBitboards` must be true).
+ * @return The score from the point of view of the player to move (positive is good for that player).
+ */
+int evaluatePosition(const Game& aGame) {
+    EvalFeatures features;
+    computeEvalFeatures(aGame.itsBoard, features, false);
+    int score = AI_SWORD_VALUE * features.itsSwordCount - AI_SHIELD_VALUE * features.itsShieldCount;
+    if (features.itsHasKing) {
+        //distance to the nearest corner (the attack wants it far)
+        score += AI_KING_CORNER_DISTANCE * features.itsKingFortressDistance;
+        score -= AI_KING_OPEN_LINE * features.itsKingOpenLines;
+        score += AI_KING_HOSTILE_SIDE * features.itsKingHostileSides * features.itsKingHostileSides;
+    }
+    return (aGame.itsCurrentPlayer->itsRole == ATTACK) ? score : -score;
+}
+
+// ============================================================================
+// SECTION 3: SEARCH
+// ============================================================================
+
+/**
+ * @brief Score bigger than any reachable score.
+ */
+static const int INFINITE_SCORE = AI_WIN_SCORE + 1;
+
+/**
+ * @brief Checks if the game is over and who won (same order as `whoWon()`).
+ *
+ * @param aGame The game to check.
+ * @param aWinner Set to the role of the winner if the game is over.
+ * @return `true` if the game is over.
+ */
+static bool getWinner(const Game& aGame, PlayerRole& aWinner) {
+    const GameStatus STATUS = getGameStatus(aGame.itsBoard);
+    if (STATUS == IN_PROGRESS) {
+        return false;
+    }
+    aWinner = (STATUS == KING_CAPTURED) ? ATTACK : DEFENSE;
+    return true;
+}
+
+/**
+ * @brief Compares two moves.
+ *
+ * @return `true` if both moves have the same start and end positions.
+ */
+static bool isSameMove(const Move& aFirst, const Move& aSecond) {
+    return aFirst.itsStartPosition.itsRow == aSecond.itsStartPosition.itsRow && aFirst.itsStartPosition.itsCol == aSecond.itsStartPosition.itsCol
+        && aFirst.itsEndPosition.itsRow == aSecond.itsEndPosition.itsRow && aFirst.itsEndPosition.itsCol == aSecond.itsEndPosition.itsCol;
+}
+
+/**
+ * @brief Gets the slot of a move in the history table.
+ *
+ * @param aRole The role of the player who plays the move.
+ * @param aMove The move.
+ * @param aSize The size of the board.
+ * @return The index in `AiSearch::itsHistory`.
+ */
+static int historySlot(PlayerRole aRole, const Move& aMove, int aSize) {
+    const int START = cellIndex(aMove.itsStartPosition.itsRow, aMove.itsStartPosition.itsCol, aSize);
+    const int END = cellIndex(aMove.itsEndPosition.itsRow, aMove.itsEndPosition.itsCol, aSize);
+    return (aRole * BIG * BIG + START) * BIG * BIG + END;
+}
+
+/**
+ * @brief Checks the clock (and the stop signal of the main thread) every 1024 positions.
+ *
+ * @param aSearch The search state (`itsStopped` is set when the deadline is passed).
+ * @return `true` if the search must stop.
+ */
+static bool isTimeOver(AiSearch& aSearch) {
+    if ((aSearch.itsNodes & 1023) == 0) {
+        if (steady_clock::now() >= aSearch.itsDeadline
+            || (aSearch.itsSharedStop != nullptr && aSearch.itsSharedStop->load(memory_order_relaxed))) {
+            aSearch.itsStopped = true;
+        }
+    }
+    return aSearch.itsStopped;
+}
+
+/**
+ * @brief Converts a score before storing it (wins are stored relative to the position, not the root).
+ */
+static int scoreToTable(int aScore, int aPly) {
+    if (aScore > AI_WIN_SCORE - AI_MAX_PLY) {
+        return aScore + aPly;
+    }
+    if (aScore < -AI_WIN_SCORE + AI_MAX_PLY) {
+        return aScore - aPly;
+    }
+    return aScore;
+}
+
+/**
+ * @brief Converts a stored score back (see `scoreToTable()`).
+ */
+static int scoreFromTable(int aScore, int aPly) {
+    if (aScore > AI_WIN_SCORE - AI_MAX_PLY) {
+        return aScore - aPly;
+    }
+    if (aScore < -AI_WIN_SCORE + AI_MAX_PLY) {
+        return aScore + aPly;
+    }
+    return aScore;
+}
+
+/**
+ * @struct TableData
+ * @brief Unpacked content of a `TableEntry`.
+ */
+struct TableData
+{
+    int itsScore = 0;
+    int itsDepth = -1;
+    BoundType itsBound = BOUND_NONE;
+    int itsStart = 0;
+    int itsEnd = 0;
+};
+
+/**
+ * @brief Reads the entry of a position (lock-free).
+ *
+ * @param aSearch The search state.
+ * @param aKey The key of the position.
+ * @param aData Filled with the entry content if found.
+ * @return `true` if the slot holds this position.
+ */
+static bool probeEntry(const AiSearch& aSearch, uint64_t aKey, TableData& aData) {
+    const TableEntry& entry = aSearch.itsTable[aKey & aSearch.itsTableMask];
+    const uint64_t DATA = entry.itsData.load(memory_order_relaxed);
+    //a torn entry (two threads writing) gives a wrong check
+    if ((entry.itsCheck.load(memory_order_relaxed) ^ DATA) != aKey || DATA == 0) {
+        return false;
+    }
+    aData.itsScore = static_cast<int16_t>(DATA & 0xFFFF);
+    aData.itsDepth = static_cast<int8_t>((DATA >> 16) & 0xFF);
+    aData.itsBound = static_cast<BoundType>((DATA >> 24) & 0xFF);
+    aData.itsStart = static_cast<int>((DATA >> 32) & 0xFF);
+    aData.itsEnd = static_cast<int>((DATA >> 40) & 0xFF);
+    return aData.itsBound != BOUND_NONE;
+}
+
+/**
+ * @brief Stores a result in the transposition table (lock-free).
+ *
+ * A slot holding the same position searched deeper is kept.
+ */
+static void storeEntry(AiSearch& aSearch, uint64_t aKey, int aDepth, int aScore, BoundType aBound, const Move& aMove, int aPly, int aSize) {
+    TableData previous;
+    if (probeEntry(aSearch, aKey, previous) && previous.itsDepth > aDepth) {
+        return;
+    }
+    const uint64_t START = static_cast<uint64_t>(cellIndex(aMove.itsStartPosition.itsRow, aMove.itsStartPosition.itsCol, aSize));
+    const uint64_t END = static_cast<uint64_t>(cellIndex(aMove.itsEndPosition.itsRow, aMove.itsEndPosition.itsCol, aSize));
+    const uint64_t DATA = static_cast<uint16_t>(static_cast<int16_t>(scoreToTable(aScore, aPly)))
+                        | static_cast<uint64_t>(static_cast<uint8_t>(aDepth)) << 16
+                        | static_cast<uint64_t>(aBound) << 24
+                        | START << 32
+                        | END << 40;
+    TableEntry& entry = aSearch.itsTable[aKey & aSearch.itsTableMask];
+    entry.itsCheck.store(aKey ^ DATA, memory_order_relaxed);
+    entry.itsData.store(DATA, memory_order_relaxed);
+}
+
+/**
+ * @brief Generates and scores the moves of a ply (table move, killers, history).
+ *
+ * @return The number of moves.
+ */
+static int prepareMoves(const Game& aGame, AiSearch& aSearch, int aPly, const Move& aTableMove) {
+    PlyMoves& ply = aSearch.itsPlies[aPly];
+    const int COUNT = generateMoves(aGame, ply.itsList);
+    const PlayerRole ROLE = aGame.itsCurrentPlayer->itsRole;
+    for (int i = 0 ; i < COUNT ; i++) {
+        const Move& move = ply.itsList.itsMoves[i];
+        if (isSameMove(move, aTableMove)) {
+            ply.itsScores[i] = 1 << 30;
+        }
+        else if (isSameMove(move, aSearch.itsKillers[aPly][0])) {
+            ply.itsScores[i] = 1 << 29;
+        }
+        else if (isSameMove(move, aSearch.itsKillers[aPly][1])) {
+            ply.itsScores[i] = 1 << 28;
+        }
+        else {
+            ply.itsScores[i] = aSearch.itsHistory[historySlot(ROLE, move, aGame.itsBoard.itsSize)];
+        }
+    }
+    return COUNT;
+}
+
+/**
+ * @brief Moves the best remaining move to position `anIndex` (selection sort, one step).
+ */
+static void pickMove(PlyMoves& aPly, int anIndex, int aCount) {
+    int best = anIndex;
+    for (int i = anIndex + 1 ; i < aCount ; i++) {
+        if (aPly.itsScores[i] > aPly.itsScores[best]) {
+            best = i;
+        }
+    }
+    if (best != anIndex) {
+        swap(aPly.itsList.itsMoves[best], aPly.itsList.itsMoves[anIndex]);
+        swap(aPly.itsScores[best], aPly.itsScores[anIndex]);
+    }
+}
+
+/**
+ * @brief Records a quiet move that caused a cutoff (killers and history).
+ */
+static void rewardMove(AiSearch& aSearch, const Game& aGame, const Move& aMove, int aDepth, int aPly) {
+    if (!isSameMove(aMove, aSearch.itsKillers[aPly][0])) {
+        aSearch.itsKillers[aPly][1] = aSearch.itsKillers[aPly][0];
+        aSearch.itsKillers[aPly][0] = aMove;
+    }
+    int& history = aSearch.itsHistory[historySlot(aGame.itsCurrentPlayer->itsRole, aMove, aGame.itsBoard.itsSize)];
+    history += aDepth * aDepth;
+    //keep the history below the killer scores
+    if (history > (1 << 27)) {
+        for (int slot = 0 ; slot < HISTORY_SIZE ; slot++) {
+            aSearch.itsHistory[slot] /= 2;
+        }
+    }
+}
+
+/**
+ * @brief Scores the moves of a node one ply from the horizon with one call to the backend.
+ *
+ * Gives the scores of a search of each child at depth 0, without the cutoffs: the finished
+ * games and the repeated positions are scored directly, the other children are put in the
+ * batch of the thread and evaluated together.
+ *
+ * @param aGame The game (modified, restored on return).
+ * @param aSearch The search state (`itsEvaluator` and `itsBatch` set).
+ * @param aCount Number of moves of `itsPlies[aPly]`.
+ * @param aPly Distance to the root.
+ * @param aBestMove Set to the best move.
+ * @param aBestScore Set to its score, from the point of view of the player to move.
+ * @return `false` (and nothing is set) if the backend failed.
+ */
+static bool searchFrontier(Game& aGame, AiSearch& aSearch, int aCount, int aPly, Move& aBestMove, int& aBestScore) {
+    PlyMoves& ply = aSearch.itsPlies[aPly];
+    EvalBatch& batch = *aSearch.itsBatch;
+    clearEvalBatch(batch);
+    //slot of each move in the batch, -1 when its score is already known
+    int slots[MAX_MOVES];
+    const int CHILD_WIN = AI_WIN_SCORE - (aPly + 1);
+    for (int i = 0 ; i < aCount ; i++) {
+        MoveUndo undo = makeMove(aGame, ply.itsList.itsMoves[i]);
+        aSearch.itsNodes++;
+        PROFILE_COUNT(PROFILE_SEARCH_NODE);
+        isTimeOver(aSearch);
+        slots[i] = -1;
+        PlayerRole winner;
+        if (getWinner(aGame, winner)) {
+            ply.itsScores[i] = (winner == aGame.itsCurrentPlayer->itsRole) ? -CHILD_WIN : CHILD_WIN;
+        }
+        else {
+            ply.itsScores[i] = 0;
+            bool isRepeated = false;
+            for (int previous = aPly - 1 ; previous >= 0 && !isRepeated ; previous -= 2) {
+                isRepeated = aSearch.itsPathKeys[previous] == aGame.itsBoard.itsHash;
+            }
+            if (!isRepeated) {
+                slots[i] = addEvalPosition(batch, aGame);
+                if (slots[i] == -1) {
+                    ply.itsScores[i] = -evaluatePosition(aGame);
+                }
+            }
+        }
+        unmakeMove(aGame, undo);
+    }
+    if (batch.itsCount > 0 && !evaluateEvalBatch(batch, *aSearch.itsEvaluator)) {
+        return false;
+    }
+    int best = 0;
+    for (int i = 0 ; i < aCount ; i++) {
+        if (slots[i] != -1) {
+            ply.itsScores[i] = -batch.itsScores[slots[i]];
+        }
+        if (ply.itsScores[i] > ply.itsScores[best]) {
+            best = i;
+        }
+    }
+    aBestMove = ply.itsList.itsMoves[best];
+    aBestScore = ply.itsScores[best];
+    return true;
+}
+
+/**
+ * @brief Principal variation search of a position (negamax form).
+ *
+ * @param aGame The game (modified during the search, restored on return).
+ * @param aSearch The search state.
+ * @param aDepth Remaining depth.
+ * @param anAlpha Lower bound of the window.
+ * @param aBeta Upper bound of the window.
+ * @param aPly Distance to the root.
+ * @return The score from the point of view of the player to move.
+ */
+static int searchPosition(Game& aGame, AiSearch& aSearch, int aDepth, int anAlpha, int aBeta, int aPly) {
+    aSearch.itsNodes++;
+    PROFILE_COUNT(PROFILE_SEARCH_NODE);
+    if (isTimeOver(aSearch)) {
+        return 0;
+    }
+    PlayerRole winner;
+    if (getWinner(aGame, winner)) {
+        return (winner == aGame.itsCurrentPlayer->itsRole) ? AI_WIN_SCORE - aPly : -(AI_WIN_SCORE - aPly);
+    }
+    const uint64_t KEY = aGame.itsBoard.itsHash;
+    //a repeated position of the current line is a draw
+    for (int ply = aPly - 2 ; ply >= 0 ; ply -= 2) {
+        if (aSearch.itsPathKeys[ply] == KEY) {
+            return 0;
+        }
+    }
+    aSearch.itsPathKeys[aPly] = KEY;
+    if (aDepth <= 0 || aPly >= AI_MAX_PLY - 1) {
+        return evaluatePosition(aGame);
+    }
+
+    const int SIZE = aGame.itsBoard.itsSize;
+    Move tableMove = {{-1,-1},{-1,-1}};
+    TableData entry;
+    if (probeEntry(aSearch, KEY, entry)) {
+        tableMove = {{entry.itsStart / SIZE, entry.itsStart % SIZE}, {entry.itsEnd / SIZE, entry.itsEnd % SIZE}};
+        if (entry.itsDepth >= aDepth) {
+            const int SCORE = scoreFromTable(entry.itsScore, aPly);
+            if (entry.itsBound == BOUND_EXACT
+                || (entry.itsBound == BOUND_LOWER && SCORE >= aBeta)
+                || (entry.itsBound == BOUND_UPPER && SCORE <= anAlpha)) {
+                return SCORE;
+            }
+        }
+    }
+
+    const int COUNT = prepareMoves(aGame, aSearch, aPly, tableMove);
+    //a player who can't move has lost
+    if (COUNT == 0) {
+        return -(AI_WIN_SCORE - aPly);
+    }
+    //one ply from the horizon, every child is evaluated in one batch (the score is exact)
+    Move frontierMove;
+    int frontierScore;
+    if (aDepth == 1 && aSearch.itsEvaluator != nullptr && searchFrontier(aGame, aSearch, COUNT, aPly, frontierMove, frontierScore)) {
+        if (aSearch.itsStopped) {
+            return 0;
+        }
+        storeEntry(aSearch, KEY, aDepth, frontierScore, BOUND_EXACT, frontierMove, aPly, SIZE);
+        return frontierScore;
+    }
+    PlyMoves& ply = aSearch.itsPlies[aPly];
+    const int ORIGINAL_ALPHA = anAlpha;
+    int bestScore = -INFINITE_SCORE;
+    Move bestMove = ply.itsList.itsMoves[0];
+    for (int i = 0 ; i < COUNT ; i++) {
+        pickMove(ply, i, COUNT);
+        const Move MOVE = ply.itsList.itsMoves[i];
+        MoveUndo undo = makeMove(aGame, MOVE);
+        int score;
+        if (i == 0) {
+            score = -searchPosition(aGame, aSearch, aDepth - 1, -aBeta, -anAlpha, aPly + 1);
+        }
+        else {
+            //null window first, full window only if the move looks better
+            score = -searchPosition(aGame, aSearch, aDepth - 1, -anAlpha - 1, -anAlpha, aPly + 1);
+            if (score > anAlpha && score < aBeta) {
+                score = -searchPosition(aGame, aSearch, aDepth - 1, -aBeta, -anAlpha, aPly + 1);
+            }
+        }
+        unmakeMove(aGame, undo);
+        if (aSearch.itsStopped) {
+            return 0;
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = MOVE;
+            if (score > anAlpha) {
+                anAlpha = score;
+            }
+        }
+        if (anAlpha >= aBeta) {
+            if (undo.itsCapturedMask == 0) {
+                rewardMove(aSearch, aGame, MOVE, aDepth, aPly);
+            }
+            break;
+        }
+    }
+    const BoundType BOUND = (bestScore <= ORIGINAL_ALPHA) ? BOUND_UPPER : (bestScore >= aBeta) ? BOUND_LOWER : BOUND_EXACT;
+    storeEntry(aSearch, KEY, aDepth, bestScore, BOUND, bestMove, aPly, SIZE);
+    return bestScore;
+}
+
+/**
+ * @brief Searches the root position at a given depth.
+ *
+ * @param aGame The game.
+ * @param aSearch The search state.
+ * @param aDepth The depth of the iteration.
+ * @param aBestMove Best move of the previous iteration (searched first), updated with the new one.
+ * @param aScore Set to the score of the best move.
+ * @return `true` if at least one move was fully searched before the time ran out.
+ */
+static bool searchRoot(Game& aGame, AiSearch& aSearch, int aDepth, Move& aBestMove, int& aScore) {
+    const int COUNT = prepareMoves(aGame, aSearch, 0, aBestMove);
+    PlyMoves& ply = aSearch.itsPlies[0];
+    aSearch.itsPathKeys[0] = aGame.itsBoard.itsHash;
+    if (aDepth == 1 && aSearch.itsEvaluator != nullptr && searchFrontier(aGame, aSearch, COUNT, 0, aBestMove, aScore)) {
+        storeEntry(aSearch, aGame.itsBoard.itsHash, aDepth, aScore, BOUND_EXACT, aBestMove, 0, aGame.itsBoard.itsSize);
+        return true;
+    }
+    int alpha = -INFINITE_SCORE;
+    bool hasResult = false;
+    Move bestMove = aBestMove;
+    for (int i = 0 ; i < COUNT ; i++) {
+        pickMove(ply, i, COUNT);
+        const Move MOVE = ply.itsList.itsMoves[i];
+        MoveUndo undo = makeMove(aGame, MOVE);
+        int score;
+        if (i == 0) {
+            score = -searchPosition(aGame, aSearch, aDepth - 1, -INFINITE_SCORE, -alpha, 1);
+        }
+        else {
+            score = -searchPosition(aGame, aSearch, aDepth - 1, -alpha - 1, -alpha, 1);
+            if (score > alpha) {
+                score = -searchPosition(aGame, aSearch, aDepth - 1, -INFINITE_SCORE, -alpha, 1);
+            }
+        }
+        unmakeMove(aGame, undo);
+        if (aSearch.itsStopped) {
+            break;
+        }
+        if (score > alpha) {
+            alpha = score;
+            bestMove = MOVE;
+            hasResult = true;
+        }
+    }
+    if (hasResult) {
+        aBestMove = bestMove;
+        aScore = alpha;
+        storeEntry(aSearch, aGame.itsBoard.itsHash, aDepth, alpha, BOUND_EXACT, bestMove, 0, aGame.itsBoard.itsSize);
+    }
+    return hasResult;
+}
+
+/**
+ * @brief Prepares the state of one thread for a new search.
+ *
+ * @param aSearch The state of one thread.
+ * @param aDeadline Time when the search must stop.
+ */
+static void startThreadSearch(AiSearch& aSearch, steady_clock::time_point aDeadline) {
+    aSearch.itsDeadline = aDeadline;
+    aSearch.itsStopped = false;
+    aSearch.itsNodes = 0;
+    for (Move* killers : aSearch.itsKillers) {
+        killers[0] = {{-1,-1},{-1,-1}};
+        killers[1] = {{-1,-1},{-1,-1}};
+    }
+}
+
+/**
+ * @brief Body of a helper thread (lazy SMP).
+ *
+ * Searches its own copy of the game with iterative deepening until the main thread stops it.
+ * Its results are only used through the shared transposition table.
+ *
+ * @param aHelper The state of the helper.
+ * @param aSnapshot The position to search (copied, the thread owns it).
+ * @param aFirstDepth First depth of the iterations (shifted to spread the threads).
+ * @param aMaxDepth Maximum depth of the search.
+ */
+static void runHelper(AiSearch& aHelper, GameSnapshot aSnapshot, int aFirstDepth, int aMaxDepth) {
+    //the board of the helper is pooled, it takes the position of any size without allocation
+    Game& game = aHelper.itsGame;
+    if (!restoreSnapshot(aSnapshot, game)) {
+        return;
+    }
+    Move bestMove = {{-1,-1},{-1,-1}};
+    for (int depth = aFirstDepth ; depth <= aMaxDepth && !aHelper.itsStopped ; depth++) {
+        int score = 0;
+        searchRoot(game, aHelper, depth, bestMove, score);
+    }
+}
+
+/**
+ * @brief Searches the best move of the current player.
+ *
+ * Iterative deepening until `aMaxDepth` or until the time budget is exhausted.
+ * The game is modified during the search and restored before returning.
+ * The helper threads search their own copy of the game and are joined before returning.
+ * A position found in the opening book or won/lost in the endgame tables is answered
+ * without searching (depth 0, no node).
+ *
+ * @param aGame The game to search (the board must have its bitboards).
+ * @param aSearch The search state (must be created).
+ * @param aTimeBudgetMs Maximum time of the search (in milliseconds).
+ * @param aMaxDepth Maximum depth of the search (1 to `AI_MAX_PLY - 1`).
+ * @return The best move found and the search statistics.
+ */
+AiResult searchBestMove(Game& aGame, AiSearch& aSearch, int aTimeBudgetMs, int aMaxDepth) {
+    PROFILE_SCOPE(PROFILE_SEARCH);
+    AiResult result;
+    const steady_clock::time_point START = steady_clock::now();
+    if (aSearch.itsTable == nullptr || aGame.itsBoard.itsCells == nullptr) {
+        return result;
+    }
+    //a finished game or a player without moves has nothing to play
+    PlayerRole winner;
+    if (getWinner(aGame, winner) || generateMoves(aGame, aSearch.itsPlies[0].itsList) == 0) {
+        return result;
+    }
+    //a known position is played without searching
+    if ((aSearch.itsBook != nullptr && probeOpeningBook(*aSearch.itsBook, aGame, result.itsBestMove, result.itsScore))
+        || (aSearch.itsEndgames != nullptr && probeEndgameTables(*aSearch.itsEndgames, aGame, result.itsBestMove, result.itsScore))) {
+        result.itsElapsedMs = duration_cast<milliseconds>(steady_clock::now() - START).count();
+        return result;
+    }
+    AnalysisEntry analysis;
+    if (aSearch.itsAnalysis != nullptr && probeAnalysisCache(*aSearch.itsAnalysis, aGame, analysis)) {
+        result.itsBestMove = analysis.itsMove;
+        result.itsScore = analysis.itsScore;
+        result.itsDepth = analysis.itsDepth;
+        result.itsNodes = analysis.itsNodes;
+        result.itsElapsedMs = duration_cast<milliseconds>(steady_clock::now() - START).count();
+        return result;
+    }
+    result.itsBestMove = aSearch.itsPlies[0].itsList.itsMoves[0];
+    if (aMaxDepth < 1 || aMaxDepth >= AI_MAX_PLY) {
+        aMaxDepth = AI_MAX_PLY - 1;
+    }
+    const steady_clock::time_point DEADLINE = START + milliseconds(aTimeBudgetMs);
+    startThreadSearch(aSearch, DEADLINE);
+    //start the helpers on their own copy of the position, half of them one ply deeper
+    aSearch.itsStopSignal.store(false, memory_order_relaxed);
+    thread helpers[AI_MAX_THREADS];
+    if (aSearch.itsHelperCount > 0) {
+        const GameSnapshot SNAPSHOT = takeSnapshot(aGame);
+        for (int helper = 0 ; helper < aSearch.itsHelperCount ; helper++) {
+            startThreadSearch(aSearch.itsHelpers[helper], DEADLINE);
+            helpers[helper] = thread(runHelper, ref(aSearch.itsHelpers[helper]), SNAPSHOT, 1 + (helper % 2 == 0), aMaxDepth);
+        }
+    }
+    for (int depth = 1 ; depth <= aMaxDepth ; depth++) {
+        Move bestMove = result.itsBestMove;
+        int score = 0;
+        if (searchRoot(aGame, aSearch, depth, bestMove, score)) {
+            result.itsBestMove = bestMove;
+            result.itsScore = score;
+            if (!aSearch.itsStopped) {
+                result.itsDepth = depth;
+            }
+        }
+        const long long ELAPSED = duration_cast<milliseconds>(steady_clock::now() - START).count();
+        //stop on a forced result, or when the next iteration would not end in time
+        if (aSearch.itsStopped || abs(result.itsScore) > AI_WIN_SCORE - AI_MAX_PLY || ELAPSED * 2 > aTimeBudgetMs) {
+            break;
+        }
+    }
+    aSearch.itsStopSignal.store(true, memory_order_relaxed);
+    result.itsNodes = aSearch.itsNodes;
+    for (int helper = 0 ; helper < aSearch.itsHelperCount ; helper++) {
+        helpers[helper].join();
+        result.itsNodes += aSearch.itsHelpers[helper].itsNodes;
+    }
+    //a search stopped before its first iteration has no result to keep
+    if (aSearch.itsAnalysis != nullptr && result.itsDepth > 0) {
+        analysis.itsMove = result.itsBestMove;
+        analysis.itsScore = result.itsScore;
+        analysis.itsDepth = result.itsDepth;
+        analysis.itsNodes = result.itsNodes;
+        storeAnalysisCache(*aSearch.itsAnalysis, aGame, analysis);
+    }
+    result.itsElapsedMs = duration_cast<milliseconds>(steady_clock::now() - START).count();
+    return result;
+}
+
+/**
+ * @brief Stores the result of a position in the transposition table, as an exact score.
+ *
+ * Used to fill the table before searching (see `preloadAnalysisCache()`), a slot holding
+ * the same position searched deeper is kept.
+ *
+ * @param aSearch The search state (must be created).
+ * @param aKey The Zobrist key of the position.
+ * @param aDepth The depth of the result.
+ * @param aScore The score of the best move for the player to move.
+ * @param aMove The best move.
+ * @param aSize The size of the board.
+ */
+void storeSearchResult(AiSearch& aSearch, uint64_t aKey, int aDepth, int aScore, const Move& aMove, int aSize) {
+    if (aSearch.itsTable == nullptr) {
+        return;
+    }
+    storeEntry(aSearch, aKey, aDepth, aScore, BOUND_EXACT, aMove, 0, aSize);
+}
@@ -0,0 +1,339 @@
+/**
+ * @file analysis.cpp
+ *
+ * @brief Implementation of the persistent analysis cache.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <atomic>
+#include <cstring>
+#include <new>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/ai.h"
+#include "../Headers/analysis.h"
+
+using namespace std;
+
+/**
+ * @brief Bit of `AnalysisSlot::itsData` set in a used slot (an empty slot is 0).
+ */
+static const uint64_t ANALYSIS_USED = uint64_t(1) << 48;
+
+// ============================================================================
+// SECTION 1: FILE
+// ============================================================================
+
+/**
+ * @brief Gets the size of a cache file.
+ *
+ * @param aSlotBits The file holds 2^aSlotBits slots.
+ * @return The size of the header and of the slots.
+ */
+static uint64_t getCacheLength(int aSlotBits) {
+    return sizeof(AnalysisHeader) + (uint64_t(1) << aSlotBits) * sizeof(AnalysisSlot);
+}
+
+/**
+ * @brief Maps a whole file in memory, read-write, creating it with a length if it is empty.
+ *
+ * A new file is filled with zeros (empty slots and an invalid header).
+ *
+ * @param aPath The path of the file.
+ * @param aNewLength The size given to a new (or empty) file.
+ * @param aData Set to the first byte of the mapping.
+ * @param aLength Set to the size of the file.
+ * @param aMapping Set to the handle of the mapping (Windows only, nullptr elsewhere).
+ * @param anIsNew Set to `true` if the file was created.
+ * @return `true` if the file is mapped.
+ */
+static bool mapReadWriteFile(const string& aPath, uint64_t aNewLength, unsigned char*& aData, uint64_t& aLength,
+                             void*& aMapping, bool& anIsNew) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(aPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size)) {
+        anIsNew = size.QuadPart == 0;
+        if (anIsNew) {
+            size.QuadPart = static_cast<LONGLONG>(aNewLength);
+        }
+        //the mapping of a new file extends it to its size
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size.QuadPart >> 32),
+                                     static_cast<DWORD>(size.QuadPart & 0xFFFFFFFF), nullptr);
+    }
+    //the mapping keeps the file open
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        return false;
+    }
+    aMapping = mapping;
+    aLength = static_cast<uint64_t>(size.QuadPart);
+#else
+    const int FILE = open(aPath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (FILE == -1) {
+        return false;
+    }
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fstat(FILE, &status) == 0) {
+        anIsNew = status.st_size == 0;
+        if (anIsNew && ftruncate(FILE, static_cast<off_t>(aNewLength)) == 0) {
+            status.st_size = static_cast<off_t>(aNewLength);
+        }
+        if (status.st_size > 0) {
+            data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, FILE, 0);
+        }
+    }
+    //the mapping keeps the file open
+    close(FILE);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    aMapping = nullptr;
+    aLength = static_cast<uint64_t>(status.st_size);
+#endif
+    aData = static_cast<unsigned char*>(data);
+    return true;
+}
+
+/**
+ * @brief Unmaps a file mapped by `mapReadWriteFile()`, the changes are written by the system.
+ *
+ * @param aData The first byte of the mapping (nothing is done if nullptr).
+ * @param aLength The size of the mapping.
+ * @param aMapping The handle of the mapping (Windows only).
+ */
+static void unmapReadWriteFile(unsigned char* aData, uint64_t aLength, void* aMapping) {
+    if (aData == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    (void)aLength;
+    UnmapViewOfFile(aData);
+    CloseHandle(aMapping);
+#else
+    (void)aMapping;
+    munmap(aData, static_cast<size_t>(aLength));
+#endif
+}
+
+/**
+ * @brief Maps an analysis cache in memory, read-write, creating the file if it doesn't exist.
+ *
+ * @param aCache The cache to open (must be closed).
+ * @param aPath The path of the file.
+ * @param aSlotBits A new file holds 2^aSlotBits slots (4-28, an existing file keeps its size).
+ * @return `true` if the cache is mapped, `false` if the file can't be created or is not a valid cache.
+ */
+bool openAnalysisCache(AnalysisCache& aCache, const string& aPath, int aSlotBits) {
+    if (aCache.itsData != nullptr || aSlotBits < 4 || aSlotBits > 28) {
+        return false;
+    }
+    bool isNew = false;
+    if (!mapReadWriteFile(aPath, getCacheLength(aSlotBits), aCache.itsData, aCache.itsLength, aCache.itsMapping, isNew)) {
+        return false;
+    }
+    if (isNew && aCache.itsLength == getCacheLength(aSlotBits)) {
+        //the slots are already zeros (empty)
+        AnalysisHeader* header = new (aCache.itsData) AnalysisHeader();
+        header->itsSlotBits = static_cast<uint32_t>(aSlotBits);
+    }
+    const AnalysisHeader* HEADER = reinterpret_cast<const AnalysisHeader*>(aCache.itsData);
+    //a file of another format is never overwritten
+    if (aCache.itsLength < sizeof(AnalysisHeader) || memcmp(HEADER->itsMagic, ANALYSIS_MAGIC, sizeof(ANALYSIS_MAGIC)) != 0
+        || HEADER->itsVersion != ANALYSIS_VERSION || HEADER->itsSlotBits < 4 || HEADER->itsSlotBits > 28
+        || aCache.itsLength != getCacheLength(static_cast<int>(HEADER->itsSlotBits))) {
+        closeAnalysisCache(aCache);
+        return false;
+    }
+    aCache.itsHeader = reinterpret_cast<AnalysisHeader*>(aCache.itsData);
+    aCache.itsSlots = reinterpret_cast<AnalysisSlot*>(aCache.itsData + sizeof(AnalysisHeader));
+    aCache.itsBucketMask = ((uint64_t(1) << HEADER->itsSlotBits) / ANALYSIS_WAYS) - 1;
+    return true;
+}
+
+/**
+ * @brief Unmaps an analysis cache (the results are kept in the file). Safe to call on a closed cache.
+ *
+ * @param aCache The cache to close.
+ */
+void closeAnalysisCache(AnalysisCache& aCache) {
+    unmapReadWriteFile(aCache.itsData, aCache.itsLength, aCache.itsMapping);
+    aCache = AnalysisCache();
+}
+
+// ============================================================================
+// SECTION 2: ENTRIES
+// ============================================================================
+
+/**
+ * @brief Gets the slots of the bucket of a key.
+ */
+static AnalysisSlot* getBucket(const AnalysisCache& aCache, uint64_t aKey) {
+    return aCache.itsSlots + (aKey & aCache.itsBucketMask) * ANALYSIS_WAYS;
+}
+
+/**
+ * @brief Marks a slot as the most recently used of its bucket.
+ */
+static void touchSlot(AnalysisCache& aCache, AnalysisSlot& aSlot) {
+    aSlot.itsLastUse.store(aCache.itsHeader->itsClock.fetch_add(1, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Unpacks the data of a slot.
+ *
+ * @param aData The packed data (`AnalysisSlot::itsData`).
+ * @param aNodes The node count of the slot.
+ * @param anEntry Filled with the result.
+ * @param aSize Set to the size of the board.
+ * @return `false` if the size or the cells are out of range (the slot is torn).
+ */
+static bool unpackSlot(uint64_t aData, uint64_t aNodes, AnalysisEntry& anEntry, int& aSize) {
+    aSize = static_cast<int>((aData >> 24) & 0xFF);
+    const int START = static_cast<int>((aData >> 32) & 0xFF);
+    const int END = static_cast<int>((aData >> 40) & 0xFF);
+    if ((aSize != LITTLE && aSize != BIG) || START >= aSize * aSize || END >= aSize * aSize) {
+        return false;
+    }
+    anEntry.itsMove = {{START / aSize, START % aSize}, {END / aSize, END % aSize}};
+    anEntry.itsScore = static_cast<int16_t>(aData & 0xFFFF);
+    anEntry.itsDepth = static_cast<int>((aData >> 16) & 0xFF);
+    anEntry.itsNodes = static_cast<long long>(aNodes);
+    return true;
+}
+
+/**
+ * @brief Looks the position of a game up in an analysis cache.
+ *
+ * @param aCache The cache (must be open).
+ * @param aGame The game (the board must have its bitboards and its key).
+ * @param anEntry Set to the result of the position.
+ * @return `true` if the position is in the cache and its move is legal.
+ */
+bool probeAnalysisCache(AnalysisCache& aCache, const Game& aGame, AnalysisEntry& anEntry) {
+    const uint64_t KEY = aGame.itsBoard.itsHash;
+    AnalysisSlot* bucket = getBucket(aCache, KEY);
+    for (int way = 0 ; way < ANALYSIS_WAYS ; way++) {
+        AnalysisSlot& slot = bucket[way];
+        const uint64_t DATA = slot.itsData.load(memory_order_relaxed);
+        const uint64_t NODES = slot.itsNodes.load(memory_order_relaxed);
+        //a torn slot (two writers) gives a wrong check
+        if (DATA == 0 || (slot.itsCheck.load(memory_order_relaxed) ^ DATA ^ NODES) != KEY) {
+            continue;
+        }
+        AnalysisEntry entry;
+        int size = 0;
+        //a key collision can't play an illegal move
+        if (unpackSlot(DATA, NODES, entry, size) && size == aGame.itsBoard.itsSize
+            && checkMovement(aGame, entry.itsMove) == VALID_MOVE) {
+            touchSlot(aCache, slot);
+            anEntry = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Stores the result of a search in an analysis cache.
+ *
+ * A result of the same position searched deeper is kept. A new position takes an empty slot of
+ * its bucket, or the least recently used one.
+ *
+ * @param aCache The cache (must be open).
+ * @param aGame The searched game (the board must have its key).
+ * @param anEntry The result of the search.
+ */
+void storeAnalysisCache(AnalysisCache& aCache, const Game& aGame, const AnalysisEntry& anEntry) {
+    const uint64_t KEY = aGame.itsBoard.itsHash;
+    const int SIZE = aGame.itsBoard.itsSize;
+    AnalysisSlot* bucket = getBucket(aCache, KEY);
+    int victim = -1;
+    int empty = -1;
+    int oldest = 0;
+    for (int way = 0 ; way < ANALYSIS_WAYS ; way++) {
+        AnalysisSlot& slot = bucket[way];
+        const uint64_t DATA = slot.itsData.load(memory_order_relaxed);
+        const uint64_t NODES = slot.itsNodes.load(memory_order_relaxed);
+        if (DATA != 0 && (slot.itsCheck.load(memory_order_relaxed) ^ DATA ^ NODES) == KEY) {
+            if (static_cast<int>((DATA >> 16) & 0xFF) > anEntry.itsDepth) {
+                touchSlot(aCache, slot);
+                return;
+            }
+            victim = way;
+            break;
+        }
+        if (DATA == 0 && empty == -1) {
+            empty = way;
+        }
+        if (slot.itsLastUse.load(memory_order_relaxed) < bucket[oldest].itsLastUse.load(memory_order_relaxed)) {
+            oldest = way;
+        }
+    }
+    if (victim == -1) {
+        victim = (empty != -1) ? empty : oldest;
+    }
+    const uint64_t START = static_cast<uint64_t>(cellIndex(anEntry.itsMove.itsStartPosition.itsRow, anEntry.itsMove.itsStartPosition.itsCol, SIZE));
+    const uint64_t END = static_cast<uint64_t>(cellIndex(anEntry.itsMove.itsEndPosition.itsRow, anEntry.itsMove.itsEndPosition.itsCol, SIZE));
+    const uint64_t DATA = static_cast<uint16_t>(static_cast<int16_t>(anEntry.itsScore))
+                        | static_cast<uint64_t>(static_cast<uint8_t>(anEntry.itsDepth)) << 16
+                        | static_cast<uint64_t>(SIZE) << 24
+                        | START << 32
+                        | END << 40
+                        | ANALYSIS_USED;
+    const uint64_t NODES = static_cast<uint64_t>(anEntry.itsNodes);
+    AnalysisSlot& slot = bucket[victim];
+    slot.itsCheck.store(KEY ^ DATA ^ NODES, memory_order_relaxed);
+    slot.itsData.store(DATA, memory_order_relaxed);
+    slot.itsNodes.store(NODES, memory_order_relaxed);
+    touchSlot(aCache, slot);
+}
+
+/**
+ * @brief Copies the results of an analysis cache to a transposition table.
+ *
+ * Each result is stored as an exact score at its depth (see `storeSearchResult()`).
+ *
+ * @param aCache The cache (must be open).
+ * @param aSearch The search state (must be created).
+ * @return The number of results copied.
+ */
+long long preloadAnalysisCache(const AnalysisCache& aCache, AiSearch& aSearch) {
+    long long count = 0;
+    const uint64_t SLOTS = (aCache.itsBucketMask + 1) * ANALYSIS_WAYS;
+    for (uint64_t index = 0 ; index < SLOTS ; index++) {
+        const AnalysisSlot& slot = aCache.itsSlots[index];
+        const uint64_t DATA = slot.itsData.load(memory_order_relaxed);
+        const uint64_t NODES = slot.itsNodes.load(memory_order_relaxed);
+        const uint64_t KEY = slot.itsCheck.load(memory_order_relaxed) ^ DATA ^ NODES;
+        AnalysisEntry entry;
+        int size = 0;
+        //the key of a slot is only known from its check, it must belong to the bucket of the slot
+        if (DATA != 0 && (KEY & aCache.itsBucketMask) == index / ANALYSIS_WAYS && unpackSlot(DATA, NODES, entry, size)) {
+            storeSearchResult(aSearch, KEY, entry.itsDepth, entry.itsScore, entry.itsMove, size);
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file batcheval.cpp
+ *
+ * @brief Implementation of the batched evaluation of positions.
+ *
+ * The planes are written from the masks of the board: the tensor of a position is cleared,
+ * then each set bit of a mask becomes a 1 of its plane (the bit index is the plane cell).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include "../Headers/typeDef.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/evalfeatures.h"
+#include "../Headers/ai.h"
+#include "../Headers/batcheval.h"
+
+using namespace std;
+
+/**
+ * @brief Allocates a batch.
+ *
+ * @param aBatch The batch to initialize (must not be already created).
+ * @param aCapacity Maximum number of positions (1 to `MAX_MOVES`).
+ * @return `true` if the allocation succeeded.
+ */
+bool createEvalBatch(EvalBatch& aBatch, int aCapacity) {
+    if (aBatch.itsTensor != nullptr || aCapacity < 1 || aCapacity > MAX_MOVES) {
+        return false;
+    }
+    aBatch.itsTensor = new (nothrow) float[static_cast<size_t>(aCapacity) * getEvalPositionFloats(BIG)];
+    aBatch.itsScores = new (nothrow) int[aCapacity];
+    aBatch.itsRoles = new (nothrow) PlayerRole[aCapacity];
+    if (aBatch.itsTensor == nullptr || aBatch.itsScores == nullptr || aBatch.itsRoles == nullptr) {
+        deleteEvalBatch(aBatch);
+        return false;
+    }
+    aBatch.itsCapacity = aCapacity;
+    clearEvalBatch(aBatch);
+    return true;
+}
+
+/**
+ * @brief Releases a batch.
+ *
+ * @param aBatch The batch to release (pointers are set to nullptr).
+ */
+void deleteEvalBatch(EvalBatch& aBatch) {
+    delete[] aBatch.itsTensor;
+    delete[] aBatch.itsScores;
+    delete[] aBatch.itsRoles;
+    aBatch = EvalBatch();
+}
+
+/**
+ * @brief Empties a batch (the memory is kept).
+ *
+ * @param aBatch The batch.
+ */
+void clearEvalBatch(EvalBatch& aBatch) {
+    aBatch.itsCount = 0;
+}
+
+/**
+ * @brief Writes the 1 of a mask in a plane.
+ *
+ * @param aMask The cells (bit `row * size + col`).
+ * @param aPlane The plane (already cleared).
+ */
+static void writePlane(const BitBoard& aMask, float* aPlane) {
+    for (int word = 0 ; word < 3 ; word++) {
+        uint64_t bits = aMask.itsWords[word];
+        while (bits != 0) {
+            aPlane[word * 64 + lowestWordBit(bits)] = 1.0f;
+            bits &= bits - 1;
+        }
+    }
+}
+
+/**
+ * @brief Encodes a position in `getEvalPositionFloats()` floats.
+ *
+ * @param aGame The game (LITTLE or BIG board; its bitboards are used when synchronized).
+ * @param aPlanes Receives the planes of the position.
+ * @return `false` (and nothing is written) if the board can't be encoded.
+ */
+bool encodeEvalPosition(const Game& aGame, float* aPlanes) {
+    const Board& board = aGame.itsBoard;
+    if (board.itsCells == nullptr || (board.itsSize != LITTLE && board.itsSize != BIG)) {
+        return false;
+    }
+    BitBoard pieceMasks[4];
+    BitBoard cellMasks[3];
+    if (board.itsHasBitboards) {
+        copy(board.itsPieceMasks, board.itsPieceMasks + 4, pieceMasks);
+        copy(board.itsCellMasks, board.itsCellMasks + 3, cellMasks);
+    }
+    else if (!scanBoardMasks(board, pieceMasks, cellMasks)) {
+        return false;
+    }
+    const int CELLS = board.itsSize * board.itsSize;
+    memset(aPlanes, 0, sizeof(float) * getEvalPositionFloats(board.itsSize));
+    writePlane(pieceMasks[SHIELD], aPlanes + PLANE_SHIELD * CELLS);
+    writePlane(pieceMasks[SWORD], aPlanes + PLANE_SWORD * CELLS);
+    writePlane(pieceMasks[KING], aPlanes + PLANE_KING * CELLS);
+    writePlane(cellMasks[FORTRESS], aPlanes + PLANE_FORTRESS * CELLS);
+    writePlane(cellMasks[CASTLE], aPlanes + PLANE_CASTLE * CELLS);
+    if (aGame.itsCurrentPlayer->itsRole == ATTACK) {
+        fill(aPlanes + PLANE_TO_MOVE * CELLS, aPlanes + (PLANE_TO_MOVE + 1) * CELLS, 1.0f);
+    }
+    return true;
+}
+
+/**
+ * @brief Adds a position at the end of a batch.
+ *
+ * @param aBatch The batch (must be created).
+ * @param aGame The game to encode.
+ * @return The index of the position in the batch, or -1 if the batch is full, the board size
+ * differs from the one of the batch, or the board can't be encoded.
+ */
+int addEvalPosition(EvalBatch& aBatch, const Game& aGame) {
+    if (aBatch.itsCount >= aBatch.itsCapacity || (aBatch.itsCount > 0 && aGame.itsBoard.itsSize != aBatch.itsSize)) {
+        return -1;
+    }
+    //the positions are packed with the stride of the size of the batch
+    const int INDEX = aBatch.itsCount;
+    float* planes = aBatch.itsTensor + static_cast<size_t>(INDEX) * getEvalPositionFloats(aGame.itsBoard.itsSize);
+    if (!encodeEvalPosition(aGame, planes)) {
+        return -1;
+    }
+    aBatch.itsSize = aGame.itsBoard.itsSize;
+    aBatch.itsRoles[INDEX] = aGame.itsCurrentPlayer->itsRole;
+    aBatch.itsCount++;
+    return INDEX;
+}
+
+/**
+ * @brief Scores all the positions of a batch with one call to the backend.
+ *
+ * The scores of the backend are turned to the point of view of the player to move of each
+ * position and kept below the win scores of the search.
+ *
+ * @param aBatch The batch (`itsScores` receives the scores).
+ * @param aBackend The backend.
+ * @return `false` if the batch is empty, the backend has no function or it failed.
+ */
+bool evaluateEvalBatch(EvalBatch& aBatch, const EvalBackend& aBackend) {
+    if (aBatch.itsCount == 0 || aBackend.itsEvaluate == nullptr
+        || !aBackend.itsEvaluate(aBackend.itsContext, aBatch.itsTensor, aBatch.itsCount, aBatch.itsSize, aBatch.itsScores)) {
+        return false;
+    }
+    //a backend can't claim a win, only the search finds them
+    const int LIMIT = AI_WIN_SCORE - AI_MAX_PLY - 1;
+    for (int i = 0 ; i < aBatch.itsCount ; i++) {
+        const int SCORE = clamp(aBatch.itsScores[i], -LIMIT, LIMIT);
+        aBatch.itsScores[i] = (aBatch.itsRoles[i] == ATTACK) ? SCORE : -SCORE;
+    }
+    return true;
+}
+
+/**
+ * @brief Sets the weights of a linear model to the material and king distance terms of `evaluatePosition()`.
+ *
+ * @param aModel The model.
+ * @param aSize The size of the boards it evaluates.
+ */
+void initializeLinearModel(LinearEvalModel& aModel, BoardSize aSize) {
+    aModel = LinearEvalModel();
+    aModel.itsSize = aSize;
+    const int LAST = aSize - 1;
+    for (int row = 0 ; row < aSize ; row++) {
+        for (int col = 0 ; col < aSize ; col++) {
+            const int CELL = row * aSize + col;
+            aModel.itsWeights[PLANE_SWORD][CELL] = AI_SWORD_VALUE;
+            aModel.itsWeights[PLANE_SHIELD][CELL] = -AI_SHIELD_VALUE;
+            //distance to the nearest corner, the attack wants it far
+            aModel.itsWeights[PLANE_KING][CELL] = AI_KING_CORNER_DISTANCE * (min(row, LAST - row) + min(col, LAST - col));
+        }
+    }
+}
+
+/**
+ * @brief Backend function of a `LinearEvalModel` (the context).
+ *
+ * @return `false` if the size of the batch is not the size of the model.
+ */
+bool evaluateLinearModel(void* aContext, const float* aTensor, int aCount, BoardSize aSize, int* aScores) {
+    const LinearEvalModel& model = *static_cast<const LinearEvalModel*>(aContext);
+    if (aSize != model.itsSize) {
+        return false;
+    }
+    const int CELLS = aSize * aSize;
+    for (int position = 0 ; position < aCount ; position++) {
+        const float* planes = aTensor + static_cast<size_t>(position) * getEvalPositionFloats(aSize);
+        float score = model.itsBias;
+        for (int plane = 0 ; plane < EVAL_PLANE_COUNT ; plane++) {
+            const float* weights = model.itsWeights[plane];
+            for (int cell = 0 ; cell < CELLS ; cell++) {
+                score += weights[cell] * planes[plane * CELLS + cell];
+            }
+        }
+        aScores[position] = static_cast<int>(score + (score < 0 ? -0.5f : 0.5f));
+    }
+    return true;
+}
+
+/**
+ * @brief Makes a backend evaluating with a linear model.
+ *
+ * @param aModel The model (must outlive the backend).
+ * @return The backend.
+ */
+EvalBackend makeLinearBackend(LinearEvalModel& aModel) {
+    EvalBackend backend;
+    backend.itsEvaluate = evaluateLinearModel;
+    backend.itsContext = &aModel;
+    return backend;
+}
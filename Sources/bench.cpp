@@ -0,0 +1,496 @@
+/**
+ * @file bench.cpp
+ *
+ * @brief Implementation of the microbenchmarks of the functions.h API.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <thread>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/saveindex.h"
+#include "../Headers/ai.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/bench.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ============================================================================
+// SECTION 1: FIXTURES
+// ============================================================================
+
+/**
+ * @brief Number of plies played to reach the mid-game position.
+ */
+static const int MIDGAME_PLIES = 24;
+
+/**
+ * @brief Depth of the search playing the mid-game plies.
+ */
+static const int MIDGAME_DEPTH = 2;
+
+/**
+ * @brief Allocates the board of a game of a fixture.
+ */
+static bool createFixtureBoard(Game& aGame, BoardSize aSize) {
+    aGame.itsBoard.itsSize = aSize;
+    return createBoard(aGame.itsBoard);
+}
+
+/**
+ * @brief Sets up a board with the special cells of its size and no piece.
+ */
+static void clearPieces(Game& aGame) {
+    initializeBoard(aGame.itsBoard);
+    for (int row = 0 ; row < aGame.itsBoard.itsSize ; row++) {
+        for (int col = 0 ; col < aGame.itsBoard.itsSize ; col++) {
+            aGame.itsBoard.itsCells[row][col].itsPieceType = NONE;
+        }
+    }
+}
+
+/**
+ * @brief Synchronizes the bitboards and the key of a board built cell by cell.
+ */
+static void finishBoard(Game& aGame) {
+    updateBitboards(aGame.itsBoard);
+    aGame.itsBoard.itsHash = computeHash(aGame.itsBoard, aGame.itsCurrentPlayer->itsRole);
+}
+
+/**
+ * @brief Plays the mid-game plies (the AI against itself, at a fixed depth so the position never changes).
+ */
+static bool playMidgame(Game& aGame) {
+    AiSearch ai;
+    if (!createAi(ai, 16, 1)) {
+        return false;
+    }
+    for (int ply = 0 ; ply < MIDGAME_PLIES && !isGameFinished(aGame) ; ply++) {
+        const AiResult RESULT = searchBestMove(aGame, ai, 60000, MIDGAME_DEPTH);
+        if (RESULT.itsBestMove.itsStartPosition.itsRow == -1) {
+            break;
+        }
+        makeMove(aGame, RESULT.itsBestMove);
+    }
+    deleteAi(ai);
+    return true;
+}
+
+/**
+ * @brief Lists the straight moves of the pieces of the player that are not legal, and one diagonal per piece.
+ */
+static void listIllegalMoves(const Game& aGame, MoveList& aList) {
+    const int SIZE = aGame.itsBoard.itsSize;
+    aList.itsCount = 0;
+    for (int row = 0 ; row < SIZE ; row++) {
+        for (int col = 0 ; col < SIZE ; col++) {
+            const PieceType PIECE = aGame.itsBoard.itsCells[row][col].itsPieceType;
+            const bool IS_MINE = (aGame.itsCurrentPlayer->itsRole == ATTACK) ? PIECE == SWORD : (PIECE == SHIELD || PIECE == KING);
+            if (!IS_MINE) {
+                continue;
+            }
+            for (int target = 0 ; target < 2 * SIZE + 1 && aList.itsCount < MAX_MOVES ; target++) {
+                //the cells of the row, then of the column, then the diagonal
+                Move move = {{row, col}, {row, target}};
+                if (target >= SIZE && target < 2 * SIZE) {
+                    move.itsEndPosition = {target - SIZE, col};
+                } else if (target == 2 * SIZE) {
+                    move.itsEndPosition = {(row + 1) % SIZE, (col + 1) % SIZE};
+                }
+                if (checkMovement(aGame, move) != VALID_MOVE) {
+                    aList.itsMoves[aList.itsCount++] = move;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Builds the capture fixtures: a SWORD at (2, 2) and 0 to 4 SHIELD pieces with their anvils.
+ *
+ * The SWORD is put on its end cell directly (the board just after `movePiece()`): a real move
+ * comes from an empty neighbor, so the 4 captures case can't happen in a game.
+ * The SHIELD pieces not captured have no anvil, so every direction is tested.
+ */
+static void buildCaptures(BenchFixture& aFixture) {
+    static const int NEIGHBORS[4][2] = {{2, 1}, {2, 3}, {1, 2}, {3, 2}};
+    static const int ANVILS[4][2] = {{2, 0}, {2, 4}, {0, 2}, {4, 2}};
+    const int SIZE = aFixture.itsSize;
+    aFixture.itsCaptureMove = {{SIZE - 1, 2}, {2, 2}};
+    for (int captures = 0 ; captures <= BENCH_MAX_CAPTURES ; captures++) {
+        Game& game = aFixture.itsCaptures[captures];
+        clearPieces(game);
+        game.itsBoard.itsCells[2][2].itsPieceType = SWORD;
+        game.itsBoard.itsCells[SIZE - 3][SIZE - 3].itsPieceType = KING;
+        for (int dir = 0 ; dir < 4 ; dir++) {
+            game.itsBoard.itsCells[NEIGHBORS[dir][0]][NEIGHBORS[dir][1]].itsPieceType = SHIELD;
+            if (dir < captures) {
+                game.itsBoard.itsCells[ANVILS[dir][0]][ANVILS[dir][1]].itsPieceType = SWORD;
+            }
+        }
+        finishBoard(game);
+    }
+}
+
+/**
+ * @brief Builds the encircled fixture: a KING at (2, 7), its 4 SHIELD pieces and a ring of swords.
+ */
+static void buildEncircled(Game& aGame) {
+    static const int SHIELDS[4][2] = {{1, 7}, {3, 7}, {2, 6}, {2, 8}};
+    static const int SWORDS[8][2] = {{0, 7}, {4, 7}, {2, 5}, {2, 9}, {1, 6}, {1, 8}, {3, 6}, {3, 8}};
+    clearPieces(aGame);
+    aGame.itsBoard.itsCells[2][7].itsPieceType = KING;
+    for (const int* shield : SHIELDS) {
+        aGame.itsBoard.itsCells[shield[0]][shield[1]].itsPieceType = SHIELD;
+    }
+    for (const int* sword : SWORDS) {
+        aGame.itsBoard.itsCells[sword[0]][sword[1]].itsPieceType = SWORD;
+    }
+    finishBoard(aGame);
+}
+
+/**
+ * @brief Builds the fixture of a board size and a phase.
+ *
+ * @param aFixture The fixture to fill (must be empty).
+ * @param aSize The size of the board.
+ * @param aPhase The position.
+ * @param aSaveDirectory The directory of the save round trip (created, emptied by `deleteBenchFixture()`).
+ * @return `false` if a board can't be allocated or the save can't be recorded.
+ */
+bool createBenchFixture(BenchFixture& aFixture, BoardSize aSize, BenchPhase aPhase, const string& aSaveDirectory) {
+    aFixture.itsSize = aSize;
+    aFixture.itsPhase = aPhase;
+    bool isCreated = createFixtureBoard(aFixture.itsGame, aSize) && createFixtureBoard(aFixture.itsScratch, aSize)
+                     && createFixtureBoard(aFixture.itsEncircled, aSize);
+    for (Game& game : aFixture.itsCaptures) {
+        isCreated = isCreated && createFixtureBoard(game, aSize);
+    }
+    if (!isCreated) {
+        deleteBenchFixture(aFixture);
+        return false;
+    }
+    initializeBoard(aFixture.itsGame.itsBoard);
+    initializeBoard(aFixture.itsScratch.itsBoard);
+    if (aPhase == BENCH_MIDGAME && !playMidgame(aFixture.itsGame)) {
+        deleteBenchFixture(aFixture);
+        return false;
+    }
+    generateMoves(aFixture.itsGame, aFixture.itsLegalMoves);
+    listIllegalMoves(aFixture.itsGame, aFixture.itsIllegalMoves);
+    buildCaptures(aFixture);
+    buildEncircled(aFixture.itsEncircled);
+    //the save of the round trip is recorded once, without the prompts of createSave()
+    aFixture.itsSaveName = "bench";
+    if (!loadSaveIndex(aFixture.itsSaves, aSaveDirectory) || !recordSave(aFixture.itsSaves, aFixture.itsSaveName, aSize, 0)) {
+        deleteBenchFixture(aFixture);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Releases a fixture and removes its save directory.
+ *
+ * @param aFixture The fixture.
+ */
+void deleteBenchFixture(BenchFixture& aFixture) {
+    deleteBoard(aFixture.itsGame.itsBoard);
+    deleteBoard(aFixture.itsScratch.itsBoard);
+    deleteBoard(aFixture.itsEncircled.itsBoard);
+    for (Game& game : aFixture.itsCaptures) {
+        deleteBoard(game.itsBoard);
+    }
+    if (!aFixture.itsSaveName.empty()) {
+        error_code error;
+        filesystem::remove_all(aFixture.itsSaves.itsDirectory, error);
+        aFixture.itsSaveName.clear();
+    }
+    deleteSaveIndex(aFixture.itsSaves);
+}
+
+// ============================================================================
+// SECTION 2: BENCHMARKS
+// ============================================================================
+
+/**
+ * @brief Receives the results of the measured calls, so the compiler can't remove them.
+ */
+static volatile long long benchSink = 0;
+
+/**
+ * @brief `createBoard()` then `deleteBoard()`.
+ */
+static long long benchCreateBoard(BenchFixture& aFixture, int, long long anIterations) {
+    long long created = 0;
+    for (long long i = 0 ; i < anIterations ; i++) {
+        Board board;
+        board.itsSize = aFixture.itsSize;
+        created += createBoard(board);
+        deleteBoard(board);
+    }
+    benchSink = created;
+    return anIterations;
+}
+
+/**
+ * @brief `initializeBoard()` on an allocated board.
+ */
+static long long benchInitializeBoard(BenchFixture& aFixture, int, long long anIterations) {
+    for (long long i = 0 ; i < anIterations ; i++) {
+        initializeBoard(aFixture.itsScratch.itsBoard);
+    }
+    benchSink = aFixture.itsScratch.itsBoard.itsHash;
+    return anIterations;
+}
+
+/**
+ * @brief `isValidMovement()` on the legal moves (argument 0) or the illegal moves (argument 1) of the position.
+ */
+static long long benchValidMovement(BenchFixture& aFixture, int anArgument, long long anIterations) {
+    const MoveList& moves = (anArgument == 0) ? aFixture.itsLegalMoves : aFixture.itsIllegalMoves;
+    if (moves.itsCount == 0) {
+        return 0;
+    }
+    long long valid = 0;
+    int move = 0;
+    for (long long i = 0 ; i < anIterations ; i++) {
+        valid += isValidMovement(aFixture.itsGame, moves.itsMoves[move]);
+        move = (move + 1 == moves.itsCount) ? 0 : move + 1;
+    }
+    benchSink = valid;
+    return anIterations;
+}
+
+/**
+ * @brief `capturePieces()` with 0 to 4 captures (the argument).
+ *
+ * The captured pieces are put back by a `copyBoard()` in each iteration: the 0 capture case
+ * measures this copy plus the tests of the 4 directions.
+ */
+static long long benchCapturePieces(BenchFixture& aFixture, int anArgument, long long anIterations) {
+    Game& scratch = aFixture.itsScratch;
+    scratch.itsCurrentPlayer = &scratch.itsPlayer1;
+    scratch.itsPlayer1.itsRole = ATTACK;
+    scratch.itsPlayer2.itsRole = DEFENSE;
+    long long captured = 0;
+    for (long long i = 0 ; i < anIterations ; i++) {
+        copyBoard(aFixture.itsCaptures[anArgument].itsBoard, scratch.itsBoard);
+        captured += countWordBits(static_cast<uint64_t>(capturePieces(scratch, aFixture.itsCaptureMove)));
+    }
+    benchSink = captured;
+    return anIterations;
+}
+
+/**
+ * @brief `isKingCapturedSimple()` on the position (argument 0) or on the encircled KING (argument 1).
+ */
+static long long benchKingCapturedSimple(BenchFixture& aFixture, int anArgument, long long anIterations) {
+    const Board& board = (anArgument == 0) ? aFixture.itsGame.itsBoard : aFixture.itsEncircled.itsBoard;
+    long long captured = 0;
+    for (long long i = 0 ; i < anIterations ; i++) {
+        captured += isKingCapturedSimple(board);
+    }
+    benchSink = captured;
+    return anIterations;
+}
+
+/**
+ * @brief `isKingCapturedRecursive()` on the position (argument 0) or on the encircled KING (argument 1).
+ */
+static long long benchKingCapturedRecursive(BenchFixture& aFixture, int anArgument, long long anIterations) {
+    const Board& board = (anArgument == 0) ? aFixture.itsGame.itsBoard : aFixture.itsEncircled.itsBoard;
+    long long captured = 0;
+    for (long long i = 0 ; i < anIterations ; i++) {
+        captured += isKingCapturedRecursive(board);
+    }
+    benchSink = captured;
+    return anIterations;
+}
+
+/**
+ * @brief `updateSave()` of the position then `loadSave()` of the file.
+ */
+static long long benchSaveRoundTrip(BenchFixture& aFixture, int, long long anIterations) {
+    long long loaded = 0;
+    for (long long i = 0 ; i < anIterations ; i++) {
+        updateSave(aFixture.itsGame, aFixture.itsSaveName, aFixture.itsSaves);
+        loaded += loadSave(aFixture.itsScratch, aFixture.itsSaveName, aFixture.itsSaves);
+    }
+    benchSink = loaded;
+    return anIterations;
+}
+
+/**
+ * @brief The benchmarks, in the order they are run.
+ */
+static const BenchCase BENCH_CASES[] = {
+    {"createBoard/deleteBoard", benchCreateBoard, 0, false},
+    {"initializeBoard", benchInitializeBoard, 0, false},
+    {"isValidMovement/legal", benchValidMovement, 0, true},
+    {"isValidMovement/illegal", benchValidMovement, 1, true},
+    {"capturePieces/0", benchCapturePieces, 0, false},
+    {"capturePieces/1", benchCapturePieces, 1, false},
+    {"capturePieces/2", benchCapturePieces, 2, false},
+    {"capturePieces/3", benchCapturePieces, 3, false},
+    {"capturePieces/4", benchCapturePieces, 4, false},
+    {"isKingCapturedSimple", benchKingCapturedSimple, 0, true},
+    {"isKingCapturedSimple/encircled", benchKingCapturedSimple, 1, false},
+    {"isKingCapturedRecursive", benchKingCapturedRecursive, 0, true},
+    {"isKingCapturedRecursive/encircled", benchKingCapturedRecursive, 1, false},
+    {"updateSave/loadSave", benchSaveRoundTrip, 0, true}
+};
+
+/**
+ * @brief Gets the list of the benchmarks.
+ *
+ * @param aCount Set to the number of benchmarks.
+ * @return The benchmarks (static array).
+ */
+const BenchCase* getBenchCases(int& aCount) {
+    aCount = static_cast<int>(sizeof(BENCH_CASES) / sizeof(BENCH_CASES[0]));
+    return BENCH_CASES;
+}
+
+// ============================================================================
+// SECTION 3: RUNNER AND REPORTS
+// ============================================================================
+
+/**
+ * @brief Gets the name of a benchmark on a fixture.
+ *
+ * @param aCase The benchmark.
+ * @param aFixture The fixture.
+ * @return "<case>/<LITTLE|BIG>" followed by "/opening" or "/midgame" if the case uses the phase.
+ */
+string getBenchName(const BenchCase& aCase, const BenchFixture& aFixture) {
+    string name = string(aCase.itsName) + ((aFixture.itsSize == LITTLE) ? "/LITTLE" : "/BIG");
+    if (aCase.itsUsesPhase) {
+        name += (aFixture.itsPhase == BENCH_OPENING) ? "/opening" : "/midgame";
+    }
+    return name;
+}
+
+/**
+ * @brief Measures a benchmark on a fixture.
+ *
+ * The iterations grow (at most 10 times per run) until a run lasts `aMinSeconds`.
+ *
+ * @param aCase The benchmark.
+ * @param aFixture The fixture.
+ * @param aMinSeconds Minimum time of the measured run.
+ * @return The measure.
+ */
+BenchResult runBenchmark(const BenchCase& aCase, BenchFixture& aFixture, double aMinSeconds) {
+    BenchResult result;
+    result.itsName = getBenchName(aCase, aFixture);
+    long long iterations = 1;
+    while (true) {
+        const steady_clock::time_point START = steady_clock::now();
+        const clock_t CPU_START = clock();
+        const long long ITEMS = aCase.itsFunction(aFixture, aCase.itsArgument, iterations);
+        const double SECONDS = duration<double>(steady_clock::now() - START).count();
+        const double CPU_SECONDS = static_cast<double>(clock() - CPU_START) / CLOCKS_PER_SEC;
+        if (SECONDS >= aMinSeconds || iterations >= 1000000000LL) {
+            result.itsIterations = iterations;
+            result.itsRealNs = SECONDS * 1e9 / iterations;
+            result.itsCpuNs = CPU_SECONDS * 1e9 / iterations;
+            result.itsItemsPerSecond = (SECONDS > 0) ? ITEMS / SECONDS : 0;
+            return result;
+        }
+        //aim 40% above the minimum time, from the speed of this run
+        const double GUESS = (SECONDS > 0) ? iterations * 1.4 * aMinSeconds / SECONDS : iterations * 10.0;
+        iterations = max(iterations + 1, min(iterations * 10, static_cast<long long>(GUESS)));
+    }
+}
+
+/**
+ * @brief Formats results as a Google Benchmark JSON document.
+ *
+ * @param aResults The results.
+ * @param aCount The number of results.
+ * @return The JSON document (with its last line end).
+ */
+string formatBenchmarkJson(const BenchResult* aResults, int aCount) {
+    char date[32];
+    const time_t NOW = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&NOW));
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+    string json = string("{\n  \"context\": {\n    \"date\": \"") + date + "\",\n    \"executable\": \"Hnefatafl_bench\",\n"
+                + "    \"num_cpus\": " + to_string(thread::hardware_concurrency()) + ",\n"
+                + "    \"library_build_type\": \"" + buildType + "\"\n  },\n  \"benchmarks\": [";
+    char line[512];
+    for (int i = 0 ; i < aCount ; i++) {
+        const BenchResult& result = aResults[i];
+        snprintf(line, sizeof(line),
+                 "%s\n    {\"name\": \"%s\", \"run_name\": \"%s\", \"run_type\": \"iteration\", \"iterations\": %lld, "
+                 "\"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\", \"items_per_second\": %.1f}",
+                 (i == 0) ? "" : ",", result.itsName.c_str(), result.itsName.c_str(), result.itsIterations,
+                 result.itsRealNs, result.itsCpuNs, result.itsItemsPerSecond);
+        json += line;
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+/**
+ * @brief Finds the wall time of a benchmark in a JSON document.
+ *
+ * @param aJson The document.
+ * @param aName The name of the benchmark.
+ * @return The `real_time` of the benchmark, -1 if it is not in the document.
+ */
+static double findBaselineTime(const string& aJson, const string& aName) {
+    const size_t NAME = aJson.find("\"name\": \"" + aName + "\"");
+    if (NAME == string::npos) {
+        return -1;
+    }
+    const size_t TIME = aJson.find("\"real_time\": ", NAME);
+    const size_t END = aJson.find('}', NAME);
+    if (TIME == string::npos || TIME > END) {
+        return -1;
+    }
+    return strtod(aJson.c_str() + TIME + 13, nullptr);
+}
+
+/**
+ * @brief Compares results with the ones of a JSON baseline (written by `formatBenchmarkJson()`).
+ *
+ * Prints one line per benchmark found in both (baseline time, new time, change) to `anOutput`.
+ *
+ * @param aResults The new results.
+ * @param aCount The number of results.
+ * @param aBaseline The content of the baseline file.
+ * @param aTolerance Allowed slowdown (0.1 for 10%).
+ * @param anOutput Receives the comparison.
+ * @return The number of benchmarks slower than the baseline by more than the tolerance.
+ */
+int compareBenchmarks(const BenchResult* aResults, int aCount, const string& aBaseline, double aTolerance, string& anOutput) {
+    int slower = 0;
+    char line[256];
+    for (int i = 0 ; i < aCount ; i++) {
+        const double BASELINE = findBaselineTime(aBaseline, aResults[i].itsName);
+        if (BASELINE <= 0) {
+            continue;
+        }
+        const double CHANGE = aResults[i].itsRealNs / BASELINE - 1;
+        const bool IS_SLOWER = CHANGE > aTolerance;
+        slower += IS_SLOWER;
+        snprintf(line, sizeof(line), "%-52s %12.1f %12.1f %+8.1f%%%s\n", aResults[i].itsName.c_str(), BASELINE,
+                 aResults[i].itsRealNs, CHANGE * 100, IS_SLOWER ? "  SLOWER" : "");
+        anOutput += line;
+    }
+    return slower;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file boardpool.cpp
+ *
+ * @brief Implementation of the pool of boards and of the board allocation counter.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <atomic>
+#include <cstring>
+#include <new>
+#include "../Headers/typeDef.h"
+#include "../Headers/boardpool.h"
+
+using namespace std;
+
+/**
+ * @brief Number of heap blocks allocated for cells (all threads).
+ */
+static atomic<long long> theBoardAllocations{0};
+
+/**
+ * @brief Allocates a pool of boards.
+ *
+ * @param aPool The pool to initialize (must not be already created).
+ * @param aCapacity The number of boards.
+ * @return `true` if successful, `false` if the capacity is not positive or an allocation failed.
+ */
+bool createBoardPool(BoardPool& aPool, int aCapacity) {
+    if (aPool.itsCells != nullptr || aCapacity <= 0) {
+        return false;
+    }
+    aPool.itsCells = new (nothrow) CellRow[static_cast<size_t>(aCapacity) * BIG];
+    aPool.itsFree = new (nothrow) int[aCapacity];
+    if (aPool.itsCells == nullptr || aPool.itsFree == nullptr) {
+        deleteBoardPool(aPool);
+        return false;
+    }
+    countBoardAllocation();
+    aPool.itsCapacity = aCapacity;
+    //the first board is on the top of the stack
+    for (int slot = 0 ; slot < aCapacity ; slot++) {
+        aPool.itsFree[slot] = aCapacity - 1 - slot;
+    }
+    aPool.itsFreeCount = aCapacity;
+    return true;
+}
+
+/**
+ * @brief Frees a pool of boards (the boards taken from it must not be used anymore).
+ *
+ * @param aPool The pool to release.
+ */
+void deleteBoardPool(BoardPool& aPool) {
+    delete[] aPool.itsCells;
+    delete[] aPool.itsFree;
+    aPool.itsCells = nullptr;
+    aPool.itsFree = nullptr;
+    aPool.itsFreeCount = 0;
+    aPool.itsCapacity = 0;
+}
+
+/**
+ * @brief Takes a board from a pool, in O(1) and without allocation.
+ *
+ * The cells (padding included) are cleared, the board is not initialized.
+ *
+ * @param aPool The pool.
+ * @param aBoard The board receiving the cells (must not have cells).
+ * @param aSize The size of the board.
+ * @return `true` if successful, `false` if the pool is empty or the board already has cells.
+ */
+bool acquireBoard(BoardPool& aPool, Board& aBoard, BoardSize aSize) {
+    if (aPool.itsFreeCount == 0 || aBoard.itsCells != nullptr) {
+        return false;
+    }
+    const int SLOT = aPool.itsFree[--aPool.itsFreeCount];
+    aBoard.itsCells = aPool.itsCells + static_cast<size_t>(SLOT) * BIG;
+    //the scans read the padding of the short rows, a previous BIG board may have left pieces there
+    memset(aBoard.itsCells, 0, sizeof(CellRow) * BIG);
+    aBoard.itsSize = aSize;
+    aBoard.itsIsPooled = true;
+    aBoard.itsHasBitboards = false;
+    return true;
+}
+
+/**
+ * @brief Gives a board back to its pool, in O(1).
+ *
+ * @param aPool The pool the board was taken from.
+ * @param aBoard The board (its cells are set to `nullptr`, nothing happens if it is not from the pool).
+ */
+void releaseBoard(BoardPool& aPool, Board& aBoard) {
+    if (!aBoard.itsIsPooled || aBoard.itsCells == nullptr || aBoard.itsCells < aPool.itsCells
+        || aBoard.itsCells >= aPool.itsCells + static_cast<size_t>(aPool.itsCapacity) * BIG) {
+        return;
+    }
+    const ptrdiff_t OFFSET = aBoard.itsCells - aPool.itsCells;
+    aPool.itsFree[aPool.itsFreeCount++] = static_cast<int>(OFFSET / BIG);
+    aBoard.itsCells = nullptr;
+    aBoard.itsIsPooled = false;
+    aBoard.itsHasBitboards = false;
+}
+
+/**
+ * @brief Counts one heap block allocated for cells (called by `createBoard()` and `createBoardPool()`).
+ */
+void countBoardAllocation() {
+    theBoardAllocations.fetch_add(1, memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of heap blocks allocated for cells since the start of the program (all threads).
+ *
+ * @return The number of allocations.
+ */
+long long getBoardAllocationCount() {
+    return theBoardAllocations.load(memory_order_relaxed);
+}
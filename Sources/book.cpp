@@ -0,0 +1,780 @@
+/**
+ * @file book.cpp
+ *
+ * @brief Implementation of the opening book and of the endgame tables.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/ai.h"
+#include "../Headers/gamedb.h"
+#include "../Headers/book.h"
+
+using namespace std;
+
+/**
+ * @brief Converts a move to its 4-byte record.
+ */
+static MoveRecord toMoveRecord(const Move& aMove) {
+    MoveRecord record;
+    record.itsCoords[0] = static_cast<unsigned char>(aMove.itsStartPosition.itsRow);
+    record.itsCoords[1] = static_cast<unsigned char>(aMove.itsStartPosition.itsCol);
+    record.itsCoords[2] = static_cast<unsigned char>(aMove.itsEndPosition.itsRow);
+    record.itsCoords[3] = static_cast<unsigned char>(aMove.itsEndPosition.itsCol);
+    return record;
+}
+
+/**
+ * @brief Converts a 4-byte record to a move.
+ */
+static Move toMove(const MoveRecord& aRecord) {
+    return {{aRecord.itsCoords[0], aRecord.itsCoords[1]}, {aRecord.itsCoords[2], aRecord.itsCoords[3]}};
+}
+
+// ============================================================================
+// SECTION 1: OPENING BOOK
+// ============================================================================
+
+/**
+ * @brief Gets the path of the opening book of a board size in `BOOK_DIRECTORY`.
+ *
+ * @param aSize The size of the board.
+ * @return "Book/opening-11.book" or "Book/opening-13.book".
+ */
+string getOpeningBookPath(BoardSize aSize) {
+    return BOOK_DIRECTORY + "/opening-" + to_string(static_cast<int>(aSize)) + ".book";
+}
+
+/**
+ * @struct BookBuilder
+ * @brief State of `buildOpeningBook()`: the entries found and the keys already searched.
+ */
+struct BookBuilder
+{
+    BookEntry* itsEntries = nullptr; /**< The entries (`itsCapacity` slots). */
+    int itsCount = 0;                /**< Number of entries. */
+    int itsCapacity = 0;             /**< Maximum number of entries. */
+    uint64_t* itsKeys = nullptr;     /**< Open addressing set of the searched keys (0 is empty). */
+    uint64_t itsKeyMask = 0;         /**< Number of slots of `itsKeys` minus 1. */
+    AiSearch* itsSearch = nullptr;   /**< The search state. */
+    int itsDepth = 0;                /**< Depth of each search. */
+    int itsTimeBudgetMs = 0;         /**< Time budget of each search. */
+};
+
+/**
+ * @brief Adds a key to the set of searched keys.
+ *
+ * @return `false` if the key was already in the set.
+ */
+static bool insertBookKey(BookBuilder& aBuilder, uint64_t aKey) {
+    //the key 0 can't be stored, its position is searched again if it comes back
+    if (aKey == 0) {
+        return true;
+    }
+    for (uint64_t slot = aKey & aBuilder.itsKeyMask ; ; slot = (slot + 1) & aBuilder.itsKeyMask) {
+        if (aBuilder.itsKeys[slot] == aKey) {
+            return false;
+        }
+        if (aBuilder.itsKeys[slot] == 0) {
+            aBuilder.itsKeys[slot] = aKey;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Searches the positions that are `aLevel` moves below the position of a game.
+ *
+ * @param aBuilder The state of the build.
+ * @param aGame The game (modified during the walk and restored).
+ * @param aLevel Number of moves to play before searching.
+ * @return `false` once the maximum number of positions is reached.
+ */
+static bool addBookLevel(BookBuilder& aBuilder, Game& aGame, int aLevel) {
+    if (isGameFinished(aGame)) {
+        return true;
+    }
+    if (aLevel == 0) {
+        if (aBuilder.itsCount == aBuilder.itsCapacity) {
+            return false;
+        }
+        if (!insertBookKey(aBuilder, aGame.itsBoard.itsHash)) {
+            return true;
+        }
+        const AiResult RESULT = searchBestMove(aGame, *aBuilder.itsSearch, aBuilder.itsTimeBudgetMs, aBuilder.itsDepth);
+        if (RESULT.itsBestMove.itsStartPosition.itsRow != -1) {
+            BookEntry& entry = aBuilder.itsEntries[aBuilder.itsCount++];
+            entry.itsHash = aGame.itsBoard.itsHash;
+            entry.itsMove = toMoveRecord(RESULT.itsBestMove);
+            entry.itsScore = static_cast<int16_t>(clamp(RESULT.itsScore, -32767, 32767));
+            entry.itsDepth = static_cast<unsigned char>(RESULT.itsDepth);
+            entry.itsSize = static_cast<unsigned char>(aGame.itsBoard.itsSize);
+        }
+        return true;
+    }
+    MoveList moves;
+    generateMoves(aGame, moves);
+    for (int i = 0 ; i < moves.itsCount ; i++) {
+        const MoveUndo UNDO = makeMove(aGame, moves.itsMoves[i]);
+        const bool IS_ADDED = addBookLevel(aBuilder, aGame, aLevel - 1);
+        unmakeMove(aGame, UNDO);
+        if (!IS_ADDED) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Builds an opening book by searching every position of the first plies.
+ *
+ * All the moves of both players are followed from the starting position, so the book answers
+ * whichever role the AI plays. Positions reached by several move orders are searched once.
+ *
+ * @param aBook The book receiving the entries (must be empty).
+ * @param aSize The size of the board.
+ * @param aPlies Positions up to `aPlies - 1` moves from the start are searched (1 for the start only).
+ * @param aSearch The search state (created by the caller, its book and tables are not used).
+ * @param aDepth Depth of each search.
+ * @param aTimeBudgetMs Time budget of each search (in milliseconds).
+ * @param aMaxPositions Maximum number of searched positions.
+ * @return `true` if the book is built, `false` on invalid arguments or allocation failure.
+ */
+bool buildOpeningBook(OpeningBook& aBook, BoardSize aSize, int aPlies, AiSearch& aSearch, int aDepth, int aTimeBudgetMs, int aMaxPositions) {
+    if (aBook.itsEntries != nullptr || (aSize != LITTLE && aSize != BIG) || aPlies < 1 || aMaxPositions < 1 || aSearch.itsTable == nullptr) {
+        return false;
+    }
+    BookBuilder builder;
+    uint64_t slots = 2;
+    while (slots < 2 * static_cast<uint64_t>(aMaxPositions)) {
+        slots *= 2;
+    }
+    builder.itsEntries = new (nothrow) BookEntry[aMaxPositions];
+    builder.itsKeys = new (nothrow) uint64_t[slots]();
+    Game game;
+    game.itsBoard.itsSize = aSize;
+    if (builder.itsEntries == nullptr || builder.itsKeys == nullptr || !createBoard(game.itsBoard)) {
+        delete[] builder.itsEntries;
+        delete[] builder.itsKeys;
+        return false;
+    }
+    initializeBoard(game.itsBoard);
+    builder.itsCapacity = aMaxPositions;
+    builder.itsKeyMask = slots - 1;
+    builder.itsSearch = &aSearch;
+    builder.itsDepth = aDepth;
+    builder.itsTimeBudgetMs = aTimeBudgetMs;
+    //the search must not answer from the book or the tables being replaced,
+    //nor from the analysis cache (its results may come from shallower searches)
+    const OpeningBook* BOOK = aSearch.itsBook;
+    const EndgameTables* ENDGAMES = aSearch.itsEndgames;
+    AnalysisCache* const ANALYSIS = aSearch.itsAnalysis;
+    aSearch.itsBook = nullptr;
+    aSearch.itsEndgames = nullptr;
+    aSearch.itsAnalysis = nullptr;
+    //level by level, so a maximum number of positions keeps the book balanced
+    for (int level = 0 ; level < aPlies && addBookLevel(builder, game, level) ; level++) {
+    }
+    aSearch.itsBook = BOOK;
+    aSearch.itsEndgames = ENDGAMES;
+    aSearch.itsAnalysis = ANALYSIS;
+    deleteBoard(game.itsBoard);
+    delete[] builder.itsKeys;
+    sort(builder.itsEntries, builder.itsEntries + builder.itsCount,
+         [](const BookEntry& aFirst, const BookEntry& aSecond) { return aFirst.itsHash < aSecond.itsHash; });
+    aBook.itsOwnedEntries = builder.itsEntries;
+    aBook.itsEntries = builder.itsEntries;
+    aBook.itsEntryCount = static_cast<uint64_t>(builder.itsCount);
+    return true;
+}
+
+/**
+ * @brief Writes an opening book to a file.
+ *
+ * @param aBook The book.
+ * @param aPath The path of the file (replaced).
+ * @return `true` if the whole file was written.
+ */
+bool writeOpeningBook(const OpeningBook& aBook, const string& aPath) {
+    FILE* file = fopen(aPath.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    BookHeader header;
+    header.itsEntryCount = aBook.itsEntryCount;
+    bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (aBook.itsEntryCount > 0) {
+        isWritten = isWritten && fwrite(aBook.itsEntries, sizeof(BookEntry), aBook.itsEntryCount, file) == aBook.itsEntryCount;
+    }
+    return fclose(file) == 0 && isWritten;
+}
+
+/**
+ * @brief Maps an opening book in memory.
+ *
+ * @param aBook The book to open (must be empty).
+ * @param aPath The path of the file.
+ * @return `true` if the book is mapped and valid (header, length, sorted keys).
+ */
+bool openOpeningBook(OpeningBook& aBook, const string& aPath) {
+    if (aBook.itsEntries != nullptr || !mapReadOnlyFile(aPath, aBook.itsData, aBook.itsLength, aBook.itsMapping)) {
+        return false;
+    }
+    BookHeader header;
+    bool isValid = aBook.itsLength >= sizeof(BookHeader);
+    if (isValid) {
+        memcpy(&header, aBook.itsData, sizeof(header));
+        isValid = memcmp(header.itsMagic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) == 0 && header.itsVersion == BOOK_VERSION
+                  && header.itsEntryCount == (aBook.itsLength - sizeof(BookHeader)) / sizeof(BookEntry)
+                  && (aBook.itsLength - sizeof(BookHeader)) % sizeof(BookEntry) == 0;
+    }
+    //the lookups are binary searches: the keys must be sorted
+    const BookEntry* entries = reinterpret_cast<const BookEntry*>(aBook.itsData + sizeof(BookHeader));
+    for (uint64_t i = 1 ; isValid && i < header.itsEntryCount ; i++) {
+        isValid = entries[i - 1].itsHash <= entries[i].itsHash;
+    }
+    if (!isValid) {
+        closeOpeningBook(aBook);
+        return false;
+    }
+    aBook.itsEntries = entries;
+    aBook.itsEntryCount = header.itsEntryCount;
+    return true;
+}
+
+/**
+ * @brief Unmaps or frees an opening book. Safe to call on an empty book.
+ *
+ * @param aBook The book to close.
+ */
+void closeOpeningBook(OpeningBook& aBook) {
+    unmapReadOnlyFile(aBook.itsData, aBook.itsLength, aBook.itsMapping);
+    delete[] aBook.itsOwnedEntries;
+    aBook = OpeningBook();
+}
+
+/**
+ * @brief Looks the position of a game up in an opening book.
+ *
+ * @param aBook The book.
+ * @param aGame The game (the board must have its bitboards and its key).
+ * @param aMove Set to the move of the book.
+ * @param aScore Set to the score of the move.
+ * @return `true` if the position is in the book and its move is legal.
+ */
+bool probeOpeningBook(const OpeningBook& aBook, const Game& aGame, Move& aMove, int& aScore) {
+    const uint64_t KEY = aGame.itsBoard.itsHash;
+    const BookEntry* END = aBook.itsEntries + aBook.itsEntryCount;
+    const BookEntry* entry = lower_bound(aBook.itsEntries, END, KEY,
+                                         [](const BookEntry& anEntry, uint64_t aKey) { return anEntry.itsHash < aKey; });
+    //a key collision can't play an illegal move
+    for ( ; entry != END && entry->itsHash == KEY ; entry++) {
+        const Move MOVE = toMove(entry->itsMove);
+        if (entry->itsSize == aGame.itsBoard.itsSize && checkMovement(aGame, MOVE) == VALID_MOVE) {
+            aMove = MOVE;
+            aScore = entry->itsScore;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// SECTION 2: ENDGAME TABLES
+// ============================================================================
+
+/**
+ * @brief Gets the path of the endgame tables of a board size in `BOOK_DIRECTORY`.
+ *
+ * @param aSize The size of the board.
+ * @return "Book/endgame-11.tables" or "Book/endgame-13.tables".
+ */
+string getEndgameTablesPath(BoardSize aSize) {
+    return BOOK_DIRECTORY + "/endgame-" + to_string(static_cast<int>(aSize)) + ".tables";
+}
+
+/**
+ * @struct BinomialTable
+ * @brief Binomial coefficients C(n, k) for the cells of a BIG board and up to `ENDGAME_MAX_SWORDS` pieces.
+ */
+struct BinomialTable
+{
+    uint64_t itsValues[BIG * BIG + 1][ENDGAME_MAX_SWORDS + 2] = {}; /**< C(n, k), 0 when k > n. */
+};
+
+/**
+ * @brief Computes the binomial coefficients at compile time (Pascal's triangle).
+ */
+static constexpr BinomialTable makeBinomials() {
+    BinomialTable table;
+    for (int n = 0 ; n <= BIG * BIG ; n++) {
+        table.itsValues[n][0] = 1;
+        for (int k = 1 ; k <= ENDGAME_MAX_SWORDS + 1 ; k++) {
+            table.itsValues[n][k] = (n == 0) ? 0 : table.itsValues[n - 1][k - 1] + table.itsValues[n - 1][k];
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief The binomial coefficients used to number the sets of cells.
+ */
+static constexpr BinomialTable BINOMIALS = makeBinomials();
+
+/**
+ * @brief Gets the number of positions of an endgame table.
+ *
+ * @param aSize The size of the board.
+ * @param aShields The number of shields.
+ * @param aSwords The number of swords.
+ * @return Both roles x KING cells x sets of shield cells x sets of sword cells.
+ */
+static uint64_t countEndgamePositions(int aSize, int aShields, int aSwords) {
+    const int CELLS = aSize * aSize;
+    return 2 * static_cast<uint64_t>(CELLS) * BINOMIALS.itsValues[CELLS][aShields] * BINOMIALS.itsValues[CELLS][aSwords];
+}
+
+/**
+ * @brief Gets the rank of a set of pieces (combinatorial number system).
+ *
+ * @param aMask The cells of the pieces (their bits are the cell indexes).
+ * @return The rank of the set among the sets of the same number of cells.
+ */
+static uint64_t rankPieces(BitBoard aMask) {
+    uint64_t rank = 0;
+    for (int piece = 1 ; !isEmptyMask(aMask) ; piece++) {
+        const int CELL = firstBit(aMask);
+        clearBit(aMask, CELL);
+        rank += BINOMIALS.itsValues[CELL][piece];
+    }
+    return rank;
+}
+
+/**
+ * @brief Finds the table holding the material of a board.
+ *
+ * @return The index of the table, or -1 if there is none.
+ */
+static int findEndgameTable(const EndgameTables& aTables, const Board& aBoard) {
+    if (aBoard.itsKingIndex == -1) {
+        return -1;
+    }
+    for (int table = 0 ; table < aTables.itsTableCount ; table++) {
+        const EndgameTableInfo& INFO = aTables.itsTables[table];
+        if (INFO.itsSize == aBoard.itsSize && INFO.itsShields == aBoard.itsPieceCounts[SHIELD] && INFO.itsSwords == aBoard.itsPieceCounts[SWORD]) {
+            return table;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Gets the index of a position in its table.
+ *
+ * @param anInfo The table (with the material of the board).
+ * @param aBoard The board (with its bitboards).
+ * @param aRole The role to move.
+ * @return The index of the value of the position.
+ */
+static uint64_t endgameIndex(const EndgameTableInfo& anInfo, const Board& aBoard, PlayerRole aRole) {
+    const int CELLS = anInfo.itsSize * anInfo.itsSize;
+    const uint64_t KINGS = static_cast<uint64_t>(aRole) * CELLS + static_cast<uint64_t>(aBoard.itsKingIndex);
+    const uint64_t SHIELDS = KINGS * BINOMIALS.itsValues[CELLS][anInfo.itsShields] + rankPieces(aBoard.itsPieceMasks[SHIELD]);
+    return SHIELDS * BINOMIALS.itsValues[CELLS][anInfo.itsSwords] + rankPieces(aBoard.itsPieceMasks[SWORD]);
+}
+
+/**
+ * @brief Gets the value of the position of a game in the endgame tables.
+ *
+ * @param aTables The tables.
+ * @param aGame The game (the board must have its bitboards, the game must be in progress).
+ * @return The value (0 for a draw, the distance with `ENDGAME_LOSS` for a loss), or -1 if no table holds the position.
+ */
+int getEndgameValue(const EndgameTables& aTables, const Game& aGame) {
+    const int TABLE = findEndgameTable(aTables, aGame.itsBoard);
+    if (TABLE == -1) {
+        return -1;
+    }
+    const EndgameTableInfo& INFO = aTables.itsTables[TABLE];
+    return aTables.itsValues[INFO.itsOffset + endgameIndex(INFO, aGame.itsBoard, aGame.itsCurrentPlayer->itsRole)];
+}
+
+/**
+ * @struct EndgameChoice
+ * @brief The best result among the moves of a position, from the point of view of the player to move.
+ */
+struct EndgameChoice
+{
+    int itsWin = -1;        /**< Distance of the fastest win (-1 if none). */
+    int itsWinMove = -1;    /**< Index of the move of the fastest win. */
+    int itsLoss = -1;       /**< Distance of the longest loss (-1 if none). */
+    int itsLossMove = -1;   /**< Index of the move of the longest loss. */
+    bool itsIsOpen = false; /**< true if a move leads to a draw or to a position not known yet. */
+};
+
+/**
+ * @brief Compares the results of all the moves of a position.
+ *
+ * Only the results of at most `aMaxDistance` plies are known (the results of longer distances
+ * are counted as open), which keeps the distances exact when a table is computed in place.
+ *
+ * @param aTables The tables (the one being computed included).
+ * @param aGame The game (modified and restored).
+ * @param aMoves The legal moves of the position.
+ * @param aMaxDistance Longest distance taken into account.
+ * @return The best win, the longest loss and whether a move is open.
+ */
+static EndgameChoice compareEndgameMoves(const EndgameTables& aTables, Game& aGame, const MoveList& aMoves, int aMaxDistance) {
+    EndgameChoice choice;
+    const PlayerRole MOVER = aGame.itsCurrentPlayer->itsRole;
+    for (int i = 0 ; i < aMoves.itsCount ; i++) {
+        const MoveUndo UNDO = makeMove(aGame, aMoves.itsMoves[i]);
+        const GameStatus STATUS = getGameStatus(aGame.itsBoard);
+        bool isWin = false;
+        int distance = -1;
+        if (STATUS != IN_PROGRESS) {
+            isWin = ((STATUS == KING_CAPTURED) ? ATTACK : DEFENSE) == MOVER;
+            distance = 1;
+        } else {
+            const int VALUE = getEndgameValue(aTables, aGame);
+            if (VALUE > 0) {
+                isWin = (VALUE & ENDGAME_LOSS) != 0;
+                distance = (VALUE & ~ENDGAME_LOSS) + 1;
+            }
+        }
+        unmakeMove(aGame, UNDO);
+        if (distance == -1 || distance > aMaxDistance) {
+            choice.itsIsOpen = true;
+        } else if (isWin && (choice.itsWin == -1 || distance < choice.itsWin)) {
+            choice.itsWin = distance;
+            choice.itsWinMove = i;
+        } else if (!isWin && distance > choice.itsLoss) {
+            choice.itsLoss = distance;
+            choice.itsLossMove = i;
+        }
+    }
+    return choice;
+}
+
+/**
+ * @brief Puts the pieces of a position on the board of a game, if the position is possible.
+ *
+ * @param aGame The game (its board has the cell types and no piece).
+ * @param aPlaced The cells of the previous position (cleared first), set to the cells of this one.
+ * @param aPlacedCount Number of cells of `aPlaced`, updated.
+ * @param aKing The cell of the KING.
+ * @param aShields The cells of the shields.
+ * @param aShieldCount Number of shields.
+ * @param aSwords The cells of the swords.
+ * @param aSwordCount Number of swords.
+ * @return `false` if two pieces share a cell or a piece is on a cell it can't stand on.
+ */
+static bool placeEndgamePieces(Game& aGame, int* aPlaced, int& aPlacedCount, int aKing, const int* aShields, int aShieldCount,
+                               const int* aSwords, int aSwordCount) {
+    Board& board = aGame.itsBoard;
+    const int SIZE = board.itsSize;
+    for (int i = 0 ; i < aPlacedCount ; i++) {
+        board.itsCells[aPlaced[i] / SIZE][aPlaced[i] % SIZE].itsPieceType = NONE;
+    }
+    aPlacedCount = 0;
+    //the KING on a FORTRESS has escaped, the other pieces only stand on NORMAL cells
+    if (board.itsCells[aKing / SIZE][aKing % SIZE].itsCellType == FORTRESS) {
+        return false;
+    }
+    for (int i = 0 ; i < aShieldCount + aSwordCount ; i++) {
+        const int CELL = (i < aShieldCount) ? aShields[i] : aSwords[i - aShieldCount];
+        if (CELL == aKing || board.itsCells[CELL / SIZE][CELL % SIZE].itsCellType != NORMAL) {
+            return false;
+        }
+        //the shields are distinct and the swords are distinct, a sword may share the cell of a shield
+        for (int shield = 0 ; i >= aShieldCount && shield < aShieldCount ; shield++) {
+            if (aShields[shield] == CELL) {
+                return false;
+            }
+        }
+    }
+    board.itsCells[aKing / SIZE][aKing % SIZE].itsPieceType = KING;
+    aPlaced[aPlacedCount++] = aKing;
+    for (int i = 0 ; i < aShieldCount ; i++) {
+        board.itsCells[aShields[i] / SIZE][aShields[i] % SIZE].itsPieceType = SHIELD;
+        aPlaced[aPlacedCount++] = aShields[i];
+    }
+    for (int i = 0 ; i < aSwordCount ; i++) {
+        board.itsCells[aSwords[i] / SIZE][aSwords[i] % SIZE].itsPieceType = SWORD;
+        aPlaced[aPlacedCount++] = aSwords[i];
+    }
+    updateBitboards(board);
+    return getGameStatus(board) == IN_PROGRESS;
+}
+
+/**
+ * @brief Moves to the next set of cells in the order of `rankPieces()`.
+ *
+ * @param aCells The sorted cells of the set, updated.
+ * @param aCount Number of cells of the set.
+ * @param aLimit Number of cells of the board.
+ * @return `false` after the last set (an empty set has no next one).
+ */
+static bool nextPieceSet(int* aCells, int aCount, int aLimit) {
+    for (int i = 0 ; i < aCount ; i++) {
+        const int NEXT = aCells[i] + 1;
+        if (NEXT < ((i + 1 < aCount) ? aCells[i + 1] : aLimit)) {
+            aCells[i] = NEXT;
+            for (int lower = 0 ; lower < i ; lower++) {
+                aCells[lower] = lower;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Computes one endgame table by retrograde iteration.
+ *
+ * Pass 0 finds the positions without a legal move (lost), pass n the wins and the losses in n plies,
+ * until a pass finds nothing.
+ *
+ * @param aTables The tables (the smaller tables are already computed, the values of this one are 0).
+ * @param aValues The writable values of all the tables.
+ * @param aTable The index of the table to compute.
+ * @param aGame A game with a board of the size of the table (its pieces are replaced).
+ */
+static void computeEndgameTable(const EndgameTables& aTables, unsigned char* aValues, int aTable, Game& aGame) {
+    const EndgameTableInfo& INFO = aTables.itsTables[aTable];
+    const int CELLS = INFO.itsSize * INFO.itsSize;
+    unsigned char* values = aValues + INFO.itsOffset;
+    int placed[1 + ENDGAME_MAX_SHIELDS + ENDGAME_MAX_SWORDS];
+    int placedCount = 0;
+    int shields[ENDGAME_MAX_SHIELDS];
+    int swords[ENDGAME_MAX_SWORDS];
+    MoveList moves;
+    for (int pass = 0 ; pass <= ENDGAME_MAX_DISTANCE ; pass++) {
+        uint64_t changes = 0;
+        uint64_t index = 0;
+        for (int role = ATTACK ; role <= DEFENSE ; role++) {
+            aGame.itsCurrentPlayer = (role == ATTACK) ? &aGame.itsPlayer1 : &aGame.itsPlayer2;
+            for (int king = 0 ; king < CELLS ; king++) {
+                for (int i = 0 ; i < INFO.itsShields ; i++) {
+                    shields[i] = i;
+                }
+                do {
+                    for (int i = 0 ; i < INFO.itsSwords ; i++) {
+                        swords[i] = i;
+                    }
+                    do {
+                        const uint64_t POSITION = index++;
+                        if (values[POSITION] != 0
+                            || !placeEndgamePieces(aGame, placed, placedCount, king, shields, INFO.itsShields, swords, INFO.itsSwords)) {
+                            continue;
+                        }
+                        if (generateMoves(aGame, moves) == 0) {
+                            //a player who can't move loses
+                            values[POSITION] = ENDGAME_LOSS;
+                            changes++;
+                            continue;
+                        }
+                        if (pass == 0) {
+                            continue;
+                        }
+                        const EndgameChoice CHOICE = compareEndgameMoves(aTables, aGame, moves, pass);
+                        if (CHOICE.itsWin != -1) {
+                            values[POSITION] = static_cast<unsigned char>(CHOICE.itsWin);
+                            changes++;
+                        } else if (!CHOICE.itsIsOpen) {
+                            values[POSITION] = static_cast<unsigned char>(ENDGAME_LOSS | CHOICE.itsLoss);
+                            changes++;
+                        }
+                    } while (nextPieceSet(swords, INFO.itsSwords, CELLS));
+                } while (nextPieceSet(shields, INFO.itsShields, CELLS));
+            }
+        }
+        if (pass > 0 && changes == 0) {
+            break;
+        }
+    }
+    //leave the board empty for the next table
+    for (int i = 0 ; i < placedCount ; i++) {
+        aGame.itsBoard.itsCells[placed[i] / INFO.itsSize][placed[i] % INFO.itsSize].itsPieceType = NONE;
+    }
+}
+
+/**
+ * @brief Computes the endgame tables of a board size, with up to a number of shields and swords.
+ *
+ * The tables are computed from the smallest (the KING against one SWORD) to the biggest,
+ * because a capture leads to a smaller table. Tables with more than `ENDGAME_MAX_POSITIONS`
+ * positions are skipped.
+ *
+ * @param aTables The tables to build (must be empty).
+ * @param aSize The size of the board.
+ * @param aMaxShields Maximum number of SHIELD pieces (0 to `ENDGAME_MAX_SHIELDS`).
+ * @param aMaxSwords Maximum number of SWORD pieces (1 to `ENDGAME_MAX_SWORDS`).
+ * @return `true` if the tables are built, `false` on invalid arguments or allocation failure.
+ */
+bool buildEndgameTables(EndgameTables& aTables, BoardSize aSize, int aMaxShields, int aMaxSwords) {
+    if (aTables.itsValues != nullptr || (aSize != LITTLE && aSize != BIG) || aMaxShields < 0 || aMaxShields > ENDGAME_MAX_SHIELDS
+        || aMaxSwords < 1 || aMaxSwords > ENDGAME_MAX_SWORDS) {
+        return false;
+    }
+    //the tables by number of pieces, so the tables reached by a capture come first
+    uint64_t total = 0;
+    for (int pieces = 1 ; pieces <= aMaxShields + aMaxSwords ; pieces++) {
+        for (int swords = 1 ; swords <= min(pieces, aMaxSwords) ; swords++) {
+            const int SHIELDS = pieces - swords;
+            const uint64_t COUNT = countEndgamePositions(aSize, SHIELDS, swords);
+            if (SHIELDS > aMaxShields || COUNT > ENDGAME_MAX_POSITIONS) {
+                continue;
+            }
+            EndgameTableInfo& info = aTables.itsTables[aTables.itsTableCount++];
+            info = EndgameTableInfo();
+            info.itsSize = static_cast<unsigned char>(aSize);
+            info.itsShields = static_cast<unsigned char>(SHIELDS);
+            info.itsSwords = static_cast<unsigned char>(swords);
+            info.itsOffset = total;
+            info.itsCount = COUNT;
+            total += COUNT;
+        }
+    }
+    unsigned char* values = new (nothrow) unsigned char[total]();
+    Game game;
+    game.itsBoard.itsSize = aSize;
+    if (values == nullptr || !createBoard(game.itsBoard)) {
+        delete[] values;
+        aTables = EndgameTables();
+        return false;
+    }
+    //the cell types of the starting position, without the pieces
+    initializeBoard(game.itsBoard);
+    for (int row = 0 ; row < aSize ; row++) {
+        for (int col = 0 ; col < aSize ; col++) {
+            game.itsBoard.itsCells[row][col].itsPieceType = NONE;
+        }
+    }
+    aTables.itsOwnedValues = values;
+    aTables.itsValues = values;
+    for (int table = 0 ; table < aTables.itsTableCount ; table++) {
+        computeEndgameTable(aTables, values, table, game);
+    }
+    deleteBoard(game.itsBoard);
+    return true;
+}
+
+/**
+ * @brief Writes endgame tables to a file.
+ *
+ * @param aTables The tables.
+ * @param aPath The path of the file (replaced).
+ * @return `true` if the whole file was written.
+ */
+bool writeEndgameTables(const EndgameTables& aTables, const string& aPath) {
+    FILE* file = fopen(aPath.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    EndgameHeader header;
+    header.itsTableCount = static_cast<uint32_t>(aTables.itsTableCount);
+    bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1;
+    //in the file, the offsets are from the start of the file
+    const uint64_t FIRST = sizeof(EndgameHeader) + sizeof(EndgameTableInfo) * static_cast<uint64_t>(aTables.itsTableCount);
+    for (int table = 0 ; table < aTables.itsTableCount ; table++) {
+        EndgameTableInfo info = aTables.itsTables[table];
+        info.itsOffset = FIRST + (aTables.itsTables[table].itsOffset - aTables.itsTables[0].itsOffset);
+        isWritten = isWritten && fwrite(&info, sizeof(info), 1, file) == 1;
+    }
+    for (int table = 0 ; table < aTables.itsTableCount ; table++) {
+        const EndgameTableInfo& INFO = aTables.itsTables[table];
+        isWritten = isWritten && fwrite(aTables.itsValues + INFO.itsOffset, 1, INFO.itsCount, file) == INFO.itsCount;
+    }
+    return fclose(file) == 0 && isWritten;
+}
+
+/**
+ * @brief Maps endgame tables in memory.
+ *
+ * @param aTables The tables to open (must be empty).
+ * @param aPath The path of the file.
+ * @return `true` if the tables are mapped and valid (header, sizes and offsets).
+ */
+bool openEndgameTables(EndgameTables& aTables, const string& aPath) {
+    if (aTables.itsValues != nullptr || !mapReadOnlyFile(aPath, aTables.itsData, aTables.itsLength, aTables.itsMapping)) {
+        return false;
+    }
+    EndgameHeader header;
+    bool isValid = aTables.itsLength >= sizeof(EndgameHeader);
+    if (isValid) {
+        memcpy(&header, aTables.itsData, sizeof(header));
+        isValid = memcmp(header.itsMagic, ENDGAME_MAGIC, sizeof(ENDGAME_MAGIC)) == 0 && header.itsVersion == ENDGAME_VERSION
+                  && header.itsTableCount <= static_cast<uint32_t>(ENDGAME_MAX_TABLES)
+                  && aTables.itsLength >= sizeof(EndgameHeader) + sizeof(EndgameTableInfo) * header.itsTableCount;
+    }
+    for (uint32_t table = 0 ; isValid && table < header.itsTableCount ; table++) {
+        EndgameTableInfo& info = aTables.itsTables[table];
+        memcpy(&info, aTables.itsData + sizeof(EndgameHeader) + sizeof(EndgameTableInfo) * table, sizeof(info));
+        //the count is checked first, so the offset can't overflow
+        isValid = (info.itsSize == LITTLE || info.itsSize == BIG) && info.itsShields <= ENDGAME_MAX_SHIELDS
+                  && info.itsSwords >= 1 && info.itsSwords <= ENDGAME_MAX_SWORDS
+                  && info.itsCount == countEndgamePositions(info.itsSize, info.itsShields, info.itsSwords)
+                  && info.itsOffset <= aTables.itsLength && info.itsCount <= aTables.itsLength - info.itsOffset;
+    }
+    if (!isValid) {
+        closeEndgameTables(aTables);
+        return false;
+    }
+    aTables.itsTableCount = static_cast<int>(header.itsTableCount);
+    aTables.itsValues = aTables.itsData;
+    return true;
+}
+
+/**
+ * @brief Unmaps or frees endgame tables. Safe to call on empty tables.
+ *
+ * @param aTables The tables to close.
+ */
+void closeEndgameTables(EndgameTables& aTables) {
+    unmapReadOnlyFile(aTables.itsData, aTables.itsLength, aTables.itsMapping);
+    delete[] aTables.itsOwnedValues;
+    aTables = EndgameTables();
+}
+
+/**
+ * @brief Finds the best move of a position of the endgame tables.
+ *
+ * The fastest win, or the longest loss. A drawn position is left to the search.
+ *
+ * @param aTables The tables.
+ * @param aGame The game (modified during the probe and restored).
+ * @param aMove Set to the best move.
+ * @param aScore Set to the score of the move (`AI_WIN_SCORE` minus the distance for a win).
+ * @return `true` if the position is won or lost in the tables.
+ */
+bool probeEndgameTables(const EndgameTables& aTables, Game& aGame, Move& aMove, int& aScore) {
+    if (getEndgameValue(aTables, aGame) <= 0) {
+        return false;
+    }
+    MoveList moves;
+    if (generateMoves(aGame, moves) == 0) {
+        return false;
+    }
+    const EndgameChoice CHOICE = compareEndgameMoves(aTables, aGame, moves, ENDGAME_MAX_DISTANCE + 1);
+    if (CHOICE.itsWin != -1) {
+        aMove = moves.itsMoves[CHOICE.itsWinMove];
+        aScore = AI_WIN_SCORE - CHOICE.itsWin;
+        return true;
+    }
+    //a lost position: every move loses, the longest resistance is played
+    if (CHOICE.itsIsOpen || CHOICE.itsLoss == -1) {
+        return false;
+    }
+    aMove = moves.itsMoves[CHOICE.itsLossMove];
+    aScore = -(AI_WIN_SCORE - CHOICE.itsLoss);
+    return true;
+}
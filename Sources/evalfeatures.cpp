@@ -0,0 +1,674 @@
+/**
+ * @file evalfeatures.cpp
+ *
+ * @brief Implementation of the whole-board scans and of the evaluation features.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FEATURES_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define FEATURES_NEON
+#include <arm_neon.h>
+#endif
+#include "../Headers/typeDef.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/evalfeatures.h"
+
+using namespace std;
+
+//lets GCC and Clang compile a function for an instruction set the rest of the file doesn't use
+#if defined(__GNUC__) || defined(__clang__)
+#define FEATURES_TARGET(aTarget) __attribute__((target(aTarget)))
+#else
+#define FEATURES_TARGET(aTarget)
+#endif
+
+// ============================================================================
+// SECTION 1: SCAN KERNELS
+// ============================================================================
+
+/**
+ * @brief Number of masks built by a scan (SHIELD, SWORD, KING, FORTRESS, CASTLE).
+ */
+static const int SCAN_PATTERNS = 5;
+
+/**
+ * @brief Smallest number of bytes scanned with SIMD (smaller boards use the scalar kernel).
+ */
+static const int SCAN_MIN_BYTES = 32;
+
+/**
+ * @struct CellPatterns
+ * @brief The byte values looked for by a scan.
+ *
+ * The bit layout of `Cell` is chosen by the compiler, so the values are read from real cells:
+ * a byte matches pattern k if `(byte & mask) == itsValues[k]`, with the piece mask for the
+ * 3 pieces and the cell mask for the 2 special cells.
+ */
+struct CellPatterns
+{
+    unsigned char itsPieceMask;                /**< Bits of `itsPieceType`. */
+    unsigned char itsCellMask;                 /**< Bits of `itsCellType`. */
+    unsigned char itsValues[SCAN_PATTERNS];    /**< SHIELD, SWORD, KING, FORTRESS, CASTLE. */
+};
+
+/**
+ * @brief Reads the byte of a cell.
+ */
+static unsigned char toByte(const Cell& aCell) {
+    unsigned char byte;
+    memcpy(&byte, &aCell, sizeof(byte));
+    return byte;
+}
+
+/**
+ * @brief Builds the patterns of a scan (once).
+ *
+ * @return The patterns.
+ */
+static CellPatterns buildCellPatterns() {
+    CellPatterns patterns;
+    Cell cell;
+    cell.itsCellType = NORMAL;
+    cell.itsPieceType = static_cast<PieceType>(15);
+    patterns.itsPieceMask = toByte(cell);
+    cell.itsCellType = static_cast<CellType>(15);
+    cell.itsPieceType = NONE;
+    patterns.itsCellMask = toByte(cell);
+    const PieceType PIECES[3] = {SHIELD, SWORD, KING};
+    for (int k = 0 ; k < 3 ; k++) {
+        cell.itsCellType = NORMAL;
+        cell.itsPieceType = PIECES[k];
+        patterns.itsValues[k] = toByte(cell);
+    }
+    const CellType CELLS[2] = {FORTRESS, CASTLE};
+    for (int k = 0 ; k < 2 ; k++) {
+        cell.itsCellType = CELLS[k];
+        cell.itsPieceType = NONE;
+        patterns.itsValues[3 + k] = toByte(cell);
+    }
+    return patterns;
+}
+
+/**
+ * @brief Scan kernel interface: builds the masks of `aCount` bytes (bit i of a mask is byte i).
+ */
+using ScanKernel = void (*)(const unsigned char* aBytes, int aCount, const CellPatterns& aPatterns, uint64_t aMasks[SCAN_PATTERNS][3]);
+
+/**
+ * @brief Portable scan, one byte at a time.
+ */
+static void scanScalar(const unsigned char* aBytes, int aCount, const CellPatterns& aPatterns, uint64_t aMasks[SCAN_PATTERNS][3]) {
+    for (int i = 0 ; i < aCount ; i++) {
+        const unsigned char PIECE = aBytes[i] & aPatterns.itsPieceMask;
+        const unsigned char CELL = aBytes[i] & aPatterns.itsCellMask;
+        for (int k = 0 ; k < SCAN_PATTERNS ; k++) {
+            if (((k < 3) ? PIECE : CELL) == aPatterns.itsValues[k]) {
+                aMasks[k][i >> 6] |= uint64_t(1) << (i & 63);
+            }
+        }
+    }
+}
+
+#ifdef FEATURES_X86
+/**
+ * @brief SSE2 scan, 16 bytes per compare.
+ *
+ * The last block is loaded so that it ends on the last byte (it overlaps the previous one),
+ * and the bits already added are dropped: no read past the bytes. Needs at least 16 bytes.
+ */
+FEATURES_TARGET("sse2")
+static void scanSse2(const unsigned char* aBytes, int aCount, const CellPatterns& aPatterns, uint64_t aMasks[SCAN_PATTERNS][3]) {
+    const __m128i PIECE_MASK = _mm_set1_epi8(static_cast<char>(aPatterns.itsPieceMask));
+    const __m128i CELL_MASK = _mm_set1_epi8(static_cast<char>(aPatterns.itsCellMask));
+    __m128i values[SCAN_PATTERNS];
+    for (int k = 0 ; k < SCAN_PATTERNS ; k++) {
+        values[k] = _mm_set1_epi8(static_cast<char>(aPatterns.itsValues[k]));
+    }
+    for (int offset = 0 ; offset < aCount ; offset += 16) {
+        const int START = min(offset, aCount - 16);
+        const __m128i BYTES = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aBytes + START));
+        const __m128i PIECES = _mm_and_si128(BYTES, PIECE_MASK);
+        const __m128i CELLS = _mm_and_si128(BYTES, CELL_MASK);
+        for (int k = 0 ; k < SCAN_PATTERNS ; k++) {
+            const uint32_t BITS = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8((k < 3) ? PIECES : CELLS, values[k])));
+            //a block starts on a multiple of 16 bits, so it never spans two words
+            aMasks[k][offset >> 6] |= uint64_t(BITS >> (offset - START)) << (offset & 63);
+        }
+    }
+}
+
+/**
+ * @brief AVX2 scan, 32 bytes per compare (same overlapping last block as `scanSse2()`).
+ */
+FEATURES_TARGET("avx2")
+static void scanAvx2(const unsigned char* aBytes, int aCount, const CellPatterns& aPatterns, uint64_t aMasks[SCAN_PATTERNS][3]) {
+    const __m256i PIECE_MASK = _mm256_set1_epi8(static_cast<char>(aPatterns.itsPieceMask));
+    const __m256i CELL_MASK = _mm256_set1_epi8(static_cast<char>(aPatterns.itsCellMask));
+    __m256i values[SCAN_PATTERNS];
+    for (int k = 0 ; k < SCAN_PATTERNS ; k++) {
+        values[k] = _mm256_set1_epi8(static_cast<char>(aPatterns.itsValues[k]));
+    }
+    for (int offset = 0 ; offset < aCount ; offset += 32) {
+        const int START = min(offset, aCount - 32);
+        const __m256i BYTES = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aBytes + START));
+        const __m256i PIECES = _mm256_and_si256(BYTES, PIECE_MASK);
+        const __m256i CELLS = _mm256_and_si256(BYTES, CELL_MASK);
+        for (int k = 0 ; k < SCAN_PATTERNS ; k++) {
+            const uint32_t BITS = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8((k < 3) ? PIECES : CELLS, values[k])));
+            //a block starts on a multiple of 32 bits, so it never spans two words
+            aMasks[k][offset >> 6] |= uint64_t(BITS >> (offset - START)) << (offset & 63);
+        }
+    }
+}
+
+/**
+ * @brief Checks if the CPU and the OS support AVX2.
+ */
+static bool hasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int registers[4];
+    __cpuid(registers, 1);
+    //OSXSAVE and AVX, then the OS must save the YMM registers
+    if ((registers[2] & (1 << 27)) == 0 || (registers[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(registers, 7, 0);
+    return (registers[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#ifdef FEATURES_NEON
+/**
+ * @brief Packs the result of a NEON compare in 16 bits (NEON has no movemask).
+ */
+static inline uint32_t neonMoveMask(uint8x16_t aCompare) {
+    static const uint8_t WEIGHTS[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t BITS = vandq_u8(aCompare, vld1q_u8(WEIGHTS));
+    return uint32_t(vaddv_u8(vget_low_u8(BITS))) | (uint32_t(vaddv_u8(vget_high_u8(BITS))) << 8);
+}
+
+/**
+ * @brief NEON scan, 16 bytes per compare (same overlapping last block as `scanSse2()`).
+ */
+static void scanNeon(const unsigned char* aBytes, int aCount, const CellPatterns& aPatterns, uint64_t aMasks[SCAN_PATTERNS][3]) {
+    const uint8x16_t PIECE_MASK = vdupq_n_u8(aPatterns.itsPieceMask);
+    const uint8x16_t CELL_MASK = vdupq_n_u8(aPatterns.itsCellMask);
+    for (int offset = 0 ; offset < aCount ; offset += 16) {
+        const int START = min(offset, aCount - 16);
+        const uint8x16_t BYTES = vld1q_u8(aBytes + START);
+        const uint8x16_t PIECES = vandq_u8(BYTES, PIECE_MASK);
+        const uint8x16_t CELLS = vandq_u8(BYTES, CELL_MASK);
+        for (int k = 0 ; k < SCAN_PATTERNS ; k++) {
+            const uint32_t BITS = neonMoveMask(vceqq_u8((k < 3) ? PIECES : CELLS, vdupq_n_u8(aPatterns.itsValues[k])));
+            aMasks[k][offset >> 6] |= uint64_t(BITS >> (offset - START)) << (offset & 63);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Checks if a kernel can run on this CPU (and was compiled in).
+ *
+ * @param aKernel The kernel.
+ * @return `true` if `selectFeatureKernel()` can use it.
+ */
+bool isFeatureKernelSupported(FeatureKernel aKernel) {
+    switch (aKernel) {
+        case KERNEL_SCALAR:
+            return true;
+#ifdef FEATURES_X86
+        case KERNEL_SSE2:
+            return true;
+        case KERNEL_AVX2: {
+            static const bool HAS_AVX2 = hasAvx2();
+            return HAS_AVX2;
+        }
+#endif
+#ifdef FEATURES_NEON
+        case KERNEL_NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Gets the selected kernel (the best supported one until `selectFeatureKernel()` is called).
+ */
+static atomic<int>& selectedKernel() {
+    static atomic<int> kernel{isFeatureKernelSupported(KERNEL_AVX2) ? KERNEL_AVX2
+                              : isFeatureKernelSupported(KERNEL_SSE2) ? KERNEL_SSE2
+                              : isFeatureKernelSupported(KERNEL_NEON) ? KERNEL_NEON : KERNEL_SCALAR};
+    return kernel;
+}
+
+/**
+ * @brief Chooses the kernel used by the scans (the best supported one is used by default).
+ *
+ * @param aKernel The kernel.
+ * @return `false` (and nothing changes) if the kernel is not supported.
+ */
+bool selectFeatureKernel(FeatureKernel aKernel) {
+    if (!isFeatureKernelSupported(aKernel)) {
+        return false;
+    }
+    selectedKernel().store(aKernel, memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Gets the kernel used by the scans.
+ *
+ * @return The selected kernel.
+ */
+FeatureKernel getFeatureKernel() {
+    return static_cast<FeatureKernel>(selectedKernel().load(memory_order_relaxed));
+}
+
+/**
+ * @brief Gets the name of a kernel.
+ *
+ * @param aKernel The kernel.
+ * @return "scalar", "sse2", "avx2", "neon", or "unknown".
+ */
+const char* getFeatureKernelName(FeatureKernel aKernel) {
+    switch (aKernel) {
+        case KERNEL_SCALAR:
+            return "scalar";
+        case KERNEL_SSE2:
+            return "sse2";
+        case KERNEL_AVX2:
+            return "avx2";
+        case KERNEL_NEON:
+            return "neon";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * @brief Gets the function of the selected kernel.
+ *
+ * @param aCount The number of bytes to scan (short scans always use the scalar kernel).
+ * @return The kernel function.
+ */
+static ScanKernel getScanKernel(int aCount) {
+    if (aCount < SCAN_MIN_BYTES) {
+        return scanScalar;
+    }
+    switch (getFeatureKernel()) {
+#ifdef FEATURES_X86
+        case KERNEL_SSE2:
+            return scanSse2;
+        case KERNEL_AVX2:
+            return scanAvx2;
+#endif
+#ifdef FEATURES_NEON
+        case KERNEL_NEON:
+            return scanNeon;
+#endif
+        default:
+            return scanScalar;
+    }
+}
+
+/**
+ * @brief Copies the rows of a board next to each other (byte `row * size + col` is the cell).
+ *
+ * @param aBytes The cells (rows of `BIG` bytes).
+ * @param aSize The size of the board (less than `BIG`).
+ * @param aPacked Receives the `aSize * aSize` cells.
+ */
+static void packRows(const unsigned char* aBytes, int aSize, unsigned char* aPacked) {
+    if (aSize == LITTLE) {
+        //constant length: each copy is a couple of moves
+        for (int line = 0 ; line < LITTLE ; line++) {
+            memcpy(aPacked + line * LITTLE, aBytes + line * BIG, LITTLE);
+        }
+        return;
+    }
+    for (int line = 0 ; line < aSize ; line++) {
+        memcpy(aPacked + line * aSize, aBytes + line * BIG, aSize);
+    }
+}
+
+/**
+ * @brief Builds the masks of the pieces and of the special cells from the cells.
+ *
+ * The rows are `BIG` cells wide and allocated in one block: on a BIG board the cells are
+ * already in the order of the masks, smaller boards are packed first (`packRows()`).
+ * The kernel then scans one run of bytes, bit i of each mask being byte i.
+ *
+ * @param aBoard The board to scan (`itsCells` allocated, size from 1 to `BIG`; its bitboards are not used).
+ * @param aPieceMasks Receives one mask per piece type (the NONE mask is empty).
+ * @param aCellMasks Receives one mask per cell type (the NORMAL mask is empty).
+ * @return `false` (and the masks are not modified) if the board can't be scanned.
+ */
+bool scanBoardMasks(const Board& aBoard, BitBoard aPieceMasks[4], BitBoard aCellMasks[3]) {
+    static const CellPatterns PATTERNS = buildCellPatterns();
+    const int SIZE = aBoard.itsSize;
+    if (aBoard.itsCells == nullptr || SIZE <= 0 || SIZE > BIG) {
+        return false;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(aBoard.itsCells[0]);
+    unsigned char packed[BIG * BIG];
+    if (SIZE != BIG) {
+        packRows(bytes, SIZE, packed);
+        bytes = packed;
+    }
+    uint64_t masks[SCAN_PATTERNS][3] = {};
+    getScanKernel(SIZE * SIZE)(bytes, SIZE * SIZE, PATTERNS, masks);
+    BitBoard* results[SCAN_PATTERNS] = {&aPieceMasks[SHIELD], &aPieceMasks[SWORD], &aPieceMasks[KING], &aCellMasks[FORTRESS], &aCellMasks[CASTLE]};
+    aPieceMasks[NONE] = BitBoard();
+    aCellMasks[NORMAL] = BitBoard();
+    for (int k = 0 ; k < SCAN_PATTERNS ; k++) {
+        memcpy(results[k]->itsWords, masks[k], sizeof(masks[k]));
+    }
+    return true;
+}
+
+// ============================================================================
+// SECTION 2: FEATURES
+// ============================================================================
+
+/**
+ * @brief Builds the mask of the cells of a board, without one column.
+ *
+ * @param aSize The size of the board.
+ * @param aSkippedColumn The column left out (-1 for none).
+ * @return The mask.
+ */
+static constexpr BitBoard buildBoardMask(int aSize, int aSkippedColumn) {
+    BitBoard mask;
+    for (int index = 0 ; index < aSize * aSize ; index++) {
+        if (index % aSize != aSkippedColumn) {
+            mask.itsWords[index >> 6] |= uint64_t(1) << (index & 63);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Builds the mask of the 4 corners of a board.
+ *
+ * @param aSize The size of the board.
+ * @return The mask.
+ */
+static constexpr BitBoard buildCornerMask(int aSize) {
+    BitBoard mask;
+    for (int index : {0, aSize - 1, aSize * (aSize - 1), aSize * aSize - 1}) {
+        mask.itsWords[index >> 6] |= uint64_t(1) << (index & 63);
+    }
+    return mask;
+}
+
+/**
+ * @brief Masks of the cells of the board, of the cells that have a west neighbor and of those that have an east neighbor.
+ */
+template <int SIZE>
+static constexpr BitBoard ALL_CELLS = buildBoardMask(SIZE, -1);
+template <int SIZE>
+static constexpr BitBoard HAS_WEST = buildBoardMask(SIZE, 0);
+template <int SIZE>
+static constexpr BitBoard HAS_EAST = buildBoardMask(SIZE, SIZE - 1);
+
+/**
+ * @brief Mask of the 4 corners (the FORTRESS cells of a game).
+ */
+template <int SIZE>
+static constexpr BitBoard CORNERS = buildCornerMask(SIZE);
+
+/**
+ * @struct KingTables
+ * @brief Masks around every cell of a board, used for the king features.
+ */
+struct KingTables
+{
+    BitBoard itsNeighbors[BIG * BIG];        /**< The 4 orthogonal neighbors on the board. */
+    unsigned char itsBorderSides[BIG * BIG]; /**< Number of sides out of the board (0-2). */
+    BitBoard itsSquares[BIG * BIG];          /**< The cells of the 5x5 square centered on the cell. */
+};
+
+/**
+ * @brief Builds the king tables of a board size (evaluated at compile time).
+ *
+ * @param aSize The size of the board.
+ * @return The filled tables.
+ */
+static constexpr KingTables buildKingTables(int aSize) {
+    KingTables tables = {};
+    for (int row = 0 ; row < aSize ; row++) {
+        for (int col = 0 ; col < aSize ; col++) {
+            const int INDEX = row * aSize + col;
+            for (int line = row - 2 ; line <= row + 2 ; line++) {
+                for (int column = col - 2 ; column <= col + 2 ; column++) {
+                    if (line < 0 || line >= aSize || column < 0 || column >= aSize) {
+                        continue;
+                    }
+                    const int CELL = line * aSize + column;
+                    tables.itsSquares[INDEX].itsWords[CELL >> 6] |= uint64_t(1) << (CELL & 63);
+                    //the neighbors are the cells one step away
+                    const int ROW_GAP = (line > row) ? line - row : row - line;
+                    const int COL_GAP = (column > col) ? column - col : col - column;
+                    if (ROW_GAP + COL_GAP == 1) {
+                        tables.itsNeighbors[INDEX].itsWords[CELL >> 6] |= uint64_t(1) << (CELL & 63);
+                    }
+                }
+            }
+            tables.itsBorderSides[INDEX] = (row == 0) + (row == aSize - 1) + (col == 0) + (col == aSize - 1);
+        }
+    }
+    return tables;
+}
+
+/**
+ * @brief King tables of each board size.
+ */
+template <int SIZE>
+static constexpr KingTables KING_TABLES = buildKingTables(SIZE);
+
+/**
+ * @brief Moves every cell of a mask one step in a direction (cells leaving the board are dropped).
+ *
+ * @param aMask The cells.
+ * @param aDirection 0 west, 1 east, 2 north, 3 south.
+ * @return The neighbors in that direction.
+ */
+template <int SIZE>
+static inline BitBoard stepMask(const BitBoard& aMask, int aDirection) {
+    switch (aDirection) {
+        case 0:
+            return shiftMaskRight(maskAnd(aMask, HAS_WEST<SIZE>), 1);
+        case 1:
+            return shiftMaskLeft(maskAnd(aMask, HAS_EAST<SIZE>), 1);
+        case 2:
+            return shiftMaskRight(aMask, SIZE);
+        default:
+            return maskAnd(shiftMaskLeft(aMask, SIZE), ALL_CELLS<SIZE>);
+    }
+}
+
+/**
+ * @brief Counts the cells of a mask that has only a few of them (one step per cell).
+ *
+ * Faster than `countBits()` on the masks around the king, when the build has no popcount instruction.
+ *
+ * @param aMask The mask to read.
+ * @return The number of set bits.
+ */
+static inline int countFewBits(const BitBoard& aMask) {
+    int count = 0;
+    for (uint64_t word : aMask.itsWords) {
+        while (word != 0) {
+            word &= word - 1;
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Counts the slides of a set of pieces in one direction (see `countSlides()`).
+ *
+ * @tparam DIRECTION 0 west, 1 east, 2 north, 3 south (a constant, so the shifts are too).
+ */
+template <int SIZE, int DIRECTION>
+static inline int countDirectionSlides(const BitBoard& aPieces, const BitBoard& aLanding, const BitBoard& aPassable) {
+    BitBoard front = aPieces;
+    BitBoard reached;
+    while (!isEmptyMask(front)) {
+        const BitBoard NEXT = stepMask<SIZE>(front, DIRECTION);
+        reached = maskOr(reached, maskAnd(NEXT, aLanding));
+        front = maskAnd(NEXT, aPassable);
+    }
+    return countBits(reached);
+}
+
+/**
+ * @brief Counts the slides of a set of pieces (all directions, all distances).
+ *
+ * Every piece slides through the passable cells; each cell of the landing mask reached counts as one move.
+ * In one direction a cell is reached by one piece at most (the nearest piece blocks the others),
+ * so the cells reached are gathered in a mask and counted once per direction.
+ *
+ * @param aPieces The pieces.
+ * @param aLanding The cells a slide can end on.
+ * @param aPassable The cells a slide can continue through.
+ * @return The number of moves.
+ */
+template <int SIZE>
+static int countSlides(const BitBoard& aPieces, const BitBoard& aLanding, const BitBoard& aPassable) {
+    return countDirectionSlides<SIZE, 0>(aPieces, aLanding, aPassable) + countDirectionSlides<SIZE, 1>(aPieces, aLanding, aPassable)
+           + countDirectionSlides<SIZE, 2>(aPieces, aLanding, aPassable) + countDirectionSlides<SIZE, 3>(aPieces, aLanding, aPassable);
+}
+
+/**
+ * @brief Builds the mask of the empty cells of the board (only needed by the slides).
+ *
+ * @param aPieceMasks The masks of the pieces.
+ * @return The cells without a piece.
+ */
+template <int SIZE>
+static inline BitBoard emptyCells(const BitBoard aPieceMasks[4]) {
+    const BitBoard OCCUPIED = maskOr(maskOr(aPieceMasks[SHIELD], aPieceMasks[SWORD]), aPieceMasks[KING]);
+    BitBoard empty;
+    for (int word = 0 ; word < 3 ; word++) {
+        empty.itsWords[word] = ALL_CELLS<SIZE>.itsWords[word] & ~OCCUPIED.itsWords[word];
+    }
+    return empty;
+}
+
+/**
+ * @brief Computes the features of a position from its masks.
+ *
+ * @param aPieceMasks The masks of the pieces.
+ * @param aCellMasks The masks of the special cells.
+ * @param aPieceCounts The number of pieces of each type.
+ * @param aFeatures Receives the features (reset by the caller).
+ * @param aWithMobility `false` to skip the mobility.
+ */
+template <int SIZE>
+static void computeFeatures(const BitBoard aPieceMasks[4], const BitBoard aCellMasks[3], const int aPieceCounts[4],
+                            EvalFeatures& aFeatures, bool aWithMobility) {
+    constexpr int LAST = SIZE - 1;
+    aFeatures.itsSwordCount = aPieceCounts[SWORD];
+    aFeatures.itsShieldCount = aPieceCounts[SHIELD];
+    const BitBoard SPECIAL = maskOr(aCellMasks[FORTRESS], aCellMasks[CASTLE]);
+    //the first king, like getKingPosition
+    const int KING_INDEX = firstBit(aPieceMasks[KING]);
+    if (KING_INDEX != -1) {
+        const int ROW = KING_INDEX / SIZE;
+        const int COL = KING_INDEX % SIZE;
+        aFeatures.itsHasKing = true;
+        aFeatures.itsKingFortressDistance = min(ROW, LAST - ROW) + min(COL, LAST - COL);
+        //a corner can only be in line with a king on the border (the castle is never on the way)
+        if (ROW == 0 || ROW == LAST || COL == 0 || COL == LAST) {
+            BitBoard king;
+            setBit(king, KING_INDEX);
+            const BitBoard EMPTY = emptyCells<SIZE>(aPieceMasks);
+            aFeatures.itsKingOpenLines = countSlides<SIZE>(king, maskAnd(EMPTY, CORNERS<SIZE>), EMPTY);
+        }
+        //the border, the swords and the special cells are hostile
+        const BitBoard HOSTILE = maskOr(aPieceMasks[SWORD], SPECIAL);
+        aFeatures.itsKingHostileSides = KING_TABLES<SIZE>.itsBorderSides[KING_INDEX]
+                                        + countFewBits(maskAnd(KING_TABLES<SIZE>.itsNeighbors[KING_INDEX], HOSTILE));
+        aFeatures.itsSwordsNearKing = countFewBits(maskAnd(KING_TABLES<SIZE>.itsSquares[KING_INDEX], aPieceMasks[SWORD]));
+    }
+    if (aWithMobility) {
+        //only the king can finish on a special cell, and nothing crosses one
+        const BitBoard EMPTY = emptyCells<SIZE>(aPieceMasks);
+        BitBoard emptyNormal;
+        for (int word = 0 ; word < 3 ; word++) {
+            emptyNormal.itsWords[word] = EMPTY.itsWords[word] & ~SPECIAL.itsWords[word];
+        }
+        aFeatures.itsAttackMobility = countSlides<SIZE>(aPieceMasks[SWORD], emptyNormal, emptyNormal);
+        aFeatures.itsDefenseMobility = countSlides<SIZE>(aPieceMasks[SHIELD], emptyNormal, emptyNormal)
+                                       + countSlides<SIZE>(aPieceMasks[KING], EMPTY, emptyNormal);
+    }
+}
+
+/**
+ * @brief Computes the features of a position with the masks of a board size.
+ *
+ * @param aPieceMasks The masks of the pieces.
+ * @param aCellMasks The masks of the special cells.
+ * @param aPieceCounts The number of pieces of each type.
+ * @param aSize The size of the board (LITTLE or BIG).
+ * @param aFeatures Receives the features (reset by the caller).
+ * @param aWithMobility `false` to skip the mobility.
+ */
+static void computeSizedFeatures(const BitBoard aPieceMasks[4], const BitBoard aCellMasks[3], const int aPieceCounts[4],
+                                 int aSize, EvalFeatures& aFeatures, bool aWithMobility) {
+    if (aSize == LITTLE) {
+        computeFeatures<LITTLE>(aPieceMasks, aCellMasks, aPieceCounts, aFeatures, aWithMobility);
+    }
+    else {
+        computeFeatures<BIG>(aPieceMasks, aCellMasks, aPieceCounts, aFeatures, aWithMobility);
+    }
+}
+
+/**
+ * @brief Computes the features of a position.
+ *
+ * Reads the bitboards of the board when they are synchronized, scans the cells otherwise.
+ * The mobility counts the same moves as `generateMoves()`, without building the list.
+ *
+ * @param aBoard The board (LITTLE or BIG).
+ * @param aFeatures Receives the features.
+ * @param aWithMobility `false` to skip the mobility (the most expensive feature).
+ * @return `false` (and `aFeatures` is reset) if the board is not LITTLE or BIG or has no cells.
+ */
+bool computeEvalFeatures(const Board& aBoard, EvalFeatures& aFeatures, bool aWithMobility) {
+    aFeatures = EvalFeatures();
+    if (aBoard.itsCells == nullptr || (aBoard.itsSize != LITTLE && aBoard.itsSize != BIG)) {
+        return false;
+    }
+    if (aBoard.itsHasBitboards) {
+        computeSizedFeatures(aBoard.itsPieceMasks, aBoard.itsCellMasks, aBoard.itsPieceCounts, aBoard.itsSize, aFeatures, aWithMobility);
+        return true;
+    }
+    BitBoard pieceMasks[4];
+    BitBoard cellMasks[3];
+    int pieceCounts[4] = {0, 0, 0, 0};
+    scanBoardMasks(aBoard, pieceMasks, cellMasks);
+    for (int piece = SHIELD ; piece <= KING ; piece++) {
+        pieceCounts[piece] = countBits(pieceMasks[piece]);
+    }
+    computeSizedFeatures(pieceMasks, cellMasks, pieceCounts, aBoard.itsSize, aFeatures, aWithMobility);
+    return true;
+}
@@ -17,10 +17,22 @@
 #endif
 
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <fstream> //for save functions
 #include <filesystem>
+#include <ctime>
 #include "../Headers/typeDef.h"
 #include "../Headers/functions.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/engine.h"
+#include "../Headers/evalfeatures.h"
+#include "../Headers/journal.h"
+#include "../Headers/saveindex.h"
+#include "../Headers/render.h"
+#include "../Headers/boardpool.h"
+#include "../Headers/profile.h"
 
 using namespace std;
 namespace fs = std::filesystem;
@@ -119,29 +131,22 @@ bool clearConsole() {
 /**
  * @brief Displays the game logo in ASCII art.
  *
- * Prints the Hnefatafl game logo with stylized text and credit line.
- * Best called after `clearConsole()` for clean display.
+ * Clears the console, then prints the Hnefatafl game logo (`HNEFATAFL_LOGO`) in a single write.
+ * The game screen uses `renderGame()` instead, which doesn't clear the console every turn.
  *
  * @note Uses UTF-8 block characters. Call `enableTerminalFormatting()` first for proper Windows display.
  */
 void displayHnefataflLogo() {
     clearConsole();
-    cout << "╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗" << endl;
-    cout << "║     ■           ■                                                                ■■■■■■  ■■■■■■                                                           ║" << endl;
-    cout << "║      ■■       ■■     ■■             ■■■■■■■■■       ■■■■■■■■■■      ■■■       ■■■■   ■■■■■■   ■■■■     ■■■              ■■■■■■■■■       ■■■■■             ║" << endl;
-    cout << "║      ■■■     ■■■     ■■■■■■■■■       ■■■■    ■■      ■■■      ■■    ■■■■■   ■■        ■■■        ■■    ■■■■■             ■■■      ■■      ■■■             ║" << endl;
-    cout << "║      ■■       ■■     ■■■■   ■■■    ■■■      ■      ■■■       ■     ■■■  ■■■            ■■■            ■■■  ■■■         ■■■       ■        ■■■             ║" << endl;
-    cout << "║      ■■       ■■     ■■■     ■■■    ■■■             ■■■            ■■■   ■■■           ■■■            ■■■   ■■■         ■■■               ■■■             ║" << endl;
-    cout << "║      ■■■     ■■■      ■■■     ■■■   ■■■             ■■■           ■■■    ■■■            ■■■          ■■■    ■■■         ■■■              ■■■              ║" << endl;
-    cout << "║     ■■■■■   ■■■■■     ■■■     ■■■   ■■■■           ■■■■          ■■■     ■■■  ■■        ■■■         ■■■     ■■■  ■■    ■■■■              ■■■              ║" << endl;
-    cout << "║    ■■■■■■■■■■■■■■     ■■■     ■■■  ■■■■■■ ■■      ■■■■■■ ■■     ■■■■■   ■■■■■■ ■■      ■■■         ■■■■■   ■■■■■■ ■■   ■■■■■■ ■■         ■■■              ║" << endl;
-    cout << "║      ■■■■   ■■■■      ■■■     ■■■   ■■■             ■■■         ■■■  ■■■■  ■■■        ■■■          ■■■  ■■■■  ■■■       ■■■            ■■■                ║" << endl;
-    cout << "║       ■■     ■■      ■■■     ■■■    ■■■             ■■■         ■■■      ■■■         ■■■           ■■■        ■■■       ■■■          ■■■                  ║" << endl;
-    cout << "║      ■■■     ■■■     ■■■     ■■■    ■■■      ■      ■■■         ■■■      ■■■          ■■■          ■■■      ■■■         ■■■        ■■■                    ║" << endl;
-    cout << "║      ■■       ■■     ■■     ■■      ■■■     ■■      ■■■         ■■■      ■■■       ■   ■■■  ■      ■■■      ■■■         ■■■       ■■■               ■■■   ║" << endl;
-    cout << "║     ■           ■    ■     ■      ■■■■■■■■■■■     ■■■■■           ■■■      ■■■      ■■■■■■■■        ■■■      ■■■      ■■■■■        ■■■■■■■■■■■■■■■■■■     ║" << endl;
-    cout << "╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝" << endl;
-    }
+    //the whole logo in one write
+    char text[LOGO_TEXT_CAPACITY];
+    TextBuffer buffer = {text, 0, LOGO_TEXT_CAPACITY};
+    for (int line = 0 ; line < LOGO_LINES ; line++) {
+        appendText(buffer, HNEFATAFL_LOGO[line]);
+        appendText(buffer, "\n");
+    }
+    cout.write(text, buffer.itsLength) << flush;
+}
 
 // ============================================================================
 // SECTION 2: BOARD MANAGEMENT
@@ -179,28 +184,30 @@ bool chooseSizeBoard(BoardSize& aBoardSize)
 /**
  * @brief Dynamically creates a game board.
  *
- * Allocates memory for a 2D array of cells. Validates board size and checks for existing allocation.
- * Cleans up memory on failure to avoid leaks.
+ * Allocates the cells in a single contiguous block (`itsSize` rows of `BIG` one-byte cells).
+ * Validates board size (1 to BIG) and checks for existing allocation.
  *
  * @param aBoard Reference to the Board object (`itsSize` must be set).
  * @return `true` if successful, `false` on allocation failure or invalid input.
  */
 bool createBoard(Board& aBoard) {
     const int SIZE = aBoard.itsSize;
-    // dont do if size is null
-    if ( SIZE == 0 ) {
+    // dont do if size is null or wider than a row
+    if ( SIZE <= 0 || SIZE > BIG ) {
         return false;
     }
     // prevent double allocation
     if (aBoard.itsCells != nullptr) {
         return false;
     }
-    // allocation of the boards lines
-    aBoard.itsCells = new Cell*[SIZE];
-    // allocation of Columns for each line
-    for (int line = 0; line < SIZE; line++){
-            aBoard.itsCells[line] = new Cell[SIZE];
+    // one allocation for all the lines (zeroed, so the padding of short rows is defined for the scans)
+    aBoard.itsCells = new (nothrow) CellRow[SIZE]();
+    if (aBoard.itsCells == nullptr) {
+        return false;
     }
+    countBoardAllocation();
+    aBoard.itsIsPooled = false;
+    aBoard.itsHasBitboards = false;
     return true;
 }
 
@@ -208,25 +215,131 @@ bool createBoard(Board& aBoard) {
 /**
  * @brief Frees the memory allocated for the game board.
  *
- * Deallocates the 2D array of cells and sets `itsCells` to `nullptr`.
+ * Deallocates the block of cells and sets `itsCells` to `nullptr`.
  * Safe to call multiple times (does nothing if already freed).
+ * A board of a `BoardPool` keeps its cells, they go back with `releaseBoard()`.
  *
  * @param aBoard Reference to the Board object to deallocate.
  */
 void deleteBoard(Board& aBoard) {
-    const int SIZE = aBoard.itsSize;
-    for (int line = 0; line < SIZE; line++) {
-        //free each row of the table
-        if (aBoard.itsCells != nullptr) {
-            delete[] aBoard.itsCells[line] ;
-            aBoard.itsCells[line] = nullptr;
-        }
+    if (aBoard.itsIsPooled) {
+        return;
     }
     //free all the table
     if (aBoard.itsCells != nullptr) {
         delete[] aBoard.itsCells ;
         aBoard.itsCells = nullptr;
     }
+    aBoard.itsHasBitboards = false;
+}
+
+/**
+ * @brief Gives a board the cells of a size, allocating only if needed.
+ *
+ * A board allocated with another size is reallocated. A board of a `BoardPool` has `BIG` rows,
+ * it takes any size without allocation (its cells are cleared when the size changes).
+ *
+ * @param aBoard The board (allocated or not).
+ * @param aSize The size wanted.
+ * @return `true` if the board has its cells, `false` if the allocation failed.
+ */
+bool resizeBoard(Board& aBoard, BoardSize aSize) {
+    if (aBoard.itsCells != nullptr && aBoard.itsSize == aSize) {
+        return true;
+    }
+    if (aBoard.itsIsPooled) {
+        memset(aBoard.itsCells, 0, sizeof(CellRow) * BIG);
+        aBoard.itsSize = aSize;
+        aBoard.itsHasBitboards = false;
+        return true;
+    }
+    deleteBoard(aBoard);
+    aBoard.itsSize = aSize;
+    return createBoard(aBoard);
+}
+
+/**
+ * @brief Copies a board (cells, bitboards and key) into another one.
+ *
+ * The destination is allocated (or reallocated if its size differs), then the whole
+ * block of cells is copied with a single `memcpy`.
+ *
+ * @param aSource The board to copy (`itsCells` must be allocated).
+ * @param aDestination The board receiving the copy.
+ * @return `true` if successful, `false` if the source is not allocated or the allocation failed.
+ */
+bool copyBoard(const Board& aSource, Board& aDestination) {
+    if (aSource.itsCells == nullptr) {
+        return false;
+    }
+    if (&aSource == &aDestination) {
+        return true;
+    }
+    //reallocate only if the block has not the good size
+    if (!resizeBoard(aDestination, aSource.itsSize)) {
+        return false;
+    }
+    memcpy(aDestination.itsCells, aSource.itsCells, sizeof(CellRow) * aSource.itsSize);
+    memcpy(aDestination.itsPieceMasks, aSource.itsPieceMasks, sizeof(aSource.itsPieceMasks));
+    memcpy(aDestination.itsCellMasks, aSource.itsCellMasks, sizeof(aSource.itsCellMasks));
+    memcpy(aDestination.itsPieceCounts, aSource.itsPieceCounts, sizeof(aSource.itsPieceCounts));
+    aDestination.itsKingIndex = aSource.itsKingIndex;
+    aDestination.itsStatus = aSource.itsStatus;
+    aDestination.itsHasBitboards = aSource.itsHasBitboards;
+    aDestination.itsHash = aSource.itsHash;
+    return true;
+}
+
+/**
+ * @brief Copies the position of a game into a snapshot.
+ *
+ * @param aGame The game to copy (`itsCells` must be allocated).
+ * @return A snapshot holding the cells, the players roles, the player to move and the key.
+ */
+GameSnapshot takeSnapshot(const Game& aGame) {
+    GameSnapshot snapshot;
+    const int SIZE = aGame.itsBoard.itsSize;
+    snapshot.itsSize = aGame.itsBoard.itsSize;
+    if (aGame.itsBoard.itsCells != nullptr && SIZE > 0 && SIZE <= BIG) {
+        memcpy(snapshot.itsCells, aGame.itsBoard.itsCells, sizeof(CellRow) * SIZE);
+    }
+    snapshot.itsPlayerRoles[0] = aGame.itsPlayer1.itsRole;
+    snapshot.itsPlayerRoles[1] = aGame.itsPlayer2.itsRole;
+    snapshot.itsIsComputer[0] = aGame.itsPlayer1.itsIsComputer;
+    snapshot.itsIsComputer[1] = aGame.itsPlayer2.itsIsComputer;
+    snapshot.itsCurrentPlayer = (aGame.itsCurrentPlayer == &aGame.itsPlayer2) ? 2 : 1;
+    snapshot.itsHash = aGame.itsBoard.itsHash;
+    return snapshot;
+}
+
+/**
+ * @brief Rebuilds a game from a snapshot.
+ *
+ * The board of `aGame` is (re)allocated if needed, the bitboards are rebuilt and
+ * `itsCurrentPlayer` points to the player of `aGame` stored in the snapshot.
+ *
+ * @param aSnapshot The snapshot to read.
+ * @param aGame The game to overwrite (its player names are kept).
+ * @return `true` if the game was rebuilt, `false` if the snapshot is invalid or the allocation failed.
+ */
+bool restoreSnapshot(const GameSnapshot& aSnapshot, Game& aGame) {
+    const int SIZE = aSnapshot.itsSize;
+    if (SIZE <= 0 || SIZE > BIG || (aSnapshot.itsCurrentPlayer != 1 && aSnapshot.itsCurrentPlayer != 2)) {
+        return false;
+    }
+    //reallocate only if the size changed
+    if (!resizeBoard(aGame.itsBoard, aSnapshot.itsSize)) {
+        return false;
+    }
+    memcpy(aGame.itsBoard.itsCells, aSnapshot.itsCells, sizeof(CellRow) * SIZE);
+    updateBitboards(aGame.itsBoard);
+    aGame.itsBoard.itsHash = aSnapshot.itsHash;
+    aGame.itsPlayer1.itsRole = aSnapshot.itsPlayerRoles[0];
+    aGame.itsPlayer2.itsRole = aSnapshot.itsPlayerRoles[1];
+    aGame.itsPlayer1.itsIsComputer = aSnapshot.itsIsComputer[0];
+    aGame.itsPlayer2.itsIsComputer = aSnapshot.itsIsComputer[1];
+    aGame.itsCurrentPlayer = (aSnapshot.itsCurrentPlayer == 2) ? &aGame.itsPlayer2 : &aGame.itsPlayer1;
+    return true;
 }
 
 /**
@@ -234,87 +347,37 @@ void deleteBoard(Board& aBoard) {
  *
  * Shows the board with column numbers (1-N) and row letters (A-N).
  * Displays pieces (shields, swords, king) and special cells (castle, fortresses).
+ * The text is composed in a stack buffer by `writeBoardText()` and written in one call.
  *
  * @param aBoard The game board object to display.
  * @note Handles both LITTLE (11x11) and BIG (13x13) board sizes.
  */
 void displayBoard(const Board& aBoard) {
-    const int SIZE = aBoard.itsSize;
-    const string CHARBOARD = "ABCDEFGHIJKLM";
-    cout << "    ";
+    //composed on the stack, then written in one call
+    char text[BOARD_TEXT_CAPACITY];
+    TextBuffer buffer = {text, 0, BOARD_TEXT_CAPACITY};
+    writeBoardText(aBoard, buffer);
+    cout.write(text, buffer.itsLength);
+}
 
-    for (int column = 0 ; column<SIZE ; column++ ) {
-        cout << "  " << column +1 ;
-        if (column>=9) {
-            cout <<"  ";
-        }
-        else {
-            cout <<"   ";
-        }
-    }
-    cout <<endl;
-    cout<<"   ╬";
-    for (int column = 0 ; column<SIZE ; column++ ) {
-        if (column != SIZE-1) {
-            cout << "═════╬";
-        }
-        else {
-            cout << "═════╣";
-        }
-    }
-    cout <<endl;
-    for (int line = 0 ; line<SIZE ; line++) {
-        cout << " " << CHARBOARD[line] << " ║";
-        for (int column = 0 ; column<SIZE ; column++) {
-            //take the enums as integers
-            CellType pos = aBoard.itsCells[line][column].itsCellType;
-            PieceType piece = aBoard.itsCells[line][column].itsPieceType;
-            cout << "  ";
-            if (piece == NONE ) {
-
-                if (pos == NORMAL) {
-                    cout << " ";
-                }
-                else if (pos == CASTLE) {
-                    cout << "x";
-                }
-                else if (pos == FORTRESS) {
-                    cout << "♜";
-                }
-            }
-            else if (piece == KING) {
-                cout << "♕";
-            }
-            else if (piece == SHIELD) {
-                cout << "♦";
-            }
-            else if (piece == SWORD) {
-                cout <<"⚔";
-            }
-            cout << "  ║";
-        }
-        if (line != SIZE-1) {
-            cout<< endl << "   ╬";
-        }
-        else {
-            cout<< endl << "   ╩";
-        }
-        for (int column = 0 ; column<SIZE ; column++ ) {
-            if (column != SIZE-1 && line != SIZE-1) {
-                cout << "═════╬";
-            }
-            else if (column == SIZE-1 && line != SIZE-1) {
-                cout << "═════╣";
-            }
-            else if (column != SIZE-1 && line == SIZE-1) {
-                cout <<"═════╩";
-            }
-            else {
-                cout <<"═════╝";
-            }
+/**
+ * @brief Puts the board in the starting layout, then builds its bitboards and its key (ATTACK to move).
+ *
+ * The cell types and the pieces are constants of the engine, so the loops only copy them.
+ *
+ * @param aBoard The board (`itsCells` allocated, `itsSize` equal to `SIZE`).
+ */
+template <int SIZE>
+void Engine<SIZE>::initialize(Board& aBoard) {
+    for (int line = 0 ; line < SIZE ; line++) {
+        for (int column = 0 ; column < SIZE ; column++) {
+            aBoard.itsCells[line][column].itsCellType = cellType(line, column);
+            aBoard.itsCells[line][column].itsPieceType = startingPiece(line, column);
         }
-        cout << endl;
     }
+    //build the masks used by the hot functions and the key of the starting position
+    updateBitboards(aBoard);
+    aBoard.itsHash = computeHash(aBoard, ATTACK);
 }
 
 /**
@@ -324,88 +387,140 @@ void displayBoard(const Board& aBoard) {
  * shields (12 defenders), and swords (24 attackers) based on board size.
  *
  * @param aBoard The board object to initialize (`itsCells` must be allocated, `itsSize` must be set).
- * @note Adjusts piece positions for LITTLE (11x11) vs BIG (13x13) boards.
+ * @note The layouts of LITTLE (11x11) and BIG (13x13) boards are generated at compile time
+ *       (see `Engine::startingPiece()`), a board of another size is left unchanged.
+ *       Also builds the bitboards and `itsHash` (ATTACK to move).
  */
 void initializeBoard(Board& aBoard) {
-    const int SIZE = aBoard .itsSize;
-    const int BIG_CENTER = 6 , LITTLE_CENTER = 5;
-    //set cellType and set piece to NONE
-    for (int line = 0 ; line < SIZE ; line++) {
-        for (int column = 0 ; column < SIZE ; column++) {
-            //test if the coords exist
-            if (aBoard.itsCells != nullptr){
-                //set castle and king in center
-                if (line == SIZE/2 && column == SIZE/2) {
-                    aBoard.itsCells[line][column].itsCellType  = CASTLE;
-                    aBoard.itsCells[line][column].itsPieceType = KING;
-                }
-                //set fortress in corners
-                else if ((line == 0 || line == SIZE-1 ) && (column== 0 || column == SIZE-1 )){
-                    aBoard.itsCells[line][column].itsCellType  = FORTRESS;
-                    aBoard.itsCells[line][column].itsPieceType = NONE;
-                }
-                //set all the other pieces at normal case and none piece
-                else {
-                    aBoard.itsCells[line][column].itsCellType  = NORMAL;
-                    aBoard.itsCells[line][column].itsPieceType = NONE;
-                }
-            }
-        }
+    //test if the cells exist
+    if (aBoard.itsCells == nullptr) {
+        return;
     }
-    //set all the piece type
-    //test the size before the loop (checking one time)
-    if (SIZE == 11) {
-        for (int line = 0 ; line < SIZE ; line++) {
-            for (int column = 0 ; column < SIZE; column++) {
-                if (aBoard.itsCells != nullptr){
-                    //place the shields around the king
-                    if (line == LITTLE_CENTER && column != LITTLE_CENTER && column >= LITTLE_CENTER-2 && column <= LITTLE_CENTER+2) {
-                        aBoard.itsCells[line][column].itsPieceType = SHIELD;
-                        //place the invert coords pieces for optimisation
-                        aBoard.itsCells[column][line].itsPieceType = SHIELD;
-                    }
-                    //place shields on the diagonals of the king
-                    if ((line == LITTLE_CENTER-1 || line == LITTLE_CENTER +1) && (column == LITTLE_CENTER-1 || column == LITTLE_CENTER+1)) {
-                        aBoard.itsCells[line][column].itsPieceType = SHIELD;
-                    }
-
-                    //place the swords on the board
-                    if ((line == 0 || line == SIZE -1 )&& column > 2 && column < 8) {
-                        aBoard.itsCells[line][column].itsPieceType = SWORD;
-                        aBoard.itsCells[column][line].itsPieceType = SWORD;
-                    }
-
-                    if (line == LITTLE_CENTER && (column == 1 || column == 9)) {
-                        aBoard.itsCells[line][column].itsPieceType = SWORD;
-                        aBoard.itsCells[column][line].itsPieceType = SWORD;
-                    }
-                }
-            }
+    if (aBoard.itsSize == LITTLE) {
+        Engine<LITTLE>::initialize(aBoard);
+    }
+    else if (aBoard.itsSize == BIG) {
+        Engine<BIG>::initialize(aBoard);
+    }
+}
+
+/**
+ * @brief Recomputes the cached game status from the king index and the piece counts.
+ *
+ * The encirclement test stops at the first free cell next to the group of the KING,
+ * so it is cheap enough to be called after every change of the board.
+ *
+ * @param aBoard The board to update (`itsKingIndex` and `itsPieceCounts` must be synchronized).
+ */
+static void updateGameStatus(Board& aBoard) {
+    const int SIZE = aBoard.itsSize;
+    const int KING = aBoard.itsKingIndex;
+    //the king and its shields fully surrounded (includes the simple capture)
+    if (KING != -1 && isKingCapturedRecursive(aBoard, {KING / SIZE, KING % SIZE})) {
+        aBoard.itsStatus = KING_CAPTURED;
+        return;
+    }
+    if (aBoard.itsPieceCounts[SWORD] == 0) {
+        aBoard.itsStatus = NO_SWORD_LEFT;
+    }
+    else if (KING != -1 && aBoard.itsCells[KING / SIZE][KING % SIZE].itsCellType == FORTRESS) {
+        aBoard.itsStatus = KING_ESCAPED;
+    }
+    else {
+        aBoard.itsStatus = IN_PROGRESS;
+    }
+}
+
+/**
+ * @brief Rebuilds the bitboards of the board from its cells.
+ *
+ * Fills one mask per piece type (SHIELD, SWORD, KING) and per special cell type (FORTRESS, CASTLE)
+ * with `scanBoardMasks()`, counts the pieces, finds the KING and computes the game status,
+ * then sets `itsHasBitboards` so the hot functions use them instead of scanning `itsCells`.
+ *
+ * @param aBoard The board to update (`itsCells` must be allocated, `itsSize` must be set).
+ * @note Called by `initializeBoard()`. Call it again after editing `itsCells` directly.
+ */
+void updateBitboards(Board& aBoard) {
+    const int SIZE = aBoard.itsSize;
+    //a 192 bits mask can't hold more than a BIG board
+    if (aBoard.itsCells == nullptr || SIZE <= 0 || SIZE > BIG) {
+        aBoard.itsHasBitboards = false;
+        return;
+    }
+    //one SIMD pass over the cells (see evalfeatures.h), then the counts come from the masks
+    scanBoardMasks(aBoard, aBoard.itsPieceMasks, aBoard.itsCellMasks);
+    for (int piece = 0 ; piece < 4 ; piece++) {
+        aBoard.itsPieceCounts[piece] = (piece == NONE) ? 0 : countBits(aBoard.itsPieceMasks[piece]);
+    }
+    //keep the first king found, like getKingPosition
+    aBoard.itsKingIndex = firstBit(aBoard.itsPieceMasks[KING]);
+    updateGameStatus(aBoard);
+    aBoard.itsHasBitboards = true;
+}
+
+/**
+ * @struct ZobristKeys
+ * @brief Fixed random keys used to build `Board::itsHash`.
+ *
+ * One key per cell index and per piece type (the NONE slot is 0) and one key for DEFENSE to move.
+ * The table is generated at compile time (splitmix64), so keys are the same in every run.
+ */
+struct ZobristKeys
+{
+    uint64_t itsPieceKeys[BIG * BIG][4] = {};
+    uint64_t itsSideKey = 0;
+};
+
+/**
+ * @brief Generates the Zobrist keys.
+ *
+ * @return The filled table.
+ */
+static constexpr ZobristKeys buildZobristKeys() {
+    ZobristKeys keys;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    //splitmix64 step
+    auto next = [&state]() {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for (int index = 0 ; index < BIG * BIG ; index++) {
+        for (int piece = SHIELD ; piece <= KING ; piece++) {
+            keys.itsPieceKeys[index][piece] = next();
         }
     }
-    else if (SIZE == 13) {
-        for (int line = 0 ; line < SIZE ; line++) {
-            for (int column = 0 ; column < SIZE; column++) {
-                if (aBoard.itsCells != nullptr){
-                    //place the shields around the king
-                    if (line == BIG_CENTER && column != BIG_CENTER && column >= BIG_CENTER-3 && column <= BIG_CENTER+3) {
-                        aBoard.itsCells[line][column].itsPieceType = SHIELD;
-                        //place the invert coords pieces for optimisation
-                        aBoard.itsCells[column][line].itsPieceType = SHIELD;
-                    }
-                    //place the swords on the board
-                    if ((line == 0 || line == SIZE -1 )&& column > 3 && column < 9) {
-                        aBoard.itsCells[line][column].itsPieceType = SWORD;
-                        aBoard.itsCells[column][line].itsPieceType = SWORD;
-                    }
-                    if (line == BIG_CENTER && (column == 1 || column == 11)) {
-                        aBoard.itsCells[line][column].itsPieceType = SWORD;
-                        aBoard.itsCells[column][line].itsPieceType = SWORD;
-                    }
-                }
-            }
+    keys.itsSideKey = next();
+    return keys;
+}
+
+static constexpr ZobristKeys ZOBRIST = buildZobristKeys();
+
+/**
+ * @brief Computes the Zobrist key of a position from scratch.
+ *
+ * XORs one fixed random key per (cell, piece) and a side key when DEFENSE is to move.
+ * Only used to (re)initialize `itsHash`; the other functions update it incrementally.
+ *
+ * @param aBoard The board to read (`itsCells` must be allocated).
+ * @param aRoleToMove The role of the player to move.
+ * @return The 64-bit key of the position.
+ */
+uint64_t computeHash(const Board& aBoard, PlayerRole aRoleToMove) {
+    const int SIZE = aBoard.itsSize;
+    uint64_t hash = (aRoleToMove == DEFENSE) ? ZOBRIST.itsSideKey : 0;
+    if (aBoard.itsCells == nullptr || SIZE <= 0 || SIZE > BIG) {
+        return hash;
+    }
+    for (int line = 0 ; line < SIZE ; line++) {
+        for (int column = 0 ; column < SIZE ; column++) {
+            hash ^= ZOBRIST.itsPieceKeys[cellIndex(line, column, SIZE)][aBoard.itsCells[line][column].itsPieceType];
         }
     }
+    return hash;
 }
 
 // ============================================================================
@@ -498,6 +613,96 @@ bool isEmptyCell(const Board& aBoard, const Position& aPos) {
 // SECTION 4: MOVEMENT & ACTIONS
 // ============================================================================
 
+/**
+ * @brief Reads a cell as its packed byte.
+ *
+ * NORMAL and NONE are both 0, so the byte is 0 only for an empty NORMAL cell.
+ *
+ * @param aCell The cell to read.
+ * @return The byte holding the cell type and the piece type.
+ */
+static inline unsigned char cellByte(const Cell& aCell) {
+    unsigned char byte;
+    memcpy(&byte, &aCell, sizeof(byte));
+    return byte;
+}
+
+/**
+ * @brief Checks a move for the current player without printing anything.
+ *
+ * @param aGame Current game state (board of size `SIZE`).
+ * @param aMove The move to validate.
+ * @return `VALID_MOVE` if the move is valid, the reason of the rejection otherwise.
+ */
+template <int SIZE>
+MoveStatus Engine<SIZE>::checkMovement(const Game& aGame, const Move& aMove) {
+    //pieces owned by each role, indexed by [PlayerRole][PieceType]
+    static constexpr bool OWNED_PIECES[2][4] = {{false, false, true, false}, {false, true, false, true}};
+    const Board& board = aGame.itsBoard;
+    const Position& start = aMove.itsStartPosition;
+    const Position& end = aMove.itsEndPosition;
+    //test if the positions are on the bounds of the board (negative values wrap to huge unsigned values)
+    if ((unsigned(start.itsRow) >= unsigned(SIZE)) | (unsigned(start.itsCol) >= unsigned(SIZE)) |
+        (unsigned(end.itsRow) >= unsigned(SIZE)) | (unsigned(end.itsCol) >= unsigned(SIZE))) {
+        return OUT_OF_BOUNDS;
+    }
+    //test if player try to moove a right piece
+    const PieceType PIECE = board.itsCells[start.itsRow][start.itsCol].itsPieceType;
+    if (!OWNED_PIECES[aGame.itsCurrentPlayer->itsRole][PIECE]) {
+        return WRONG_PIECE;
+    }
+    //test if a other piece than king try to escape or enter in castle
+    const Cell END_CELL = board.itsCells[end.itsRow][end.itsCol];
+    if ((PIECE != KING) & (END_CELL.itsCellType != NORMAL)) {
+        return SPECIAL_CELL;
+    }
+    const int DELTA_ROW = end.itsRow - start.itsRow;
+    const int DELTA_COL = end.itsCol - start.itsCol;
+    if ((DELTA_ROW == 0) & (DELTA_COL == 0)) {
+        return NO_MOVEMENT;
+    }
+    if ((DELTA_ROW != 0) & (DELTA_COL != 0)) {
+        return NOT_STRAIGHT;
+    }
+    //the end cell must be empty
+    if (END_CELL.itsPieceType != NONE) {
+        return BLOCKED;
+    }
+    //accumulate the cells strictly between start and end: any piece or special cell blocks
+    const int STEP_ROW = (DELTA_ROW > 0) - (DELTA_ROW < 0);
+    const int STEP_COL = (DELTA_COL > 0) - (DELTA_COL < 0);
+    const int LENGTH = abs(DELTA_ROW + DELTA_COL);
+    unsigned char blockers = 0;
+    for (int i = 1 ; i < LENGTH ; i++) {
+        blockers |= cellByte(board.itsCells[start.itsRow + i*STEP_ROW][start.itsCol + i*STEP_COL]);
+    }
+    return blockers == 0 ? VALID_MOVE : BLOCKED;
+}
+
+/**
+ * @brief Checks a move for the current player without printing anything.
+ *
+ * Validates, in this order: board bounds, piece ownership (SWORD for ATTACK, SHIELD/KING for DEFENSE),
+ * special cell restrictions (only KING can finish on FORTRESS/CASTLE), horizontal/vertical movement only,
+ * and a free path (no piece or special cell crossed, empty end cell).
+ *
+ * @param aGame Current game state (player, board).
+ * @param aMove The move to validate (start and end positions).
+ * @return `VALID_MOVE` if the move is valid, the reason of the rejection otherwise.
+ * @note The text of the errors is displayed by `playGame()` only.
+ *       Every move is `OUT_OF_BOUNDS` on boards other than LITTLE or BIG.
+ */
+MoveStatus checkMovement(const Game& aGame, const Move& aMove) {
+    switch (aGame.itsBoard.itsSize) {
+        case LITTLE:
+            return Engine<LITTLE>::checkMovement(aGame, aMove);
+        case BIG:
+            return Engine<BIG>::checkMovement(aGame, aMove);
+        default:
+            return OUT_OF_BOUNDS;
+    }
+}
+
 /**
  * @brief Checks if a move is valid for the current player.
  *
@@ -508,177 +713,434 @@ bool isEmptyCell(const Board& aBoard, const Position& aPos) {
  * @param aGame Current game state (player, board).
  * @param aMove The move to validate (start and end positions).
  * @return `true` if move is valid, `false` otherwise.
+ * @note Prints nothing, use `checkMovement()` to know why a move is rejected.
  */
 bool isValidMovement(const Game& aGame, const Move& aMove) {
+    PROFILE_SCOPE(PROFILE_VALID_MOVEMENT);
+    return checkMovement(aGame, aMove) == VALID_MOVE;
+}
+
+/**
+ * @brief Moves a piece on the board.
+ *
+ * Transfers piece from start position to end position. Clears start cell (sets to NONE).
+ * Cell types (NORMAL, FORTRESS, CASTLE) remain unchanged.
+ *
+ * @param aGame Current game state.
+ * @param aMove The move to execute (start and end positions).
+ * @note Assumes move is valid. Use `isValidMovement()` first to validate.
+ *       Keeps the bitboards, the piece counts, the game status and `itsHash` synchronized.
+ */
+void movePiece(Game& aGame, const Move& aMove) {
+    PROFILE_SCOPE(PROFILE_MOVE_PIECE);
+    PieceType piece = aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType; //stock a piece on variable
+    aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType = NONE; //set the 1st selected position piece as NONE
+    aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow][aMove.itsEndPosition.itsCol].itsPieceType = piece; //replace the 2nd selected position with stocked piece
+    //keep the masks and the key synchronized with the cells
     const int SIZE = aGame.itsBoard.itsSize;
-    Player *player=aGame.itsCurrentPlayer;
-    //test if the position is on the bounds of the board
-    if (aMove.itsEndPosition.itsRow < 0 || aMove.itsEndPosition.itsRow >= SIZE || aMove.itsEndPosition.itsCol < 0 || aMove.itsEndPosition.itsCol >= SIZE ||
-        aMove.itsStartPosition.itsRow<0 ||aMove.itsStartPosition.itsRow >=SIZE || aMove.itsStartPosition.itsCol < 0 || aMove.itsStartPosition.itsCol >=SIZE)
-    {
-        cout << "Error : ";
-        cerr << "Selection is out of bounds" <<endl ;
-        return false;
-    }
-    //test if player try to moove a right piece
-    if (player->itsRole == ATTACK && aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType != SWORD )
-    {
-        cout << "Error : ";
-        cerr << "Attack c'ant moove other pieces than SWORD" << endl;
-        return false;
+    const int START = cellIndex(aMove.itsStartPosition.itsRow, aMove.itsStartPosition.itsCol, SIZE);
+    const int END = cellIndex(aMove.itsEndPosition.itsRow, aMove.itsEndPosition.itsCol, SIZE);
+    aGame.itsBoard.itsHash ^= ZOBRIST.itsPieceKeys[START][piece] ^ ZOBRIST.itsPieceKeys[END][piece];
+    if (aGame.itsBoard.itsHasBitboards && piece != NONE) {
+        clearBit(aGame.itsBoard.itsPieceMasks[piece], START);
+        setBit(aGame.itsBoard.itsPieceMasks[piece], END);
+        if (piece == KING) {
+            aGame.itsBoard.itsKingIndex = END;
+        }
     }
-    if (player->itsRole == DEFENSE && (aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType == SWORD
-       || aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType == NONE ))
-    {
-        cout << "Error : ";
-        cerr << "DEFENCE can only moove SHIELD and the KING" <<endl;
-        return false;
+    if (aGame.itsBoard.itsHasBitboards) {
+        updateGameStatus(aGame.itsBoard);
     }
+}
+/**
+ * @struct CaptureTable
+ * @brief Precomputed neighbors and anvils of every cell of a board.
+ *
+ * For each cell (indexed by `cellIndex()`) and each direction (west, east, north, south),
+ * stores the neighbor that can be captured and the cell behind it (the anvil).
+ * A direction is only usable if both are on the board: the border is never an anvil.
+ */
+struct CaptureTable
+{
+    unsigned char itsDirections[BIG * BIG];    /**< Bit d set if the neighbor and the anvil of direction d are on the board. */
+    unsigned char itsNeighbors[BIG * BIG][4];  /**< `cellIndex()` of the neighbor of each direction. */
+    unsigned char itsAnvils[BIG * BIG][4];     /**< `cellIndex()` of the cell behind the neighbor. */
+    unsigned char itsOffsets[BIG * BIG];       /**< Offset of each cell from `itsCells[0][0]` (rows are `BIG` cells wide). */
+};
 
-    //test if a other piece than king try to escape or enter in castle
-    if  (aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType !=KING &&
-        (aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow][aMove.itsEndPosition.itsCol].itsCellType == FORTRESS ||
-         aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow][aMove.itsEndPosition.itsCol].itsCellType == CASTLE)) {
-        cout << "Error : ";
-        cerr << "Only King can escape or go in castle" << endl;
-        return false;
+/**
+ * @brief Builds the capture table of a board size (evaluated at compile time).
+ *
+ * @param aSize The size of the board.
+ * @return The filled table.
+ */
+static constexpr CaptureTable buildCaptureTable(int aSize) {
+    constexpr Position DIRECTIONS[4] = {{0,-1},{0,1},{-1,0},{1,0}};
+    CaptureTable table = {};
+    for (int line = 0 ; line < aSize ; line++) {
+        for (int col = 0 ; col < aSize ; col++) {
+            const int INDEX = cellIndex(line, col, aSize);
+            table.itsOffsets[INDEX] = line * BIG + col;
+            for (int dir = 0 ; dir < 4 ; dir++) {
+                //the anvil is 2 cells away, if it is on the board the neighbor is too
+                const int ANVIL_ROW = line + 2*DIRECTIONS[dir].itsRow;
+                const int ANVIL_COL = col + 2*DIRECTIONS[dir].itsCol;
+                if (ANVIL_ROW >= 0 && ANVIL_ROW < aSize && ANVIL_COL >= 0 && ANVIL_COL < aSize) {
+                    table.itsDirections[INDEX] |= 1 << dir;
+                    table.itsNeighbors[INDEX][dir] = cellIndex(line + DIRECTIONS[dir].itsRow, col + DIRECTIONS[dir].itsCol, aSize);
+                    table.itsAnvils[INDEX][dir] = cellIndex(ANVIL_ROW, ANVIL_COL, aSize);
+                }
+            }
         }
-
-    if (aMove.itsEndPosition.itsCol == aMove.itsStartPosition.itsCol &&  aMove.itsEndPosition.itsRow == aMove.itsStartPosition.itsRow) {
-        return false;
     }
-    int min,max;
-    //test the movement on columns
-    if (aMove.itsEndPosition.itsCol == aMove.itsStartPosition.itsCol) {
-        if (aMove.itsStartPosition.itsRow < aMove.itsEndPosition.itsRow) {
-            min = aMove.itsStartPosition.itsRow;
-            max = aMove.itsEndPosition.itsRow;
-        }
-        else {
-            max = aMove.itsStartPosition.itsRow;
-            min = aMove.itsEndPosition.itsRow;
+    return table;
+}
+
+/**
+ * @brief Capture table of each board size.
+ */
+template <int SIZE>
+static constexpr CaptureTable CAPTURES = buildCaptureTable(SIZE);
+
+/**
+ * @brief Removes the pieces captured by a move.
+ *
+ * @param aGame Current game state (board of size `SIZE`).
+ * @param aMove The executed move.
+ * @return The captured neighbors, bit d set for direction d (west, east, north, south).
+ */
+template <int SIZE>
+int Engine<SIZE>::capturePieces(Game& aGame, const Move& aMove) {
+    //pieces used as anvil by each role, indexed by [PlayerRole][PieceType]
+    static constexpr bool ANVIL_PIECES[2][4] = {{false, false, true, false}, {false, true, false, true}};
+    Board& board = aGame.itsBoard;
+    constexpr const CaptureTable& TABLE = CAPTURES<SIZE>;
+    const PlayerRole ROLE = aGame.itsCurrentPlayer->itsRole;
+    const PieceType ENEMY = (ROLE == ATTACK) ? SHIELD : SWORD;
+    const int END = cellIndex(aMove.itsEndPosition.itsRow, aMove.itsEndPosition.itsCol, SIZE);
+    const unsigned char* neighbors = TABLE.itsNeighbors[END];
+    const unsigned char* anvils = TABLE.itsAnvils[END];
+    Cell* cells = board.itsCells[0];
+    int captured = 0;
+    if (board.itsHasBitboards) {
+        //anvils: the pieces of the role, the fortresses and the empty castles
+        const BitBoard OCCUPIED = maskOr(maskOr(board.itsPieceMasks[SHIELD], board.itsPieceMasks[SWORD]), board.itsPieceMasks[KING]);
+        BitBoard anvilMask = maskOr(board.itsPieceMasks[(ROLE == ATTACK) ? SWORD : SHIELD], board.itsCellMasks[FORTRESS]);
+        for (int word = 0 ; word < WORDS ; word++) {
+            anvilMask.itsWords[word] |= board.itsCellMasks[CASTLE].itsWords[word] & ~OCCUPIED.itsWords[word];
         }
-        //test if the end case is empty
-        if (aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType != NONE) {
-            return false;
+        if (ROLE == DEFENSE) {
+            anvilMask = maskOr(anvilMask, board.itsPieceMasks[KING]);
         }
-        //loop for test in the row if a piece block
-        for (int i = min+1 ; i <= max ; i++) {
-            if (aGame.itsBoard.itsCells[i][aMove.itsStartPosition.itsCol].itsPieceType != NONE
-                || aGame.itsBoard.itsCells[i][aMove.itsStartPosition.itsCol].itsCellType != NORMAL) {
-                cout << "Error : ";
-                cerr << "A piece block the movement in :" << char('A'+i) <<  aMove.itsStartPosition.itsCol << endl;
-                return false;
+        for (int dir = 0 ; dir < 4 ; dir++) {
+            if ((TABLE.itsDirections[END] >> dir & 1) && testBit(board.itsPieceMasks[ENEMY], neighbors[dir]) && testBit(anvilMask, anvils[dir])) {
+                captured |= 1 << dir;
             }
         }
     }
-    else if (aMove.itsEndPosition.itsRow == aMove.itsStartPosition.itsRow) {
-        if (aMove.itsStartPosition.itsCol < aMove.itsEndPosition.itsCol) {
-            min = aMove.itsStartPosition.itsCol;
-            max = aMove.itsEndPosition.itsCol;
-        }
-        else {
-            max = aMove.itsStartPosition.itsCol;
-            min = aMove.itsEndPosition.itsCol;
+    else {
+        for (int dir = 0 ; dir < 4 ; dir++) {
+            if ((TABLE.itsDirections[END] >> dir & 1) && cells[TABLE.itsOffsets[neighbors[dir]]].itsPieceType == ENEMY) {
+                const Cell ANVIL = cells[TABLE.itsOffsets[anvils[dir]]];
+                if (ANVIL_PIECES[ROLE][ANVIL.itsPieceType] || ANVIL.itsCellType == FORTRESS
+                    || (ANVIL.itsCellType == CASTLE && ANVIL.itsPieceType == NONE)) {
+                    captured |= 1 << dir;
+                }
+            }
         }
-        for (int i = min+1 ; i<= max ; i++) {
-            if (aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][i].itsPieceType != NONE
-                || aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][i].itsCellType != NORMAL) {
-                cout << "Error : ";
-                cerr << "A piece block the movement in : "  << char('A' + aMove.itsStartPosition.itsRow) << i << endl;
-                return false;
+    }
+    //remove the captured pieces once all the directions are tested
+    for (int dir = 0 ; dir < 4 ; dir++) {
+        if (captured & (1 << dir)) {
+            const int INDEX = neighbors[dir];
+            cells[TABLE.itsOffsets[INDEX]].itsPieceType = NONE;
+            board.itsHash ^= ZOBRIST.itsPieceKeys[INDEX][ENEMY];
+            if (board.itsHasBitboards) {
+                clearBit(board.itsPieceMasks[ENEMY], INDEX);
+                board.itsPieceCounts[ENEMY]--;
             }
         }
-
     }
-    else {
-        return false;
+    //a capture can free the king or remove the last sword
+    if (board.itsHasBitboards) {
+        updateGameStatus(board);
     }
-    return true;
+    return captured;
 }
 
-/**
- * @brief Moves a piece on the board.
- *
- * Transfers piece from start position to end position. Clears start cell (sets to NONE).
- * Cell types (NORMAL, FORTRESS, CASTLE) remain unchanged.
- *
- * @param aGame Current game state.
- * @param aMove The move to execute (start and end positions).
- * @note Assumes move is valid. Use `isValidMovement()` first to validate.
- */
-void movePiece(Game& aGame, const Move& aMove) {
-    PieceType piece = aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType; //stock a piece on variable
-    aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType = NONE; //set the 1st selected position piece as NONE
-    aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow][aMove.itsEndPosition.itsCol].itsPieceType = piece; //replace the 2nd selected position with stocked piece
-}
 /**
  * @brief Removes captured pieces from the board.
  *
  * Checks all 4 cardinal directions from move end position. Applies capture rules:
  * - ATTACK captures SHIELD when sandwiched between SWORD/FORTRESS/empty CASTLE
  * - DEFENSE captures SWORD when sandwiched between SHIELD/KING/FORTRESS/CASTLE
+ * The border of the board is not hostile: a piece against the border can't be captured from the other side.
+ * Neighbors and anvils come from a table built at compile time for each size; with bitboards, the enemies and
+ * the anvils are masks and each direction is two bit tests.
  *
  * @param aGame Current game state.
  * @param aMove The executed move (uses end position for capture check).
+ * @return The captured neighbors, bit d set for direction d (west, east, north, south, as `MoveUndo`).
  * @note Assumes move already validated and executed. Modifies board to remove captured pieces.
+ *       Keeps the bitboards, the piece counts, the game status and `itsHash` synchronized.
+ *       Nothing is captured on boards other than LITTLE or BIG.
  */
-void capturePieces(Game& aGame, const Move& aMove) {
+int capturePieces(Game& aGame, const Move& aMove) {
+    PROFILE_SCOPE(PROFILE_CAPTURE_PIECES);
+    switch (aGame.itsBoard.itsSize) {
+        case LITTLE:
+            return Engine<LITTLE>::capturePieces(aGame, aMove);
+        case BIG:
+            return Engine<BIG>::capturePieces(aGame, aMove);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Plays a move and records how to undo it.
+ *
+ * @param aGame Current game state (board of size `SIZE`).
+ * @param aMove The move to play (must be valid).
+ * @return The undo record to give to `unmakeMove()`.
+ */
+template <int SIZE>
+MoveUndo Engine<SIZE>::makeMove(Game& aGame, const Move& aMove) {
+    MoveUndo undo;
+    undo.itsMove = aMove;
+    undo.itsMovedPiece = aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType;
+    undo.itsCapturedPiece = (aGame.itsCurrentPlayer->itsRole == ATTACK) ? SHIELD : SWORD;
+    undo.itsPreviousPlayer = aGame.itsCurrentPlayer;
+    movePiece(aGame, aMove);
+    //capturePieces gives the captured directions in the order of the undo mask
+    undo.itsCapturedMask = static_cast<unsigned char>(capturePieces(aGame, aMove));
+    switchCurrentPlayer(aGame);
+    return undo;
+}
+
+/**
+ * @brief Plays a move and records how to undo it.
+ *
+ * Calls `movePiece()`, `capturePieces()` and `switchCurrentPlayer()`, and records the moved piece,
+ * the captured neighbors and the previous current player. No allocation, no board copy.
+ *
+ * @param aGame Current game state.
+ * @param aMove The move to play (must be valid).
+ * @return The undo record to give to `unmakeMove()`.
+ * @note On boards other than LITTLE or BIG, the piece is moved and the player switched, nothing is captured.
+ */
+MoveUndo makeMove(Game& aGame, const Move& aMove) {
+    switch (aGame.itsBoard.itsSize) {
+        case LITTLE:
+            return Engine<LITTLE>::makeMove(aGame, aMove);
+        case BIG:
+            return Engine<BIG>::makeMove(aGame, aMove);
+        default:
+            break;
+    }
+    MoveUndo undo;
+    undo.itsMove = aMove;
+    undo.itsMovedPiece = aGame.itsBoard.itsCells[aMove.itsStartPosition.itsRow][aMove.itsStartPosition.itsCol].itsPieceType;
+    undo.itsCapturedPiece = (aGame.itsCurrentPlayer->itsRole == ATTACK) ? SHIELD : SWORD;
+    undo.itsPreviousPlayer = aGame.itsCurrentPlayer;
+    movePiece(aGame, aMove);
+    switchCurrentPlayer(aGame);
+    return undo;
+}
+
+/**
+ * @brief Restores the game state as it was before a `makeMove()`.
+ *
+ * Gives the captured pieces back, moves the piece back to its start position
+ * and restores the current player. Bitboards are kept synchronized.
+ *
+ * @param aGame Current game state (must be the state right after the matching `makeMove()`).
+ * @param anUndo The record returned by `makeMove()`.
+ */
+void unmakeMove(Game& aGame, const MoveUndo& anUndo) {
+    constexpr Position AROUND_CELLS[4] = {{0,-1},{0,1},{-1,0},{1,0}};
     const int SIZE = aGame.itsBoard.itsSize;
-    //constexpr is initialized when compiling
-    constexpr Position aroundCells[4] = {{0,-1},{0,1},{-1,0},{1,0}};
-    //for defense
-    if (aGame.itsCurrentPlayer->itsRole == DEFENSE) {
-        //for each loop for test the 4 cells around the moove
-        for (Position arroundCell : aroundCells ) {
-            //test if the tested cell is in bounds
-            if ((aMove.itsEndPosition.itsRow + arroundCell.itsRow) >= 0 && aMove.itsEndPosition.itsRow + arroundCell.itsCol <SIZE &&
-                aMove.itsEndPosition.itsCol + arroundCell.itsCol >= 0 && aMove.itsEndPosition.itsCol + arroundCell.itsCol <SIZE){
-                //test if the tested cell contain a SWORD
-                if (aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +arroundCell.itsRow][aMove.itsEndPosition.itsCol +arroundCell.itsCol].itsPieceType==SWORD){
-                    //test all capture condition
-                    if (aMove.itsEndPosition.itsRow + arroundCell.itsRow == 0 || aMove.itsEndPosition.itsRow + arroundCell.itsCol == SIZE-1 ||
-                        aMove.itsEndPosition.itsCol + arroundCell.itsCol == 0 || aMove.itsEndPosition.itsRow + arroundCell.itsCol == SIZE-1 ||
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsPieceType== SHIELD ||
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsPieceType== KING ||
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsCellType == FORTRESS ||
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsCellType == CASTLE &&
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsPieceType== NONE) {
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +arroundCell.itsRow][aMove.itsEndPosition.itsCol +arroundCell.itsCol].itsPieceType = NONE;
-                    }
+    const Position& start = anUndo.itsMove.itsStartPosition;
+    const Position& end = anUndo.itsMove.itsEndPosition;
+    //give the captured pieces back
+    for (int dir = 0 ; dir < 4 ; dir++) {
+        if (anUndo.itsCapturedMask & (1 << dir)) {
+            const int ROW = end.itsRow + AROUND_CELLS[dir].itsRow;
+            const int COL = end.itsCol + AROUND_CELLS[dir].itsCol;
+            const int INDEX = cellIndex(ROW, COL, SIZE);
+            aGame.itsBoard.itsCells[ROW][COL].itsPieceType = anUndo.itsCapturedPiece;
+            aGame.itsBoard.itsHash ^= ZOBRIST.itsPieceKeys[INDEX][anUndo.itsCapturedPiece];
+            if (aGame.itsBoard.itsHasBitboards) {
+                setBit(aGame.itsBoard.itsPieceMasks[anUndo.itsCapturedPiece], INDEX);
+                aGame.itsBoard.itsPieceCounts[anUndo.itsCapturedPiece]++;
+            }
+        }
+    }
+    //move the piece back (movePiece keeps the masks and the status synchronized)
+    movePiece(aGame, {end, start});
+    if (aGame.itsCurrentPlayer != anUndo.itsPreviousPlayer) {
+        switchCurrentPlayer(aGame);
+    }
+}
+
+/**
+ * @struct RayTable
+ * @brief Precomputed slide rays of every cell of a board.
+ *
+ * For each cell (indexed by `cellIndex()`) and each direction (west, east, north, south),
+ * stores the cells a piece would cross in order, up to the border.
+ */
+struct RayTable
+{
+    unsigned char itsLength[BIG * BIG][4];           /**< Number of cells of each ray. */
+    unsigned char itsRows[BIG * BIG][4][BIG - 1];    /**< Rows of the cells of each ray. */
+    unsigned char itsCols[BIG * BIG][4][BIG - 1];    /**< Columns of the cells of each ray. */
+};
+
+/**
+ * @brief Builds the ray table of a board size (evaluated at compile time).
+ *
+ * @param aSize The size of the board.
+ * @return The filled table.
+ */
+static constexpr RayTable buildRayTable(int aSize) {
+    constexpr Position DIRECTIONS[4] = {{0,-1},{0,1},{-1,0},{1,0}};
+    RayTable table = {};
+    for (int line = 0 ; line < aSize ; line++) {
+        for (int col = 0 ; col < aSize ; col++) {
+            const int INDEX = cellIndex(line, col, aSize);
+            for (int dir = 0 ; dir < 4 ; dir++) {
+                int length = 0;
+                int row = line + DIRECTIONS[dir].itsRow;
+                int column = col + DIRECTIONS[dir].itsCol;
+                while (row >= 0 && row < aSize && column >= 0 && column < aSize) {
+                    table.itsRows[INDEX][dir][length] = row;
+                    table.itsCols[INDEX][dir][length] = column;
+                    length++;
+                    row += DIRECTIONS[dir].itsRow;
+                    column += DIRECTIONS[dir].itsCol;
                 }
+                table.itsLength[INDEX][dir] = length;
             }
         }
     }
-    //same tests adapted for attack
-    if (aGame.itsCurrentPlayer->itsRole == ATTACK) {
-        for (Position arroundCell : aroundCells ) {
-            //test if the tested cell is in bounds
-            if ((aMove.itsEndPosition.itsRow + arroundCell.itsRow) >= 0 && aMove.itsEndPosition.itsRow + arroundCell.itsCol <SIZE &&
-                aMove.itsEndPosition.itsCol + arroundCell.itsCol >= 0 && aMove.itsEndPosition.itsCol + arroundCell.itsCol <SIZE){
-                //test if the tested cell contain a SHIELD
-                if (aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +arroundCell.itsRow][aMove.itsEndPosition.itsCol +arroundCell.itsCol].itsPieceType==SHIELD){
-                    //test all capture conditions
-                    if (aMove.itsEndPosition.itsRow + arroundCell.itsRow == 0 || aMove.itsEndPosition.itsRow + arroundCell.itsCol == SIZE-1 ||
-                        aMove.itsEndPosition.itsCol + arroundCell.itsCol == 0 || aMove.itsEndPosition.itsRow + arroundCell.itsCol == SIZE-1 ||
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsPieceType==SWORD ||
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsCellType == FORTRESS ||
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsCellType == CASTLE &&
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +2*arroundCell.itsRow][aMove.itsEndPosition.itsCol +2*arroundCell.itsCol].itsPieceType== NONE) {
-                        aGame.itsBoard.itsCells[aMove.itsEndPosition.itsRow +arroundCell.itsRow][aMove.itsEndPosition.itsCol +arroundCell.itsCol].itsPieceType = NONE;
-                    }
+    return table;
+}
+
+/**
+ * @brief Ray table of each board size.
+ */
+template <int SIZE>
+static constexpr RayTable RAYS = buildRayTable(SIZE);
+
+/**
+ * @brief Adds the moves of one piece to a move list.
+ *
+ * @tparam SIZE The size of the board.
+ * @param aBoard The game board.
+ * @param aRow The row of the piece.
+ * @param aCol The column of the piece.
+ * @param aList The list receiving the moves.
+ */
+template <int SIZE>
+static void addPieceMoves(const Board& aBoard, int aRow, int aCol, MoveList& aList) {
+    constexpr const RayTable& RAYS_OF_SIZE = RAYS<SIZE>;
+    const int INDEX = cellIndex(aRow, aCol, SIZE);
+    const bool IS_KING = aBoard.itsCells[aRow][aCol].itsPieceType == KING;
+    for (int dir = 0 ; dir < 4 ; dir++) {
+        const int LENGTH = RAYS_OF_SIZE.itsLength[INDEX][dir];
+        for (int step = 0 ; step < LENGTH ; step++) {
+            const int ROW = RAYS_OF_SIZE.itsRows[INDEX][dir][step];
+            const int COL = RAYS_OF_SIZE.itsCols[INDEX][dir][step];
+            const Cell CELL = aBoard.itsCells[ROW][COL];
+            //a piece stops the slide
+            if (CELL.itsPieceType != NONE) {
+                break;
+            }
+            //special cells stop the slide, only the king can finish on it
+            if (CELL.itsCellType != NORMAL) {
+                if (IS_KING) {
+                    aList.itsMoves[aList.itsCount++] = {{aRow, aCol}, {ROW, COL}};
                 }
+                break;
             }
+            aList.itsMoves[aList.itsCount++] = {{aRow, aCol}, {ROW, COL}};
         }
     }
 }
 
+/**
+ * @brief Generates all the legal moves of the current player.
+ *
+ * @param aGame Current game state (board of size `SIZE`).
+ * @param aList The list receiving the moves (its previous content is discarded).
+ * @return The number of moves generated.
+ */
+template <int SIZE>
+int Engine<SIZE>::generateMoves(const Game& aGame, MoveList& aList) {
+    const Board& board = aGame.itsBoard;
+    aList.itsCount = 0;
+    if (board.itsCells == nullptr) {
+        return 0;
+    }
+    const bool IS_ATTACK = aGame.itsCurrentPlayer->itsRole == ATTACK;
+    if (board.itsHasBitboards) {
+        //walk only the cells of the current player pieces
+        BitBoard pieces = IS_ATTACK ? board.itsPieceMasks[SWORD] : maskOr(board.itsPieceMasks[SHIELD], board.itsPieceMasks[KING]);
+        for (int word = 0 ; word < WORDS ; word++) {
+            uint64_t bits = pieces.itsWords[word];
+            while (bits != 0) {
+                const int INDEX = word * 64 + lowestWordBit(bits);
+                bits &= bits - 1;
+                addPieceMoves<SIZE>(board, INDEX / SIZE, INDEX % SIZE, aList);
+            }
+        }
+    }
+    else {
+        for (int line = 0 ; line < SIZE ; line++) {
+            for (int col = 0 ; col < SIZE ; col++) {
+                const PieceType PIECE = board.itsCells[line][col].itsPieceType;
+                if ((IS_ATTACK && PIECE == SWORD) || (!IS_ATTACK && (PIECE == SHIELD || PIECE == KING))) {
+                    addPieceMoves<SIZE>(board, line, col, aList);
+                }
+            }
+        }
+    }
+    return aList.itsCount;
+}
+
+/**
+ * @brief Generates all the legal moves of the current player.
+ *
+ * Slides every piece of `itsCurrentPlayer` along rays computed at compile time (one per direction and per cell,
+ * for LITTLE and BIG boards) and applies the same rules as `isValidMovement()`:
+ * pieces stop before any piece or special cell, only the KING can finish on a FORTRESS/CASTLE,
+ * and no piece can cross a FORTRESS/CASTLE.
+ *
+ * @param aGame Current game state (player, board).
+ * @param aList The list receiving the moves (its previous content is discarded).
+ * @return The number of moves generated (also stored in `aList.itsCount`).
+ * @note Prints nothing. Returns 0 for board sizes other than LITTLE or BIG.
+ */
+int generateMoves(const Game& aGame, MoveList& aList) {
+    PROFILE_SCOPE(PROFILE_GENERATE_MOVES);
+    switch (aGame.itsBoard.itsSize) {
+        case LITTLE:
+            return Engine<LITTLE>::generateMoves(aGame, aList);
+        case BIG:
+            return Engine<BIG>::generateMoves(aGame, aList);
+        default:
+            aList.itsCount = 0;
+            return 0;
+    }
+}
+
 /**
  * @brief Switches the active player.
  *
  * Toggles between Player1 and Player2 for alternating turns.
  *
- * @param aGame Reference to the Game object (updates `itsCurrentPlayer`).
+ * @param aGame Reference to the Game object (updates `itsCurrentPlayer` and the side key of `itsHash`).
  */
 void switchCurrentPlayer(Game& aGame) {
     if (aGame.itsCurrentPlayer == &aGame.itsPlayer1){
@@ -687,6 +1149,8 @@ void switchCurrentPlayer(Game& aGame) {
     else {
         aGame.itsCurrentPlayer = &aGame.itsPlayer1;
     }
+    //the role to move is part of the key
+    aGame.itsBoard.itsHash ^= ZOBRIST.itsSideKey;
 }
 
 // ============================================================================
@@ -702,6 +1166,9 @@ void switchCurrentPlayer(Game& aGame) {
  * @return `true` if at least one SWORD exists, `false` if none remain.
  */
 bool isSwordLeft(const Board& aBoard) {
+    if (aBoard.itsHasBitboards) {
+        return aBoard.itsPieceCounts[SWORD] > 0;
+    }
     const int SIZE = aBoard.itsSize;
     for (int line = 0 ; line < SIZE ; line ++) {
         for (int col = 0 ; col < SIZE ; col++) {
@@ -713,6 +1180,34 @@ bool isSwordLeft(const Board& aBoard) {
     return false;
 }
 
+/**
+ * @brief Counts the pieces of a given type on the board.
+ *
+ * Reads the cached count when bitboards are available, scans the board otherwise.
+ *
+ * @param aBoard The game board to check.
+ * @param aPiece The piece type to count (SHIELD, SWORD or KING).
+ * @return The number of pieces of this type, 0 for NONE.
+ */
+int countPieces(const Board& aBoard, PieceType aPiece) {
+    if (aPiece == NONE) {
+        return 0;
+    }
+    if (aBoard.itsHasBitboards) {
+        return aBoard.itsPieceCounts[aPiece];
+    }
+    const int SIZE = aBoard.itsSize;
+    int count = 0;
+    for (int line = 0 ; line < SIZE ; line ++) {
+        for (int col = 0 ; col < SIZE ; col++) {
+            if (aBoard.itsCells[line][col].itsPieceType == aPiece) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
 /**
  * @brief Gets the king's position on the board.
  *
@@ -723,6 +1218,13 @@ bool isSwordLeft(const Board& aBoard) {
  */
 Position getKingPosition(const Board& aBoard) {
     const int SIZE = aBoard.itsSize;
+    if (aBoard.itsHasBitboards) {
+        const int INDEX = aBoard.itsKingIndex;
+        if (INDEX == -1) {
+            return {-1, -1};
+        }
+        return {INDEX / SIZE, INDEX % SIZE};
+    }
     for (int line = 0 ; line < SIZE ; line ++) {
         for (int col = 0 ; col < SIZE ; col++) {
             if (aBoard.itsCells[line][col].itsPieceType==KING) {
@@ -742,6 +1244,9 @@ Position getKingPosition(const Board& aBoard) {
  * @return `true` if king is on a FORTRESS cell, `false` otherwise.
  */
 bool isKingEscaped(const Board& aBoard) {
+    if (aBoard.itsHasBitboards) {
+        return aBoard.itsKingIndex != -1 && testBit(aBoard.itsCellMasks[FORTRESS], aBoard.itsKingIndex);
+    }
     Position kingCoords = getKingPosition(aBoard);
     if (kingCoords.itsRow == -1) {
         return false;
@@ -775,11 +1280,24 @@ bool isKingCapturedSimple(const Board& aBoard) {
             {kingPos.itsRow+1, kingPos.itsCol},
             {kingPos.itsRow-1, kingPos.itsCol}
     };
+    BitBoard hostileMask;
+    if (aBoard.itsHasBitboards) {
+        hostileMask = maskOr(aBoard.itsPieceMasks[SWORD], maskOr(aBoard.itsCellMasks[CASTLE], aBoard.itsCellMasks[FORTRESS]));
+    }
     int count = 0;
     for (auto& cardPoint : kingArounds) {
         if (cardPoint.itsCol < 0 || cardPoint.itsCol >= SIZE || cardPoint.itsRow < 0 || cardPoint.itsRow >=SIZE ) {
             count++;
         }
+        else if (aBoard.itsHasBitboards) {
+            //one mask test instead of three cell reads
+            if (testBit(hostileMask, cellIndex(cardPoint.itsRow, cardPoint.itsCol, SIZE))) {
+                count++;
+            }
+            else {
+                return false;
+            }
+        }
         else if (aBoard.itsCells[cardPoint.itsRow][cardPoint.itsCol].itsPieceType==SWORD ||
             aBoard.itsCells[cardPoint.itsRow][cardPoint.itsCol].itsCellType == CASTLE ||
             aBoard.itsCells[cardPoint.itsRow][cardPoint.itsCol].itsCellType == FORTRESS) {
@@ -796,86 +1314,116 @@ bool isKingCapturedSimple(const Board& aBoard) {
 }
 
 /**
- * @brief Checks if the king is captured (recursive version with escape detection).
+ * @brief Checks if the group of KING and SHIELD pieces of a cell is enclosed.
+ *
+ * @param aBoard The board (size `SIZE`).
+ * @param aStart `cellIndex()` of a KING or SHIELD of the group.
+ * @return `true` if no cell of the group touches an empty NORMAL cell.
+ */
+template <int SIZE>
+bool Engine<SIZE>::isEncircled(const Board& aBoard, int aStart) {
+    //every cell is pushed at most once, so the stack can't hold more than the board
+    constexpr Position AROUND_CELLS[4] = {{0,-1},{0,1},{-1,0},{1,0}};
+    int stack[CELLS];
+    int top = 0;
+    BitBoard visited;
+    stack[top++] = aStart;
+    setBit(visited, stack[0]);
+    while (top > 0) {
+        const int INDEX = stack[--top];
+        for (const Position& dir : AROUND_CELLS) {
+            const int ROW = INDEX / SIZE + dir.itsRow;
+            const int COL = INDEX % SIZE + dir.itsCol;
+            //the border is hostile
+            if (ROW < 0 || ROW >= SIZE || COL < 0 || COL >= SIZE) {
+                continue;
+            }
+            const Cell CELL = aBoard.itsCells[ROW][COL];
+            if (CELL.itsPieceType == KING || CELL.itsPieceType == SHIELD) {
+                //explore the group
+                const int NEXT = cellIndex(ROW, COL, SIZE);
+                if (!testBit(visited, NEXT)) {
+                    setBit(visited, NEXT);
+                    stack[top++] = NEXT;
+                }
+            }
+            else if (CELL.itsPieceType == NONE && CELL.itsCellType == NORMAL) {
+                //a free cell is an escape route
+                return false;
+            }
+        }
+    }
+    //if not escape found the king is captured
+    return true;
+}
+
+/**
+ * @brief Checks if the king is captured (encirclement of the king and its shields).
  *
- * Advanced version: explores SHIELD chains recursively to find escape routes.
- * King captured only if completely blocked with no path to free cells.
- * Automatically manages memory for visited cell tracking.
+ * Flood-fills the group of KING and SHIELD pieces connected to the king (orthogonally)
+ * with an explicit stack and a `BitBoard` of visited cells: no recursion, no allocation.
+ * King captured only if no cell of the group touches a free cell (empty NORMAL cell);
+ * borders, SWORD pieces, FORTRESS and CASTLE cells are hostile.
+ * This includes the simple capture (`isKingCapturedSimple()`) of a king without shields.
  *
  * @param aBoard The game board to check.
- * @param aKingPos Position to check (default {-1,-1} auto-detects king).
- * @param isCellChecked Internal tracking array (default nullptr, auto-initialized).
- * @return `true` if king completely blocked, `false` if escape route exists.
- * @note Advanced version for bonus points. Call with default params: `isKingCapturedRecursive(board)`.
+ * @param aKingPos Position to start from (default {-1,-1} auto-detects king).
+ * @return `true` if the group is completely enclosed, `false` if a free cell is reachable.
+ * @note Always `false` on boards other than LITTLE or BIG.
+ *       Called after every move by the game status update, so encirclement wins the game for ATTACK.
  */
-bool isKingCapturedRecursive(const Board& aBoard, Position aKingPos , bool** isCellChecked) {
+bool isKingCapturedRecursive(const Board& aBoard, Position aKingPos) {
     const int SIZE = aBoard.itsSize;
-    //set the end condition if this is the first function iteration
-    bool endCond = (isCellChecked == nullptr);
     // find king position if not gived (base : {-1,-1})
     if (aKingPos.itsCol == -1) {
-        aKingPos.itsCol = getKingPosition(aBoard).itsCol;
-        aKingPos.itsRow = getKingPosition(aBoard).itsRow;
+        aKingPos = getKingPosition(aBoard);
     }
     // If pos = -1 (king not on the board) return false
-    if (aKingPos.itsCol == -1) {
+    if (aKingPos.itsRow < 0 || aKingPos.itsRow >= SIZE || aKingPos.itsCol < 0 || aKingPos.itsCol >= SIZE) {
         return false;
     }
-    // Allocate the tracking array
-    isCellChecked = new bool *[SIZE];
-    for (int line = 0 ; line < SIZE ; line++){
-        isCellChecked[line] = new bool[SIZE];
-        for (int col = 0; col < SIZE; col++) {
-            isCellChecked[line][col] = false;
-        }
-    }
-    // If the current cell is not a king or shield, it's not a valid escape route
-    if (aBoard.itsCells[aKingPos.itsRow][aKingPos.itsCol].itsPieceType != KING ||
-        aBoard.itsCells[aKingPos.itsRow][aKingPos.itsCol].itsPieceType != SHIELD) {
-        //stop all if is the first iteration
-        if (endCond) {
-            //delocate memory
-            for (int line = 0 ; line <SIZE ; line++) {
-                delete[] isCellChecked[line];
-            }
-            delete[] isCellChecked;
-        }
+    // the start cell must belong to the group (king or shield)
+    const PieceType START = aBoard.itsCells[aKingPos.itsRow][aKingPos.itsCol].itsPieceType;
+    if (START != KING && START != SHIELD) {
         return false;
     }
-    // valid the visited cell
-    isCellChecked[aKingPos.itsRow][aKingPos.itsRow] = true;
-    // Check neighboring cells in all 4 directions
-    Position checkArray[4] = {{0,-1},{0,1},{-1,0},{1,0}};
-    //use a for each loop for all position of the array
-    for (Position pos : checkArray) {
-        //test if position is already checked and if position is in the bounds
-        if (isValidPosition(pos,aBoard) && isCellChecked[pos.itsRow][pos.itsCol] == false ) {
-            //verify if this is not sword (for found a escape)
-            if (aBoard.itsCells[pos.itsRow][pos.itsCol].itsPieceType != SWORD &&
-                aBoard.itsCells[pos.itsRow][pos.itsCol].itsCellType != CASTLE &&
-                aBoard.itsCells[pos.itsRow][pos.itsCol].itsCellType != FORTRESS) {
-                //explore the path (recursive)
-                if(isKingCapturedRecursive(aBoard , pos , isCellChecked) == false) {
-                    if (endCond) {
-                        for (int line = 0 ; line <SIZE ; line++) {
-                            delete[] isCellChecked[line];
-                        }
-                        delete[] isCellChecked;
-                    }
-                    return false;
-                }
-            }
-        }
+    switch (SIZE) {
+        case LITTLE:
+            return Engine<LITTLE>::isEncircled(aBoard, cellIndex(aKingPos.itsRow, aKingPos.itsCol, SIZE));
+        case BIG:
+            return Engine<BIG>::isEncircled(aBoard, cellIndex(aKingPos.itsRow, aKingPos.itsCol, SIZE));
+        default:
+            return false;
     }
-    //if not escape found the king is captured
-    if (endCond) {
-        for (int line = 0 ; line <SIZE ; line++) {
-            delete[] isCellChecked[line];
-        }
-        delete[] isCellChecked;
+}
+
+//the engines of both board sizes, used by the other files (see engine.h)
+template struct Engine<LITTLE>;
+template struct Engine<BIG>;
+
+/**
+ * @brief Gets the state of the game on a board.
+ *
+ * Reads the cached `itsStatus` when the bitboards are synchronized (O(1)),
+ * otherwise uses `isKingCapturedRecursive()`, `isSwordLeft()` and `isKingEscaped()`.
+ *
+ * @param aBoard The game board to check.
+ * @return The status, in the priority order of `whoWon()`.
+ */
+GameStatus getGameStatus(const Board& aBoard) {
+    if (aBoard.itsHasBitboards) {
+        return aBoard.itsStatus;
     }
-    //if the cell is sword (no return before) return true
-    return true;
+    if (isKingCapturedRecursive(aBoard)) {
+        return KING_CAPTURED;
+    }
+    if (!isSwordLeft(aBoard)) {
+        return NO_SWORD_LEFT;
+    }
+    if (isKingEscaped(aBoard)) {
+        return KING_ESCAPED;
+    }
+    return IN_PROGRESS;
 }
 
 /**
@@ -888,10 +1436,8 @@ bool isKingCapturedRecursive(const Board& aBoard, Position aKingPos , bool** isC
  */
 bool isGameFinished(const Game& aGame)
 {
-    if (isKingCapturedSimple(aGame.itsBoard) == true || isKingEscaped(aGame.itsBoard) == true || isSwordLeft(aGame.itsBoard) == false) {
-        return true;
-    }
-    return false;
+    PROFILE_SCOPE(PROFILE_GAME_FINISHED);
+    return getGameStatus(aGame.itsBoard) != IN_PROGRESS;
 }
 
 
@@ -908,16 +1454,15 @@ bool isGameFinished(const Game& aGame)
  */
 const Player* whoWon(const Game& aGame)
 {
-    if (isKingCapturedSimple(aGame.itsBoard) == true) {
-        return &aGame.itsPlayer1;
+    switch (getGameStatus(aGame.itsBoard)) {
+        case KING_CAPTURED:
+            return &aGame.itsPlayer1;
+        case NO_SWORD_LEFT:
+        case KING_ESCAPED:
+            return &aGame.itsPlayer2;
+        default:
+            return nullptr;
     }
-    if (isSwordLeft(aGame.itsBoard) == false) {
-        return &aGame.itsPlayer2;
-    }
-    if (isKingEscaped(aGame.itsBoard) == true) {
-        return &aGame.itsPlayer2;
-    }
-    return nullptr;
 }
 
 // ============================================================================
@@ -932,39 +1477,30 @@ const Player* whoWon(const Game& aGame)
 /**
  * @brief create save of game when game is starting.
  *
- * Create folder /save if not already exist
  * Create a new file of save with selected name
- *  -if name is already used : overwrite suggestion
- *  -if maximum number of save (5) is reached : overwrite suggestion (on selected save)
+ *  -if name is already used (in the save index) : overwrite suggestion
+ *  -if the name can't be used (see `isValidSaveName()`) : return false
  *  -if you choose to not overwrite a save , the game will not be able to save and return false.
+ *  -there is no limit on the number of saves
  *
- *@note all save files will be stocked on the folder /save
+ *@note all save files will be stocked on the folder of the index (/Save), the index is updated
  *
  * @param saveName pointer on the name of the save
+ * @param anIndex the index of the save folder (see `loadSaveIndex()`)
+ * @param aSize the size of the board of the game
  *
  * @return if save is successfully created
  */
-bool createSave(string& saveName) {
-
-    // Create Save folder if it does not exist
-    if (!fs::exists("Save")) {
-        cout << "Creating Save folder /Save..." << endl;
-        fs::create_directory("Save");
-    }
+bool createSave(string& saveName, SaveIndex& anIndex, int aSize) {
     //Enter the name of the save
     cout << "enter file name :" <<endl;
     cin >>saveName;
-    // Count the number of save files
-    int nbFile = 0;
-    for (const auto& entry : fs::directory_iterator("Save")) {
-        if (fs::is_regular_file(entry)) {
-            nbFile++;
-        }
+    if (!isValidSaveName(saveName)) {
+        cout << "Invalid save name: " << saveName << endl;
+        return false;
     }
-    // Build save file path
-    fs::path savePath = fs::path("Save") / saveName;
-    // Check if save already exists
-    if (fs::exists(savePath)) {
+    // Check if save already exists (lookup in the index, no scan of the folder)
+    if (findSave(anIndex, saveName) != -1) {
         cout << "Save already exists: " << saveName << endl;
         cout << "Overwrite ? (y/n): ";
         char choice;
@@ -973,193 +1509,111 @@ bool createSave(string& saveName) {
             return false;
         }
     }
-    // Check save limit
-    else if (nbFile >= 5) {
-        cout << "Maximum number of saves reached (5)." << endl;
-        cout << "Overwrite selected save ? (y/n): ";
-        char choice;
-        cin >> choice;
-        if (choice != 'y' && choice != 'Y') {
-            return false;
-        }
-    }
 
     // Create or overwrite the save file
-    ofstream saveFile(savePath);
+    const string savePath = getSavePath(anIndex, saveName);
+    ofstream saveFile(savePath, ios::binary | ios::trunc);
     if (!saveFile.is_open()) {
         cerr << "Failed to create save file." << endl;
         return false;
     }
     saveFile.close();
+    if (!recordSave(anIndex, saveName, aSize, 0)) {
+        cerr << "Failed to update the save index." << endl;
+        return false;
+    }
     cout << "Save created successfully: " << savePath << endl;
     return true;
 }
 
 /**
  * @brief update the save of the game with the current game state on the save file.
- *  -if file is not found , a new file with the new filename is created
+ *  -the game is written in the binary format (see `encodeSave()`), as a journal without moves
+ *  -`playGame()` appends the moves to the journal instead (see `appendJournal()`)
+ *  -if the save is not in the index , a new file with the new filename is created
  *
  * @param aGame the current game state.
  * @param saveName the name of the save
+ * @param anIndex the index of the save folder
  */
-void updateSave(const Game& aGame , string& saveName) {
-    const int SIZE = aGame.itsBoard.itsSize;
-    fs::path savePath = fs::path("Save") / saveName;
-    if (fs::exists(savePath)) {
-        //Clear the file and open it
-        ofstream oFile(savePath, ios::trunc);
-        if (!oFile.is_open()) {
+void updateSave(const Game& aGame , string& saveName, SaveIndex& anIndex) {
+    PROFILE_SCOPE(PROFILE_SAVE_IO);
+    if (findSave(anIndex, saveName) != -1) {
+        //Clear the file and write the whole record at once
+        const SaveRecord RECORD = encodeSave(aGame);
+        ofstream oFile(getSavePath(anIndex, saveName), ios::binary | ios::trunc);
+        if (!oFile.is_open() || !oFile.write(reinterpret_cast<const char*>(&RECORD), sizeof(RECORD))
+            || !recordSave(anIndex, saveName, aGame.itsBoard.itsSize, 0)) {
             cout << "Error of save";
         }
-        oFile << aGame.itsPlayer1.itsName << endl << aGame.itsPlayer2.itsName << endl; //Write player 1 and player 2
-        oFile << aGame.itsCurrentPlayer->itsRole << endl; //Write role of current player
-        oFile << aGame.itsBoard.itsSize << endl; //Write the size of the board
-        //Loop for write all piece of the board
-        for (int line = 0 ; line <SIZE ; line ++) {
-            for (int col = 0 ; col <SIZE ; col ++) {
-                if (aGame.itsBoard.itsCells[line][col].itsPieceType == NONE) {
-                    oFile <<"☒";
-                }
-                if (aGame.itsBoard.itsCells[line][col].itsPieceType == SWORD) {
-                    oFile <<"S";
-                }
-                if (aGame.itsBoard.itsCells[line][col].itsPieceType == KING) {
-                    oFile <<"K";
-                }
-                if (aGame.itsBoard.itsCells[line][col].itsPieceType == SHIELD) {
-                    oFile <<"s";
-                }
-            }
-            oFile << endl;
-        }
-        oFile.close();
     }
     else {
         cout <<"No file found create new file :" << endl;
-        createSave(saveName);
+        createSave(saveName, anIndex, aGame.itsBoard.itsSize);
     }
 }
 
 /**
  * @brief delete a selected save.
- *  -if save name does not exist : return false and do nothing
- *  -delete only saves in the folder /Save
- *  -if 2 saves have a same name : select one of them (number between 1 & 5)
+ *  -if save name is not in the index : return false and do nothing
+ *  -delete only saves in the folder of the index (/Save)
+ *  -the save is removed from the index
  *
  * @param saveName Name of the save to delete
+ * @param anIndex the index of the save folder
  *
  * @return  if the deletion was successfully carried out
  */
-bool deleteSave(std::string& saveName) {
-    const std::filesystem::path saveDir = "Save";
-
-    //
-    if (!fs::exists(saveDir) || !fs::is_directory(saveDir)) {
-        //error message with std::cerr
-        cerr << "Error: Save directory : '" << saveDir.string()
-                  << " does not exist or is not a directory." << std::endl;
-        return false;
-    }
-
-    //max size for selection (max 5 files in the folder)
-    constexpr size_t MAX_OPTIONS = 5;
-    fs::path paths[MAX_OPTIONS]; // Tableau C-style pour stocker les chemins
-    size_t matchCount = 0;
-    fs::path uniquePath;
-
-    //stock the 5 files with a loop (directory iterator)
-    for (const auto& entry : fs::directory_iterator(saveDir)) {
-        if (entry.is_regular_file()) {
-            //test if filename has same name of the tested file
-            if (entry.path().filename().string() == saveName) {
-                if (matchCount == 0) {
-                    uniquePath = entry.path();
-                }
-                //test
-                if (matchCount < MAX_OPTIONS) {
-                    paths[matchCount] = entry.path();
-                }
-                matchCount++;
-            }
-        }
-    }
-
-    if (matchCount == 0) {
+bool deleteSave(string& saveName, SaveIndex& anIndex) {
+    if (findSave(anIndex, saveName) == -1) {
         //no file :
-        std::cout << "No save found : " << saveName << endl;
+        cout << "No save found : " << saveName << endl;
         return false;
     }
+    const fs::path pathToDelete = getSavePath(anIndex, saveName);
+    cout << "deleting the save : " << pathToDelete.string() << endl;
 
-    fs::path pathToDelete;
-
-    if (matchCount == 1) {
-        // one file
-        pathToDelete = uniquePath;
-        std::cout << "Deletion of the single backup: " << pathToDelete.string() << endl;
-
-    } else {
-
-        cout << "Several backups were found with the name '" << saveName << "':" << endl;
-
-        size_t displayCount = (matchCount > MAX_OPTIONS) ? MAX_OPTIONS : matchCount;
-
-        // display options
-        for (size_t i = 0; i < displayCount; i++) {
-            cout << "[" << (i + 1) << "] " << paths[i].string() << endl;
-        }
-        if (matchCount > MAX_OPTIONS) {
-            cout << "[...] and " << (matchCount - MAX_OPTIONS) << " others." << endl;
-        }
-        cout << "[0] Exit" << endl;
-        cout << "Choose the save to delete (1-" << displayCount << ") : ";
-
-        // read user choice
-        int choice = -1;
-        cin >> choice;
-
-        if ( choice < 1 || choice > (int)displayCount) {
-            //verification of cancel
-            if (choice == 0) {
-                cout << "Operation canceled." << endl;
-            } else {
-                cout << "invalid choice. canceling the delete." << endl;
-            }
-        }
-        //the path to delete is the selected number :
-        pathToDelete = paths[choice - 1];
-        std::cout << "deleting the save : " << pathToDelete.string() << endl;
-    }
-
-    //delete safely the save with try/catch
+    //delete safely the save with try/catch (a file already removed by hand is only removed from the index)
     try {
-        bool success = fs::remove(pathToDelete);
-        if (success) {
-            cout << "The file has been successfully deleted";
-        }
-        return success;
+        fs::remove(pathToDelete);
     } catch (const fs::filesystem_error& e) {
         cerr << "error of delete of '" << pathToDelete.string() << "': "<< e.what() << endl; //e.what() = error type to display
         return false;
     }
+    bool success = removeSave(anIndex, saveName);
+    if (success) {
+        cout << "The file has been successfully deleted";
+    }
+    return success;
 }
 
 /**
  * @brief display a save selection menu
- *  -display 5 line for the 5 saves
- *  -if a save don't exist : display free space
- *  -else display the save name
+ *  -display one line per save of the index (name, board size, moves, last update)
+ *  -if there is no save : display no save
  *  -display the actions possible :
  *      -Load a save 1
  *      -Delete a save 2
  *      -Exit save manager 0
  */
-bool saveManager(Game &aGame , string &saveName) {
+bool saveManager(Game &aGame , string &saveName, SaveIndex& anIndex) {
     cout << "══════════════════════════════════════════════════════"<<endl;
-    int count =1;
-    for (const auto& entry : fs::directory_iterator("Save") ) {
-
-        cout <<count<<" : "<< entry.path().filename().string()<<endl;
-        count++;
+    if (anIndex.itsCount == 0) {
+        cout << "No save" << endl;
+    }
+    for (int count = 0 ; count < anIndex.itsCount ; count++) {
+        const SaveIndexEntry& entry = anIndex.itsEntries[count];
+        const time_t TIMESTAMP = static_cast<time_t>(entry.itsTimestamp);
+        char date[32] = "?";
+        const tm* localDate = localtime(&TIMESTAMP);
+        if (localDate != nullptr) {
+            strftime(date, sizeof(date), "%Y-%m-%d %H:%M", localDate);
+        }
+        cout << count + 1 << " : " << entry.itsName << " (";
+        if (entry.itsSize != 0) {
+            cout << int(entry.itsSize) << "x" << int(entry.itsSize) << ", ";
+        }
+        cout << entry.itsPlies << " moves, " << date << ")" << endl;
     }
     cout << "══════════════════════════════════════════════════════"<<endl;
     int userInput = -1;
@@ -1176,12 +1630,13 @@ bool saveManager(Game &aGame , string &saveName) {
     else if (userInput == 1) {
         cout << "Enter a file name to load : ";
         cin >> saveName;
-        loadSave(aGame,saveName);
+        //a game that failed to load can't be played
+        return loadSave(aGame,saveName,anIndex);
     }
     else if (userInput == 2) {
         cout <<"Enter a file to delete : ";
         cin >>delName;
-        deleteSave(delName);
+        deleteSave(delName, anIndex);
         return false;
     }
     else {
@@ -1193,100 +1648,261 @@ bool saveManager(Game &aGame , string &saveName) {
 
 /**
  * @brief Load a selected save for continue to play it
- *  -if no save in folder /Save display an error message (No save to load) and return false
+ *  -the save is looked up in the index, the file is read in one block, as a binary journal
+ *   (`replayJournal()`) or a legacy text save (`importTextSave()`)
+ *  -if the save is not in the index display an error message (No save to load) and return false
  *  -check if lines contains the goods information (currentPlayer, boardSize , Board )
  *  -if information are incorrect :
  *      -size != 11 or 13
  *      -currentPlayer != itsPlayer1 or itsPlayer2
  *      -if board is missing or invalid (example 2 kings on the board)
  * @param saveName name of the save
+ * @param anIndex the index of the save folder
  *
  * @return if save was successfully loaded
  */
-bool loadSave(Game &aGame, string& saveName) {
-    string fileToLoad="Save/"+saveName;
-    ifstream iFile(fileToLoad);
+bool loadSave(Game &aGame, string& saveName, const SaveIndex& anIndex) {
+    PROFILE_SCOPE(PROFILE_SAVE_IO);
+    if (findSave(anIndex, saveName) == -1) {
+        std::cerr << "No save to load : " << saveName << std::endl;
+        return false;
+    }
+    string fileToLoad=getSavePath(anIndex, saveName);
+    ifstream iFile(fileToLoad, ios::binary | ios::ate);
     if (!iFile.is_open()) {
         std::cerr << "Error: impossible to read the file : " << saveName << std::endl;
         return false;
     }
-    string player1 , player2 , currentPlayer ,boardSize;
-
-    if (getline(iFile,player1)) {
-        aGame.itsPlayer1.itsName = player1;
+    //read the whole file in one block
+    const streamoff LENGTH = iFile.tellg();
+    if (LENGTH <= 0 || LENGTH > (1 << 20)) {
+        cerr << "Loading Error";
+        return false;
     }
-    else {
+    string content(static_cast<size_t>(LENGTH), '\0');
+    iFile.seekg(0);
+    if (!iFile.read(&content[0], LENGTH)) {
         cerr << "Loading Error";
         return false;
     }
-    if (getline(iFile,player2)) {
-        aGame.itsPlayer2.itsName = player2;
+    bool isLoaded;
+    if (content.size() >= sizeof(SaveRecord) && memcmp(content.data(), SAVE_MAGIC, sizeof(SAVE_MAGIC)) == 0) {
+        //binary save: the header position, then the journal of the moves
+        isLoaded = replayJournal(content, aGame);
     }
     else {
+        //saves written before the binary format
+        isLoaded = importTextSave(content, aGame);
+    }
+    if (!isLoaded) {
         cerr << "Loading Error";
-        return false;
     }
-    if (getline(iFile,currentPlayer)) {
-        if (currentPlayer == "0") {
-            aGame.itsCurrentPlayer = &aGame.itsPlayer1;
+    return isLoaded;
+}
+
+/**
+ * @brief Gets the type of a cell of a board at the start of a game.
+ *
+ * @param aRow The row of the cell.
+ * @param aCol The column of the cell.
+ * @param aSize The size of the board.
+ * @return FORTRESS in the corners, CASTLE in the center, NORMAL elsewhere (same as `initializeBoard()`).
+ */
+static CellType standardCellType(int aRow, int aCol, int aSize) {
+    if ((aRow == 0 || aRow == aSize-1) && (aCol == 0 || aCol == aSize-1)) {
+        return FORTRESS;
+    }
+    if (aRow == aSize/2 && aCol == aSize/2) {
+        return CASTLE;
+    }
+    return NORMAL;
+}
+
+/**
+ * @brief Checks the pieces of a loaded position and copies it into a game.
+ *
+ * @param aSnapshot The loaded position (cells, roles and player to move).
+ * @param aNames The names of player 1 and player 2.
+ * @param aGame The game to overwrite.
+ * @return `true` if the position is valid (at most one KING, only the KING on a special cell).
+ */
+static bool restoreLoadedGame(const GameSnapshot& aSnapshot, const string aNames[2], Game& aGame) {
+    const int SIZE = aSnapshot.itsSize;
+    int kingCount = 0;
+    for (int line = 0 ; line < SIZE ; line++) {
+        for (int col = 0 ; col < SIZE ; col++) {
+            const Cell CELL = aSnapshot.itsCells[line][col];
+            kingCount += CELL.itsPieceType == KING;
+            if (CELL.itsCellType != NORMAL && CELL.itsPieceType != NONE && CELL.itsPieceType != KING) {
+                return false;
+            }
         }
-        else {
-            aGame.itsCurrentPlayer = &aGame.itsPlayer2;
+    }
+    if (kingCount > 1 || !restoreSnapshot(aSnapshot, aGame)) {
+        return false;
+    }
+    aGame.itsPlayer1.itsName = aNames[0];
+    aGame.itsPlayer2.itsName = aNames[1];
+    aGame.itsBoard.itsHash = computeHash(aGame.itsBoard, aGame.itsCurrentPlayer->itsRole);
+    return true;
+}
+
+/**
+ * @brief Packs a game into a binary save record.
+ *
+ * @param aGame The game to save (`itsCells` must be allocated).
+ * @return The record (names longer than `SAVE_NAME_LENGTH - 1` characters are cut).
+ */
+SaveRecord encodeSave(const Game& aGame) {
+    SaveRecord record;
+    const int SIZE = aGame.itsBoard.itsSize;
+    record.itsSize = static_cast<unsigned char>(SIZE);
+    record.itsCurrentPlayer = (aGame.itsCurrentPlayer == &aGame.itsPlayer2) ? 2 : 1;
+    const Player* players[2] = {&aGame.itsPlayer1, &aGame.itsPlayer2};
+    for (int player = 0 ; player < 2 ; player++) {
+        record.itsPlayerRoles[player] = static_cast<unsigned char>(players[player]->itsRole);
+        record.itsIsComputer[player] = players[player]->itsIsComputer;
+        //the last byte stays 0
+        players[player]->itsName.copy(record.itsNames[player], SAVE_NAME_LENGTH - 1);
+    }
+    if (aGame.itsBoard.itsCells == nullptr) {
+        return record;
+    }
+    for (int line = 0 ; line < SIZE ; line++) {
+        for (int col = 0 ; col < SIZE ; col++) {
+            const int INDEX = cellIndex(line, col, SIZE);
+            record.itsCells[INDEX / 4] |= aGame.itsBoard.itsCells[line][col].itsPieceType << (2 * (INDEX % 4));
         }
     }
+    return record;
+}
 
-    else {
-        cerr << "Loading Error";
+/**
+ * @brief Rebuilds a game from a binary save record.
+ *
+ * Checks the magic, the version, the size, the player to move, the roles, the unused bits
+ * and the pieces (at most one KING, only the KING on a FORTRESS or the CASTLE) before
+ * touching the game.
+ *
+ * @param aRecord The record to read.
+ * @param aGame The game to overwrite (board, players, bitboards and key).
+ * @return `true` if the record is valid, `false` otherwise (the game is not modified).
+ */
+bool decodeSave(const SaveRecord& aRecord, Game& aGame) {
+    const int SIZE = aRecord.itsSize;
+    if (memcmp(aRecord.itsMagic, SAVE_MAGIC, sizeof(SAVE_MAGIC)) != 0 || aRecord.itsVersion != SAVE_VERSION) {
+        return false;
+    }
+    if ((SIZE != LITTLE && SIZE != BIG) || (aRecord.itsCurrentPlayer != 1 && aRecord.itsCurrentPlayer != 2)) {
+        return false;
+    }
+    //one player of each role
+    if (aRecord.itsPlayerRoles[0] > DEFENSE || aRecord.itsPlayerRoles[1] > DEFENSE || aRecord.itsPlayerRoles[0] == aRecord.itsPlayerRoles[1]) {
+        return false;
+    }
+    if (aRecord.itsIsComputer[0] > 1 || aRecord.itsIsComputer[1] > 1
+        || aRecord.itsNames[0][SAVE_NAME_LENGTH - 1] != 0 || aRecord.itsNames[1][SAVE_NAME_LENGTH - 1] != 0) {
         return false;
     }
-    if (getline(iFile,boardSize)) {
-        if (boardSize == "11") {
-            aGame.itsBoard.itsSize = LITTLE;
+    //the bits after the last cell must be 0
+    const int CELLS = SIZE * SIZE;
+    if ((CELLS % 4 != 0 && (aRecord.itsCells[CELLS / 4] >> (2 * (CELLS % 4))) != 0)) {
+        return false;
+    }
+    for (int byte = (CELLS + 3) / 4 ; byte < SAVE_BOARD_BYTES ; byte++) {
+        if (aRecord.itsCells[byte] != 0) {
+            return false;
         }
-        else {
-            aGame.itsBoard.itsSize = BIG;
+    }
+    GameSnapshot snapshot;
+    snapshot.itsSize = static_cast<BoardSize>(SIZE);
+    snapshot.itsCurrentPlayer = aRecord.itsCurrentPlayer;
+    for (int player = 0 ; player < 2 ; player++) {
+        snapshot.itsPlayerRoles[player] = static_cast<PlayerRole>(aRecord.itsPlayerRoles[player]);
+        snapshot.itsIsComputer[player] = aRecord.itsIsComputer[player] == 1;
+    }
+    for (int line = 0 ; line < SIZE ; line++) {
+        for (int col = 0 ; col < SIZE ; col++) {
+            const int INDEX = cellIndex(line, col, SIZE);
+            snapshot.itsCells[line][col].itsCellType = standardCellType(line, col, SIZE);
+            snapshot.itsCells[line][col].itsPieceType = static_cast<PieceType>((aRecord.itsCells[INDEX / 4] >> (2 * (INDEX % 4))) & 3);
+        }
+    }
+    const string NAMES[2] = {aRecord.itsNames[0], aRecord.itsNames[1]};
+    return restoreLoadedGame(snapshot, NAMES, aGame);
+}
+
+/**
+ * @brief Reads a save written in the legacy text format.
+ *
+ * Lines: player 1 name, player 2 name, role of the current player (0 or 1), size (11 or 13),
+ * then one line of glyphs per row: `K` (KING), `S` (SWORD), `s` (SHIELD), any other glyph is empty.
+ * A glyph can be a multi-byte UTF-8 character (like `☒`), it counts as one cell.
+ *
+ * @param aText The whole content of the file.
+ * @param aGame The game to overwrite (board, players, bitboards and key).
+ * @return `true` if the text is a valid save, `false` otherwise (the game is not modified).
+ */
+bool importTextSave(const string& aText, Game& aGame) {
+    string lines[4];
+    size_t start = 0;
+    for (string& line : lines) {
+        const size_t END = aText.find('\n', start);
+        if (END == string::npos) {
+            return false;
         }
-        createBoard(aGame.itsBoard);
+        line = aText.substr(start, END - start);
+        start = END + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+    }
+    GameSnapshot snapshot;
+    //the file stores the role of the current player, role 0 is player 1
+    if (lines[2] != "0" && lines[2] != "1") {
+        return false;
+    }
+    snapshot.itsCurrentPlayer = (lines[2] == "0") ? 1 : 2;
+    if (lines[3] == "11") {
+        snapshot.itsSize = LITTLE;
+    }
+    else if (lines[3] == "13") {
+        snapshot.itsSize = BIG;
     }
     else {
-        cerr << "Loading Error";
         return false;
     }
-    int N = aGame.itsBoard.itsSize;
-
-    char car;
-    int kingCount = 0; //for test if 2king are on the board
-    for (int line = 0; line < N; line++) {
-
-        for (int col = 0; col < N; col++) {
-            if ((line == 0 || line == N-1) && (col == 0 || col == N-1)) {
-                aGame.itsBoard.itsCells[line][col].itsCellType=FORTRESS;
-            }
-            else if (N==11 && line ==5 && col ==5 || N==11 && line ==6 && col ==6) {
-                aGame.itsBoard.itsCells[line][col].itsCellType=CASTLE;
-            }
-            else {
-                aGame.itsBoard.itsCells[line][col].itsCellType=NORMAL;
-            }
-
-            if (!iFile.get(car)) {
-                cerr << "Error: EOF at (" << line << ", " << col << ")" << endl;
-                iFile.close();
+    const int SIZE = snapshot.itsSize;
+    size_t pos = start;
+    for (int line = 0 ; line < SIZE ; line++) {
+        for (int col = 0 ; col < SIZE ; col++) {
+            if (pos >= aText.size() || aText[pos] == '\n') {
                 return false;
             }
-
-            if (car == 'K') {
-                kingCount++;
-                aGame.itsBoard.itsCells[line][col].itsPieceType = KING;
-            } else if (car == 'S') {
-                aGame.itsBoard.itsCells[line][col].itsPieceType = SWORD;
-            } else if (car == 's') {
-                aGame.itsBoard.itsCells[line][col].itsPieceType = SHIELD;
+            const char GLYPH = aText[pos++];
+            //skip the continuation bytes of a multi-byte UTF-8 glyph
+            while (pos < aText.size() && (static_cast<unsigned char>(aText[pos]) & 0xC0) == 0x80) {
+                pos++;
+            }
+            snapshot.itsCells[line][col].itsCellType = standardCellType(line, col, SIZE);
+            if (GLYPH == 'K') {
+                snapshot.itsCells[line][col].itsPieceType = KING;
+            } else if (GLYPH == 'S') {
+                snapshot.itsCells[line][col].itsPieceType = SWORD;
+            } else if (GLYPH == 's') {
+                snapshot.itsCells[line][col].itsPieceType = SHIELD;
             } else {
-                aGame.itsBoard.itsCells[line][col].itsPieceType = NONE;
+                snapshot.itsCells[line][col].itsPieceType = NONE;
             }
         }
-        iFile.get(car);
+        //each row ends with a line break (optional for the last one)
+        if (pos < aText.size() && aText[pos] == '\r') {
+            pos++;
+        }
+        if (pos < aText.size() && aText[pos] != '\n') {
+            return false;
+        }
+        pos++;
     }
-    return true;
+    return restoreLoadedGame(snapshot, lines, aGame);
 }
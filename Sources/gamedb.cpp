@@ -0,0 +1,470 @@
+/**
+ * @file gamedb.cpp
+ *
+ * @brief Implementation of the single-file game database.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/ai.h"
+#include "../Headers/journal.h"
+#include "../Headers/gamedb.h"
+
+using namespace std;
+
+// ============================================================================
+// SECTION 1: WRITING
+// ============================================================================
+
+/**
+ * @brief Gets the winner of a finished game as stored in the index.
+ *
+ * @param aGame The game to read.
+ * @return ATTACK, DEFENSE or `GAMEDB_NO_WINNER` if the game is not finished.
+ */
+static unsigned char getDatabaseWinner(const Game& aGame) {
+    switch (getGameStatus(aGame.itsBoard)) {
+        case KING_CAPTURED:
+            return ATTACK;
+        case NO_SWORD_LEFT:
+        case KING_ESCAPED:
+            return DEFENSE;
+        default:
+            return GAMEDB_NO_WINNER;
+    }
+}
+
+/**
+ * @brief Puts a game in the starting position of a board size, reusing its board if possible.
+ *
+ * @return `false` if the allocation failed.
+ */
+static bool startDatabaseGame(Game& aGame, BoardSize aSize) {
+    if (!resizeBoard(aGame.itsBoard, aSize)) {
+        return false;
+    }
+    initializeBoard(aGame.itsBoard);
+    aGame.itsCurrentPlayer = &aGame.itsPlayer1;
+    return true;
+}
+
+/**
+ * @brief Creates (or overwrites) a game database.
+ *
+ * @param aWriter The writer to open (must be closed).
+ * @param aPath The path of the file.
+ * @return `true` if the file was created.
+ */
+bool createGameDatabase(GameDbWriter& aWriter, const string& aPath) {
+    if (aWriter.itsFile != nullptr) {
+        return false;
+    }
+    aWriter.itsFile = fopen(aPath.c_str(), "wb");
+    if (aWriter.itsFile == nullptr) {
+        return false;
+    }
+    //the header is written again by closeGameDatabase, with the count and the index offset
+    const GameDbHeader HEADER;
+    aWriter.itsCount = 0;
+    aWriter.itsOffset = sizeof(HEADER);
+    if (fwrite(&HEADER, sizeof(HEADER), 1, aWriter.itsFile) != 1) {
+        fclose(aWriter.itsFile);
+        aWriter.itsFile = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Adds a game to a database being written.
+ *
+ * The game is replayed from the starting position with `checkMovement()`, so a database
+ * only holds legal games, and the winner of the index is the one of the final position.
+ *
+ * @param aWriter The open writer.
+ * @param aSize The size of the board.
+ * @param aMoves The moves of the game.
+ * @param aPlies The number of moves.
+ * @return `true` if the game was added, `false` if a move is illegal or a write failed.
+ */
+bool addDatabaseGame(GameDbWriter& aWriter, BoardSize aSize, const Move* aMoves, int aPlies) {
+    if (aWriter.itsFile == nullptr || (aSize != LITTLE && aSize != BIG) || aPlies < 0 || (aPlies > 0 && aMoves == nullptr)) {
+        return false;
+    }
+    if (!startDatabaseGame(aWriter.itsGame, aSize)) {
+        return false;
+    }
+    for (int ply = 0 ; ply < aPlies ; ply++) {
+        if (isGameFinished(aWriter.itsGame) || checkMovement(aWriter.itsGame, aMoves[ply]) != VALID_MOVE) {
+            return false;
+        }
+        makeMove(aWriter.itsGame, aMoves[ply]);
+    }
+    //grow the index by doubling its size
+    if (aWriter.itsCount == aWriter.itsCapacity) {
+        const uint64_t CAPACITY = max<uint64_t>(64, aWriter.itsCapacity * 2);
+        GameDbEntry* entries = new (nothrow) GameDbEntry[CAPACITY];
+        if (entries == nullptr) {
+            return false;
+        }
+        if (aWriter.itsEntries != nullptr) {
+            memcpy(entries, aWriter.itsEntries, sizeof(GameDbEntry) * aWriter.itsCount);
+            delete[] aWriter.itsEntries;
+        }
+        aWriter.itsEntries = entries;
+        aWriter.itsCapacity = CAPACITY;
+    }
+    //the moves are written by blocks of records
+    const int BLOCK = 256;
+    MoveRecord records[BLOCK];
+    for (int first = 0 ; first < aPlies ; first += BLOCK) {
+        const int COUNT = min(BLOCK, aPlies - first);
+        for (int i = 0 ; i < COUNT ; i++) {
+            const Move& move = aMoves[first + i];
+            records[i].itsCoords[0] = static_cast<unsigned char>(move.itsStartPosition.itsRow);
+            records[i].itsCoords[1] = static_cast<unsigned char>(move.itsStartPosition.itsCol);
+            records[i].itsCoords[2] = static_cast<unsigned char>(move.itsEndPosition.itsRow);
+            records[i].itsCoords[3] = static_cast<unsigned char>(move.itsEndPosition.itsCol);
+        }
+        if (fwrite(records, sizeof(MoveRecord), COUNT, aWriter.itsFile) != static_cast<size_t>(COUNT)) {
+            return false;
+        }
+    }
+    GameDbEntry& entry = aWriter.itsEntries[aWriter.itsCount++];
+    entry = GameDbEntry();
+    entry.itsMovesOffset = aWriter.itsOffset;
+    entry.itsPlies = static_cast<uint32_t>(aPlies);
+    entry.itsSize = static_cast<unsigned char>(aSize);
+    entry.itsWinner = getDatabaseWinner(aWriter.itsGame);
+    aWriter.itsOffset += sizeof(MoveRecord) * static_cast<uint64_t>(aPlies);
+    return true;
+}
+
+/**
+ * @brief Writes the index and the header, then closes the file.
+ *
+ * Safe to call on a closed writer.
+ *
+ * @param aWriter The writer to close.
+ * @return `false` if a write failed (the file is not a valid database).
+ */
+bool closeGameDatabase(GameDbWriter& aWriter) {
+    if (aWriter.itsFile == nullptr) {
+        return true;
+    }
+    //the index starts on a multiple of 8 so its entries can be read in place
+    const char PADDING[8] = {};
+    const uint64_t PADDING_SIZE = (8 - aWriter.itsOffset % 8) % 8;
+    GameDbHeader header;
+    header.itsGameCount = aWriter.itsCount;
+    header.itsIndexOffset = aWriter.itsOffset + PADDING_SIZE;
+    bool isWritten = fwrite(PADDING, 1, PADDING_SIZE, aWriter.itsFile) == PADDING_SIZE;
+    if (aWriter.itsCount > 0) {
+        isWritten = isWritten && fwrite(aWriter.itsEntries, sizeof(GameDbEntry), aWriter.itsCount, aWriter.itsFile) == aWriter.itsCount;
+    }
+    isWritten = isWritten && fseek(aWriter.itsFile, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, aWriter.itsFile) == 1;
+    isWritten = fclose(aWriter.itsFile) == 0 && isWritten;
+    aWriter.itsFile = nullptr;
+    delete[] aWriter.itsEntries;
+    aWriter.itsEntries = nullptr;
+    aWriter.itsCount = 0;
+    aWriter.itsCapacity = 0;
+    deleteBoard(aWriter.itsGame.itsBoard);
+    return isWritten;
+}
+
+// ============================================================================
+// SECTION 2: READING
+// ============================================================================
+
+/**
+ * @brief Checks the header, the index and the move streams of a mapped database.
+ *
+ * @return `true` if every offset is inside the file.
+ */
+static bool isValidDatabase(const unsigned char* aData, uint64_t aLength) {
+    if (aLength < sizeof(GameDbHeader)) {
+        return false;
+    }
+    GameDbHeader header;
+    memcpy(&header, aData, sizeof(header));
+    if (memcmp(header.itsMagic, GAMEDB_MAGIC, sizeof(GAMEDB_MAGIC)) != 0 || header.itsVersion != GAMEDB_VERSION) {
+        return false;
+    }
+    //the index must hold in the file (the count is checked first against overflows)
+    if (header.itsIndexOffset < sizeof(GameDbHeader) || header.itsIndexOffset % 8 != 0 || header.itsIndexOffset > aLength
+        || header.itsGameCount > (aLength - header.itsIndexOffset) / sizeof(GameDbEntry)) {
+        return false;
+    }
+    const GameDbEntry* entries = reinterpret_cast<const GameDbEntry*>(aData + header.itsIndexOffset);
+    for (uint64_t game = 0 ; game < header.itsGameCount ; game++) {
+        const GameDbEntry& entry = entries[game];
+        if ((entry.itsSize != LITTLE && entry.itsSize != BIG) || entry.itsWinner > GAMEDB_NO_WINNER
+            || entry.itsMovesOffset < sizeof(GameDbHeader) || entry.itsMovesOffset > header.itsIndexOffset
+            || entry.itsPlies > (header.itsIndexOffset - entry.itsMovesOffset) / sizeof(MoveRecord)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Maps a whole file in memory, read-only.
+ *
+ * @param aPath The path of the file.
+ * @param aData Set to the first byte of the mapping.
+ * @param aLength Set to the size of the file.
+ * @param aMapping Set to the handle of the mapping (Windows only, nullptr elsewhere).
+ * @return `true` if the file is mapped, `false` if it can't be opened or is empty.
+ */
+bool mapReadOnlyFile(const string& aPath, const unsigned char*& aData, uint64_t& aLength, void*& aMapping) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    //the mapping keeps the file open
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        return false;
+    }
+    aMapping = mapping;
+    aLength = static_cast<uint64_t>(size.QuadPart);
+#else
+    const int FILE = open(aPath.c_str(), O_RDONLY);
+    if (FILE == -1) {
+        return false;
+    }
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fstat(FILE, &status) == 0 && status.st_size > 0) {
+        data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, FILE, 0);
+    }
+    //the mapping keeps the file open
+    close(FILE);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    aMapping = nullptr;
+    aLength = static_cast<uint64_t>(status.st_size);
+#endif
+    aData = static_cast<const unsigned char*>(data);
+    return true;
+}
+
+/**
+ * @brief Unmaps a file mapped by `mapReadOnlyFile()`.
+ *
+ * @param aData The first byte of the mapping (nothing is done if nullptr).
+ * @param aLength The size of the mapping.
+ * @param aMapping The handle of the mapping (Windows only).
+ */
+void unmapReadOnlyFile(const unsigned char* aData, uint64_t aLength, void* aMapping) {
+    if (aData == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    (void)aLength;
+    UnmapViewOfFile(aData);
+    CloseHandle(aMapping);
+#else
+    (void)aMapping;
+    munmap(const_cast<unsigned char*>(aData), static_cast<size_t>(aLength));
+#endif
+}
+
+/**
+ * @brief Maps a game database in memory.
+ *
+ * Checks the header and that the index and every move stream are inside the file,
+ * so the readers don't have to check the offsets again.
+ *
+ * @param aDatabase The database to open (must be closed).
+ * @param aPath The path of the file.
+ * @return `true` if the database is mapped and valid.
+ */
+bool openGameDatabase(GameDatabase& aDatabase, const string& aPath) {
+    if (aDatabase.itsData != nullptr
+        || !mapReadOnlyFile(aPath, aDatabase.itsData, aDatabase.itsLength, aDatabase.itsMapping)) {
+        return false;
+    }
+    if (!isValidDatabase(aDatabase.itsData, aDatabase.itsLength)) {
+        closeGameDatabase(aDatabase);
+        return false;
+    }
+    GameDbHeader header;
+    memcpy(&header, aDatabase.itsData, sizeof(header));
+    aDatabase.itsEntries = reinterpret_cast<const GameDbEntry*>(aDatabase.itsData + header.itsIndexOffset);
+    aDatabase.itsGameCount = header.itsGameCount;
+    return true;
+}
+
+/**
+ * @brief Unmaps a game database. Safe to call on a closed database.
+ *
+ * @param aDatabase The database to close.
+ */
+void closeGameDatabase(GameDatabase& aDatabase) {
+    unmapReadOnlyFile(aDatabase.itsData, aDatabase.itsLength, aDatabase.itsMapping);
+    aDatabase = GameDatabase();
+}
+
+/**
+ * @brief Gets the moves of a game, in place in the mapping.
+ *
+ * @param aDatabase The open database.
+ * @param anIndex The index of the game (less than `itsGameCount`).
+ * @return The first of the `itsPlies` records of the game.
+ */
+const MoveRecord* getDatabaseMoves(const GameDatabase& aDatabase, uint64_t anIndex) {
+    return reinterpret_cast<const MoveRecord*>(aDatabase.itsData + aDatabase.itsEntries[anIndex].itsMovesOffset);
+}
+
+/**
+ * @brief Replays a game of a database with `movePiece()` / `capturePieces()`.
+ *
+ * The moves were checked when the database was written, so they are only checked to be
+ * on the board (no `checkMovement()`), which keeps the replay as fast as possible.
+ *
+ * @param aDatabase The open database.
+ * @param anIndex The index of the game.
+ * @param aGame The game receiving the final position (its board is reused if it has the good size).
+ * @return `false` if the index or a move is out of bounds.
+ */
+bool replayDatabaseGame(const GameDatabase& aDatabase, uint64_t anIndex, Game& aGame) {
+    if (anIndex >= aDatabase.itsGameCount) {
+        return false;
+    }
+    const GameDbEntry& entry = aDatabase.itsEntries[anIndex];
+    const BoardSize SIZE = static_cast<BoardSize>(entry.itsSize);
+    if (!startDatabaseGame(aGame, SIZE)) {
+        return false;
+    }
+    const MoveRecord* records = getDatabaseMoves(aDatabase, anIndex);
+    for (uint32_t ply = 0 ; ply < entry.itsPlies ; ply++) {
+        const unsigned char* coords = records[ply].itsCoords;
+        if ((coords[0] >= SIZE) | (coords[1] >= SIZE) | (coords[2] >= SIZE) | (coords[3] >= SIZE)) {
+            return false;
+        }
+        const Move MOVE = {{coords[0], coords[1]}, {coords[2], coords[3]}};
+        movePiece(aGame, MOVE);
+        capturePieces(aGame, MOVE);
+        switchCurrentPlayer(aGame);
+    }
+    return true;
+}
+
+// ============================================================================
+// SECTION 3: STATISTICS
+// ============================================================================
+
+/**
+ * @brief Replays the games given by a shared counter and adds them to the statistics of the thread.
+ */
+static void runStatsWorker(const GameDatabase& aDatabase, atomic<uint64_t>& aNextGame, GameDbStats& aStats) {
+    //games are taken by blocks to share the counter less often
+    const uint64_t BLOCK = 64;
+    Game game;
+    for (uint64_t first = aNextGame.fetch_add(BLOCK) ; first < aDatabase.itsGameCount ; first = aNextGame.fetch_add(BLOCK)) {
+        const uint64_t LAST = min(first + BLOCK, aDatabase.itsGameCount);
+        for (uint64_t index = first ; index < LAST ; index++) {
+            const GameDbEntry& entry = aDatabase.itsEntries[index];
+            const int SIZE = (entry.itsSize == BIG);
+            aStats.itsGames[SIZE]++;
+            aStats.itsPlies[SIZE] += entry.itsPlies;
+            aStats.itsWins[SIZE][entry.itsWinner]++;
+            if (!replayDatabaseGame(aDatabase, index, game) || getDatabaseWinner(game) != entry.itsWinner) {
+                aStats.itsReplayErrors++;
+            }
+        }
+    }
+    deleteBoard(game.itsBoard);
+}
+
+/**
+ * @brief Replays all the games of a database on a pool of threads and computes their statistics.
+ *
+ * @param aDatabase The open database.
+ * @param aThreadCount Number of threads (`AI_ALL_CORES` (0) for one per core).
+ * @return The statistics.
+ */
+GameDbStats computeDatabaseStats(const GameDatabase& aDatabase, int aThreadCount) {
+    GameDbStats total;
+    if (aDatabase.itsGameCount == 0) {
+        return total;
+    }
+    if (aThreadCount == AI_ALL_CORES) {
+        aThreadCount = static_cast<int>(thread::hardware_concurrency());
+    }
+    aThreadCount = clamp(aThreadCount, 1, AI_MAX_THREADS);
+    //each thread adds to its own statistics, they are summed at the end
+    GameDbStats stats[AI_MAX_THREADS];
+    thread workers[AI_MAX_THREADS];
+    atomic<uint64_t> nextGame{0};
+    for (int worker = 0 ; worker < aThreadCount ; worker++) {
+        workers[worker] = thread(runStatsWorker, cref(aDatabase), ref(nextGame), ref(stats[worker]));
+    }
+    for (int worker = 0 ; worker < aThreadCount ; worker++) {
+        workers[worker].join();
+        for (int size = 0 ; size < 2 ; size++) {
+            total.itsGames[size] += stats[worker].itsGames[size];
+            total.itsPlies[size] += stats[worker].itsPlies[size];
+            for (int winner = 0 ; winner < 3 ; winner++) {
+                total.itsWins[size][winner] += stats[worker].itsWins[size][winner];
+            }
+        }
+        total.itsReplayErrors += stats[worker].itsReplayErrors;
+    }
+    return total;
+}
+
+/**
+ * @brief Counts the results of the games starting with a given move (only reads the index and the first moves).
+ *
+ * @param aDatabase The open database.
+ * @param aSize The size of the board of the games to count.
+ * @param anOpening The first move.
+ * @return The results of these games.
+ */
+OpeningStats getOpeningStats(const GameDatabase& aDatabase, BoardSize aSize, const Move& anOpening) {
+    OpeningStats stats;
+    const unsigned char OPENING[4] = {static_cast<unsigned char>(anOpening.itsStartPosition.itsRow),
+                                      static_cast<unsigned char>(anOpening.itsStartPosition.itsCol),
+                                      static_cast<unsigned char>(anOpening.itsEndPosition.itsRow),
+                                      static_cast<unsigned char>(anOpening.itsEndPosition.itsCol)};
+    for (uint64_t index = 0 ; index < aDatabase.itsGameCount ; index++) {
+        const GameDbEntry& entry = aDatabase.itsEntries[index];
+        if (entry.itsSize != aSize || entry.itsPlies == 0 || memcmp(getDatabaseMoves(aDatabase, index)->itsCoords, OPENING, 4) != 0) {
+            continue;
+        }
+        stats.itsGames++;
+        stats.itsAttackWins += entry.itsWinner == ATTACK;
+        stats.itsDefenseWins += entry.itsWinner == DEFENSE;
+    }
+    return stats;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file journal.cpp
+ *
+ * @brief Implementation of the append-only move journal used by the save files.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <cstring>
+#include <filesystem>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/journal.h"
+#include "../Headers/profile.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// ============================================================================
+// SECTION 1: WRITING
+// ============================================================================
+
+/**
+ * @brief Forces the written data of a file to the disk.
+ *
+ * @param aFile The file to synchronize (already flushed).
+ * @return `true` if successful.
+ */
+bool syncFile(FILE* aFile) {
+#ifdef _WIN32
+    return _commit(_fileno(aFile)) == 0;
+#else
+    return fsync(fileno(aFile)) == 0;
+#endif
+}
+
+/**
+ * @brief Opens the journal file and sets the policy.
+ *
+ * @return `true` if the file is open.
+ */
+static bool startJournal(MoveJournal& aJournal, const string& aPath, const char* aMode, const JournalPolicy& aPolicy) {
+    if (aJournal.itsFile != nullptr) {
+        return false;
+    }
+    aJournal.itsPolicy = aPolicy;
+    //the buffer can't hold more than JOURNAL_BUFFER_MOVES moves
+    if (aJournal.itsPolicy.itsFlushInterval < 1) {
+        aJournal.itsPolicy.itsFlushInterval = 1;
+    }
+    if (aJournal.itsPolicy.itsFlushInterval > JOURNAL_BUFFER_MOVES) {
+        aJournal.itsPolicy.itsFlushInterval = JOURNAL_BUFFER_MOVES;
+    }
+    aJournal.itsBuffered = 0;
+    aJournal.itsPlies = 0;
+    aJournal.itsFile = fopen(aPath.c_str(), aMode);
+    return aJournal.itsFile != nullptr;
+}
+
+/**
+ * @brief Creates (or overwrites) a journal starting from the position of a game.
+ *
+ * @param aJournal The journal to open (must be closed).
+ * @param aPath The path of the file.
+ * @param aGame The position written in the header.
+ * @param aPolicy The write and sync policy.
+ * @return `true` if the header was written, `false` otherwise.
+ */
+bool openJournal(MoveJournal& aJournal, const string& aPath, const Game& aGame, const JournalPolicy& aPolicy) {
+    PROFILE_SCOPE(PROFILE_SAVE_IO);
+    if (!startJournal(aJournal, aPath, "wb", aPolicy)) {
+        return false;
+    }
+    const SaveRecord HEADER = encodeSave(aGame);
+    //the header is always synchronized, a journal without header can't be replayed
+    if (fwrite(&HEADER, sizeof(HEADER), 1, aJournal.itsFile) != 1 || fflush(aJournal.itsFile) != 0
+        || (aJournal.itsPolicy.itsIsSyncing && !syncFile(aJournal.itsFile))) {
+        fclose(aJournal.itsFile);
+        aJournal.itsFile = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens an existing journal to append the next moves.
+ *
+ * An incomplete last record (interrupted write) is removed first.
+ *
+ * @param aJournal The journal to open (must be closed).
+ * @param aPath The path of the file (it must start with `SAVE_MAGIC`).
+ * @param aPolicy The write and sync policy.
+ * @return `true` if the journal is open, `false` otherwise.
+ */
+bool resumeJournal(MoveJournal& aJournal, const string& aPath, const JournalPolicy& aPolicy) {
+    PROFILE_SCOPE(PROFILE_SAVE_IO);
+    error_code error;
+    const uintmax_t SIZE = fs::file_size(aPath, error);
+    if (error || SIZE < sizeof(SaveRecord) || aJournal.itsFile != nullptr) {
+        return false;
+    }
+    //a legacy text save is not a journal
+    char magic[sizeof(SAVE_MAGIC)] = {};
+    FILE* file = fopen(aPath.c_str(), "rb");
+    const bool IS_JOURNAL = file != nullptr && fread(magic, sizeof(magic), 1, file) == 1
+                            && memcmp(magic, SAVE_MAGIC, sizeof(magic)) == 0;
+    if (file != nullptr) {
+        fclose(file);
+    }
+    if (!IS_JOURNAL) {
+        return false;
+    }
+    const uintmax_t MOVES = (SIZE - sizeof(SaveRecord)) / sizeof(MoveRecord);
+    const uintmax_t COMPLETE = sizeof(SaveRecord) + MOVES * sizeof(MoveRecord);
+    if (COMPLETE != SIZE) {
+        fs::resize_file(aPath, COMPLETE, error);
+        if (error) {
+            return false;
+        }
+    }
+    if (!startJournal(aJournal, aPath, "ab", aPolicy)) {
+        return false;
+    }
+    aJournal.itsPlies = static_cast<int>(MOVES);
+    return true;
+}
+
+/**
+ * @brief Writes the buffered moves to the file (and syncs it if the policy asks for it).
+ *
+ * @param aJournal The open journal.
+ * @return `false` if the journal is closed or the write failed.
+ */
+bool flushJournal(MoveJournal& aJournal) {
+    if (aJournal.itsFile == nullptr) {
+        return false;
+    }
+    if (aJournal.itsBuffered == 0) {
+        return true;
+    }
+    const size_t COUNT = static_cast<size_t>(aJournal.itsBuffered);
+    aJournal.itsBuffered = 0;
+    //one write for the whole buffer
+    if (fwrite(aJournal.itsBuffer, sizeof(MoveRecord), COUNT, aJournal.itsFile) != COUNT || fflush(aJournal.itsFile) != 0) {
+        return false;
+    }
+    return !aJournal.itsPolicy.itsIsSyncing || syncFile(aJournal.itsFile);
+}
+
+/**
+ * @brief Adds a move to a journal.
+ *
+ * The move is buffered and the buffer is written when it holds `itsFlushInterval` moves.
+ *
+ * @param aJournal The open journal.
+ * @param aMove The played move.
+ * @return `false` if the journal is closed or a write failed.
+ */
+bool appendJournal(MoveJournal& aJournal, const Move& aMove) {
+    PROFILE_SCOPE(PROFILE_SAVE_IO);
+    if (aJournal.itsFile == nullptr) {
+        return false;
+    }
+    MoveRecord& record = aJournal.itsBuffer[aJournal.itsBuffered++];
+    record.itsCoords[0] = static_cast<unsigned char>(aMove.itsStartPosition.itsRow);
+    record.itsCoords[1] = static_cast<unsigned char>(aMove.itsStartPosition.itsCol);
+    record.itsCoords[2] = static_cast<unsigned char>(aMove.itsEndPosition.itsRow);
+    record.itsCoords[3] = static_cast<unsigned char>(aMove.itsEndPosition.itsCol);
+    aJournal.itsPlies++;
+    if (aJournal.itsBuffered >= aJournal.itsPolicy.itsFlushInterval) {
+        return flushJournal(aJournal);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the buffered moves, syncs and closes the file.
+ *
+ * Safe to call on a closed journal.
+ *
+ * @param aJournal The journal to close.
+ * @return `false` if the last write failed.
+ */
+bool closeJournal(MoveJournal& aJournal) {
+    if (aJournal.itsFile == nullptr) {
+        return true;
+    }
+    bool isWritten = flushJournal(aJournal);
+    //the end of a game is always synchronized
+    if (!aJournal.itsPolicy.itsIsSyncing) {
+        isWritten = syncFile(aJournal.itsFile) && isWritten;
+    }
+    isWritten = fclose(aJournal.itsFile) == 0 && isWritten;
+    aJournal.itsFile = nullptr;
+    return isWritten;
+}
+
+// ============================================================================
+// SECTION 2: REPLAY
+// ============================================================================
+
+/**
+ * @brief Rebuilds a game from the content of a journal file.
+ *
+ * Decodes the header with `decodeSave()` then plays every complete record with `makeMove()`;
+ * an incomplete last record is ignored. Each move is checked with `checkMovement()`.
+ *
+ * @param aContent The whole content of the file.
+ * @param aGame The game to overwrite.
+ * @param aPlies Set to the number of replayed moves (can be `nullptr`).
+ * @return `true` if the header is valid and every move is legal, `false` otherwise
+ *         (after an illegal move, `aGame` holds the position reached before it).
+ */
+bool replayJournal(const string& aContent, Game& aGame, int* aPlies) {
+    if (aPlies != nullptr) {
+        *aPlies = 0;
+    }
+    if (aContent.size() < sizeof(SaveRecord)) {
+        return false;
+    }
+    SaveRecord header;
+    memcpy(&header, aContent.data(), sizeof(header));
+    if (!decodeSave(header, aGame)) {
+        return false;
+    }
+    const size_t MOVES = (aContent.size() - sizeof(SaveRecord)) / sizeof(MoveRecord);
+    const unsigned char* records = reinterpret_cast<const unsigned char*>(aContent.data()) + sizeof(SaveRecord);
+    for (size_t i = 0 ; i < MOVES ; i++) {
+        const unsigned char* coords = records + i * sizeof(MoveRecord);
+        const Move MOVE = {{coords[0], coords[1]}, {coords[2], coords[3]}};
+        //no move after the end of the game
+        if (isGameFinished(aGame) || checkMovement(aGame, MOVE) != VALID_MOVE) {
+            return false;
+        }
+        makeMove(aGame, MOVE);
+        if (aPlies != nullptr) {
+            (*aPlies)++;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,385 @@
+/**
+ * @file mcts.cpp
+ *
+ * @brief Implementation of the Monte Carlo tree search player.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <new>
+#include <thread>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/ai.h"
+#include "../Headers/boardpool.h"
+#include "../Headers/profile.h"
+#include "../Headers/mcts.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ============================================================================
+// SECTION 1: CREATION
+// ============================================================================
+
+/**
+ * @brief Scale of `evaluatePosition()` in the score of a cut rollout (a lead of this value is a 73% win).
+ */
+static const double EVAL_SCALE = 400.0;
+
+/**
+ * @brief Playouts between two reads of the clock.
+ */
+static const int CLOCK_INTERVAL = 16;
+
+/**
+ * @brief Allocates the node pool and the threads of the search.
+ *
+ * @param aSearch The search to initialize (must not be already created).
+ * @param aNodeBits The pool holds 2^aNodeBits nodes (4-24).
+ * @param aThreadCount Number of threads (1-`AI_MAX_THREADS`, `AI_ALL_CORES` for one per core).
+ * @param aSeed Seed of the random rollouts.
+ * @return `true` if the allocation succeeded, `false` otherwise.
+ */
+bool createMcts(MctsSearch& aSearch, int aNodeBits, int aThreadCount, uint64_t aSeed) {
+    if (aSearch.itsNodes != nullptr || aNodeBits < 4 || aNodeBits > 24 || aThreadCount < 0 || aThreadCount > AI_MAX_THREADS) {
+        return false;
+    }
+    if (aThreadCount == AI_ALL_CORES) {
+        //hardware_concurrency() can return 0 when unknown
+        aThreadCount = clamp(static_cast<int>(thread::hardware_concurrency()), 1, AI_MAX_THREADS);
+    }
+    aSearch.itsCapacity = 1 << aNodeBits;
+    aSearch.itsNodes = new (nothrow) MctsNode[aSearch.itsCapacity];
+    aSearch.itsWorkers = new (nothrow) MctsWorker[aThreadCount];
+    bool isCreated = aSearch.itsNodes != nullptr && aSearch.itsWorkers != nullptr && createBoardPool(aSearch.itsBoards, aThreadCount);
+    if (isCreated) {
+        aSearch.itsThreadCount = aThreadCount;
+    }
+    //each worker keeps its board, the searches don't allocate
+    for (int worker = 0 ; isCreated && worker < aSearch.itsThreadCount ; worker++) {
+        isCreated = acquireBoard(aSearch.itsBoards, aSearch.itsWorkers[worker].itsGame.itsBoard, LITTLE);
+    }
+    if (!isCreated) {
+        deleteMcts(aSearch);
+        return false;
+    }
+    aSearch.itsSeed = aSeed;
+    return true;
+}
+
+/**
+ * @brief Releases the node pool and the threads of the search.
+ *
+ * @param aSearch The search to release (pointers are set to nullptr).
+ */
+void deleteMcts(MctsSearch& aSearch) {
+    for (int worker = 0 ; worker < aSearch.itsThreadCount ; worker++) {
+        releaseBoard(aSearch.itsBoards, aSearch.itsWorkers[worker].itsGame.itsBoard);
+    }
+    deleteBoardPool(aSearch.itsBoards);
+    delete[] aSearch.itsNodes;
+    delete[] aSearch.itsWorkers;
+    aSearch.itsNodes = nullptr;
+    aSearch.itsWorkers = nullptr;
+    aSearch.itsCapacity = 0;
+    aSearch.itsThreadCount = 0;
+}
+
+// ============================================================================
+// SECTION 2: PLAYOUTS
+// ============================================================================
+
+/**
+ * @brief Draws the next number of a splitmix64 generator.
+ *
+ * @param aState The state of the generator (updated).
+ * @return A 64-bit pseudo-random number.
+ */
+static uint64_t nextRandom(uint64_t& aState) {
+    aState += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = aState;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Puts the position of the searched game in the game of a worker.
+ */
+static void copyRootPosition(const Game& aRoot, Game& aGame) {
+    copyBoard(aRoot.itsBoard, aGame.itsBoard);
+    aGame.itsPlayer1.itsRole = aRoot.itsPlayer1.itsRole;
+    aGame.itsPlayer2.itsRole = aRoot.itsPlayer2.itsRole;
+    aGame.itsCurrentPlayer = (aRoot.itsCurrentPlayer == &aRoot.itsPlayer2) ? &aGame.itsPlayer2 : &aGame.itsPlayer1;
+}
+
+/**
+ * @brief Gets the winner of a finished position from its cached status.
+ *
+ * @return `false` if the game is not finished.
+ */
+static bool getWinner(const Game& aGame, PlayerRole& aWinner) {
+    const GameStatus STATUS = getGameStatus(aGame.itsBoard);
+    if (STATUS == IN_PROGRESS) {
+        return false;
+    }
+    aWinner = (STATUS == KING_CAPTURED) ? ATTACK : DEFENSE;
+    return true;
+}
+
+/**
+ * @brief Creates the children of a node (the calling thread owns its `MCTS_EXPANDING` state).
+ *
+ * A finished position, or a player without move (who loses, as in the alpha-beta search),
+ * makes the node terminal. When the pool is full the node is expanded without children.
+ */
+static void expandNode(MctsSearch& aSearch, MctsNode& aNode, MctsWorker& aWorker) {
+    Game& game = aWorker.itsGame;
+    PlayerRole winner = ATTACK;
+    if (getWinner(game, winner)) {
+        aNode.itsWinner = winner;
+        aNode.itsState.store(MCTS_TERMINAL, memory_order_release);
+        return;
+    }
+    if (generateMoves(game, aWorker.itsMoves) == 0) {
+        winner = (game.itsCurrentPlayer->itsRole == ATTACK) ? DEFENSE : ATTACK;
+        aNode.itsWinner = winner;
+        aNode.itsState.store(MCTS_TERMINAL, memory_order_release);
+        return;
+    }
+    const int COUNT = aWorker.itsMoves.itsCount;
+    //once the pool is full the counter is not increased anymore, so it can't overflow
+    const bool IS_FULL = aSearch.itsNodeCount.load(memory_order_relaxed) > aSearch.itsCapacity - COUNT;
+    const int FIRST = IS_FULL ? aSearch.itsCapacity : aSearch.itsNodeCount.fetch_add(COUNT, memory_order_relaxed);
+    if (FIRST > aSearch.itsCapacity - COUNT) {
+        aNode.itsChildCount = 0;
+        aNode.itsState.store(MCTS_EXPANDED, memory_order_release);
+        return;
+    }
+    //the children are in a random order, so the unvisited ones are not tried in the generation order
+    const PlayerRole MOVER = game.itsCurrentPlayer->itsRole;
+    for (int i = COUNT - 1 ; i > 0 ; i--) {
+        swap(aWorker.itsMoves.itsMoves[i], aWorker.itsMoves.itsMoves[nextRandom(aWorker.itsRandom) % static_cast<uint64_t>(i + 1)]);
+    }
+    for (int i = 0 ; i < COUNT ; i++) {
+        MctsNode& child = aSearch.itsNodes[FIRST + i];
+        child.itsMove = aWorker.itsMoves.itsMoves[i];
+        child.itsFirstChild = -1;
+        child.itsChildCount = 0;
+        child.itsVisits.store(0, memory_order_relaxed);
+        child.itsVirtualLoss.store(0, memory_order_relaxed);
+        child.itsResults.store(0, memory_order_relaxed);
+        child.itsState.store(MCTS_LEAF, memory_order_relaxed);
+        child.itsMover = MOVER;
+    }
+    aNode.itsFirstChild = FIRST;
+    aNode.itsChildCount = COUNT;
+    aNode.itsState.store(MCTS_EXPANDED, memory_order_release);
+}
+
+/**
+ * @brief Chooses the child of a node with UCT.
+ *
+ * The threads currently going through a child count as lost playouts of this child.
+ *
+ * @return The index of the child.
+ */
+static int selectChild(const MctsSearch& aSearch, const MctsNode& aNode) {
+    const int PARENT = aNode.itsVisits.load(memory_order_relaxed) + aNode.itsVirtualLoss.load(memory_order_relaxed);
+    const double LOG_PARENT = log(static_cast<double>(max(PARENT, 1)));
+    int best = aNode.itsFirstChild;
+    double bestValue = -1;
+    for (int index = aNode.itsFirstChild ; index < aNode.itsFirstChild + aNode.itsChildCount ; index++) {
+        const MctsNode& child = aSearch.itsNodes[index];
+        const int VISITS = child.itsVisits.load(memory_order_relaxed) + child.itsVirtualLoss.load(memory_order_relaxed);
+        if (VISITS == 0) {
+            return index;
+        }
+        const double MEAN = static_cast<double>(child.itsResults.load(memory_order_relaxed)) / (static_cast<double>(MCTS_RESULT_UNIT) * VISITS);
+        const double VALUE = MEAN + MCTS_EXPLORATION * sqrt(LOG_PARENT / VISITS);
+        if (VALUE > bestValue) {
+            bestValue = VALUE;
+            best = index;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Plays random moves until the end of the game or `MCTS_ROLLOUT_PLIES`.
+ *
+ * @return The result for ATTACK, from 0 (lost) to `MCTS_RESULT_UNIT` (won).
+ */
+static int runRollout(MctsWorker& aWorker) {
+    Game& game = aWorker.itsGame;
+    PlayerRole winner;
+    for (int ply = 0 ; ply < MCTS_ROLLOUT_PLIES ; ply++) {
+        if (getWinner(game, winner)) {
+            return (winner == ATTACK) ? MCTS_RESULT_UNIT : 0;
+        }
+        const int COUNT = generateMoves(game, aWorker.itsMoves);
+        if (COUNT == 0) {
+            return (game.itsCurrentPlayer->itsRole == ATTACK) ? 0 : MCTS_RESULT_UNIT;
+        }
+        makeMove(game, aWorker.itsMoves.itsMoves[nextRandom(aWorker.itsRandom) % static_cast<uint64_t>(COUNT)]);
+    }
+    if (getWinner(game, winner)) {
+        return (winner == ATTACK) ? MCTS_RESULT_UNIT : 0;
+    }
+    //a cut rollout is scored by the evaluation, as a win probability
+    const int SCORE = evaluatePosition(game) * ((game.itsCurrentPlayer->itsRole == ATTACK) ? 1 : -1);
+    return static_cast<int>(lround(MCTS_RESULT_UNIT / (1.0 + exp(-SCORE / EVAL_SCALE))));
+}
+
+/**
+ * @brief Plays one playout: selection, expansion, rollout and update of the path.
+ */
+static void runPlayout(const Game& aRoot, MctsSearch& aSearch, MctsWorker& aWorker) {
+    copyRootPosition(aRoot, aWorker.itsGame);
+    int depth = 0;
+    aWorker.itsPath[0] = 0;
+    aSearch.itsNodes[0].itsVirtualLoss.fetch_add(1, memory_order_relaxed);
+    int result = -1;
+    while (true) {
+        MctsNode& node = aSearch.itsNodes[aWorker.itsPath[depth]];
+        unsigned char state = node.itsState.load(memory_order_acquire);
+        //the first thread reaching a visited leaf expands it, the others play out from it
+        if (state == MCTS_LEAF && (depth == 0 || node.itsVisits.load(memory_order_relaxed) > 0)) {
+            unsigned char expected = MCTS_LEAF;
+            if (node.itsState.compare_exchange_strong(expected, MCTS_EXPANDING, memory_order_acquire)) {
+                expandNode(aSearch, node, aWorker);
+                state = node.itsState.load(memory_order_relaxed);
+            }
+        }
+        if (state == MCTS_TERMINAL) {
+            result = (node.itsWinner == ATTACK) ? MCTS_RESULT_UNIT : 0;
+            break;
+        }
+        if (state != MCTS_EXPANDED || node.itsChildCount == 0 || depth + 1 == MCTS_MAX_DEPTH) {
+            break;
+        }
+        const int CHILD = selectChild(aSearch, node);
+        aSearch.itsNodes[CHILD].itsVirtualLoss.fetch_add(1, memory_order_relaxed);
+        makeMove(aWorker.itsGame, aSearch.itsNodes[CHILD].itsMove);
+        aWorker.itsPath[++depth] = CHILD;
+    }
+    if (result == -1) {
+        result = runRollout(aWorker);
+    }
+    aWorker.itsMaxDepth = max(aWorker.itsMaxDepth, depth);
+    for (int level = 0 ; level <= depth ; level++) {
+        MctsNode& node = aSearch.itsNodes[aWorker.itsPath[level]];
+        node.itsResults.fetch_add((node.itsMover == ATTACK) ? result : MCTS_RESULT_UNIT - result, memory_order_relaxed);
+        node.itsVisits.fetch_add(1, memory_order_relaxed);
+        node.itsVirtualLoss.fetch_sub(1, memory_order_relaxed);
+    }
+    PROFILE_COUNT(PROFILE_SEARCH_NODE);
+}
+
+/**
+ * @brief Body of a thread: plays playouts until the deadline, the playout limit or the stop signal.
+ */
+static void runWorker(const Game& aRoot, MctsSearch& aSearch, MctsWorker& aWorker, steady_clock::time_point aDeadline,
+                      long long aMaxPlayouts) {
+    while (!aSearch.itsStopSignal.load(memory_order_relaxed)) {
+        const long long PLAYOUT = aSearch.itsPlayouts.fetch_add(1, memory_order_relaxed);
+        if ((aMaxPlayouts > 0 && PLAYOUT >= aMaxPlayouts)
+            || (aWorker.itsPlayouts % CLOCK_INTERVAL == 0 && aWorker.itsPlayouts > 0 && steady_clock::now() >= aDeadline)) {
+            aSearch.itsStopSignal.store(true, memory_order_relaxed);
+            break;
+        }
+        runPlayout(aRoot, aSearch, aWorker);
+        aWorker.itsPlayouts++;
+    }
+}
+
+// ============================================================================
+// SECTION 3: SEARCH
+// ============================================================================
+
+/**
+ * @brief Searches the best move of the current player with playouts.
+ *
+ * A new tree is grown from the position at each call. With one thread and a playout limit,
+ * the search only depends on the position and the seed.
+ *
+ * @param aGame The game to search (the board must have its bitboards, it is not modified).
+ * @param aSearch The search (must be created).
+ * @param aTimeBudgetMs Maximum time of the search (in milliseconds).
+ * @param aMaxPlayouts Maximum number of playouts (0 for no limit).
+ * @return The most visited move; `itsScore` is the mean result of the move scaled to ±1000,
+ *         `itsDepth` the deepest node of the tree and `itsNodes` the number of playouts.
+ */
+AiResult searchMctsMove(const Game& aGame, MctsSearch& aSearch, int aTimeBudgetMs, long long aMaxPlayouts) {
+    PROFILE_SCOPE(PROFILE_SEARCH);
+    AiResult result;
+    const steady_clock::time_point START = steady_clock::now();
+    if (aSearch.itsNodes == nullptr || aGame.itsBoard.itsCells == nullptr) {
+        return result;
+    }
+    //the root is expanded before the threads start (a finished game or a player without moves has nothing to play)
+    MctsWorker& main = aSearch.itsWorkers[0];
+    for (int worker = 0 ; worker < aSearch.itsThreadCount ; worker++) {
+        MctsWorker& state = aSearch.itsWorkers[worker];
+        state.itsRandom = aSearch.itsSeed + aGame.itsBoard.itsHash + 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(worker);
+        state.itsPlayouts = 0;
+        state.itsMaxDepth = 0;
+    }
+    MctsNode& root = aSearch.itsNodes[0];
+    root.itsFirstChild = -1;
+    root.itsChildCount = 0;
+    root.itsVisits.store(0, memory_order_relaxed);
+    root.itsVirtualLoss.store(0, memory_order_relaxed);
+    root.itsResults.store(0, memory_order_relaxed);
+    root.itsMover = (aGame.itsCurrentPlayer->itsRole == ATTACK) ? DEFENSE : ATTACK;
+    aSearch.itsNodeCount.store(1, memory_order_relaxed);
+    copyRootPosition(aGame, main.itsGame);
+    root.itsState.store(MCTS_EXPANDING, memory_order_relaxed);
+    expandNode(aSearch, root, main);
+    if (root.itsState.load(memory_order_relaxed) != MCTS_EXPANDED || root.itsChildCount == 0) {
+        return result;
+    }
+    result.itsBestMove = aSearch.itsNodes[root.itsFirstChild].itsMove;
+    //a single move needs no playout
+    if (root.itsChildCount > 1) {
+        const steady_clock::time_point DEADLINE = START + milliseconds(aTimeBudgetMs);
+        aSearch.itsStopSignal.store(false, memory_order_relaxed);
+        aSearch.itsPlayouts.store(0, memory_order_relaxed);
+        thread helpers[AI_MAX_THREADS];
+        for (int helper = 1 ; helper < aSearch.itsThreadCount ; helper++) {
+            helpers[helper] = thread(runWorker, cref(aGame), ref(aSearch), ref(aSearch.itsWorkers[helper]), DEADLINE, aMaxPlayouts);
+        }
+        runWorker(aGame, aSearch, main, DEADLINE, aMaxPlayouts);
+        for (int helper = 1 ; helper < aSearch.itsThreadCount ; helper++) {
+            helpers[helper].join();
+        }
+    }
+    //the most visited move is the most reliable one
+    int best = root.itsFirstChild;
+    for (int index = root.itsFirstChild + 1 ; index < root.itsFirstChild + root.itsChildCount ; index++) {
+        const MctsNode& child = aSearch.itsNodes[index];
+        const MctsNode& current = aSearch.itsNodes[best];
+        if (child.itsVisits.load(memory_order_relaxed) > current.itsVisits.load(memory_order_relaxed)
+            || (child.itsVisits.load(memory_order_relaxed) == current.itsVisits.load(memory_order_relaxed)
+                && child.itsResults.load(memory_order_relaxed) > current.itsResults.load(memory_order_relaxed))) {
+            best = index;
+        }
+    }
+    const MctsNode& chosen = aSearch.itsNodes[best];
+    result.itsBestMove = chosen.itsMove;
+    const int VISITS = chosen.itsVisits.load(memory_order_relaxed);
+    if (VISITS > 0) {
+        const double MEAN = static_cast<double>(chosen.itsResults.load(memory_order_relaxed)) / (static_cast<double>(MCTS_RESULT_UNIT) * VISITS);
+        result.itsScore = static_cast<int>(lround((2 * MEAN - 1) * 1000));
+    }
+    for (int worker = 0 ; worker < aSearch.itsThreadCount ; worker++) {
+        result.itsNodes += aSearch.itsWorkers[worker].itsPlayouts;
+        result.itsDepth = max(result.itsDepth, aSearch.itsWorkers[worker].itsMaxDepth);
+    }
+    result.itsElapsedMs = duration_cast<milliseconds>(steady_clock::now() - START).count();
+    return result;
+}
@@ -0,0 +1,356 @@
+/**
+ * @file notation.cpp
+ *
+ * @brief Implementation of the one-line text notation of the positions and of the moves.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <cstring>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/engine.h"
+#include "../Headers/notation.h"
+
+using namespace std;
+
+/**
+ * @brief Letter of each PieceType in a position (NONE is written as a run of empty cells).
+ */
+static const char PIECE_LETTERS[4] = {'1', 'd', 'a', 'k'};
+
+/**
+ * @brief Letter of each PlayerRole after a position.
+ */
+static const char ROLE_LETTERS[2] = {'a', 'd'};
+
+/**
+ * @brief Row letters of `displayBoard()`.
+ */
+static const char ROW_LETTERS[] = "ABCDEFGHIJKLM";
+
+/**
+ * @brief Removes the spaces and line ends at the end of a text.
+ *
+ * @param aText The text to trim.
+ * @return The text without its trailing blanks.
+ */
+static string_view trimEnd(string_view aText) {
+    size_t length = aText.size();
+    while (length > 0 && (aText[length - 1] == ' ' || aText[length - 1] == '\t' || aText[length - 1] == '\r' || aText[length - 1] == '\n')) {
+        length--;
+    }
+    return aText.substr(0, length);
+}
+
+// ============================================================================
+// SECTION 1: POSITIONS
+// ============================================================================
+
+/**
+ * @brief Writes a run of empty cells (1-13) in a buffer.
+ *
+ * @param aRun The number of empty cells.
+ * @param aBuffer The buffer.
+ * @param aLength The length of the text, increased by the written digits.
+ */
+static void writeRun(int aRun, char* aBuffer, int& aLength) {
+    if (aRun >= 10) {
+        aBuffer[aLength++] = '1';
+        aRun -= 10;
+    }
+    aBuffer[aLength++] = static_cast<char>('0' + aRun);
+}
+
+/**
+ * @brief Writes the position of a game in the text notation.
+ *
+ * @param aGame The game to write (`itsCells` allocated).
+ * @param aBuffer The buffer receiving the text (0 terminated).
+ * @param aCapacity The size of the buffer (`POSITION_TEXT_CAPACITY` is always enough).
+ * @return The length of the text, or -1 if the buffer is too small or the board is not valid.
+ */
+int formatPosition(const Game& aGame, char* aBuffer, int aCapacity) {
+    const Board& BOARD = aGame.itsBoard;
+    const int SIZE = BOARD.itsSize;
+    if (BOARD.itsCells == nullptr || (SIZE != LITTLE && SIZE != BIG) || aBuffer == nullptr || aGame.itsCurrentPlayer == nullptr) {
+        return -1;
+    }
+    //written on the stack, then copied if it fits
+    char text[POSITION_TEXT_CAPACITY];
+    int length = 0;
+    for (int row = 0 ; row < SIZE ; row++) {
+        if (row > 0) {
+            text[length++] = '/';
+        }
+        int run = 0;
+        for (int col = 0 ; col < SIZE ; col++) {
+            const PieceType PIECE = BOARD.itsCells[row][col].itsPieceType;
+            if (PIECE == NONE) {
+                run++;
+                continue;
+            }
+            if (run > 0) {
+                writeRun(run, text, length);
+                run = 0;
+            }
+            text[length++] = PIECE_LETTERS[PIECE & 3];
+        }
+        if (run > 0) {
+            writeRun(run, text, length);
+        }
+    }
+    text[length++] = ' ';
+    text[length++] = ROLE_LETTERS[aGame.itsCurrentPlayer->itsRole == DEFENSE];
+    if (length + 1 > aCapacity) {
+        return -1;
+    }
+    memcpy(aBuffer, text, length);
+    aBuffer[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Sets the cell types of a snapshot and checks that only the KING is on a special cell.
+ *
+ * @tparam SIZE The size of the board.
+ * @param aSnapshot The snapshot holding the pieces.
+ * @return `true` if no SWORD or SHIELD is on a FORTRESS or the CASTLE.
+ */
+template <int SIZE>
+static bool setCellTypes(GameSnapshot& aSnapshot) {
+    for (int row = 0 ; row < SIZE ; row++) {
+        for (int col = 0 ; col < SIZE ; col++) {
+            Cell& cell = aSnapshot.itsCells[row][col];
+            cell.itsCellType = Engine<SIZE>::cellType(row, col);
+            if (cell.itsCellType != NORMAL && cell.itsPieceType != NONE && cell.itsPieceType != KING) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a position written in the text notation into a game.
+ *
+ * The position is fully checked before the game is modified: every row has the same width,
+ * the size is LITTLE or BIG, there is at most one KING and only the KING is on a special cell.
+ * Trailing spaces and line ends are ignored. Player 1 attacks and player 2 defends
+ * (the names and `itsIsComputer` are kept), the bitboards and the key are rebuilt.
+ *
+ * @param aText The text to read.
+ * @param aGame The game to overwrite (its board is created or resized if needed).
+ * @return `true` if the position was read, `false` if the text is not valid (the game is not modified).
+ */
+bool parsePosition(string_view aText, Game& aGame) {
+    const string_view TEXT = trimEnd(aText);
+    const size_t LENGTH = TEXT.size();
+    GameSnapshot snapshot;
+    int row = 0;
+    int col = 0;
+    int width = -1;
+    int kingCount = 0;
+    size_t index = 0;
+    for ( ; index < LENGTH && TEXT[index] != ' ' ; index++) {
+        const char LETTER = TEXT[index];
+        PieceType piece;
+        switch (LETTER) {
+            case '/':
+                //the first row gives the size, the others must have the same width
+                if (width == -1) {
+                    if (col != LITTLE && col != BIG) {
+                        return false;
+                    }
+                    width = col;
+                } else if (col != width) {
+                    return false;
+                }
+                if (++row >= width) {
+                    return false;
+                }
+                col = 0;
+                continue;
+            case 'a':
+                piece = SWORD;
+                break;
+            case 'd':
+                piece = SHIELD;
+                break;
+            case 'k':
+                piece = KING;
+                kingCount++;
+                break;
+            default:
+                if (LETTER < '1' || LETTER > '9') {
+                    return false;
+                }
+                //a run of empty cells (one or two digits, the cells are already empty)
+                col += LETTER - '0';
+                if (index + 1 < LENGTH && TEXT[index + 1] >= '0' && TEXT[index + 1] <= '9') {
+                    col += (LETTER - '0') * 9 + TEXT[++index] - '0';
+                }
+                if (col > BIG) {
+                    return false;
+                }
+                continue;
+        }
+        if (col >= BIG) {
+            return false;
+        }
+        snapshot.itsCells[row][col++].itsPieceType = piece;
+    }
+    //the board must be square, followed by a single space and the role to move
+    if (width == -1 || col != width || row != width - 1 || kingCount > 1) {
+        return false;
+    }
+    if (index + 2 != LENGTH || (TEXT[index + 1] != ROLE_LETTERS[ATTACK] && TEXT[index + 1] != ROLE_LETTERS[DEFENSE])) {
+        return false;
+    }
+    snapshot.itsSize = static_cast<BoardSize>(width);
+    if (!((width == LITTLE) ? setCellTypes<LITTLE>(snapshot) : setCellTypes<BIG>(snapshot))) {
+        return false;
+    }
+    snapshot.itsIsComputer[0] = aGame.itsPlayer1.itsIsComputer;
+    snapshot.itsIsComputer[1] = aGame.itsPlayer2.itsIsComputer;
+    snapshot.itsCurrentPlayer = (TEXT[index + 1] == ROLE_LETTERS[ATTACK]) ? 1 : 2;
+    if (!restoreSnapshot(snapshot, aGame)) {
+        return false;
+    }
+    aGame.itsBoard.itsHash = computeHash(aGame.itsBoard, aGame.itsCurrentPlayer->itsRole);
+    return true;
+}
+
+// ============================================================================
+// SECTION 2: MOVES
+// ============================================================================
+
+/**
+ * @brief Writes a position of a move (row letter, column number).
+ *
+ * @param aPos The position (row and column between 0 and 12).
+ * @param aBuffer The buffer.
+ * @param aLength The length of the text, increased by the written characters.
+ */
+static void writeCoordinates(const Position& aPos, char* aBuffer, int& aLength) {
+    aBuffer[aLength++] = ROW_LETTERS[aPos.itsRow];
+    const int NUMBER = aPos.itsCol + 1;
+    if (NUMBER >= 10) {
+        aBuffer[aLength++] = '1';
+    }
+    aBuffer[aLength++] = static_cast<char>('0' + NUMBER % 10);
+}
+
+/**
+ * @brief Writes the coordinates of a cell in the text notation (`D4`).
+ *
+ * @param aPos The position (row and column between 0 and 12).
+ * @param aBuffer The buffer receiving the text (0 terminated).
+ * @param aCapacity The size of the buffer (4 bytes are always enough).
+ * @return The length of the text, or -1 if the buffer is too small or the position is out of range.
+ */
+int formatCell(const Position& aPos, char* aBuffer, int aCapacity) {
+    if (aBuffer == nullptr || aPos.itsRow < 0 || aPos.itsRow >= BIG || aPos.itsCol < 0 || aPos.itsCol >= BIG) {
+        return -1;
+    }
+    char text[4];
+    int length = 0;
+    writeCoordinates(aPos, text, length);
+    if (length + 1 > aCapacity) {
+        return -1;
+    }
+    memcpy(aBuffer, text, length);
+    aBuffer[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Writes a move in the text notation.
+ *
+ * @param aMove The move to write (rows and columns between 0 and 12).
+ * @param aBuffer The buffer receiving the text (0 terminated).
+ * @param aCapacity The size of the buffer (`MOVE_TEXT_CAPACITY` is always enough).
+ * @return The length of the text, or -1 if the buffer is too small or a position is out of range.
+ */
+int formatMove(const Move& aMove, char* aBuffer, int aCapacity) {
+    for (const Position& POS : {aMove.itsStartPosition, aMove.itsEndPosition}) {
+        if (POS.itsRow < 0 || POS.itsRow >= BIG || POS.itsCol < 0 || POS.itsCol >= BIG) {
+            return -1;
+        }
+    }
+    if (aBuffer == nullptr) {
+        return -1;
+    }
+    char text[MOVE_TEXT_CAPACITY];
+    int length = 0;
+    writeCoordinates(aMove.itsStartPosition, text, length);
+    text[length++] = '-';
+    writeCoordinates(aMove.itsEndPosition, text, length);
+    if (length + 1 > aCapacity) {
+        return -1;
+    }
+    memcpy(aBuffer, text, length);
+    aBuffer[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Reads a position of a move (row letter, column number of 1 or 2 digits).
+ *
+ * @param aText The text to read.
+ * @param anIndex The index of the first character, moved after the position.
+ * @param aSize The size of the board.
+ * @param aPos The position receiving the coordinates.
+ * @return `true` if the position was read and is on the board.
+ */
+static bool readCoordinates(string_view aText, size_t& anIndex, int aSize, Position& aPos) {
+    if (anIndex + 1 >= aText.size()) {
+        return false;
+    }
+    const char LETTER = aText[anIndex];
+    if (LETTER >= 'a' && LETTER <= 'z') {
+        aPos.itsRow = LETTER - 'a';
+    } else if (LETTER >= 'A' && LETTER <= 'Z') {
+        aPos.itsRow = LETTER - 'A';
+    } else {
+        return false;
+    }
+    const char FIRST_DIGIT = aText[anIndex + 1];
+    if (FIRST_DIGIT < '1' || FIRST_DIGIT > '9') {
+        return false;
+    }
+    int number = FIRST_DIGIT - '0';
+    anIndex += 2;
+    if (anIndex < aText.size() && aText[anIndex] >= '0' && aText[anIndex] <= '9') {
+        number = number * 10 + aText[anIndex++] - '0';
+    }
+    aPos.itsCol = number - 1;
+    return aPos.itsRow < aSize && aPos.itsCol < aSize;
+}
+
+/**
+ * @brief Reads a move written in the text notation.
+ *
+ * Only the syntax and the bounds are checked, not the rules (see `checkMovement()`).
+ *
+ * @param aText The text to read (trailing spaces and line ends are ignored).
+ * @param aSize The size of the board.
+ * @param aMove The move receiving the coordinates.
+ * @return `true` if the move was read and both positions are on the board.
+ */
+bool parseMove(string_view aText, BoardSize aSize, Move& aMove) {
+    const string_view TEXT = trimEnd(aText);
+    size_t index = 0;
+    Move move;
+    if (!readCoordinates(TEXT, index, aSize, move.itsStartPosition)) {
+        return false;
+    }
+    if (index < TEXT.size() && TEXT[index] == '-') {
+        index++;
+    }
+    if (!readCoordinates(TEXT, index, aSize, move.itsEndPosition) || index != TEXT.size()) {
+        return false;
+    }
+    aMove = move;
+    return true;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file perft.cpp
+ *
+ * @brief Implementation of the perft counter and of the hot path benchmark.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <chrono>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/perft.h"
+#include "../Headers/engine.h"
+#include "../Headers/evalfeatures.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ============================================================================
+// SECTION 1: PERFT
+// ============================================================================
+
+/**
+ * @brief Counts the positions reachable with the engine of one board size.
+ *
+ * @tparam SIZE The size of the board.
+ * @param aGame The start position (modified during the count and restored).
+ * @param aDepth The number of plies (at least 1).
+ * @return The number of leaf positions.
+ */
+template <int SIZE>
+static long long perftOf(Game& aGame, int aDepth) {
+    //a finished game has no moves
+    if (isGameFinished(aGame)) {
+        return 0;
+    }
+    MoveList moves;
+    const int COUNT = Engine<SIZE>::generateMoves(aGame, moves);
+    if (aDepth == 1) {
+        return COUNT;
+    }
+    long long nodes = 0;
+    for (int i = 0 ; i < COUNT ; i++) {
+        MoveUndo undo = Engine<SIZE>::makeMove(aGame, moves.itsMoves[i]);
+        nodes += perftOf<SIZE>(aGame, aDepth - 1);
+        unmakeMove(aGame, undo);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Counts the positions reachable in exactly `aDepth` plies.
+ *
+ * The last ply is counted with the size of the move list (bulk counting).
+ * The engine of the board size is picked once, the whole count runs in it.
+ *
+ * @param aGame The start position (modified during the count and restored).
+ * @param aDepth The number of plies (0 returns 1).
+ * @return The number of leaf positions (0 for boards other than LITTLE or BIG).
+ */
+long long perft(Game& aGame, int aDepth) {
+    if (aDepth <= 0) {
+        return 1;
+    }
+    switch (aGame.itsBoard.itsSize) {
+        case LITTLE:
+            return perftOf<LITTLE>(aGame, aDepth);
+        case BIG:
+            return perftOf<BIG>(aGame, aDepth);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Gets the stored reference count of a starting position.
+ *
+ * @param aSize The size of the board.
+ * @param aDepth The depth.
+ * @return The reference count, or -1 if it is not known.
+ */
+long long perftReference(BoardSize aSize, int aDepth) {
+    if (aDepth == 0) {
+        return 1;
+    }
+    if (aDepth < 0 || aDepth > PERFT_REFERENCE_DEPTHS || (aSize != LITTLE && aSize != BIG)) {
+        return -1;
+    }
+    return PERFT_REFERENCE[aSize == BIG][aDepth - 1];
+}
+
+// ============================================================================
+// SECTION 2: HOT PATH BENCHMARK
+// ============================================================================
+
+/**
+ * @brief Number of positions used by the benchmark.
+ */
+static const int BENCH_POSITIONS = 64;
+
+/**
+ * @brief Receives the results of the measured calls, so the compiler can't remove them.
+ */
+static volatile long long benchSink = 0;
+
+/**
+ * @brief Converts a count and a duration into a rate.
+ */
+static double toRate(long long aCount, steady_clock::time_point aStart) {
+    const double SECONDS = duration<double>(steady_clock::now() - aStart).count();
+    return (SECONDS > 0) ? aCount / SECONDS : 0;
+}
+
+/**
+ * @brief Measures the speed of the hot paths on positions of a fixed random game.
+ *
+ * @param aSize The size of the board.
+ * @param aRounds Number of passes over the positions (more rounds give a steadier measure).
+ * @return The measured rates.
+ */
+HotPathRates benchmarkHotPaths(BoardSize aSize, int aRounds) {
+    HotPathRates rates;
+    //positions of one game played with a fixed pseudo-random sequence
+    Game* games = new Game[BENCH_POSITIONS];
+    int positions = 0;
+    Game game;
+    game.itsBoard.itsSize = aSize;
+    if (!createBoard(game.itsBoard)) {
+        delete[] games;
+        return rates;
+    }
+    initializeBoard(game.itsBoard);
+    MoveList moves;
+    unsigned int seed = 2025;
+    while (positions < BENCH_POSITIONS && !isGameFinished(game) && generateMoves(game, moves) > 0) {
+        restoreSnapshot(takeSnapshot(game), games[positions++]);
+        seed = seed * 1103515245u + 12345u;
+        makeMove(game, moves.itsMoves[(seed >> 16) % moves.itsCount]);
+    }
+    deleteBoard(game.itsBoard);
+
+    //move generation
+    long long calls = 0;
+    long long generated = 0;
+    steady_clock::time_point start = steady_clock::now();
+    for (int round = 0 ; round < aRounds ; round++) {
+        for (int position = 0 ; position < positions ; position++) {
+            generated += generateMoves(games[position], moves);
+            calls++;
+        }
+    }
+    rates.itsGeneratePerSecond = toRate(calls, start);
+    rates.itsMovesPerSecond = toRate(generated, start);
+
+    //make/unmake of every move of every position (one generation per position is included)
+    long long pairs = 0;
+    start = steady_clock::now();
+    for (int round = 0 ; round < aRounds ; round++) {
+        for (int position = 0 ; position < positions ; position++) {
+            const int COUNT = generateMoves(games[position], moves);
+            for (int i = 0 ; i < COUNT ; i++) {
+                MoveUndo undo = makeMove(games[position], moves.itsMoves[i]);
+                unmakeMove(games[position], undo);
+            }
+            pairs += COUNT;
+        }
+    }
+    rates.itsMakeUnmakePerSecond = toRate(pairs, start);
+
+    //endgame checks (much cheaper, so 100 times more passes)
+    long long checks = 0;
+    long long finished = 0;
+    start = steady_clock::now();
+    for (int round = 0 ; round < aRounds * 100 ; round++) {
+        for (int position = 0 ; position < positions ; position++) {
+            finished += isGameFinished(games[position]);
+            checks++;
+        }
+    }
+    rates.itsGameFinishedPerSecond = toRate(checks, start);
+
+    //evaluation features and whole-board scans
+    long long features = 0;
+    long long mobility = 0;
+    EvalFeatures evalFeatures;
+    start = steady_clock::now();
+    for (int round = 0 ; round < aRounds * 10 ; round++) {
+        for (int position = 0 ; position < positions ; position++) {
+            computeEvalFeatures(games[position].itsBoard, evalFeatures);
+            mobility += evalFeatures.itsAttackMobility;
+            features++;
+        }
+    }
+    rates.itsFeaturesPerSecond = toRate(features, start);
+    long long scans = 0;
+    BitBoard pieceMasks[4];
+    BitBoard cellMasks[3];
+    start = steady_clock::now();
+    for (int round = 0 ; round < aRounds * 10 ; round++) {
+        for (int position = 0 ; position < positions ; position++) {
+            scanBoardMasks(games[position].itsBoard, pieceMasks, cellMasks);
+            mobility += pieceMasks[SWORD].itsWords[0] & 1;
+            scans++;
+        }
+    }
+    rates.itsScansPerSecond = toRate(scans, start);
+    benchSink = finished + generated + mobility;
+
+    for (int position = 0 ; position < positions ; position++) {
+        deleteBoard(games[position].itsBoard);
+    }
+    delete[] games;
+    return rates;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file player.cpp
+ *
+ * @brief Implementation of the computer player, searching with alpha-beta or with MCTS.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include "../Headers/typeDef.h"
+#include "../Headers/ai.h"
+#include "../Headers/mcts.h"
+#include "../Headers/player.h"
+
+using namespace std;
+
+/**
+ * @brief Gets the name of an engine.
+ *
+ * @param anEngine The engine.
+ * @return "alphabeta" or "mcts".
+ */
+const char* getEngineName(EngineKind anEngine) {
+    return (anEngine == ENGINE_MCTS) ? "mcts" : "alphabeta";
+}
+
+/**
+ * @brief Reads the name of an engine.
+ *
+ * @param aText "alphabeta" or "mcts".
+ * @param anEngine Set to the engine if the name is known.
+ * @return `true` if the name is known.
+ */
+bool parseEngineName(string_view aText, EngineKind& anEngine) {
+    if (aText == "alphabeta") {
+        anEngine = ENGINE_ALPHA_BETA;
+        return true;
+    }
+    if (aText == "mcts") {
+        anEngine = ENGINE_MCTS;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Creates a computer player with the default sizes of its engine.
+ *
+ * @param aPlayer The player to create (must not be already created).
+ * @param anEngine The engine.
+ * @param aThreadCount Number of search threads (`AI_ALL_CORES` for one per core).
+ * @return `true` if the allocation succeeded, `false` otherwise.
+ */
+bool createComputerPlayer(ComputerPlayer& aPlayer, EngineKind anEngine, int aThreadCount) {
+    aPlayer.itsEngine = anEngine;
+    if (anEngine == ENGINE_MCTS) {
+        return createMcts(aPlayer.itsMcts, MCTS_NODE_BITS, aThreadCount);
+    }
+    return createAi(aPlayer.itsSearch, AI_TABLE_BITS, aThreadCount);
+}
+
+/**
+ * @brief Releases a computer player.
+ *
+ * @param aPlayer The player to release.
+ */
+void deleteComputerPlayer(ComputerPlayer& aPlayer) {
+    deleteAi(aPlayer.itsSearch);
+    deleteMcts(aPlayer.itsMcts);
+}
+
+/**
+ * @brief Chooses the move of the current player.
+ *
+ * @param aGame The game (restored before returning).
+ * @param aPlayer The computer player (must be created).
+ * @param aTimeBudgetMs Maximum time of the search (in milliseconds).
+ * @return The move and the statistics of the search (the best move is -1 if the player has no legal move).
+ */
+AiResult chooseComputerMove(Game& aGame, ComputerPlayer& aPlayer, int aTimeBudgetMs) {
+    if (aPlayer.itsEngine == ENGINE_MCTS) {
+        return searchMctsMove(aGame, aPlayer.itsMcts, aTimeBudgetMs);
+    }
+    return searchBestMove(aGame, aPlayer.itsSearch, aTimeBudgetMs);
+}
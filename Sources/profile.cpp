@@ -0,0 +1,212 @@
+/**
+ * @file profile.cpp
+ *
+ * @brief Implementation of the optional instrumentation of the hot functions.
+ *
+ * The counters of the running threads are kept in a list protected by a mutex, which is only
+ * locked when a thread starts or ends and when the counters are collected or reset.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <cstdio>
+#include <mutex>
+#include "../Headers/profile.h"
+
+using namespace std;
+
+/**
+ * @brief Names of the instrumented functions, in `ProfilePoint` order.
+ */
+static const char* const POINT_NAMES[PROFILE_POINT_COUNT] = {
+    "isValidMovement", "capturePieces", "movePiece", "isGameFinished",
+    "generateMoves", "searchBestMove", "searchNode", "saveIO"
+};
+
+#ifdef HNEFATAFL_PROFILE
+
+/**
+ * @struct ProfileRegistry
+ * @brief The counters of the running threads and the sum of the finished ones.
+ */
+struct ProfileRegistry
+{
+    mutex itsMutex;                             /**< Protects the list and the finished counters. */
+    ProfileThreadCounters* itsFirst = nullptr;  /**< The running threads. */
+    ProfileCounter itsFinished[PROFILE_POINT_COUNT]; /**< Counters of the finished threads. */
+};
+
+/**
+ * @brief Gets the registry (created on first use, before any thread counters).
+ */
+static ProfileRegistry& getRegistry() {
+    static ProfileRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Registers the counters of a new thread.
+ */
+ProfileThreadCounters::ProfileThreadCounters() {
+    for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+        itsCalls[point].store(0, memory_order_relaxed);
+        itsCycles[point].store(0, memory_order_relaxed);
+    }
+    ProfileRegistry& registry = getRegistry();
+    lock_guard<mutex> lock(registry.itsMutex);
+    itsNext = registry.itsFirst;
+    registry.itsFirst = this;
+}
+
+/**
+ * @brief Adds the counters of a finished thread to the registry and unregisters them.
+ */
+ProfileThreadCounters::~ProfileThreadCounters() {
+    ProfileRegistry& registry = getRegistry();
+    lock_guard<mutex> lock(registry.itsMutex);
+    for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+        registry.itsFinished[point].itsCalls += itsCalls[point].load(memory_order_relaxed);
+        registry.itsFinished[point].itsCycles += itsCycles[point].load(memory_order_relaxed);
+    }
+    ProfileThreadCounters** link = &registry.itsFirst;
+    while (*link != this) {
+        link = &(*link)->itsNext;
+    }
+    *link = itsNext;
+}
+
+/**
+ * @brief Gets the counters of the calling thread (registered on first use).
+ *
+ * @return The counters.
+ */
+ProfileThreadCounters& getThreadProfile() {
+    thread_local ProfileThreadCounters counters;
+    return counters;
+}
+
+#endif // HNEFATAFL_PROFILE
+
+/**
+ * @brief Checks if the instrumentation is compiled in.
+ *
+ * @return `true` if the core was built with `HNEFATAFL_PROFILE`.
+ */
+bool isProfilingEnabled() {
+#ifdef HNEFATAFL_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Gets the name of an instrumented function.
+ *
+ * @param aPoint The instrumented function.
+ * @return Its name ("isValidMovement", ...), or "unknown".
+ */
+const char* getProfilePointName(ProfilePoint aPoint) {
+    if (aPoint < 0 || aPoint >= PROFILE_POINT_COUNT) {
+        return "unknown";
+    }
+    return POINT_NAMES[aPoint];
+}
+
+/**
+ * @brief Gets the name of the clock used for the ticks.
+ *
+ * @return "tsc" (x86 time stamp counter) or "ns" (steady clock).
+ */
+const char* getProfileClockName() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    return "tsc";
+#else
+    return "ns";
+#endif
+}
+
+/**
+ * @brief Adds the counters of all the threads (running or finished).
+ *
+ * @return The counters (all 0 without `HNEFATAFL_PROFILE`).
+ */
+ProfileReport collectProfile() {
+    ProfileReport report;
+#ifdef HNEFATAFL_PROFILE
+    report.itsIsEnabled = true;
+    ProfileRegistry& registry = getRegistry();
+    lock_guard<mutex> lock(registry.itsMutex);
+    for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+        report.itsCounters[point] = registry.itsFinished[point];
+    }
+    for (const ProfileThreadCounters* counters = registry.itsFirst ; counters != nullptr ; counters = counters->itsNext) {
+        for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+            report.itsCounters[point].itsCalls += counters->itsCalls[point].load(memory_order_relaxed);
+            report.itsCounters[point].itsCycles += counters->itsCycles[point].load(memory_order_relaxed);
+        }
+    }
+#endif
+    return report;
+}
+
+/**
+ * @brief Sets the counters of all the threads to 0.
+ */
+void resetProfile() {
+#ifdef HNEFATAFL_PROFILE
+    ProfileRegistry& registry = getRegistry();
+    lock_guard<mutex> lock(registry.itsMutex);
+    for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+        registry.itsFinished[point] = ProfileCounter();
+    }
+    //a running thread may add a call at the same time, it is only lost
+    for (ProfileThreadCounters* counters = registry.itsFirst ; counters != nullptr ; counters = counters->itsNext) {
+        for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+            counters->itsCalls[point].store(0, memory_order_relaxed);
+            counters->itsCycles[point].store(0, memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Formats a report as a text table (one line per function).
+ *
+ * @param aReport The report.
+ * @return The table, with its line ends.
+ */
+string formatProfileText(const ProfileReport& aReport) {
+    if (!aReport.itsIsEnabled) {
+        return "profiling not compiled in (build with HNEFATAFL_PROFILE)\n";
+    }
+    char line[128];
+    snprintf(line, sizeof(line), "%-16s %14s %18s %12s\n", "function", "calls", getProfileClockName(), "per call");
+    string text = line;
+    for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+        const ProfileCounter& counter = aReport.itsCounters[point];
+        const double PER_CALL = (counter.itsCalls == 0) ? 0.0 : static_cast<double>(counter.itsCycles) / counter.itsCalls;
+        snprintf(line, sizeof(line), "%-16s %14llu %18llu %12.1f\n", POINT_NAMES[point],
+                 static_cast<unsigned long long>(counter.itsCalls), static_cast<unsigned long long>(counter.itsCycles), PER_CALL);
+        text += line;
+    }
+    return text;
+}
+
+/**
+ * @brief Formats a report as one line of JSON (no line end).
+ *
+ * @param aReport The report.
+ * @return The JSON object.
+ */
+string formatProfileJson(const ProfileReport& aReport) {
+    string json = string("{\"enabled\":") + (aReport.itsIsEnabled ? "true" : "false")
+                + ",\"clock\":\"" + getProfileClockName() + "\",\"points\":{";
+    for (int point = 0 ; point < PROFILE_POINT_COUNT ; point++) {
+        const ProfileCounter& counter = aReport.itsCounters[point];
+        json += string((point == 0) ? "\"" : ",\"") + POINT_NAMES[point] + "\":{\"calls\":" + to_string(counter.itsCalls)
+              + ",\"cycles\":" + to_string(counter.itsCycles) + "}";
+    }
+    json += "}}";
+    return json;
+}
@@ -0,0 +1,414 @@
+/**
+ * @file render.cpp
+ *
+ * @brief Implementation of the buffered terminal renderer of the game screen.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <new>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+#include "../Headers/typeDef.h"
+#include "../Headers/render.h"
+
+using namespace std;
+
+/**
+ * @brief The lines of the logo (UTF-8, without line ends).
+ */
+const char* const HNEFATAFL_LOGO[LOGO_LINES] = {
+    "╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗",
+    "║     ■           ■                                                                ■■■■■■  ■■■■■■                                                           ║",
+    "║      ■■       ■■     ■■             ■■■■■■■■■       ■■■■■■■■■■      ■■■       ■■■■   ■■■■■■   ■■■■     ■■■              ■■■■■■■■■       ■■■■■             ║",
+    "║      ■■■     ■■■     ■■■■■■■■■       ■■■■    ■■      ■■■      ■■    ■■■■■   ■■        ■■■        ■■    ■■■■■             ■■■      ■■      ■■■             ║",
+    "║      ■■       ■■     ■■■■   ■■■    ■■■      ■      ■■■       ■     ■■■  ■■■            ■■■            ■■■  ■■■         ■■■       ■        ■■■             ║",
+    "║      ■■       ■■     ■■■     ■■■    ■■■             ■■■            ■■■   ■■■           ■■■            ■■■   ■■■         ■■■               ■■■             ║",
+    "║      ■■■     ■■■      ■■■     ■■■   ■■■             ■■■           ■■■    ■■■            ■■■          ■■■    ■■■         ■■■              ■■■              ║",
+    "║     ■■■■■   ■■■■■     ■■■     ■■■   ■■■■           ■■■■          ■■■     ■■■  ■■        ■■■         ■■■     ■■■  ■■    ■■■■              ■■■              ║",
+    "║    ■■■■■■■■■■■■■■     ■■■     ■■■  ■■■■■■ ■■      ■■■■■■ ■■     ■■■■■   ■■■■■■ ■■      ■■■         ■■■■■   ■■■■■■ ■■   ■■■■■■ ■■         ■■■              ║",
+    "║      ■■■■   ■■■■      ■■■     ■■■   ■■■             ■■■         ■■■  ■■■■  ■■■        ■■■          ■■■  ■■■■  ■■■       ■■■            ■■■                ║",
+    "║       ■■     ■■      ■■■     ■■■    ■■■             ■■■         ■■■      ■■■         ■■■           ■■■        ■■■       ■■■          ■■■                  ║",
+    "║      ■■■     ■■■     ■■■     ■■■    ■■■      ■      ■■■         ■■■      ■■■          ■■■          ■■■      ■■■         ■■■        ■■■                    ║",
+    "║      ■■       ■■     ■■     ■■      ■■■     ■■      ■■■         ■■■      ■■■       ■   ■■■  ■      ■■■      ■■■         ■■■       ■■■               ■■■   ║",
+    "║     ■           ■    ■     ■      ■■■■■■■■■■■     ■■■■■           ■■■      ■■■      ■■■■■■■■        ■■■      ■■■      ■■■■■        ■■■■■■■■■■■■■■■■■■     ║",
+    "╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝"
+};
+
+/**
+ * @brief Row letters of the board.
+ */
+static const char ROW_LETTERS[] = "ABCDEFGHIJKLM";
+
+/**
+ * @brief Screen column of the first cell of a board line (1-based, see `writeBoardText()`).
+ */
+static const int FIRST_CELL_COLUMN = 7;
+
+/**
+ * @brief Screen columns between two cells of a line.
+ */
+static const int CELL_WIDTH = 6;
+
+// ============================================================================
+// SECTION 1: TEXT COMPOSITION
+// ============================================================================
+
+/**
+ * @brief Appends text to a buffer.
+ *
+ * @param aBuffer The buffer.
+ * @param aText The text to append.
+ * @return `true` if it fit, `false` if the buffer is full (nothing is appended).
+ */
+bool appendText(TextBuffer& aBuffer, string_view aText) {
+    const int LENGTH = static_cast<int>(aText.size());
+    if (aBuffer.itsData == nullptr || aBuffer.itsLength + LENGTH > aBuffer.itsCapacity) {
+        return false;
+    }
+    memcpy(aBuffer.itsData + aBuffer.itsLength, aText.data(), LENGTH);
+    aBuffer.itsLength += LENGTH;
+    return true;
+}
+
+/**
+ * @brief Appends a positive number to a buffer.
+ *
+ * @param aBuffer The buffer.
+ * @param aNumber The number.
+ * @return `true` if it fit.
+ */
+static bool appendNumber(TextBuffer& aBuffer, int aNumber) {
+    char digits[12];
+    const to_chars_result RESULT = to_chars(digits, digits + sizeof(digits), aNumber);
+    return appendText(aBuffer, string_view(digits, RESULT.ptr - digits));
+}
+
+/**
+ * @brief Appends the escape sequence moving the cursor to a cell of the screen.
+ *
+ * @param aBuffer The buffer.
+ * @param aRow The row of the screen (1-based).
+ * @param aColumn The column of the screen (1-based).
+ * @return `true` if it fit.
+ */
+static bool appendCursor(TextBuffer& aBuffer, int aRow, int aColumn) {
+    return appendText(aBuffer, "\x1b[") && appendNumber(aBuffer, aRow) && appendText(aBuffer, ";")
+           && appendNumber(aBuffer, aColumn) && appendText(aBuffer, "H");
+}
+
+/**
+ * @brief Gets the symbol of a cell.
+ *
+ * @param aCell The cell.
+ * @return The piece, or the symbol of the cell type if it is empty.
+ */
+static string_view cellSymbol(const Cell& aCell) {
+    switch (aCell.itsPieceType) {
+        case KING:
+            return "♕";
+        case SHIELD:
+            return "♦";
+        case SWORD:
+            return "⚔";
+        default:
+            break;
+    }
+    switch (aCell.itsCellType) {
+        case NORMAL:
+            return " ";
+        case CASTLE:
+            return "x";
+        case FORTRESS:
+            return "♜";
+        default:
+            return "";
+    }
+}
+
+/**
+ * @brief Composes the text of a board, exactly as displayed by `displayBoard()`.
+ *
+ * @param aBoard The board to write (`itsSize` at most BIG).
+ * @param aBuffer The buffer receiving the text (`BOARD_TEXT_CAPACITY` bytes are always enough).
+ * @return `true` if the whole board fit in the buffer.
+ */
+bool writeBoardText(const Board& aBoard, TextBuffer& aBuffer) {
+    const int SIZE = aBoard.itsSize;
+    if (aBoard.itsCells == nullptr || SIZE <= 0 || SIZE > BIG) {
+        return false;
+    }
+    //column numbers
+    bool fits = appendText(aBuffer, "    ");
+    for (int column = 0 ; column < SIZE ; column++) {
+        fits = fits && appendText(aBuffer, "  ") && appendNumber(aBuffer, column + 1) && appendText(aBuffer, (column >= 9) ? "  " : "   ");
+    }
+    fits = fits && appendText(aBuffer, "\n   ╬");
+    for (int column = 0 ; column < SIZE ; column++) {
+        fits = fits && appendText(aBuffer, (column != SIZE - 1) ? "═════╬" : "═════╣");
+    }
+    fits = fits && appendText(aBuffer, "\n");
+    //one line of cells and one separator per row
+    for (int line = 0 ; line < SIZE && fits ; line++) {
+        fits = appendText(aBuffer, " ") && appendText(aBuffer, string_view(ROW_LETTERS + line, 1)) && appendText(aBuffer, " ║");
+        for (int column = 0 ; column < SIZE ; column++) {
+            fits = fits && appendText(aBuffer, "  ") && appendText(aBuffer, cellSymbol(aBoard.itsCells[line][column])) && appendText(aBuffer, "  ║");
+        }
+        fits = fits && appendText(aBuffer, (line != SIZE - 1) ? "\n   ╬" : "\n   ╩");
+        for (int column = 0 ; column < SIZE ; column++) {
+            if (column != SIZE - 1) {
+                fits = fits && appendText(aBuffer, (line != SIZE - 1) ? "═════╬" : "═════╩");
+            }
+            else {
+                fits = fits && appendText(aBuffer, (line != SIZE - 1) ? "═════╣" : "═════╝");
+            }
+        }
+        fits = fits && appendText(aBuffer, "\n");
+    }
+    return fits;
+}
+
+// ============================================================================
+// SECTION 2: RENDERER
+// ============================================================================
+
+/**
+ * @brief Screen row of the status line (1-based, the logo is above).
+ */
+static const int STATUS_ROW = LOGO_LINES + 1;
+
+/**
+ * @brief Gets the screen row of a line of cells (1-based).
+ *
+ * @param aLine The row of the board.
+ * @return The row of the screen (the column numbers and a separator are above the first line).
+ */
+static int cellScreenRow(int aLine) {
+    return STATUS_ROW + 3 + 2 * aLine;
+}
+
+/**
+ * @brief Allocates the frame buffer of a renderer.
+ *
+ * @param aRenderer The renderer to initialize.
+ * @return `true` if successful, `false` if the allocation failed.
+ */
+bool createRenderer(BoardRenderer& aRenderer) {
+    aRenderer.itsFrame.itsData = new (nothrow) char[RENDER_BUFFER_BYTES];
+    aRenderer.itsFrame.itsCapacity = (aRenderer.itsFrame.itsData != nullptr) ? RENDER_BUFFER_BYTES : 0;
+    aRenderer.itsFrame.itsLength = 0;
+    aRenderer.itsIsShown = false;
+    return aRenderer.itsFrame.itsData != nullptr;
+}
+
+/**
+ * @brief Frees the frame buffer of a renderer.
+ *
+ * @param aRenderer The renderer to release.
+ */
+void deleteRenderer(BoardRenderer& aRenderer) {
+    delete[] aRenderer.itsFrame.itsData;
+    aRenderer.itsFrame = TextBuffer();
+    aRenderer.itsIsShown = false;
+}
+
+/**
+ * @brief Forgets the screen content, so the next render draws a full frame.
+ *
+ * To call when something else changed the screen (console cleared, many lines printed).
+ *
+ * @param aRenderer The renderer.
+ */
+void invalidateRenderer(BoardRenderer& aRenderer) {
+    aRenderer.itsIsShown = false;
+}
+
+/**
+ * @brief Remembers the cells of a board as the cells on the screen.
+ *
+ * @param aRenderer The renderer.
+ * @param aBoard The drawn board.
+ */
+static void rememberBoard(BoardRenderer& aRenderer, const Board& aBoard) {
+    memcpy(aRenderer.itsShownCells, aBoard.itsCells, sizeof(CellRow) * aBoard.itsSize);
+    aRenderer.itsShownSize = aBoard.itsSize;
+    aRenderer.itsIsShown = true;
+}
+
+/**
+ * @brief Composes a full frame: clear screen, logo, status line and board.
+ *
+ * @param aRenderer The renderer (its previous frame is discarded).
+ * @param aBoard The board to draw.
+ * @param aStatus The status line (a single line).
+ * @return `true` if the frame fit in the buffer.
+ */
+bool composeFrame(BoardRenderer& aRenderer, const Board& aBoard, string_view aStatus) {
+    TextBuffer& frame = aRenderer.itsFrame;
+    frame.itsLength = 0;
+    aRenderer.itsIsShown = false;
+    //cursor home, then clear the screen
+    bool fits = appendText(frame, "\x1b[H\x1b[2J");
+    for (int line = 0 ; line < LOGO_LINES ; line++) {
+        fits = fits && appendText(frame, HNEFATAFL_LOGO[line]) && appendText(frame, "\n");
+    }
+    fits = fits && appendText(frame, aStatus) && appendText(frame, "\n") && writeBoardText(aBoard, frame);
+    if (!fits) {
+        frame.itsLength = 0;
+        return false;
+    }
+    rememberBoard(aRenderer, aBoard);
+    return true;
+}
+
+/**
+ * @brief Composes the changes since the last frame: the changed cells, the status line and the erased prompts.
+ *
+ * @param aRenderer The renderer (its previous frame is discarded).
+ * @param aBoard The board to draw (same size as the board on the screen).
+ * @param aStatus The status line (a single line).
+ * @return The number of redrawn cells, or -1 if a full frame is needed (nothing was composed).
+ */
+int composeUpdate(BoardRenderer& aRenderer, const Board& aBoard, string_view aStatus) {
+    TextBuffer& frame = aRenderer.itsFrame;
+    frame.itsLength = 0;
+    const int SIZE = aBoard.itsSize;
+    if (!aRenderer.itsIsShown || aRenderer.itsShownSize != aBoard.itsSize || aBoard.itsCells == nullptr) {
+        return -1;
+    }
+    int changed = 0;
+    bool fits = true;
+    for (int line = 0 ; line < SIZE && fits ; line++) {
+        //only the rows with a change are compared cell by cell
+        if (memcmp(aRenderer.itsShownCells[line], aBoard.itsCells[line], SIZE) == 0) {
+            continue;
+        }
+        for (int column = 0 ; column < SIZE ; column++) {
+            const Cell CELL = aBoard.itsCells[line][column];
+            const Cell SHOWN = aRenderer.itsShownCells[line][column];
+            if (CELL.itsPieceType == SHOWN.itsPieceType && CELL.itsCellType == SHOWN.itsCellType) {
+                continue;
+            }
+            fits = fits && appendCursor(frame, cellScreenRow(line), FIRST_CELL_COLUMN + CELL_WIDTH * column)
+                   && appendText(frame, cellSymbol(CELL));
+            changed++;
+        }
+    }
+    //new status line, then erase everything below the board
+    fits = fits && appendCursor(frame, STATUS_ROW, 1) && appendText(frame, aStatus) && appendText(frame, "\x1b[K")
+           && appendCursor(frame, cellScreenRow(SIZE), 1) && appendText(frame, "\x1b[J");
+    if (!fits) {
+        frame.itsLength = 0;
+        return -1;
+    }
+    rememberBoard(aRenderer, aBoard);
+    return changed;
+}
+
+/**
+ * @brief Writes the composed frame to the standard output with a single system call.
+ *
+ * `cout` is flushed first so the frame comes after the text already printed.
+ *
+ * @param aRenderer The renderer holding the frame.
+ * @return `true` if the whole frame was written.
+ */
+bool writeRenderer(const BoardRenderer& aRenderer) {
+    cout.flush();
+    fflush(stdout);
+    const char* data = aRenderer.itsFrame.itsData;
+    int remaining = aRenderer.itsFrame.itsLength;
+    //one call, unless the output only accepts a part of it
+    while (remaining > 0) {
+#ifdef _WIN32
+        const int WRITTEN = _write(1, data, remaining);
+#else
+        const int WRITTEN = static_cast<int>(write(STDOUT_FILENO, data, remaining));
+#endif
+        if (WRITTEN <= 0) {
+            return false;
+        }
+        data += WRITTEN;
+        remaining -= WRITTEN;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the size of the terminal of the standard output.
+ *
+ * @param aRows The number of rows.
+ * @param aColumns The number of columns.
+ * @return `true` if the output is a terminal and its size is known.
+ */
+static bool getTerminalSize(int& aRows, int& aColumns) {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        return false;
+    }
+    aRows = info.srWindow.Bottom - info.srWindow.Top + 1;
+    aColumns = info.srWindow.Right - info.srWindow.Left + 1;
+    return true;
+#else
+    winsize size;
+    if (!isatty(STDOUT_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0) {
+        return false;
+    }
+    aRows = size.ws_row;
+    aColumns = size.ws_col;
+    return true;
+#endif
+}
+
+/**
+ * @brief Counts the screen columns of a UTF-8 line (one per character).
+ *
+ * @param aLine The line.
+ * @return The number of characters.
+ */
+static int countColumns(const char* aLine) {
+    int columns = 0;
+    for ( ; *aLine != '\0' ; aLine++) {
+        columns += (*aLine & 0xC0) != 0x80;
+    }
+    return columns;
+}
+
+/**
+ * @brief Checks if the terminal shows a whole frame without scrolling or wrapping lines.
+ *
+ * @param aSize The size of the board.
+ * @return `true` if the cursor positions of an update are reliable.
+ */
+static bool isFrameVisible(int aSize) {
+    static const int LOGO_COLUMNS = countColumns(HNEFATAFL_LOGO[0]);
+    int rows;
+    int columns;
+    return getTerminalSize(rows, columns) && rows >= cellScreenRow(aSize) + RENDER_PROMPT_LINES && columns >= LOGO_COLUMNS;
+}
+
+/**
+ * @brief Draws the game screen: only the changes when possible, a full frame otherwise.
+ *
+ * @param aRenderer The renderer.
+ * @param aBoard The board to draw.
+ * @param aStatus The status line (a single line).
+ * @return `true` if the frame was written.
+ */
+bool renderGame(BoardRenderer& aRenderer, const Board& aBoard, string_view aStatus) {
+    if (!isFrameVisible(aBoard.itsSize) || composeUpdate(aRenderer, aBoard, aStatus) == -1) {
+        if (!composeFrame(aRenderer, aBoard, aStatus)) {
+            return false;
+        }
+    }
+    return writeRenderer(aRenderer);
+}
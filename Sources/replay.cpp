@@ -0,0 +1,348 @@
+/**
+ * @file replay.cpp
+ *
+ * @brief Implementation of the batch validator of the game records.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/notation.h"
+#include "../Headers/ai.h"
+#include "../Headers/boardpool.h"
+#include "../Headers/replay.h"
+
+using namespace std;
+
+// ============================================================================
+// SECTION 1: ONE RECORD
+// ============================================================================
+
+/**
+ * @brief Names of the verdicts, in `ReplayStatus` order.
+ */
+static const char* const STATUS_NAMES[REPLAY_STATUS_COUNT] = {"ok", "wrong-result", "illegal", "after-end", "syntax"};
+
+/**
+ * @brief Gets the name of a verdict, as written by `runReplay()`.
+ *
+ * @param aStatus The verdict.
+ * @return "ok", "wrong-result", "illegal", "after-end" or "syntax".
+ */
+const char* getReplayStatusName(ReplayStatus aStatus) {
+    if (aStatus < 0 || aStatus >= REPLAY_STATUS_COUNT) {
+        return "unknown";
+    }
+    return STATUS_NAMES[aStatus];
+}
+
+/**
+ * @brief Takes the next word of a record.
+ *
+ * @param aRecord The rest of the record (the word and the spaces before it are removed).
+ * @return The word, empty at the end of the record.
+ */
+static string_view nextWord(string_view& aRecord) {
+    size_t start = 0;
+    while (start < aRecord.size() && (aRecord[start] == ' ' || aRecord[start] == '\t')) {
+        start++;
+    }
+    size_t end = start;
+    while (end < aRecord.size() && aRecord[end] != ' ' && aRecord[end] != '\t') {
+        end++;
+    }
+    const string_view WORD = aRecord.substr(start, end - start);
+    aRecord.remove_prefix(end);
+    return WORD;
+}
+
+/**
+ * @brief Gets the winner of a position, with the rules of the self-play runner.
+ *
+ * @return 'A' or 'D' if the game is finished or the player to move is stuck, '-' otherwise.
+ */
+static char getRecordWinner(const Game& aGame) {
+    if (isGameFinished(aGame)) {
+        return (whoWon(aGame)->itsRole == ATTACK) ? 'A' : 'D';
+    }
+    MoveList moves;
+    if (generateMoves(aGame, moves) == 0) {
+        return (aGame.itsCurrentPlayer->itsRole == ATTACK) ? 'D' : 'A';
+    }
+    return '-';
+}
+
+/**
+ * @brief Replays one record and checks its claimed winner.
+ *
+ * @param aRecord The line of the record (without its line end).
+ * @param aGame The game used for the replay (its board is created or resized if needed, then reused).
+ * @return The verdict (`REPLAY_SYNTAX_ERROR` also if the board can't be allocated).
+ */
+ReplayVerdict validateGameRecord(string_view aRecord, Game& aGame) {
+    ReplayVerdict verdict;
+    const string_view SIZE_WORD = nextWord(aRecord);
+    const string_view WINNER_WORD = nextWord(aRecord);
+    const BoardSize SIZE = (SIZE_WORD == "11") ? LITTLE : BIG;
+    if ((SIZE_WORD != "11" && SIZE_WORD != "13") || WINNER_WORD.size() != 1) {
+        return verdict;
+    }
+    const char CLAIMED = static_cast<char>(toupper(static_cast<unsigned char>(WINNER_WORD[0])));
+    if ((CLAIMED != 'A' && CLAIMED != 'D' && CLAIMED != '-') || !resizeBoard(aGame.itsBoard, SIZE)) {
+        return verdict;
+    }
+    initializeBoard(aGame.itsBoard);
+    aGame.itsPlayer1.itsRole = ATTACK;
+    aGame.itsPlayer2.itsRole = DEFENSE;
+    aGame.itsCurrentPlayer = &aGame.itsPlayer1;
+
+    bool isReplayed = true;
+    for (string_view word = nextWord(aRecord) ; !word.empty() && isReplayed ; word = nextWord(aRecord)) {
+        Move move;
+        if (!parseMove(word, SIZE, move)) {
+            verdict.itsStatus = REPLAY_SYNTAX_ERROR;
+            isReplayed = false;
+        } else if (isGameFinished(aGame)) {
+            verdict.itsStatus = REPLAY_AFTER_END;
+            isReplayed = false;
+        } else if (!isValidMovement(aGame, move)) {
+            verdict.itsStatus = REPLAY_ILLEGAL_MOVE;
+            isReplayed = false;
+        } else {
+            movePiece(aGame, move);
+            capturePieces(aGame, move);
+            switchCurrentPlayer(aGame);
+            verdict.itsPlies++;
+        }
+    }
+    verdict.itsWinner = getRecordWinner(aGame);
+    verdict.itsFinalHash = aGame.itsBoard.itsHash;
+    if (isReplayed) {
+        verdict.itsStatus = (verdict.itsWinner == CLAIMED) ? REPLAY_VALID : REPLAY_WRONG_RESULT;
+    }
+    return verdict;
+}
+
+/**
+ * @brief Writes the line of a verdict: `<index> <verdict> <plies> <winner A|D|-> <final key in hex>`.
+ *
+ * @param anIndex The index of the record (from 0, in the order of the input).
+ * @param aVerdict The verdict.
+ * @param aBuffer The buffer receiving the line (with its line end, 0 terminated).
+ * @param aCapacity The size of the buffer (64 bytes are always enough).
+ * @return The length of the line, or -1 if the buffer is too small.
+ */
+int formatReplayVerdict(long long anIndex, const ReplayVerdict& aVerdict, char* aBuffer, int aCapacity) {
+    const int LENGTH = snprintf(aBuffer, static_cast<size_t>(max(aCapacity, 0)), "%lld %s %d %c %016llx\n", anIndex,
+                                getReplayStatusName(aVerdict.itsStatus), aVerdict.itsPlies, aVerdict.itsWinner,
+                                static_cast<unsigned long long>(aVerdict.itsFinalHash));
+    return (LENGTH < 0 || LENGTH >= aCapacity) ? -1 : LENGTH;
+}
+
+// ============================================================================
+// SECTION 2: THREAD POOL
+// ============================================================================
+
+/**
+ * @brief Chunks in memory per worker (read, replayed or waiting to be written).
+ */
+static const int CHUNKS_PER_WORKER = 4;
+
+/**
+ * @struct ReplayChunk
+ * @brief Records read together and their verdicts.
+ */
+struct ReplayChunk
+{
+    string itsRecords[REPLAY_CHUNK_RECORDS];        /**< The lines (their buffers are reused by the next chunks). */
+    ReplayVerdict itsVerdicts[REPLAY_CHUNK_RECORDS]; /**< The verdicts, written by the worker of the chunk. */
+    int itsCount = 0;                               /**< Number of records. */
+    bool itsIsDone = false;                         /**< true once the verdicts are written. */
+};
+
+/**
+ * @struct ReplayQueue
+ * @brief Ring of chunks shared by the reader and the workers.
+ *
+ * Chunk n is in slot n % capacity: the reader fills chunk `itsRead`, the workers take the chunks
+ * from `itsTaken` to `itsRead`, and the reader writes the verdicts of `itsWritten` once it is done.
+ */
+struct ReplayQueue
+{
+    mutex itsMutex;                      /**< Protects the counters and `itsIsDone`. */
+    condition_variable itsWorkReady;     /**< A chunk was read, or the input is over. */
+    condition_variable itsChunkDone;     /**< A chunk was replayed. */
+    ReplayChunk* itsChunks = nullptr;    /**< The slots. */
+    int itsCapacity = 0;                 /**< Number of slots. */
+    long long itsRead = 0;               /**< Chunks given to the workers. */
+    long long itsTaken = 0;              /**< Chunks taken by a worker. */
+    bool itsIsClosed = false;            /**< true once every chunk was written. */
+};
+
+/**
+ * @brief Body of a worker: replays the chunks on its own board until the queue is closed.
+ *
+ * @param aQueue The shared queue.
+ * @param aGame The game of the worker (board taken from the pool of the run).
+ */
+static void runReplayWorker(ReplayQueue& aQueue, Game& aGame) {
+    while (true) {
+        unique_lock<mutex> lock(aQueue.itsMutex);
+        aQueue.itsWorkReady.wait(lock, [&aQueue]() { return aQueue.itsTaken < aQueue.itsRead || aQueue.itsIsClosed; });
+        if (aQueue.itsTaken == aQueue.itsRead) {
+            return;
+        }
+        ReplayChunk& chunk = aQueue.itsChunks[aQueue.itsTaken++ % aQueue.itsCapacity];
+        lock.unlock();
+        for (int record = 0 ; record < chunk.itsCount ; record++) {
+            chunk.itsVerdicts[record] = validateGameRecord(chunk.itsRecords[record], aGame);
+        }
+        lock.lock();
+        chunk.itsIsDone = true;
+        aQueue.itsChunkDone.notify_one();
+    }
+}
+
+/**
+ * @brief Reads the next records of the input into a chunk (empty lines and comments are skipped).
+ *
+ * @return `false` if the input is over (the chunk may still have records).
+ */
+static bool readChunk(istream& anInput, ReplayChunk& aChunk) {
+    aChunk.itsCount = 0;
+    while (aChunk.itsCount < REPLAY_CHUNK_RECORDS) {
+        string& line = aChunk.itsRecords[aChunk.itsCount];
+        if (!getline(anInput, line)) {
+            return false;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty() && line[0] != '#') {
+            aChunk.itsCount++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the verdicts of a chunk and adds them to the summary.
+ *
+ * @return `false` if the output can't be written.
+ */
+static bool writeChunk(ostream& anOutput, const ReplayChunk& aChunk, long long& anIndex, ReplaySummary& aSummary) {
+    char line[64];
+    for (int record = 0 ; record < aChunk.itsCount ; record++) {
+        const ReplayVerdict& verdict = aChunk.itsVerdicts[record];
+        const int LENGTH = formatReplayVerdict(anIndex++, verdict, line, sizeof(line));
+        anOutput.write(line, LENGTH);
+        aSummary.itsCounts[verdict.itsStatus]++;
+    }
+    aSummary.itsRecords += aChunk.itsCount;
+    return static_cast<bool>(anOutput);
+}
+
+/**
+ * @brief Validates all the records of a stream on a pool of threads.
+ *
+ * The calling thread reads the records by chunks of `REPLAY_CHUNK_RECORDS` and writes the
+ * verdicts of the chunks in the order of the input; at most 4 chunks per worker are in memory,
+ * so the input can be of any length.
+ *
+ * @param anInput The records.
+ * @param anOutput Receives one verdict line per record (see `formatReplayVerdict()`).
+ * @param aThreadCount Number of workers (`AI_ALL_CORES` (0) for one per core).
+ * @param aSummary Receives the number of records of each verdict (can be nullptr).
+ * @return `false` if a worker couldn't allocate its board or the output can't be written.
+ */
+bool runReplay(istream& anInput, ostream& anOutput, int aThreadCount, ReplaySummary* aSummary) {
+    if (aThreadCount == AI_ALL_CORES) {
+        aThreadCount = static_cast<int>(thread::hardware_concurrency());
+    }
+    aThreadCount = clamp(aThreadCount, 1, AI_MAX_THREADS);
+    ReplaySummary summary;
+    //the boards of the workers come from one pool: a board takes both sizes without allocation
+    BoardPool pool;
+    Game games[AI_MAX_THREADS];
+    ReplayQueue queue;
+    queue.itsCapacity = CHUNKS_PER_WORKER * aThreadCount;
+    queue.itsChunks = new (nothrow) ReplayChunk[queue.itsCapacity];
+    bool isCreated = queue.itsChunks != nullptr && createBoardPool(pool, aThreadCount);
+    for (int worker = 0 ; worker < aThreadCount && isCreated ; worker++) {
+        isCreated = acquireBoard(pool, games[worker].itsBoard, LITTLE);
+    }
+    if (!isCreated) {
+        deleteBoardPool(pool);
+        delete[] queue.itsChunks;
+        return false;
+    }
+    thread workers[AI_MAX_THREADS];
+    for (int worker = 0 ; worker < aThreadCount ; worker++) {
+        workers[worker] = thread(runReplayWorker, ref(queue), ref(games[worker]));
+    }
+
+    long long written = 0;
+    long long index = 0;
+    bool isInputOver = false;
+    bool isWritten = true;
+    while (true) {
+        //the verdicts already known are written before reading more, so a slow pipe still gets its answers
+        bool isOldestDone = false;
+        if (written < queue.itsRead) {
+            lock_guard<mutex> lock(queue.itsMutex);
+            isOldestDone = queue.itsChunks[written % queue.itsCapacity].itsIsDone;
+        }
+        if (isOldestDone) {
+            isWritten = writeChunk(anOutput, queue.itsChunks[written++ % queue.itsCapacity], index, summary) && isWritten;
+            continue;
+        }
+        //a free slot is filled without waiting, the reader only waits for the oldest chunk when the ring is full
+        if (!isInputOver && queue.itsRead - written < queue.itsCapacity) {
+            ReplayChunk& chunk = queue.itsChunks[queue.itsRead % queue.itsCapacity];
+            isInputOver = !readChunk(anInput, chunk);
+            if (chunk.itsCount > 0) {
+                lock_guard<mutex> lock(queue.itsMutex);
+                chunk.itsIsDone = false;
+                queue.itsRead++;
+                queue.itsWorkReady.notify_one();
+            }
+            continue;
+        }
+        if (written == queue.itsRead) {
+            break;
+        }
+        ReplayChunk& oldest = queue.itsChunks[written % queue.itsCapacity];
+        {
+            unique_lock<mutex> lock(queue.itsMutex);
+            queue.itsChunkDone.wait(lock, [&oldest]() { return oldest.itsIsDone; });
+        }
+        isWritten = writeChunk(anOutput, oldest, index, summary) && isWritten;
+        written++;
+    }
+
+    {
+        lock_guard<mutex> lock(queue.itsMutex);
+        queue.itsIsClosed = true;
+        queue.itsWorkReady.notify_all();
+    }
+    for (int worker = 0 ; worker < aThreadCount ; worker++) {
+        workers[worker].join();
+        releaseBoard(pool, games[worker].itsBoard);
+    }
+    deleteBoardPool(pool);
+    delete[] queue.itsChunks;
+    anOutput.flush();
+    if (aSummary != nullptr) {
+        *aSummary = summary;
+    }
+    return isWritten && static_cast<bool>(anOutput);
+}
@@ -0,0 +1,318 @@
+/**
+ * @file saveindex.cpp
+ *
+ * @brief Implementation of the index of the save directory.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/journal.h"
+#include "../Headers/saveindex.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// ============================================================================
+// SECTION 1: ENTRIES IN MEMORY
+// ============================================================================
+
+/**
+ * @brief Gets the position where a name is (or would be) in the sorted entries.
+ *
+ * @return The first entry whose name is not less than `aName`.
+ */
+static int lowerBoundSave(const SaveIndex& anIndex, const char* aName) {
+    int first = 0;
+    int last = anIndex.itsCount;
+    while (first < last) {
+        const int MIDDLE = (first + last) / 2;
+        if (strcmp(anIndex.itsEntries[MIDDLE].itsName, aName) < 0) {
+            first = MIDDLE + 1;
+        }
+        else {
+            last = MIDDLE;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Adds an entry to the index in memory, or replaces the entry with the same name.
+ *
+ * @return `false` if the allocation failed.
+ */
+static bool insertSaveEntry(SaveIndex& anIndex, const SaveIndexEntry& anEntry) {
+    const int POSITION = lowerBoundSave(anIndex, anEntry.itsName);
+    if (POSITION < anIndex.itsCount && strcmp(anIndex.itsEntries[POSITION].itsName, anEntry.itsName) == 0) {
+        anIndex.itsEntries[POSITION] = anEntry;
+        return true;
+    }
+    //grow the entries by doubling their size
+    if (anIndex.itsCount == anIndex.itsCapacity) {
+        const int CAPACITY = (anIndex.itsCapacity == 0) ? 16 : anIndex.itsCapacity * 2;
+        SaveIndexEntry* entries = new (nothrow) SaveIndexEntry[CAPACITY];
+        if (entries == nullptr) {
+            return false;
+        }
+        if (anIndex.itsEntries != nullptr) {
+            memcpy(entries, anIndex.itsEntries, sizeof(SaveIndexEntry) * anIndex.itsCount);
+            delete[] anIndex.itsEntries;
+        }
+        anIndex.itsEntries = entries;
+        anIndex.itsCapacity = CAPACITY;
+    }
+    memmove(anIndex.itsEntries + POSITION + 1, anIndex.itsEntries + POSITION, sizeof(SaveIndexEntry) * (anIndex.itsCount - POSITION));
+    anIndex.itsEntries[POSITION] = anEntry;
+    anIndex.itsCount++;
+    return true;
+}
+
+/**
+ * @brief Builds the entry of a save file written before the index existed.
+ *
+ * @param aPath The path of the file.
+ * @param aName The name of the save.
+ * @return The entry (size 0 if the file is not a valid save).
+ */
+static SaveIndexEntry describeSaveFile(const fs::path& aPath, const string& aName) {
+    SaveIndexEntry entry;
+    aName.copy(entry.itsName, SAVE_INDEX_NAME_LENGTH - 1);
+    error_code error;
+    //convert the time of the file clock to the system clock
+    const fs::file_time_type WRITE_TIME = fs::last_write_time(aPath, error);
+    entry.itsTimestamp = static_cast<int64_t>(time(nullptr));
+    if (!error) {
+        entry.itsTimestamp -= chrono::duration_cast<chrono::seconds>(fs::file_time_type::clock::now() - WRITE_TIME).count();
+    }
+    ifstream iFile(aPath, ios::binary);
+    const string CONTENT((istreambuf_iterator<char>(iFile)), istreambuf_iterator<char>());
+    if (CONTENT.size() >= sizeof(SaveRecord) && memcmp(CONTENT.data(), SAVE_MAGIC, sizeof(SAVE_MAGIC)) == 0) {
+        SaveRecord record;
+        memcpy(&record, CONTENT.data(), sizeof(record));
+        if (record.itsSize == LITTLE || record.itsSize == BIG) {
+            entry.itsSize = record.itsSize;
+        }
+        entry.itsPlies = static_cast<uint32_t>((CONTENT.size() - sizeof(SaveRecord)) / sizeof(MoveRecord));
+        entry.itsOffset = sizeof(SaveRecord) + sizeof(MoveRecord) * static_cast<uint64_t>(entry.itsPlies);
+    }
+    else {
+        //legacy text save: the size is only known once the text is read
+        Game game;
+        if (importTextSave(CONTENT, game)) {
+            entry.itsSize = static_cast<unsigned char>(game.itsBoard.itsSize);
+        }
+        deleteBoard(game.itsBoard);
+    }
+    return entry;
+}
+
+// ============================================================================
+// SECTION 2: INDEX FILE
+// ============================================================================
+
+/**
+ * @brief Reads an index file into the index in memory.
+ *
+ * @return `false` if the file is not a valid index.
+ */
+static bool readSaveIndex(SaveIndex& anIndex, const fs::path& aPath) {
+    ifstream iFile(aPath, ios::binary);
+    if (!iFile.is_open()) {
+        return false;
+    }
+    const string CONTENT((istreambuf_iterator<char>(iFile)), istreambuf_iterator<char>());
+    SaveIndexHeader header;
+    if (CONTENT.size() < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, CONTENT.data(), sizeof(header));
+    if (memcmp(header.itsMagic, SAVE_INDEX_MAGIC, sizeof(SAVE_INDEX_MAGIC)) != 0 || header.itsVersion != SAVE_INDEX_VERSION
+        || (CONTENT.size() - sizeof(header)) % sizeof(SaveIndexEntry) != 0
+        || (CONTENT.size() - sizeof(header)) / sizeof(SaveIndexEntry) != header.itsCount) {
+        return false;
+    }
+    for (uint64_t i = 0 ; i < header.itsCount ; i++) {
+        SaveIndexEntry entry;
+        memcpy(&entry, CONTENT.data() + sizeof(header) + i * sizeof(SaveIndexEntry), sizeof(entry));
+        //test if the name is terminated and usable, the entries are sorted again by the insertion
+        if (entry.itsName[SAVE_INDEX_NAME_LENGTH - 1] != 0 || !isValidSaveName(entry.itsName)) {
+            return false;
+        }
+        if (!insertSaveEntry(anIndex, entry)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Loads the index of a save directory (creates the directory if needed).
+ *
+ * Without an index file, the directory is scanned once and the index is created from the
+ * save files found (saves written before the index existed).
+ *
+ * @param anIndex The index to fill (its previous entries are freed).
+ * @param aDirectory The save directory.
+ * @return `false` if the index file is invalid or can't be written.
+ */
+bool loadSaveIndex(SaveIndex& anIndex, const string& aDirectory) {
+    deleteSaveIndex(anIndex);
+    anIndex.itsDirectory = aDirectory;
+    error_code error;
+    fs::create_directories(aDirectory, error);
+    const fs::path INDEX_PATH = fs::path(aDirectory) / SAVE_INDEX_FILE;
+    if (fs::exists(INDEX_PATH, error)) {
+        if (!readSaveIndex(anIndex, INDEX_PATH)) {
+            deleteSaveIndex(anIndex);
+            anIndex.itsDirectory = aDirectory;
+            return false;
+        }
+        return true;
+    }
+    //first use of the directory: the only scan, the index is used afterwards
+    for (const auto& entry : fs::directory_iterator(aDirectory, error)) {
+        const string NAME = entry.path().filename().string();
+        if (entry.is_regular_file(error) && isValidSaveName(NAME) && !insertSaveEntry(anIndex, describeSaveFile(entry.path(), NAME))) {
+            return false;
+        }
+    }
+    return writeSaveIndex(anIndex);
+}
+
+/**
+ * @brief Writes the index to a temporary file, then replaces the index file with it.
+ *
+ * @param anIndex The index to write.
+ * @return `true` if the index file was replaced.
+ */
+bool writeSaveIndex(const SaveIndex& anIndex) {
+    const fs::path INDEX_PATH = fs::path(anIndex.itsDirectory) / SAVE_INDEX_FILE;
+    const fs::path TEMPORARY_PATH = fs::path(anIndex.itsDirectory) / (SAVE_INDEX_FILE + ".tmp");
+    FILE* file = fopen(TEMPORARY_PATH.string().c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    SaveIndexHeader header;
+    header.itsCount = static_cast<uint64_t>(anIndex.itsCount);
+    const size_t COUNT = static_cast<size_t>(anIndex.itsCount);
+    bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1
+                     && (COUNT == 0 || fwrite(anIndex.itsEntries, sizeof(SaveIndexEntry), COUNT, file) == COUNT);
+    //the new index must be on the disk before it replaces the old one
+    isWritten = isWritten && fflush(file) == 0 && syncFile(file);
+    isWritten = fclose(file) == 0 && isWritten;
+    error_code error;
+    if (isWritten) {
+        fs::rename(TEMPORARY_PATH, INDEX_PATH, error);
+    }
+    if (!isWritten || error) {
+        fs::remove(TEMPORARY_PATH, error);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Frees the entries of an index.
+ *
+ * @param anIndex The index to free.
+ */
+void deleteSaveIndex(SaveIndex& anIndex) {
+    delete[] anIndex.itsEntries;
+    anIndex.itsEntries = nullptr;
+    anIndex.itsCount = 0;
+    anIndex.itsCapacity = 0;
+}
+
+// ============================================================================
+// SECTION 3: SAVES
+// ============================================================================
+
+/**
+ * @brief Finds a save in the index (binary search).
+ *
+ * @param anIndex The index.
+ * @param aName The name of the save.
+ * @return The position of the entry in `itsEntries`, -1 if the save is not in the index.
+ */
+int findSave(const SaveIndex& anIndex, const string& aName) {
+    if (aName.size() >= static_cast<size_t>(SAVE_INDEX_NAME_LENGTH)) {
+        return -1;
+    }
+    const int POSITION = lowerBoundSave(anIndex, aName.c_str());
+    if (POSITION < anIndex.itsCount && aName == anIndex.itsEntries[POSITION].itsName) {
+        return POSITION;
+    }
+    return -1;
+}
+
+/**
+ * @brief Checks if a name can be used for a save (not empty, fits in an entry, no path, not the index).
+ *
+ * @param aName The name to check.
+ * @return `true` if the name is valid.
+ */
+bool isValidSaveName(const string& aName) {
+    return !aName.empty() && aName.size() < static_cast<size_t>(SAVE_INDEX_NAME_LENGTH)
+           && aName.find_first_of("/\\:") == string::npos && aName != "." && aName != ".."
+           && aName != SAVE_INDEX_FILE && aName != SAVE_INDEX_FILE + ".tmp";
+}
+
+/**
+ * @brief Adds or updates a save in the index (timestamp set to now), then writes the index.
+ *
+ * @param anIndex The index.
+ * @param aName The name of the save (see `isValidSaveName()`).
+ * @param aSize The size of the board (0 if unknown).
+ * @param aPlies The number of moves of the journal.
+ * @return `true` if the entry is in the index and the index was written.
+ */
+bool recordSave(SaveIndex& anIndex, const string& aName, int aSize, int aPlies) {
+    if (!isValidSaveName(aName) || aPlies < 0) {
+        return false;
+    }
+    SaveIndexEntry entry;
+    aName.copy(entry.itsName, SAVE_INDEX_NAME_LENGTH - 1);
+    entry.itsTimestamp = static_cast<int64_t>(time(nullptr));
+    entry.itsSize = static_cast<unsigned char>(aSize);
+    entry.itsPlies = static_cast<uint32_t>(aPlies);
+    entry.itsOffset = sizeof(SaveRecord) + sizeof(MoveRecord) * static_cast<uint64_t>(aPlies);
+    return insertSaveEntry(anIndex, entry) && writeSaveIndex(anIndex);
+}
+
+/**
+ * @brief Removes a save from the index (the file is not deleted), then writes the index.
+ *
+ * @param anIndex The index.
+ * @param aName The name of the save.
+ * @return `true` if the save was in the index and the index was written.
+ */
+bool removeSave(SaveIndex& anIndex, const string& aName) {
+    const int POSITION = findSave(anIndex, aName);
+    if (POSITION == -1) {
+        return false;
+    }
+    memmove(anIndex.itsEntries + POSITION, anIndex.itsEntries + POSITION + 1, sizeof(SaveIndexEntry) * (anIndex.itsCount - POSITION - 1));
+    anIndex.itsCount--;
+    return writeSaveIndex(anIndex);
+}
+
+/**
+ * @brief Gets the path of a save file.
+ *
+ * @param anIndex The index of the save directory.
+ * @param aName The name of the save.
+ * @return The path of the file in the save directory.
+ */
+string getSavePath(const SaveIndex& anIndex, const string& aName) {
+    return (fs::path(anIndex.itsDirectory) / aName).string();
+}
@@ -0,0 +1,195 @@
+/**
+ * @file selfplay.cpp
+ *
+ * @brief Implementation of the headless self-play runner.
+ *
+ * Games are played with `makeMove()` on a private `Game` per worker thread;
+ * nothing is displayed and nothing is read from the terminal.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <new>
+#include <thread>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/ai.h"
+#include "../Headers/boardpool.h"
+#include "../Headers/selfplay.h"
+
+using namespace std;
+
+// ============================================================================
+// SECTION 1: ONE GAME
+// ============================================================================
+
+/**
+ * @brief Draws the next number of a splitmix64 generator.
+ *
+ * @param aState The state of the generator (updated).
+ * @return A 64-bit pseudo-random number.
+ */
+static uint64_t nextRandom(uint64_t& aState) {
+    aState += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = aState;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Plays one game without any display or input.
+ *
+ * @param aSettings The settings of the run.
+ * @param aGameIndex Index of the game (the random players use `itsSeed + aGameIndex`).
+ * @param aSearch Search state used by the AI players (created by the caller, can be nullptr
+ *                if no side is an `AI_PLAYER`).
+ * @param aPool Pool giving the board of the game (can be nullptr, the board is then allocated).
+ * @param aMcts Search used by the MCTS players (can be nullptr if no side is a `MCTS_PLAYER`).
+ * @return The result of the game.
+ */
+SelfPlayResult playSelfPlayGame(const SelfPlaySettings& aSettings, int aGameIndex, AiSearch* aSearch, BoardPool* aPool,
+                                MctsSearch* aMcts) {
+    SelfPlayResult result;
+    Game game;
+    game.itsBoard.itsSize = aSettings.itsSize;
+    if (aPool != nullptr ? !acquireBoard(*aPool, game.itsBoard, aSettings.itsSize) : !createBoard(game.itsBoard)) {
+        return result;
+    }
+    initializeBoard(game.itsBoard);
+    if (aSearch != nullptr) {
+        clearAi(*aSearch);
+    }
+    uint64_t randomState = aSettings.itsSeed + static_cast<uint64_t>(aGameIndex);
+    MoveList moves;
+    while (true) {
+        if (isGameFinished(game)) {
+            result.itsEnd = END_WIN;
+            result.itsHasWinner = true;
+            result.itsWinner = whoWon(game)->itsRole;
+            break;
+        }
+        if (result.itsPlies >= aSettings.itsMaxPlies) {
+            result.itsEnd = END_PLY_LIMIT;
+            break;
+        }
+        const PlayerRole ROLE = game.itsCurrentPlayer->itsRole;
+        const PlayerKind KIND = (ROLE == ATTACK) ? aSettings.itsAttack : aSettings.itsDefense;
+        Move move = {{-1,-1},{-1,-1}};
+        if (KIND == AI_PLAYER && aSearch != nullptr) {
+            move = searchBestMove(game, *aSearch, aSettings.itsTimeBudgetMs, aSettings.itsMaxDepth).itsBestMove;
+        }
+        else if (KIND == MCTS_PLAYER && aMcts != nullptr) {
+            move = searchMctsMove(game, *aMcts, aSettings.itsTimeBudgetMs).itsBestMove;
+        }
+        else if (generateMoves(game, moves) > 0) {
+            move = moves.itsMoves[nextRandom(randomState) % static_cast<uint64_t>(moves.itsCount)];
+        }
+        //a player who can't move loses (same rule as the search)
+        if (move.itsStartPosition.itsRow == -1) {
+            result.itsEnd = END_NO_MOVE;
+            result.itsHasWinner = true;
+            result.itsWinner = (ROLE == ATTACK) ? DEFENSE : ATTACK;
+            break;
+        }
+        makeMove(game, move);
+        result.itsPlies++;
+    }
+    result.itsFinalHash = game.itsBoard.itsHash;
+    if (aPool != nullptr) {
+        releaseBoard(*aPool, game.itsBoard);
+    } else {
+        deleteBoard(game.itsBoard);
+    }
+    return result;
+}
+
+// ============================================================================
+// SECTION 2: THREAD POOL
+// ============================================================================
+
+/**
+ * @brief Body of a worker: takes the next game index until all the games are played.
+ *
+ * @param aSettings The settings of the run.
+ * @param aGameCount Number of games of the run.
+ * @param aNextGame Shared counter of the next game to play.
+ * @param anIsFailed Set if the worker couldn't allocate its search tables or its board.
+ * @param aResults Results of the run (each game is written by exactly one worker).
+ */
+static void runWorker(const SelfPlaySettings& aSettings, int aGameCount, atomic<int>& aNextGame,
+                      atomic<bool>& anIsFailed, SelfPlayResult* aResults) {
+    AiSearch search;
+    MctsSearch mcts;
+    BoardPool pool;
+    const bool NEEDS_AI = aSettings.itsAttack == AI_PLAYER || aSettings.itsDefense == AI_PLAYER;
+    const bool NEEDS_MCTS = aSettings.itsAttack == MCTS_PLAYER || aSettings.itsDefense == MCTS_PLAYER;
+    if ((NEEDS_AI && !createAi(search, aSettings.itsTableBits, 1))
+        || (NEEDS_MCTS && !createMcts(mcts, aSettings.itsNodeBits, 1, aSettings.itsSeed)) || !createBoardPool(pool, 1)) {
+        anIsFailed.store(true);
+        deleteAi(search);
+        deleteMcts(mcts);
+        return;
+    }
+    //the board of each game is taken from the pool of the worker: no allocation after the start
+    for (int game = aNextGame.fetch_add(1) ; game < aGameCount ; game = aNextGame.fetch_add(1)) {
+        aResults[game] = playSelfPlayGame(aSettings, game, NEEDS_AI ? &search : nullptr, &pool, NEEDS_MCTS ? &mcts : nullptr);
+    }
+    deleteBoardPool(pool);
+    deleteAi(search);
+    deleteMcts(mcts);
+}
+
+/**
+ * @brief Plays many games on a pool of threads and writes one line per game.
+ *
+ * Each line is `<index> <winner A|D|-> <end win|stuck|limit> <plies> <final key in hex>`,
+ * in the order of the game indexes whatever the number of threads.
+ *
+ * @param aSettings The settings of the run.
+ * @param aGameCount Number of games to play.
+ * @param aThreadCount Number of worker threads (`AI_ALL_CORES` for one per core).
+ * @param anOutput Stream receiving the lines.
+ * @param aResults Optional array of `aGameCount` results filled by the run (can be nullptr).
+ * @return `true` if all the games were played, `false` if a worker couldn't allocate its tables.
+ */
+bool runSelfPlay(const SelfPlaySettings& aSettings, int aGameCount, int aThreadCount, ostream& anOutput,
+                 SelfPlayResult* aResults) {
+    if (aGameCount <= 0) {
+        return true;
+    }
+    if (aThreadCount == AI_ALL_CORES) {
+        aThreadCount = static_cast<int>(thread::hardware_concurrency());
+    }
+    aThreadCount = clamp(aThreadCount, 1, min(AI_MAX_THREADS, aGameCount));
+    SelfPlayResult* results = (aResults != nullptr) ? aResults : new (nothrow) SelfPlayResult[aGameCount];
+    if (results == nullptr) {
+        return false;
+    }
+    atomic<int> nextGame{0};
+    atomic<bool> isFailed{false};
+    thread workers[AI_MAX_THREADS];
+    for (int worker = 0 ; worker < aThreadCount ; worker++) {
+        workers[worker] = thread(runWorker, cref(aSettings), aGameCount, ref(nextGame), ref(isFailed), results);
+    }
+    for (int worker = 0 ; worker < aThreadCount ; worker++) {
+        workers[worker].join();
+    }
+    //the lines are written once all the games are over, so the output doesn't depend on the scheduling
+    static const char* END_NAMES[3] = {"win", "stuck", "limit"};
+    char line[96];
+    for (int game = 0 ; game < aGameCount && !isFailed ; game++) {
+        const SelfPlayResult& result = results[game];
+        const char WINNER = !result.itsHasWinner ? '-' : (result.itsWinner == ATTACK ? 'A' : 'D');
+        snprintf(line, sizeof(line), "%d %c %s %d %016llx\n", game, WINNER, END_NAMES[result.itsEnd], result.itsPlies,
+                 static_cast<unsigned long long>(result.itsFinalHash));
+        anOutput << line;
+    }
+    if (aResults == nullptr) {
+        delete[] results;
+    }
+    return !isFailed;
+}
@@ -0,0 +1,793 @@
+/**
+ * @file server.cpp
+ *
+ * @brief Implementation of the network game server (many games per process).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <charconv>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#ifdef __linux__
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/notation.h"
+#include "../Headers/server.h"
+#include "../Headers/profile.h"
+
+using namespace std;
+
+/**
+ * @brief Name of each PlayerRole in the replies.
+ */
+static const char* const ROLE_NAMES[2] = {"attack", "defense"};
+
+/**
+ * @brief Offsets of the neighbors in the order of `MoveUndo::itsCapturedMask` (west, east, north, south).
+ */
+static const int CAPTURE_OFFSETS[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+// ============================================================================
+// SECTION 1: POOLS
+// ============================================================================
+
+/**
+ * @brief Allocates the pools of a server.
+ *
+ * @param aServer The server to initialize.
+ * @param aMaxConnections The number of connections.
+ * @param aMaxGames The number of games.
+ * @return `true` if successful, `false` if a size is not positive or an allocation failed.
+ */
+bool createServer(GameServer& aServer, int aMaxConnections, int aMaxGames) {
+    if (aMaxConnections <= 0 || aMaxGames <= 0) {
+        return false;
+    }
+    aServer.itsConnections = new (nothrow) ServerConnection[aMaxConnections];
+    aServer.itsGames = new (nothrow) ServerGame[aMaxGames];
+    aServer.itsPending = new (nothrow) int[aMaxConnections];
+    if (aServer.itsConnections == nullptr || aServer.itsGames == nullptr || aServer.itsPending == nullptr
+        || !createBoardPool(aServer.itsBoards, aMaxGames)) {
+        deleteServer(aServer);
+        return false;
+    }
+    aServer.itsConnectionCapacity = aMaxConnections;
+    aServer.itsGameCapacity = aMaxGames;
+    //free lists in index order
+    for (int i = 0 ; i < aMaxConnections ; i++) {
+        aServer.itsConnections[i].itsNextFree = (i + 1 < aMaxConnections) ? i + 1 : -1;
+    }
+    for (int i = 0 ; i < aMaxGames ; i++) {
+        aServer.itsGames[i].itsNextFree = (i + 1 < aMaxGames) ? i + 1 : -1;
+    }
+    aServer.itsFreeConnection = 0;
+    aServer.itsFreeGame = 0;
+    aServer.itsPendingCount = 0;
+    aServer.itsStats = ServerStats();
+    aServer.itsIsStopping = false;
+    return true;
+}
+
+/**
+ * @brief Closes the sockets of a server and frees its pools.
+ *
+ * @param aServer The server to release.
+ */
+void deleteServer(GameServer& aServer) {
+#ifdef __linux__
+    for (int i = 0 ; i < aServer.itsConnectionCapacity ; i++) {
+        if (aServer.itsConnections[i].itsIsOpen && aServer.itsConnections[i].itsSocket >= 0) {
+            close(aServer.itsConnections[i].itsSocket);
+        }
+    }
+    if (aServer.itsListenSocket >= 0) {
+        close(aServer.itsListenSocket);
+    }
+    if (aServer.itsEventQueue >= 0) {
+        close(aServer.itsEventQueue);
+    }
+#endif
+    //the boards of the games are in the pool, they are never deleted one by one
+    delete[] aServer.itsConnections;
+    delete[] aServer.itsGames;
+    deleteBoardPool(aServer.itsBoards);
+    delete[] aServer.itsPending;
+    aServer.itsConnections = nullptr;
+    aServer.itsGames = nullptr;
+    aServer.itsPending = nullptr;
+    aServer.itsConnectionCapacity = 0;
+    aServer.itsGameCapacity = 0;
+    aServer.itsFreeConnection = -1;
+    aServer.itsFreeGame = -1;
+    aServer.itsPendingCount = 0;
+    aServer.itsListenSocket = -1;
+    aServer.itsEventQueue = -1;
+}
+
+/**
+ * @brief Adds a reply line to the output of a connection.
+ *
+ * A connection whose output is full stops receiving replies and is closed.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ * @param aParts The parts of the line, written one after the other (the line end is added).
+ */
+static void sendLine(GameServer& aServer, int aConnection, initializer_list<string_view> aParts) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    int length = 1;
+    for (string_view part : aParts) {
+        length += static_cast<int>(part.size());
+    }
+    if (connection.itsOutputLength + length > SERVER_OUTPUT_BYTES) {
+        connection.itsIsClosing = true;
+    } else {
+        for (string_view part : aParts) {
+            memcpy(connection.itsOutput + connection.itsOutputLength, part.data(), part.size());
+            connection.itsOutputLength += static_cast<int>(part.size());
+        }
+        connection.itsOutput[connection.itsOutputLength++] = '\n';
+    }
+    if (!connection.itsIsPending) {
+        connection.itsIsPending = true;
+        aServer.itsPending[aServer.itsPendingCount++] = aConnection;
+    }
+}
+
+/**
+ * @brief Sends a reply line to the players of a game (once if a connection plays both roles).
+ *
+ * @param aServer The server.
+ * @param aGame The index of the game.
+ * @param aParts The parts of the line.
+ */
+static void sendToPlayers(GameServer& aServer, int aGame, initializer_list<string_view> aParts) {
+    const int* PLAYERS = aServer.itsGames[aGame].itsPlayers;
+    if (PLAYERS[ATTACK] != -1) {
+        sendLine(aServer, PLAYERS[ATTACK], aParts);
+    }
+    if (PLAYERS[DEFENSE] != -1 && PLAYERS[DEFENSE] != PLAYERS[ATTACK]) {
+        sendLine(aServer, PLAYERS[DEFENSE], aParts);
+    }
+}
+
+/**
+ * @brief Takes a game from the pool and puts it in the starting position.
+ *
+ * @param aServer The server.
+ * @param aSize The size of the board.
+ * @return The index of the game, or -1 if the pool is empty.
+ */
+static int openGame(GameServer& aServer, BoardSize aSize) {
+    const int INDEX = aServer.itsFreeGame;
+    if (INDEX == -1) {
+        return -1;
+    }
+    ServerGame& slot = aServer.itsGames[INDEX];
+    aServer.itsFreeGame = slot.itsNextFree;
+    slot.itsIsUsed = true;
+    slot.itsPlayers[ATTACK] = -1;
+    slot.itsPlayers[DEFENSE] = -1;
+    //the pool has one board per game, so it is never empty here
+    Game& game = slot.itsGame;
+    acquireBoard(aServer.itsBoards, game.itsBoard, aSize);
+    initializeBoard(game.itsBoard);
+    game.itsPlayer1.itsRole = ATTACK;
+    game.itsPlayer2.itsRole = DEFENSE;
+    game.itsCurrentPlayer = &game.itsPlayer1;
+    aServer.itsStats.itsGames++;
+    aServer.itsStats.itsOpenGames++;
+    return INDEX;
+}
+
+/**
+ * @brief Closes a game: its players receive `closed` and leave it, the game goes back to the pool.
+ *
+ * @param aServer The server.
+ * @param aGame The index of the game.
+ */
+static void closeGame(GameServer& aServer, int aGame) {
+    ServerGame& slot = aServer.itsGames[aGame];
+    sendToPlayers(aServer, aGame, {"closed"});
+    for (int player : slot.itsPlayers) {
+        if (player != -1) {
+            aServer.itsConnections[player].itsGame = -1;
+        }
+    }
+    releaseBoard(aServer.itsBoards, slot.itsGame.itsBoard);
+    slot.itsIsUsed = false;
+    slot.itsPlayers[ATTACK] = -1;
+    slot.itsPlayers[DEFENSE] = -1;
+    slot.itsNextFree = aServer.itsFreeGame;
+    aServer.itsFreeGame = aGame;
+    aServer.itsStats.itsOpenGames--;
+}
+
+/**
+ * @brief Takes a connection from the pool.
+ *
+ * @param aServer The server.
+ * @param aSocket The socket of the client (-1 for a connection without socket).
+ * @return The index of the connection, or -1 if the pool is empty.
+ */
+int openConnection(GameServer& aServer, int aSocket) {
+    const int INDEX = aServer.itsFreeConnection;
+    if (INDEX == -1) {
+        return -1;
+    }
+    ServerConnection& connection = aServer.itsConnections[INDEX];
+    aServer.itsFreeConnection = connection.itsNextFree;
+    //itsIsPending is kept: the connection may still be in the list of outputs to send
+    connection.itsSocket = aSocket;
+    connection.itsIsOpen = true;
+    connection.itsIsClosing = false;
+    connection.itsIsWaitingOutput = false;
+    connection.itsGame = -1;
+    connection.itsInputLength = 0;
+    connection.itsOutputLength = 0;
+    aServer.itsStats.itsAccepted++;
+    aServer.itsStats.itsOpenConnections++;
+    return INDEX;
+}
+
+/**
+ * @brief Closes a connection: its game is closed for the opponent, its socket is closed.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ */
+void closeConnection(GameServer& aServer, int aConnection) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    if (!connection.itsIsOpen) {
+        return;
+    }
+    if (connection.itsGame != -1) {
+        closeGame(aServer, connection.itsGame);
+    }
+#ifdef __linux__
+    if (connection.itsSocket >= 0) {
+        close(connection.itsSocket);
+    }
+#endif
+    connection.itsSocket = -1;
+    connection.itsIsOpen = false;
+    connection.itsOutputLength = 0;
+    connection.itsNextFree = aServer.itsFreeConnection;
+    aServer.itsFreeConnection = aConnection;
+    aServer.itsStats.itsOpenConnections--;
+}
+
+// ============================================================================
+// SECTION 2: PROTOCOL
+// ============================================================================
+
+/**
+ * @brief Reads the size argument of `host` and `new`.
+ *
+ * @param anArgument The argument.
+ * @param aSize The size read.
+ * @return `true` for "11" and "13".
+ */
+static bool readSize(string_view anArgument, BoardSize& aSize) {
+    if (anArgument == "11") {
+        aSize = LITTLE;
+        return true;
+    }
+    if (anArgument == "13") {
+        aSize = BIG;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the name of the reason why a move is refused.
+ *
+ * @param aStatus The result of `checkMovement()`.
+ * @return The name sent after `error`.
+ */
+static string_view moveStatusName(MoveStatus aStatus) {
+    switch (aStatus) {
+        case OUT_OF_BOUNDS:
+            return "out-of-bounds";
+        case WRONG_PIECE:
+            return "wrong-piece";
+        case SPECIAL_CELL:
+            return "special-cell";
+        case NO_MOVEMENT:
+            return "no-movement";
+        case NOT_STRAIGHT:
+            return "not-straight";
+        case BLOCKED:
+            return "blocked";
+        default:
+            return "valid";
+    }
+}
+
+/**
+ * @brief Sends the start of a game to one of its players.
+ *
+ * @param aServer The server.
+ * @param aConnection The player.
+ * @param aGame The index of the game.
+ * @param aRole The role of the player ("attack", "defense" or "both").
+ */
+static void sendStart(GameServer& aServer, int aConnection, int aGame, string_view aRole) {
+    char id[12];
+    const to_chars_result ID_END = to_chars(id, id + sizeof(id), aGame);
+    char position[POSITION_TEXT_CAPACITY];
+    const int LENGTH = formatPosition(aServer.itsGames[aGame].itsGame, position, POSITION_TEXT_CAPACITY);
+    sendLine(aServer, aConnection, {"start ", string_view(id, ID_END.ptr - id), " ", aRole, " ", string_view(position, (LENGTH > 0) ? LENGTH : 0)});
+}
+
+/**
+ * @brief Creates a game for a connection (`host` or `new`).
+ *
+ * @param aServer The server.
+ * @param aConnection The connection.
+ * @param anArgument The size of the board.
+ * @param anIsPlayingBoth true for `new` (the connection plays both roles).
+ */
+static void hostGame(GameServer& aServer, int aConnection, string_view anArgument, bool anIsPlayingBoth) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    BoardSize size;
+    if (connection.itsGame != -1) {
+        sendLine(aServer, aConnection, {"error in-game"});
+        return;
+    }
+    if (!readSize(anArgument, size)) {
+        sendLine(aServer, aConnection, {"error size"});
+        return;
+    }
+    const int GAME = openGame(aServer, size);
+    if (GAME == -1) {
+        sendLine(aServer, aConnection, {"error full"});
+        return;
+    }
+    connection.itsGame = GAME;
+    ServerGame& slot = aServer.itsGames[GAME];
+    slot.itsPlayers[ATTACK] = aConnection;
+    if (anIsPlayingBoth) {
+        slot.itsPlayers[DEFENSE] = aConnection;
+        sendStart(aServer, aConnection, GAME, "both");
+    } else {
+        char id[12];
+        const to_chars_result ID_END = to_chars(id, id + sizeof(id), GAME);
+        sendLine(aServer, aConnection, {"hosted ", string_view(id, ID_END.ptr - id)});
+    }
+}
+
+/**
+ * @brief Joins a hosted game as defender (`join`).
+ *
+ * @param aServer The server.
+ * @param aConnection The connection.
+ * @param anArgument The id of the game.
+ */
+static void joinGame(GameServer& aServer, int aConnection, string_view anArgument) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    if (connection.itsGame != -1) {
+        sendLine(aServer, aConnection, {"error in-game"});
+        return;
+    }
+    int game = -1;
+    const from_chars_result RESULT = from_chars(anArgument.data(), anArgument.data() + anArgument.size(), game);
+    if (RESULT.ec != errc() || RESULT.ptr != anArgument.data() + anArgument.size() || game < 0 || game >= aServer.itsGameCapacity
+        || !aServer.itsGames[game].itsIsUsed || aServer.itsGames[game].itsPlayers[DEFENSE] != -1) {
+        sendLine(aServer, aConnection, {"error no-game"});
+        return;
+    }
+    ServerGame& slot = aServer.itsGames[game];
+    slot.itsPlayers[DEFENSE] = aConnection;
+    connection.itsGame = game;
+    sendStart(aServer, slot.itsPlayers[ATTACK], game, ROLE_NAMES[ATTACK]);
+    sendStart(aServer, aConnection, game, ROLE_NAMES[DEFENSE]);
+}
+
+/**
+ * @brief Plays a move of a connection and sends the changes to both players (`move`).
+ *
+ * @param aServer The server.
+ * @param aConnection The connection.
+ * @param anArgument The move.
+ */
+static void playServerMove(GameServer& aServer, int aConnection, string_view anArgument) {
+    const int GAME = aServer.itsConnections[aConnection].itsGame;
+    if (GAME == -1) {
+        sendLine(aServer, aConnection, {"error no-game"});
+        return;
+    }
+    ServerGame& slot = aServer.itsGames[GAME];
+    Game& game = slot.itsGame;
+    if (slot.itsPlayers[DEFENSE] == -1) {
+        sendLine(aServer, aConnection, {"error waiting"});
+        return;
+    }
+    if (isGameFinished(game)) {
+        sendLine(aServer, aConnection, {"error finished"});
+        return;
+    }
+    if (slot.itsPlayers[game.itsCurrentPlayer->itsRole] != aConnection) {
+        sendLine(aServer, aConnection, {"error not-your-turn"});
+        return;
+    }
+    Move move;
+    if (!parseMove(anArgument, game.itsBoard.itsSize, move)) {
+        sendLine(aServer, aConnection, {"error syntax"});
+        return;
+    }
+    //the silent validation, the reason goes back to the client
+    const MoveStatus STATUS = checkMovement(game, move);
+    if (STATUS != VALID_MOVE) {
+        sendLine(aServer, aConnection, {"error ", moveStatusName(STATUS)});
+        return;
+    }
+    const MoveUndo UNDO = makeMove(game, move);
+    aServer.itsStats.itsMoves++;
+    //the diff: the move, then the captured cells
+    char text[64];
+    int length = formatMove(move, text, MOVE_TEXT_CAPACITY);
+    for (int direction = 0 ; direction < 4 ; direction++) {
+        if ((UNDO.itsCapturedMask >> direction & 1) == 0) {
+            continue;
+        }
+        const Position CAPTURED = {move.itsEndPosition.itsRow + CAPTURE_OFFSETS[direction][0], move.itsEndPosition.itsCol + CAPTURE_OFFSETS[direction][1]};
+        memcpy(text + length, " x ", 3);
+        length += 3;
+        length += formatCell(CAPTURED, text + length, static_cast<int>(sizeof(text)) - length);
+    }
+    sendToPlayers(aServer, GAME, {"moved ", string_view(text, length)});
+    if (isGameFinished(game)) {
+        const GameStatus END = getGameStatus(game.itsBoard);
+        const string_view REASON = (END == KING_CAPTURED) ? "king-captured" : (END == NO_SWORD_LEFT) ? "no-sword-left" : "king-escaped";
+        sendToPlayers(aServer, GAME, {"end ", REASON, " ", ROLE_NAMES[(END == KING_CAPTURED) ? ATTACK : DEFENSE]});
+    } else {
+        MoveList moves;
+        if (generateMoves(game, moves) == 0) {
+            sendToPlayers(aServer, GAME, {"end no-move ", ROLE_NAMES[UNDO.itsPreviousPlayer->itsRole]});
+        }
+    }
+}
+
+/**
+ * @brief Executes one command line of a connection.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ * @param aLine The command, without its line end.
+ * @return `false` if the connection must be closed (after sending its output).
+ */
+bool handleServerLine(GameServer& aServer, int aConnection, string_view aLine) {
+    if (!aLine.empty() && aLine.back() == '\r') {
+        aLine.remove_suffix(1);
+    }
+    const size_t SPACE = aLine.find(' ');
+    const string_view COMMAND = aLine.substr(0, SPACE);
+    const string_view ARGUMENT = (SPACE == string_view::npos) ? string_view() : aLine.substr(SPACE + 1);
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    if (COMMAND == "move") {
+        playServerMove(aServer, aConnection, ARGUMENT);
+    } else if (COMMAND == "host") {
+        hostGame(aServer, aConnection, ARGUMENT, false);
+    } else if (COMMAND == "new") {
+        hostGame(aServer, aConnection, ARGUMENT, true);
+    } else if (COMMAND == "join") {
+        joinGame(aServer, aConnection, ARGUMENT);
+    } else if (COMMAND == "board") {
+        if (connection.itsGame == -1) {
+            sendLine(aServer, aConnection, {"error no-game"});
+        } else {
+            char position[POSITION_TEXT_CAPACITY];
+            const int LENGTH = formatPosition(aServer.itsGames[connection.itsGame].itsGame, position, POSITION_TEXT_CAPACITY);
+            sendLine(aServer, aConnection, {"position ", string_view(position, (LENGTH > 0) ? LENGTH : 0)});
+        }
+    } else if (COMMAND == "leave") {
+        if (connection.itsGame == -1) {
+            sendLine(aServer, aConnection, {"error no-game"});
+        } else {
+            closeGame(aServer, connection.itsGame);
+        }
+    } else if (COMMAND == "profile") {
+        //the counters of the hot functions, for the monitoring (`"enabled":false` without HNEFATAFL_PROFILE)
+        sendLine(aServer, aConnection, {"profile ", formatProfileJson(collectProfile())});
+    } else if (COMMAND == "quit") {
+        sendLine(aServer, aConnection, {"bye"});
+        connection.itsIsClosing = true;
+    } else if (!COMMAND.empty()) {
+        sendLine(aServer, aConnection, {"error unknown-command"});
+    }
+    return !connection.itsIsClosing;
+}
+
+/**
+ * @brief Adds received data to the input of a connection and executes its complete lines.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ * @param aData The received bytes.
+ * @param aLength The number of bytes.
+ * @return `false` if the connection must be closed (`quit` or line too long).
+ */
+bool receiveServerData(GameServer& aServer, int aConnection, const char* aData, int aLength) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    for (int i = 0 ; i < aLength && !connection.itsIsClosing ; i++) {
+        if (aData[i] == '\n') {
+            const int LENGTH = connection.itsInputLength;
+            connection.itsInputLength = 0;
+            handleServerLine(aServer, aConnection, string_view(connection.itsInput, LENGTH));
+        } else if (connection.itsInputLength == SERVER_LINE_LENGTH - 1) {
+            sendLine(aServer, aConnection, {"error line-too-long"});
+            connection.itsIsClosing = true;
+        } else {
+            connection.itsInput[connection.itsInputLength++] = aData[i];
+        }
+    }
+    return !connection.itsIsClosing;
+}
+
+// ============================================================================
+// SECTION 3: EVENT LOOP
+// ============================================================================
+
+/**
+ * @brief Asks the event loop to stop (can be called from another thread or a signal handler).
+ *
+ * @param aServer The server.
+ */
+void stopServer(GameServer& aServer) {
+    aServer.itsIsStopping = true;
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Event data of the listening socket (the connections use their socket and index).
+ */
+static const uint64_t LISTEN_EVENT = ~uint64_t(0);
+
+/**
+ * @brief Number of events read by one `epoll_wait()`.
+ */
+static const int SERVER_EVENTS = 256;
+
+/**
+ * @brief Waiting time of `epoll_wait()` between two checks of `itsIsStopping`.
+ */
+static const int SERVER_WAIT_MS = 100;
+
+/**
+ * @brief Builds the event data of a connection.
+ *
+ * The socket is stored with the index, so an event of a closed connection is not applied
+ * to a new connection that reused its slot.
+ *
+ * @param aConnection The index of the connection.
+ * @param aSocket The socket of the connection.
+ * @return The event data.
+ */
+static uint64_t connectionEvent(int aConnection, int aSocket) {
+    return (uint64_t(uint32_t(aSocket)) << 32) | uint32_t(aConnection);
+}
+
+/**
+ * @brief Opens the listening socket of the server.
+ *
+ * @param aServer The server (created, not listening).
+ * @param aPort The TCP port (0 picks a free port, see `itsPort`).
+ * @return `true` if the server listens, `false` on error or on systems without epoll.
+ */
+bool listenServer(GameServer& aServer, int aPort) {
+    if (aServer.itsConnections == nullptr || aServer.itsListenSocket >= 0 || aPort < 0 || aPort > 65535) {
+        return false;
+    }
+    const int SOCKET = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (SOCKET < 0) {
+        return false;
+    }
+    const int YES = 1;
+    setsockopt(SOCKET, SOL_SOCKET, SO_REUSEADDR, &YES, sizeof(YES));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(aPort));
+    socklen_t addressLength = sizeof(address);
+    const int QUEUE = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_EVENT;
+    if (QUEUE < 0 || bind(SOCKET, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(SOCKET, SOMAXCONN) != 0
+        || getsockname(SOCKET, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0
+        || epoll_ctl(QUEUE, EPOLL_CTL_ADD, SOCKET, &event) != 0) {
+        close(SOCKET);
+        if (QUEUE >= 0) {
+            close(QUEUE);
+        }
+        return false;
+    }
+    aServer.itsListenSocket = SOCKET;
+    aServer.itsEventQueue = QUEUE;
+    aServer.itsPort = ntohs(address.sin_port);
+    return true;
+}
+
+/**
+ * @brief Sends the output of a connection, watches the socket for writing if some is left,
+ * and closes the connection if it was asked.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ */
+static void flushConnection(GameServer& aServer, int aConnection) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    if (!connection.itsIsOpen || connection.itsSocket < 0) {
+        return;
+    }
+    if (connection.itsOutputLength > 0) {
+        const ssize_t SENT = send(connection.itsSocket, connection.itsOutput, connection.itsOutputLength, MSG_NOSIGNAL);
+        if (SENT < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            closeConnection(aServer, aConnection);
+            return;
+        }
+        if (SENT > 0) {
+            connection.itsOutputLength -= static_cast<int>(SENT);
+            memmove(connection.itsOutput, connection.itsOutput + SENT, connection.itsOutputLength);
+        }
+    }
+    if (connection.itsIsClosing && connection.itsOutputLength == 0) {
+        closeConnection(aServer, aConnection);
+        return;
+    }
+    //watch for writing only while some output is left, and no more for reading once closing
+    const bool IS_WAITING = connection.itsOutputLength > 0;
+    if (IS_WAITING != connection.itsIsWaitingOutput || connection.itsIsClosing) {
+        epoll_event event = {};
+        uint32_t events = 0;
+        if (!connection.itsIsClosing) {
+            events |= EPOLLIN | EPOLLRDHUP;
+        }
+        if (IS_WAITING) {
+            events |= EPOLLOUT;
+        }
+        event.events = events;
+        event.data.u64 = connectionEvent(aConnection, connection.itsSocket);
+        epoll_ctl(aServer.itsEventQueue, EPOLL_CTL_MOD, connection.itsSocket, &event);
+        connection.itsIsWaitingOutput = IS_WAITING;
+    }
+}
+
+/**
+ * @brief Accepts the waiting clients.
+ *
+ * @param aServer The server.
+ */
+static void acceptClients(GameServer& aServer) {
+    for (;;) {
+        const int SOCKET = accept4(aServer.itsListenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (SOCKET < 0) {
+            return;
+        }
+        const int CONNECTION = openConnection(aServer, SOCKET);
+        if (CONNECTION == -1) {
+            aServer.itsStats.itsRefused++;
+            close(SOCKET);
+            continue;
+        }
+        //the replies are short lines, they must not wait for more data
+        const int YES = 1;
+        setsockopt(SOCKET, IPPROTO_TCP, TCP_NODELAY, &YES, sizeof(YES));
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = connectionEvent(CONNECTION, SOCKET);
+        if (epoll_ctl(aServer.itsEventQueue, EPOLL_CTL_ADD, SOCKET, &event) != 0) {
+            closeConnection(aServer, CONNECTION);
+        }
+    }
+}
+
+/**
+ * @brief Reads the data of a connection and executes its commands.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ */
+static void readConnection(GameServer& aServer, int aConnection) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    char data[4096];
+    while (connection.itsIsOpen && !connection.itsIsClosing) {
+        const ssize_t RECEIVED = recv(connection.itsSocket, data, sizeof(data), 0);
+        if (RECEIVED > 0) {
+            receiveServerData(aServer, aConnection, data, static_cast<int>(RECEIVED));
+        } else if (RECEIVED < 0 && errno == EINTR) {
+            continue;
+        } else if (RECEIVED < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        } else if (RECEIVED == 0) {
+            //closed for writing by the client, the replies are still sent
+            connection.itsIsClosing = true;
+            if (!connection.itsIsPending) {
+                flushConnection(aServer, aConnection);
+            }
+            return;
+        } else {
+            closeConnection(aServer, aConnection);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Runs the event loop until `stopServer()` is called.
+ *
+ * @param aServer The listening server.
+ * @return `true` if the loop stopped normally, `false` on error.
+ */
+bool runServer(GameServer& aServer) {
+    if (aServer.itsEventQueue < 0) {
+        return false;
+    }
+    epoll_event events[SERVER_EVENTS];
+    while (!aServer.itsIsStopping) {
+        const int COUNT = epoll_wait(aServer.itsEventQueue, events, SERVER_EVENTS, SERVER_WAIT_MS);
+        if (COUNT < 0 && errno != EINTR) {
+            return false;
+        }
+        for (int i = 0 ; i < COUNT ; i++) {
+            if (events[i].data.u64 == LISTEN_EVENT) {
+                acceptClients(aServer);
+                continue;
+            }
+            const int CONNECTION = static_cast<int>(events[i].data.u64 & 0xFFFFFFFFu);
+            const int SOCKET = static_cast<int>(events[i].data.u64 >> 32);
+            ServerConnection& connection = aServer.itsConnections[CONNECTION];
+            if (!connection.itsIsOpen || connection.itsSocket != SOCKET) {
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                readConnection(aServer, CONNECTION);
+            }
+            if (connection.itsIsOpen && (events[i].events & EPOLLOUT) && !connection.itsIsPending) {
+                flushConnection(aServer, CONNECTION);
+            }
+        }
+        //the replies of this round, a closed connection may add the "closed" of its opponent
+        //(taken from the end, so a connection is never in the list twice)
+        while (aServer.itsPendingCount > 0) {
+            const int CONNECTION = aServer.itsPending[--aServer.itsPendingCount];
+            aServer.itsConnections[CONNECTION].itsIsPending = false;
+            flushConnection(aServer, CONNECTION);
+        }
+    }
+    return true;
+}
+
+#else
+
+/**
+ * @brief Opens the listening socket of the server (not available without epoll).
+ *
+ * @return `false`.
+ */
+bool listenServer(GameServer&, int) {
+    return false;
+}
+
+/**
+ * @brief Runs the event loop (not available without epoll).
+ *
+ * @return `false`.
+ */
+bool runServer(GameServer&) {
+    return false;
+}
+
+#endif
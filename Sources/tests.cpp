@@ -24,7 +24,7 @@
  *   - DISPLAY_PROMPTS: show or mute prompts/error messages coming from functions
  *
  * Helper conventions used in this file only (no production code change):
- *   - cb(size): allocates a raw Cell** board of given size
+ *   - cb(size): allocates a raw contiguous CellRow* board of given size
  *   - db(board,size): frees a previously allocated board
  *   - resetBoard(board,size): sets all cells to {NORMAL, NONE}
  *
@@ -52,12 +52,44 @@
 #include <iostream>
 #include <sstream>
 #include <functional>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#ifdef __linux__
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 #include "../Headers/typeDef.h"
 #include "../Headers/functions.h"
 #include "../Headers/tests.h"
+#include "../Headers/ai.h"
+#include "../Headers/selfplay.h"
+#include "../Headers/perft.h"
+#include "../Headers/journal.h"
+#include "../Headers/gamedb.h"
+#include "../Headers/saveindex.h"
+#include "../Headers/bitboard.h"
+#include "../Headers/engine.h"
+#include "../Headers/evalfeatures.h"
+#include "../Headers/notation.h"
+#include "../Headers/render.h"
+#include "../Headers/server.h"
+#include "../Headers/boardpool.h"
+#include "../Headers/book.h"
+#include "../Headers/batcheval.h"
+#include "../Headers/profile.h"
+#include "../Headers/bench.h"
+#include "../Headers/replay.h"
+#include "../Headers/mcts.h"
+#include "../Headers/player.h"
+#include "../Headers/analysis.h"
 
 // ========================= HELPER MACRO FOR SAFE TEST EXECUTION =========================
 /**
@@ -106,11 +138,11 @@ void printTestResult(int testNum, const string& description, bool passed,
                      const string& expected = "", const string& actual = "");
 void printTestException(int testNum, const string& description, const string& exceptionMsg);
 void printTestSummary(const string& testName, int passed, int failed);
-void resetBoard(Cell**& aBoard, const BoardSize& aBoardSize);
-Cell** cb(const BoardSize& aBoardSize);
-void db(Cell**& aBoard, const BoardSize& aBoardSize);
-void placePiece(Cell** board, int r, int c, PieceType piece);
-void drawRectBorderPieces(Cell** board, int r1, int c1, int r2, int c2, PieceType piece);
+void resetBoard(CellRow*& aBoard, const BoardSize& aBoardSize);
+CellRow* cb(const BoardSize& aBoardSize);
+void db(CellRow*& aBoard, const BoardSize& aBoardSize);
+void placePiece(CellRow* board, int r, int c, PieceType piece);
+void drawRectBorderPieces(CellRow* board, int r1, int c1, int r2, int c2, PieceType piece);
 
 // ========================= TEST FUNCTIONS =========================
 
@@ -222,7 +254,7 @@ void test_chooseSizeBoard()
  * Test coverage:
  * - Valid board sizes (LITTLE, BIG)
  * - Pointer verification (not nullptr after allocation)
- * - Memory allocation verification (all rows allocated)
+ * - Memory allocation verification (all rows in one contiguous block)
  * - Edge cases (size 0, negative size, very large size)
  * - Double allocation detection (memory leak prevention)
  */
@@ -255,24 +287,24 @@ void test_createBoard() {
         failed++;
     }
 
-    // Test 3: Verify all rows are allocated for LITTLE board
+    // Test 3: Verify the 11 rows are contiguous for LITTLE board
     testNum++;
-    bool allRowsAllocated = true;
+    bool allRowsContiguous = true;
     if (board1.itsCells != nullptr) {
         for (int i = 0; i < LITTLE; ++i) {
-            if (board1.itsCells[i] == nullptr) {
-                allRowsAllocated = false;
+            if (&board1.itsCells[i][0] != &board1.itsCells[0][0] + i * BIG) {
+                allRowsContiguous = false;
                 break;
             }
         }
     } else {
-        allRowsAllocated = false;
+        allRowsContiguous = false;
     }
-    if (allRowsAllocated) {
-        printTestResult(testNum, "LITTLE board: all 11 rows allocated", true);
+    if (allRowsContiguous) {
+        printTestResult(testNum, "LITTLE board: all 11 rows in one contiguous block", true);
         pass++;
     } else {
-        printTestResult(testNum, "LITTLE board: all 11 rows allocated", false, "all rows allocated", "some rows nullptr");
+        printTestResult(testNum, "LITTLE board: all 11 rows in one contiguous block", false, "contiguous rows", "rows not contiguous");
         failed++;
     }
 
@@ -299,24 +331,24 @@ void test_createBoard() {
         failed++;
     }
 
-    // Test 6: Verify all rows are allocated for BIG board
+    // Test 6: Verify the 13 rows are contiguous for BIG board
     testNum++;
-    allRowsAllocated = true;
+    allRowsContiguous = true;
     if (board2.itsCells != nullptr) {
         for (int i = 0; i < BIG; ++i) {
-            if (board2.itsCells[i] == nullptr) {
-                allRowsAllocated = false;
+            if (&board2.itsCells[i][0] != &board2.itsCells[0][0] + i * BIG) {
+                allRowsContiguous = false;
                 break;
             }
         }
     } else {
-        allRowsAllocated = false;
+        allRowsContiguous = false;
     }
-    if (allRowsAllocated) {
-        printTestResult(testNum, "BIG board: all 13 rows allocated", true);
+    if (allRowsContiguous) {
+        printTestResult(testNum, "BIG board: all 13 rows in one contiguous block", true);
         pass++;
     } else {
-        printTestResult(testNum, "BIG board: all 13 rows allocated", false, "all rows allocated", "some rows nullptr");
+        printTestResult(testNum, "BIG board: all 13 rows in one contiguous block", false, "contiguous rows", "rows not contiguous");
         failed++;
     }
 
@@ -340,27 +372,37 @@ void test_createBoard() {
         }
     }
 
-    // Test 8: Very large size (edge case - tests memory handling)
+    // Test 8: Very large size (edge case - rows are sized for BIG boards)
     testNum++;
     Board board4 = {nullptr, static_cast<BoardSize>(1000)};
     bool result4 = createBoard(board4);
-    // Large allocation should succeed (unless out of memory)
-    if (result4) {
-        printTestResult(testNum, "Size 1000 → allocation handled", true);
+    // Sizes wider than a BIG row must be rejected
+    if (!result4 && board4.itsCells == nullptr) {
+        printTestResult(testNum, "Size 1000 → rejected (wider than BIG)", true);
         pass++;
-        db(board4.itsCells, static_cast<BoardSize>(1000)); // Clean up large allocation
     } else {
-        printTestResult(testNum, "Size 1000 → allocation handled", false, "allocated or failed gracefully", "unexpected behavior");
+        printTestResult(testNum, "Size 1000 → rejected (wider than BIG)", false, "false (rejected)", "true (accepted)");
+        failed++;
+        db(board4.itsCells, static_cast<BoardSize>(1000)); // Clean up unexpected allocation
+    }
+
+    // Test 9: A cell is packed in a single byte
+    testNum++;
+    if (sizeof(Cell) == 1 && sizeof(CellRow) == BIG) {
+        printTestResult(testNum, "Cell packed in 1 byte (BIG row = 13 bytes)", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Cell packed in 1 byte (BIG row = 13 bytes)", false, "1", to_string(sizeof(Cell)));
         failed++;
     }
 
     // === Category 3: Double allocation (memory leak detection) ===
 
-    // Test 9: Double allocation prevention
+    // Test 10: Double allocation prevention
     testNum++;
     Board board5 = {nullptr, LITTLE};
     createBoard(board5);
-    Cell** firstAllocation = board5.itsCells;
+    CellRow* firstAllocation = board5.itsCells;
     bool secondAllocation = createBoard(board5); // Second allocation should be rejected
     if (!secondAllocation && board5.itsCells == firstAllocation) {
         printTestResult(testNum, "Double allocation → prevented (validation active)", true);
@@ -448,6 +490,312 @@ void test_deleteBoard() {
 }
 
 
+/**
+ * @brief Test function for acquireBoard.
+ *
+ * This function tests the pool of boards: boards are taken and given back in O(1) without
+ * allocation, their cells are cleared, and a pooled board changes size without reallocation
+ * (resizeBoard, restoreSnapshot) and is never freed by deleteBoard.
+ */
+void test_acquireBoard() {
+    printTestHeader("acquireBoard");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test: one allocation for the whole pool
+    testNum++;
+    BoardPool pool;
+    const long long BEFORE_POOL = getBoardAllocationCount();
+    BoardPool empty;
+    const bool REFUSED = !createBoardPool(empty, 0);
+    const bool CREATED = createBoardPool(pool, 3);
+    if (REFUSED && CREATED && pool.itsFreeCount == 3 && getBoardAllocationCount() == BEFORE_POOL + 1 && !createBoardPool(pool, 3)) {
+        printTestResult(testNum, "createBoardPool(3) → 1 allocation, 3 free boards (0 and double creation refused)", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "createBoardPool(3) → 1 allocation", false, "1", to_string(getBoardAllocationCount() - BEFORE_POOL));
+        failed++;
+    }
+    if (!CREATED) {
+        printTestSummary("acquireBoard", pass, failed);
+        return;
+    }
+
+    // Test: 3 distinct boards, then the pool is empty
+    testNum++;
+    const long long BEFORE = getBoardAllocationCount();
+    Board boards[4];
+    bool taken = true;
+    for (int i = 0; i < 3; ++i) {
+        taken = acquireBoard(pool, boards[i], i == 0 ? BIG : LITTLE) && taken;
+    }
+    const bool IS_EMPTY = !acquireBoard(pool, boards[3], LITTLE) && boards[3].itsCells == nullptr;
+    if (taken && IS_EMPTY && boards[0].itsCells != boards[1].itsCells && boards[1].itsCells != boards[2].itsCells
+        && boards[0].itsSize == BIG && boards[0].itsIsPooled && !acquireBoard(pool, boards[0], BIG)) {
+        printTestResult(testNum, "3 boards taken → distinct cells, the 4th is refused", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "3 boards taken → distinct cells, the 4th is refused", false, "3", to_string(3 - pool.itsFreeCount));
+        failed++;
+    }
+
+    // Test: a board given back is taken again, with its cells cleared
+    testNum++;
+    initializeBoard(boards[0]);
+    CellRow* cells = boards[0].itsCells;
+    releaseBoard(pool, boards[0]);
+    const bool RELEASED = boards[0].itsCells == nullptr && pool.itsFreeCount == 1;
+    acquireBoard(pool, boards[0], LITTLE);
+    bool isCleared = true;
+    for (int row = 0; row < BIG; ++row) {
+        for (int col = 0; col < BIG; ++col) {
+            isCleared = isCleared && boards[0].itsCells[row][col].itsPieceType == NONE && boards[0].itsCells[row][col].itsCellType == NORMAL;
+        }
+    }
+    if (RELEASED && boards[0].itsCells == cells && isCleared) {
+        printTestResult(testNum, "BIG board given back → taken again as LITTLE, all BIG rows cleared", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "board given back → taken again and cleared", false, "cleared", isCleared ? "other cells" : "not cleared");
+        failed++;
+    }
+
+    // Test: a pooled board changes size without allocation
+    testNum++;
+    Game game;
+    game.itsBoard.itsSize = BIG;
+    createBoard(game.itsBoard);
+    initializeBoard(game.itsBoard);
+    const GameSnapshot SNAPSHOT = takeSnapshot(game);
+    Game pooled;
+    pooled.itsBoard = boards[1];
+    const long long BEFORE_RESIZE = getBoardAllocationCount();
+    const bool RESTORED = restoreSnapshot(SNAPSHOT, pooled);
+    const bool RESIZED = resizeBoard(pooled.itsBoard, LITTLE) && resizeBoard(pooled.itsBoard, BIG);
+    const bool COPIED = RESIZED && copyBoard(game.itsBoard, pooled.itsBoard);
+    if (RESTORED && COPIED && pooled.itsBoard.itsCells == boards[1].itsCells && pooled.itsBoard.itsSize == BIG
+        && pooled.itsBoard.itsHash == game.itsBoard.itsHash && getBoardAllocationCount() == BEFORE_RESIZE) {
+        printTestResult(testNum, "LITTLE pooled board → BIG snapshot, resizes and copy without allocation", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "pooled board resized without allocation", false, "0", to_string(getBoardAllocationCount() - BEFORE_RESIZE));
+        failed++;
+    }
+
+    // Test: deleteBoard keeps a pooled board, releaseBoard ignores a board of the heap
+    testNum++;
+    deleteBoard(pooled.itsBoard);
+    const bool KEPT = pooled.itsBoard.itsCells == boards[1].itsCells;
+    releaseBoard(pool, game.itsBoard);
+    if (KEPT && game.itsBoard.itsCells != nullptr && pool.itsFreeCount == 0 && getBoardAllocationCount() == BEFORE + 1) {
+        printTestResult(testNum, "deleteBoard on a pooled board and releaseBoard on a heap board → nothing changed", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "deleteBoard on a pooled board → kept", false, "kept", "freed");
+        failed++;
+    }
+    deleteBoard(game.itsBoard);
+
+    for (int i = 0; i < 3; ++i) {
+        releaseBoard(pool, boards[i]);
+    }
+    deleteBoardPool(pool);
+    printTestSummary("acquireBoard", pass, failed);
+}
+
+/**
+ * @brief Test function for the copyBoard function.
+ *
+ * This function tests the copyBoard function by copying initialized boards of both sizes,
+ * checking that the copy is independent from the source, and that a destination of another
+ * size is reallocated.
+ */
+void test_copyBoard() {
+    printTestHeader("copyBoard");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Board source = {cb(size), size};
+        initializeBoard(source);
+
+        // Test: copy into an empty board → same cells and masks, separate block
+        testNum++;
+        Board copy = {nullptr, LITTLE};
+        bool copied = copyBoard(source, copy);
+        bool same = copied && copy.itsSize == size && copy.itsCells != source.itsCells && copy.itsHasBitboards;
+        for (int i = 0; same && i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                if (copy.itsCells[i][j].itsCellType != source.itsCells[i][j].itsCellType
+                    || copy.itsCells[i][j].itsPieceType != source.itsCells[i][j].itsPieceType) {
+                    same = false;
+                }
+            }
+        }
+        if (same && countPieces(copy, SWORD) == 24) {
+            printTestResult(testNum, sizeName + " - copy is identical and in its own block", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - copy is identical and in its own block", false, "identical copy", "different copy");
+            failed++;
+        }
+
+        // Test: editing the copy leaves the source unchanged
+        testNum++;
+        copy.itsCells[0][size/2].itsPieceType = NONE;
+        if (source.itsCells[0][size/2].itsPieceType == SWORD) {
+            printTestResult(testNum, sizeName + " - editing the copy → source unchanged", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - editing the copy → source unchanged", false, "SWORD", "modified");
+            failed++;
+        }
+
+        deleteBoard(copy);
+        db(source.itsCells, size);
+    }
+
+    // Test: destination of another size is reallocated
+    testNum++;
+    Board little = {cb(LITTLE), LITTLE};
+    Board big = {cb(BIG), BIG};
+    initializeBoard(big);
+    bool resized = copyBoard(big, little) && little.itsSize == BIG
+                   && little.itsCells[BIG-1][BIG-1].itsCellType == FORTRESS;
+    if (resized) {
+        printTestResult(testNum, "LITTLE destination ← BIG source → reallocated as BIG", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "LITTLE destination ← BIG source → reallocated as BIG", false, "BIG copy", "not resized");
+        failed++;
+    }
+    deleteBoard(little);
+    db(big.itsCells, BIG);
+
+    // Test: nullptr source is rejected
+    testNum++;
+    Board nullSource = {nullptr, LITTLE};
+    Board destination = {nullptr, LITTLE};
+    if (!copyBoard(nullSource, destination) && destination.itsCells == nullptr) {
+        printTestResult(testNum, "nullptr source → rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "nullptr source → rejected", false, "false", "true");
+        failed++;
+    }
+
+    printTestSummary("copyBoard", pass, failed);
+}
+
+/**
+ * @brief Test function for takeSnapshot and restoreSnapshot.
+ *
+ * This function tests the snapshot of a game: a restored game has the same cells, key, masks
+ * and player to move, the snapshot doesn't change with the game, and invalid snapshots are rejected.
+ */
+void test_takeSnapshot()
+{
+    printTestHeader("takeSnapshot / restoreSnapshot");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        makeMove(game, {{0, size / 2 - 2}, {1, size / 2 - 2}});
+        const GameSnapshot SNAPSHOT = takeSnapshot(game);
+
+        // Test: a restored game is the same position
+        testNum++;
+        Game copy;
+        bool restored = restoreSnapshot(SNAPSHOT, copy);
+        bool same = restored && copy.itsBoard.itsSize == size && copy.itsBoard.itsHash == game.itsBoard.itsHash
+                    && copy.itsCurrentPlayer == &copy.itsPlayer2 && copy.itsBoard.itsHasBitboards
+                    && countPieces(copy.itsBoard, SWORD) == countPieces(game.itsBoard, SWORD);
+        for (int row = 0; row < size && same; ++row) {
+            for (int col = 0; col < size; ++col) {
+                same = same && copy.itsBoard.itsCells[row][col].itsPieceType == game.itsBoard.itsCells[row][col].itsPieceType
+                       && copy.itsBoard.itsCells[row][col].itsCellType == game.itsBoard.itsCells[row][col].itsCellType;
+            }
+        }
+        if (same) {
+            printTestResult(testNum, sizeName + " - restored game → same cells, key and player", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - restored game → same cells, key and player", false, "same", "different");
+            failed++;
+        }
+
+        // Test: the snapshot is a value, later moves don't change it
+        testNum++;
+        MoveList defenseMoves;
+        generateMoves(game, defenseMoves);
+        makeMove(game, defenseMoves.itsMoves[0]);
+        const GameSnapshot LATER = takeSnapshot(game);
+        if (SNAPSHOT.itsHash != LATER.itsHash && SNAPSHOT.itsCurrentPlayer == 2 && LATER.itsCurrentPlayer == 1) {
+            printTestResult(testNum, sizeName + " - game moved on → snapshot unchanged", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - game moved on → snapshot unchanged", false, "unchanged", "changed");
+            failed++;
+        }
+
+        deleteBoard(copy.itsBoard);
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: restoring into a game of another size reallocates its board
+    testNum++;
+    {
+        Game little;
+        little.itsBoard.itsSize = LITTLE;
+        createBoard(little.itsBoard);
+        initializeBoard(little.itsBoard);
+        Game big;
+        big.itsBoard.itsSize = BIG;
+        createBoard(big.itsBoard);
+        initializeBoard(big.itsBoard);
+        bool ok = restoreSnapshot(takeSnapshot(big), little) && little.itsBoard.itsSize == BIG
+                  && little.itsBoard.itsHash == big.itsBoard.itsHash;
+        if (ok) {
+            printTestResult(testNum, "LITTLE game restored from a BIG snapshot → BIG board", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "LITTLE game restored from a BIG snapshot → BIG board", false, "BIG", "other");
+            failed++;
+        }
+        deleteBoard(little.itsBoard);
+        deleteBoard(big.itsBoard);
+    }
+
+    // Test: invalid snapshots are rejected
+    testNum++;
+    {
+        GameSnapshot badPlayer;
+        badPlayer.itsCurrentPlayer = 3;
+        GameSnapshot badSize;
+        badSize.itsSize = static_cast<BoardSize>(20);
+        Game game;
+        if (!restoreSnapshot(badPlayer, game) && !restoreSnapshot(badSize, game) && game.itsBoard.itsCells == nullptr) {
+            printTestResult(testNum, "Invalid player / size → rejected", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "Invalid player / size → rejected", false, "false", "true");
+            failed++;
+        }
+        deleteBoard(game.itsBoard);
+    }
+
+    printTestSummary("takeSnapshot / restoreSnapshot", pass, failed);
+}
+
+
 /**
  * @brief Test function for the initializeBoard function.
  *
@@ -476,7 +824,7 @@ void test_initializeBoard()
 
         try {
             // Create expected board
-            Cell** expectedBoard = cb(size);
+            CellRow* expectedBoard = cb(size);
             resetBoard(expectedBoard, size);
 
             // Set fortresses (corners)
@@ -755,122 +1103,570 @@ void test_initializeBoard()
 
 
 /**
- * @brief Test function for the isValidPosition function.
+ * @brief Test function for the updateBitboards function.
  *
- * This function tests the isValidPosition function for different board sizes, valid positions,
- * and invalid positions. Tests include corners, edges, center, out-of-bounds positions, and
- * extreme values for both LITTLE and BIG board sizes.
+ * This function tests the updateBitboards function by checking that every mask matches the cells
+ * after initialization, that movePiece/capturePieces keep the masks synchronized, and that the
+ * mask-based endgame checks give the same answers as the cell scans.
  */
-void test_isValidPosition()
+void test_updateBitboards()
 {
-    printTestHeader("isValidPosition");
+    printTestHeader("updateBitboards");
     int pass = 0;
     int failed = 0;
     int testNum = 0;
 
-    struct TestCase {
-        string description;
-        Position pos;
-        bool expectedValid;
-        BoardSize boardSize;
+    // Compares every mask bit with the cell it represents
+    auto masksMatchCells = [](const Board& aBoard) {
+        for (int i = 0; i < aBoard.itsSize; ++i) {
+            for (int j = 0; j < aBoard.itsSize; ++j) {
+                const int index = i * aBoard.itsSize + j;
+                for (PieceType piece : {SHIELD, SWORD, KING}) {
+                    bool bit = (aBoard.itsPieceMasks[piece].itsWords[index / 64] >> (index % 64)) & 1;
+                    if (bit != (aBoard.itsCells[i][j].itsPieceType == piece)) return false;
+                }
+                for (CellType type : {FORTRESS, CASTLE}) {
+                    bool bit = (aBoard.itsCellMasks[type].itsWords[index / 64] >> (index % 64)) & 1;
+                    if (bit != (aBoard.itsCells[i][j].itsCellType == type)) return false;
+                }
+            }
+        }
+        return true;
     };
 
-    TestCase tests[] = {
-        // LITTLE board (11x11) - Valid positions
-        {"LITTLE - Top-left corner (0,0)", {0, 0}, true, LITTLE},
-        {"LITTLE - Top-right corner (0,10)", {0, 10}, true, LITTLE},
-        {"LITTLE - Bottom-left corner (10,0)", {10, 0}, true, LITTLE},
-        {"LITTLE - Bottom-right corner (10,10)", {10, 10}, true, LITTLE},
-        {"LITTLE - Center (5,5)", {5, 5}, true, LITTLE},
-        {"LITTLE - Top edge middle (0,5)", {0, 5}, true, LITTLE},
-        {"LITTLE - Bottom edge middle (10,5)", {10, 5}, true, LITTLE},
-        {"LITTLE - Left edge middle (5,0)", {5, 0}, true, LITTLE},
-        {"LITTLE - Right edge middle (5,10)", {5, 10}, true, LITTLE},
-        {"LITTLE - Random valid (3,7)", {3, 7}, true, LITTLE},
-
-        // LITTLE board (11x11) - Invalid positions (out of bounds)
-        {"LITTLE - Row negative (-1,0)", {-1, 0}, false, LITTLE},
-        {"LITTLE - Col negative (0,-1)", {0, -1}, false, LITTLE},
-        {"LITTLE - Both negative (-1,-1)", {-1, -1}, false, LITTLE},
-        {"LITTLE - Row too large (11,0)", {11, 0}, false, LITTLE},
-        {"LITTLE - Col too large (0,11)", {0, 11}, false, LITTLE},
-        {"LITTLE - Both too large (11,11)", {11, 11}, false, LITTLE},
-        {"LITTLE - Row very negative (-100,5)", {-100, 5}, false, LITTLE},
-        {"LITTLE - Col very large (5,999)", {5, 999}, false, LITTLE},
-
-        // BIG board (13x13) - Valid positions
-        {"BIG - Top-left corner (0,0)", {0, 0}, true, BIG},
-        {"BIG - Top-right corner (0,12)", {0, 12}, true, BIG},
-        {"BIG - Bottom-left corner (12,0)", {12, 0}, true, BIG},
-        {"BIG - Bottom-right corner (12,12)", {12, 12}, true, BIG},
-        {"BIG - Center (6,6)", {6, 6}, true, BIG},
-        {"BIG - Top edge middle (0,6)", {0, 6}, true, BIG},
-        {"BIG - Bottom edge middle (12,6)", {12, 6}, true, BIG},
-        {"BIG - Left edge middle (6,0)", {6, 0}, true, BIG},
-        {"BIG - Right edge middle (6,12)", {6, 12}, true, BIG},
-        {"BIG - Random valid (8,4)", {8, 4}, true, BIG},
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
 
-        // BIG board (13x13) - Invalid positions (out of bounds)
-        {"BIG - Row negative (-1,6)", {-1, 6}, false, BIG},
-        {"BIG - Col negative (6,-1)", {6, -1}, false, BIG},
-        {"BIG - Both negative (-5,-5)", {-5, -5}, false, BIG},
-        {"BIG - Row too large (13,6)", {13, 6}, false, BIG},
-        {"BIG - Col too large (6,13)", {6, 13}, false, BIG},
-        {"BIG - Both too large (13,13)", {13, 13}, false, BIG},
-        {"BIG - Row very negative (-999,6)", {-999, 6}, false, BIG},
-        {"BIG - Col very large (6,1000)", {6, 1000}, false, BIG},
-    };
+        // Test: initializeBoard builds synchronized masks
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        if (game.itsBoard.itsHasBitboards && masksMatchCells(game.itsBoard)) {
+            printTestResult(testNum, sizeName + " - initializeBoard → masks match cells", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - initializeBoard → masks match cells", false, "synchronized", "different");
+            failed++;
+        }
 
-    // Run all tests
-    for (const TestCase& test : tests) {
+        // Test: a capturing move keeps the masks synchronized
         testNum++;
-        bool result = isValidPosition(test.pos, {nullptr, test.boardSize});
+        resetBoard(game.itsBoard.itsCells, size);
+        game.itsBoard.itsCells[5][2].itsPieceType = SWORD;
+        game.itsBoard.itsCells[5][5].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[5][6].itsPieceType = SWORD;
+        updateBitboards(game.itsBoard);
+        game.itsCurrentPlayer = &game.itsPlayer1;
+        Move move = {{5, 2}, {5, 4}};
+        movePiece(game, move);
+        capturePieces(game, move);
+        if (masksMatchCells(game.itsBoard) && countPieces(game.itsBoard, SHIELD) == 0) {
+            printTestResult(testNum, sizeName + " - movePiece + capturePieces → masks still match cells", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - movePiece + capturePieces → masks still match cells", false, "synchronized", "different");
+            failed++;
+        }
 
-        if (result == test.expectedValid) {
-            printTestResult(testNum, test.description, true);
+        // Test: mask and scan paths agree on the endgame checks
+        testNum++;
+        resetBoard(game.itsBoard.itsCells, size);
+        game.itsBoard.itsCells[size-1][size-1] = {FORTRESS, KING};
+        game.itsBoard.itsCells[3][4].itsPieceType = SWORD;
+        Board scanBoard = {game.itsBoard.itsCells, size};
+        updateBitboards(game.itsBoard);
+        Position fastKing = getKingPosition(game.itsBoard);
+        Position scanKing = getKingPosition(scanBoard);
+        bool agree = fastKing.itsRow == scanKing.itsRow && fastKing.itsCol == scanKing.itsCol
+                     && isSwordLeft(game.itsBoard) == isSwordLeft(scanBoard)
+                     && isKingEscaped(game.itsBoard) == isKingEscaped(scanBoard)
+                     && isKingCapturedSimple(game.itsBoard) == isKingCapturedSimple(scanBoard);
+        if (agree && isKingEscaped(game.itsBoard)) {
+            printTestResult(testNum, sizeName + " - mask and scan endgame checks agree", true);
             pass++;
         } else {
-            printTestResult(testNum, test.description, false,
-                           test.expectedValid ? "valid" : "invalid",
-                           result ? "valid" : "invalid");
+            printTestResult(testNum, sizeName + " - mask and scan endgame checks agree", false, "same results", "different results");
             failed++;
         }
+
+        db(game.itsBoard.itsCells, size);
     }
 
-    printTestSummary("isValidPosition", pass, failed);
-}
+    // Test: nullptr board is rejected
+    testNum++;
+    Board nullBoard = {nullptr, LITTLE};
+    updateBitboards(nullBoard);
+    if (!nullBoard.itsHasBitboards) {
+        printTestResult(testNum, "nullptr board → no masks", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "nullptr board → no masks", false, "itsHasBitboards false", "true");
+        failed++;
+    }
 
+    printTestSummary("updateBitboards", pass, failed);
+}
 
 /**
- * @brief Test function for the getPositionFromInput function.
+ * @brief Test function for the computeHash function.
  *
- * This function tests the getPositionFromInput function by providing various input strings and
- * comparing the returned positions with expected positions. Tests cover valid inputs, boundary
- * cases, format errors, and invalid input conditions for both board sizes.
+ * This function tests the Zobrist key: starting keys, side to move, incremental updates done by
+ * makeMove/unmakeMove compared with a full recomputation, and two move orders reaching the same position.
  */
-void test_getPositionFromInput() {
-    printTestHeader("getPositionFromInput");
+void test_computeHash()
+{
+    printTestHeader("computeHash");
     int pass = 0;
     int failed = 0;
     int testNum = 0;
 
-    struct TestCase {
-        string input;
-        bool expectedResult;
-        int expectedRow;
-        int expectedCol;
-        BoardSize boardSize;
-        string description;
-    };
+    uint64_t startKeys[2] = {0, 0};
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        startKeys[size == BIG] = game.itsBoard.itsHash;
 
-    TestCase testCases[] = {
-        // LITTLE board (11x11) - Valid inputs (uppercase)
-        {"A1", true, 0, 0, LITTLE, "LITTLE - Valid 'A1' → (0,0) top-left corner"},
-        {"A11", true, 0, 10, LITTLE, "LITTLE - Valid 'A11' → (0,10) top-right corner"},
-        {"K1", true, 10, 0, LITTLE, "LITTLE - Valid 'K1' → (10,0) bottom-left corner"},
-        {"K11", true, 10, 10, LITTLE, "LITTLE - Valid 'K11' → (10,10) bottom-right corner"},
-        {"F6", true, 5, 5, LITTLE, "LITTLE - Valid 'F6' → (5,5) center"},
-        {"C7", true, 2, 6, LITTLE, "LITTLE - Valid 'C7' → (2,6) random position"},
+        // Test: starting key and side key
+        testNum++;
+        if (game.itsBoard.itsHash == computeHash(game.itsBoard, ATTACK) && game.itsBoard.itsHash != 0
+            && computeHash(game.itsBoard, DEFENSE) != computeHash(game.itsBoard, ATTACK)) {
+            printTestResult(testNum, sizeName + " - initial key, ATTACK to move", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - initial key, ATTACK to move", false, "computeHash(ATTACK)", "different");
+            failed++;
+        }
+
+        // Test: incremental key matches a full recomputation after every move
+        testNum++;
+        const int DEPTH = 30;
+        MoveUndo undos[DEPTH];
+        int played = 0;
+        bool incrementalOk = true;
+        unsigned int seed = 777u + size;
+        for (int ply = 0; ply < DEPTH; ++ply) {
+            MoveList list;
+            generateMoves(game, list);
+            // keep the moves ending 2 cells away from the edges (see test_unmakeMove)
+            int candidates[MAX_MOVES];
+            int count = 0;
+            for (int i = 0; i < list.itsCount; ++i) {
+                const Position& end = list.itsMoves[i].itsEndPosition;
+                if (end.itsRow >= 2 && end.itsRow < size - 2 && end.itsCol >= 2 && end.itsCol < size - 2) {
+                    candidates[count++] = i;
+                }
+            }
+            if (count == 0) {
+                break;
+            }
+            seed = seed * 1103515245u + 12345u;
+            undos[played++] = makeMove(game, list.itsMoves[candidates[(seed >> 16) % count]]);
+            incrementalOk = incrementalOk && game.itsBoard.itsHash == computeHash(game.itsBoard, game.itsCurrentPlayer->itsRole);
+        }
+        if (incrementalOk && played > 0) {
+            printTestResult(testNum, sizeName + " - " + to_string(played) + " moves → incremental key == computeHash", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - incremental key == computeHash", false, "equal", "different");
+            failed++;
+        }
+
+        // Test: undoing every move gives the starting key back
+        testNum++;
+        for (int ply = played - 1; ply >= 0; --ply) {
+            unmakeMove(game, undos[ply]);
+        }
+        if (game.itsBoard.itsHash == startKeys[size == BIG]) {
+            printTestResult(testNum, sizeName + " - moves undone → initial key", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - moves undone → initial key", false, "initial key", "different");
+            failed++;
+        }
+
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: both sizes have different starting keys
+    testNum++;
+    if (startKeys[0] != startKeys[1]) {
+        printTestResult(testNum, "LITTLE and BIG initial keys differ", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "LITTLE and BIG initial keys differ", false, "different", "equal");
+        failed++;
+    }
+
+    // Test: transposition, two move orders reach the same key
+    testNum++;
+    {
+        Game first;
+        first.itsBoard = {cb(LITTLE), LITTLE};
+        initializeBoard(first.itsBoard);
+        Game second;
+        second.itsBoard = {cb(LITTLE), LITTLE};
+        initializeBoard(second.itsBoard);
+        const Move attackA = {{0,3},{1,3}};
+        const Move attackB = {{0,7},{1,7}};
+        const Move defense = {{3,5},{3,3}};
+        makeMove(first, attackA);
+        makeMove(first, defense);
+        const uint64_t middleKey = first.itsBoard.itsHash;
+        makeMove(first, attackB);
+        makeMove(second, attackB);
+        makeMove(second, defense);
+        makeMove(second, attackA);
+        if (first.itsBoard.itsHash == second.itsBoard.itsHash && first.itsBoard.itsHash != middleKey) {
+            printTestResult(testNum, "Two move orders, same position → same key", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "Two move orders, same position → same key", false, "equal", "different");
+            failed++;
+        }
+        db(first.itsBoard.itsCells, LITTLE);
+        db(second.itsBoard.itsCells, LITTLE);
+    }
+
+    printTestSummary("computeHash", pass, failed);
+}
+
+/**
+ * @brief Counts the occurrences of a text in another one.
+ *
+ * @param aText The text to search.
+ * @param aPattern The text to count.
+ * @return The number of occurrences.
+ */
+static int countOccurrences(const string& aText, const string& aPattern) {
+    int count = 0;
+    for (size_t found = aText.find(aPattern); found != string::npos; found = aText.find(aPattern, found + aPattern.size())) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Test function for the writeBoardText function.
+ *
+ * This function tests the writeBoardText function on the starting positions of both sizes
+ * (lines, pieces and fortresses), checks that displayBoard prints the same text, and that
+ * a small buffer or a board without cells is refused.
+ */
+void test_writeBoardText()
+{
+    printTestHeader("writeBoardText");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Board board = {cb(size), size};
+        initializeBoard(board);
+        char text[BOARD_TEXT_CAPACITY];
+        TextBuffer buffer = {text, 0, BOARD_TEXT_CAPACITY};
+
+        // Test: starting position
+        testNum++;
+        const bool WRITTEN = writeBoardText(board, buffer);
+        const string TEXT(text, buffer.itsLength);
+        if (WRITTEN && countOccurrences(TEXT, "\n") == 2 + 2 * size && countOccurrences(TEXT, "⚔") == 24
+            && countOccurrences(TEXT, "♦") == 12 && countOccurrences(TEXT, "♕") == 1 && countOccurrences(TEXT, "♜") == 4
+            && TEXT.compare(0, 10, "      1   ") == 0) {
+            printTestResult(testNum, sizeName + " - starting position → " + to_string(2 + 2 * size) + " lines, 24 swords, 12 shields, 1 king", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - starting position", false, to_string(2 + 2 * size) + " lines", to_string(countOccurrences(TEXT, "\n")));
+            failed++;
+        }
+
+        // Test: displayBoard prints the same text
+        testNum++;
+        ostringstream oss;
+        streambuf* oldCoutBuf = cout.rdbuf(oss.rdbuf());
+        displayBoard(board);
+        cout.rdbuf(oldCoutBuf);
+        if (oss.str() == TEXT) {
+            printTestResult(testNum, sizeName + " - displayBoard → same text", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - displayBoard", false, "same text", "different text");
+            failed++;
+        }
+
+        // Test: buffer too small
+        testNum++;
+        TextBuffer small = {text, 0, 100};
+        if (!writeBoardText(board, small) && small.itsLength <= 100) {
+            printTestResult(testNum, sizeName + " - buffer of 100 bytes → false", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - buffer of 100 bytes", false, "false", "true");
+            failed++;
+        }
+        db(board.itsCells, size);
+    }
+
+    // Test: board without cells
+    testNum++;
+    char text[BOARD_TEXT_CAPACITY];
+    TextBuffer buffer = {text, 0, BOARD_TEXT_CAPACITY};
+    if (!writeBoardText(Board(), buffer) && buffer.itsLength == 0) {
+        printTestResult(testNum, "Board without cells → false", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Board without cells", false, "false", "true");
+        failed++;
+    }
+
+    printTestSummary("writeBoardText", pass, failed);
+}
+
+/**
+ * @brief Test function for the composeFrame and composeUpdate functions.
+ *
+ * This function tests that a full frame clears the screen and holds the logo, the status line
+ * and the board, and that an update only redraws the changed cells: none, the start and the end
+ * of a move, or the start, the end and the captured cell. A size change needs a full frame.
+ */
+void test_composeUpdate()
+{
+    printTestHeader("composeUpdate");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    BoardRenderer renderer;
+    createRenderer(renderer);
+    Game game;
+    parsePosition("11/11/11/2ad7/11/4a6/11/11/11/11/11 a", game);
+
+    // Test: no frame on the screen yet
+    testNum++;
+    if (composeUpdate(renderer, game.itsBoard, "status") == -1 && renderer.itsFrame.itsLength == 0) {
+        printTestResult(testNum, "Update before the first frame → -1", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Update before the first frame", false, "-1", "an update");
+        failed++;
+    }
+
+    // Test: full frame
+    testNum++;
+    char boardText[BOARD_TEXT_CAPACITY];
+    TextBuffer boardBuffer = {boardText, 0, BOARD_TEXT_CAPACITY};
+    writeBoardText(game.itsBoard, boardBuffer);
+    bool composed = composeFrame(renderer, game.itsBoard, "Turn to : ATTACK (Alice)");
+    string frame(renderer.itsFrame.itsData, renderer.itsFrame.itsLength);
+    if (composed && frame.compare(0, 7, "\x1b[H\x1b[2J") == 0 && frame.find(HNEFATAFL_LOGO[1]) != string::npos
+        && frame.find("Turn to : ATTACK (Alice)\n") != string::npos && frame.find(string(boardText, boardBuffer.itsLength)) != string::npos) {
+        printTestResult(testNum, "Full frame → clear, logo, status and board", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Full frame", false, "clear, logo, status and board", composed ? "missing parts" : "false");
+        failed++;
+    }
+
+    // Test: nothing changed
+    testNum++;
+    int changed = composeUpdate(renderer, game.itsBoard, "Turn to : ATTACK (Alice)");
+    frame.assign(renderer.itsFrame.itsData, renderer.itsFrame.itsLength);
+    if (changed == 0 && frame == "\x1b[16;1HTurn to : ATTACK (Alice)\x1b[K\x1b[41;1H\x1b[J") {
+        printTestResult(testNum, "No change → status line and erased prompts only", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "No change", false, "0 cells", to_string(changed) + " cells");
+        failed++;
+    }
+
+    // Test: move with a capture (F5-D5 captures the shield of D4)
+    testNum++;
+    makeMove(game, {{5, 4}, {3, 4}});
+    changed = composeUpdate(renderer, game.itsBoard, "Turn to : DEFENSE (Bob)");
+    frame.assign(renderer.itsFrame.itsData, renderer.itsFrame.itsLength);
+    if (changed == 3 && frame.find("\x1b[29;31H ") != string::npos && frame.find("\x1b[25;31H⚔") != string::npos
+        && frame.find("\x1b[25;25H ") != string::npos && frame.find("DEFENSE (Bob)") != string::npos
+        && frame.find("\x1b[2J") == string::npos) {
+        printTestResult(testNum, "Capture → start, end and captured cell redrawn", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Capture", false, "3 cells", to_string(changed) + " cells");
+        failed++;
+    }
+
+    // Test: move without capture
+    testNum++;
+    makeMove(game, {{3, 4}, {3, 8}});
+    changed = composeUpdate(renderer, game.itsBoard, "Turn to : ATTACK (Alice)");
+    frame.assign(renderer.itsFrame.itsData, renderer.itsFrame.itsLength);
+    if (changed == 2 && frame.find("\x1b[25;31H ") != string::npos && frame.find("\x1b[25;55H⚔") != string::npos) {
+        printTestResult(testNum, "Simple move → start and end redrawn", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Simple move", false, "2 cells", to_string(changed) + " cells");
+        failed++;
+    }
+
+    // Test: other board size
+    testNum++;
+    Game big;
+    parsePosition(POSITION_START_BIG, big);
+    if (composeUpdate(renderer, big.itsBoard, "status") == -1 && composeFrame(renderer, big.itsBoard, "status")
+        && composeUpdate(renderer, big.itsBoard, "status") == 0) {
+        printTestResult(testNum, "Board size changed → -1, then full frame", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Board size changed", false, "-1", "an update");
+        failed++;
+    }
+
+    // Test: invalidated screen
+    testNum++;
+    invalidateRenderer(renderer);
+    if (composeUpdate(renderer, big.itsBoard, "status") == -1) {
+        printTestResult(testNum, "After invalidateRenderer → -1", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "After invalidateRenderer", false, "-1", "an update");
+        failed++;
+    }
+
+    // Test: renderer without buffer
+    testNum++;
+    deleteRenderer(renderer);
+    if (!composeFrame(renderer, big.itsBoard, "status")) {
+        printTestResult(testNum, "Renderer without buffer → false", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Renderer without buffer", false, "false", "true");
+        failed++;
+    }
+    deleteBoard(game.itsBoard);
+    deleteBoard(big.itsBoard);
+
+    printTestSummary("composeUpdate", pass, failed);
+}
+
+/**
+ * @brief Test function for the isValidPosition function.
+ *
+ * This function tests the isValidPosition function for different board sizes, valid positions,
+ * and invalid positions. Tests include corners, edges, center, out-of-bounds positions, and
+ * extreme values for both LITTLE and BIG board sizes.
+ */
+void test_isValidPosition()
+{
+    printTestHeader("isValidPosition");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    struct TestCase {
+        string description;
+        Position pos;
+        bool expectedValid;
+        BoardSize boardSize;
+    };
+
+    TestCase tests[] = {
+        // LITTLE board (11x11) - Valid positions
+        {"LITTLE - Top-left corner (0,0)", {0, 0}, true, LITTLE},
+        {"LITTLE - Top-right corner (0,10)", {0, 10}, true, LITTLE},
+        {"LITTLE - Bottom-left corner (10,0)", {10, 0}, true, LITTLE},
+        {"LITTLE - Bottom-right corner (10,10)", {10, 10}, true, LITTLE},
+        {"LITTLE - Center (5,5)", {5, 5}, true, LITTLE},
+        {"LITTLE - Top edge middle (0,5)", {0, 5}, true, LITTLE},
+        {"LITTLE - Bottom edge middle (10,5)", {10, 5}, true, LITTLE},
+        {"LITTLE - Left edge middle (5,0)", {5, 0}, true, LITTLE},
+        {"LITTLE - Right edge middle (5,10)", {5, 10}, true, LITTLE},
+        {"LITTLE - Random valid (3,7)", {3, 7}, true, LITTLE},
+
+        // LITTLE board (11x11) - Invalid positions (out of bounds)
+        {"LITTLE - Row negative (-1,0)", {-1, 0}, false, LITTLE},
+        {"LITTLE - Col negative (0,-1)", {0, -1}, false, LITTLE},
+        {"LITTLE - Both negative (-1,-1)", {-1, -1}, false, LITTLE},
+        {"LITTLE - Row too large (11,0)", {11, 0}, false, LITTLE},
+        {"LITTLE - Col too large (0,11)", {0, 11}, false, LITTLE},
+        {"LITTLE - Both too large (11,11)", {11, 11}, false, LITTLE},
+        {"LITTLE - Row very negative (-100,5)", {-100, 5}, false, LITTLE},
+        {"LITTLE - Col very large (5,999)", {5, 999}, false, LITTLE},
+
+        // BIG board (13x13) - Valid positions
+        {"BIG - Top-left corner (0,0)", {0, 0}, true, BIG},
+        {"BIG - Top-right corner (0,12)", {0, 12}, true, BIG},
+        {"BIG - Bottom-left corner (12,0)", {12, 0}, true, BIG},
+        {"BIG - Bottom-right corner (12,12)", {12, 12}, true, BIG},
+        {"BIG - Center (6,6)", {6, 6}, true, BIG},
+        {"BIG - Top edge middle (0,6)", {0, 6}, true, BIG},
+        {"BIG - Bottom edge middle (12,6)", {12, 6}, true, BIG},
+        {"BIG - Left edge middle (6,0)", {6, 0}, true, BIG},
+        {"BIG - Right edge middle (6,12)", {6, 12}, true, BIG},
+        {"BIG - Random valid (8,4)", {8, 4}, true, BIG},
+
+        // BIG board (13x13) - Invalid positions (out of bounds)
+        {"BIG - Row negative (-1,6)", {-1, 6}, false, BIG},
+        {"BIG - Col negative (6,-1)", {6, -1}, false, BIG},
+        {"BIG - Both negative (-5,-5)", {-5, -5}, false, BIG},
+        {"BIG - Row too large (13,6)", {13, 6}, false, BIG},
+        {"BIG - Col too large (6,13)", {6, 13}, false, BIG},
+        {"BIG - Both too large (13,13)", {13, 13}, false, BIG},
+        {"BIG - Row very negative (-999,6)", {-999, 6}, false, BIG},
+        {"BIG - Col very large (6,1000)", {6, 1000}, false, BIG},
+    };
+
+    // Run all tests
+    for (const TestCase& test : tests) {
+        testNum++;
+        bool result = isValidPosition(test.pos, {nullptr, test.boardSize});
+
+        if (result == test.expectedValid) {
+            printTestResult(testNum, test.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, test.description, false,
+                           test.expectedValid ? "valid" : "invalid",
+                           result ? "valid" : "invalid");
+            failed++;
+        }
+    }
+
+    printTestSummary("isValidPosition", pass, failed);
+}
+
+
+/**
+ * @brief Test function for the getPositionFromInput function.
+ *
+ * This function tests the getPositionFromInput function by providing various input strings and
+ * comparing the returned positions with expected positions. Tests cover valid inputs, boundary
+ * cases, format errors, and invalid input conditions for both board sizes.
+ */
+void test_getPositionFromInput() {
+    printTestHeader("getPositionFromInput");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    struct TestCase {
+        string input;
+        bool expectedResult;
+        int expectedRow;
+        int expectedCol;
+        BoardSize boardSize;
+        string description;
+    };
+
+    TestCase testCases[] = {
+        // LITTLE board (11x11) - Valid inputs (uppercase)
+        {"A1", true, 0, 0, LITTLE, "LITTLE - Valid 'A1' → (0,0) top-left corner"},
+        {"A11", true, 0, 10, LITTLE, "LITTLE - Valid 'A11' → (0,10) top-right corner"},
+        {"K1", true, 10, 0, LITTLE, "LITTLE - Valid 'K1' → (10,0) bottom-left corner"},
+        {"K11", true, 10, 10, LITTLE, "LITTLE - Valid 'K11' → (10,10) bottom-right corner"},
+        {"F6", true, 5, 5, LITTLE, "LITTLE - Valid 'F6' → (5,5) center"},
+        {"C7", true, 2, 6, LITTLE, "LITTLE - Valid 'C7' → (2,6) random position"},
 
         // LITTLE board (11x11) - Valid inputs (lowercase - should work)
         {"a1", true, 0, 0, LITTLE, "LITTLE - Valid lowercase 'a1' → (0,0)"},
@@ -1038,14 +1834,14 @@ void test_isEmptyCell()
     };
 
     // Create and configure boards for each size
-    Cell** boardLittle = cb(LITTLE);
-    Cell** boardBig = cb(BIG);
+    CellRow* boardLittle = cb(LITTLE);
+    CellRow* boardBig = cb(BIG);
     resetBoard(boardLittle, LITTLE);
     resetBoard(boardBig, BIG);
 
     // Setup test cells for each board according to test cases
     for (const TestCase& tc : testCases) {
-        Cell** currentBoard = (tc.boardSize == LITTLE) ? boardLittle : boardBig;
+        CellRow* currentBoard = (tc.boardSize == LITTLE) ? boardLittle : boardBig;
         currentBoard[tc.pos.itsRow][tc.pos.itsCol] = {tc.cellType, tc.pieceType};
     }
 
@@ -1060,7 +1856,7 @@ void test_isEmptyCell()
     // Execute all test cases
     for (const TestCase& tc : testCases) {
         testNum++;
-        Cell** currentBoard = (tc.boardSize == LITTLE) ? boardLittle : boardBig;
+        CellRow* currentBoard = (tc.boardSize == LITTLE) ? boardLittle : boardBig;
         Board board = {currentBoard, tc.boardSize};
 
         bool result = isEmptyCell(board, tc.pos);
@@ -1084,6 +1880,337 @@ void test_isEmptyCell()
     printTestSummary("isEmptyCell", pass, failed);
 }
 
+/**
+ * @brief Test function for the formatPosition function.
+ *
+ * This function tests the formatPosition function on the starting positions of both sizes,
+ * with the DEFENSE role to move, and checks that a small buffer or a board without cells is refused.
+ */
+void test_formatPosition()
+{
+    printTestHeader("formatPosition");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        const string EXPECTED = (size == LITTLE) ? POSITION_START_LITTLE : POSITION_START_BIG;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        char text[POSITION_TEXT_CAPACITY];
+
+        // Test: starting position
+        testNum++;
+        int length = formatPosition(game, text, POSITION_TEXT_CAPACITY);
+        if (length == static_cast<int>(EXPECTED.size()) && EXPECTED == text) {
+            printTestResult(testNum, sizeName + " - starting position → " + EXPECTED, true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - starting position", false, EXPECTED, (length < 0) ? "-1" : string(text));
+            failed++;
+        }
+
+        // Test: DEFENSE to move
+        testNum++;
+        game.itsCurrentPlayer = &game.itsPlayer2;
+        length = formatPosition(game, text, POSITION_TEXT_CAPACITY);
+        if (length > 0 && text[length - 1] == 'd' && text[length - 2] == ' ') {
+            printTestResult(testNum, sizeName + " - DEFENSE to move → ends with \" d\"", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - DEFENSE to move", false, "ends with \" d\"", (length < 0) ? "-1" : string(text));
+            failed++;
+        }
+
+        // Test: buffer one byte too small (no room for the final 0)
+        testNum++;
+        char small[POSITION_TEXT_CAPACITY];
+        length = formatPosition(game, small, static_cast<int>(EXPECTED.size()));
+        if (length == -1) {
+            printTestResult(testNum, sizeName + " - buffer too small → -1", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - buffer too small", false, "-1", to_string(length));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: board without cells
+    testNum++;
+    Game empty;
+    char text[POSITION_TEXT_CAPACITY];
+    if (formatPosition(empty, text, POSITION_TEXT_CAPACITY) == -1) {
+        printTestResult(testNum, "Board without cells → -1", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Board without cells", false, "-1", "a length");
+        failed++;
+    }
+
+    printTestSummary("formatPosition", pass, failed);
+}
+
+/**
+ * @brief Test function for the parsePosition function.
+ *
+ * This function tests the parsePosition function on the starting positions, on the positions
+ * of random games (written then read back), and on malformed texts which must leave the game untouched.
+ */
+void test_parsePosition()
+{
+    printTestHeader("parsePosition");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game reference;
+        reference.itsBoard = {cb(size), size};
+        initializeBoard(reference.itsBoard);
+
+        // Test: starting position, same cells, bitboards and key as initializeBoard
+        testNum++;
+        Game game;
+        game.itsPlayer1.itsName = "Alice";
+        const bool PARSED = parsePosition((size == LITTLE) ? POSITION_START_LITTLE : POSITION_START_BIG, game);
+        if (PARSED && game.itsBoard.itsSize == size && memcmp(game.itsBoard.itsPieceMasks, reference.itsBoard.itsPieceMasks, sizeof(BitBoard) * 4) == 0
+            && game.itsBoard.itsHasBitboards && game.itsBoard.itsHash == reference.itsBoard.itsHash
+            && game.itsCurrentPlayer == &game.itsPlayer1 && game.itsPlayer1.itsRole == ATTACK && game.itsPlayer1.itsName == "Alice") {
+            printTestResult(testNum, sizeName + " - starting position → same pieces and key as initializeBoard", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - starting position", false, "same board", PARSED ? "different board" : "refused");
+            failed++;
+        }
+
+        // Test: positions of a random game, written then read back
+        testNum++;
+        unsigned int seed = 77u + size;
+        MoveList moves;
+        char text[POSITION_TEXT_CAPACITY];
+        bool same = true;
+        int positions = 0;
+        for (int ply = 0; ply < 200 && same && !isGameFinished(reference); ++ply) {
+            same = formatPosition(reference, text, POSITION_TEXT_CAPACITY) > 0 && parsePosition(text, game)
+                   && memcmp(game.itsBoard.itsPieceMasks, reference.itsBoard.itsPieceMasks, sizeof(BitBoard) * 4) == 0
+                   && game.itsBoard.itsHash == reference.itsBoard.itsHash
+                   && game.itsCurrentPlayer->itsRole == reference.itsCurrentPlayer->itsRole;
+            positions++;
+            const int COUNT = generateMoves(reference, moves);
+            if (COUNT == 0) {
+                break;
+            }
+            seed = seed * 1103515245u + 12345u;
+            makeMove(reference, moves.itsMoves[(seed >> 16) % COUNT]);
+        }
+        if (same) {
+            printTestResult(testNum, sizeName + " - " + to_string(positions) + " positions of a random game → read back identical", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - random game positions", false, "identical", "different at position " + to_string(positions));
+            failed++;
+        }
+        deleteBoard(game.itsBoard);
+        db(reference.itsBoard.itsCells, size);
+    }
+
+    // Test: DEFENSE to move, line end and a king alone
+    testNum++;
+    {
+        Game game;
+        const bool PARSED = parsePosition("11/11/11/11/11/5k5/11/11/11/10a/11 d\r\n", game);
+        if (PARSED && game.itsBoard.itsSize == LITTLE && game.itsCurrentPlayer == &game.itsPlayer2
+            && game.itsBoard.itsCells[5][5].itsPieceType == KING && game.itsBoard.itsCells[5][5].itsCellType == CASTLE
+            && game.itsBoard.itsCells[9][10].itsPieceType == SWORD && game.itsBoard.itsCells[0][0].itsCellType == FORTRESS
+            && game.itsBoard.itsPieceCounts[SWORD] == 1
+            && game.itsBoard.itsHash == computeHash(game.itsBoard, DEFENSE)) {
+            printTestResult(testNum, "Sparse position, DEFENSE to move, CRLF → read", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "Sparse position, DEFENSE to move, CRLF", false, "read", PARSED ? "wrong board" : "refused");
+            failed++;
+        }
+        deleteBoard(game.itsBoard);
+    }
+
+    // Malformed texts: the game keeps its starting position
+    struct TestCase {
+        string text;
+        string description;
+    };
+    TestCase testCases[] = {
+        {"", "Empty text"},
+        {"11/11/11/11/11/5k5/11/11/11/11/11", "Missing role"},
+        {"11/11/11/11/11/5k5/11/11/11/11/11 x", "Unknown role"},
+        {"11/11/11/11/11/5k5/11/11/11/11/11  a", "Two spaces before the role"},
+        {"11/11/11/11/11/5k5/11/11/11/11 a", "10 rows of 11 cells"},
+        {"11/11/11/11/11/5k5/11/11/11/11/11/11 a", "12 rows of 11 cells"},
+        {"11/11/11/11/11/5k5/11/11/11/12/11 a", "One row too wide"},
+        {"11/11/11/11/11/5k4/11/11/11/11/11 a", "One row too short"},
+        {"12/12/12/12/12/12/12/12/12/12/12/12 a", "12x12 board"},
+        {"11/11/11/11/11/5x5/11/11/11/11/11 a", "Unknown piece"},
+        {"11/11/11/11/11/4kk5/11/11/11/11/11 a", "Two kings"},
+        {"a10/11/11/11/11/5k5/11/11/11/11/11 a", "SWORD on a FORTRESS"},
+        {"11/11/11/11/11/5d5/11/11/11/11/11 a", "SHIELD on the CASTLE"},
+        {"11/11/11/11/11/05k5/11/11/11/11/11 a", "Run starting with 0"},
+        {"99/11/11/11/11/5k5/11/11/11/11/11 a", "Run longer than a row"},
+    };
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(game.itsBoard);
+    const uint64_t START_HASH = game.itsBoard.itsHash;
+    for (const TestCase& tc : testCases) {
+        testNum++;
+        const bool PARSED = parsePosition(tc.text, game);
+        if (!PARSED && game.itsBoard.itsHash == START_HASH && game.itsBoard.itsCells[5][5].itsPieceType == KING) {
+            printTestResult(testNum, tc.description + " → refused, game unchanged", true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, "refused", PARSED ? "read" : "game modified");
+            failed++;
+        }
+    }
+    db(game.itsBoard.itsCells, LITTLE);
+
+    printTestSummary("parsePosition", pass, failed);
+}
+
+/**
+ * @brief Test function for the formatMove function.
+ *
+ * This function tests the formatMove function on moves with one and two digit columns,
+ * and checks that a small buffer or a position out of range is refused.
+ */
+void test_formatMove()
+{
+    printTestHeader("formatMove");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    struct TestCase {
+        Move move;
+        int capacity;
+        string expected;
+        string description;
+    };
+    TestCase testCases[] = {
+        {{{5, 1}, {5, 4}}, MOVE_TEXT_CAPACITY, "F2-F5", "Horizontal move"},
+        {{{0, 3}, {9, 3}}, MOVE_TEXT_CAPACITY, "A4-J4", "Vertical move"},
+        {{{12, 12}, {12, 9}}, MOVE_TEXT_CAPACITY, "M13-M10", "Two digit columns"},
+        {{{12, 12}, {12, 9}}, 7, "", "Buffer too small"},
+        {{{13, 0}, {12, 0}}, MOVE_TEXT_CAPACITY, "", "Row out of range"},
+        {{{0, -1}, {0, 2}}, MOVE_TEXT_CAPACITY, "", "Negative column"},
+    };
+    for (const TestCase& tc : testCases) {
+        testNum++;
+        char text[MOVE_TEXT_CAPACITY];
+        const int LENGTH = formatMove(tc.move, text, tc.capacity);
+        const bool OK = tc.expected.empty() ? LENGTH == -1 : (LENGTH == static_cast<int>(tc.expected.size()) && tc.expected == text);
+        if (OK) {
+            printTestResult(testNum, tc.description + " → " + (tc.expected.empty() ? "-1" : tc.expected), true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, tc.expected.empty() ? "-1" : tc.expected, (LENGTH < 0) ? "-1" : string(text));
+            failed++;
+        }
+    }
+
+    printTestSummary("formatMove", pass, failed);
+}
+
+/**
+ * @brief Test function for the parseMove function.
+ *
+ * This function tests the parseMove function with valid moves (uppercase, lowercase, without `-`,
+ * with a line end), with malformed texts and with positions out of the board for both sizes,
+ * and reads back every move generated from the starting positions.
+ */
+void test_parseMove()
+{
+    printTestHeader("parseMove");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    struct TestCase {
+        string text;
+        BoardSize size;
+        bool expectedValid;
+        Move expected;
+        string description;
+    };
+    TestCase testCases[] = {
+        {"F2-F5", LITTLE, true, {{5, 1}, {5, 4}}, "Uppercase move"},
+        {"a4-j4", LITTLE, true, {{0, 3}, {9, 3}}, "Lowercase move"},
+        {"A4J4", LITTLE, true, {{0, 3}, {9, 3}}, "Move without -"},
+        {"K11-K8\n", LITTLE, true, {{10, 10}, {10, 7}}, "Last row and column of LITTLE, line end"},
+        {"M13-M10", BIG, true, {{12, 12}, {12, 9}}, "Last row and column of BIG"},
+        {"M13-M10", LITTLE, false, {}, "Row M on LITTLE"},
+        {"A12-A13", LITTLE, false, {}, "Column 12 on LITTLE"},
+        {"A14-A1", BIG, false, {}, "Column 14 on BIG"},
+        {"A0-A1", LITTLE, false, {}, "Column 0"},
+        {"A1-", LITTLE, false, {}, "Missing end"},
+        {"A1-B2-C3", LITTLE, false, {}, "Extra characters"},
+        {"11-A1", LITTLE, false, {}, "Missing row letter"},
+        {"", LITTLE, false, {}, "Empty text"},
+    };
+    for (const TestCase& tc : testCases) {
+        testNum++;
+        Move move = {{-1, -1}, {-1, -1}};
+        const bool VALID = parseMove(tc.text, tc.size, move);
+        const bool SAME = move.itsStartPosition.itsRow == tc.expected.itsStartPosition.itsRow
+                          && move.itsStartPosition.itsCol == tc.expected.itsStartPosition.itsCol
+                          && move.itsEndPosition.itsRow == tc.expected.itsEndPosition.itsRow
+                          && move.itsEndPosition.itsCol == tc.expected.itsEndPosition.itsCol;
+        if (VALID == tc.expectedValid && (!VALID || SAME)) {
+            printTestResult(testNum, tc.description + " → " + (tc.expectedValid ? "read" : "refused"), true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, tc.expectedValid ? "read" : "refused", VALID ? "read" : "refused");
+            failed++;
+        }
+    }
+
+    // Test: every starting move is written and read back
+    for (BoardSize size : {LITTLE, BIG}) {
+        testNum++;
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        MoveList moves;
+        const int COUNT = generateMoves(game, moves);
+        int same = 0;
+        for (int i = 0; i < COUNT; ++i) {
+            char text[MOVE_TEXT_CAPACITY];
+            Move move;
+            if (formatMove(moves.itsMoves[i], text, MOVE_TEXT_CAPACITY) > 0 && parseMove(text, size, move)
+                && checkMovement(game, move) == VALID_MOVE
+                && move.itsStartPosition.itsRow == moves.itsMoves[i].itsStartPosition.itsRow
+                && move.itsStartPosition.itsCol == moves.itsMoves[i].itsStartPosition.itsCol
+                && move.itsEndPosition.itsRow == moves.itsMoves[i].itsEndPosition.itsRow
+                && move.itsEndPosition.itsCol == moves.itsMoves[i].itsEndPosition.itsCol) {
+                same++;
+            }
+        }
+        if (same == COUNT && COUNT > 0) {
+            printTestResult(testNum, sizeName + " - " + to_string(COUNT) + " starting moves → read back identical", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - starting moves", false, to_string(COUNT), to_string(same));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+    }
+
+    printTestSummary("parseMove", pass, failed);
+}
+
 /**
  * @brief Test function for the isValidMovement function.
  *
@@ -1295,6 +2422,126 @@ void test_isValidMovement()
     printTestSummary("isValidMovement", pass, failed);
 }
 
+/**
+ * @brief Test function for the checkMovement function.
+ *
+ * This function tests the checkMovement function by checking the status returned for each
+ * kind of rejected move, that nothing is printed, and that the moves accepted on the starting
+ * boards are exactly the ones returned by generateMoves.
+ */
+void test_checkMovement()
+{
+    printTestHeader("checkMovement");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    const string STATUS_NAMES[] = {"VALID_MOVE", "OUT_OF_BOUNDS", "WRONG_PIECE", "SPECIAL_CELL", "NO_MOVEMENT", "NOT_STRAIGHT", "BLOCKED"};
+
+    // === Category 1: one status per case ===
+    struct StatusTestCase {
+        PlayerRole role;
+        Move move;
+        MoveStatus expected;
+        string description;
+    };
+    // Board: SWORD at D4, SHIELD at D8, KING at C1, FORTRESS at A1, CASTLE at F6
+    StatusTestCase tests[] = {
+        {ATTACK, {{3, 3}, {3, 5}}, VALID_MOVE, "SWORD D4→D6 → VALID_MOVE"},
+        {ATTACK, {{3, 3}, {0, 3}}, VALID_MOVE, "SWORD D4→A4 (toward row A) → VALID_MOVE"},
+        {ATTACK, {{3, 3}, {3, 11}}, OUT_OF_BOUNDS, "SWORD D4→D12 → OUT_OF_BOUNDS"},
+        {ATTACK, {{-1, 3}, {3, 3}}, OUT_OF_BOUNDS, "Start (-1,3) → OUT_OF_BOUNDS"},
+        {ATTACK, {{3, 7}, {3, 9}}, WRONG_PIECE, "ATTACK moves SHIELD D8 → WRONG_PIECE"},
+        {DEFENSE, {{4, 4}, {4, 6}}, WRONG_PIECE, "DEFENSE moves empty E5 → WRONG_PIECE"},
+        {ATTACK, {{3, 5}, {5, 5}}, WRONG_PIECE, "ATTACK moves from empty D6 → WRONG_PIECE"},
+        {DEFENSE, {{3, 7}, {5, 7}}, VALID_MOVE, "SHIELD D8→F8 → VALID_MOVE"},
+        {DEFENSE, {{2, 0}, {0, 0}}, VALID_MOVE, "KING C1→A1 FORTRESS → VALID_MOVE"},
+        {ATTACK, {{3, 3}, {3, 3}}, NO_MOVEMENT, "SWORD D4→D4 → NO_MOVEMENT"},
+        {ATTACK, {{3, 3}, {5, 5}}, SPECIAL_CELL, "SWORD D4→F6 CASTLE → SPECIAL_CELL"},
+        {ATTACK, {{3, 3}, {4, 4}}, NOT_STRAIGHT, "SWORD D4→E5 → NOT_STRAIGHT"},
+        {ATTACK, {{3, 3}, {3, 9}}, BLOCKED, "SWORD D4→D10 over SHIELD D8 → BLOCKED"},
+        {ATTACK, {{3, 3}, {3, 7}}, BLOCKED, "SWORD D4→D8 occupied → BLOCKED"},
+        {DEFENSE, {{3, 7}, {3, 2}}, BLOCKED, "SHIELD D8→D3 over SWORD D4 → BLOCKED"},
+    };
+
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    resetBoard(game.itsBoard.itsCells, LITTLE);
+    game.itsBoard.itsCells[3][3].itsPieceType = SWORD;
+    game.itsBoard.itsCells[3][7].itsPieceType = SHIELD;
+    game.itsBoard.itsCells[2][0].itsPieceType = KING;
+    game.itsBoard.itsCells[0][0].itsCellType = FORTRESS;
+    game.itsBoard.itsCells[5][5].itsCellType = CASTLE;
+
+    // Capture both streams: the validation must stay silent
+    streambuf* oldCoutBuf = cout.rdbuf();
+    streambuf* oldCerrBuf = cerr.rdbuf();
+    ostringstream output;
+
+    for (const StatusTestCase& tc : tests) {
+        testNum++;
+        game.itsCurrentPlayer = (tc.role == ATTACK) ? &game.itsPlayer1 : &game.itsPlayer2;
+        cout.rdbuf(output.rdbuf());
+        cerr.rdbuf(output.rdbuf());
+        MoveStatus result = checkMovement(game, tc.move);
+        cout.rdbuf(oldCoutBuf);
+        cerr.rdbuf(oldCerrBuf);
+        if (result == tc.expected) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, STATUS_NAMES[tc.expected], STATUS_NAMES[result]);
+            failed++;
+        }
+    }
+
+    // Test: nothing was printed
+    testNum++;
+    if (output.str().empty()) {
+        printTestResult(testNum, "No output on cout/cerr during validation", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "No output on cout/cerr during validation", false, "empty", output.str());
+        failed++;
+    }
+    db(game.itsBoard.itsCells, LITTLE);
+
+    // === Category 2: agreement with generateMoves on the starting boards ===
+    for (BoardSize size : {LITTLE, BIG}) {
+        for (PlayerRole role : {ATTACK, DEFENSE}) {
+            testNum++;
+            Game start;
+            start.itsBoard = {cb(size), size};
+            initializeBoard(start.itsBoard);
+            start.itsCurrentPlayer = (role == ATTACK) ? &start.itsPlayer1 : &start.itsPlayer2;
+            int validCount = 0;
+            for (int i = 0; i < size * size; ++i) {
+                for (int j = 0; j < size * size; ++j) {
+                    if (checkMovement(start, {{i / size, i % size}, {j / size, j % size}}) == VALID_MOVE) validCount++;
+                }
+            }
+            MoveList list;
+            int generated = generateMoves(start, list);
+            bool allValid = true;
+            for (int i = 0; i < list.itsCount; ++i) {
+                if (!isValidMovement(start, list.itsMoves[i])) allValid = false;
+            }
+            const string description = string(size == LITTLE ? "LITTLE" : "BIG") + "/" + (role == ATTACK ? "ATTACK" : "DEFENSE")
+                                       + " - every (start, end) pair agrees with generateMoves";
+            if (allValid && validCount == generated) {
+                printTestResult(testNum, description, true);
+                pass++;
+            } else {
+                printTestResult(testNum, description, false, to_string(generated), to_string(validCount));
+                failed++;
+            }
+            db(start.itsBoard.itsCells, size);
+        }
+    }
+
+    printTestSummary("checkMovement", pass, failed);
+}
+
 /**
  * @brief Test the movePiece function with different board sizes and piece types.
  *
@@ -1809,10 +3056,64 @@ void test_capturePieces()
             {}, 0,
             "ATTACK - SWORD G6→G7 captures 2 SHIELDs on BIG board (13x13)"
         },
+
+        // Test 26: Left edge - the border is not an anvil
+        {
+            ATTACK, SWORD, {{5, 1}, {5, 0}}, LITTLE,
+            {
+                {{5, 1}, NORMAL, SWORD},
+                {{4, 0}, NORMAL, SHIELD},     // Adjacent North, empty beyond
+                {{6, 0}, NORMAL, SHIELD}      // Adjacent South, empty beyond
+            }, 3,
+            {}, 0,
+            {{{4, 0}, SHIELD}, {{6, 0}, SHIELD}}, 2,
+            "ATTACK - SWORD F2→F1 at left edge: no captures (same as the right edge)"
+        },
+
+        // Test 27: Piece against the top border, attacked from below
+        {
+            ATTACK, SWORD, {{2, 6}, {1, 6}}, LITTLE,
+            {
+                {{2, 6}, NORMAL, SWORD},
+                {{0, 6}, NORMAL, SHIELD}      // Against the border: nothing behind it
+            }, 2,
+            {}, 0,
+            {{{0, 6}, SHIELD}}, 1,
+            "ATTACK - SWORD C7→B7: SHIELD at A7 against the border not captured"
+        },
+
+        // Test 28: Row + column = SIZE-1 must not capture without anvil
+        {
+            DEFENSE, SHIELD, {{9, 1}, {9, 3}}, LITTLE,
+            {
+                {{9, 1}, NORMAL, SHIELD},
+                {{9, 4}, NORMAL, SWORD},      // East neighbor, empty beyond
+                {{10, 3}, NORMAL, SWORD}      // South neighbor, against the border
+            }, 3,
+            {}, 0,
+            {{{9, 4}, SWORD}, {{10, 3}, SWORD}}, 2,
+            "DEFENSE - SHIELD J2→J4: no captures without anvil near the bottom edge"
+        },
+
+        // Test 29: Bottom right corner area with anvils on both sides
+        {
+            DEFENSE, SHIELD, {{8, 12}, {10, 12}}, BIG,
+            {
+                {{8, 12}, NORMAL, SHIELD},
+                {{11, 12}, NORMAL, SWORD}, {{12, 12}, FORTRESS, NONE}, // South: FORTRESS anvil
+                {{10, 11}, NORMAL, SWORD}, {{10, 10}, NORMAL, KING}    // West: KING anvil
+            }, 5,
+            {{11, 12}, {10, 11}}, 2,
+            {}, 0,
+            "DEFENSE - SHIELD I13→K13 on BIG board: captures at the border with FORTRESS and KING anvils"
+        },
     };
 
-    // Execute all test cases
-    for (const TestCase& tc : tests) {
+    // Execute all test cases, on plain cells then with bitboards (mask path)
+    const int CASE_COUNT = sizeof(tests) / sizeof(tests[0]);
+    for (int run = 0; run < 2 * CASE_COUNT; ++run) {
+        const TestCase& tc = tests[run % CASE_COUNT];
+        const bool withBitboards = run >= CASE_COUNT;
         // Setup board
         Game game;
         game.itsBoard = {cb(tc.boardSize), tc.boardSize};
@@ -1829,6 +3130,9 @@ void test_capturePieces()
             game.itsBoard.itsCells[setup.pos.itsRow][setup.pos.itsCol].itsCellType = setup.cellType;
             game.itsBoard.itsCells[setup.pos.itsRow][setup.pos.itsCol].itsPieceType = setup.pieceType;
         }
+        if (withBitboards) {
+            updateBitboards(game.itsBoard);
+        }
 
         if (DISPLAY_BOARDS) {
             cout << "  Before move:" << endl;
@@ -1866,16 +3170,35 @@ void test_capturePieces()
             }
         }
 
+        // With bitboards, the masks must match the cells after the captures
+        bool masksSynchronized = true;
+        if (withBitboards) {
+            Board fresh = {cb(tc.boardSize), tc.boardSize};
+            for (int row = 0; row < tc.boardSize; ++row) {
+                for (int col = 0; col < tc.boardSize; ++col) {
+                    fresh.itsCells[row][col] = game.itsBoard.itsCells[row][col];
+                }
+            }
+            updateBitboards(fresh);
+            for (PieceType piece : {SHIELD, SWORD, KING}) {
+                masksSynchronized = masksSynchronized && game.itsBoard.itsPieceCounts[piece] == fresh.itsPieceCounts[piece]
+                                    && memcmp(&game.itsBoard.itsPieceMasks[piece], &fresh.itsPieceMasks[piece], sizeof(BitBoard)) == 0;
+            }
+            db(fresh.itsCells, tc.boardSize);
+        }
+
         testNum++;
-        if (allCaptured && allNonCaptured) {
-            printTestResult(testNum, tc.description, true);
+        const string description = tc.description + (withBitboards ? " [bitboards]" : "");
+        if (allCaptured && allNonCaptured && masksSynchronized) {
+            printTestResult(testNum, description, true);
             pass++;
         } else {
             string expected = "all captures/non-captures correct";
             string actual = "";
             if (!allCaptured) actual += "some expected captures not removed ";
-            if (!allNonCaptured) actual += "some pieces wrongly captured/modified";
-            printTestResult(testNum, tc.description, false, expected, actual);
+            if (!allNonCaptured) actual += "some pieces wrongly captured/modified ";
+            if (!masksSynchronized) actual += "bitboards out of sync";
+            printTestResult(testNum, description, false, expected, actual);
             failed++;
         }
 
@@ -1888,41 +3211,173 @@ void test_capturePieces()
 
 
 /**
- * @brief Test function for switchCurrentPlayer.
+ * @brief Test function for the generateMoves function.
  *
- * This function tests the switchCurrentPlayer function by toggling between players
- * and verifying the current player state.
+ * This function tests the generateMoves function by counting the legal moves of the starting
+ * positions for both roles and sizes, and by checking the special cell rules (KING only on
+ * FORTRESS/CASTLE, no crossing) on hand-made boards, with and without bitboards.
  */
-void test_switchCurrentPlayer() {
-    printTestHeader("switchCurrentPlayer");
+void test_generateMoves()
+{
+    printTestHeader("generateMoves");
     int pass = 0;
     int failed = 0;
     int testNum = 0;
 
-    // Test structure for switchCurrentPlayer
-    struct SwitchTestCase {
-        bool startWithNullptr;  // true if starting with nullptr
-        int switchCount;        // Number of switches to perform
-        bool expectPlayer1;     // true if expecting Player1, false if Player2
-        string description;
+    // Looks for a move in a list
+    auto contains = [](const MoveList& aList, Move aMove) {
+        for (int i = 0; i < aList.itsCount; ++i) {
+            const Move& m = aList.itsMoves[i];
+            if (m.itsStartPosition.itsRow == aMove.itsStartPosition.itsRow && m.itsStartPosition.itsCol == aMove.itsStartPosition.itsCol
+                && m.itsEndPosition.itsRow == aMove.itsEndPosition.itsRow && m.itsEndPosition.itsCol == aMove.itsEndPosition.itsCol) {
+                return true;
+            }
+        }
+        return false;
     };
 
-    // Parameterized tests
-    SwitchTestCase tests[] = {
-        // Basic tests
-        {false, 1, false, "Switch from Player1 to Player2"},                    // Test 1
-        {false, 2, true,  "Switch from Player2 back to Player1"},               // Test 2
-
-        // Edge case
-        {true,  1, true,  "Initial nullptr -> becomes Player1 after first switch"}, // Test 3
-
-        // Sequence tests
-        {false, 10, true,  "10 toggles from Player1 -> ends on Player1 (even)"},   // Test 4
-        {false, 5,  false, "5 toggles from Player1 -> ends on Player2 (odd)"},     // Test 5
+    // === Category 1: starting positions ===
+    struct CountTestCase {
+        BoardSize size;
+        PlayerRole role;
+        int expectedCount;
+        string description;
     };
-
-    for (const auto& test : tests) {
-        Game game;
+    CountTestCase counts[] = {
+        {LITTLE, ATTACK, 116, "LITTLE initial board - ATTACK has 116 moves"},
+        {LITTLE, DEFENSE, 60, "LITTLE initial board - DEFENSE has 60 moves"},
+        {BIG, ATTACK, 156, "BIG initial board - ATTACK has 156 moves"},
+        {BIG, DEFENSE, 132, "BIG initial board - DEFENSE has 132 moves"},
+    };
+    for (const CountTestCase& tc : counts) {
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(tc.size), tc.size};
+        initializeBoard(game.itsBoard);
+        game.itsCurrentPlayer = (tc.role == ATTACK) ? &game.itsPlayer1 : &game.itsPlayer2;
+        MoveList list;
+        int fastCount = generateMoves(game, list);
+        // Same position without bitboards (cell scan)
+        game.itsBoard.itsHasBitboards = false;
+        int scanCount = generateMoves(game, list);
+        if (fastCount == tc.expectedCount && scanCount == tc.expectedCount) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, to_string(tc.expectedCount),
+                            to_string(fastCount) + " (masks) / " + to_string(scanCount) + " (scan)");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, tc.size);
+    }
+
+    // === Category 2: special cells ===
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    game.itsCurrentPlayer = &game.itsPlayer2;
+
+    // Test: KING can finish on a FORTRESS but no further
+    testNum++;
+    resetBoard(game.itsBoard.itsCells, LITTLE);
+    game.itsBoard.itsCells[0][0].itsCellType = FORTRESS;
+    game.itsBoard.itsCells[0][3].itsPieceType = KING;
+    game.itsBoard.itsCells[1][3].itsPieceType = SWORD;
+    MoveList list;
+    generateMoves(game, list);
+    // West: B1..A1(fortress) = 3, East: 7, South: blocked = 0, North: border = 0
+    if (list.itsCount == 10 && contains(list, {{0, 3}, {0, 0}})) {
+        printTestResult(testNum, "KING A4 → 10 moves including FORTRESS A1", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "KING A4 → 10 moves including FORTRESS A1", false, "10 with A1", to_string(list.itsCount));
+        failed++;
+    }
+
+    // Test: SHIELD can neither finish on nor cross the CASTLE
+    testNum++;
+    resetBoard(game.itsBoard.itsCells, LITTLE);
+    game.itsBoard.itsCells[5][5].itsCellType = CASTLE;
+    game.itsBoard.itsCells[5][3].itsPieceType = SHIELD;
+    game.itsBoard.itsCells[4][3].itsPieceType = SWORD;
+    game.itsBoard.itsCells[6][3].itsPieceType = SWORD;
+    generateMoves(game, list);
+    // West: 3 cells, East: only F5 before the castle
+    if (list.itsCount == 4 && !contains(list, {{5, 3}, {5, 5}}) && !contains(list, {{5, 3}, {5, 6}})) {
+        printTestResult(testNum, "SHIELD F4 → 4 moves, CASTLE F6 neither reached nor crossed", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "SHIELD F4 → 4 moves, CASTLE F6 neither reached nor crossed", false, "4", to_string(list.itsCount));
+        failed++;
+    }
+
+    // Test: ATTACK only moves SWORDs
+    testNum++;
+    game.itsCurrentPlayer = &game.itsPlayer1;
+    generateMoves(game, list);
+    bool onlySwords = list.itsCount > 0;
+    for (int i = 0; i < list.itsCount; ++i) {
+        const Position& start = list.itsMoves[i].itsStartPosition;
+        if (game.itsBoard.itsCells[start.itsRow][start.itsCol].itsPieceType != SWORD) onlySwords = false;
+    }
+    if (onlySwords) {
+        printTestResult(testNum, "ATTACK → only SWORD moves generated", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "ATTACK → only SWORD moves generated", false, "only SWORD", "other pieces moved");
+        failed++;
+    }
+
+    // Test: unsupported board size
+    testNum++;
+    game.itsBoard.itsSize = static_cast<BoardSize>(9);
+    if (generateMoves(game, list) == 0 && list.itsCount == 0) {
+        printTestResult(testNum, "Board of size 9 → no moves", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Board of size 9 → no moves", false, "0", to_string(list.itsCount));
+        failed++;
+    }
+
+    db(game.itsBoard.itsCells, LITTLE);
+    printTestSummary("generateMoves", pass, failed);
+}
+
+/**
+ * @brief Test function for switchCurrentPlayer.
+ *
+ * This function tests the switchCurrentPlayer function by toggling between players
+ * and verifying the current player state.
+ */
+void test_switchCurrentPlayer() {
+    printTestHeader("switchCurrentPlayer");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test structure for switchCurrentPlayer
+    struct SwitchTestCase {
+        bool startWithNullptr;  // true if starting with nullptr
+        int switchCount;        // Number of switches to perform
+        bool expectPlayer1;     // true if expecting Player1, false if Player2
+        string description;
+    };
+
+    // Parameterized tests
+    SwitchTestCase tests[] = {
+        // Basic tests
+        {false, 1, false, "Switch from Player1 to Player2"},                    // Test 1
+        {false, 2, true,  "Switch from Player2 back to Player1"},               // Test 2
+
+        // Edge case
+        {true,  1, true,  "Initial nullptr -> becomes Player1 after first switch"}, // Test 3
+
+        // Sequence tests
+        {false, 10, true,  "10 toggles from Player1 -> ends on Player1 (even)"},   // Test 4
+        {false, 5,  false, "5 toggles from Player1 -> ends on Player2 (odd)"},     // Test 5
+    };
+
+    for (const auto& test : tests) {
+        Game game;
 
         // Initial setup
         game.itsCurrentPlayer = test.startWithNullptr ? nullptr : &game.itsPlayer1;
@@ -2030,7 +3485,7 @@ void test_isSwordLeft()
 
     for (const auto& test : tests) {
         BoardSize size = test.boardSize;
-        Cell** b = cb(size);
+        CellRow* b = cb(size);
         resetBoard(b, size);
 
         // Setup du plateau selon le test
@@ -2104,6 +3559,405 @@ void test_isSwordLeft()
     printTestSummary("isSwordLeft", pass, failed);
 }
 
+/**
+ * @brief Test function for countPieces.
+ *
+ * This function tests the countPieces function on the starting boards (mask path)
+ * and on hand-made boards (scan path) for every piece type.
+ */
+void test_countPieces()
+{
+    printTestHeader("countPieces");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Board board = {cb(size), size};
+
+        // Test: starting position counts
+        testNum++;
+        initializeBoard(board);
+        int kings = countPieces(board, KING), shields = countPieces(board, SHIELD), swords = countPieces(board, SWORD);
+        if (kings == 1 && shields == 12 && swords == 24 && countPieces(board, NONE) == 0) {
+            printTestResult(testNum, sizeName + " - initial board → 1/12/24", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - initial board → 1/12/24", false, "1/12/24",
+                            to_string(kings) + "/" + to_string(shields) + "/" + to_string(swords));
+            failed++;
+        }
+
+        // Test: hand-made board without masks
+        testNum++;
+        Board scanBoard = {board.itsCells, size};
+        resetBoard(scanBoard.itsCells, size);
+        scanBoard.itsCells[0][1].itsPieceType = SWORD;
+        scanBoard.itsCells[size-1][size-2].itsPieceType = SWORD;
+        scanBoard.itsCells[4][4].itsPieceType = SHIELD;
+        swords = countPieces(scanBoard, SWORD);
+        shields = countPieces(scanBoard, SHIELD);
+        kings = countPieces(scanBoard, KING);
+        if (swords == 2 && shields == 1 && kings == 0) {
+            printTestResult(testNum, sizeName + " - hand-made board (scan) → 0/1/2", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - hand-made board (scan) → 0/1/2", false, "0/1/2",
+                            to_string(kings) + "/" + to_string(shields) + "/" + to_string(swords));
+            failed++;
+        }
+
+        db(board.itsCells, size);
+    }
+
+    printTestSummary("countPieces", pass, failed);
+}
+
+/**
+ * @brief Test function for perft.
+ *
+ * This function tests the perft function by comparing the counts of both starting positions
+ * with the reference values up to depth 3, and by checking that the game is restored.
+ */
+void test_perft()
+{
+    printTestHeader("perft");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        const uint64_t KEY = game.itsBoard.itsHash;
+        for (int depth = 0; depth <= 3; ++depth) {
+            testNum++;
+            const long long NODES = perft(game, depth);
+            const long long REFERENCE = perftReference(size, depth);
+            const string description = sizeName + " - perft(" + to_string(depth) + ") → " + to_string(REFERENCE);
+            if (NODES == REFERENCE && game.itsBoard.itsHash == KEY) {
+                printTestResult(testNum, description, true);
+                pass++;
+            } else {
+                printTestResult(testNum, description, false, to_string(REFERENCE), to_string(NODES));
+                failed++;
+            }
+        }
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: a finished game has no moves
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[5][5].itsPieceType = KING;
+        updateBitboards(game.itsBoard);
+        // no SWORD left: DEFENSE has won
+        if (perft(game, 1) == 0 && perft(game, 0) == 1) {
+            printTestResult(testNum, "Finished game → perft(1) = 0", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "Finished game → perft(1) = 0", false, "0", to_string(perft(game, 1)));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    printTestSummary("perft", pass, failed);
+}
+
+/**
+ * @brief Test function for Engine.
+ *
+ * This function tests the engines of both board sizes by comparing their compile-time masks
+ * with the masks built from the cells, their starting layout with the piece counts,
+ * and their move generation with the public functions; unsupported sizes are rejected.
+ */
+void test_engine()
+{
+    printTestHeader("Engine");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsPlayer1.itsRole = ATTACK;
+        game.itsPlayer2.itsRole = DEFENSE;
+        game.itsCurrentPlayer = &game.itsPlayer1;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        const BitBoard FORTRESSES = (size == LITTLE) ? Engine<LITTLE>::FORTRESS_MASK : Engine<BIG>::FORTRESS_MASK;
+        const BitBoard CASTLES = (size == LITTLE) ? Engine<LITTLE>::CASTLE_MASK : Engine<BIG>::CASTLE_MASK;
+
+        // Test: compile-time masks match the cells
+        testNum++;
+        bool sameMasks = true;
+        for (int word = 0; word < 3; ++word) {
+            sameMasks = sameMasks && FORTRESSES.itsWords[word] == game.itsBoard.itsCellMasks[FORTRESS].itsWords[word]
+                        && CASTLES.itsWords[word] == game.itsBoard.itsCellMasks[CASTLE].itsWords[word];
+        }
+        if (sameMasks && countBits(FORTRESSES) == 4 && countBits(CASTLES) == 1) {
+            printTestResult(testNum, sizeName + " - FORTRESS_MASK / CASTLE_MASK → match the cells", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - FORTRESS_MASK / CASTLE_MASK → match the cells", false, "4 / 1", to_string(countBits(FORTRESSES)) + " / " + to_string(countBits(CASTLES)));
+            failed++;
+        }
+
+        // Test: starting layout has 24 swords, 12 shields and the king on the castle
+        testNum++;
+        const int CENTER = size / 2;
+        if (game.itsBoard.itsPieceCounts[SWORD] == 24 && game.itsBoard.itsPieceCounts[SHIELD] == 12
+            && game.itsBoard.itsKingIndex == cellIndex(CENTER, CENTER, size)) {
+            printTestResult(testNum, sizeName + " - starting layout → 24 SWORD, 12 SHIELD, KING on castle", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - starting layout → 24 SWORD, 12 SHIELD, KING on castle", false, "24 / 12",
+                            to_string(game.itsBoard.itsPieceCounts[SWORD]) + " / " + to_string(game.itsBoard.itsPieceCounts[SHIELD]));
+            failed++;
+        }
+
+        // Test: the engine generates the same moves as the public function
+        testNum++;
+        MoveList engineList;
+        MoveList publicList;
+        const int ENGINE_COUNT = (size == LITTLE) ? Engine<LITTLE>::generateMoves(game, engineList) : Engine<BIG>::generateMoves(game, engineList);
+        const int PUBLIC_COUNT = generateMoves(game, publicList);
+        bool sameMoves = ENGINE_COUNT == PUBLIC_COUNT && ENGINE_COUNT > 0;
+        for (int i = 0; sameMoves && i < ENGINE_COUNT; ++i) {
+            sameMoves = checkMovement(game, engineList.itsMoves[i]) == VALID_MOVE;
+        }
+        if (sameMoves) {
+            printTestResult(testNum, sizeName + " - Engine::generateMoves → same valid moves", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - Engine::generateMoves → same valid moves", false, to_string(PUBLIC_COUNT), to_string(ENGINE_COUNT));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: unsupported board size is rejected by the rules
+    testNum++;
+    {
+        Game game;
+        game.itsPlayer1.itsRole = ATTACK;
+        game.itsPlayer2.itsRole = DEFENSE;
+        game.itsCurrentPlayer = &game.itsPlayer1;
+        game.itsBoard = {cb(LITTLE), static_cast<BoardSize>(9)};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[0][4].itsPieceType = SWORD;
+        game.itsBoard.itsCells[4][4].itsPieceType = KING;
+        for (const Position& pos : {Position{3, 4}, Position{5, 4}, Position{4, 3}, Position{4, 5}}) {
+            game.itsBoard.itsCells[pos.itsRow][pos.itsCol].itsPieceType = SWORD;
+        }
+        const Move MOVE = {{0, 4}, {0, 2}};
+        if (checkMovement(game, MOVE) == OUT_OF_BOUNDS && capturePieces(game, MOVE) == 0 && !isKingCapturedRecursive(game.itsBoard, {4, 4})) {
+            printTestResult(testNum, "Board of size 9 → OUT_OF_BOUNDS, no capture, no encirclement", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "Board of size 9 → OUT_OF_BOUNDS, no capture, no encirclement", false, "rejected", "accepted");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    printTestSummary("Engine", pass, failed);
+}
+
+/**
+ * @brief Test function for makeMove.
+ *
+ * This function tests the makeMove function by checking the undo record (moved piece,
+ * captured mask, previous player) on hand-made capture positions for both roles.
+ */
+void test_makeMove()
+{
+    printTestHeader("makeMove");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    struct TestCase {
+        PlayerRole role;
+        Move move;
+        PieceType movedPiece;
+        unsigned char expectedMask;
+        string description;
+    };
+    // Board: SHIELD on (5,3) and (5,7), SWORDs on (5,2), (5,8); SWORD on (3,5), SHIELD on (2,5)
+    TestCase cases[] = {
+        {ATTACK, {{7,4},{5,4}}, SWORD, 0x1, "ATTACK captures the west SHIELD → mask 0x1"},
+        {ATTACK, {{7,6},{5,6}}, SWORD, 0x2, "ATTACK captures the east SHIELD → mask 0x2"},
+        {DEFENSE, {{4,7},{4,5}}, SHIELD, 0x4, "DEFENSE captures the north SWORD → mask 0x4"},
+        {ATTACK, {{7,4},{6,4}}, SWORD, 0x0, "ATTACK without capture → mask 0x0"},
+    };
+    for (const TestCase& tc : cases) {
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[5][3].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[5][7].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[5][2].itsPieceType = SWORD;
+        game.itsBoard.itsCells[5][8].itsPieceType = SWORD;
+        game.itsBoard.itsCells[3][5].itsPieceType = SWORD;
+        game.itsBoard.itsCells[2][5].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[7][4].itsPieceType = SWORD;
+        game.itsBoard.itsCells[7][6].itsPieceType = SWORD;
+        game.itsBoard.itsCells[4][7].itsPieceType = SHIELD;
+        updateBitboards(game.itsBoard);
+        Player* previous = (tc.role == ATTACK) ? &game.itsPlayer1 : &game.itsPlayer2;
+        game.itsCurrentPlayer = previous;
+
+        MoveUndo undo = makeMove(game, tc.move);
+        const Position& end = tc.move.itsEndPosition;
+        bool ok = undo.itsMovedPiece == tc.movedPiece && undo.itsCapturedMask == tc.expectedMask
+                  && undo.itsPreviousPlayer == previous && game.itsCurrentPlayer != previous
+                  && game.itsBoard.itsCells[end.itsRow][end.itsCol].itsPieceType == tc.movedPiece;
+        if (ok) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, "mask " + to_string(tc.expectedMask),
+                            "mask " + to_string(undo.itsCapturedMask));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    printTestSummary("makeMove", pass, failed);
+}
+
+/**
+ * @brief Test function for unmakeMove.
+ *
+ * This function tests the unmakeMove function by undoing a capture and sequences of generated
+ * moves, and by comparing the cells, the masks and the current player with the original state.
+ */
+void test_unmakeMove()
+{
+    printTestHeader("unmakeMove");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Compares two boards cell by cell and mask by mask
+    auto sameBoard = [](const Board& aFirst, const Board& aSecond) {
+        for (int row = 0; row < aFirst.itsSize; ++row) {
+            for (int col = 0; col < aFirst.itsSize; ++col) {
+                if (aFirst.itsCells[row][col].itsCellType != aSecond.itsCells[row][col].itsCellType
+                    || aFirst.itsCells[row][col].itsPieceType != aSecond.itsCells[row][col].itsPieceType) {
+                    return false;
+                }
+            }
+        }
+        for (int piece = 0; piece < 4; ++piece) {
+            for (int word = 0; word < 3; ++word) {
+                if (aFirst.itsPieceMasks[piece].itsWords[word] != aSecond.itsPieceMasks[piece].itsWords[word]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    // Test: undo a double capture
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[3][3].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[3][5].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[3][2].itsPieceType = SWORD;
+        game.itsBoard.itsCells[3][6].itsPieceType = SWORD;
+        game.itsBoard.itsCells[7][4].itsPieceType = SWORD;
+        updateBitboards(game.itsBoard);
+        Board before = {nullptr, LITTLE};
+        copyBoard(game.itsBoard, before);
+
+        MoveUndo undo = makeMove(game, {{7,4},{3,4}});
+        bool captured = undo.itsCapturedMask == 0x3 && countPieces(game.itsBoard, SHIELD) == 0;
+        unmakeMove(game, undo);
+        if (captured && sameBoard(game.itsBoard, before) && game.itsCurrentPlayer == &game.itsPlayer1) {
+            printTestResult(testNum, "Double capture undone → board restored", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "Double capture undone → board restored", false, "restored", "different");
+            failed++;
+        }
+        deleteBoard(before);
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    // Tests: sequences of generated moves, undone in reverse order
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        Board before = {nullptr, size};
+        copyBoard(game.itsBoard, before);
+
+        const int DEPTH = 40;
+        MoveUndo undos[DEPTH];
+        int played = 0;
+        unsigned int seed = 12345u + size;
+        bool stepsOk = true;
+        for (int ply = 0; ply < DEPTH; ++ply) {
+            MoveList list;
+            generateMoves(game, list);
+            // keep the moves ending 2 cells away from the edges (edge captures are covered by capturePieces)
+            int candidates[MAX_MOVES];
+            int count = 0;
+            for (int i = 0; i < list.itsCount; ++i) {
+                const Position& end = list.itsMoves[i].itsEndPosition;
+                if (end.itsRow >= 2 && end.itsRow < size - 2 && end.itsCol >= 2 && end.itsCol < size - 2) {
+                    candidates[count++] = i;
+                }
+            }
+            if (count == 0) {
+                break;
+            }
+            seed = seed * 1103515245u + 12345u;
+            const Move& move = list.itsMoves[candidates[(seed >> 16) % count]];
+            Board step = {nullptr, size};
+            copyBoard(game.itsBoard, step);
+            Player* player = game.itsCurrentPlayer;
+            MoveUndo undo = makeMove(game, move);
+            // undo and redo immediately: every single step must be exact
+            unmakeMove(game, undo);
+            stepsOk = stepsOk && sameBoard(game.itsBoard, step) && game.itsCurrentPlayer == player;
+            undos[played++] = makeMove(game, move);
+            deleteBoard(step);
+        }
+        for (int ply = played - 1; ply >= 0; --ply) {
+            unmakeMove(game, undos[ply]);
+        }
+        const string description = sizeName + " - " + to_string(played) + " generated moves undone → initial board";
+        if (stepsOk && played > 0 && sameBoard(game.itsBoard, before) && game.itsCurrentPlayer == &game.itsPlayer1) {
+            printTestResult(testNum, description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, description, false, "restored", "different");
+            failed++;
+        }
+        deleteBoard(before);
+        db(game.itsBoard.itsCells, size);
+    }
+
+    printTestSummary("unmakeMove", pass, failed);
+}
+
 /**
  * @brief Test function for getKingPosition.
  *
@@ -2363,13 +4217,13 @@ void test_isKingCapturedSimple()
         bool expectCaptured;
         string description;
         // Board configuration (lambda function for setup)
-        function<void(Cell**, int)> setupBoard;
+        function<void(CellRow*, int)> setupBoard;
     };
 
     CaptureTestCase tests[] = {
         // === LEVEL 1: Simple captures with 4 identical hostile elements ===
         {2, 2, true, "4 SWORD around king (center)",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[2][2].itsPieceType = KING;
                 cells[1][2].itsPieceType = SWORD;  // up
@@ -2380,7 +4234,7 @@ void test_isKingCapturedSimple()
 
         // === LEVEL 2: Captures with 3 SWORD + 1 hostile element (border/castle/fortress) ===
         {0, 2, true, "3 SWORD + border (top edge)",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[0][2].itsPieceType = KING;
                 cells[1][2].itsPieceType = SWORD;  // down
@@ -2390,7 +4244,7 @@ void test_isKingCapturedSimple()
             }},
 
         {2, 2, true, "3 SWORD + CASTLE",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[2][2].itsPieceType = KING;
                 cells[1][2].itsPieceType = SWORD;  // up
@@ -2400,7 +4254,7 @@ void test_isKingCapturedSimple()
             }},
 
         {4, 4, true, "3 SWORD + FORTRESS",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[4][4].itsPieceType = KING;
                 cells[3][4].itsPieceType = SWORD;  // up
@@ -2411,7 +4265,7 @@ void test_isKingCapturedSimple()
 
         // === LEVEL 3: Captures with 2 SWORD + 2 hostile elements (border/fortress/castle) ===
         {10, 2, true, "2 SWORD + border + FORTRESS (bottom edge)",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[size-1][2].itsPieceType = KING;
                 cells[size-2][2].itsPieceType = SWORD;  // up
@@ -2421,7 +4275,7 @@ void test_isKingCapturedSimple()
             }},
 
         {0, 5, true, "2 SWORD + border + CASTLE (top edge)",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[0][5].itsPieceType = KING;
                 cells[1][5].itsPieceType = SWORD;  // down
@@ -2431,7 +4285,7 @@ void test_isKingCapturedSimple()
             }},
 
         {5, 5, true, "2 SWORD + FORTRESS + CASTLE (no borders)",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[5][5].itsPieceType = KING;
                 cells[4][5].itsPieceType = SWORD;  // up
@@ -2442,7 +4296,7 @@ void test_isKingCapturedSimple()
 
         // === NIVEAU 4: Non-captures - cellule vide (seulement 3 hostiles) ===
         {2, 2, false, "3 SWORD + 1 empty cell → not captured",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[2][2].itsPieceType = KING;
                 cells[3][2].itsPieceType = SWORD;  // down
@@ -2453,7 +4307,7 @@ void test_isKingCapturedSimple()
 
         // === LEVEL 5: Non-captures - SHIELD neutralizes one side ===
         {2, 2, false, "3 SWORD + 1 SHIELD → not captured",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[2][2].itsPieceType = KING;
                 cells[1][2].itsPieceType = SWORD;  // up
@@ -2463,7 +4317,7 @@ void test_isKingCapturedSimple()
             }},
 
         {0, 2, false, "2 SWORD + border + SHIELD → not captured",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[0][2].itsPieceType = KING;
                 cells[1][2].itsPieceType = SWORD;  // down
@@ -2473,7 +4327,7 @@ void test_isKingCapturedSimple()
             }},
 
         {5, 5, false, "2 SWORD + FORTRESS + SHIELD → not captured",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 cells[5][5].itsPieceType = KING;
                 cells[4][5].itsPieceType = SWORD;  // up
@@ -2484,7 +4338,7 @@ void test_isKingCapturedSimple()
 
         // === NIVEAU 6: Edge case - Pas de roi ===
         {-1, -1, false, "No king on board → not captured",
-            [](Cell** cells, int size) {
+            [](CellRow* cells, int size) {
                 (void)size;
                 (void)cells;
                 // Plateau vide, pas de roi
@@ -2883,11 +4737,209 @@ void test_isKingCapturedRecursive()
     if(isKingCapturedRecursive(b)) { printTestResult(testNum,"Gap replaced by castle → captured", true); pass++; }
     else { printTestResult(testNum,"Gap replaced by castle → captured", false, "captured","not captured"); failed++; }
 
+    // Test 17: Whole BIG board filled with the group, a single free cell at the far corner
+    // The group covers every cell, so the search must go through all of them without recursion
+    testNum++;
+    {
+        Board big = {cb(BIG), BIG};
+        resetBoard(big.itsCells, BIG);
+        for (int r = 0; r < BIG; ++r) {
+            for (int c = 0; c < BIG; ++c) {
+                big.itsCells[r][c].itsPieceType = SHIELD;
+            }
+        }
+        big.itsCells[0][0].itsPieceType = KING;
+        big.itsCells[BIG-1][BIG-1].itsPieceType = NONE;
+        const bool OPEN = !isKingCapturedRecursive(big);
+        big.itsCells[BIG-1][BIG-1].itsPieceType = SWORD;
+        const bool SEALED = isKingCapturedRecursive(big);
+        if (OPEN && SEALED) {
+            printTestResult(testNum, "BIG board full of shields: far free cell → NOT captured, sealed → captured", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "BIG board full of shields: far free cell → NOT captured, sealed → captured", false,
+                            "not captured / captured", string(OPEN ? "not captured" : "captured") + " / " + (SEALED ? "captured" : "not captured"));
+            failed++;
+        }
+        db(big.itsCells, BIG);
+    }
+
     db(b.itsCells,size);
 
     printTestSummary("isKingCapturedRecursive", pass, failed);
 }
 
+/**
+ * @brief Test function for getGameStatus.
+ *
+ * This function tests the getGameStatus function by checking the status cached by makeMove and
+ * unmakeMove in endgame scenarios, and by comparing it with a full scan of the board
+ * along random games on both board sizes.
+ */
+void test_getGameStatus()
+{
+    printTestHeader("getGameStatus");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string STATUS_NAMES[4] = {"IN_PROGRESS", "KING_CAPTURED", "NO_SWORD_LEFT", "KING_ESCAPED"};
+
+    // Compares the cached status, counts and king with a scan of a copy without the cache
+    auto matchesScan = [](const Board& aBoard) {
+        Board scan = {nullptr, aBoard.itsSize};
+        copyBoard(aBoard, scan);
+        scan.itsHasBitboards = false;
+        const Position KING = getKingPosition(aBoard);
+        const Position SCAN_KING = getKingPosition(scan);
+        const bool SAME = getGameStatus(aBoard) == getGameStatus(scan)
+                          && countPieces(aBoard, SWORD) == countPieces(scan, SWORD)
+                          && countPieces(aBoard, SHIELD) == countPieces(scan, SHIELD)
+                          && KING.itsRow == SCAN_KING.itsRow && KING.itsCol == SCAN_KING.itsCol;
+        deleteBoard(scan);
+        return SAME;
+    };
+
+    struct TestCase {
+        PlayerRole role;
+        Move move;
+        GameStatus expected;
+        string description;
+    };
+    // Board: KING on (5,5) with SWORDs on 3 sides, a SHIELD on (1,4) next to the only other SWORD on (1,3)
+    TestCase cases[] = {
+        {ATTACK, {{8,4},{5,4}}, KING_CAPTURED, "SWORD closes the 4th side → KING_CAPTURED"},
+        {ATTACK, {{8,4},{8,6}}, IN_PROGRESS, "quiet SWORD move → IN_PROGRESS"},
+        {DEFENSE, {{5,5},{5,3}}, IN_PROGRESS, "KING leaves the trap → IN_PROGRESS"},
+    };
+    for (const TestCase& tc : cases) {
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[5][5].itsPieceType = KING;
+        game.itsBoard.itsCells[4][5].itsPieceType = SWORD;
+        game.itsBoard.itsCells[6][5].itsPieceType = SWORD;
+        game.itsBoard.itsCells[5][6].itsPieceType = SWORD;
+        game.itsBoard.itsCells[8][4].itsPieceType = SWORD;
+        updateBitboards(game.itsBoard);
+        game.itsCurrentPlayer = (tc.role == ATTACK) ? &game.itsPlayer1 : &game.itsPlayer2;
+
+        MoveUndo undo = makeMove(game, tc.move);
+        const GameStatus AFTER = getGameStatus(game.itsBoard);
+        unmakeMove(game, undo);
+        const GameStatus RESTORED = getGameStatus(game.itsBoard);
+        if (AFTER == tc.expected && RESTORED == IN_PROGRESS) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, STATUS_NAMES[tc.expected], STATUS_NAMES[AFTER]);
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    // Test: a SWORD closes the encirclement of the KING and its SHIELD
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[5][5].itsPieceType = KING;
+        game.itsBoard.itsCells[5][6].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[4][5].itsPieceType = SWORD;
+        game.itsBoard.itsCells[4][6].itsPieceType = SWORD;
+        game.itsBoard.itsCells[6][5].itsPieceType = SWORD;
+        game.itsBoard.itsCells[6][6].itsPieceType = SWORD;
+        game.itsBoard.itsCells[5][7].itsPieceType = SWORD;
+        game.itsBoard.itsCells[8][4].itsPieceType = SWORD;
+        updateBitboards(game.itsBoard);
+        const GameStatus BEFORE = getGameStatus(game.itsBoard);
+        makeMove(game, {{8,4},{5,4}});
+        const GameStatus AFTER = getGameStatus(game.itsBoard);
+        if (BEFORE == IN_PROGRESS && AFTER == KING_CAPTURED && whoWon(game) == &game.itsPlayer1) {
+            printTestResult(testNum, "encirclement of KING + SHIELD closed → KING_CAPTURED, ATTACK wins", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "encirclement of KING + SHIELD closed → KING_CAPTURED, ATTACK wins", false,
+                            "IN_PROGRESS / KING_CAPTURED", STATUS_NAMES[BEFORE] + " / " + STATUS_NAMES[AFTER]);
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    // Test: the last SWORD is captured, then the KING escapes
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[0][10].itsCellType = FORTRESS;
+        game.itsBoard.itsCells[2][5].itsPieceType = SWORD;
+        game.itsBoard.itsCells[2][4].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[5][6].itsPieceType = SHIELD;
+        game.itsBoard.itsCells[0][7].itsPieceType = KING;
+        updateBitboards(game.itsBoard);
+        game.itsCurrentPlayer = &game.itsPlayer2;
+
+        MoveUndo capture = makeMove(game, {{5,6},{2,6}});
+        const GameStatus NO_SWORD = getGameStatus(game.itsBoard);
+        unmakeMove(game, capture);
+        MoveUndo escape = makeMove(game, {{0,7},{0,10}});
+        const GameStatus ESCAPED = getGameStatus(game.itsBoard);
+        unmakeMove(game, escape);
+        const string description = "last SWORD captured → NO_SWORD_LEFT, KING on FORTRESS → KING_ESCAPED";
+        if (NO_SWORD == NO_SWORD_LEFT && ESCAPED == KING_ESCAPED && getGameStatus(game.itsBoard) == IN_PROGRESS
+            && countPieces(game.itsBoard, SWORD) == 1) {
+            printTestResult(testNum, description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, description, false, "NO_SWORD_LEFT / KING_ESCAPED",
+                            STATUS_NAMES[NO_SWORD] + " / " + STATUS_NAMES[ESCAPED]);
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    // Tests: random games, the cache must match a full scan after every move and every undo
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        bool ok = getGameStatus(game.itsBoard) == IN_PROGRESS;
+        int finished = 0;
+        unsigned int seed = 777u + size;
+        for (int round = 0; round < 20 && ok; ++round) {
+            const int DEPTH = 1000;
+            MoveUndo undos[DEPTH];
+            int played = 0;
+            MoveList list;
+            while (played < DEPTH && !isGameFinished(game) && generateMoves(game, list) > 0) {
+                seed = seed * 1103515245u + 12345u;
+                undos[played++] = makeMove(game, list.itsMoves[(seed >> 16) % list.itsCount]);
+                ok = ok && matchesScan(game.itsBoard);
+            }
+            finished += isGameFinished(game);
+            for (int ply = played - 1; ply >= 0; --ply) {
+                unmakeMove(game, undos[ply]);
+                ok = ok && matchesScan(game.itsBoard);
+            }
+        }
+        const string description = sizeName + " - cache matches a full scan in 20 random games (" + to_string(finished) + " finished)";
+        if (ok && finished > 0) {
+            printTestResult(testNum, description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, description, false, "same status", "different");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+    }
+
+    printTestSummary("getGameStatus", pass, failed);
+}
+
 /**
  * @brief Test function for isGameFinished.
  *
@@ -2995,6 +5047,8 @@ void test_isGameFinished()
     for (const auto& test : tests) {
         testNum++;
         test.setup(game, size);
+        // Cells are edited directly: resynchronize the masks left by initializeBoard
+        updateBitboards(game.itsBoard);
         if (DISPLAY_BOARDS) displayBoard(game.itsBoard);
         bool result = isGameFinished(game);
         if (result == test.expectFinished) {
@@ -3111,6 +5165,8 @@ void test_whoWon()
         testNum++;
         const auto& test = tests[i];
         test.setup(game, size);
+        // Cells are edited directly: resynchronize the masks left by initializeBoard
+        updateBitboards(game.itsBoard);
         const Player* w = whoWon(game);
         const Player* expected = nullptr;
         if (test.expectedType == WhoWonTestCase::ATTACKER) expected = &game.itsPlayer1;
@@ -3130,57 +5186,3483 @@ void test_whoWon()
     printTestSummary("whoWon", pass, failed);
 }
 
+/**
+ * @brief Test function for scanBoardMasks.
+ *
+ * This function tests the scanBoardMasks function with every kernel supported by the CPU
+ * on random cells of several board sizes, against masks built cell by cell.
+ */
+void test_scanBoardMasks()
+{
+    printTestHeader("scanBoardMasks");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const FeatureKernel DEFAULT_KERNEL = getFeatureKernel();
 
-// ========================================================================================
-// ============================= HELPER FUNCTIONS =========================================
-// ========================================================================================
-// This section contains all utility/helper functions used by the test suite.
-// These functions provide:
-//   - Board memory management (cb, db, resetBoard)
-//   - Test output formatting (printTestHeader, printTestResult, printTestSummary, etc.)
-//   - Test configuration (configureTestDisplay)
-// ========================================================================================
+    // Test: the scalar kernel always exists, an unknown kernel is refused
+    testNum++;
+    if (isFeatureKernelSupported(KERNEL_SCALAR) && !selectFeatureKernel(KERNEL_COUNT) && getFeatureKernel() == DEFAULT_KERNEL) {
+        printTestResult(testNum, "Scalar supported, unknown kernel refused (default " + string(getFeatureKernelName(DEFAULT_KERNEL)) + ")", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "Scalar supported, unknown kernel refused", false, "refused", "accepted");
+        failed++;
+    }
+
+    for (int kernel = 0; kernel < KERNEL_COUNT; ++kernel) {
+        if (!selectFeatureKernel(static_cast<FeatureKernel>(kernel))) {
+            continue;
+        }
+        const string kernelName = getFeatureKernelName(static_cast<FeatureKernel>(kernel));
+        for (int size : {2, 5, 9, 11, 12, 13}) {
+            // Test: random cells → same masks as a cell by cell scan
+            testNum++;
+            Board board = {cb(static_cast<BoardSize>(size)), static_cast<BoardSize>(size)};
+            unsigned int seed = 17u * size + kernel;
+            bool same = true;
+            for (int round = 0; round < 20 && same; ++round) {
+                BitBoard expectedPieces[4];
+                BitBoard expectedCells[3];
+                for (int row = 0; row < size; ++row) {
+                    for (int col = 0; col < size; ++col) {
+                        seed = seed * 1103515245u + 12345u;
+                        board.itsCells[row][col].itsPieceType = static_cast<PieceType>((seed >> 16) % 4);
+                        board.itsCells[row][col].itsCellType = static_cast<CellType>((seed >> 20) % 3);
+                        if (board.itsCells[row][col].itsPieceType != NONE) {
+                            setBit(expectedPieces[board.itsCells[row][col].itsPieceType], row * size + col);
+                        }
+                        if (board.itsCells[row][col].itsCellType != NORMAL) {
+                            setBit(expectedCells[board.itsCells[row][col].itsCellType], row * size + col);
+                        }
+                    }
+                }
+                BitBoard pieces[4];
+                BitBoard cells[3];
+                same = scanBoardMasks(board, pieces, cells);
+                for (int word = 0; word < 3 && same; ++word) {
+                    for (int piece = 0; piece < 4; ++piece) {
+                        same = same && pieces[piece].itsWords[word] == expectedPieces[piece].itsWords[word];
+                    }
+                    for (int cell = 0; cell < 3; ++cell) {
+                        same = same && cells[cell].itsWords[word] == expectedCells[cell].itsWords[word];
+                    }
+                }
+            }
+            const string description = kernelName + " - size " + to_string(size) + " random cells → same masks";
+            if (same) {
+                printTestResult(testNum, description, true);
+                pass++;
+            } else {
+                printTestResult(testNum, description, false, "same masks", "different masks");
+                failed++;
+            }
+            db(board.itsCells, static_cast<BoardSize>(size));
+        }
+    }
+    selectFeatureKernel(DEFAULT_KERNEL);
+
+    // Test: a board without cells is not scanned
+    testNum++;
+    {
+        Board board = {nullptr, LITTLE};
+        BitBoard pieces[4];
+        BitBoard cells[3];
+        setBit(pieces[SWORD], 3);
+        if (!scanBoardMasks(board, pieces, cells) && testBit(pieces[SWORD], 3)) {
+            printTestResult(testNum, "No cells → false, masks unchanged", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "No cells → false, masks unchanged", false, "false", "true");
+            failed++;
+        }
+    }
+
+    printTestSummary("scanBoardMasks", pass, failed);
+}
 
 /**
- * @brief Resets all cells of a board to {NORMAL, NONE}.
- * @param aBoard The board to reset
- * @param aBoardSize The size of the board
+ * @brief Test function for computeEvalFeatures.
+ *
+ * This function tests the computeEvalFeatures function on the starting positions, on a hand-made
+ * position around the king, and compares the mobility with generateMoves on random games,
+ * with and without bitboards.
  */
-void resetBoard(Cell**& aBoard, const BoardSize& aBoardSize)
+void test_computeEvalFeatures()
 {
-    // Iterate over each row and column of the board
-    for (int i = 0; i < aBoardSize; ++i) {
-        for (int j = 0; j < aBoardSize; ++j) {
-            // Set the cell to a normal state with no piece
-            aBoard[i][j] = {NORMAL, NONE};
+    printTestHeader("computeEvalFeatures");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsPlayer1.itsRole = ATTACK;
+        game.itsPlayer2.itsRole = DEFENSE;
+        game.itsCurrentPlayer = &game.itsPlayer1;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+
+        // Test: starting position
+        testNum++;
+        EvalFeatures features;
+        MoveList moves;
+        const int ATTACK_MOVES = generateMoves(game, moves);
+        if (computeEvalFeatures(game.itsBoard, features) && features.itsSwordCount == 24 && features.itsShieldCount == 12
+            && features.itsHasKing && features.itsKingFortressDistance == 2 * (size / 2) && features.itsKingOpenLines == 0
+            && features.itsKingHostileSides == 0 && features.itsSwordsNearKing == 0 && features.itsAttackMobility == ATTACK_MOVES) {
+            printTestResult(testNum, sizeName + " - starting position → 24 / 12, distance " + to_string(2 * (size / 2)) + ", " + to_string(ATTACK_MOVES) + " moves", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - starting position", false, "24 / 12 / " + to_string(ATTACK_MOVES),
+                            to_string(features.itsSwordCount) + " / " + to_string(features.itsShieldCount) + " / " + to_string(features.itsAttackMobility));
+            failed++;
+        }
+
+        // Test: mobility matches generateMoves on random games (bitboards and cell scan)
+        testNum++;
+        unsigned int seed = 2025u + size;
+        bool same = true;
+        int positions = 0;
+        for (int ply = 0; ply < 300 && same && !isGameFinished(game); ++ply) {
+            const int COUNT = generateMoves(game, moves);
+            if (COUNT == 0) {
+                break;
+            }
+            switchCurrentPlayer(game);
+            const int OTHER_COUNT = generateMoves(game, moves);
+            switchCurrentPlayer(game);
+            const int ATTACK_COUNT = (game.itsCurrentPlayer->itsRole == ATTACK) ? COUNT : OTHER_COUNT;
+            const int DEFENSE_COUNT = (game.itsCurrentPlayer->itsRole == ATTACK) ? OTHER_COUNT : COUNT;
+            EvalFeatures withBitboards;
+            EvalFeatures withScan;
+            computeEvalFeatures(game.itsBoard, withBitboards);
+            game.itsBoard.itsHasBitboards = false;
+            computeEvalFeatures(game.itsBoard, withScan);
+            updateBitboards(game.itsBoard);
+            same = withBitboards.itsAttackMobility == ATTACK_COUNT && withBitboards.itsDefenseMobility == DEFENSE_COUNT
+                   && withScan.itsAttackMobility == ATTACK_COUNT && withScan.itsDefenseMobility == DEFENSE_COUNT
+                   && withScan.itsSwordsNearKing == withBitboards.itsSwordsNearKing
+                   && withScan.itsKingHostileSides == withBitboards.itsKingHostileSides;
+            positions++;
+            generateMoves(game, moves);
+            seed = seed * 1103515245u + 12345u;
+            makeMove(game, moves.itsMoves[(seed >> 16) % moves.itsCount]);
+        }
+        if (same && positions > 0) {
+            printTestResult(testNum, sizeName + " - mobility of " + to_string(positions) + " positions → same as generateMoves", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - mobility → same as generateMoves", false, "same", "different at position " + to_string(positions));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: king on the border, next to a sword, with one open corner
+    testNum++;
+    {
+        Board board = {cb(LITTLE), LITTLE};
+        resetBoard(board.itsCells, LITTLE);
+        board.itsCells[0][0].itsCellType = FORTRESS;
+        board.itsCells[0][10].itsCellType = FORTRESS;
+        board.itsCells[10][0].itsCellType = FORTRESS;
+        board.itsCells[10][10].itsCellType = FORTRESS;
+        board.itsCells[5][5].itsCellType = CASTLE;
+        board.itsCells[0][3].itsPieceType = KING;
+        board.itsCells[0][4].itsPieceType = SWORD;
+        board.itsCells[2][5].itsPieceType = SWORD;
+        board.itsCells[3][3].itsPieceType = SWORD;
+        board.itsCells[6][6].itsPieceType = SWORD;
+        updateBitboards(board);
+        EvalFeatures features;
+        computeEvalFeatures(board, features, false);
+        // open to (0,0) only, hostile: border + sword, (3,3) is out of the 5x5 square
+        if (features.itsKingOpenLines == 1 && features.itsKingHostileSides == 2 && features.itsSwordsNearKing == 2
+            && features.itsKingFortressDistance == 3 && features.itsAttackMobility == -1) {
+            printTestResult(testNum, "King on the border → 1 open line, 2 hostile sides, 2 swords near", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "King on the border → 1 open line, 2 hostile sides, 2 swords near", false, "1 / 2 / 2",
+                            to_string(features.itsKingOpenLines) + " / " + to_string(features.itsKingHostileSides) + " / " + to_string(features.itsSwordsNearKing));
+            failed++;
+        }
+        db(board.itsCells, LITTLE);
+    }
+
+    // Test: unsupported board size
+    testNum++;
+    {
+        Board board = {cb(LITTLE), static_cast<BoardSize>(9)};
+        resetBoard(board.itsCells, LITTLE);
+        EvalFeatures features;
+        features.itsSwordCount = 7;
+        if (!computeEvalFeatures(board, features) && features.itsSwordCount == 0) {
+            printTestResult(testNum, "Board of size 9 → false, features reset", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "Board of size 9 → false, features reset", false, "false", "true");
+            failed++;
         }
+        db(board.itsCells, LITTLE);
     }
+
+    printTestSummary("computeEvalFeatures", pass, failed);
 }
 
 /**
- * @brief Creates a board (cb = "create board").
- * Allocates memory for a 2D array of cells.
- * @param aBoardSize The size of the board
- * @return Pointer to the allocated board
+ * @brief Test function for evaluatePosition.
+ *
+ * This function tests the evaluatePosition function: the score is symmetric for both roles,
+ * a lost SHIELD is good for ATTACK and an open line from the king to a corner is good for DEFENSE.
  */
-Cell** cb(const BoardSize& aBoardSize) {
-    Cell** board = new Cell*[aBoardSize];
-    for (int i = 0; i < aBoardSize; ++i) {
-        board[i] = new Cell[aBoardSize];
+void test_evaluatePosition()
+{
+    printTestHeader("evaluatePosition");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+
+        // Test: same position, opposite point of view
+        testNum++;
+        game.itsCurrentPlayer = &game.itsPlayer1;
+        const int ATTACK_SCORE = evaluatePosition(game);
+        game.itsCurrentPlayer = &game.itsPlayer2;
+        const int DEFENSE_SCORE = evaluatePosition(game);
+        if (ATTACK_SCORE == -DEFENSE_SCORE) {
+            printTestResult(testNum, sizeName + " - initial board → ATTACK score == -DEFENSE score", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - initial board → ATTACK score == -DEFENSE score", false,
+                            to_string(-DEFENSE_SCORE), to_string(ATTACK_SCORE));
+            failed++;
+        }
+
+        // Test: removing a SHIELD is good for ATTACK
+        testNum++;
+        game.itsCurrentPlayer = &game.itsPlayer1;
+        Position shield = {-1, -1};
+        for (int row = 0; row < size && shield.itsRow == -1; ++row) {
+            for (int col = 0; col < size; ++col) {
+                if (game.itsBoard.itsCells[row][col].itsPieceType == SHIELD) {
+                    shield = {row, col};
+                    break;
+                }
+            }
+        }
+        game.itsBoard.itsCells[shield.itsRow][shield.itsCol].itsPieceType = NONE;
+        updateBitboards(game.itsBoard);
+        const int WITHOUT_SHIELD = evaluatePosition(game);
+        if (WITHOUT_SHIELD > ATTACK_SCORE) {
+            printTestResult(testNum, sizeName + " - one SHIELD less → better for ATTACK", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - one SHIELD less → better for ATTACK", false,
+                            "> " + to_string(ATTACK_SCORE), to_string(WITHOUT_SHIELD));
+            failed++;
+        }
+
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: a king with an open line to a corner is good for DEFENSE
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[8][8].itsPieceType = SWORD;
+        game.itsBoard.itsCells[1][4].itsPieceType = KING;
+        game.itsBoard.itsCells[0][2].itsPieceType = SWORD;
+        updateBitboards(game.itsBoard);
+        game.itsCurrentPlayer = &game.itsPlayer2;
+        const int CLOSED = evaluatePosition(game);
+        // king on the edge row, the way to (0,10) is open
+        game.itsBoard.itsCells[1][4].itsPieceType = NONE;
+        game.itsBoard.itsCells[0][4].itsPieceType = KING;
+        updateBitboards(game.itsBoard);
+        const int OPEN = evaluatePosition(game);
+        if (OPEN > CLOSED) {
+            printTestResult(testNum, "King with an open line to a corner → better for DEFENSE", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "King with an open line to a corner → better for DEFENSE", false,
+                            "> " + to_string(CLOSED), to_string(OPEN));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
     }
-    return board;
+
+    printTestSummary("evaluatePosition", pass, failed);
 }
 
 /**
- * @brief Deletes a board (db = "delete board").
- * Frees the memory allocated for a 2D array of cells.
- * @param aBoard The board to delete
- * @param aBoardSize The size of the board
+ * @brief Test function for searchBestMove.
+ *
+ * This function tests the searchBestMove function: it finds a winning move in one for both roles,
+ * plays a legal move within its time budget on the starting boards, and leaves the game unchanged,
+ * with one and with several threads. It also tests the allocation rules of createAi.
  */
-void db(Cell**& aBoard, const BoardSize& aBoardSize) {
-    for (int i = 0; i < aBoardSize; ++i) {
-        delete[] aBoard[i];
+void test_searchBestMove()
+{
+    printTestHeader("searchBestMove");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    AiSearch ai;
+    // Test: allocation and double allocation
+    testNum++;
+    bool created = createAi(ai, 16);
+    AiSearch badSize;
+    if (created && !createAi(ai, 16) && !createAi(badSize, 0) && !createAi(badSize, 40)) {
+        printTestResult(testNum, "createAi → allocated once, bad sizes rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "createAi → allocated once, bad sizes rejected", false, "true/false/false/false", "other");
+        failed++;
+    }
+    if (!created) {
+        printTestSummary("searchBestMove", pass, failed);
+        return;
+    }
+
+    // Test: DEFENSE escapes in one move
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[0][0].itsCellType = FORTRESS;
+        game.itsBoard.itsCells[0][10].itsCellType = FORTRESS;
+        game.itsBoard.itsCells[0][4].itsPieceType = KING;
+        game.itsBoard.itsCells[0][6].itsPieceType = SWORD;
+        game.itsBoard.itsCells[8][8].itsPieceType = SWORD;
+        updateBitboards(game.itsBoard);
+        game.itsBoard.itsHash = computeHash(game.itsBoard, DEFENSE);
+        game.itsCurrentPlayer = &game.itsPlayer2;
+        clearAi(ai);
+        AiResult result = searchBestMove(game, ai, 200, 4);
+        const Move& move = result.itsBestMove;
+        bool ok = move.itsStartPosition.itsRow == 0 && move.itsStartPosition.itsCol == 4
+                  && move.itsEndPosition.itsRow == 0 && move.itsEndPosition.itsCol == 0
+                  && result.itsScore > AI_WIN_SCORE - AI_MAX_PLY;
+        if (ok) {
+            printTestResult(testNum, "DEFENSE - king (0,4) → escapes to (0,0)", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "DEFENSE - king (0,4) → escapes to (0,0)", false, "(0,4)->(0,0)",
+                            "(" + to_string(move.itsStartPosition.itsRow) + "," + to_string(move.itsStartPosition.itsCol) + ")->("
+                            + to_string(move.itsEndPosition.itsRow) + "," + to_string(move.itsEndPosition.itsCol) + ")");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    // Test: ATTACK captures the king in one move
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(game.itsBoard.itsCells, LITTLE);
+        game.itsBoard.itsCells[0][4].itsPieceType = KING;
+        game.itsBoard.itsCells[0][3].itsPieceType = SWORD;
+        game.itsBoard.itsCells[1][4].itsPieceType = SWORD;
+        game.itsBoard.itsCells[3][5].itsPieceType = SWORD;
+        updateBitboards(game.itsBoard);
+        game.itsBoard.itsHash = computeHash(game.itsBoard, ATTACK);
+        game.itsCurrentPlayer = &game.itsPlayer1;
+        clearAi(ai);
+        AiResult result = searchBestMove(game, ai, 200, 4);
+        const Move& move = result.itsBestMove;
+        bool ok = move.itsEndPosition.itsRow == 0 && move.itsEndPosition.itsCol == 5
+                  && result.itsScore > AI_WIN_SCORE - AI_MAX_PLY;
+        if (ok) {
+            printTestResult(testNum, "ATTACK - SWORD (3,5) → closes the king on (0,5)", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "ATTACK - SWORD (3,5) → closes the king on (0,5)", false, "end (0,5)",
+                            "end (" + to_string(move.itsEndPosition.itsRow) + "," + to_string(move.itsEndPosition.itsCol) + ")");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    // Tests: starting boards, legal move within the budget and game restored
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        Board before = {nullptr, size};
+        copyBoard(game.itsBoard, before);
+        clearAi(ai);
+        const int BUDGET = 50;
+        AiResult result = searchBestMove(game, ai, BUDGET);
+
+        testNum++;
+        const string legalDescription = sizeName + " - initial board → legal move in " + to_string(result.itsElapsedMs) + " ms";
+        if (checkMovement(game, result.itsBestMove) == VALID_MOVE && result.itsDepth >= 1 && result.itsElapsedMs <= BUDGET + 50) {
+            printTestResult(testNum, legalDescription, true);
+            pass++;
+        } else {
+            printTestResult(testNum, legalDescription, false, "legal move, <= " + to_string(BUDGET + 50) + " ms",
+                            to_string(result.itsElapsedMs) + " ms, depth " + to_string(result.itsDepth));
+            failed++;
+        }
+
+        testNum++;
+        bool restored = game.itsBoard.itsHash == before.itsHash && game.itsCurrentPlayer == &game.itsPlayer1;
+        for (int row = 0; row < size && restored; ++row) {
+            for (int col = 0; col < size; ++col) {
+                restored = restored && game.itsBoard.itsCells[row][col].itsPieceType == before.itsCells[row][col].itsPieceType;
+            }
+        }
+        if (restored) {
+            printTestResult(testNum, sizeName + " - after the search → game unchanged", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - after the search → game unchanged", false, "unchanged", "modified");
+            failed++;
+        }
+        deleteBoard(before);
+        db(game.itsBoard.itsCells, size);
+    }
+
+    deleteAi(ai);
+
+    // Tests: lazy SMP with 4 threads, same answers
+    AiSearch smp;
+    testNum++;
+    if (createAi(smp, 16, 4) && smp.itsHelperCount == 3) {
+        printTestResult(testNum, "createAi with 4 threads → 3 helpers", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "createAi with 4 threads → 3 helpers", false, "3", to_string(smp.itsHelperCount));
+        failed++;
     }
+    if (smp.itsTable != nullptr) {
+        testNum++;
+        {
+            Game game;
+            game.itsBoard = {cb(LITTLE), LITTLE};
+            resetBoard(game.itsBoard.itsCells, LITTLE);
+            game.itsBoard.itsCells[0][4].itsPieceType = KING;
+            game.itsBoard.itsCells[0][3].itsPieceType = SWORD;
+            game.itsBoard.itsCells[1][4].itsPieceType = SWORD;
+            game.itsBoard.itsCells[3][5].itsPieceType = SWORD;
+            updateBitboards(game.itsBoard);
+            game.itsBoard.itsHash = computeHash(game.itsBoard, ATTACK);
+            game.itsCurrentPlayer = &game.itsPlayer1;
+            AiResult result = searchBestMove(game, smp, 200, 4);
+            if (result.itsBestMove.itsEndPosition.itsRow == 0 && result.itsBestMove.itsEndPosition.itsCol == 5) {
+                printTestResult(testNum, "4 threads - ATTACK closes the king on (0,5)", true);
+                pass++;
+            } else {
+                printTestResult(testNum, "4 threads - ATTACK closes the king on (0,5)", false, "end (0,5)", "other");
+                failed++;
+            }
+            db(game.itsBoard.itsCells, LITTLE);
+        }
+
+        testNum++;
+        {
+            Game game;
+            game.itsBoard = {cb(BIG), BIG};
+            initializeBoard(game.itsBoard);
+            const uint64_t KEY = game.itsBoard.itsHash;
+            AiResult result = searchBestMove(game, smp, 50);
+            if (checkMovement(game, result.itsBestMove) == VALID_MOVE && game.itsBoard.itsHash == KEY && result.itsNodes > 0) {
+                printTestResult(testNum, "4 threads - BIG initial board → legal move, game unchanged", true);
+                pass++;
+            } else {
+                printTestResult(testNum, "4 threads - BIG initial board → legal move, game unchanged", false, "legal", "other");
+                failed++;
+            }
+            db(game.itsBoard.itsCells, BIG);
+        }
+    }
+    deleteAi(smp);
+    printTestSummary("searchBestMove", pass, failed);
+}
+
+/**
+ * @brief Test function for buildOpeningBook.
+ *
+ * This function tests the buildOpeningBook function on the first two plies of the LITTLE board:
+ * one entry per position, the limit of positions, the round trip through writeOpeningBook and
+ * openOpeningBook, the lookup of probeOpeningBook, and a searchBestMove answered by the book.
+ */
+void test_buildOpeningBook()
+{
+    printTestHeader("buildOpeningBook");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    AiSearch ai;
+    if (!createAi(ai, 16)) {
+        printTestResult(++testNum, "createAi → allocated", false, "true", "false");
+        printTestSummary("buildOpeningBook", pass, 1);
+        return;
+    }
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(game.itsBoard);
+    MoveList moves;
+    const int FIRST_MOVES = generateMoves(game, moves);
+
+    // Test: the starting position and every position after one move
+    testNum++;
+    OpeningBook book;
+    const bool BUILT = buildOpeningBook(book, LITTLE, 2, ai, 1, 1000, 1000);
+    if (BUILT && book.itsEntryCount == static_cast<uint64_t>(1 + FIRST_MOVES)) {
+        printTestResult(testNum, "LITTLE, 2 plies → " + to_string(1 + FIRST_MOVES) + " entries", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "LITTLE, 2 plies → " + to_string(1 + FIRST_MOVES) + " entries", false,
+                        to_string(1 + FIRST_MOVES), BUILT ? to_string(book.itsEntryCount) : "not built");
+        failed++;
+    }
+
+    // Test: the limit of positions and the invalid arguments
+    testNum++;
+    OpeningBook small;
+    OpeningBook invalid;
+    const bool SMALL_BUILT = buildOpeningBook(small, LITTLE, 2, ai, 1, 1000, 5);
+    if (SMALL_BUILT && small.itsEntryCount == 5 && !buildOpeningBook(invalid, LITTLE, 0, ai, 1, 1000, 5)
+        && !buildOpeningBook(small, LITTLE, 2, ai, 1, 1000, 5)) {
+        printTestResult(testNum, "5 positions max → 5 entries, bad arguments rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "5 positions max → 5 entries, bad arguments rejected", false, "5", to_string(small.itsEntryCount));
+        failed++;
+    }
+    closeOpeningBook(small);
+
+    // Test: the keys are sorted and the moves are legal
+    testNum++;
+    bool sorted = BUILT;
+    for (uint64_t i = 1 ; sorted && i < book.itsEntryCount ; i++) {
+        sorted = book.itsEntries[i - 1].itsHash < book.itsEntries[i].itsHash;
+    }
+    Move move = {{-1, -1}, {-1, -1}};
+    int score = 0;
+    const bool FOUND = BUILT && probeOpeningBook(book, game, move, score);
+    if (sorted && FOUND && checkMovement(game, move) == VALID_MOVE) {
+        printTestResult(testNum, "starting position → sorted keys, legal book move", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "starting position → sorted keys, legal book move", false, "sorted and found",
+                        string(sorted ? "sorted" : "unsorted") + ", " + (FOUND ? "found" : "not found"));
+        failed++;
+    }
+
+    // Test: round trip through a file
+    testNum++;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_opening.book").string();
+    OpeningBook mapped;
+    bool sameEntries = BUILT && writeOpeningBook(book, PATH) && openOpeningBook(mapped, PATH) && mapped.itsEntryCount == book.itsEntryCount;
+    if (sameEntries) {
+        sameEntries = memcmp(mapped.itsEntries, book.itsEntries, sizeof(BookEntry) * book.itsEntryCount) == 0;
+    }
+    Move mappedMove = {{-1, -1}, {-1, -1}};
+    if (sameEntries && probeOpeningBook(mapped, game, mappedMove, score)
+        && mappedMove.itsEndPosition.itsRow == move.itsEndPosition.itsRow && mappedMove.itsEndPosition.itsCol == move.itsEndPosition.itsCol) {
+        printTestResult(testNum, "write then open → same entries, same move", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "write then open → same entries, same move", false, "same", "different");
+        failed++;
+    }
+
+    // Test: searchBestMove answers from the book without searching
+    testNum++;
+    ai.itsBook = &mapped;
+    clearAi(ai);
+    const AiResult RESULT = searchBestMove(game, ai, 1000, 8);
+    ai.itsBook = nullptr;
+    if (RESULT.itsNodes == 0 && RESULT.itsDepth == 0 && RESULT.itsBestMove.itsStartPosition.itsRow == move.itsStartPosition.itsRow
+        && RESULT.itsBestMove.itsEndPosition.itsCol == move.itsEndPosition.itsCol) {
+        printTestResult(testNum, "searchBestMove with the book → book move, 0 nodes", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "searchBestMove with the book → book move, 0 nodes", false, "0 nodes",
+                        to_string(RESULT.itsNodes) + " nodes");
+        failed++;
+    }
+    closeOpeningBook(mapped);
+
+    // Test: a file with a bad header is rejected
+    testNum++;
+    {
+        fstream file(PATH, ios::binary | ios::in | ios::out);
+        file.write("XXXX", 4);
+    }
+    OpeningBook corrupted;
+    if (!openOpeningBook(corrupted, PATH) && corrupted.itsEntries == nullptr && corrupted.itsData == nullptr) {
+        printTestResult(testNum, "bad magic → rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "bad magic → rejected", false, "false", "true");
+        failed++;
+    }
+    filesystem::remove(PATH);
+
+    closeOpeningBook(book);
+    db(game.itsBoard.itsCells, LITTLE);
+    deleteAi(ai);
+    printTestSummary("buildOpeningBook", pass, failed);
+}
+
+/**
+ * @brief Test function for buildEndgameTables.
+ *
+ * This function tests the buildEndgameTables function on the KING against one and two swords:
+ * the values of an escape in one move for both roles, the move of probeEndgameTables, the
+ * positions without a table, and the round trip through writeEndgameTables and openEndgameTables.
+ */
+void test_buildEndgameTables()
+{
+    printTestHeader("buildEndgameTables");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test: the tables of the KING against one and two swords
+    testNum++;
+    EndgameTables tables;
+    const bool BUILT = buildEndgameTables(tables, LITTLE, 0, 2);
+    EndgameTables invalid;
+    if (BUILT && tables.itsTableCount == 2 && tables.itsTables[0].itsSwords == 1 && tables.itsTables[1].itsSwords == 2
+        && !buildEndgameTables(invalid, LITTLE, 0, 0) && !buildEndgameTables(invalid, LITTLE, ENDGAME_MAX_SHIELDS + 1, 1)) {
+        printTestResult(testNum, "LITTLE, 0 shield, 2 swords → 2 tables, bad arguments rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "LITTLE, 0 shield, 2 swords → 2 tables, bad arguments rejected", false, "2",
+                        to_string(tables.itsTableCount));
+        failed++;
+    }
+    if (!BUILT) {
+        printTestSummary("buildEndgameTables", pass, failed);
+        return;
+    }
+
+    //the KING on (0,4) and a SWORD on (8,8): the KING escapes in one move
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(game.itsBoard);
+    for (int row = 0 ; row < LITTLE ; row++) {
+        for (int col = 0 ; col < LITTLE ; col++) {
+            game.itsBoard.itsCells[row][col].itsPieceType = NONE;
+        }
+    }
+    game.itsBoard.itsCells[0][4].itsPieceType = KING;
+    game.itsBoard.itsCells[8][8].itsPieceType = SWORD;
+    updateBitboards(game.itsBoard);
+
+    // Test: DEFENSE to move wins in 1 ply, ATTACK to move loses in 2 plies
+    testNum++;
+    game.itsCurrentPlayer = &game.itsPlayer2;
+    const int DEFENSE_VALUE = getEndgameValue(tables, game);
+    game.itsCurrentPlayer = &game.itsPlayer1;
+    const int ATTACK_VALUE = getEndgameValue(tables, game);
+    if (DEFENSE_VALUE == 1 && ATTACK_VALUE == (ENDGAME_LOSS | 2)) {
+        printTestResult(testNum, "KING (0,4), SWORD (8,8) → DEFENSE wins in 1, ATTACK loses in 2", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "KING (0,4), SWORD (8,8) → DEFENSE wins in 1, ATTACK loses in 2", false,
+                        "1 / " + to_string(ENDGAME_LOSS | 2), to_string(DEFENSE_VALUE) + " / " + to_string(ATTACK_VALUE));
+        failed++;
+    }
+
+    // Test: probeEndgameTables plays the escape
+    testNum++;
+    game.itsCurrentPlayer = &game.itsPlayer2;
+    game.itsBoard.itsHash = computeHash(game.itsBoard, DEFENSE);
+    Move move = {{-1, -1}, {-1, -1}};
+    int score = 0;
+    const bool PROBED = probeEndgameTables(tables, game, move, score);
+    const bool ESCAPES = PROBED && move.itsStartPosition.itsRow == 0 && move.itsStartPosition.itsCol == 4
+                         && game.itsBoard.itsCells[move.itsEndPosition.itsRow][move.itsEndPosition.itsCol].itsCellType == FORTRESS;
+    if (ESCAPES && score == AI_WIN_SCORE - 1 && game.itsBoard.itsCells[0][4].itsPieceType == KING) {
+        printTestResult(testNum, "DEFENSE to move → KING to a fortress, score AI_WIN_SCORE - 1", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "DEFENSE to move → KING to a fortress, score AI_WIN_SCORE - 1", false, to_string(AI_WIN_SCORE - 1),
+                        PROBED ? to_string(score) : "not found");
+        failed++;
+    }
+
+    // Test: a position without a table
+    testNum++;
+    game.itsBoard.itsCells[2][2].itsPieceType = SWORD;
+    game.itsBoard.itsCells[2][8].itsPieceType = SWORD;
+    game.itsBoard.itsCells[3][3].itsPieceType = SHIELD;
+    updateBitboards(game.itsBoard);
+    const int NO_TABLE = getEndgameValue(tables, game);
+    if (NO_TABLE == -1 && !probeEndgameTables(tables, game, move, score)) {
+        printTestResult(testNum, "3 swords and a shield → no table", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "3 swords and a shield → no table", false, "-1", to_string(NO_TABLE));
+        failed++;
+    }
+    game.itsBoard.itsCells[2][8].itsPieceType = NONE;
+    game.itsBoard.itsCells[3][3].itsPieceType = NONE;
+    updateBitboards(game.itsBoard);
+
+    // Test: round trip through a file
+    testNum++;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_endgame.tables").string();
+    EndgameTables mapped;
+    bool sameValues = writeEndgameTables(tables, PATH) && openEndgameTables(mapped, PATH) && mapped.itsTableCount == tables.itsTableCount;
+    for (int table = 0 ; sameValues && table < tables.itsTableCount ; table++) {
+        const EndgameTableInfo& INFO = tables.itsTables[table];
+        sameValues = mapped.itsTables[table].itsCount == INFO.itsCount
+                     && memcmp(mapped.itsValues + mapped.itsTables[table].itsOffset, tables.itsValues + INFO.itsOffset, INFO.itsCount) == 0;
+    }
+    if (sameValues && getEndgameValue(mapped, game) == getEndgameValue(tables, game)) {
+        printTestResult(testNum, "write then open → same values", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "write then open → same values", false, "same", "different");
+        failed++;
+    }
+    closeEndgameTables(mapped);
+
+    // Test: a truncated file is rejected
+    testNum++;
+    filesystem::resize_file(PATH, filesystem::file_size(PATH) / 2);
+    EndgameTables truncated;
+    if (!openEndgameTables(truncated, PATH) && truncated.itsValues == nullptr && truncated.itsData == nullptr) {
+        printTestResult(testNum, "truncated file → rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "truncated file → rejected", false, "false", "true");
+        failed++;
+    }
+    filesystem::remove(PATH);
+
+    closeEndgameTables(tables);
+    db(game.itsBoard.itsCells, LITTLE);
+    printTestSummary("buildEndgameTables", pass, failed);
+}
+
+/**
+ * @brief Test function for openAnalysisCache.
+ *
+ * This function tests the creation of a cache file, its reopening with its own size and its
+ * results, and the rejection of invalid sizes and of a file of another format.
+ */
+void test_openAnalysisCache()
+{
+    printTestHeader("openAnalysisCache");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_open.cache").string();
+    filesystem::remove(PATH);
+
+    // Test: a new file holds the header and empty slots
+    testNum++;
+    AnalysisCache cache;
+    const bool IS_CREATED = openAnalysisCache(cache, PATH, 6);
+    bool isEmpty = IS_CREATED;
+    for (int slot = 0 ; isEmpty && slot < 64 ; slot++) {
+        isEmpty = cache.itsSlots[slot].itsData.load() == 0;
+    }
+    if (isEmpty && cache.itsBucketMask == 64 / ANALYSIS_WAYS - 1 && filesystem::file_size(PATH) == 64 + 64 * sizeof(AnalysisSlot)) {
+        printTestResult(testNum, "new file, 2^6 slots → 2112 bytes, empty slots", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "new file, 2^6 slots → 2112 bytes, empty slots", false, "2112 bytes", IS_CREATED ? "other" : "not created");
+        failed++;
+    }
+
+    // Test: a result is kept after closing, the file keeps its size
+    testNum++;
+    Game game;
+    parsePosition(POSITION_START_LITTLE, game);
+    AnalysisEntry stored;
+    stored.itsMove = {{0, 3}, {1, 3}};
+    stored.itsScore = -42;
+    stored.itsDepth = 7;
+    stored.itsNodes = 123456789012LL;
+    if (IS_CREATED) {
+        storeAnalysisCache(cache, game, stored);
+    }
+    closeAnalysisCache(cache);
+    AnalysisEntry found;
+    const bool IS_REOPENED = openAnalysisCache(cache, PATH, 10);
+    if (IS_REOPENED && cache.itsData != nullptr && cache.itsBucketMask == 64 / ANALYSIS_WAYS - 1
+        && probeAnalysisCache(cache, game, found) && found.itsScore == -42 && found.itsDepth == 7 && found.itsNodes == 123456789012LL
+        && found.itsMove.itsStartPosition.itsCol == 3 && found.itsMove.itsEndPosition.itsRow == 1) {
+        printTestResult(testNum, "close then open with 2^10 → 2^6 slots, same result", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "close then open with 2^10 → 2^6 slots, same result", false, "same result", "different");
+        failed++;
+    }
+    closeAnalysisCache(cache);
+
+    // Test: invalid sizes and an open cache are rejected
+    testNum++;
+    AnalysisCache other;
+    const bool IS_OPEN = openAnalysisCache(cache, PATH);
+    if (IS_OPEN && !openAnalysisCache(cache, PATH) && !openAnalysisCache(other, PATH, 3) && !openAnalysisCache(other, PATH, 29)
+        && other.itsData == nullptr) {
+        printTestResult(testNum, "open twice, 2^3 or 2^29 slots → rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "open twice, 2^3 or 2^29 slots → rejected", false, "rejected", "accepted");
+        failed++;
+    }
+    closeAnalysisCache(cache);
+
+    // Test: a file of another format is rejected and not modified
+    testNum++;
+    {
+        fstream file(PATH, ios::binary | ios::in | ios::out);
+        file.write("XXXX", 4);
+    }
+    const uintmax_t LENGTH = filesystem::file_size(PATH);
+    if (!openAnalysisCache(cache, PATH) && cache.itsData == nullptr && filesystem::file_size(PATH) == LENGTH) {
+        printTestResult(testNum, "bad magic → rejected, file kept", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "bad magic → rejected, file kept", false, "false", "true");
+        failed++;
+    }
+    filesystem::remove(PATH);
+
+    deleteBoard(game.itsBoard);
+    printTestSummary("openAnalysisCache", pass, failed);
+}
+
+/**
+ * @brief Test function for storeAnalysisCache.
+ *
+ * This function tests the results kept for a position (the deepest one), the eviction of the
+ * least recently used position of a full bucket, the keys of another board size, the answer of
+ * searchBestMove from the cache and preloadAnalysisCache.
+ */
+void test_storeAnalysisCache()
+{
+    printTestHeader("storeAnalysisCache");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_store.cache").string();
+    filesystem::remove(PATH);
+    AnalysisCache cache;
+    Game game;
+    parsePosition(POSITION_START_LITTLE, game);
+    MoveList moves;
+    generateMoves(game, moves);
+    if (!openAnalysisCache(cache, PATH, 4)) {
+        printTestResult(1, "2^4 slots → opened", false, "opened", "not opened");
+        deleteBoard(game.itsBoard);
+        printTestSummary("storeAnalysisCache", 0, 1);
+        return;
+    }
+    const uint64_t KEY = game.itsBoard.itsHash;
+
+    // Test: a shallower result doesn't replace a deeper one, a deeper one does
+    testNum++;
+    AnalysisEntry entry;
+    entry.itsMove = moves.itsMoves[0];
+    entry.itsDepth = 6;
+    entry.itsScore = 10;
+    storeAnalysisCache(cache, game, entry);
+    entry.itsDepth = 3;
+    entry.itsScore = 20;
+    storeAnalysisCache(cache, game, entry);
+    AnalysisEntry found;
+    const bool IS_KEPT = probeAnalysisCache(cache, game, found) && found.itsDepth == 6 && found.itsScore == 10;
+    entry.itsDepth = 8;
+    entry.itsScore = 30;
+    storeAnalysisCache(cache, game, entry);
+    if (IS_KEPT && probeAnalysisCache(cache, game, found) && found.itsDepth == 8 && found.itsScore == 30) {
+        printTestResult(testNum, "depth 6, 3 then 8 → depth 6 kept, then replaced by 8", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "depth 6, 3 then 8 → depth 6 kept, then replaced by 8", false, "8",
+                        to_string(found.itsDepth));
+        failed++;
+    }
+
+    // Test: a full bucket evicts its least recently used position
+    testNum++;
+    const uint64_t STEP = cache.itsBucketMask + 1;
+    entry.itsDepth = 1;
+    for (int key = 1 ; key < ANALYSIS_WAYS ; key++) {
+        game.itsBoard.itsHash = KEY + key * STEP;
+        storeAnalysisCache(cache, game, entry);
+    }
+    //the first position is used again, the second one is now the oldest
+    game.itsBoard.itsHash = KEY;
+    const bool IS_FIRST_FOUND = probeAnalysisCache(cache, game, found);
+    game.itsBoard.itsHash = KEY + ANALYSIS_WAYS * STEP;
+    storeAnalysisCache(cache, game, entry);
+    bool isPresent[ANALYSIS_WAYS + 1];
+    for (int key = 0 ; key <= ANALYSIS_WAYS ; key++) {
+        game.itsBoard.itsHash = KEY + key * STEP;
+        isPresent[key] = probeAnalysisCache(cache, game, found);
+    }
+    if (IS_FIRST_FOUND && isPresent[0] && !isPresent[1] && isPresent[2] && isPresent[3] && isPresent[ANALYSIS_WAYS]) {
+        printTestResult(testNum, "5 keys in a bucket of 4 → least recently used evicted", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "5 keys in a bucket of 4 → least recently used evicted", false, "key 1 evicted",
+                        string(isPresent[1] ? "key 1 kept" : "key 1 evicted") + (isPresent[0] ? "" : ", key 0 evicted"));
+        failed++;
+    }
+
+    // Test: the key of another board size is not answered
+    testNum++;
+    Game big;
+    parsePosition(POSITION_START_BIG, big);
+    big.itsBoard.itsHash = KEY;
+    if (!probeAnalysisCache(cache, big, found)) {
+        printTestResult(testNum, "same key, 13x13 board → not found", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "same key, 13x13 board → not found", false, "not found", "found");
+        failed++;
+    }
+    deleteBoard(big.itsBoard);
+    closeAnalysisCache(cache);
+    filesystem::remove(PATH);
+
+    // Test: searchBestMove stores its result, then answers from the cache
+    testNum++;
+    parsePosition(POSITION_START_LITTLE, game);
+    AiSearch ai;
+    const bool IS_READY = createAi(ai, 16) && openAnalysisCache(cache, PATH, 8);
+    ai.itsAnalysis = &cache;
+    const AiResult SEARCHED = IS_READY ? searchBestMove(game, ai, 10000, 3) : AiResult();
+    const AiResult CACHED = IS_READY ? searchBestMove(game, ai, 10000, 3) : AiResult();
+    if (IS_READY && SEARCHED.itsDepth == 3 && SEARCHED.itsNodes > 0 && CACHED.itsDepth == 3 && CACHED.itsNodes == SEARCHED.itsNodes
+        && CACHED.itsScore == SEARCHED.itsScore && CACHED.itsElapsedMs <= 1
+        && CACHED.itsBestMove.itsStartPosition.itsRow == SEARCHED.itsBestMove.itsStartPosition.itsRow
+        && CACHED.itsBestMove.itsEndPosition.itsCol == SEARCHED.itsBestMove.itsEndPosition.itsCol) {
+        printTestResult(testNum, "depth 3 searched twice → second answer from the cache", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "depth 3 searched twice → second answer from the cache", false, "same result",
+                        to_string(CACHED.itsElapsedMs) + " ms");
+        failed++;
+    }
+
+    // Test: the results of the cache fill the transposition table
+    testNum++;
+    makeMove(game, SEARCHED.itsBestMove);
+    const AiResult REPLY = IS_READY ? searchBestMove(game, ai, 10000, 2) : AiResult();
+    clearAi(ai);
+    const long long LOADED = IS_READY ? preloadAnalysisCache(cache, ai) : -1;
+    if (REPLY.itsDepth == 2 && LOADED == 2) {
+        printTestResult(testNum, "2 positions searched → 2 results loaded", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "2 positions searched → 2 results loaded", false, "2", to_string(LOADED));
+        failed++;
+    }
+    ai.itsAnalysis = nullptr;
+    closeAnalysisCache(cache);
+    filesystem::remove(PATH);
+
+    deleteAi(ai);
+    deleteBoard(game.itsBoard);
+    printTestSummary("storeAnalysisCache", pass, failed);
+}
+
+/**
+ * @brief Sums the floats of one plane of an encoded position.
+ */
+static float sumPlane(const float* aPlanes, int aPlane, int aSize) {
+    float sum = 0.0f;
+    for (int cell = 0 ; cell < aSize * aSize ; cell++) {
+        sum += aPlanes[aPlane * aSize * aSize + cell];
+    }
+    return sum;
+}
+
+/**
+ * @brief Test function for encodeEvalPosition.
+ *
+ * This function tests the encoding of the initial boards of both sizes: the count of each piece
+ * and special cell plane, the KING on the CASTLE, the side-to-move plane, the same planes from
+ * the bitboards and from a scan of the cells, and a board without cells.
+ */
+void test_encodeEvalPosition()
+{
+    printTestHeader("encodeEvalPosition");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        const int FLOATS = getEvalPositionFloats(size);
+        const int CENTER = (size / 2) * size + size / 2;
+        float* planes = new float[FLOATS];
+        float* scanned = new float[FLOATS];
+
+        // Test: one 1 per piece and per special cell, the KING on the CASTLE
+        testNum++;
+        const bool ENCODED = encodeEvalPosition(game, planes);
+        if (ENCODED && sumPlane(planes, PLANE_SHIELD, size) == countPieces(game.itsBoard, SHIELD)
+            && sumPlane(planes, PLANE_SWORD, size) == countPieces(game.itsBoard, SWORD)
+            && sumPlane(planes, PLANE_KING, size) == 1.0f && planes[PLANE_KING * size * size + CENTER] == 1.0f
+            && sumPlane(planes, PLANE_FORTRESS, size) == 4.0f && planes[PLANE_CASTLE * size * size + CENTER] == 1.0f
+            && sumPlane(planes, PLANE_CASTLE, size) == 1.0f) {
+            printTestResult(testNum, sizeName + " - initial board → piece and cell planes", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - initial board → piece and cell planes", false,
+                            to_string(countPieces(game.itsBoard, SWORD)) + " swords",
+                            ENCODED ? to_string(static_cast<int>(sumPlane(planes, PLANE_SWORD, size))) + " swords" : "not encoded");
+            failed++;
+        }
+
+        // Test: the side-to-move plane
+        testNum++;
+        const float ATTACK_PLANE = sumPlane(planes, PLANE_TO_MOVE, size);
+        game.itsCurrentPlayer = &game.itsPlayer2;
+        encodeEvalPosition(game, planes);
+        const float DEFENSE_PLANE = sumPlane(planes, PLANE_TO_MOVE, size);
+        if (ATTACK_PLANE == size * size && DEFENSE_PLANE == 0.0f) {
+            printTestResult(testNum, sizeName + " - side to move → all 1 for ATTACK, all 0 for DEFENSE", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - side to move → all 1 for ATTACK, all 0 for DEFENSE", false,
+                            to_string(size * size) + "/0", to_string(static_cast<int>(ATTACK_PLANE)) + "/" + to_string(static_cast<int>(DEFENSE_PLANE)));
+            failed++;
+        }
+
+        // Test: the scan of the cells gives the planes of the bitboards
+        testNum++;
+        game.itsBoard.itsHasBitboards = false;
+        const bool SCANNED = encodeEvalPosition(game, scanned);
+        if (SCANNED && memcmp(planes, scanned, sizeof(float) * FLOATS) == 0) {
+            printTestResult(testNum, sizeName + " - without bitboards → same planes", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - without bitboards → same planes", false, "same", "different");
+            failed++;
+        }
+
+        delete[] planes;
+        delete[] scanned;
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: a board without cells is not encoded
+    testNum++;
+    Game empty;
+    float planes[EVAL_PLANE_COUNT * LITTLE * LITTLE] = {};
+    planes[0] = 2.0f;
+    if (!encodeEvalPosition(empty, planes) && planes[0] == 2.0f) {
+        printTestResult(testNum, "no cells → false, nothing written", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "no cells → false, nothing written", false, "false", "true");
+        failed++;
+    }
+
+    printTestSummary("encodeEvalPosition", pass, failed);
+}
+
+/**
+ * @struct CountingBackend
+ * @brief Context of a test backend: a linear model and what it was asked.
+ */
+struct CountingBackend
+{
+    LinearEvalModel itsModel;   /**< The model scoring the positions. */
+    atomic<int> itsCalls{0};    /**< Number of batches evaluated. */
+    atomic<int> itsLargest{0};  /**< Largest batch evaluated. */
+};
+
+/**
+ * @brief Backend function of a `CountingBackend`.
+ */
+static bool evaluateCounting(void* aContext, const float* aTensor, int aCount, BoardSize aSize, int* aScores) {
+    CountingBackend& backend = *static_cast<CountingBackend*>(aContext);
+    backend.itsCalls++;
+    int largest = backend.itsLargest.load();
+    while (aCount > largest && !backend.itsLargest.compare_exchange_weak(largest, aCount)) {
+    }
+    return evaluateLinearModel(&backend.itsModel, aTensor, aCount, aSize, aScores);
+}
+
+/**
+ * @brief Backend function claiming a win for ATTACK in every position.
+ */
+static bool evaluateHuge(void*, const float*, int aCount, BoardSize, int* aScores) {
+    for (int i = 0 ; i < aCount ; i++) {
+        aScores[i] = 1000000;
+    }
+    return true;
+}
+
+/**
+ * @brief Test function for evaluateEvalBatch.
+ *
+ * This function tests a batch of positions of the LITTLE board: the sizes mixed in a batch,
+ * the scores of the linear model for both players to move, a model of the wrong size,
+ * the scores kept below the win scores, and searchBestMove with a backend attached.
+ */
+void test_evaluateEvalBatch()
+{
+    printTestHeader("evaluateEvalBatch");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(game.itsBoard);
+    Game big;
+    big.itsBoard = {cb(BIG), BIG};
+    initializeBoard(big.itsBoard);
+    EvalBatch batch;
+
+    // Test: the positions are added in order, another size is rejected
+    testNum++;
+    const bool CREATED = createEvalBatch(batch, 4);
+    const int FIRST = CREATED ? addEvalPosition(batch, game) : -1;
+    game.itsCurrentPlayer = &game.itsPlayer2;
+    const int SECOND = CREATED ? addEvalPosition(batch, game) : -1;
+    game.itsCurrentPlayer = &game.itsPlayer1;
+    const int OTHER_SIZE = CREATED ? addEvalPosition(batch, big) : -1;
+    EvalBatch tooBig;
+    if (CREATED && FIRST == 0 && SECOND == 1 && OTHER_SIZE == -1 && batch.itsCount == 2 && !createEvalBatch(tooBig, MAX_MOVES + 1)) {
+        printTestResult(testNum, "LITTLE, LITTLE, BIG → slots 0 and 1, BIG rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "LITTLE, LITTLE, BIG → slots 0 and 1, BIG rejected", false, "0/1/-1",
+                        to_string(FIRST) + "/" + to_string(SECOND) + "/" + to_string(OTHER_SIZE));
+        failed++;
+    }
+    if (!CREATED) {
+        db(game.itsBoard.itsCells, LITTLE);
+        db(big.itsBoard.itsCells, BIG);
+        printTestSummary("evaluateEvalBatch", pass, failed);
+        return;
+    }
+
+    // Test: the linear model scores material and king distance for the player to move
+    testNum++;
+    LinearEvalModel model;
+    initializeLinearModel(model, LITTLE);
+    const EvalBackend LINEAR = makeLinearBackend(model);
+    const int EXPECTED = AI_SWORD_VALUE * countPieces(game.itsBoard, SWORD) - AI_SHIELD_VALUE * countPieces(game.itsBoard, SHIELD)
+                         + AI_KING_CORNER_DISTANCE * 10;
+    if (evaluateEvalBatch(batch, LINEAR) && batch.itsScores[0] == EXPECTED && batch.itsScores[1] == -EXPECTED) {
+        printTestResult(testNum, "linear model → " + to_string(EXPECTED) + " for ATTACK, opposite for DEFENSE", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "linear model → " + to_string(EXPECTED) + " for ATTACK, opposite for DEFENSE", false,
+                        to_string(EXPECTED) + "/" + to_string(-EXPECTED), to_string(batch.itsScores[0]) + "/" + to_string(batch.itsScores[1]));
+        failed++;
+    }
+
+    // Test: a model of another size, an empty batch and a backend claiming wins
+    testNum++;
+    LinearEvalModel bigModel;
+    initializeLinearModel(bigModel, BIG);
+    const bool WRONG_SIZE = evaluateEvalBatch(batch, makeLinearBackend(bigModel));
+    EvalBackend huge;
+    huge.itsEvaluate = evaluateHuge;
+    const bool HUGE_DONE = evaluateEvalBatch(batch, huge);
+    const int LIMIT = AI_WIN_SCORE - AI_MAX_PLY - 1;
+    clearEvalBatch(batch);
+    if (!WRONG_SIZE && HUGE_DONE && batch.itsScores[0] == LIMIT && batch.itsScores[1] == -LIMIT && !evaluateEvalBatch(batch, LINEAR)) {
+        printTestResult(testNum, "wrong size, empty batch → false, wins clamped below the search wins", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "wrong size, empty batch → false, wins clamped below the search wins", false,
+                        to_string(LIMIT), to_string(batch.itsScores[0]));
+        failed++;
+    }
+    deleteEvalBatch(batch);
+
+    // Test: the search evaluates its horizon in batches and still finds the escape
+    testNum++;
+    {
+        AiSearch ai;
+        CountingBackend counting;
+        initializeLinearModel(counting.itsModel, LITTLE);
+        EvalBackend backend;
+        backend.itsEvaluate = evaluateCounting;
+        backend.itsContext = &counting;
+        Game escape;
+        escape.itsBoard = {cb(LITTLE), LITTLE};
+        resetBoard(escape.itsBoard.itsCells, LITTLE);
+        escape.itsBoard.itsCells[0][0].itsCellType = FORTRESS;
+        escape.itsBoard.itsCells[0][10].itsCellType = FORTRESS;
+        escape.itsBoard.itsCells[10][0].itsCellType = FORTRESS;
+        escape.itsBoard.itsCells[10][10].itsCellType = FORTRESS;
+        escape.itsBoard.itsCells[0][4].itsPieceType = KING;
+        escape.itsBoard.itsCells[0][6].itsPieceType = SWORD;
+        escape.itsBoard.itsCells[8][8].itsPieceType = SWORD;
+        updateBitboards(escape.itsBoard);
+        escape.itsBoard.itsHash = computeHash(escape.itsBoard, DEFENSE);
+        escape.itsCurrentPlayer = &escape.itsPlayer2;
+        const bool ATTACHED = createAi(ai, 16) && attachEvaluator(ai, &backend);
+        const AiResult ESCAPE = ATTACHED ? searchBestMove(escape, ai, 1000, 3) : AiResult();
+        clearAi(ai);
+        const AiResult OPENING = ATTACHED ? searchBestMove(game, ai, 1000, 2) : AiResult();
+        const bool DETACHED = ATTACHED && attachEvaluator(ai, nullptr) && ai.itsBatch == nullptr && ai.itsEvaluator == nullptr;
+        if (ATTACHED && ESCAPE.itsBestMove.itsEndPosition.itsRow == 0 && ESCAPE.itsBestMove.itsEndPosition.itsCol == 0
+            && OPENING.itsDepth == 2 && checkMovement(game, OPENING.itsBestMove) == VALID_MOVE
+            && counting.itsCalls > 0 && counting.itsLargest > 1 && DETACHED) {
+            printTestResult(testNum, "backend attached → escape found, legal opening move, batches of " + to_string(counting.itsLargest.load()), true);
+            pass++;
+        } else {
+            printTestResult(testNum, "backend attached → escape found, legal opening move, batched", false, "A1, depth 2, batches",
+                            to_string(ESCAPE.itsBestMove.itsEndPosition.itsCol) + ", depth " + to_string(OPENING.itsDepth)
+                            + ", largest " + to_string(counting.itsLargest.load()));
+            failed++;
+        }
+        deleteAi(ai);
+        db(escape.itsBoard.itsCells, LITTLE);
+    }
+
+    db(game.itsBoard.itsCells, LITTLE);
+    db(big.itsBoard.itsCells, BIG);
+    printTestSummary("evaluateEvalBatch", pass, failed);
+}
+
+/**
+ * @brief Test function for searchMctsMove.
+ *
+ * This function tests the allocation rules of createMcts, the winning moves in one for both roles,
+ * the repeatability of a search with one thread and a playout limit, the playout count with
+ * several threads, and a finished game.
+ */
+void test_searchMctsMove()
+{
+    printTestHeader("searchMctsMove");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test: allocation and double allocation
+    testNum++;
+    MctsSearch mcts;
+    MctsSearch badSize;
+    const bool IS_CREATED = createMcts(mcts, 16, 1, 7);
+    if (IS_CREATED && !createMcts(mcts, 16) && !createMcts(badSize, 3) && !createMcts(badSize, 25)) {
+        printTestResult(testNum, "createMcts → allocated once, bad sizes rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "createMcts → allocated once, bad sizes rejected", false, "true/false/false/false", "other");
+        failed++;
+    }
+    if (!IS_CREATED) {
+        printTestSummary("searchMctsMove", pass, failed);
+        return;
+    }
+
+    // Test: the winning move in one is found by both roles
+    struct WinCase { const char* itsPosition; const char* itsName; GameStatus itsStatus; };
+    const WinCase CASES[] = {
+        {"4k1a4/11/11/11/11/11/11/11/8a2/11/11 d", "DEFENSE - king (0,4) → escapes", KING_ESCAPED},
+        {"3ak6/4a6/11/5a5/11/11/11/11/11/11/11 a", "ATTACK - king (0,4) → captured", KING_CAPTURED}
+    };
+    Game game;
+    for (const WinCase& winCase : CASES) {
+        testNum++;
+        parsePosition(winCase.itsPosition, game);
+        const uint64_t HASH = game.itsBoard.itsHash;
+        const AiResult RESULT = searchMctsMove(game, mcts, 10000, 400);
+        const bool IS_LEGAL = isValidMovement(game, RESULT.itsBestMove);
+        const bool IS_UNCHANGED = game.itsBoard.itsHash == HASH;
+        GameStatus status = IN_PROGRESS;
+        if (IS_LEGAL) {
+            makeMove(game, RESULT.itsBestMove);
+            status = getGameStatus(game.itsBoard);
+        }
+        if (IS_LEGAL && IS_UNCHANGED && status == winCase.itsStatus && RESULT.itsScore > 900) {
+            printTestResult(testNum, winCase.itsName, true);
+            pass++;
+        } else {
+            printTestResult(testNum, winCase.itsName, false, "winning move", "score " + to_string(RESULT.itsScore));
+            failed++;
+        }
+    }
+
+    // Test: one thread with a playout limit always plays the same move
+    testNum++;
+    parsePosition(POSITION_START_LITTLE, game);
+    const AiResult FIRST = searchMctsMove(game, mcts, 10000, 300);
+    const AiResult SECOND = searchMctsMove(game, mcts, 10000, 300);
+    if (FIRST.itsNodes == 300 && SECOND.itsNodes == 300 && isValidMovement(game, FIRST.itsBestMove)
+        && FIRST.itsScore == SECOND.itsScore && FIRST.itsDepth >= 1
+        && FIRST.itsBestMove.itsEndPosition.itsRow == SECOND.itsBestMove.itsEndPosition.itsRow
+        && FIRST.itsBestMove.itsEndPosition.itsCol == SECOND.itsBestMove.itsEndPosition.itsCol) {
+        printTestResult(testNum, "1 thread, 300 playouts twice → same legal move and score", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "1 thread, 300 playouts twice → same legal move and score", false,
+                        "300 playouts, same move", to_string(FIRST.itsNodes) + " and " + to_string(SECOND.itsNodes));
+        failed++;
+    }
+
+    // Test: 4 threads share the playouts of one tree
+    testNum++;
+    MctsSearch parallel;
+    parsePosition(POSITION_START_BIG, game);
+    const bool IS_PARALLEL = createMcts(parallel, 16, 4);
+    const AiResult RESULT = IS_PARALLEL ? searchMctsMove(game, parallel, 10000, 800) : AiResult();
+    if (IS_PARALLEL && RESULT.itsNodes == 800 && parallel.itsNodes[0].itsVisits.load() == 800
+        && parallel.itsNodes[0].itsVirtualLoss.load() == 0 && isValidMovement(game, RESULT.itsBestMove)) {
+        printTestResult(testNum, "4 threads, 800 playouts → 800 root visits, no virtual loss left", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "4 threads, 800 playouts → 800 root visits, no virtual loss left", false, "800",
+                        to_string(RESULT.itsNodes));
+        failed++;
+    }
+    deleteMcts(parallel);
+
+    // Test: a finished game has no move
+    testNum++;
+    parsePosition("11/11/11/11/11/5k5/11/11/11/11/11 a", game);
+    const AiResult FINISHED = searchMctsMove(game, mcts, 100);
+    if (FINISHED.itsBestMove.itsStartPosition.itsRow == -1 && FINISHED.itsNodes == 0) {
+        printTestResult(testNum, "no SWORD left → no move", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "no SWORD left → no move", false, "-1", to_string(FINISHED.itsBestMove.itsStartPosition.itsRow));
+        failed++;
+    }
+
+    deleteMcts(mcts);
+    deleteBoard(game.itsBoard);
+    printTestSummary("searchMctsMove", pass, failed);
+}
+
+/**
+ * @brief Test function for chooseComputerMove.
+ *
+ * This function tests the names of the engines and that a computer player plays a legal move
+ * with both engines, on the same game interface.
+ */
+void test_chooseComputerMove()
+{
+    printTestHeader("chooseComputerMove");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test: engine names
+    testNum++;
+    EngineKind engine = ENGINE_ALPHA_BETA;
+    if (parseEngineName("mcts", engine) && engine == ENGINE_MCTS && strcmp(getEngineName(engine), "mcts") == 0
+        && parseEngineName(getEngineName(ENGINE_ALPHA_BETA), engine) && engine == ENGINE_ALPHA_BETA && !parseEngineName("minimax", engine)) {
+        printTestResult(testNum, "alphabeta and mcts → read back, unknown name rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "alphabeta and mcts → read back, unknown name rejected", false, "valid", "invalid");
+        failed++;
+    }
+
+    // Test: both engines play a legal move and leave the game unchanged
+    Game game;
+    for (EngineKind kind : {ENGINE_ALPHA_BETA, ENGINE_MCTS}) {
+        testNum++;
+        parsePosition(POSITION_START_LITTLE, game);
+        ComputerPlayer computer;
+        const bool IS_CREATED = createComputerPlayer(computer, kind, 2);
+        const AiResult RESULT = IS_CREATED ? chooseComputerMove(game, computer, 50) : AiResult();
+        const string NAME = string(getEngineName(kind)) + " → legal move in 50 ms";
+        if (IS_CREATED && computer.itsEngine == kind && isValidMovement(game, RESULT.itsBestMove) && RESULT.itsNodes > 0
+            && game.itsBoard.itsHash == computeHash(game.itsBoard, ATTACK)) {
+            printTestResult(testNum, NAME, true);
+            pass++;
+        } else {
+            printTestResult(testNum, NAME, false, "legal move", "none");
+            failed++;
+        }
+        deleteComputerPlayer(computer);
+    }
+
+    deleteBoard(game.itsBoard);
+    printTestSummary("chooseComputerMove", pass, failed);
+}
+
+/**
+ * @brief Test function for playSelfPlayGame.
+ *
+ * This function tests one headless game: random games are reproducible from their seed,
+ * stop at the ply limit, and AI games end with a winner given by whoWon.
+ */
+void test_playSelfPlayGame()
+{
+    printTestHeader("playSelfPlayGame");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        SelfPlaySettings settings;
+        settings.itsSize = size;
+        settings.itsSeed = 42;
+
+        // Test: same seed, same game
+        testNum++;
+        SelfPlayResult first = playSelfPlayGame(settings, 3, nullptr);
+        SelfPlayResult second = playSelfPlayGame(settings, 3, nullptr);
+        SelfPlayResult other = playSelfPlayGame(settings, 4, nullptr);
+        if (first.itsPlies == second.itsPlies && first.itsFinalHash == second.itsFinalHash && first.itsEnd == second.itsEnd
+            && (first.itsFinalHash != other.itsFinalHash || first.itsPlies != other.itsPlies)) {
+            printTestResult(testNum, sizeName + " - random games → same seed, same game", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - random games → same seed, same game", false, "same", "different");
+            failed++;
+        }
+
+        // Test: the ply limit stops the game without a winner
+        testNum++;
+        settings.itsMaxPlies = 2;
+        SelfPlayResult limited = playSelfPlayGame(settings, 0, nullptr);
+        if (limited.itsEnd == END_PLY_LIMIT && limited.itsPlies == 2 && !limited.itsHasWinner) {
+            printTestResult(testNum, sizeName + " - 2 plies limit → stopped after 2 plies", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - 2 plies limit → stopped after 2 plies", false, "limit / 2",
+                            to_string(limited.itsEnd) + " / " + to_string(limited.itsPlies));
+            failed++;
+        }
+    }
+
+    // Test: AI against random on a LITTLE board ends with a winner
+    testNum++;
+    {
+        AiSearch search;
+        createAi(search, 14);
+        SelfPlaySettings settings;
+        settings.itsAttack = RANDOM_PLAYER;
+        settings.itsDefense = AI_PLAYER;
+        settings.itsMaxDepth = 2;
+        settings.itsTimeBudgetMs = 20;
+        SelfPlayResult result = playSelfPlayGame(settings, 0, &search);
+        if (result.itsHasWinner && result.itsEnd != END_PLY_LIMIT && result.itsPlies > 0) {
+            printTestResult(testNum, "LITTLE - AI DEFENSE against random ATTACK → game won in " + to_string(result.itsPlies) + " plies", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "LITTLE - AI DEFENSE against random ATTACK → game won", false, "winner", "no winner");
+            failed++;
+        }
+        deleteAi(search);
+    }
+
+    printTestSummary("playSelfPlayGame", pass, failed);
+}
+
+/**
+ * @brief Test function for runSelfPlay.
+ *
+ * This function tests the thread pool of the self-play runner: one line per game in index order,
+ * and the same output with one or several threads.
+ */
+void test_runSelfPlay()
+{
+    printTestHeader("runSelfPlay");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    SelfPlaySettings settings;
+    settings.itsMaxPlies = 200;
+    const int GAMES = 24;
+
+    // Test: one line per game, in order
+    testNum++;
+    stringstream single;
+    bool done = runSelfPlay(settings, GAMES, 1, single);
+    int lines = 0;
+    bool inOrder = true;
+    string line;
+    while (getline(single, line)) {
+        inOrder = inOrder && line.rfind(to_string(lines) + " ", 0) == 0;
+        lines++;
+    }
+    if (done && lines == GAMES && inOrder) {
+        printTestResult(testNum, "1 thread → " + to_string(GAMES) + " lines in game order", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "1 thread → " + to_string(GAMES) + " lines in game order", false, to_string(GAMES), to_string(lines));
+        failed++;
+    }
+
+    // Test: the output doesn't depend on the number of threads
+    testNum++;
+    stringstream several;
+    SelfPlayResult results[GAMES];
+    done = runSelfPlay(settings, GAMES, 4, several, results);
+    if (done && several.str() == single.str() && results[GAMES - 1].itsPlies > 0) {
+        printTestResult(testNum, "4 threads → same output as 1 thread", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "4 threads → same output as 1 thread", false, "same", "different");
+        failed++;
+    }
+
+    printTestSummary("runSelfPlay", pass, failed);
+}
+
+/**
+ * @brief Plays a game of pseudo-random legal moves and writes it as a game record (see replay.h).
+ *
+ * @param aSize The size of the board.
+ * @param aSeed Chooses the moves.
+ * @param aGame The game receiving the final position.
+ * @param aLastMove Receives the text of the last move (empty if no move was played).
+ * @return The record, with the winner of the final position.
+ */
+static string playRecordGame(BoardSize aSize, int aSeed, Game& aGame, string& aLastMove)
+{
+    resizeBoard(aGame.itsBoard, aSize);
+    initializeBoard(aGame.itsBoard);
+    aGame.itsCurrentPlayer = &aGame.itsPlayer1;
+    string moves;
+    aLastMove.clear();
+    MoveList list;
+    char text[MOVE_TEXT_CAPACITY];
+    char winner = '-';
+    for (int ply = 0 ; ; ply++) {
+        if (isGameFinished(aGame)) {
+            winner = (whoWon(aGame)->itsRole == ATTACK) ? 'A' : 'D';
+            break;
+        }
+        if (generateMoves(aGame, list) == 0) {
+            winner = (aGame.itsCurrentPlayer->itsRole == ATTACK) ? 'D' : 'A';
+            break;
+        }
+        if (ply == 300) {
+            break;
+        }
+        const Move MOVE = list.itsMoves[(ply * 7919 + aSeed * 104729) % list.itsCount];
+        formatMove(MOVE, text, sizeof(text));
+        aLastMove = text;
+        moves += string(" ") + text;
+        makeMove(aGame, MOVE);
+    }
+    return to_string(aSize) + " " + winner + moves;
+}
+
+/**
+ * @brief Test function for validateGameRecord.
+ *
+ * This function tests the verdicts of records without moves, with a bad header, an illegal
+ * move, an unreadable move, a wrong winner and a move after the end, and of complete games.
+ */
+void test_validateGameRecord()
+{
+    printTestHeader("validateGameRecord");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    Game game;
+
+    // Test: hand-written records
+    struct RecordCase { const char* itsRecord; ReplayStatus itsStatus; int itsPlies; };
+    const RecordCase CASES[] = {
+        {"11 -", REPLAY_VALID, 0},
+        {"13 a", REPLAY_WRONG_RESULT, 0},
+        {"12 -", REPLAY_SYNTAX_ERROR, 0},
+        {"11 X", REPLAY_SYNTAX_ERROR, 0},
+        {"11", REPLAY_SYNTAX_ERROR, 0},
+        {"11 - F1-F2", REPLAY_ILLEGAL_MOVE, 0},
+        {"11 - A4-C4 Z9-Z10", REPLAY_SYNTAX_ERROR, 1},
+        {"11   -\tA4-C4  ", REPLAY_VALID, 1}
+    };
+    for (const RecordCase& recordCase : CASES) {
+        testNum++;
+        const ReplayVerdict VERDICT = validateGameRecord(recordCase.itsRecord, game);
+        const string NAME = string("\"") + recordCase.itsRecord + "\" → " + getReplayStatusName(recordCase.itsStatus);
+        if (VERDICT.itsStatus == recordCase.itsStatus && VERDICT.itsPlies == recordCase.itsPlies) {
+            printTestResult(testNum, NAME, true);
+            pass++;
+        } else {
+            printTestResult(testNum, NAME, false, getReplayStatusName(recordCase.itsStatus),
+                            string(getReplayStatusName(VERDICT.itsStatus)) + " after " + to_string(VERDICT.itsPlies));
+            failed++;
+        }
+    }
+
+    // Test: complete games are valid, a move after the end or another winner is rejected
+    testNum++;
+    int valid = 0;
+    int finished = 0;
+    int rejected = 0;
+    const int GAMES = 40;
+    Game player;
+    string lastMove;
+    for (int seed = 0 ; seed < GAMES ; seed++) {
+        const string RECORD = playRecordGame((seed % 2 == 0) ? LITTLE : BIG, seed, player, lastMove);
+        const ReplayVerdict VERDICT = validateGameRecord(RECORD, game);
+        valid += VERDICT.itsStatus == REPLAY_VALID && VERDICT.itsFinalHash == player.itsBoard.itsHash;
+        if (RECORD[3] != '-') {
+            finished++;
+            rejected += validateGameRecord(RECORD + " " + lastMove, game).itsStatus == REPLAY_AFTER_END;
+            string wrong = RECORD;
+            wrong[3] = '-';
+            rejected += validateGameRecord(wrong, game).itsStatus == REPLAY_WRONG_RESULT;
+        }
+    }
+    if (valid == GAMES && finished > 0 && rejected == 2 * finished) {
+        printTestResult(testNum, to_string(GAMES) + " games → valid, " + to_string(finished) + " finished ones tampered → rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "complete games", false, to_string(GAMES) + " valid", to_string(valid) + " valid, "
+                        + to_string(rejected) + "/" + to_string(2 * finished) + " rejected");
+        failed++;
+    }
+
+    deleteBoard(player.itsBoard);
+    deleteBoard(game.itsBoard);
+    printTestSummary("validateGameRecord", pass, failed);
+}
+
+/**
+ * @brief Test function for runReplay.
+ *
+ * This function tests that the verdicts of several chunks of records are written in the order of
+ * the input whatever the number of threads, and that the comments and empty lines are skipped.
+ */
+void test_runReplay()
+{
+    printTestHeader("runReplay");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // the records of 3 chunks and a half, some of them tampered
+    Game game;
+    string lastMove;
+    string input = "# submitted games\n\n";
+    string expected;
+    char line[64];
+    const int RECORDS = REPLAY_CHUNK_RECORDS * 3 + REPLAY_CHUNK_RECORDS / 2;
+    for (int record = 0 ; record < RECORDS ; record++) {
+        string text = playRecordGame((record % 3 == 0) ? BIG : LITTLE, record, game, lastMove);
+        if (record % 5 == 0) {
+            text += " A1-A2";
+        }
+        input += text + ((record % 7 == 0) ? "\r\n\n" : "\n");
+        formatReplayVerdict(record, validateGameRecord(text, game), line, sizeof(line));
+        expected += line;
+    }
+
+    // Test: 1 and 4 threads give the verdicts of the records, in order
+    for (int threads : {1, 4}) {
+        testNum++;
+        stringstream records(input);
+        stringstream output;
+        ReplaySummary summary;
+        const bool IS_DONE = runReplay(records, output, threads, &summary);
+        long long counted = 0;
+        for (long long count : summary.itsCounts) {
+            counted += count;
+        }
+        const string NAME = to_string(threads) + " thread(s) → " + to_string(RECORDS) + " verdicts in order";
+        if (IS_DONE && output.str() == expected && summary.itsRecords == RECORDS && counted == RECORDS
+            && summary.itsCounts[REPLAY_VALID] < RECORDS && summary.itsCounts[REPLAY_VALID] > 0) {
+            printTestResult(testNum, NAME, true);
+            pass++;
+        } else {
+            printTestResult(testNum, NAME, false, to_string(RECORDS), to_string(summary.itsRecords));
+            failed++;
+        }
+    }
+
+    // Test: an empty input
+    testNum++;
+    stringstream empty("# nothing\n");
+    stringstream emptyOutput;
+    ReplaySummary emptySummary;
+    if (runReplay(empty, emptyOutput, 2, &emptySummary) && emptyOutput.str().empty() && emptySummary.itsRecords == 0) {
+        printTestResult(testNum, "comments only → no verdict", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "comments only → no verdict", false, "0", to_string(emptySummary.itsRecords));
+        failed++;
+    }
+
+    deleteBoard(game.itsBoard);
+    printTestSummary("runReplay", pass, failed);
+}
+
+
+/**
+ * @brief Test function for getBoardAllocationCount.
+ *
+ * This function tests that the steady state allocates no board: self-play games with a pool,
+ * searches with helper threads and games of the server opened and closed many times.
+ */
+void test_getBoardAllocationCount()
+{
+    printTestHeader("getBoardAllocationCount");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test: self-play games with a pool, same games as with allocated boards
+    testNum++;
+    SelfPlaySettings settings;
+    settings.itsMaxPlies = 100;
+    BoardPool pool;
+    createBoardPool(pool, 1);
+    bool same = true;
+    long long allocations = 0;
+    for (int game = 0; game < 20; ++game) {
+        settings.itsSize = (game % 2 == 0) ? LITTLE : BIG;
+        const SelfPlayResult ALLOCATED = playSelfPlayGame(settings, game, nullptr);
+        const long long BEFORE = getBoardAllocationCount();
+        const SelfPlayResult POOLED = playSelfPlayGame(settings, game, nullptr, &pool);
+        allocations += getBoardAllocationCount() - BEFORE;
+        same = same && POOLED.itsPlies == ALLOCATED.itsPlies && POOLED.itsFinalHash == ALLOCATED.itsFinalHash;
+    }
+    if (same && allocations == 0 && pool.itsFreeCount == 1) {
+        printTestResult(testNum, "20 self-play games (both sizes) with a pool → 0 allocation, same games", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "20 self-play games with a pool", false, "0", to_string(allocations));
+        failed++;
+    }
+    deleteBoardPool(pool);
+
+    // Test: searches with helper threads
+    testNum++;
+    AiSearch search;
+    const bool CREATED = createAi(search, 14, 4);
+    const long long BEFORE_SEARCH = getBoardAllocationCount();
+    bool played = CREATED;
+    for (BoardSize size : {LITTLE, BIG, LITTLE}) {
+        Game game;
+        game.itsBoard.itsSize = size;
+        createBoard(game.itsBoard);
+        initializeBoard(game.itsBoard);
+        const long long BEFORE = getBoardAllocationCount();
+        played = played && searchBestMove(game, search, 1000, 2).itsBestMove.itsStartPosition.itsRow != -1;
+        allocations += getBoardAllocationCount() - BEFORE;
+        deleteBoard(game.itsBoard);
+    }
+    if (played && allocations == 0 && getBoardAllocationCount() == BEFORE_SEARCH + 3) {
+        printTestResult(testNum, "3 searches with 4 threads, LITTLE and BIG → 0 allocation by the search", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "3 searches with 4 threads", false, "0", to_string(allocations));
+        failed++;
+    }
+    deleteAi(search);
+
+    // Test: games of the server opened and closed
+    testNum++;
+    GameServer server;
+    createServer(server, 2, 2);
+    const int CONNECTION = openConnection(server, -1);
+    const long long BEFORE_SERVER = getBoardAllocationCount();
+    for (int game = 0; game < 50; ++game) {
+        handleServerLine(server, CONNECTION, (game % 2 == 0) ? "new 11" : "new 13");
+        handleServerLine(server, CONNECTION, "move A5-B5");
+        handleServerLine(server, CONNECTION, "leave");
+        server.itsConnections[CONNECTION].itsOutputLength = 0;
+    }
+    if (server.itsStats.itsMoves == 50 && server.itsStats.itsOpenGames == 0 && getBoardAllocationCount() == BEFORE_SERVER) {
+        printTestResult(testNum, "50 server games opened, played and closed → 0 allocation", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "50 server games", false, "0", to_string(getBoardAllocationCount() - BEFORE_SERVER));
+        failed++;
+    }
+    deleteServer(server);
+
+    printTestSummary("getBoardAllocationCount", pass, failed);
+}
+
+/**
+ * @brief Test function for collectProfile.
+ *
+ * This function tests the names of the instrumented functions, the JSON report, and the calls
+ * counted in two threads: added together with `HNEFATAFL_PROFILE`, all 0 without it.
+ */
+void test_collectProfile()
+{
+    printTestHeader("collectProfile");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test: every function has its own name
+    testNum++;
+    bool namesValid = strcmp(getProfilePointName(PROFILE_POINT_COUNT), "unknown") == 0;
+    for (int point = 0 ; point < PROFILE_POINT_COUNT && namesValid ; point++) {
+        namesValid = strcmp(getProfilePointName(static_cast<ProfilePoint>(point)), "unknown") != 0;
+        for (int other = 0 ; other < point && namesValid ; other++) {
+            namesValid = strcmp(getProfilePointName(static_cast<ProfilePoint>(point)), getProfilePointName(static_cast<ProfilePoint>(other))) != 0;
+        }
+    }
+    if (namesValid) {
+        printTestResult(testNum, "point names → distinct, unknown past the last", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "point names → distinct, unknown past the last", false, "distinct", "duplicate or unknown");
+        failed++;
+    }
+
+    // Test: calls of this thread and of a finished thread are added
+    testNum++;
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(game.itsBoard);
+    const Move MOVE = {{0, 3}, {1, 3}};
+    resetProfile();
+    for (int i = 0 ; i < 3 ; i++) {
+        isValidMovement(game, MOVE);
+    }
+    thread other([&game, &MOVE]() { isValidMovement(game, MOVE); });
+    other.join();
+    const ProfileReport REPORT = collectProfile();
+    const uint64_t EXPECTED = isProfilingEnabled() ? 4 : 0;
+    const uint64_t CALLS = REPORT.itsCounters[PROFILE_VALID_MOVEMENT].itsCalls;
+    if (REPORT.itsIsEnabled == isProfilingEnabled() && CALLS == EXPECTED && REPORT.itsCounters[PROFILE_CAPTURE_PIECES].itsCalls == 0) {
+        printTestResult(testNum, string(isProfilingEnabled() ? "instrumented" : "plain") + " build → "
+                        + to_string(EXPECTED) + " isValidMovement calls", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "isValidMovement calls of two threads", false, to_string(EXPECTED), to_string(CALLS));
+        failed++;
+    }
+
+    // Test: the JSON report has every function and the reset clears the counters
+    testNum++;
+    const string JSON = formatProfileJson(REPORT);
+    bool hasPoints = JSON.find(isProfilingEnabled() ? "\"enabled\":true" : "\"enabled\":false") != string::npos
+                     && JSON.front() == '{' && JSON.back() == '}';
+    for (int point = 0 ; point < PROFILE_POINT_COUNT && hasPoints ; point++) {
+        hasPoints = JSON.find(string("\"") + getProfilePointName(static_cast<ProfilePoint>(point)) + "\":{\"calls\":") != string::npos;
+    }
+    resetProfile();
+    if (hasPoints && collectProfile().itsCounters[PROFILE_VALID_MOVEMENT].itsCalls == 0 && !formatProfileText(REPORT).empty()) {
+        printTestResult(testNum, "JSON → every function, reset → 0 calls", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "JSON → every function, reset → 0 calls", false, "every function", JSON);
+        failed++;
+    }
+
+    db(game.itsBoard.itsCells, LITTLE);
+    printTestSummary("collectProfile", pass, failed);
+}
+
+/**
+ * @brief Test function for runBenchmark.
+ *
+ * This function tests the fixtures of both phases (0 to 4 captures, encircled KING, illegal moves),
+ * one run of every benchmark, and the comparison of the JSON results with a baseline.
+ */
+void test_runBenchmark()
+{
+    printTestHeader("runBenchmark");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string DIRECTORY = (filesystem::temp_directory_path() / "hnefatafl_test_bench").string();
+
+    // Test: fixtures of the opening and of the mid-game
+    testNum++;
+    BenchFixture opening;
+    BenchFixture midgame;
+    const bool IS_CREATED = createBenchFixture(opening, LITTLE, BENCH_OPENING, DIRECTORY)
+                            && createBenchFixture(midgame, LITTLE, BENCH_MIDGAME, DIRECTORY + "_midgame");
+    bool isFixtureValid = IS_CREATED && opening.itsLegalMoves.itsCount > 0 && opening.itsIllegalMoves.itsCount > 0
+                          && isKingCapturedRecursive(opening.itsEncircled.itsBoard)
+                          && !isKingCapturedRecursive(opening.itsGame.itsBoard)
+                          && midgame.itsGame.itsBoard.itsHash != opening.itsGame.itsBoard.itsHash;
+    for (int move = 0 ; isFixtureValid && move < opening.itsIllegalMoves.itsCount ; move++) {
+        isFixtureValid = !isValidMovement(opening.itsGame, opening.itsIllegalMoves.itsMoves[move]);
+    }
+    if (isFixtureValid) {
+        printTestResult(testNum, "fixtures → legal and illegal moves, encircled KING, mid-game position", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "fixtures → legal and illegal moves, encircled KING, mid-game position", false, "valid", "invalid");
+        failed++;
+    }
+
+    // Test: every benchmark runs, the capture benchmarks capture 0 to 4 pieces
+    testNum++;
+    int caseCount = 0;
+    const BenchCase* cases = getBenchCases(caseCount);
+    vector<BenchResult> results;
+    bool isRunValid = IS_CREATED;
+    for (int index = 0 ; isRunValid && index < caseCount ; index++) {
+        const BenchResult RESULT = runBenchmark(cases[index], opening, 0);
+        isRunValid = RESULT.itsIterations == 1 && RESULT.itsName == getBenchName(cases[index], opening);
+        if (cases[index].itsFunction == cases[4].itsFunction) {
+            //the benchmark counts its iterations, the captures are checked on its scratch game
+            isRunValid = isRunValid && cases[index].itsFunction(opening, cases[index].itsArgument, 1) == 1;
+            copyBoard(opening.itsCaptures[cases[index].itsArgument].itsBoard, opening.itsScratch.itsBoard);
+            isRunValid = isRunValid && countWordBits(static_cast<uint64_t>(capturePieces(opening.itsScratch, opening.itsCaptureMove)))
+                                       == cases[index].itsArgument;
+        }
+        results.push_back(RESULT);
+    }
+    if (isRunValid && caseCount > 4 && strcmp(cases[4].itsName, "capturePieces/0") == 0) {
+        printTestResult(testNum, to_string(caseCount) + " benchmarks → 1 iteration each, 0 to 4 captures", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "one run of every benchmark", false, "valid", "invalid");
+        failed++;
+    }
+
+    // Test: JSON round trip, a slower benchmark is reported
+    testNum++;
+    const string JSON = formatBenchmarkJson(results.data(), static_cast<int>(results.size()));
+    string sameOutput;
+    const int SAME = compareBenchmarks(results.data(), static_cast<int>(results.size()), JSON, 0.1, sameOutput);
+    vector<BenchResult> slower = results;
+    if (!slower.empty()) {
+        slower[0].itsRealNs = results[0].itsRealNs * 2 + 1;
+    }
+    string slowerOutput;
+    const int SLOWER = compareBenchmarks(slower.data(), static_cast<int>(slower.size()), JSON, 0.1, slowerOutput);
+    if (!results.empty() && SAME == 0 && SLOWER == 1 && slowerOutput.find("SLOWER") != string::npos
+        && JSON.find("\"benchmarks\": [") != string::npos) {
+        printTestResult(testNum, "baseline of the same run → 0 slower, doubled time → 1 slower", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "comparison with a baseline", false, "0 and 1", to_string(SAME) + " and " + to_string(SLOWER));
+        failed++;
+    }
+
+    deleteBenchFixture(opening);
+    deleteBenchFixture(midgame);
+    printTestSummary("runBenchmark", pass, failed);
+}
+
+/**
+ * @brief Test function for encodeSave.
+ *
+ * This function tests the encodeSave function: the header fields, the 2 bits per cell packing,
+ * the size of the record and the truncation of long names.
+ */
+void test_encodeSave()
+{
+    printTestHeader("encodeSave");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Test: size of the record
+    testNum++;
+    if (sizeof(SaveRecord) == 118 && SAVE_BOARD_BYTES == 43) {
+        printTestResult(testNum, "record of 118 bytes, board packed in 43 bytes", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "record of 118 bytes, board packed in 43 bytes", false, "118 / 43",
+                        to_string(sizeof(SaveRecord)) + " / " + to_string(SAVE_BOARD_BYTES));
+        failed++;
+    }
+
+    // Tests: header and packed cells of the starting boards
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        game.itsPlayer1.itsName = "Alice";
+        game.itsPlayer2.itsIsComputer = true;
+        game.itsCurrentPlayer = &game.itsPlayer2;
+        const SaveRecord RECORD = encodeSave(game);
+        bool ok = memcmp(RECORD.itsMagic, SAVE_MAGIC, 4) == 0 && RECORD.itsVersion == SAVE_VERSION
+                  && RECORD.itsSize == size && RECORD.itsCurrentPlayer == 2
+                  && RECORD.itsPlayerRoles[0] == ATTACK && RECORD.itsPlayerRoles[1] == DEFENSE
+                  && RECORD.itsIsComputer[0] == 0 && RECORD.itsIsComputer[1] == 1
+                  && string(RECORD.itsNames[0]) == "Alice" && string(RECORD.itsNames[1]) == "Player 2";
+        for (int row = 0; row < size; ++row) {
+            for (int col = 0; col < size; ++col) {
+                const int INDEX = row * size + col;
+                ok = ok && ((RECORD.itsCells[INDEX / 4] >> (2 * (INDEX % 4))) & 3) == game.itsBoard.itsCells[row][col].itsPieceType;
+            }
+        }
+        if (ok) {
+            printTestResult(testNum, sizeName + " - header and 2 bits per cell", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - header and 2 bits per cell", false, "same game", "different");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+    }
+
+    // Test: a long name is cut and stays 0 terminated
+    testNum++;
+    {
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        initializeBoard(game.itsBoard);
+        game.itsPlayer1.itsName = string(100, 'x');
+        const SaveRecord RECORD = encodeSave(game);
+        if (string(RECORD.itsNames[0]) == string(SAVE_NAME_LENGTH - 1, 'x')) {
+            printTestResult(testNum, "100 characters name → cut to " + to_string(SAVE_NAME_LENGTH - 1), true);
+            pass++;
+        } else {
+            printTestResult(testNum, "100 characters name → cut to " + to_string(SAVE_NAME_LENGTH - 1), false,
+                            to_string(SAVE_NAME_LENGTH - 1), to_string(string(RECORD.itsNames[0]).size()));
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+
+    printTestSummary("encodeSave", pass, failed);
+}
+
+/**
+ * @brief Test function for decodeSave.
+ *
+ * This function tests the decodeSave function: a game played for a few moves is rebuilt exactly
+ * from its record, and corrupted records are rejected without modifying the game.
+ */
+void test_decodeSave()
+{
+    printTestHeader("decodeSave");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Tests: round trip of a played game
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        game.itsPlayer1.itsName = "Attacker";
+        game.itsPlayer2.itsName = "Defender";
+        game.itsPlayer1.itsIsComputer = true;
+        MoveList list;
+        unsigned int seed = 99u + size;
+        for (int ply = 0; ply < 31 && generateMoves(game, list) > 0; ++ply) {
+            seed = seed * 1103515245u + 12345u;
+            makeMove(game, list.itsMoves[(seed >> 16) % list.itsCount]);
+        }
+        Game loaded;
+        bool ok = decodeSave(encodeSave(game), loaded) && loaded.itsBoard.itsSize == size
+                  && loaded.itsBoard.itsHash == game.itsBoard.itsHash && loaded.itsBoard.itsHasBitboards
+                  && loaded.itsCurrentPlayer == &loaded.itsPlayer2 && loaded.itsPlayer1.itsIsComputer
+                  && loaded.itsPlayer1.itsName == "Attacker" && loaded.itsPlayer2.itsName == "Defender";
+        for (int row = 0; row < size && ok; ++row) {
+            for (int col = 0; col < size; ++col) {
+                ok = ok && loaded.itsBoard.itsCells[row][col].itsPieceType == game.itsBoard.itsCells[row][col].itsPieceType
+                        && loaded.itsBoard.itsCells[row][col].itsCellType == game.itsBoard.itsCells[row][col].itsCellType;
+            }
+        }
+        if (ok) {
+            printTestResult(testNum, sizeName + " - played game → same cells, players and key", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - played game → same cells, players and key", false, "same game", "different");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+        deleteBoard(loaded.itsBoard);
+    }
+
+    // Tests: corrupted records
+    struct TestCase {
+        function<void(SaveRecord& record)> corrupt;
+        string description;
+    };
+    TestCase cases[] = {
+        {[](SaveRecord& record) { record.itsMagic[0] = 'X'; }, "wrong magic → rejected"},
+        {[](SaveRecord& record) { record.itsVersion = SAVE_VERSION + 1; }, "unknown version → rejected"},
+        {[](SaveRecord& record) { record.itsSize = 12; }, "size 12 → rejected"},
+        {[](SaveRecord& record) { record.itsCurrentPlayer = 3; }, "current player 3 → rejected"},
+        {[](SaveRecord& record) { record.itsPlayerRoles[1] = ATTACK; }, "two attackers → rejected"},
+        {[](SaveRecord& record) { record.itsNames[0][SAVE_NAME_LENGTH - 1] = 'x'; }, "name not terminated → rejected"},
+        {[](SaveRecord& record) { record.itsCells[LITTLE * LITTLE / 4] |= 1 << 6; }, "bits after the last cell → rejected"},
+        {[](SaveRecord& record) { record.itsCells[0] |= KING; }, "second KING → rejected"},
+        {[](SaveRecord& record) { record.itsCells[0] |= SWORD; }, "SWORD on a FORTRESS → rejected"},
+    };
+    for (const TestCase& tc : cases) {
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        initializeBoard(game.itsBoard);
+        SaveRecord record = encodeSave(game);
+        tc.corrupt(record);
+        Game loaded;
+        loaded.itsPlayer1.itsName = "unchanged";
+        const bool DECODED = decodeSave(record, loaded);
+        if (!DECODED && loaded.itsBoard.itsCells == nullptr && loaded.itsPlayer1.itsName == "unchanged") {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, "rejected", "accepted");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, LITTLE);
+        deleteBoard(loaded.itsBoard);
+    }
+
+    printTestSummary("decodeSave", pass, failed);
+}
+
+/**
+ * @brief Test function for importTextSave.
+ *
+ * This function tests the legacy text import: the multi-byte `☒` glyph counts as one cell,
+ * the special cells are rebuilt on both sizes and truncated or invalid texts are rejected.
+ */
+void test_importTextSave()
+{
+    printTestHeader("importTextSave");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+
+    // Writes a board in the legacy format (same glyphs as the old updateSave)
+    auto legacyText = [](const Game& aGame) {
+        string text = aGame.itsPlayer1.itsName + "\n" + aGame.itsPlayer2.itsName + "\n"
+                      + to_string(aGame.itsCurrentPlayer->itsRole) + "\n" + to_string(aGame.itsBoard.itsSize) + "\n";
+        for (int row = 0; row < aGame.itsBoard.itsSize; ++row) {
+            for (int col = 0; col < aGame.itsBoard.itsSize; ++col) {
+                const PieceType PIECE = aGame.itsBoard.itsCells[row][col].itsPieceType;
+                text += (PIECE == NONE) ? "☒" : (PIECE == SWORD) ? "S" : (PIECE == KING) ? "K" : "s";
+            }
+            text += "\n";
+        }
+        return text;
+    };
+
+    // Tests: starting boards
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        Game loaded;
+        bool ok = importTextSave(legacyText(game), loaded) && loaded.itsBoard.itsSize == size
+                  && loaded.itsBoard.itsHash == game.itsBoard.itsHash && loaded.itsCurrentPlayer == &loaded.itsPlayer1
+                  && loaded.itsPlayer2.itsName == "Player 2";
+        for (int row = 0; row < size && ok; ++row) {
+            for (int col = 0; col < size; ++col) {
+                ok = ok && loaded.itsBoard.itsCells[row][col].itsPieceType == game.itsBoard.itsCells[row][col].itsPieceType
+                        && loaded.itsBoard.itsCells[row][col].itsCellType == game.itsBoard.itsCells[row][col].itsCellType;
+            }
+        }
+        if (ok) {
+            printTestResult(testNum, sizeName + " - legacy text with ☒ glyphs → same board and cell types", true);
+            pass++;
+        } else {
+            printTestResult(testNum, sizeName + " - legacy text with ☒ glyphs → same board and cell types", false, "same board", "different");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+        deleteBoard(loaded.itsBoard);
+    }
+
+    // Tests: invalid texts
+    Game reference;
+    reference.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(reference.itsBoard);
+    const string VALID = legacyText(reference);
+    const size_t BOARD_START = VALID.find("11\n") + 3;
+    struct TestCase {
+        string text;
+        string description;
+    };
+    TestCase cases[] = {
+        {VALID.substr(0, VALID.size() - 40), "truncated board → rejected"},
+        {"a\nb\n0\n12\n" + VALID.substr(BOARD_START), "size 12 → rejected"},
+        {"a\nb\n5\n11\n" + VALID.substr(BOARD_START), "current role 5 → rejected"},
+        // the second cell of the first row (a 3 bytes ☒) becomes a second KING
+        {VALID.substr(0, BOARD_START + 3) + "K" + VALID.substr(BOARD_START + 6), "second KING → rejected"},
+        {"a\nb", "no board → rejected"},
+    };
+    for (const TestCase& tc : cases) {
+        testNum++;
+        Game loaded;
+        if (!importTextSave(tc.text, loaded) && loaded.itsBoard.itsCells == nullptr) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, "rejected", "accepted");
+            failed++;
+        }
+        deleteBoard(loaded.itsBoard);
+    }
+    db(reference.itsBoard.itsCells, LITTLE);
+
+    printTestSummary("importTextSave", pass, failed);
+}
+
+/**
+ * @brief Reads a whole file into a string (empty if the file can't be read).
+ */
+static string readWholeFile(const string& aPath) {
+    ifstream file(aPath, ios::binary);
+    return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Test function for appendJournal.
+ *
+ * This function tests the journal writer: the header is written by openJournal, each move adds
+ * 4 bytes, the buffer is only written every itsFlushInterval moves and closeJournal writes the rest.
+ */
+void test_appendJournal()
+{
+    printTestHeader("appendJournal");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_append.journal").string();
+
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(game.itsBoard);
+    MoveList list;
+    generateMoves(game, list);
+    const Move MOVE = list.itsMoves[0];
+
+    // Test: header only after openJournal
+    testNum++;
+    MoveJournal journal;
+    const bool OPENED = openJournal(journal, PATH, game);
+    if (OPENED && readWholeFile(PATH).size() == sizeof(SaveRecord)) {
+        printTestResult(testNum, "openJournal → file holds the header only", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "openJournal → file holds the header only", false, to_string(sizeof(SaveRecord)),
+                        to_string(readWholeFile(PATH).size()));
+        failed++;
+    }
+
+    // Test: every move is written with the default policy
+    testNum++;
+    appendJournal(journal, MOVE);
+    const string CONTENT = readWholeFile(PATH);
+    const unsigned char* record = reinterpret_cast<const unsigned char*>(CONTENT.data()) + sizeof(SaveRecord);
+    if (CONTENT.size() == sizeof(SaveRecord) + 4 && record[0] == MOVE.itsStartPosition.itsRow && record[1] == MOVE.itsStartPosition.itsCol
+        && record[2] == MOVE.itsEndPosition.itsRow && record[3] == MOVE.itsEndPosition.itsCol && journal.itsPlies == 1) {
+        printTestResult(testNum, "default policy → 4 bytes written per move", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "default policy → 4 bytes written per move", false, to_string(sizeof(SaveRecord) + 4),
+                        to_string(CONTENT.size()));
+        failed++;
+    }
+    closeJournal(journal);
+
+    // Test: buffered policy, moves written every 8 moves and on close
+    testNum++;
+    JournalPolicy policy;
+    policy.itsFlushInterval = 8;
+    policy.itsIsSyncing = false;
+    openJournal(journal, PATH, game, policy);
+    for (int i = 0; i < 7; ++i) {
+        appendJournal(journal, MOVE);
+    }
+    const size_t BUFFERED = readWholeFile(PATH).size();
+    appendJournal(journal, MOVE);
+    const size_t FLUSHED = readWholeFile(PATH).size();
+    appendJournal(journal, MOVE);
+    closeJournal(journal);
+    const size_t CLOSED = readWholeFile(PATH).size();
+    if (BUFFERED == sizeof(SaveRecord) && FLUSHED == sizeof(SaveRecord) + 32 && CLOSED == sizeof(SaveRecord) + 36
+        && journal.itsFile == nullptr) {
+        printTestResult(testNum, "flush interval 8 → nothing written for 7 moves, 8 at the 8th, the rest on close", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "flush interval 8 → nothing written for 7 moves, 8 at the 8th, the rest on close", false,
+                        "118 / 150 / 154", to_string(BUFFERED) + " / " + to_string(FLUSHED) + " / " + to_string(CLOSED));
+        failed++;
+    }
+
+    // Test: a closed journal refuses moves
+    testNum++;
+    if (!appendJournal(journal, MOVE) && closeJournal(journal)) {
+        printTestResult(testNum, "closed journal → appendJournal fails, closeJournal is harmless", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "closed journal → appendJournal fails, closeJournal is harmless", false, "false", "true");
+        failed++;
+    }
+
+    filesystem::remove(PATH);
+    db(game.itsBoard.itsCells, LITTLE);
+    printTestSummary("appendJournal", pass, failed);
+}
+
+/**
+ * @brief Test function for replayJournal.
+ *
+ * This function tests the journal replay: games written move by move (and resumed in the middle)
+ * are rebuilt exactly, an interrupted last record is ignored and illegal moves are rejected.
+ */
+void test_replayJournal()
+{
+    printTestHeader("replayJournal");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_replay.journal").string();
+
+    // Tests: random games written in two sessions (resumeJournal in the middle)
+    for (BoardSize size : {LITTLE, BIG}) {
+        const string sizeName = (size == LITTLE) ? "LITTLE" : "BIG";
+        testNum++;
+        Game game;
+        game.itsBoard = {cb(size), size};
+        initializeBoard(game.itsBoard);
+        MoveJournal journal;
+        bool written = openJournal(journal, PATH, game);
+        MoveList list;
+        unsigned int seed = 4242u + size;
+        int played = 0;
+        while (played < 120 && !isGameFinished(game) && generateMoves(game, list) > 0) {
+            if (played == 60) {
+                written = written && closeJournal(journal) && resumeJournal(journal, PATH) && journal.itsPlies == 60;
+            }
+            seed = seed * 1103515245u + 12345u;
+            const Move MOVE = list.itsMoves[(seed >> 16) % list.itsCount];
+            makeMove(game, MOVE);
+            written = written && appendJournal(journal, MOVE);
+            played++;
+        }
+        written = closeJournal(journal) && written;
+        Game replayed;
+        int plies = -1;
+        const bool OK = written && replayJournal(readWholeFile(PATH), replayed, &plies) && plies == played
+                        && replayed.itsBoard.itsHash == game.itsBoard.itsHash
+                        && (replayed.itsCurrentPlayer == &replayed.itsPlayer2) == (game.itsCurrentPlayer == &game.itsPlayer2);
+        const string description = sizeName + " - " + to_string(played) + " moves in 2 sessions → same position";
+        if (OK) {
+            printTestResult(testNum, description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, description, false, to_string(played) + " plies", to_string(plies) + " plies");
+            failed++;
+        }
+        db(game.itsBoard.itsCells, size);
+        deleteBoard(replayed.itsBoard);
+    }
+
+    Game game;
+    game.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(game.itsBoard);
+    MoveList list;
+    generateMoves(game, list);
+
+    // Test: an interrupted last record is ignored by the replay and removed by resumeJournal
+    testNum++;
+    {
+        MoveJournal journal;
+        openJournal(journal, PATH, game);
+        appendJournal(journal, list.itsMoves[0]);
+        closeJournal(journal);
+        ofstream(PATH, ios::binary | ios::app) << "\x01\x02";
+        Game replayed;
+        int plies = -1;
+        const bool REPLAYED = replayJournal(readWholeFile(PATH), replayed, &plies) && plies == 1;
+        const bool RESUMED = resumeJournal(journal, PATH) && journal.itsPlies == 1 && closeJournal(journal)
+                             && readWholeFile(PATH).size() == sizeof(SaveRecord) + 4;
+        if (REPLAYED && RESUMED) {
+            printTestResult(testNum, "2 bytes of an interrupted record → ignored, then removed", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "2 bytes of an interrupted record → ignored, then removed", false, "1 ply", to_string(plies) + " plies");
+            failed++;
+        }
+        deleteBoard(replayed.itsBoard);
+    }
+
+    // Tests: invalid journals
+    string valid;
+    {
+        MoveJournal journal;
+        openJournal(journal, PATH, game);
+        closeJournal(journal);
+        valid = readWholeFile(PATH);
+    }
+    struct TestCase {
+        string content;
+        string description;
+    };
+    TestCase cases[] = {
+        {valid + string("\x05\x05\x05\x07", 4), "move of the KING by ATTACK → rejected"},
+        {valid + string("\x00\x03\x00\x00", 4), "SWORD to a FORTRESS → rejected"},
+        {valid + string("\x0f\x03\x0f\x04", 4), "out of the board → rejected"},
+        {valid.substr(0, 100), "truncated header → rejected"},
+        {"legacy\ntext\n0\n11\n", "text save → rejected"},
+    };
+    for (const TestCase& tc : cases) {
+        testNum++;
+        Game replayed;
+        if (!replayJournal(tc.content, replayed)) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, "rejected", "accepted");
+            failed++;
+        }
+        deleteBoard(replayed.itsBoard);
+    }
+
+    filesystem::remove(PATH);
+    db(game.itsBoard.itsCells, LITTLE);
+    printTestSummary("replayJournal", pass, failed);
+}
+
+/**
+ * @brief Plays a random game from the starting position (fixed seed) and keeps its moves.
+ *
+ * @param aSize The size of the board.
+ * @param aSeed The seed of the random moves.
+ * @param aMoves Receives the moves (at least `aMaxPlies` moves).
+ * @param aMaxPlies Maximum number of moves.
+ * @param aGame Receives the final position (its board must be allocated with the size).
+ * @return The number of moves played.
+ */
+static int playRandomDatabaseGame(BoardSize aSize, unsigned int aSeed, Move* aMoves, int aMaxPlies, Game& aGame)
+{
+    aGame.itsBoard.itsSize = aSize;
+    initializeBoard(aGame.itsBoard);
+    aGame.itsCurrentPlayer = &aGame.itsPlayer1;
+    MoveList list;
+    int played = 0;
+    while (played < aMaxPlies && !isGameFinished(aGame) && generateMoves(aGame, list) > 0) {
+        aSeed = aSeed * 1103515245u + 12345u;
+        aMoves[played] = list.itsMoves[(aSeed >> 16) % list.itsCount];
+        makeMove(aGame, aMoves[played]);
+        played++;
+    }
+    return played;
+}
+
+/**
+ * @brief Test function for addDatabaseGame.
+ *
+ * This function tests the database writer and reader: random games of both sizes are replayed
+ * from the mapping to the same positions, illegal games are refused and corrupted files are rejected.
+ */
+void test_addDatabaseGame()
+{
+    printTestHeader("addDatabaseGame");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_add.gamedb").string();
+    const int MAX_PLIES = 1000;
+    Move* moves = new Move[MAX_PLIES];
+
+    // Tests: random games of both sizes replayed from the mapping
+    const int GAMES = 6;
+    unsigned long long hashes[GAMES];
+    unsigned char winners[GAMES];
+    bool written = false;
+    {
+        GameDbWriter writer;
+        written = createGameDatabase(writer, PATH);
+        for (int i = 0; i < GAMES; ++i) {
+            const BoardSize SIZE = (i % 2 == 0) ? LITTLE : BIG;
+            Game game;
+            game.itsBoard = {cb(SIZE), SIZE};
+            const int PLIES = playRandomDatabaseGame(SIZE, 777u + i, moves, MAX_PLIES, game);
+            hashes[i] = game.itsBoard.itsHash;
+            const GameStatus STATUS = getGameStatus(game.itsBoard);
+            winners[i] = (STATUS == IN_PROGRESS) ? GAMEDB_NO_WINNER : (STATUS == KING_CAPTURED) ? ATTACK : DEFENSE;
+            written = addDatabaseGame(writer, SIZE, moves, PLIES) && written;
+            db(game.itsBoard.itsCells, SIZE);
+        }
+        written = closeGameDatabase(writer) && written;
+    }
+    GameDatabase database;
+    const bool OPENED = written && openGameDatabase(database, PATH) && database.itsGameCount == GAMES;
+    for (int i = 0; i < GAMES; ++i) {
+        testNum++;
+        const string sizeName = (i % 2 == 0) ? "LITTLE" : "BIG";
+        Game replayed;
+        const bool OK = OPENED && replayDatabaseGame(database, i, replayed) && replayed.itsBoard.itsHash == hashes[i]
+                        && database.itsEntries[i].itsWinner == winners[i];
+        const string description = sizeName + " - game " + to_string(i) + " replayed from the mapping → same position and winner";
+        if (OK) {
+            printTestResult(testNum, description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, description, false, "same position", "different");
+            failed++;
+        }
+        deleteBoard(replayed.itsBoard);
+    }
+
+    // Test: an index out of range is refused
+    testNum++;
+    {
+        Game replayed;
+        if (OPENED && !replayDatabaseGame(database, GAMES, replayed)) {
+            printTestResult(testNum, "index after the last game → refused", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "index after the last game → refused", false, "false", "true");
+            failed++;
+        }
+        deleteBoard(replayed.itsBoard);
+    }
+    closeGameDatabase(database);
+
+    // Tests: illegal games are refused and not indexed
+    {
+        const Move KING_MOVE = {{5, 5}, {5, 7}};
+        const Move OUT_MOVE = {{0, 3}, {-1, 3}};
+        struct TestCase {
+            Move move;
+            string description;
+        };
+        TestCase cases[] = {
+            {KING_MOVE, "move of the KING by ATTACK → refused"},
+            {OUT_MOVE, "move out of the board → refused"},
+        };
+        for (const TestCase& tc : cases) {
+            testNum++;
+            GameDbWriter writer;
+            createGameDatabase(writer, PATH);
+            const bool ADDED = addDatabaseGame(writer, LITTLE, &tc.move, 1);
+            const uint64_t COUNT = writer.itsCount;
+            closeGameDatabase(writer);
+            if (!ADDED && COUNT == 0) {
+                printTestResult(testNum, tc.description, true);
+                pass++;
+            } else {
+                printTestResult(testNum, tc.description, false, "refused", "added");
+                failed++;
+            }
+        }
+    }
+
+    // Test: an empty database can be opened
+    testNum++;
+    {
+        GameDbWriter writer;
+        const bool CREATED = createGameDatabase(writer, PATH) && closeGameDatabase(writer);
+        GameDatabase empty;
+        const bool OK = CREATED && openGameDatabase(empty, PATH) && empty.itsGameCount == 0;
+        closeGameDatabase(empty);
+        if (OK) {
+            printTestResult(testNum, "database without games → opened, 0 games", true);
+            pass++;
+        } else {
+            printTestResult(testNum, "database without games → opened, 0 games", false, "0 games", "not opened");
+            failed++;
+        }
+    }
+
+    // Tests: corrupted databases are rejected
+    {
+        GameDbWriter writer;
+        createGameDatabase(writer, PATH);
+        const int PLIES = 2;
+        Game game;
+        game.itsBoard = {cb(LITTLE), LITTLE};
+        playRandomDatabaseGame(LITTLE, 1u, moves, PLIES, game);
+        addDatabaseGame(writer, LITTLE, moves, PLIES);
+        closeGameDatabase(writer);
+        db(game.itsBoard.itsCells, LITTLE);
+    }
+    const string VALID = readWholeFile(PATH);
+    GameDbHeader header;
+    memcpy(&header, VALID.data(), sizeof(header));
+    const size_t ENTRY = static_cast<size_t>(header.itsIndexOffset);
+    string badMagic = VALID;
+    badMagic[0] = 'X';
+    string badOffset = VALID;
+    badOffset[ENTRY] = static_cast<char>(0xff);
+    string badPlies = VALID;
+    badPlies[ENTRY + 8] = static_cast<char>(0x7f);
+    string badSize = VALID;
+    badSize[ENTRY + 12] = 12;
+    struct FileCase {
+        string content;
+        string description;
+    };
+    FileCase fileCases[] = {
+        {badMagic, "wrong magic → rejected"},
+        {VALID.substr(0, VALID.size() - 1), "truncated index → rejected"},
+        {badOffset, "moves after the end of the file → rejected"},
+        {badPlies, "too many moves for the file → rejected"},
+        {badSize, "board size 12 → rejected"},
+        {"", "empty file → rejected"},
+    };
+    for (const FileCase& tc : fileCases) {
+        testNum++;
+        ofstream(PATH, ios::binary | ios::trunc) << tc.content;
+        GameDatabase corrupted;
+        const bool OPENED_CORRUPTED = openGameDatabase(corrupted, PATH);
+        closeGameDatabase(corrupted);
+        if (!OPENED_CORRUPTED && corrupted.itsData == nullptr) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, "rejected", "opened");
+            failed++;
+        }
+    }
+
+    filesystem::remove(PATH);
+    delete[] moves;
+    printTestSummary("addDatabaseGame", pass, failed);
+}
+
+/**
+ * @brief Test function for computeDatabaseStats.
+ *
+ * This function tests the parallel replay of a database: the statistics are the same with
+ * 1 thread, 4 threads and all the cores, a wrong winner in the index is detected and the
+ * opening statistics count the games starting with a move.
+ */
+void test_computeDatabaseStats()
+{
+    printTestHeader("computeDatabaseStats");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const string PATH = (filesystem::temp_directory_path() / "hnefatafl_test_stats.gamedb").string();
+    const int MAX_PLIES = 1000;
+    Move* moves = new Move[MAX_PLIES];
+
+    // build 150 random games (more than two blocks of the workers), with the expected statistics
+    const int GAMES = 150;
+    GameDbStats expected;
+    Move opening = {{0, 0}, {0, 0}};
+    OpeningStats expectedOpening;
+    GameDbWriter writer;
+    bool written = createGameDatabase(writer, PATH);
+    for (int i = 0; i < GAMES; ++i) {
+        const BoardSize SIZE = (i % 3 == 0) ? BIG : LITTLE;
+        Game game;
+        game.itsBoard = {cb(SIZE), SIZE};
+        const int PLIES = playRandomDatabaseGame(SIZE, 31u * i + 5u, moves, MAX_PLIES, game);
+        const GameStatus STATUS = getGameStatus(game.itsBoard);
+        const int WINNER = (STATUS == IN_PROGRESS) ? GAMEDB_NO_WINNER : (STATUS == KING_CAPTURED) ? ATTACK : DEFENSE;
+        expected.itsGames[SIZE == BIG]++;
+        expected.itsPlies[SIZE == BIG] += PLIES;
+        expected.itsWins[SIZE == BIG][WINNER]++;
+        if (i == 1) {
+            opening = moves[0];
+        }
+        if (SIZE == LITTLE && PLIES > 0 && moves[0].itsStartPosition.itsRow == opening.itsStartPosition.itsRow
+            && moves[0].itsStartPosition.itsCol == opening.itsStartPosition.itsCol
+            && moves[0].itsEndPosition.itsRow == opening.itsEndPosition.itsRow && moves[0].itsEndPosition.itsCol == opening.itsEndPosition.itsCol) {
+            expectedOpening.itsGames++;
+            expectedOpening.itsAttackWins += WINNER == ATTACK;
+            expectedOpening.itsDefenseWins += WINNER == DEFENSE;
+        }
+        written = addDatabaseGame(writer, SIZE, moves, PLIES) && written;
+        db(game.itsBoard.itsCells, SIZE);
+    }
+    written = closeGameDatabase(writer) && written;
+
+    // Tests: same statistics whatever the number of threads
+    GameDatabase database;
+    const bool OPENED = written && openGameDatabase(database, PATH);
+    for (int threads : {1, 4, AI_ALL_CORES}) {
+        testNum++;
+        const GameDbStats STATS = OPENED ? computeDatabaseStats(database, threads) : GameDbStats();
+        bool same = STATS.itsReplayErrors == 0;
+        for (int size = 0; size < 2; ++size) {
+            same = same && STATS.itsGames[size] == expected.itsGames[size] && STATS.itsPlies[size] == expected.itsPlies[size];
+            for (int winner = 0; winner < 3; ++winner) {
+                same = same && STATS.itsWins[size][winner] == expected.itsWins[size][winner];
+            }
+        }
+        const string description = (threads == AI_ALL_CORES ? string("all cores") : to_string(threads) + " thread(s)")
+                                   + " → same counts as the written games, no replay error";
+        if (same) {
+            printTestResult(testNum, description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, description, false, to_string(expected.itsGames[0] + expected.itsGames[1]) + " games",
+                            to_string(STATS.itsGames[0] + STATS.itsGames[1]) + " games, "
+                            + to_string(STATS.itsReplayErrors) + " errors");
+            failed++;
+        }
+    }
+
+    // Test: results by opening move
+    testNum++;
+    const OpeningStats OPENING = getOpeningStats(database, LITTLE, opening);
+    if (OPENED && OPENING.itsGames == expectedOpening.itsGames && OPENING.itsGames > 0
+        && OPENING.itsAttackWins == expectedOpening.itsAttackWins && OPENING.itsDefenseWins == expectedOpening.itsDefenseWins) {
+        printTestResult(testNum, "LITTLE opening of game 1 → " + to_string(expectedOpening.itsGames) + " games", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "LITTLE opening of game 1 → " + to_string(expectedOpening.itsGames) + " games", false,
+                        to_string(expectedOpening.itsGames), to_string(OPENING.itsGames));
+        failed++;
+    }
+    closeGameDatabase(database);
+
+    // Test: a winner changed in the index is found by the replay
+    testNum++;
+    string content = readWholeFile(PATH);
+    GameDbHeader header;
+    memcpy(&header, content.data(), sizeof(header));
+    const size_t WINNER = static_cast<size_t>(header.itsIndexOffset) + 13;
+    content[WINNER] = static_cast<char>(content[WINNER] == ATTACK ? DEFENSE : ATTACK);
+    ofstream(PATH, ios::binary | ios::trunc) << content;
+    const bool REOPENED = openGameDatabase(database, PATH);
+    const GameDbStats CHANGED = REOPENED ? computeDatabaseStats(database, 4) : GameDbStats();
+    closeGameDatabase(database);
+    if (REOPENED && CHANGED.itsReplayErrors == 1) {
+        printTestResult(testNum, "winner of game 0 changed in the index → 1 replay error", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "winner of game 0 changed in the index → 1 replay error", false, "1", to_string(CHANGED.itsReplayErrors));
+        failed++;
+    }
+
+    filesystem::remove(PATH);
+    delete[] moves;
+    printTestSummary("computeDatabaseStats", pass, failed);
+}
+
+/**
+ * @brief Test function for recordSave.
+ *
+ * This function tests the save index in memory and on disk: saves are kept sorted and found
+ * without scanning the folder, there is no limit on their number, each change replaces the
+ * index file and invalid names are refused.
+ */
+void test_recordSave()
+{
+    printTestHeader("recordSave");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const filesystem::path DIRECTORY = filesystem::temp_directory_path() / "hnefatafl_test_record";
+    filesystem::remove_all(DIRECTORY);
+
+    // Test: a new folder gets an empty index
+    testNum++;
+    SaveIndex saves;
+    const bool LOADED = loadSaveIndex(saves, DIRECTORY.string());
+    if (LOADED && saves.itsCount == 0 && filesystem::exists(DIRECTORY / SAVE_INDEX_FILE)) {
+        printTestResult(testNum, "new folder → created with an empty index file", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "new folder → created with an empty index file", false, "0 saves", to_string(saves.itsCount) + " saves");
+        failed++;
+    }
+
+    // Test: more saves than the old limit of 5, kept sorted by name
+    testNum++;
+    const int SAVES = 200;
+    bool recorded = true;
+    for (int i = 0; i < SAVES; ++i) {
+        //names added in a shuffled order
+        const int NUMBER = (i * 73) % SAVES;
+        recorded = recordSave(saves, "game" + to_string(1000 + NUMBER), (NUMBER % 2 == 0) ? LITTLE : BIG, NUMBER) && recorded;
+    }
+    bool sorted = true;
+    for (int i = 1; i < saves.itsCount; ++i) {
+        sorted = sorted && strcmp(saves.itsEntries[i - 1].itsName, saves.itsEntries[i].itsName) < 0;
+    }
+    if (recorded && saves.itsCount == SAVES && sorted) {
+        printTestResult(testNum, to_string(SAVES) + " saves → all recorded, sorted by name", true);
+        pass++;
+    } else {
+        printTestResult(testNum, to_string(SAVES) + " saves → all recorded, sorted by name", false, to_string(SAVES),
+                        to_string(saves.itsCount));
+        failed++;
+    }
+
+    // Test: lookup of a save and of an unknown name
+    testNum++;
+    const int FOUND = findSave(saves, "game1042");
+    const bool OK_FOUND = FOUND != -1 && saves.itsEntries[FOUND].itsPlies == 42 && saves.itsEntries[FOUND].itsSize == LITTLE
+                          && saves.itsEntries[FOUND].itsOffset == sizeof(SaveRecord) + 42 * sizeof(MoveRecord)
+                          && findSave(saves, "game42") == -1 && findSave(saves, "") == -1;
+    if (OK_FOUND) {
+        printTestResult(testNum, "findSave → game1042 found with its size, plies and offset, unknown names not found", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "findSave → game1042 found with its size, plies and offset, unknown names not found", false,
+                        "found", to_string(FOUND));
+        failed++;
+    }
+
+    // Test: updating a save replaces its entry
+    testNum++;
+    const bool UPDATED = recordSave(saves, "game1042", BIG, 50);
+    const int UPDATED_POSITION = findSave(saves, "game1042");
+    if (UPDATED && saves.itsCount == SAVES && UPDATED_POSITION != -1 && saves.itsEntries[UPDATED_POSITION].itsPlies == 50
+        && saves.itsEntries[UPDATED_POSITION].itsSize == BIG) {
+        printTestResult(testNum, "second recordSave of a name → entry updated, no new entry", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "second recordSave of a name → entry updated, no new entry", false, to_string(SAVES),
+                        to_string(saves.itsCount));
+        failed++;
+    }
+
+    // Test: removeSave
+    testNum++;
+    const bool REMOVED = removeSave(saves, "game1000") && findSave(saves, "game1000") == -1 && saves.itsCount == SAVES - 1;
+    if (REMOVED && !removeSave(saves, "game1000")) {
+        printTestResult(testNum, "removeSave → removed once, then not found", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "removeSave → removed once, then not found", false, "removed", "not removed");
+        failed++;
+    }
+
+    // Test: the index file holds the same entries, no temporary file is left
+    testNum++;
+    SaveIndex reloaded;
+    const bool RELOADED = loadSaveIndex(reloaded, DIRECTORY.string()) && reloaded.itsCount == saves.itsCount
+                          && memcmp(reloaded.itsEntries, saves.itsEntries, sizeof(SaveIndexEntry) * saves.itsCount) == 0
+                          && !filesystem::exists(DIRECTORY / (SAVE_INDEX_FILE + ".tmp"));
+    if (RELOADED) {
+        printTestResult(testNum, "loadSaveIndex → same entries as in memory", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "loadSaveIndex → same entries as in memory", false, to_string(saves.itsCount),
+                        to_string(reloaded.itsCount));
+        failed++;
+    }
+    deleteSaveIndex(reloaded);
+
+    // Tests: invalid names are refused
+    struct TestCase {
+        string name;
+        string description;
+    };
+    TestCase cases[] = {
+        {"", "empty name → refused"},
+        {"../escape", "name with a path → refused"},
+        {SAVE_INDEX_FILE, "name of the index file → refused"},
+        {string(SAVE_INDEX_NAME_LENGTH, 'a'), "name too long → refused"},
+    };
+    for (const TestCase& tc : cases) {
+        testNum++;
+        if (!isValidSaveName(tc.name) && !recordSave(saves, tc.name, LITTLE, 0)) {
+            printTestResult(testNum, tc.description, true);
+            pass++;
+        } else {
+            printTestResult(testNum, tc.description, false, "refused", "recorded");
+            failed++;
+        }
+    }
+
+    // Test: a corrupted index file is rejected
+    testNum++;
+    ofstream(DIRECTORY / SAVE_INDEX_FILE, ios::binary | ios::app) << "x";
+    SaveIndex corrupted;
+    if (!loadSaveIndex(corrupted, DIRECTORY.string()) && corrupted.itsCount == 0) {
+        printTestResult(testNum, "index file with an extra byte → rejected", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "index file with an extra byte → rejected", false, "rejected", "loaded");
+        failed++;
+    }
+    deleteSaveIndex(corrupted);
+
+    deleteSaveIndex(saves);
+    filesystem::remove_all(DIRECTORY);
+    printTestSummary("recordSave", pass, failed);
+}
+
+/**
+ * @brief Test function for loadSaveIndex.
+ *
+ * This function tests the creation of the index of a folder written before the index: the binary
+ * and text saves found are described once (size, plies, offset), other files are ignored.
+ */
+void test_loadSaveIndex()
+{
+    printTestHeader("loadSaveIndex");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    const filesystem::path DIRECTORY = filesystem::temp_directory_path() / "hnefatafl_test_index";
+    filesystem::remove_all(DIRECTORY);
+    filesystem::create_directories(DIRECTORY / "folder");
+
+    // a journal of 3 moves on a BIG board
+    Game game;
+    game.itsBoard = {cb(BIG), BIG};
+    initializeBoard(game.itsBoard);
+    MoveJournal journal;
+    openJournal(journal, (DIRECTORY / "journal").string(), game);
+    MoveList list;
+    for (int i = 0; i < 3; ++i) {
+        generateMoves(game, list);
+        makeMove(game, list.itsMoves[0]);
+        appendJournal(journal, list.itsMoves[0]);
+    }
+    closeJournal(journal);
+    db(game.itsBoard.itsCells, BIG);
+
+    // a legacy text save of a LITTLE board
+    Game little;
+    little.itsBoard = {cb(LITTLE), LITTLE};
+    initializeBoard(little.itsBoard);
+    string text = little.itsPlayer1.itsName + "\n" + little.itsPlayer2.itsName + "\n0\n11\n";
+    for (int row = 0; row < LITTLE; ++row) {
+        for (int col = 0; col < LITTLE; ++col) {
+            const PieceType PIECE = little.itsBoard.itsCells[row][col].itsPieceType;
+            text += (PIECE == NONE) ? "☒" : (PIECE == SWORD) ? "S" : (PIECE == KING) ? "K" : "s";
+        }
+        text += "\n";
+    }
+    ofstream(DIRECTORY / "text", ios::binary) << text;
+    db(little.itsBoard.itsCells, LITTLE);
+
+    SaveIndex saves;
+    const bool LOADED = loadSaveIndex(saves, DIRECTORY.string());
+
+    // Test: only the files are indexed
+    testNum++;
+    if (LOADED && saves.itsCount == 2 && findSave(saves, "folder") == -1 && filesystem::exists(DIRECTORY / SAVE_INDEX_FILE)) {
+        printTestResult(testNum, "folder without index → 2 save files indexed, sub folder ignored", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "folder without index → 2 save files indexed, sub folder ignored", false, "2", to_string(saves.itsCount));
+        failed++;
+    }
+
+    // Test: the journal is described from its header and length
+    testNum++;
+    const int JOURNAL = findSave(saves, "journal");
+    if (JOURNAL != -1 && saves.itsEntries[JOURNAL].itsSize == BIG && saves.itsEntries[JOURNAL].itsPlies == 3
+        && saves.itsEntries[JOURNAL].itsOffset == sizeof(SaveRecord) + 3 * sizeof(MoveRecord)) {
+        printTestResult(testNum, "journal → BIG, 3 moves, offset after the 3 records", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "journal → BIG, 3 moves, offset after the 3 records", false, "13 / 3",
+                        JOURNAL == -1 ? "not found" : to_string(saves.itsEntries[JOURNAL].itsSize) + " / " + to_string(saves.itsEntries[JOURNAL].itsPlies));
+        failed++;
+    }
+
+    // Test: the text save is described from its content
+    testNum++;
+    const int TEXT = findSave(saves, "text");
+    if (TEXT != -1 && saves.itsEntries[TEXT].itsSize == LITTLE && saves.itsEntries[TEXT].itsPlies == 0 && saves.itsEntries[TEXT].itsOffset == 0) {
+        printTestResult(testNum, "text save → LITTLE, no journal", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "text save → LITTLE, no journal", false, "11", TEXT == -1 ? "not found" : to_string(saves.itsEntries[TEXT].itsSize));
+        failed++;
+    }
+
+    // Test: once the index exists, new files are not scanned
+    testNum++;
+    ofstream(DIRECTORY / "copied", ios::binary) << text;
+    SaveIndex reloaded;
+    if (loadSaveIndex(reloaded, DIRECTORY.string()) && reloaded.itsCount == 2 && findSave(reloaded, "copied") == -1) {
+        printTestResult(testNum, "file added after the index → not scanned again", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "file added after the index → not scanned again", false, "2", to_string(reloaded.itsCount));
+        failed++;
+    }
+    deleteSaveIndex(reloaded);
+
+    deleteSaveIndex(saves);
+    filesystem::remove_all(DIRECTORY);
+    printTestSummary("loadSaveIndex", pass, failed);
+}
+
+/**
+ * @brief Takes the replies waiting in the output of a connection of the server.
+ *
+ * @param aServer The server.
+ * @param aConnection The index of the connection.
+ * @return The replies (the output is emptied).
+ */
+static string takeServerOutput(GameServer& aServer, int aConnection) {
+    ServerConnection& connection = aServer.itsConnections[aConnection];
+    const string OUTPUT(connection.itsOutput, connection.itsOutputLength);
+    connection.itsOutputLength = 0;
+    return OUTPUT;
+}
+
+/**
+ * @brief Test function for handleServerLine.
+ *
+ * This function tests the protocol of the game server on connections without socket: hosting,
+ * joining, the moves checked with checkMovement and sent as diffs (captures included), the end of
+ * a game, the errors, leaving a game, the pools and the lines received in several pieces.
+ */
+void test_handleServerLine()
+{
+    printTestHeader("handleServerLine");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+    GameServer server;
+    const bool CREATED = createServer(server, 4, 2);
+    const int HOST = CREATED ? openConnection(server, -1) : -1;
+    const int GUEST = CREATED ? openConnection(server, -1) : -1;
+    const int SOLO = CREATED ? openConnection(server, -1) : -1;
+    if (!CREATED || HOST == -1 || GUEST == -1 || SOLO == -1) {
+        printTestResult(++testNum, "createServer(4, 2) and 3 connections", false, "created", "failed");
+        printTestSummary("handleServerLine", pass, failed + 1);
+        deleteServer(server);
+        return;
+    }
+
+    // Test: host a game
+    testNum++;
+    handleServerLine(server, HOST, "host 11");
+    string output = takeServerOutput(server, HOST);
+    if (output == "hosted 0\n" && server.itsConnections[HOST].itsGame == 0) {
+        printTestResult(testNum, "host 11 → hosted 0", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "host 11 → hosted 0", false, "hosted 0", output);
+        failed++;
+    }
+
+    // Test: wrong size and unknown command
+    testNum++;
+    handleServerLine(server, SOLO, "host 12");
+    handleServerLine(server, SOLO, "play F2-F5");
+    output = takeServerOutput(server, SOLO);
+    if (output == "error size\nerror unknown-command\n") {
+        printTestResult(testNum, "host 12, play → error size, error unknown-command", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "host 12, play → error size, error unknown-command", false, "2 errors", output);
+        failed++;
+    }
+
+    // Test: no move before the opponent joined
+    testNum++;
+    handleServerLine(server, HOST, "move A4-B4");
+    output = takeServerOutput(server, HOST);
+    if (output == "error waiting\n") {
+        printTestResult(testNum, "move before join → error waiting", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "move before join → error waiting", false, "error waiting", output);
+        failed++;
+    }
+
+    // Test: join sends the start position to both players
+    testNum++;
+    handleServerLine(server, GUEST, "join 0");
+    const string HOST_START = takeServerOutput(server, HOST);
+    const string GUEST_START = takeServerOutput(server, GUEST);
+    if (HOST_START == "start 0 attack " + string(POSITION_START_LITTLE) + "\n"
+        && GUEST_START == "start 0 defense " + string(POSITION_START_LITTLE) + "\n") {
+        printTestResult(testNum, "join 0 → start with the role and the position to both players", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "join 0 → start to both players", false, "start 0 attack ...", HOST_START + GUEST_START);
+        failed++;
+    }
+
+    // Tests: the moves refused by the server
+    const pair<const char*, const char*> REFUSED[] = {
+        {"move E1-E2", "error not-your-turn\n"},
+        {"move F6-F7", "error wrong-piece\n"},
+        {"move A4-C5", "error not-straight\n"},
+        {"move D1-D8", "error blocked\n"},
+        {"move A4-A1", "error special-cell\n"},
+        {"move A4", "error syntax\n"}
+    };
+    for (const auto& [LINE, EXPECTED] : REFUSED) {
+        testNum++;
+        const int PLAYER = (strcmp(LINE, "move E1-E2") == 0) ? GUEST : HOST;
+        handleServerLine(server, PLAYER, LINE);
+        output = takeServerOutput(server, PLAYER);
+        const string OPPONENT = takeServerOutput(server, PLAYER == HOST ? GUEST : HOST);
+        if (output == EXPECTED && OPPONENT.empty()) {
+            printTestResult(testNum, string(LINE) + " → " + string(EXPECTED, strlen(EXPECTED) - 1), true);
+            pass++;
+        } else {
+            printTestResult(testNum, LINE, false, string(EXPECTED, strlen(EXPECTED) - 1), output);
+            failed++;
+        }
+    }
+
+    // Test: a valid move is sent to both players
+    testNum++;
+    handleServerLine(server, HOST, "move a4-b4");
+    const string HOST_MOVED = takeServerOutput(server, HOST);
+    const string GUEST_MOVED = takeServerOutput(server, GUEST);
+    const Game& PLAYED = server.itsGames[0].itsGame;
+    if (HOST_MOVED == "moved A4-B4\n" && GUEST_MOVED == HOST_MOVED && PLAYED.itsBoard.itsCells[1][3].itsPieceType == SWORD
+        && PLAYED.itsCurrentPlayer->itsRole == DEFENSE && server.itsStats.itsMoves == 1) {
+        printTestResult(testNum, "move a4-b4 → moved A4-B4 to both players, DEFENSE to play", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "move a4-b4 → moved A4-B4 to both players", false, "moved A4-B4", HOST_MOVED + GUEST_MOVED);
+        failed++;
+    }
+
+    // Test: board
+    testNum++;
+    handleServerLine(server, GUEST, "board");
+    output = takeServerOutput(server, GUEST);
+    if (output == "position 4aaaa3/3a1a5/11/a4d4a/a3ddd3a/aa1ddkdd1aa/a3ddd3a/a4d4a/11/5a5/3aaaaa3 d\n") {
+        printTestResult(testNum, "board → position after A4-B4, DEFENSE to play", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "board → position after A4-B4", false, "B4 sword", output);
+        failed++;
+    }
+
+    // Test: the pool of games is full
+    testNum++;
+    handleServerLine(server, SOLO, "new 13");
+    const string SOLO_START = takeServerOutput(server, SOLO);
+    const int FOURTH = openConnection(server, -1);
+    handleServerLine(server, FOURTH, "host 11");
+    output = takeServerOutput(server, FOURTH);
+    if (SOLO_START == "start 1 both " + string(POSITION_START_BIG) + "\n" && output == "error full\n" && openConnection(server, -1) == -1) {
+        printTestResult(testNum, "new 13 → start 1 both, then games and connections full", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "new 13, then pools full", false, "start 1 both / error full", SOLO_START + output);
+        failed++;
+    }
+
+    // Test: a move with a capture sends the captured cell
+    testNum++;
+    parsePosition("11/11/11/2ad7/11/4a6/11/5k5/11/11/11 a", server.itsGames[0].itsGame);
+    handleServerLine(server, HOST, "move F5-D5");
+    const string CAPTURE = takeServerOutput(server, HOST);
+    takeServerOutput(server, GUEST);
+    if (CAPTURE == "moved F5-D5 x D4\n" && server.itsGames[0].itsGame.itsBoard.itsCells[3][3].itsPieceType == NONE) {
+        printTestResult(testNum, "F5-D5 sandwiches D4 → moved F5-D5 x D4", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "F5-D5 sandwiches D4", false, "moved F5-D5 x D4", CAPTURE);
+        failed++;
+    }
+
+    // Test: the king escapes, the game is finished
+    testNum++;
+    parsePosition("1k11/13/13/13/13/13/13/13/13/13/13/13/6a6 d", server.itsGames[1].itsGame);
+    handleServerLine(server, SOLO, "move A2-A1");
+    output = takeServerOutput(server, SOLO);
+    handleServerLine(server, SOLO, "move M7-M6");
+    const string AFTER_END = takeServerOutput(server, SOLO);
+    if (output == "moved A2-A1\nend king-escaped defense\n" && AFTER_END == "error finished\n") {
+        printTestResult(testNum, "A2-A1 → moved, end king-escaped defense, then error finished", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "A2-A1 → end king-escaped defense", false, "end king-escaped defense", output + AFTER_END);
+        failed++;
+    }
+
+    // Test: leave closes the game for both players
+    testNum++;
+    handleServerLine(server, GUEST, "leave");
+    const string HOST_CLOSED = takeServerOutput(server, HOST);
+    const string GUEST_CLOSED = takeServerOutput(server, GUEST);
+    if (HOST_CLOSED == "closed\n" && GUEST_CLOSED == "closed\n" && server.itsConnections[HOST].itsGame == -1
+        && server.itsConnections[GUEST].itsGame == -1 && server.itsStats.itsOpenGames == 1) {
+        printTestResult(testNum, "leave → closed to both players, game back to the pool", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "leave → closed to both players", false, "closed", HOST_CLOSED + GUEST_CLOSED);
+        failed++;
+    }
+
+    // Test: closing a connection closes its game for the opponent
+    testNum++;
+    handleServerLine(server, HOST, "host 11");
+    takeServerOutput(server, HOST);
+    handleServerLine(server, GUEST, "join 0");
+    takeServerOutput(server, HOST);
+    takeServerOutput(server, GUEST);
+    closeConnection(server, HOST);
+    output = takeServerOutput(server, GUEST);
+    if (output == "closed\n" && server.itsConnections[GUEST].itsGame == -1 && server.itsStats.itsOpenConnections == 3
+        && openConnection(server, -1) == HOST) {
+        printTestResult(testNum, "connection closed → closed to the opponent, slot reused", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "connection closed → closed to the opponent", false, "closed", output);
+        failed++;
+    }
+
+    // Test: lines received in several pieces, with CR LF
+    testNum++;
+    const bool KEPT = receiveServerData(server, GUEST, "bo", 2) && receiveServerData(server, GUEST, "ard\r\nhost 1", 11)
+                      && receiveServerData(server, GUEST, "1\nqu", 4);
+    output = takeServerOutput(server, GUEST);
+    const bool QUIT = !receiveServerData(server, GUEST, "it\n", 3);
+    output += takeServerOutput(server, GUEST);
+    if (KEPT && QUIT && output == "error no-game\nhosted 0\nbye\n") {
+        printTestResult(testNum, "board, host 11 and quit split across 4 reads → 3 replies, then close", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "lines split across reads", false, "error no-game / hosted 0 / bye", output);
+        failed++;
+    }
+
+    // Test: a line too long closes the connection
+    testNum++;
+    const string LONG_LINE(SERVER_LINE_LENGTH, 'x');
+    const bool IS_KEPT = receiveServerData(server, SOLO, LONG_LINE.data(), static_cast<int>(LONG_LINE.size()));
+    output = takeServerOutput(server, SOLO);
+    if (!IS_KEPT && output == "error line-too-long\n") {
+        printTestResult(testNum, to_string(SERVER_LINE_LENGTH) + " characters without line end → error line-too-long, close", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "line too long", false, "error line-too-long", output);
+        failed++;
+    }
+
+    deleteServer(server);
+    printTestSummary("handleServerLine", pass, failed);
+}
+
+#ifdef __linux__
+/**
+ * @brief Connects a client socket to the server of the tests.
+ *
+ * @param aPort The port of the server.
+ * @return The socket (reads time out after 2 s), or -1 on error.
+ */
+static int connectTestClient(int aPort) {
+    const int SOCKET = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(aPort));
+    const timeval TIMEOUT = {2, 0};
+    if (SOCKET < 0 || setsockopt(SOCKET, SOL_SOCKET, SO_RCVTIMEO, &TIMEOUT, sizeof(TIMEOUT)) != 0
+        || connect(SOCKET, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (SOCKET >= 0) {
+            close(SOCKET);
+        }
+        return -1;
+    }
+    return SOCKET;
+}
+
+/**
+ * @brief Sends a command to the server and reads a number of reply lines.
+ *
+ * @param aSocket The client socket.
+ * @param aCommand The command with its line end (nothing is sent if empty).
+ * @param aLines The number of lines to read.
+ * @return The lines read (less if the server closed or the time ran out).
+ */
+static string exchangeTestLines(int aSocket, const string& aCommand, int aLines) {
+    if (!aCommand.empty() && send(aSocket, aCommand.data(), aCommand.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(aCommand.size())) {
+        return "";
+    }
+    string text;
+    char character;
+    while (aLines > 0 && recv(aSocket, &character, 1, 0) == 1) {
+        text += character;
+        aLines -= character == '\n';
+    }
+    return text;
+}
+#endif
+
+/**
+ * @brief Test function for runServer.
+ *
+ * This function tests the event loop on loopback sockets: a game between two clients, many
+ * games at the same time, a client refused when the pool is full and the stop of the loop.
+ */
+void test_runServer()
+{
+    printTestHeader("runServer");
+    int pass = 0;
+    int failed = 0;
+    int testNum = 0;
+#ifdef __linux__
+    const int CLIENTS = 64;
+    GameServer server;
+    const bool LISTENING = createServer(server, CLIENTS + 1, CLIENTS) && listenServer(server, 0);
+    thread loop;
+    bool isRunning = false;
+    if (LISTENING) {
+        loop = thread([&server, &isRunning]() { isRunning = runServer(server); });
+    }
+
+    // Test: a game between two clients
+    testNum++;
+    const int HOST = LISTENING ? connectTestClient(server.itsPort) : -1;
+    const int GUEST = LISTENING ? connectTestClient(server.itsPort) : -1;
+    string hosted = exchangeTestLines(HOST, "host 11\n", 1);
+    const bool STARTED = exchangeTestLines(GUEST, "join 0\n", 1).rfind("start 0 defense ", 0) == 0
+                         && exchangeTestLines(HOST, "", 1).rfind("start 0 attack ", 0) == 0;
+    const string MOVED = exchangeTestLines(HOST, "move A4-B4\n", 1);
+    const string SEEN = exchangeTestLines(GUEST, "", 1);
+    if (hosted == "hosted 0\n" && STARTED && MOVED == "moved A4-B4\n" && SEEN == MOVED) {
+        printTestResult(testNum, "host, join and move over TCP → both players receive the move", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "host, join and move over TCP", false, "moved A4-B4", hosted + MOVED + SEEN);
+        failed++;
+    }
+
+    // Test: quit, then the opponent receives closed
+    testNum++;
+    const string BYE = exchangeTestLines(HOST, "quit\n", 2);
+    const string CLOSED = exchangeTestLines(GUEST, "", 1);
+    close(HOST);
+    close(GUEST);
+    if (BYE == "bye\n" && CLOSED == "closed\n") {
+        printTestResult(testNum, "quit → bye and connection closed, closed to the opponent", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "quit → bye, closed to the opponent", false, "bye / closed", BYE + CLOSED);
+        failed++;
+    }
+
+    // Test: many games at the same time
+    testNum++;
+    int sockets[CLIENTS];
+    for (int i = 0; i < CLIENTS; ++i) {
+        sockets[i] = LISTENING ? connectTestClient(server.itsPort) : -1;
+    }
+    int played = 0;
+    for (int i = 0; i < CLIENTS; ++i) {
+        played += exchangeTestLines(sockets[i], "new 11\n", 1).rfind("start ", 0) == 0;
+    }
+    for (int i = 0; i < CLIENTS; ++i) {
+        played += exchangeTestLines(sockets[i], "move A4-B4\n", 1) == "moved A4-B4\n";
+    }
+    if (played == 2 * CLIENTS) {
+        printTestResult(testNum, to_string(CLIENTS) + " clients playing their own game → all moves played", true);
+        pass++;
+    } else {
+        printTestResult(testNum, to_string(CLIENTS) + " clients playing their own game", false, to_string(2 * CLIENTS), to_string(played));
+        failed++;
+    }
+
+    // Test: a client refused when the pool of connections is full
+    testNum++;
+    const int EXTRA = LISTENING ? connectTestClient(server.itsPort) : -1;
+    const int REFUSED = LISTENING ? connectTestClient(server.itsPort) : -1;
+    const string EXTRA_REPLY = exchangeTestLines(EXTRA, "board\n", 1);
+    const string REFUSED_REPLY = exchangeTestLines(REFUSED, "board\n", 1);
+    if (EXTRA_REPLY == "error no-game\n" && REFUSED_REPLY.empty()) {
+        printTestResult(testNum, to_string(CLIENTS + 1) + " connections used → the next client is closed", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "pool of connections full", false, "refused", REFUSED_REPLY);
+        failed++;
+    }
+    for (int i = 0; i < CLIENTS; ++i) {
+        if (sockets[i] >= 0) {
+            close(sockets[i]);
+        }
+    }
+    for (int client : {EXTRA, REFUSED}) {
+        if (client >= 0) {
+            close(client);
+        }
+    }
+
+    // Test: stopServer ends the loop
+    testNum++;
+    stopServer(server);
+    if (loop.joinable()) {
+        loop.join();
+    }
+    if (LISTENING && isRunning && server.itsStats.itsGames == CLIENTS + 1 && server.itsStats.itsRefused == 1) {
+        printTestResult(testNum, "stopServer → runServer returns true, " + to_string(CLIENTS + 1) + " games and 1 client refused counted", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "stopServer → runServer returns true", false, "true", isRunning ? "true" : "false");
+        failed++;
+    }
+    deleteServer(server);
+#else
+    // Test: no event loop without epoll
+    testNum++;
+    GameServer server;
+    if (createServer(server, 1, 1) && !listenServer(server, 0)) {
+        printTestResult(testNum, "listenServer without epoll → false", true);
+        pass++;
+    } else {
+        printTestResult(testNum, "listenServer without epoll → false", false, "false", "true");
+        failed++;
+    }
+    deleteServer(server);
+#endif
+    printTestSummary("runServer", pass, failed);
+}
+
+// ========================================================================================
+// ============================= HELPER FUNCTIONS =========================================
+// ========================================================================================
+// This section contains all utility/helper functions used by the test suite.
+// These functions provide:
+//   - Board memory management (cb, db, resetBoard)
+//   - Test output formatting (printTestHeader, printTestResult, printTestSummary, etc.)
+//   - Test configuration (configureTestDisplay)
+// ========================================================================================
+
+/**
+ * @brief Resets all cells of a board to {NORMAL, NONE}.
+ * @param aBoard The board to reset
+ * @param aBoardSize The size of the board
+ */
+void resetBoard(CellRow*& aBoard, const BoardSize& aBoardSize)
+{
+    // Iterate over each row and column of the board
+    for (int i = 0; i < aBoardSize; ++i) {
+        for (int j = 0; j < aBoardSize; ++j) {
+            // Set the cell to a normal state with no piece
+            aBoard[i][j] = {NORMAL, NONE};
+        }
+    }
+}
+
+/**
+ * @brief Creates a board (cb = "create board").
+ * Allocates a single contiguous block of rows of cells.
+ * @param aBoardSize The size of the board
+ * @return Pointer to the allocated board
+ */
+CellRow* cb(const BoardSize& aBoardSize) {
+    return new CellRow[aBoardSize];
+}
+
+/**
+ * @brief Deletes a board (db = "delete board").
+ * Frees the block of cells allocated by cb.
+ * @param aBoard The board to delete
+ * @param aBoardSize The size of the board
+ */
+void db(CellRow*& aBoard, const BoardSize& aBoardSize) {
+    (void)aBoardSize; // Single block: the size is not needed anymore
     delete[] aBoard;
     aBoard = nullptr;
 }
@@ -3315,7 +8797,7 @@ void printTestSummary(const string& testName, int passed, int failed) {
  * @param c Column position
  * @param piece The piece type to place
  */
-void placePiece(Cell** board, int r, int c, PieceType piece) {
+void placePiece(CellRow* board, int r, int c, PieceType piece) {
     board[r][c].itsCellType = NORMAL;
     board[r][c].itsPieceType = piece;
 }
@@ -3330,7 +8812,7 @@ void placePiece(Cell** board, int r, int c, PieceType piece) {
  * @param c2 Second column coordinate
  * @param piece The piece type to place on the border
  */
-void drawRectBorderPieces(Cell** board, int r1, int c1, int r2, int c2, PieceType piece) {
+void drawRectBorderPieces(CellRow* board, int r1, int c1, int r2, int c2, PieceType piece) {
     int top = std::min(r1, r2);
     int bottom = std::max(r1, r2);
     int left = std::min(c1, c2);
@@ -0,0 +1,104 @@
+/**
+ * @file analyze.cpp
+ *
+ * @brief Entry point of `Hnefatafl_analyze`, the analysis of positions with the persistent cache.
+ *
+ * Usage: `Hnefatafl_analyze [--cache FILE] [--time MS] [--threads T]`
+ *
+ * Reads one position per line (see notation.h) from `stdin` and writes its analysis to `stdout`:
+ * `<line> <move> <score> <depth> <nodes> <microseconds>`, or `<line> invalid`. Empty lines and
+ * lines starting with `#` are skipped. The results are kept in the analysis cache
+ * (`ANALYSIS_CACHE_PATH` by default, see analysis.h), so a position analyzed by a previous run
+ * is answered without searching.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/ai.h"
+#include "../Headers/analysis.h"
+#include "../Headers/notation.h"
+
+using namespace std;
+
+/**
+ * @brief Displays the usage of the program.
+ */
+static void displayUsage() {
+    cerr << "Usage: Hnefatafl_analyze [--cache FILE] [--time MS] [--threads T]" << endl;
+}
+
+/**
+ * @brief Main function of the analysis tool.
+ *
+ * @return 0 if every position was analyzed, 2 if a position is invalid, 1 on invalid arguments or allocation errors.
+ */
+int main(int argc, char* argv[]) {
+    string cachePath = ANALYSIS_CACHE_PATH;
+    int timeMs = 2000;
+    int threads = AI_ALL_CORES;
+    for (int arg = 1 ; arg < argc ; arg++) {
+        if (arg + 1 < argc && strcmp(argv[arg], "--cache") == 0) {
+            cachePath = argv[++arg];
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--time") == 0) {
+            timeMs = atoi(argv[++arg]);
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--threads") == 0) {
+            threads = atoi(argv[++arg]);
+        } else {
+            displayUsage();
+            return 1;
+        }
+    }
+    if (timeMs <= 0 || threads < 0) {
+        displayUsage();
+        return 1;
+    }
+    AiSearch search;
+    if (!createAi(search, AI_TABLE_BITS, threads)) {
+        cerr << "Error: not enough memory for the search" << endl;
+        return 1;
+    }
+    AnalysisCache cache;
+    if (!openAnalysisCache(cache, cachePath)) {
+        cerr << "Error: can't open the analysis cache " << cachePath << endl;
+        deleteAi(search);
+        return 1;
+    }
+    search.itsAnalysis = &cache;
+    cerr << preloadAnalysisCache(cache, search) << " positions loaded from " << cachePath << endl;
+
+    Game game;
+    string line;
+    long long lineNumber = 0;
+    bool isValid = true;
+    char move[MOVE_TEXT_CAPACITY];
+    while (getline(cin, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (!parsePosition(line, game)) {
+            cout << lineNumber << " invalid" << endl;
+            isValid = false;
+            continue;
+        }
+        const auto START = chrono::steady_clock::now();
+        const AiResult RESULT = searchBestMove(game, search, timeMs);
+        const long long MICROSECONDS = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - START).count();
+        if (formatMove(RESULT.itsBestMove, move, MOVE_TEXT_CAPACITY) < 0) {
+            strcpy(move, "-");
+        }
+        cout << lineNumber << " " << move << " " << RESULT.itsScore << " " << RESULT.itsDepth << " "
+             << RESULT.itsNodes << " " << MICROSECONDS << endl;
+    }
+    deleteBoard(game.itsBoard);
+    closeAnalysisCache(cache);
+    deleteAi(search);
+    return isValid ? 0 : 2;
+}
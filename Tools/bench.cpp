@@ -0,0 +1,146 @@
+/**
+ * @file bench.cpp
+ *
+ * @brief Entry point of `Hnefatafl_bench`, the microbenchmarks of the functions.h API.
+ *
+ * Usage: `Hnefatafl_bench [--size 11|13] [--filter REGEX] [--min-time S] [--json FILE] [--baseline FILE] [--tolerance PCT]`
+ *
+ * Prints the time per call of each benchmark (see bench.h) on the LITTLE and BIG boards, in the
+ * opening and mid-game positions. `--json` also writes the results in the Google Benchmark format.
+ * `--baseline` compares the results with a previous JSON file and returns 1 if a benchmark is
+ * slower by more than the tolerance (10% by default).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <vector>
+#include "../Headers/typeDef.h"
+#include "../Headers/bench.h"
+
+using namespace std;
+
+/**
+ * @brief Displays the usage of the program.
+ */
+static void displayUsage() {
+    cerr << "Usage: Hnefatafl_bench [--size 11|13] [--filter REGEX] [--min-time S] [--json FILE] [--baseline FILE] [--tolerance PCT]" << endl;
+}
+
+/**
+ * @brief Main function of the benchmark tool.
+ *
+ * @return 0 on success, 1 on an error or a slowdown beyond the tolerance.
+ */
+int main(int argc, char* argv[]) {
+    bool sizes[2] = {true, true};
+    const char* filter = ".*";
+    double minSeconds = BENCH_MIN_TIME;
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    double tolerance = 10;
+    for (int arg = 1 ; arg < argc ; arg++) {
+        if (arg + 1 < argc && strcmp(argv[arg], "--filter") == 0) {
+            filter = argv[++arg];
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--min-time") == 0) {
+            minSeconds = atof(argv[++arg]);
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--json") == 0) {
+            jsonPath = argv[++arg];
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--baseline") == 0) {
+            baselinePath = argv[++arg];
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--tolerance") == 0) {
+            tolerance = atof(argv[++arg]);
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--size") == 0) {
+            const int SIZE = atoi(argv[++arg]);
+            if (SIZE != LITTLE && SIZE != BIG) {
+                displayUsage();
+                return 1;
+            }
+            sizes[0] = SIZE == LITTLE;
+            sizes[1] = SIZE == BIG;
+        } else {
+            displayUsage();
+            return 1;
+        }
+    }
+    regex pattern;
+    try {
+        pattern = regex(filter);
+    } catch (const regex_error&) {
+        cerr << "Error: invalid filter" << endl;
+        return 1;
+    }
+    if (minSeconds < 0 || tolerance < 0) {
+        displayUsage();
+        return 1;
+    }
+    string baseline;
+    if (baselinePath != nullptr) {
+        ifstream file(baselinePath);
+        if (!file) {
+            cerr << "Error: can't read " << baselinePath << endl;
+            return 1;
+        }
+        stringstream content;
+        content << file.rdbuf();
+        baseline = content.str();
+    }
+
+    int caseCount = 0;
+    const BenchCase* cases = getBenchCases(caseCount);
+    const string SAVE_DIRECTORY = (filesystem::temp_directory_path() / "hnefatafl_bench_saves").string();
+    vector<BenchResult> results;
+    cout << left << setw(52) << "benchmark" << right << setw(14) << "time (ns)" << setw(14) << "cpu (ns)"
+         << setw(14) << "iterations" << endl;
+    for (BoardSize size : {LITTLE, BIG}) {
+        if (!sizes[size == BIG]) {
+            continue;
+        }
+        for (int phase = 0 ; phase < BENCH_PHASE_COUNT ; phase++) {
+            BenchFixture fixture;
+            if (!createBenchFixture(fixture, size, static_cast<BenchPhase>(phase), SAVE_DIRECTORY)) {
+                cerr << "Error: fixture creation failed" << endl;
+                return 1;
+            }
+            for (int index = 0 ; index < caseCount ; index++) {
+                //the cases without position are measured on the opening fixture only
+                if ((!cases[index].itsUsesPhase && phase != BENCH_OPENING)
+                    || !regex_search(getBenchName(cases[index], fixture), pattern)) {
+                    continue;
+                }
+                const BenchResult RESULT = runBenchmark(cases[index], fixture, minSeconds);
+                cout << left << setw(52) << RESULT.itsName << right << fixed << setprecision(1) << setw(14) << RESULT.itsRealNs
+                     << setw(14) << RESULT.itsCpuNs << setw(14) << RESULT.itsIterations << endl;
+                results.push_back(RESULT);
+            }
+            deleteBenchFixture(fixture);
+        }
+    }
+
+    if (jsonPath != nullptr) {
+        ofstream file(jsonPath);
+        file << formatBenchmarkJson(results.data(), static_cast<int>(results.size()));
+        if (!file) {
+            cerr << "Error: can't write " << jsonPath << endl;
+            return 1;
+        }
+    }
+    if (baselinePath != nullptr) {
+        string comparison;
+        const int SLOWER = compareBenchmarks(results.data(), static_cast<int>(results.size()), baseline, tolerance / 100, comparison);
+        cout << endl << left << setw(52) << "comparison" << right << setw(13) << "baseline" << setw(13) << "current"
+             << setw(10) << "change" << endl << comparison;
+        if (SLOWER > 0) {
+            cout << SLOWER << " benchmark(s) slower than the baseline by more than " << tolerance << "%" << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file book.cpp
+ *
+ * @brief Entry point of `Hnefatafl_book`, the offline generator of the opening book and of the endgame tables.
+ *
+ * Usage: `Hnefatafl_book [--size 11|13] [--plies P] [--depth D] [--time MS] [--positions N]
+ * [--shields S] [--swords S] [--book FILE] [--endgame FILE]`
+ *
+ * By default the files are written to `BOOK_DIRECTORY`, where the game loads them. A `--plies`
+ * or `--swords` of 0 skips the book or the tables.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include "../Headers/typeDef.h"
+#include "../Headers/ai.h"
+#include "../Headers/book.h"
+
+using namespace std;
+
+/**
+ * @brief Displays the usage of the program.
+ */
+static void displayUsage() {
+    cerr << "Usage: Hnefatafl_book [--size 11|13] [--plies P] [--depth D] [--time MS] [--positions N]" << endl
+         << "                      [--shields S] [--swords S] [--book FILE] [--endgame FILE]" << endl;
+}
+
+/**
+ * @brief Creates the directory of a file if it does not exist.
+ *
+ * @param aPath The path of the file.
+ */
+static void createParentDirectory(const string& aPath) {
+    const filesystem::path PARENT = filesystem::path(aPath).parent_path();
+    error_code error;
+    if (!PARENT.empty()) {
+        filesystem::create_directories(PARENT, error);
+    }
+}
+
+/**
+ * @brief Main function of the book generator.
+ *
+ * @return 0 if the files were written, 1 on invalid arguments or error.
+ */
+int main(int argc, char* argv[]) {
+    BoardSize size = LITTLE;
+    int plies = 3;
+    int depth = 8;
+    int timeMs = 2000;
+    int positions = 10000;
+    int shields = 1;
+    int swords = 2;
+    string bookName;
+    string endgameName;
+    for (int arg = 1 ; arg < argc ; arg++) {
+        const char* option = argv[arg];
+        //every option takes a value
+        if (arg + 1 >= argc) {
+            displayUsage();
+            return 1;
+        }
+        const char* value = argv[++arg];
+        bool isValid = true;
+        if (strcmp(option, "--size") == 0) {
+            const int SIZE = atoi(value);
+            isValid = SIZE == LITTLE || SIZE == BIG;
+            size = (SIZE == BIG) ? BIG : LITTLE;
+        } else if (strcmp(option, "--plies") == 0) {
+            plies = atoi(value);
+            isValid = plies >= 0;
+        } else if (strcmp(option, "--depth") == 0) {
+            depth = atoi(value);
+            isValid = depth >= 1 && depth < AI_MAX_PLY;
+        } else if (strcmp(option, "--time") == 0) {
+            timeMs = atoi(value);
+            isValid = timeMs > 0;
+        } else if (strcmp(option, "--positions") == 0) {
+            positions = atoi(value);
+            isValid = positions > 0;
+        } else if (strcmp(option, "--shields") == 0) {
+            shields = atoi(value);
+            isValid = shields >= 0 && shields <= ENDGAME_MAX_SHIELDS;
+        } else if (strcmp(option, "--swords") == 0) {
+            swords = atoi(value);
+            isValid = swords >= 0 && swords <= ENDGAME_MAX_SWORDS;
+        } else if (strcmp(option, "--book") == 0) {
+            bookName = value;
+        } else if (strcmp(option, "--endgame") == 0) {
+            endgameName = value;
+        } else {
+            isValid = false;
+        }
+        if (!isValid) {
+            displayUsage();
+            return 1;
+        }
+    }
+    if (bookName.empty()) {
+        bookName = getOpeningBookPath(size);
+    }
+    if (endgameName.empty()) {
+        endgameName = getEndgameTablesPath(size);
+    }
+
+    EndgameTables tables;
+    if (swords > 0) {
+        const auto START = chrono::steady_clock::now();
+        createParentDirectory(endgameName);
+        if (!buildEndgameTables(tables, size, shields, swords) || !writeEndgameTables(tables, endgameName)) {
+            cerr << "Error: can't build or write " << endgameName << endl;
+            closeEndgameTables(tables);
+            return 1;
+        }
+        uint64_t count = 0;
+        for (int table = 0 ; table < tables.itsTableCount ; table++) {
+            count += tables.itsTables[table].itsCount;
+        }
+        cerr << endgameName << ": " << tables.itsTableCount << " tables, " << count << " positions in "
+             << chrono::duration<double>(chrono::steady_clock::now() - START).count() << " s" << endl;
+    }
+    if (plies > 0) {
+        AiSearch search;
+        if (!createAi(search, AI_TABLE_BITS, AI_ALL_CORES)) {
+            cerr << "Error: not enough memory for the search tables" << endl;
+            closeEndgameTables(tables);
+            return 1;
+        }
+        const auto START = chrono::steady_clock::now();
+        OpeningBook book;
+        createParentDirectory(bookName);
+        const bool IS_DONE = buildOpeningBook(book, size, plies, search, depth, timeMs, positions) && writeOpeningBook(book, bookName);
+        deleteAi(search);
+        if (!IS_DONE) {
+            cerr << "Error: can't build or write " << bookName << endl;
+            closeOpeningBook(book);
+            closeEndgameTables(tables);
+            return 1;
+        }
+        cerr << bookName << ": " << book.itsEntryCount << " positions in "
+             << chrono::duration<double>(chrono::steady_clock::now() - START).count() << " s" << endl;
+        closeOpeningBook(book);
+    }
+    closeEndgameTables(tables);
+    return 0;
+}
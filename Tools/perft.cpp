@@ -0,0 +1,140 @@
+/**
+ * @file perft.cpp
+ *
+ * @brief Entry point of `Hnefatafl_perft`, the move generation benchmark and correctness check.
+ *
+ * Usage: `Hnefatafl_perft [--size 11|13] [--depth D] [--rounds R] [--check] [--position "<text>"]`
+ *
+ * Without `--check`, prints the perft counts and nodes/sec of both starting positions up to depth D,
+ * then the speed of `generateMoves()`, `makeMove()`/`unmakeMove()` and `isGameFinished()`.
+ * With `--check`, only compares the counts with the reference values and returns 1 on a mismatch.
+ * With `--position`, only counts the positions reachable from the given position (see notation.h).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include "../Headers/typeDef.h"
+#include "../Headers/functions.h"
+#include "../Headers/perft.h"
+#include "../Headers/evalfeatures.h"
+#include "../Headers/notation.h"
+
+using namespace std;
+
+/**
+ * @brief Displays the usage of the program.
+ */
+static void displayUsage() {
+    cerr << "Usage: Hnefatafl_perft [--size 11|13] [--depth D] [--rounds R] [--check] [--position \"<text>\"]" << endl;
+}
+
+/**
+ * @brief Main function of the perft tool.
+ *
+ * @return 0 if every count matches its reference (or no reference is known), 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    int depth = 4;
+    int rounds = 200;
+    bool isCheck = false;
+    bool sizes[2] = {true, true};
+    const char* position = nullptr;
+    for (int arg = 1 ; arg < argc ; arg++) {
+        if (strcmp(argv[arg], "--check") == 0) {
+            isCheck = true;
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--depth") == 0) {
+            depth = atoi(argv[++arg]);
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--rounds") == 0) {
+            rounds = atoi(argv[++arg]);
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--position") == 0) {
+            position = argv[++arg];
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--size") == 0) {
+            const int SIZE = atoi(argv[++arg]);
+            if (SIZE != LITTLE && SIZE != BIG) {
+                displayUsage();
+                return 1;
+            }
+            sizes[0] = SIZE == LITTLE;
+            sizes[1] = SIZE == BIG;
+        } else {
+            displayUsage();
+            return 1;
+        }
+    }
+    if (depth < 1 || rounds < 1) {
+        displayUsage();
+        return 1;
+    }
+
+    //counts from a given position, without reference values
+    if (position != nullptr) {
+        Game game;
+        if (!parsePosition(position, game)) {
+            cerr << "Error: invalid position" << endl;
+            return 1;
+        }
+        for (int ply = 1 ; ply <= depth ; ply++) {
+            const auto START = chrono::steady_clock::now();
+            const long long NODES = perft(game, ply);
+            const double SECONDS = chrono::duration<double>(chrono::steady_clock::now() - START).count();
+            cout << "perft position depth " << ply << " : " << setw(12) << NODES << "  " << fixed << setprecision(3) << SECONDS << " s" << endl;
+        }
+        deleteBoard(game.itsBoard);
+        return 0;
+    }
+
+    bool isMatching = true;
+    for (BoardSize size : {LITTLE, BIG}) {
+        if (!sizes[size == BIG]) {
+            continue;
+        }
+        Game game;
+        game.itsBoard.itsSize = size;
+        if (!createBoard(game.itsBoard)) {
+            cerr << "Error: board allocation failed" << endl;
+            return 1;
+        }
+        initializeBoard(game.itsBoard);
+        for (int ply = 1 ; ply <= depth ; ply++) {
+            const auto START = chrono::steady_clock::now();
+            const long long NODES = perft(game, ply);
+            const double SECONDS = chrono::duration<double>(chrono::steady_clock::now() - START).count();
+            const long long REFERENCE = perftReference(size, ply);
+            cout << "perft " << setw(2) << size << "x" << size << " depth " << ply << " : " << setw(12) << NODES;
+            if (!isCheck) {
+                cout << "  " << fixed << setprecision(3) << SECONDS << " s  "
+                     << setprecision(0) << (SECONDS > 0 ? NODES / SECONDS : 0) << " nodes/s";
+            }
+            if (REFERENCE == -1) {
+                cout << "  (no reference)" << endl;
+            } else if (REFERENCE == NODES) {
+                cout << "  OK" << endl;
+            } else {
+                cout << "  MISMATCH (expected " << REFERENCE << ")" << endl;
+                isMatching = false;
+            }
+        }
+        deleteBoard(game.itsBoard);
+
+        if (!isCheck) {
+            const HotPathRates RATES = benchmarkHotPaths(size, rounds);
+            cout << fixed << setprecision(0)
+                 << "bench " << setw(2) << size << "x" << size << " generateMoves  : " << setw(12) << RATES.itsGeneratePerSecond
+                 << " calls/s  " << RATES.itsMovesPerSecond << " moves/s" << endl
+                 << "bench " << setw(2) << size << "x" << size << " make/unmake    : " << setw(12) << RATES.itsMakeUnmakePerSecond
+                 << " pairs/s" << endl
+                 << "bench " << setw(2) << size << "x" << size << " isGameFinished : " << setw(12) << RATES.itsGameFinishedPerSecond
+                 << " calls/s" << endl
+                 << "bench " << setw(2) << size << "x" << size << " evalFeatures   : " << setw(12) << RATES.itsFeaturesPerSecond
+                 << " calls/s" << endl
+                 << "bench " << setw(2) << size << "x" << size << " scanBoardMasks : " << setw(12) << RATES.itsScansPerSecond
+                 << " calls/s (" << getFeatureKernelName(getFeatureKernel()) << ")" << endl;
+        }
+    }
+    return isMatching ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file replay.cpp
+ *
+ * @brief Entry point of `Hnefatafl_replay`, the batch validator of the game records.
+ *
+ * Usage: `Hnefatafl_replay [--threads T] [--input FILE] [--output FILE]`
+ *
+ * Reads one game record per line (see replay.h) from the input (`stdin` by default) and writes
+ * one verdict per record to the output (`stdout` by default), in the order of the input.
+ * A summary is written to `stderr`. Nothing is ever asked to the user.
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../Headers/typeDef.h"
+#include "../Headers/ai.h"
+#include "../Headers/replay.h"
+
+using namespace std;
+
+/**
+ * @brief Displays the usage of the program.
+ */
+static void displayUsage() {
+    cerr << "Usage: Hnefatafl_replay [--threads T] [--input FILE] [--output FILE]" << endl;
+}
+
+/**
+ * @brief Main function of the record validator.
+ *
+ * @return 0 if every record is valid, 2 if a record is rejected, 1 on invalid arguments or I/O errors.
+ */
+int main(int argc, char* argv[]) {
+    int threads = AI_ALL_CORES;
+    string inputName;
+    string outputName;
+    for (int arg = 1 ; arg < argc ; arg++) {
+        if (arg + 1 < argc && strcmp(argv[arg], "--threads") == 0) {
+            threads = atoi(argv[++arg]);
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--input") == 0) {
+            inputName = argv[++arg];
+        } else if (arg + 1 < argc && strcmp(argv[arg], "--output") == 0) {
+            outputName = argv[++arg];
+        } else {
+            displayUsage();
+            return 1;
+        }
+    }
+    if (threads < 0) {
+        displayUsage();
+        return 1;
+    }
+    ifstream inputFile;
+    if (!inputName.empty()) {
+        inputFile.open(inputName);
+        if (!inputFile) {
+            cerr << "Error: can't read " << inputName << endl;
+            return 1;
+        }
+    }
+    ofstream outputFile;
+    if (!outputName.empty()) {
+        outputFile.open(outputName);
+        if (!outputFile) {
+            cerr << "Error: can't write " << outputName << endl;
+            return 1;
+        }
+    }
+    //the records are lines, the C streams don't have to be synchronized
+    ios::sync_with_stdio(false);
+    istream& input = inputName.empty() ? cin : inputFile;
+    ostream& output = outputName.empty() ? cout : outputFile;
+
+    ReplaySummary summary;
+    const auto START = chrono::steady_clock::now();
+    if (!runReplay(input, output, threads, &summary)) {
+        cerr << "Error: board allocation or output failed" << endl;
+        return 1;
+    }
+    const double SECONDS = chrono::duration<double>(chrono::steady_clock::now() - START).count();
+    cerr << summary.itsRecords << " records in " << SECONDS << " s";
+    for (int status = 0 ; status < REPLAY_STATUS_COUNT ; status++) {
+        cerr << ", " << getReplayStatusName(static_cast<ReplayStatus>(status)) << " " << summary.itsCounts[status];
+    }
+    cerr << endl;
+    return (summary.itsCounts[REPLAY_VALID] == summary.itsRecords) ? 0 : 2;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file selfplay.cpp
+ *
+ * @brief Entry point of `Hnefatafl_selfplay`, the headless self-play runner.
+ *
+ * Usage: `Hnefatafl_selfplay [--games N] [--threads T] [--size 11|13] [--attack ai|mcts|random]
+ * [--defense ai|mcts|random] [--time MS] [--depth D] [--max-plies P] [--seed S] [--output FILE] [--profile FILE]`
+ *
+ * One line per game is written to the output (see `runSelfPlay()`), and a summary to `stderr`.
+ * With a build instrumented by `HNEFATAFL_PROFILE`, the counters of the hot functions are added
+ * to the summary and written as JSON to the `--profile` file (see profile.h).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../Headers/typeDef.h"
+#include "../Headers/ai.h"
+#include "../Headers/selfplay.h"
+#include "../Headers/profile.h"
+
+using namespace std;
+
+/**
+ * @brief Displays the usage of the program.
+ */
+static void displayUsage() {
+    cerr << "Usage: Hnefatafl_selfplay [--games N] [--threads T] [--size 11|13] [--attack ai|mcts|random]" << endl
+         << "                          [--defense ai|mcts|random] [--time MS] [--depth D] [--max-plies P]" << endl
+         << "                          [--seed S] [--output FILE] [--profile FILE]" << endl;
+}
+
+/**
+ * @brief Reads a player kind from an argument.
+ *
+ * @param aText The argument ("ai", "mcts" or "random").
+ * @param aKind Set to the kind if the argument is valid.
+ * @return `true` if the argument is valid.
+ */
+static bool readPlayerKind(const char* aText, PlayerKind& aKind) {
+    if (strcmp(aText, "ai") == 0) {
+        aKind = AI_PLAYER;
+        return true;
+    }
+    if (strcmp(aText, "mcts") == 0) {
+        aKind = MCTS_PLAYER;
+        return true;
+    }
+    if (strcmp(aText, "random") == 0) {
+        aKind = RANDOM_PLAYER;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Main function of the self-play runner.
+ *
+ * @return 0 if all the games were played, 1 on invalid arguments or allocation failure.
+ */
+int main(int argc, char* argv[]) {
+    SelfPlaySettings settings;
+    int games = 100;
+    int threads = AI_ALL_CORES;
+    string outputName;
+    string profileName;
+    for (int arg = 1 ; arg < argc ; arg++) {
+        const char* option = argv[arg];
+        //every option takes a value
+        if (arg + 1 >= argc) {
+            displayUsage();
+            return 1;
+        }
+        const char* value = argv[++arg];
+        bool isValid = true;
+        if (strcmp(option, "--games") == 0) {
+            games = atoi(value);
+        } else if (strcmp(option, "--threads") == 0) {
+            threads = atoi(value);
+        } else if (strcmp(option, "--size") == 0) {
+            const int SIZE = atoi(value);
+            isValid = SIZE == LITTLE || SIZE == BIG;
+            settings.itsSize = (SIZE == BIG) ? BIG : LITTLE;
+        } else if (strcmp(option, "--attack") == 0) {
+            isValid = readPlayerKind(value, settings.itsAttack);
+        } else if (strcmp(option, "--defense") == 0) {
+            isValid = readPlayerKind(value, settings.itsDefense);
+        } else if (strcmp(option, "--time") == 0) {
+            settings.itsTimeBudgetMs = atoi(value);
+        } else if (strcmp(option, "--depth") == 0) {
+            settings.itsMaxDepth = atoi(value);
+        } else if (strcmp(option, "--max-plies") == 0) {
+            settings.itsMaxPlies = atoi(value);
+        } else if (strcmp(option, "--seed") == 0) {
+            settings.itsSeed = strtoull(value, nullptr, 10);
+        } else if (strcmp(option, "--output") == 0) {
+            outputName = value;
+        } else if (strcmp(option, "--profile") == 0) {
+            profileName = value;
+        } else {
+            isValid = false;
+        }
+        if (!isValid || games < 0 || threads < 0) {
+            displayUsage();
+            return 1;
+        }
+    }
+
+    ofstream outputFile;
+    if (!outputName.empty()) {
+        outputFile.open(outputName);
+        if (!outputFile.is_open()) {
+            cerr << "Error: can't open " << outputName << endl;
+            return 1;
+        }
+    }
+    ostream& output = outputFile.is_open() ? outputFile : cout;
+
+    SelfPlayResult* results = new SelfPlayResult[games > 0 ? games : 1];
+    const auto START = chrono::steady_clock::now();
+    const bool IS_DONE = runSelfPlay(settings, games, threads, output, results);
+    const double SECONDS = chrono::duration<double>(chrono::steady_clock::now() - START).count();
+    if (!IS_DONE) {
+        cerr << "Error: not enough memory for the search tables" << endl;
+        delete[] results;
+        return 1;
+    }
+
+    //summary
+    int attackWins = 0, defenseWins = 0, unfinished = 0;
+    long long plies = 0;
+    for (int game = 0 ; game < games ; game++) {
+        plies += results[game].itsPlies;
+        if (!results[game].itsHasWinner) {
+            unfinished++;
+        } else if (results[game].itsWinner == ATTACK) {
+            attackWins++;
+        } else {
+            defenseWins++;
+        }
+    }
+    cerr << games << " games in " << SECONDS << " s (" << (SECONDS > 0 ? games / SECONDS : 0) << " games/s)" << endl
+         << "ATTACK " << attackWins << " / DEFENSE " << defenseWins << " / unfinished " << unfinished
+         << " / average plies " << (games > 0 ? static_cast<double>(plies) / games : 0) << endl;
+    const ProfileReport PROFILE = collectProfile();
+    if (PROFILE.itsIsEnabled) {
+        cerr << formatProfileText(PROFILE);
+    }
+    if (!profileName.empty()) {
+        ofstream profileFile(profileName);
+        profileFile << formatProfileJson(PROFILE) << endl;
+        if (!profileFile) {
+            cerr << "Error: can't write " << profileName << endl;
+        }
+    }
+    delete[] results;
+    return 0;
+}
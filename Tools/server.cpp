@@ -0,0 +1,111 @@
+/**
+ * @file server.cpp
+ *
+ * @brief Entry point of `Hnefatafl_server`, the network game server.
+ *
+ * Usage: `Hnefatafl_server [--port P] [--connections N] [--games N]`
+ *
+ * The protocol is described in server.h. The server stops on SIGINT or SIGTERM and prints
+ * its counters to `stderr` (and the counters of the hot functions in a `HNEFATAFL_PROFILE` build).
+ *
+ * @author JMB and zecross-dev - IUT Informatique La Rochelle
+ * @date 10/11/2025
+ */
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "../Headers/typeDef.h"
+#include "../Headers/server.h"
+#include "../Headers/profile.h"
+
+using namespace std;
+
+/**
+ * @brief Default TCP port of the server.
+ */
+const int DEFAULT_PORT = 7171;
+
+/**
+ * @brief The running server, stopped by the signal handler.
+ */
+static GameServer theServer;
+
+/**
+ * @brief Stops the server on SIGINT and SIGTERM.
+ */
+static void handleSignal(int) {
+    stopServer(theServer);
+}
+
+/**
+ * @brief Displays the usage of the program.
+ */
+static void displayUsage() {
+    cerr << "Usage: Hnefatafl_server [--port P] [--connections N] [--games N]" << endl;
+}
+
+/**
+ * @brief Main function of the network game server.
+ *
+ * @return 0 if the server stopped normally, 1 on invalid arguments or error.
+ */
+int main(int argc, char* argv[]) {
+    int port = DEFAULT_PORT;
+    int connections = SERVER_MAX_CONNECTIONS;
+    int games = SERVER_MAX_GAMES;
+    for (int arg = 1 ; arg < argc ; arg++) {
+        const char* option = argv[arg];
+        //every option takes a value
+        if (arg + 1 >= argc) {
+            displayUsage();
+            return 1;
+        }
+        const int VALUE = atoi(argv[++arg]);
+        bool isValid = true;
+        if (strcmp(option, "--port") == 0) {
+            port = VALUE;
+            isValid = port >= 0 && port <= 65535;
+        } else if (strcmp(option, "--connections") == 0) {
+            connections = VALUE;
+            isValid = connections > 0;
+        } else if (strcmp(option, "--games") == 0) {
+            games = VALUE;
+            isValid = games > 0;
+        } else {
+            isValid = false;
+        }
+        if (!isValid) {
+            displayUsage();
+            return 1;
+        }
+    }
+
+    if (!createServer(theServer, connections, games)) {
+        cerr << "Error: not enough memory for the pools" << endl;
+        return 1;
+    }
+    if (!listenServer(theServer, port)) {
+        cerr << "Error: can't listen on port " << port << endl;
+        deleteServer(theServer);
+        return 1;
+    }
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+    cerr << "listening on port " << theServer.itsPort << " (" << connections << " connections, " << games << " games)" << endl;
+    const bool IS_DONE = runServer(theServer);
+
+    const ServerStats& STATS = theServer.itsStats;
+    cerr << "accepted " << STATS.itsAccepted << " / refused " << STATS.itsRefused << " / games " << STATS.itsGames
+         << " / moves " << STATS.itsMoves << endl;
+    const ProfileReport PROFILE = collectProfile();
+    if (PROFILE.itsIsEnabled) {
+        cerr << formatProfileText(PROFILE);
+    }
+    deleteServer(theServer);
+    if (!IS_DONE) {
+        cerr << "Error: the event loop failed" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -14,9 +14,77 @@
 #include "Headers/typeDef.h"
 #include "Headers/functions.h"
 #include "Headers/tests.h"
+#include "Headers/ai.h"
+#include "Headers/journal.h"
+#include "Headers/saveindex.h"
+#include "Headers/render.h"
+#include "Headers/book.h"
+#include "Headers/analysis.h"
+#include "Headers/player.h"
 
 using namespace std;
 
+/**
+ * @brief Displays why a move was rejected.
+ *
+ * Only the interactive game turns the codes of `checkMovement()` into text.
+ *
+ * @param aStatus The result of the validation (nothing is displayed for `VALID_MOVE`).
+ * @param aMove The rejected move.
+ */
+void displayMoveError(MoveStatus aStatus, const Move& aMove)
+{
+    switch (aStatus) {
+        case OUT_OF_BOUNDS:
+            cout << "Error : Selection is out of bounds" << endl;
+            break;
+        case WRONG_PIECE:
+            cout << "Error : ATTACK can only move SWORD, DEFENSE can only move SHIELD and the KING" << endl;
+            break;
+        case SPECIAL_CELL:
+            cout << "Error : Only King can escape or go in castle" << endl;
+            break;
+        case NO_MOVEMENT:
+            cout << "Error : The piece must move" << endl;
+            break;
+        case NOT_STRAIGHT:
+            cout << "Error : Pieces only move horizontally or vertically" << endl;
+            break;
+        case BLOCKED:
+            cout << "Error : The path to " << char('A' + aMove.itsEndPosition.itsRow) << aMove.itsEndPosition.itsCol + 1
+                 << " is blocked" << endl;
+            break;
+        case VALID_MOVE:
+            break;
+    }
+}
+
+/**
+ * @brief Asks if a player is played by the computer.
+ *
+ * @param aPlayer The player to configure (updates `itsIsComputer`).
+ */
+void chooseComputerPlayer(Player& aPlayer)
+{
+    cout << "Is " << aPlayer.itsName << " played by the computer (y/n) ";
+    string answer;
+    cin >> answer;
+    aPlayer.itsIsComputer = (answer == "y" || answer == "Y");
+}
+
+/**
+ * @brief Asks which engine plays for the computer.
+ *
+ * @return The engine (alpha-beta unless "m" is answered).
+ */
+EngineKind chooseComputerEngine()
+{
+    cout << "Engine of the computer : alpha-beta or Monte Carlo (a/m) ";
+    string answer;
+    cin >> answer;
+    return (answer == "m" || answer == "M") ? ENGINE_MCTS : ENGINE_ALPHA_BETA;
+}
+
 /**
  * @brief Function to play the Hnefatafl game.
  *
@@ -26,7 +94,12 @@ void playGame()
 {
     Game game;
     string saveName ="";
-    bool loaded = saveManager(game , saveName);
+    //the save index is loaded once, the save manager and the saves only use it
+    SaveIndex saves;
+    if (!loadSaveIndex(saves)) {
+        cout << "Error : the save index of the folder " << saves.itsDirectory << " is invalid" << endl;
+    }
+    bool loaded = saveManager(game , saveName, saves);
     if (!loaded) {
         chooseSizeBoard(game.itsBoard.itsSize);
         createBoard(game.itsBoard);
@@ -36,16 +109,50 @@ void playGame()
         cout <<"Select name for player 2 :  ";
         cin >> game.itsPlayer2.itsName;
     }
-    cout << "Do you want to save this game (y/n)";
-    string saveValidation;
-    cin >> saveValidation;
+    chooseComputerPlayer(game.itsPlayer1);
+    chooseComputerPlayer(game.itsPlayer2);
+    ComputerPlayer computer;
+    if ((game.itsPlayer1.itsIsComputer || game.itsPlayer2.itsIsComputer)
+        && !createComputerPlayer(computer, chooseComputerEngine(), AI_ALL_CORES)) {
+        cout << "Error : not enough memory for the computer player" << endl;
+        game.itsPlayer1.itsIsComputer = false;
+        game.itsPlayer2.itsIsComputer = false;
+    }
+    //the book and the endgame tables of the board size are used when they were generated (Hnefatafl_book)
+    OpeningBook book;
+    EndgameTables endgames;
+    if (openOpeningBook(book, getOpeningBookPath(game.itsBoard.itsSize))) {
+        computer.itsSearch.itsBook = &book;
+    }
+    if (openEndgameTables(endgames, getEndgameTablesPath(game.itsBoard.itsSize))) {
+        computer.itsSearch.itsEndgames = &endgames;
+    }
+    //the positions analyzed in the previous games are answered from the cache and fill the table
+    AnalysisCache analysis;
+    if (computer.itsSearch.itsTable != nullptr && openAnalysisCache(analysis, ANALYSIS_CACHE_PATH)) {
+        computer.itsSearch.itsAnalysis = &analysis;
+        preloadAnalysisCache(analysis, computer.itsSearch);
+    }
+    //the moves are appended to the journal of the save, a loaded save continues its journal
+    //(a legacy text save is rewritten as a journal starting from the loaded position)
+    MoveJournal journal;
     bool validSave = false;
-    if (saveValidation== "y" || saveValidation == "Y") {
-        validSave = createSave(saveName);
+    if (loaded) {
+        const string SAVE_PATH = getSavePath(saves, saveName);
+        validSave = resumeJournal(journal, SAVE_PATH) || openJournal(journal, SAVE_PATH, game);
+    }
+    else {
+        cout << "Do you want to save this game (y/n)";
+        string saveValidation;
+        cin >> saveValidation;
+        if (saveValidation== "y" || saveValidation == "Y") {
+            validSave = createSave(saveName, saves, game.itsBoard.itsSize) && openJournal(journal, getSavePath(saves, saveName), game);
+        }
     }
+    //the screen is redrawn in one write, only the changed cells after the first turn
+    BoardRenderer renderer;
+    const bool HAS_RENDERER = createRenderer(renderer);
     while (!isGameFinished(game)) {
-        clearConsole();
-        displayHnefataflLogo();
         string playerRole;
         if (game.itsCurrentPlayer->itsRole == 1) {
             playerRole = "DEFENSE";
@@ -53,26 +160,59 @@ void playGame()
         else {
             playerRole = "ATTACK";
         }
-        cout << "Turn to : " << playerRole << " (" << game.itsCurrentPlayer->itsName << ")" <<endl;
-        displayBoard(game.itsBoard);
+        const string STATUS = "Turn to : " + playerRole + " (" + game.itsCurrentPlayer->itsName + ")";
+        if (!HAS_RENDERER || !renderGame(renderer, game.itsBoard, STATUS)) {
+            displayHnefataflLogo();
+            cout << STATUS << endl;
+            displayBoard(game.itsBoard);
+        }
         Position pos1{-1,-1},pos2{-1,-1};
         Move turnMove{pos1,pos2} ;
-        bool validMove;
-        do {
-            cout << "position 1 , ";
-            getPositionFromInput(pos1 , game.itsBoard);
-            cout << "position 2 , ";
-            getPositionFromInput(pos2 , game.itsBoard);
-            turnMove={pos1,pos2};
-            validMove = isValidMovement(game,turnMove);
-        }while (!validMove);
+        MoveStatus moveStatus;
+        if (game.itsCurrentPlayer->itsIsComputer) {
+            turnMove = chooseComputerMove(game, computer).itsBestMove;
+            //a player without legal move can't continue the game
+            if (turnMove.itsStartPosition.itsRow == -1) {
+                cout << "No legal move left for " << game.itsCurrentPlayer->itsName << endl;
+                break;
+            }
+        }
+        else {
+            int attempts = 0;
+            do {
+                attempts++;
+                cout << "position 1 , ";
+                getPositionFromInput(pos1 , game.itsBoard);
+                cout << "position 2 , ";
+                getPositionFromInput(pos2 , game.itsBoard);
+                turnMove={pos1,pos2};
+                moveStatus = checkMovement(game,turnMove);
+                displayMoveError(moveStatus, turnMove);
+            }while (moveStatus != VALID_MOVE);
+            //the errors may have scrolled the screen
+            if (attempts > 1) {
+                invalidateRenderer(renderer);
+            }
+        }
         movePiece(game,turnMove);
         capturePieces(game,turnMove);
         switchCurrentPlayer(game);
-        if (validSave == true) {
-            updateSave(game,saveName);
+        if (validSave == true && !appendJournal(journal, turnMove)) {
+            cout << "Error of save" << endl;
+            validSave = false;
         }
     }
+    //the index is only written at the end of the game, not after each move
+    if (validSave && (!closeJournal(journal) || !recordSave(saves, saveName, game.itsBoard.itsSize, journal.itsPlies))) {
+        cout << "Error of save" << endl;
+    }
+    closeJournal(journal);
+    deleteRenderer(renderer);
+    deleteSaveIndex(saves);
+    deleteComputerPlayer(computer);
+    closeOpeningBook(book);
+    closeEndgameTables(endgames);
+    closeAnalysisCache(analysis);
     deleteBoard(game.itsBoard);
 
 }
@@ -101,7 +241,14 @@ void launchTests(){
     test_chooseSizeBoard();
     test_createBoard();
     test_deleteBoard();
+    test_acquireBoard();
+    test_copyBoard();
+    test_takeSnapshot();
     test_initializeBoard();
+    test_updateBitboards();
+    test_computeHash();
+    test_writeBoardText();
+    test_composeUpdate();
 
     // ─────────────────────────────────────────────────────────────────
     // Step 2: Position and Cell Validation Tests
@@ -109,26 +256,88 @@ void launchTests(){
     test_getPositionFromInput();
     test_isValidPosition();
     test_isEmptyCell();
+    test_formatPosition();
+    test_parsePosition();
+    test_formatMove();
+    test_parseMove();
 
     // ─────────────────────────────────────────────────────────────────
     // Step 3: Movement and Action Tests
     // ─────────────────────────────────────────────────────────────────
     test_isValidMovement();
+    test_checkMovement();
     test_movePiece();
     test_capturePieces();
+    test_generateMoves();
+    test_makeMove();
+    test_unmakeMove();
+    test_perft();
+    test_engine();
     test_switchCurrentPlayer();
 
     // ─────────────────────────────────────────────────────────────────
     // Step 4: Game State and Victory Condition Tests
     // ─────────────────────────────────────────────────────────────────
     test_isSwordLeft();
+    test_countPieces();
     test_getKingPosition();
     test_isKingEscaped();
     test_isKingCapturedSimple();
-    // test_isKingCapturedRecursive();  // Optional: Advanced recursive king capture detection
+    test_isKingCapturedRecursive();
+    test_getGameStatus();
     test_isGameFinished();
     test_whoWon();
 
+    // ─────────────────────────────────────────────────────────────────
+    // Step 5: Computer Player Tests
+    // ─────────────────────────────────────────────────────────────────
+    test_scanBoardMasks();
+    test_computeEvalFeatures();
+    test_evaluatePosition();
+    test_searchBestMove();
+    test_buildOpeningBook();
+    test_buildEndgameTables();
+    test_openAnalysisCache();
+    test_storeAnalysisCache();
+    test_encodeEvalPosition();
+    test_evaluateEvalBatch();
+    test_searchMctsMove();
+    test_chooseComputerMove();
+
+    // ─────────────────────────────────────────────────────────────────
+    // Step 6: Self-play Tests
+    // ─────────────────────────────────────────────────────────────────
+    test_playSelfPlayGame();
+    test_runSelfPlay();
+    test_validateGameRecord();
+    test_runReplay();
+    test_getBoardAllocationCount();
+    test_collectProfile();
+    test_runBenchmark();
+
+    // ─────────────────────────────────────────────────────────────────
+    // Step 7: Save Format and Journal Tests
+    // ─────────────────────────────────────────────────────────────────
+    test_encodeSave();
+    test_decodeSave();
+    test_importTextSave();
+    test_appendJournal();
+    test_replayJournal();
+    test_recordSave();
+    test_loadSaveIndex();
+
+    // ─────────────────────────────────────────────────────────────────
+    // Step 8: Game Database Tests
+    // ─────────────────────────────────────────────────────────────────
+    test_addDatabaseGame();
+    test_computeDatabaseStats();
+
+    // ─────────────────────────────────────────────────────────────────
+    // Step 9: Network Server Tests
+    // ─────────────────────────────────────────────────────────────────
+    test_handleServerLine();
+    test_runServer();
+
     // Display test suite footer
     printTestSuiteFooter();
 }